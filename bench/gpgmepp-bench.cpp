@@ -0,0 +1,539 @@
+/*
+    gpgmepp-bench.cpp
+
+    This file is part of GPGME++'s benchmarks.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+/*
+ * Measures the throughput of common GpgME++ operations and writes the
+ * results as JSON, so that they can be compared between releases.
+ *
+ * All keys are created in a temporary GNUPGHOME which is removed when the
+ * program exits.
+ */
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <context.h>
+#include <data.h>
+#include <decryptionresult.h>
+#include <encryptionresult.h>
+#include <engineinfo.h>
+#include <global.h>
+#include <gpgmepp_version.h>
+#include <importresult.h>
+#include <key.h>
+#include <keygenerationresult.h>
+#include <keylistresult.h>
+#include <signingresult.h>
+#include <verificationresult.h>
+#include <interfaces/dataprovider.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace GpgME;
+
+namespace
+{
+
+struct Options {
+    double seconds = 1.0;
+    unsigned int keys = 100;
+    unsigned int userIDs = 50;
+    unsigned int subkeys = 10;
+    std::string filter;
+    std::string output;
+};
+
+struct Measurement {
+    std::string name;
+    unsigned long iterations = 0;
+    double seconds = 0;
+    // bytes resp. items processed by one iteration; 0 if not applicable
+    size_t bytes = 0;
+    size_t items = 0;
+};
+
+class Bench
+{
+public:
+    explicit Bench(const Options &o)
+        : options(o)
+    {
+    }
+
+    // Runs @p op repeatedly for at least the configured time.
+    void run(const std::string &name, size_t bytes, size_t items, const std::function<bool()> &op)
+    {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+            return;
+        }
+        Measurement m;
+        m.name = name;
+        m.bytes = bytes;
+        m.items = items;
+        const auto start = std::chrono::steady_clock::now();
+        std::chrono::duration<double> elapsed{0};
+        do {
+            if (!op()) {
+                std::cerr << name << ": operation failed" << std::endl;
+                failed = true;
+                return;
+            }
+            ++m.iterations;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed.count() < options.seconds);
+        m.seconds = elapsed.count();
+        std::fprintf(stderr, "%-32s %12.1f ops/s\n", name.c_str(), m.iterations / m.seconds);
+        measurements.push_back(m);
+    }
+
+    void writeJson(std::ostream &out) const
+    {
+        out << "{\n"
+            << "  \"version\": \"" << GPGMEPP_VERSION_STRING << "\",\n"
+            << "  \"engine\": \"" << engineInfo(GpgEngine).version() << "\",\n"
+            << "  \"benchmarks\": [";
+        for (size_t i = 0; i < measurements.size(); ++i) {
+            const Measurement &m = measurements[i];
+            const double ops = m.iterations / m.seconds;
+            out << (i ? ",\n" : "\n")
+                << "    {\"name\": \"" << m.name << "\""
+                << ", \"iterations\": " << m.iterations
+                << ", \"seconds\": " << m.seconds
+                << ", \"ops_per_second\": " << ops;
+            if (m.bytes) {
+                out << ", \"bytes_per_second\": " << ops * m.bytes;
+            }
+            if (m.items) {
+                out << ", \"items_per_second\": " << ops * m.items;
+            }
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    const Options options;
+    std::vector<Measurement> measurements;
+    bool failed = false;
+};
+
+// An in-memory data provider to measure the overhead of the callbacks
+class MemoryProvider : public DataProvider
+{
+public:
+    bool isSupported(Operation) const override
+    {
+        return true;
+    }
+    ssize_t read(void *buffer, size_t bufSize) override
+    {
+        const size_t n = std::min(bufSize, data.size() - pos);
+        std::memcpy(buffer, data.data() + pos, n);
+        pos += n;
+        return n;
+    }
+    ssize_t write(const void *buffer, size_t bufSize) override
+    {
+        if (pos + bufSize > data.size()) {
+            data.resize(pos + bufSize);
+        }
+        std::memcpy(&data[pos], buffer, bufSize);
+        pos += bufSize;
+        return bufSize;
+    }
+    off_t seek(off_t offset, int whence) override
+    {
+        const off_t base = whence == SEEK_SET ? 0 : whence == SEEK_CUR ? off_t(pos) : off_t(data.size());
+        if (base + offset < 0) {
+            errno = EINVAL;
+            return -1;
+        }
+        pos = base + offset;
+        return pos;
+    }
+    void release() override
+    {
+        data.clear();
+        pos = 0;
+    }
+
+    std::vector<char> data;
+    size_t pos = 0;
+};
+
+class TemporaryHome
+{
+public:
+    TemporaryHome()
+    {
+        std::string tmpl = (std::filesystem::temp_directory_path() / "gpgmepp-bench-XXXXXX").string();
+        if (mkdtemp(&tmpl[0])) {
+            path = tmpl;
+            std::ofstream(path + "/gpg.conf") << "no-auto-check-trustdb\n";
+            std::ofstream(path + "/gpg-agent.conf") << "allow-loopback-pinentry\n";
+        }
+    }
+    ~TemporaryHome()
+    {
+        if (path.empty()) {
+            return;
+        }
+        const std::string kill = "gpgconf --homedir '" + path + "' --kill all >/dev/null 2>&1";
+        (void)std::system(kill.c_str());
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::string path;
+};
+
+std::unique_ptr<Context> createContext(const std::string &home)
+{
+    auto ctx = Context::create(OpenPGP);
+    ctx->setEngineHomeDirectory(home.c_str());
+    ctx->setPinentryMode(Context::PinentryLoopback);
+    ctx->setOffline(true);
+    return ctx;
+}
+
+Key createKey(Context &ctx, const std::string &userID, const std::string &algo, Context::CreationFlags flags)
+{
+    const KeyGenerationResult result = ctx.createKey(userID, algo, 0,
+                                                     static_cast<Context::CreationFlags>(flags | Context::CreateNoPassword
+                                                                                         | Context::CreateNoExpire
+                                                                                         | Context::CreateForce));
+    if (result.error() || !result.fingerprint()) {
+        std::cerr << "Creating key for " << userID << " failed: " << result.error().asStdString() << std::endl;
+        return Key();
+    }
+    Error err;
+    return ctx.key(result.fingerprint(), err, true);
+}
+
+// a key with many user IDs and subkeys
+Key createLargeKey(Context &ctx, const Options &options)
+{
+    Key key = createKey(ctx, "Large Key <large@example.net>", "ed25519", Context::CreateCertify);
+    if (key.isNull()) {
+        return key;
+    }
+    for (unsigned int i = 0; i < options.userIDs; ++i) {
+        const std::string uid = "Large Key " + std::to_string(i) + " <large" + std::to_string(i) + "@example.net>";
+        if (const Error err = ctx.addUid(key, uid.c_str())) {
+            std::cerr << "Adding user ID failed: " << err.asStdString() << std::endl;
+            return Key();
+        }
+    }
+    for (unsigned int i = 0; i < options.subkeys; ++i) {
+        const char *algo = i % 2 ? "cv25519" : "ed25519";
+        const auto flags = static_cast<Context::CreationFlags>((i % 2 ? Context::CreateEncrypt : Context::CreateSign)
+                                                               | Context::CreateNoExpire);
+        const KeyGenerationResult result = ctx.createSubkey(key, algo, 0, flags);
+        if (result.error()) {
+            std::cerr << "Creating subkey failed: " << result.error().asStdString() << std::endl;
+            return Key();
+        }
+    }
+    Error err;
+    return ctx.key(key.primaryFingerprint(), err, true);
+}
+
+void benchKeys(Bench &bench, const Key &key)
+{
+    size_t userIDs = key.numUserIDs();
+    size_t subkeys = key.numSubkeys();
+    bench.run("key/copy", 0, 0, [&key]() {
+        const Key copy = key;
+        return !copy.isNull();
+    });
+    bench.run("key/iterate-userids", 0, userIDs, [&key]() {
+        size_t n = 0;
+        for (const UserID &uid : key.userIDs()) {
+            n += std::strlen(uid.id()) + std::strlen(uid.email()) + uid.numSignatures();
+        }
+        return n > 0;
+    });
+    bench.run("key/iterate-subkeys", 0, subkeys, [&key]() {
+        size_t n = 0;
+        for (const Subkey &subkey : key.subkeys()) {
+            n += std::strlen(subkey.fingerprint()) + subkey.canSign() + subkey.length();
+        }
+        return n > 0;
+    });
+    bench.run("key/indexed-access", 0, userIDs + subkeys, [&key, userIDs, subkeys]() {
+        size_t n = 0;
+        for (size_t i = 0; i < userIDs; ++i) {
+            n += key.userID(i).validity();
+        }
+        for (size_t i = 0; i < subkeys; ++i) {
+            n += key.subkey(i).isRevoked();
+        }
+        return n < userIDs + subkeys + 1;
+    });
+    bench.run("key/can-encrypt", 0, 0, [&key]() {
+        return key.canEncrypt() || key.canSign();
+    });
+}
+
+void benchData(Bench &bench)
+{
+    static const size_t chunkSize = 64 * 1024;
+    static const size_t total = 4 * 1024 * 1024;
+    const std::vector<char> chunk(chunkSize, 'x');
+    std::vector<char> buffer(chunkSize);
+
+    const auto writeAndRead = [&chunk, &buffer](Data &data) {
+        data.seek(0, SEEK_SET);
+        for (size_t n = 0; n < total; n += chunkSize) {
+            if (data.write(chunk.data(), chunkSize) != ssize_t(chunkSize)) {
+                return false;
+            }
+        }
+        data.seek(0, SEEK_SET);
+        size_t n = 0;
+        ssize_t r;
+        while ((r = data.read(buffer.data(), chunkSize)) > 0) {
+            n += r;
+        }
+        return n == total;
+    };
+
+    bench.run("data/memory", 2 * total, 0, [&writeAndRead]() {
+        Data data;
+        return writeAndRead(data);
+    });
+    bench.run("data/memory-reuse", 2 * total, 0, [&writeAndRead]() {
+        static Data data;
+        return writeAndRead(data);
+    });
+    std::FILE *const fp = std::tmpfile();
+    if (fp) {
+        bench.run("data/file", 2 * total, 0, [&writeAndRead, fp]() {
+            Data data(fp);
+            return writeAndRead(data);
+        });
+        std::fclose(fp);
+    }
+    bench.run("data/provider", 2 * total, 0, [&writeAndRead]() {
+        MemoryProvider provider;
+        Data data(&provider);
+        return writeAndRead(data);
+    });
+    const std::string text(total, 'x');
+    bench.run("data/to-string", total, 0, [&text]() {
+        Data data(text.data(), text.size(), false);
+        return data.toString().size() == text.size();
+    });
+}
+
+void benchKeyListing(Bench &bench, Context &ctx, const Options &options)
+{
+    std::cerr << "Creating " << options.keys << " keys..." << std::endl;
+    for (unsigned int i = 0; i < options.keys; ++i) {
+        const std::string uid = "Listed Key " + std::to_string(i) + " <listed" + std::to_string(i) + "@example.net>";
+        if (createKey(ctx, uid, "ed25519", Context::CreateSign).isNull()) {
+            bench.failed = true;
+            return;
+        }
+    }
+    const auto list = [&ctx](unsigned int mode, bool secretOnly) {
+        ctx.setKeyListMode(mode);
+        if (ctx.startKeyListing("@example.net", secretOnly)) {
+            return false;
+        }
+        Error err;
+        size_t n = 0;
+        while (!ctx.nextKey(err).isNull()) {
+            ++n;
+        }
+        return !ctx.endKeyListing().error() && n > 0;
+    };
+    bench.run("keylist/public", 0, options.keys, [&list]() {
+        return list(Local, false);
+    });
+    bench.run("keylist/secret", 0, options.keys, [&list]() {
+        return list(Local, true);
+    });
+    bench.run("keylist/signatures", 0, options.keys, [&list]() {
+        return list(Local | Signatures, false);
+    });
+    ctx.setKeyListMode(Local);
+}
+
+void benchCrypto(Bench &bench, Context &ctx, const Key &key)
+{
+    static const size_t size = 1024;
+    const std::string text(size, 'x');
+    Data plainText(text.data(), text.size(), false);
+
+    ctx.clearSigningKeys();
+    ctx.addSigningKey(key);
+    Data signature;
+    bench.run("crypto/sign-detached", size, 0, [&]() {
+        Data sig;
+        const bool ok = !ctx.sign(plainText, sig, Detached).error();
+        if (ok) {
+            signature = sig;
+        }
+        return ok;
+    });
+    if (signature.isNull()) {
+        return;
+    }
+    bench.run("crypto/verify-detached", size, 0, [&]() {
+        signature.rewind();
+        plainText.rewind();
+        return !ctx.verifyDetachedSignature(signature, plainText).error();
+    });
+    bench.run("result/verification", 0, 0, [&ctx]() {
+        return ctx.verificationResult().numSignatures() == 1;
+    });
+
+    const std::vector<Key> recipients{key};
+    Data cipherText;
+    bench.run("crypto/encrypt", size, 0, [&]() {
+        Data cipher;
+        plainText.rewind();
+        const bool ok = !ctx.encrypt(recipients, plainText, cipher, Context::AlwaysTrust).error();
+        if (ok) {
+            cipherText = cipher;
+        }
+        return ok;
+    });
+    if (cipherText.isNull()) {
+        return;
+    }
+    bench.run("crypto/decrypt", size, 0, [&]() {
+        Data plain;
+        cipherText.rewind();
+        return !ctx.decrypt(cipherText, plain).error();
+    });
+
+    Data exported;
+    if (!ctx.exportPublicKeys(key.primaryFingerprint(), exported)) {
+        bench.run("crypto/import-unchanged", 0, 0, [&]() {
+            exported.rewind();
+            return !ctx.importKeys(exported).error();
+        });
+        bench.run("result/import", 0, 0, [&ctx]() {
+            return ctx.importResult().numConsidered() == 1;
+        });
+    }
+}
+
+void usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --seconds S    run every benchmark for at least S seconds (default 1)\n"
+              << "  --keys N       number of keys for the keylisting benchmarks (default 100)\n"
+              << "  --uids N       number of user IDs of the large key (default 50)\n"
+              << "  --subkeys N    number of subkeys of the large key (default 10)\n"
+              << "  --filter TEXT  run only the benchmarks whose name contains TEXT\n"
+              << "  --output FILE  write the JSON results to FILE instead of stdout\n";
+}
+
+} // namespace
+
+int
+main (int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "--help") {
+            usage(argv[0]);
+            return 0;
+        } else if (!value) {
+            usage(argv[0]);
+            return 1;
+        } else if (arg == "--seconds") {
+            options.seconds = std::atof(value);
+        } else if (arg == "--keys") {
+            options.keys = std::atoi(value);
+        } else if (arg == "--uids") {
+            options.userIDs = std::atoi(value);
+        } else if (arg == "--subkeys") {
+            options.subkeys = std::atoi(value);
+        } else if (arg == "--filter") {
+            options.filter = value;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+        ++i;
+    }
+
+    GpgME::initializeLibrary();
+
+    const TemporaryHome home;
+    if (home.path.empty()) {
+        std::cerr << "Creating a temporary GNUPGHOME failed" << std::endl;
+        return 1;
+    }
+    const auto ctx = createContext(home.path);
+
+    Bench bench(options);
+    benchData(bench);
+
+    std::cerr << "Creating a key with " << options.userIDs << " user IDs and "
+              << options.subkeys << " subkeys..." << std::endl;
+    const Key largeKey = createLargeKey(*ctx, options);
+    if (largeKey.isNull()) {
+        return 1;
+    }
+    benchKeys(bench, largeKey);
+
+    const Key cryptoKey = createKey(*ctx, "Crypto Key <crypto@example.net>", "future-default", Context::CreateUseDefaults);
+    if (cryptoKey.isNull()) {
+        return 1;
+    }
+    benchCrypto(bench, *ctx, cryptoKey);
+    benchKeyListing(bench, *ctx, options);
+
+    if (options.output.empty()) {
+        bench.writeJson(std::cout);
+    } else {
+        std::ofstream out(options.output);
+        bench.writeJson(out);
+        if (!out) {
+            std::cerr << "Writing " << options.output << " failed" << std::endl;
+            return 1;
+        }
+    }
+
+    return bench.failed ? 1 : 0;
+}
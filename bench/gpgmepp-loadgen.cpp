@@ -0,0 +1,743 @@
+/*
+    gpgmepp-loadgen.cpp
+
+    This file is part of GPGME++'s benchmarks.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+
+/*
+ * Drives a mix of operations at a target rate from several threads and
+ * reports the latency percentiles and the throughput, as well as the
+ * number of engine processes and the resident memory over time. The
+ * operations run either synchronously on one context per thread, on
+ * contexts leased from a ContextPool, or asynchronously on the contexts of
+ * one EpollEventLoop per thread.
+ *
+ * All keys are created in a temporary GNUPGHOME which is removed when the
+ * program exits.
+ */
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <context.h>
+#include <contextpool.h>
+#include <data.h>
+#include <decryptionresult.h>
+#include <encryptionresult.h>
+#include <engineinfo.h>
+#include <epolleventloop.h>
+#include <global.h>
+#include <gpgmepp_version.h>
+#include <key.h>
+#include <keygenerationresult.h>
+#include <keylistresult.h>
+#include <signingresult.h>
+#include <verificationresult.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace GpgME;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+enum Operation {
+    Sign,
+    Verify,
+    Encrypt,
+    Decrypt,
+    KeyList,
+    NumOperations
+};
+
+const char *const operationNames[NumOperations] = {"sign", "verify", "encrypt", "decrypt", "keylist"};
+
+enum Mode {
+    SyncMode,
+    PoolMode,
+    EventLoopMode,
+};
+
+const char *const modeNames[] = {"sync", "pool", "eventloop"};
+
+struct Options {
+    Mode mode = SyncMode;
+    unsigned int threads = 4;
+    // contexts per thread in event loop mode
+    unsigned int contexts = 4;
+    // operations per second of all threads; 0 runs as fast as possible
+    double rate = 0;
+    double seconds = 10;
+    double interval = 1;
+    size_t size = 1024;
+    unsigned int weights[NumOperations] = {1, 1, 1, 1, 1};
+    std::string output;
+};
+
+// the keys and messages shared by all operations
+struct Fixture {
+    std::string home;
+    Key key;
+    std::vector<Key> recipients;
+    std::string plainText;
+    std::string signature;
+    std::string cipherText;
+};
+
+// the latencies of one thread in microseconds
+struct Latencies {
+    std::vector<double> values[NumOperations];
+    unsigned long failures[NumOperations] = {};
+};
+
+struct Sample {
+    double seconds;
+    unsigned long operations;
+    long rss;
+    int engines;
+};
+
+class TemporaryHome
+{
+public:
+    TemporaryHome()
+    {
+        std::string tmpl = (std::filesystem::temp_directory_path() / "gpgmepp-loadgen-XXXXXX").string();
+        if (mkdtemp(&tmpl[0])) {
+            path = tmpl;
+            std::ofstream(path + "/gpg.conf") << "no-auto-check-trustdb\n";
+            std::ofstream(path + "/gpg-agent.conf") << "allow-loopback-pinentry\n";
+        }
+    }
+    ~TemporaryHome()
+    {
+        if (path.empty()) {
+            return;
+        }
+        const std::string kill = "gpgconf --homedir '" + path + "' --kill all >/dev/null 2>&1";
+        (void)std::system(kill.c_str());
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    std::string path;
+};
+
+// Returns the resident set size in bytes, or -1 if unknown.
+long residentSetSize()
+{
+    std::ifstream statm("/proc/self/statm");
+    long size;
+    long resident;
+    if (!(statm >> size >> resident)) {
+        return -1;
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Returns the number of running child processes, i.e. engines, or -1 if
+// unknown.
+int engineProcessCount()
+{
+    std::error_code ec;
+    std::filesystem::directory_iterator it("/proc", ec);
+    if (ec) {
+        return -1;
+    }
+    const std::string self = std::to_string(getpid());
+    int count = 0;
+    for (const auto &entry : it) {
+        const std::string name = entry.path().filename().string();
+        if (name.find_first_not_of("0123456789") != std::string::npos) {
+            continue;
+        }
+        std::ifstream stat(entry.path() / "stat");
+        std::string line;
+        if (!std::getline(stat, line)) {
+            continue;
+        }
+        // the parent follows the command name in parentheses and the state
+        const size_t end = line.rfind(')');
+        if (end == std::string::npos) {
+            continue;
+        }
+        std::istringstream fields(line.substr(end + 1));
+        std::string state;
+        std::string parent;
+        if (fields >> state >> parent && parent == self) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void configureContext(Context &ctx, const Fixture &fixture)
+{
+    ctx.setEngineHomeDirectory(fixture.home.c_str());
+    ctx.setPinentryMode(Context::PinentryLoopback);
+    ctx.setOffline(true);
+    ctx.setKeyListMode(Local);
+    ctx.addSigningKey(fixture.key);
+}
+
+std::unique_ptr<Context> createContext(const Fixture &fixture)
+{
+    auto ctx = Context::create(OpenPGP);
+    configureContext(*ctx, fixture);
+    return ctx;
+}
+
+const char *const keyListPattern = "loadgen@example.net";
+
+bool runOperation(Context &ctx, Operation op, const Fixture &fixture)
+{
+    const std::string &text = fixture.plainText;
+    switch (op) {
+    case Sign: {
+        Data plainText(text.data(), text.size(), false);
+        Data signature;
+        return !ctx.sign(plainText, signature, Detached).error();
+    }
+    case Verify: {
+        Data signature(fixture.signature.data(), fixture.signature.size(), false);
+        Data plainText(text.data(), text.size(), false);
+        const VerificationResult result = ctx.verifyDetachedSignature(signature, plainText);
+        return !result.error() && result.numSignatures() == 1 && !result.signature(0).status();
+    }
+    case Encrypt: {
+        Data plainText(text.data(), text.size(), false);
+        Data cipherText;
+        return !ctx.encrypt(fixture.recipients, plainText, cipherText, Context::AlwaysTrust).error();
+    }
+    case Decrypt: {
+        Data cipherText(fixture.cipherText.data(), fixture.cipherText.size(), false);
+        Data plainText;
+        return !ctx.decrypt(cipherText, plainText).error();
+    }
+    case KeyList: {
+        if (ctx.startKeyListing(keyListPattern)) {
+            return false;
+        }
+        Error err;
+        size_t n = 0;
+        while (!ctx.nextKey(err).isNull()) {
+            ++n;
+        }
+        return !ctx.endKeyListing().error() && n == 1;
+    }
+    default:
+        return false;
+    }
+}
+
+// Starts @p op on a context managed by an event loop. @p done is called by
+// the thread running the loop.
+Error startOperation(Context &ctx, Operation op, const Fixture &fixture, const std::function<void(bool)> &done)
+{
+    const std::string &text = fixture.plainText;
+    switch (op) {
+    case Sign: {
+        Data signature;
+        return ctx.signAsync(Data(text.data(), text.size(), false), signature, Detached,
+                             [done](const SigningResult &result) {
+                                 done(!result.error());
+                             });
+    }
+    case Verify:
+        return ctx.verifyAsync(Data(fixture.signature.data(), fixture.signature.size(), false),
+                               Data(text.data(), text.size(), false),
+                               [done](const VerificationResult &result) {
+                                   done(!result.error() && result.numSignatures() == 1 && !result.signature(0).status());
+                               });
+    case Encrypt: {
+        Data cipherText;
+        return ctx.encryptAsync(fixture.recipients, Data(text.data(), text.size(), false), cipherText,
+                                Context::AlwaysTrust,
+                                [done](const EncryptionResult &result) {
+                                    done(!result.error());
+                                });
+    }
+    case Decrypt: {
+        Data plainText;
+        return ctx.decryptAsync(Data(fixture.cipherText.data(), fixture.cipherText.size(), false), plainText,
+                                Context::DecryptNone,
+                                [done](const DecryptionResult &result) {
+                                    done(!result.error());
+                                });
+    }
+    case KeyList:
+        return ctx.listKeysAsync({keyListPattern}, false,
+                                 [done](const KeyListResult &result, const std::vector<Key> &keys) {
+                                     done(!result.error() && keys.size() == 1);
+                                 });
+    default:
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+}
+
+class LoadGenerator
+{
+public:
+    LoadGenerator(const Options &o, const Fixture &f)
+        : options(o),
+          fixture(f),
+          latencies(o.threads),
+          pool(OpenPGP, [this](Context &ctx) {
+              configureContext(ctx, fixture);
+          })
+    {
+        for (unsigned int weight : options.weights) {
+            totalWeight += weight;
+        }
+    }
+
+    void run()
+    {
+        start = Clock::now();
+        deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+        std::thread sampler(&LoadGenerator::sample, this);
+        std::vector<std::thread> workers;
+        for (unsigned int i = 0; i < options.threads; ++i) {
+            workers.emplace_back(options.mode == EventLoopMode ? &LoadGenerator::runEventLoop : &LoadGenerator::runSync,
+                                 this, i);
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+        }
+        cv.notify_all();
+        sampler.join();
+    }
+
+    void writeJson(std::ostream &out) const
+    {
+        out << "{\n"
+            << "  \"version\": \"" << GPGMEPP_VERSION_STRING << "\",\n"
+            << "  \"engine\": \"" << engineInfo(GpgEngine).version() << "\",\n"
+            << "  \"mode\": \"" << modeNames[options.mode] << "\",\n"
+            << "  \"threads\": " << options.threads << ",\n"
+            << "  \"target_rate\": " << options.rate << ",\n"
+            << "  \"seconds\": " << elapsed << ",\n"
+            << "  \"operations\": [";
+        std::vector<double> all;
+        unsigned long allFailures = 0;
+        bool first = true;
+        for (int op = 0; op < NumOperations; ++op) {
+            std::vector<double> values;
+            unsigned long failures = 0;
+            for (const Latencies &l : latencies) {
+                values.insert(values.end(), l.values[op].begin(), l.values[op].end());
+                failures += l.failures[op];
+            }
+            if (values.empty() && !failures) {
+                continue;
+            }
+            all.insert(all.end(), values.begin(), values.end());
+            allFailures += failures;
+            out << (first ? "\n" : ",\n") << "    ";
+            writeStatistics(out, operationNames[op], values, failures);
+            first = false;
+        }
+        out << "\n  ],\n  \"total\": ";
+        writeStatistics(out, "all", all, allFailures);
+        out << ",\n  \"samples\": [";
+        for (size_t i = 0; i < samples.size(); ++i) {
+            const Sample &s = samples[i];
+            out << (i ? ",\n" : "\n")
+                << "    {\"seconds\": " << s.seconds
+                << ", \"operations\": " << s.operations
+                << ", \"rss\": " << s.rss
+                << ", \"engines\": " << s.engines << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    bool failed() const
+    {
+        for (const Latencies &l : latencies) {
+            for (unsigned long failures : l.failures) {
+                if (failures) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    // Picks the next operation according to the weights of the mix
+    Operation pick(std::mt19937 &random) const
+    {
+        unsigned int n = std::uniform_int_distribution<unsigned int>(0, totalWeight - 1)(random);
+        for (int op = 0; op < NumOperations; ++op) {
+            if (n < options.weights[op]) {
+                return static_cast<Operation>(op);
+            }
+            n -= options.weights[op];
+        }
+        return Sign;
+    }
+
+    Clock::duration period() const
+    {
+        const double perThread = options.rate / options.threads;
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1 / perThread));
+    }
+
+    // Records the latency of an operation measured from the time it was
+    // due, so that operations delayed by a slow engine count as slow.
+    void record(unsigned int thread, Operation op, Clock::time_point due, bool ok)
+    {
+        Latencies &l = latencies[thread];
+        if (!ok) {
+            ++l.failures[op];
+        }
+        l.values[op].push_back(std::chrono::duration<double, std::micro>(Clock::now() - due).count());
+        ++operations;
+    }
+
+    void runSync(unsigned int thread)
+    {
+        std::mt19937 random(thread);
+        std::unique_ptr<Context> ctx;
+        if (options.mode == SyncMode) {
+            ctx = createContext(fixture);
+        }
+        const bool paced = options.rate > 0;
+        Clock::time_point due = start;
+        while (true) {
+            if (paced) {
+                std::this_thread::sleep_until(due);
+            } else {
+                due = Clock::now();
+            }
+            if (due >= deadline) {
+                break;
+            }
+            const Operation op = pick(random);
+            bool ok;
+            if (ctx) {
+                ok = runOperation(*ctx, op, fixture);
+            } else {
+                ContextPool::Lease lease = pool.acquire();
+                ok = lease && runOperation(*lease, op, fixture);
+            }
+            record(thread, op, due, ok);
+            if (paced) {
+                due += period();
+            }
+        }
+    }
+
+    void runEventLoop(unsigned int thread)
+    {
+        std::mt19937 random(thread);
+        EpollEventLoop loop;
+        if (loop.error()) {
+            std::cerr << "Creating the event loop failed: " << loop.error().asStdString() << std::endl;
+            return;
+        }
+        std::vector<std::unique_ptr<Context>> contexts;
+        std::vector<Context *> idle;
+        for (unsigned int i = 0; i < options.contexts; ++i) {
+            contexts.push_back(createContext(fixture));
+            loop.manage(contexts.back().get());
+            idle.push_back(contexts.back().get());
+        }
+        const bool paced = options.rate > 0;
+        Clock::time_point due = start;
+        while ((paced ? due : Clock::now()) < deadline) {
+            // start all operations which are due
+            while (!idle.empty() && (paced ? due : Clock::now()) < deadline && (!paced || due <= Clock::now())) {
+                Context *const ctx = idle.back();
+                idle.pop_back();
+                const Operation op = pick(random);
+                const Clock::time_point started = paced ? due : Clock::now();
+                const Error err = startOperation(*ctx, op, fixture, [this, thread, op, started, ctx, &idle](bool ok) {
+                    record(thread, op, started, ok);
+                    idle.push_back(ctx);
+                });
+                if (err) {
+                    record(thread, op, started, false);
+                    idle.push_back(ctx);
+                }
+                if (paced) {
+                    due += period();
+                }
+            }
+            int timeout = 100;
+            if (paced && !idle.empty()) {
+                const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(due - Clock::now());
+                timeout = std::max<int>(0, std::min<int>(timeout, wait.count()));
+            }
+            loop.processEvents(timeout);
+        }
+        // wait for the pending operations
+        while (idle.size() < contexts.size()) {
+            loop.processEvents(100);
+        }
+        for (const auto &ctx : contexts) {
+            loop.unmanage(ctx.get());
+        }
+    }
+
+    void sample()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.interval));
+        Clock::time_point next = start + interval;
+        while (!cv.wait_until(lock, next, [this]() {
+                    return finished;
+                })) {
+            Sample s;
+            s.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            s.operations = operations;
+            s.rss = residentSetSize();
+            s.engines = engineProcessCount();
+            const unsigned long previous = samples.empty() ? 0 : samples.back().operations;
+            std::fprintf(stderr, "%8.1fs %10lu ops %10.1f ops/s %8.1f MiB %4d engines\n",
+                         s.seconds, s.operations, (s.operations - previous) / options.interval,
+                         s.rss / (1024.0 * 1024.0), s.engines);
+            samples.push_back(s);
+            next += interval;
+        }
+    }
+
+    static double percentile(const std::vector<double> &sorted, double p)
+    {
+        if (sorted.empty()) {
+            return 0;
+        }
+        const size_t index = std::min(sorted.size() - 1, size_t(p * sorted.size()));
+        return sorted[index];
+    }
+
+    void writeStatistics(std::ostream &out, const char *name, std::vector<double> &values, unsigned long failures) const
+    {
+        std::sort(values.begin(), values.end());
+        out << "{\"name\": \"" << name << "\""
+            << ", \"count\": " << values.size()
+            << ", \"failures\": " << failures
+            << ", \"ops_per_second\": " << (elapsed > 0 ? values.size() / elapsed : 0)
+            << ", \"p50_us\": " << percentile(values, 0.5)
+            << ", \"p99_us\": " << percentile(values, 0.99)
+            << ", \"p999_us\": " << percentile(values, 0.999)
+            << ", \"max_us\": " << (values.empty() ? 0 : values.back()) << "}";
+    }
+
+    const Options options;
+    const Fixture &fixture;
+    unsigned int totalWeight = 0;
+    std::vector<Latencies> latencies;
+    ContextPool pool;
+    std::atomic<unsigned long> operations{0};
+    Clock::time_point start;
+    Clock::time_point deadline;
+    double elapsed = 0;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool finished = false;
+    std::vector<Sample> samples;
+};
+
+bool createFixture(Fixture &fixture, const Options &options)
+{
+    const auto ctx = createContext(fixture);
+    const KeyGenerationResult result = ctx->createKey("Load Generator <loadgen@example.net>", "future-default", 0,
+                                                      static_cast<Context::CreationFlags>(Context::CreateUseDefaults
+                                                                                          | Context::CreateNoPassword
+                                                                                          | Context::CreateNoExpire
+                                                                                          | Context::CreateForce));
+    if (result.error() || !result.fingerprint()) {
+        std::cerr << "Creating the key failed: " << result.error().asStdString() << std::endl;
+        return false;
+    }
+    Error err;
+    fixture.key = ctx->key(result.fingerprint(), err, true);
+    if (fixture.key.isNull()) {
+        std::cerr << "Listing the key failed: " << err.asStdString() << std::endl;
+        return false;
+    }
+    fixture.recipients = {fixture.key};
+    fixture.plainText.assign(options.size, 'x');
+
+    configureContext(*ctx, fixture);
+    Data plainText(fixture.plainText.data(), fixture.plainText.size(), false);
+    Data signature;
+    if (const Error e = ctx->sign(plainText, signature, Detached).error()) {
+        std::cerr << "Signing failed: " << e.asStdString() << std::endl;
+        return false;
+    }
+    fixture.signature = signature.toString();
+    plainText.rewind();
+    Data cipherText;
+    if (const Error e = ctx->encrypt(fixture.recipients, plainText, cipherText, Context::AlwaysTrust).error()) {
+        std::cerr << "Encrypting failed: " << e.asStdString() << std::endl;
+        return false;
+    }
+    fixture.cipherText = cipherText.toString();
+    return true;
+}
+
+// parses a mix like "sign=2,verify=1"; operations not listed get weight 0
+bool parseMix(const std::string &mix, Options &options)
+{
+    std::fill(std::begin(options.weights), std::end(options.weights), 0);
+    std::istringstream stream(mix);
+    std::string item;
+    unsigned int total = 0;
+    while (std::getline(stream, item, ',')) {
+        const size_t eq = item.find('=');
+        const std::string name = item.substr(0, eq);
+        const unsigned int weight = eq == std::string::npos ? 1 : std::atoi(item.c_str() + eq + 1);
+        const auto it = std::find_if(std::begin(operationNames), std::end(operationNames), [&name](const char *n) {
+            return name == n;
+        });
+        if (it == std::end(operationNames)) {
+            return false;
+        }
+        options.weights[it - std::begin(operationNames)] = weight;
+        total += weight;
+    }
+    return total > 0;
+}
+
+void usage(const char *name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --mode MODE      sync, pool or eventloop (default sync)\n"
+              << "  --threads N      number of threads (default 4)\n"
+              << "  --contexts N     contexts per thread in eventloop mode (default 4)\n"
+              << "  --rate R         operations per second of all threads; 0 runs as fast\n"
+              << "                   as possible (default 0)\n"
+              << "  --seconds S      duration of the run (default 10)\n"
+              << "  --interval S     interval of the samples (default 1)\n"
+              << "  --size BYTES     size of the messages (default 1024)\n"
+              << "  --mix MIX        weights of the operations, e.g. sign=2,verify=1; the\n"
+              << "                   operations are sign, verify, encrypt, decrypt and keylist\n"
+              << "                   (default all with weight 1)\n"
+              << "  --output FILE    write the JSON results to FILE instead of stdout\n";
+}
+
+} // namespace
+
+int
+main (int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg == "--help") {
+            usage(argv[0]);
+            return 0;
+        } else if (!value) {
+            usage(argv[0]);
+            return 1;
+        } else if (arg == "--mode") {
+            const auto it = std::find_if(std::begin(modeNames), std::end(modeNames), [value](const char *n) {
+                return std::string(value) == n;
+            });
+            if (it == std::end(modeNames)) {
+                usage(argv[0]);
+                return 1;
+            }
+            options.mode = static_cast<Mode>(it - std::begin(modeNames));
+        } else if (arg == "--threads") {
+            options.threads = std::max(1, std::atoi(value));
+        } else if (arg == "--contexts") {
+            options.contexts = std::max(1, std::atoi(value));
+        } else if (arg == "--rate") {
+            options.rate = std::max(0.0, std::atof(value));
+        } else if (arg == "--seconds") {
+            options.seconds = std::atof(value);
+        } else if (arg == "--interval") {
+            options.interval = std::max(0.01, std::atof(value));
+        } else if (arg == "--size") {
+            options.size = std::atol(value);
+        } else if (arg == "--mix") {
+            if (!parseMix(value, options)) {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+        ++i;
+    }
+
+    GpgME::initializeLibrary();
+
+    const TemporaryHome home;
+    if (home.path.empty()) {
+        std::cerr << "Creating a temporary GNUPGHOME failed" << std::endl;
+        return 1;
+    }
+    Fixture fixture;
+    fixture.home = home.path;
+    if (!createFixture(fixture, options)) {
+        return 1;
+    }
+
+    LoadGenerator generator(options, fixture);
+    generator.run();
+
+    if (options.output.empty()) {
+        generator.writeJson(std::cout);
+    } else {
+        std::ofstream out(options.output);
+        generator.writeJson(out);
+        if (!out) {
+            std::cerr << "Writing " << options.output << " failed" << std::endl;
+            return 1;
+        }
+    }
+
+    return generator.failed() ? 1 : 0;
+}
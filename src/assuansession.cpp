@@ -0,0 +1,199 @@
+/*
+  assuansession.cpp - a persistent connection for Assuan transactions
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <assuansession.h>
+#include <context.h>
+#include <data.h>
+#include <error.h>
+#include <interfaces/assuantransaction.h>
+
+#include <mutex>
+
+using namespace GpgME;
+
+namespace
+{
+
+// passes the response to a transaction owned by the caller
+class ForwardingTransaction : public AssuanTransaction
+{
+public:
+    explicit ForwardingTransaction(AssuanTransaction *t)
+        : mTarget(t)
+    {
+    }
+
+    Error data(const char *data, size_t datalen) override
+    {
+        return mTarget ? mTarget->data(data, datalen) : Error();
+    }
+
+    Data inquire(const char *name, const char *args, Error &err) override
+    {
+        if (mTarget) {
+            return mTarget->inquire(name, args, err);
+        }
+        err = Error::fromCode(GPG_ERR_ASS_UNKNOWN_INQUIRE);
+        return Data::null;
+    }
+
+    Error status(const char *status, const char *args) override
+    {
+        return mTarget ? mTarget->status(status, args) : Error();
+    }
+
+private:
+    AssuanTransaction *const mTarget;
+};
+
+}
+
+class AssuanSession::Private
+{
+public:
+    Private(const char *s, const char *h)
+        : socketName(s ? s : ""),
+          homeDirectory(h ? h : ""),
+          connected(false),
+          reconnects(0)
+    {
+    }
+
+    // called with the mutex locked
+    Error connect()
+    {
+        Error err;
+        ctx = Context::createForEngine(AssuanEngine, &err);
+        if (!ctx) {
+            return err ? err : Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+        }
+        if (!socketName.empty()) {
+            err = ctx->setEngineFileName(socketName.c_str());
+        }
+        if (!err && !homeDirectory.empty()) {
+            err = ctx->setEngineHomeDirectory(homeDirectory.c_str());
+        }
+        if (err) {
+            ctx.reset();
+        }
+        return err;
+    }
+
+    // called with the mutex locked
+    Error run(const char *command, AssuanTransaction *transaction)
+    {
+        if (!command) {
+            return Error::fromCode(GPG_ERR_INV_ARG);
+        }
+        // the first attempt may use a stale connection; repeat once
+        const bool wasConnected = connected;
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            if (!ctx) {
+                if (const Error err = connect()) {
+                    return err;
+                }
+            }
+            const Error err = ctx->assuanTransact(command,
+                                                  std::unique_ptr<AssuanTransaction>(new ForwardingTransaction(transaction)));
+            if (!isConnectionError(err)) {
+                connected = true;
+                return err;
+            }
+            ctx.reset();
+            connected = false;
+            if (attempt > 0 || !wasConnected) {
+                return err;
+            }
+            ++reconnects;
+        }
+        return Error();
+    }
+
+    const std::string socketName;
+    const std::string homeDirectory;
+    mutable std::mutex mutex;
+    std::unique_ptr<Context> ctx;
+    bool connected;
+    unsigned int reconnects;
+};
+
+AssuanSession::AssuanSession(const char *socketName, const char *homeDirectory)
+    : d(new Private(socketName, homeDirectory))
+{
+}
+
+AssuanSession::~AssuanSession() = default;
+
+Error AssuanSession::transact(const char *command, AssuanTransaction *transaction)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->run(command, transaction);
+}
+
+std::vector<Error> AssuanSession::transact(const std::vector<Command> &commands)
+{
+    std::vector<Error> errors;
+    errors.reserve(commands.size());
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    for (const Command &command : commands) {
+        errors.push_back(d->run(command.command.c_str(), command.transaction));
+    }
+    return errors;
+}
+
+bool AssuanSession::isConnected() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->connected;
+}
+
+unsigned int AssuanSession::reconnects() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->reconnects;
+}
+
+void AssuanSession::disconnect()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->ctx.reset();
+    d->connected = false;
+}
+
+bool AssuanSession::isConnectionError(const Error &err)
+{
+    switch (err.code()) {
+    case GPG_ERR_ASS_CONNECT_FAILED:
+    case GPG_ERR_ASS_READ_ERROR:
+    case GPG_ERR_ASS_WRITE_ERROR:
+    case GPG_ERR_EPIPE:
+    case GPG_ERR_ECONNRESET:
+    case GPG_ERR_EOF:
+        return true;
+    default:
+        return false;
+    }
+}
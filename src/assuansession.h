@@ -0,0 +1,102 @@
+/*
+  assuansession.h - a persistent connection for Assuan transactions
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_ASSUANSESSION_H__
+#define __GPGMEPP_ASSUANSESSION_H__
+
+#include "global.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class AssuanTransaction;
+class Context;
+
+/**
+ * Keeps an Assuan connection to gpg-agent (or another Assuan server) open
+ * on a dedicated context and runs transactions over it.
+ *
+ * A Context of the AssuanEngine keeps its connection between transactions,
+ * so repeated queries like "SCD GETINFO" only pay for the connection once.
+ * If a transaction fails because the connection was lost, e.g. because the
+ * agent was restarted, then the session connects again and repeats the
+ * command once. Commands which must not be repeated should therefore not be
+ * sent over a session.
+ *
+ * The transactions are not owned by the session; they must stay alive
+ * until the command has been run. The session is thread-safe; transactions
+ * of different threads are run one after the other.
+ */
+class GPGMEPP_EXPORT AssuanSession
+{
+public:
+    struct Command {
+        std::string command;
+        /** May be null, in which case the response is discarded. */
+        AssuanTransaction *transaction;
+    };
+
+    /**
+     * Creates a session for the Assuan server listening on @p socketName.
+     * If @p socketName is null, then the default socket of gpg-agent is
+     * used. No connection is made until the first transaction.
+     */
+    explicit AssuanSession(const char *socketName = nullptr, const char *homeDirectory = nullptr);
+    ~AssuanSession();
+
+    /** Runs @p command and passes the response to @p transaction. */
+    Error transact(const char *command, AssuanTransaction *transaction = nullptr);
+
+    /**
+     * Runs all @p commands back to back on the connection without letting
+     * other threads interleave their commands. Returns one error per
+     * command.
+     */
+    std::vector<Error> transact(const std::vector<Command> &commands);
+
+    bool isConnected() const;
+    /** Returns how often the session had to connect again after the
+     * connection was lost. */
+    unsigned int reconnects() const;
+
+    /** Closes the connection. The next transaction connects again. */
+    void disconnect();
+
+    /** Returns true if @p err means that the connection was lost. */
+    static bool isConnectionError(const Error &err);
+
+private:
+    AssuanSession(const AssuanSession &) = delete;
+    AssuanSession &operator=(const AssuanSession &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_ASSUANSESSION_H__
@@ -0,0 +1,188 @@
+/*
+  awaitable.h - C++20 coroutine support for asynchronous operations
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_AWAITABLE_H__
+#define __GPGMEPP_AWAITABLE_H__
+
+#include "context.h"
+#include "data.h"
+#include "decryptionresult.h"
+#include "encryptionresult.h"
+#include "keylistresult.h"
+#include "signingresult.h"
+#include "verificationresult.h"
+
+// The library itself is built as C++17; the awaitables are header-only
+// and only available to applications built with coroutine support.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <functional>
+#include <utility>
+
+namespace GpgME
+{
+
+/**
+ * An awaitable for an asynchronous operation of a Context.
+ *
+ * co_await starts the operation and suspends the coroutine. The coroutine
+ * is resumed by the thread running the event loop of the context when the
+ * operation is done, and co_await yields the result. If the operation
+ * cannot be started, then the coroutine is not suspended and co_await
+ * yields a result with the error.
+ *
+ * The context must be managed by an EventLoopInteractor, and it must not
+ * be destroyed by the resumed coroutine before the coroutine is suspended
+ * again (see Context::encryptAsync).
+ */
+template <typename Result, typename Callback = std::function<void(const Result &)>>
+class Awaitable
+{
+public:
+    using Starter = std::function<Error(const Callback &)>;
+
+    explicit Awaitable(Starter start)
+        : mStart(std::move(start))
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        const Error err = mStart([this, handle](const Result &result) {
+            mResult = result;
+            handle.resume();
+        });
+        if (err) {
+            mResult = Result(err);
+            return false;
+        }
+        return true;
+    }
+
+    Result await_resume()
+    {
+        return std::move(mResult);
+    }
+
+private:
+    Starter mStart;
+    Result mResult;
+};
+
+inline Awaitable<EncryptionResult> awaitEncryption(Context &ctx, const std::vector<Key> &recipients, const Data &plainText,
+                                                   Data &cipherText, Context::EncryptionFlags flags = Context::None)
+{
+    return Awaitable<EncryptionResult>([&ctx, recipients, plainText, cipherText, flags](const Context::EncryptionCallback &callback) mutable {
+        return ctx.encryptAsync(recipients, plainText, cipherText, flags, callback);
+    });
+}
+
+inline Awaitable<DecryptionResult> awaitDecryption(Context &ctx, const Data &cipherText, Data &plainText,
+                                                   Context::DecryptionFlags flags = Context::DecryptNone)
+{
+    return Awaitable<DecryptionResult>([&ctx, cipherText, plainText, flags](const Context::DecryptionCallback &callback) mutable {
+        return ctx.decryptAsync(cipherText, plainText, flags, callback);
+    });
+}
+
+inline Awaitable<SigningResult> awaitSigning(Context &ctx, const Data &plainText, Data &signature, SignatureMode mode)
+{
+    return Awaitable<SigningResult>([&ctx, plainText, signature, mode](const Context::SigningCallback &callback) mutable {
+        return ctx.signAsync(plainText, signature, mode, callback);
+    });
+}
+
+/** Verifies a detached signature. */
+inline Awaitable<VerificationResult> awaitVerification(Context &ctx, const Data &signature, const Data &signedText)
+{
+    return Awaitable<VerificationResult>([&ctx, signature, signedText](const Context::VerificationCallback &callback) {
+        return ctx.verifyAsync(signature, signedText, callback);
+    });
+}
+
+inline Awaitable<VerificationResult> awaitOpaqueVerification(Context &ctx, const Data &signedData, Data &plainText)
+{
+    return Awaitable<VerificationResult>([&ctx, signedData, plainText](const Context::VerificationCallback &callback) mutable {
+        return ctx.verifyOpaqueAsync(signedData, plainText, callback);
+    });
+}
+
+/** Yields the result of the key listing and the listed keys. */
+class KeyListingAwaitable
+{
+public:
+    KeyListingAwaitable(Context &ctx, const std::vector<std::string> &patterns, bool secretOnly)
+        : mContext(ctx),
+          mPatterns(patterns),
+          mSecretOnly(secretOnly)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        const Error err = mContext.listKeysAsync(mPatterns, mSecretOnly, [this, handle](const KeyListResult &result, const std::vector<Key> &keys) {
+            mResult = result;
+            mKeys = keys;
+            handle.resume();
+        });
+        if (err) {
+            mResult = KeyListResult(err);
+            return false;
+        }
+        return true;
+    }
+
+    std::pair<KeyListResult, std::vector<Key>> await_resume()
+    {
+        return {std::move(mResult), std::move(mKeys)};
+    }
+
+private:
+    Context &mContext;
+    const std::vector<std::string> mPatterns;
+    const bool mSecretOnly;
+    KeyListResult mResult;
+    std::vector<Key> mKeys;
+};
+
+inline KeyListingAwaitable awaitKeyListing(Context &ctx, const std::vector<std::string> &patterns, bool secretOnly = false)
+{
+    return KeyListingAwaitable(ctx, patterns, secretOnly);
+}
+
+} // namespace GpgME
+
+#endif // __cpp_impl_coroutine
+
+#endif // __GPGMEPP_AWAITABLE_H__
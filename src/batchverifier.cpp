@@ -0,0 +1,182 @@
+/*
+  batchverifier.cpp - verifies many detached signatures concurrently
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <batchverifier.h>
+#include <context.h>
+#include <contextpool.h>
+#include <verificationresult.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace GpgME;
+
+class BatchVerifier::Private
+{
+public:
+    struct Task {
+        Item item;
+        Callback callback;
+    };
+
+    Private(ContextPool &p, unsigned int c, unsigned int q)
+        : pool(p),
+          concurrency(c ? c : 1),
+          queueSize(q ? q : 2 * concurrency),
+          pending(0),
+          stopping(false)
+    {
+    }
+
+    ~Private()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        notEmpty.notify_all();
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    void startWorkers()
+    {
+        // called with the mutex locked
+        while (workers.size() < concurrency) {
+            workers.emplace_back(&Private::run, this);
+        }
+    }
+
+    VerificationResult verifyOne(const Item &item)
+    {
+        Error err;
+        ContextPool::Lease lease = pool.acquire(&err);
+        if (!lease) {
+            return VerificationResult(err);
+        }
+        err = lease->startDetachedSignatureVerification(item.signature, item.signedData);
+        if (err) {
+            return VerificationResult(err);
+        }
+        lease->wait();
+        return lease->verificationResult();
+    }
+
+    void run()
+    {
+        while (true) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmpty.wait(lock, [this]() {
+                    return !queue.empty() || stopping;
+                });
+                if (queue.empty()) {
+                    return;
+                }
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            notFull.notify_one();
+
+            const VerificationResult result = verifyOne(task.item);
+            if (task.callback) {
+                task.callback(result);
+            }
+
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                --pending;
+            }
+            done.notify_all();
+        }
+    }
+
+    ContextPool &pool;
+    const unsigned int concurrency;
+    const unsigned int queueSize;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::condition_variable done;
+    std::deque<Task> queue;
+    size_t pending;
+    bool stopping;
+};
+
+BatchVerifier::BatchVerifier(ContextPool &pool, unsigned int concurrency, unsigned int queueSize)
+    : d(new Private(pool, concurrency, queueSize))
+{
+}
+
+BatchVerifier::~BatchVerifier()
+{
+    waitForDone();
+}
+
+unsigned int BatchVerifier::concurrency() const
+{
+    return d->concurrency;
+}
+
+std::vector<VerificationResult> BatchVerifier::verify(const std::vector<Item> &items)
+{
+    std::vector<VerificationResult> results(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        // every worker writes to a different element
+        VerificationResult *const slot = &results[i];
+        submit(items[i], [slot](const VerificationResult &result) {
+            *slot = result;
+        });
+    }
+    waitForDone();
+    return results;
+}
+
+void BatchVerifier::submit(const Item &item, const Callback &callback)
+{
+    {
+        std::unique_lock<std::mutex> lock(d->mutex);
+        d->startWorkers();
+        d->notFull.wait(lock, [this]() {
+            return d->queue.size() < d->queueSize;
+        });
+        d->queue.push_back({item, callback});
+        ++d->pending;
+    }
+    d->notEmpty.notify_one();
+}
+
+void BatchVerifier::waitForDone()
+{
+    std::unique_lock<std::mutex> lock(d->mutex);
+    d->done.wait(lock, [this]() {
+        return d->pending == 0;
+    });
+}
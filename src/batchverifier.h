@@ -0,0 +1,92 @@
+/*
+  batchverifier.h - verifies many detached signatures concurrently
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_BATCHVERIFIER_H__
+#define __GPGMEPP_BATCHVERIFIER_H__
+
+#include "global.h"
+#include "data.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+class ContextPool;
+class VerificationResult;
+
+/**
+ * Verifies detached signatures concurrently with contexts of a ContextPool.
+ *
+ * Each verification is run by one of @p concurrency worker threads with
+ * startDetachedSignatureVerification() and wait() on a leased context.
+ * Items are passed to the workers through a bounded queue; submit() blocks
+ * while the queue is full.
+ *
+ * The pool must outlive the verifier. The data objects of an item must not
+ * be used by the caller until the item has been verified.
+ */
+class GPGMEPP_EXPORT BatchVerifier
+{
+public:
+    struct Item {
+        Data signature;
+        Data signedData;
+    };
+    /** Called by a worker thread with the result of an item. */
+    using Callback = std::function<void(const VerificationResult &result)>;
+
+    /** If @p queueSize is 0, then twice the concurrency is used. */
+    explicit BatchVerifier(ContextPool &pool, unsigned int concurrency = 4, unsigned int queueSize = 0);
+    /** Waits for all submitted items. */
+    ~BatchVerifier();
+
+    unsigned int concurrency() const;
+
+    /**
+     * Verifies all @p items and returns the results in the same order. An
+     * item which could not be verified has a result with the error set.
+     */
+    std::vector<VerificationResult> verify(const std::vector<Item> &items);
+
+    /**
+     * Queues @p item for verification. @p callback is called from a worker
+     * thread when the item has been verified. Blocks while the queue is full.
+     */
+    void submit(const Item &item, const Callback &callback);
+
+    /** Waits until all submitted items have been verified. */
+    void waitForDone();
+
+private:
+    BatchVerifier(const BatchVerifier &) = delete;
+    BatchVerifier &operator=(const BatchVerifier &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_BATCHVERIFIER_H__
@@ -0,0 +1,182 @@
+/*
+  bulkencryptor.cpp - encrypts many messages for the same recipients
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <bulkencryptor.h>
+#include <contextpool.h>
+#include <encryptionresult.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace GpgME;
+
+class BulkEncryptor::Private
+{
+public:
+    Private(ContextPool &p, const std::vector<Key> &r, Context::EncryptionFlags f, unsigned int c)
+        : pool(p),
+          recipients(r),
+          flags(f),
+          concurrency(c ? c : 1),
+          recipientSet(recipients),
+          next(0),
+          exhausted(false)
+    {
+    }
+
+    // returns false if the source is exhausted
+    bool fetch(const Source &source, size_t &index, Data &plainText, Data &cipherText)
+    {
+        const std::lock_guard<std::mutex> lock(sourceMutex);
+        if (exhausted) {
+            return false;
+        }
+        index = next;
+        if (!source(index, plainText, cipherText)) {
+            exhausted = true;
+            return false;
+        }
+        ++next;
+        return true;
+    }
+
+    void work(const Source &source, const Callback &callback)
+    {
+        Error err;
+        ContextPool::Lease lease = pool.acquire(&err);
+        size_t index;
+        Data plainText{Data::null};
+        Data cipherText{Data::null};
+        while (fetch(source, index, plainText, cipherText)) {
+            EncryptionResult result;
+            if (!lease) {
+                result = EncryptionResult(err);
+            } else {
+                const Error e = lease->startEncryption(recipientSet, plainText, cipherText, flags);
+                if (e) {
+                    result = EncryptionResult(e);
+                } else {
+                    lease->wait();
+                    result = lease->encryptionResult();
+                }
+            }
+            {
+                const std::lock_guard<std::mutex> lock(statisticsMutex);
+                ++stats.messages;
+                if (result.error()) {
+                    ++stats.failures;
+                }
+            }
+            if (callback) {
+                callback(index, result);
+            }
+        }
+    }
+
+    ContextPool &pool;
+    const std::vector<Key> recipients;
+    const Context::EncryptionFlags flags;
+    const unsigned int concurrency;
+    const RecipientSet recipientSet;
+
+    std::mutex sourceMutex;
+    size_t next;
+    bool exhausted;
+
+    mutable std::mutex statisticsMutex;
+    Statistics stats;
+};
+
+BulkEncryptor::BulkEncryptor(ContextPool &pool, const std::vector<Key> &recipients,
+                             Context::EncryptionFlags flags, unsigned int concurrency)
+    : d(new Private(pool, recipients, flags, concurrency))
+{
+}
+
+BulkEncryptor::~BulkEncryptor() = default;
+
+const std::vector<Key> &BulkEncryptor::recipients() const
+{
+    return d->recipients;
+}
+
+unsigned int BulkEncryptor::concurrency() const
+{
+    return d->concurrency;
+}
+
+void BulkEncryptor::run(const Source &source, const Callback &callback)
+{
+    {
+        const std::lock_guard<std::mutex> lock(d->statisticsMutex);
+        d->stats = Statistics();
+    }
+    d->next = 0;
+    d->exhausted = false;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(d->concurrency);
+    for (unsigned int i = 0; i < d->concurrency; ++i) {
+        workers.emplace_back(&Private::work, d.get(), std::cref(source), std::cref(callback));
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const std::lock_guard<std::mutex> lock(d->statisticsMutex);
+    d->stats.seconds = elapsed.count();
+}
+
+std::vector<EncryptionResult> BulkEncryptor::encrypt(const std::vector<Data> &plainTexts, std::vector<Data> &cipherTexts)
+{
+    std::vector<EncryptionResult> results(plainTexts.size());
+    if (cipherTexts.size() != plainTexts.size()) {
+        std::fill(results.begin(), results.end(), EncryptionResult(Error::fromCode(GPG_ERR_INV_VALUE)));
+        return results;
+    }
+    run([&plainTexts, &cipherTexts](size_t index, Data &plainText, Data &cipherText) {
+            if (index >= plainTexts.size()) {
+                return false;
+            }
+            plainText = plainTexts[index];
+            cipherText = cipherTexts[index];
+            return true;
+        },
+        [&results](size_t index, const EncryptionResult &result) {
+            // every worker writes to a different element
+            results[index] = result;
+        });
+    return results;
+}
+
+BulkEncryptor::Statistics BulkEncryptor::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->statisticsMutex);
+    return d->stats;
+}
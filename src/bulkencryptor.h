@@ -0,0 +1,101 @@
+/*
+  bulkencryptor.h - encrypts many messages for the same recipients
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_BULKENCRYPTOR_H__
+#define __GPGMEPP_BULKENCRYPTOR_H__
+
+#include "global.h"
+#include "context.h"
+#include "data.h"
+#include "recipientset.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+class ContextPool;
+class EncryptionResult;
+
+/**
+ * Encrypts many messages for the same set of recipients concurrently with
+ * the contexts of a ContextPool.
+ *
+ * The recipients are converted to a RecipientSet once when the encryptor
+ * is created, which is shared by all encryptions.
+ *
+ * The pool must outlive the encryptor.
+ */
+class GPGMEPP_EXPORT BulkEncryptor
+{
+public:
+    /**
+     * Called (serialized) by the worker threads to get the next message.
+     * Returns false if there are no more messages. @p index is the number
+     * of the message, counting from 0.
+     */
+    using Source = std::function<bool(size_t index, Data &plainText, Data &cipherText)>;
+    /** Called by a worker thread with the result of the message @p index. */
+    using Callback = std::function<void(size_t index, const EncryptionResult &result)>;
+
+    struct Statistics {
+        unsigned long messages = 0;
+        unsigned long failures = 0;
+        double seconds = 0;
+
+        double messagesPerSecond() const
+        {
+            return seconds > 0 ? messages / seconds : 0;
+        }
+    };
+
+    BulkEncryptor(ContextPool &pool, const std::vector<Key> &recipients,
+                  Context::EncryptionFlags flags = Context::None, unsigned int concurrency = 4);
+    ~BulkEncryptor();
+
+    const std::vector<Key> &recipients() const;
+    unsigned int concurrency() const;
+
+    /** Encrypts all messages provided by @p source. Returns when the source
+     * is exhausted and all messages have been encrypted. */
+    void run(const Source &source, const Callback &callback);
+
+    /** Encrypts every plain text into the cipher text with the same index
+     * and returns the results in the same order. */
+    std::vector<EncryptionResult> encrypt(const std::vector<Data> &plainTexts, std::vector<Data> &cipherTexts);
+
+    /** Returns the statistics of the last run. */
+    Statistics statistics() const;
+
+private:
+    BulkEncryptor(const BulkEncryptor &) = delete;
+    BulkEncryptor &operator=(const BulkEncryptor &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_BULKENCRYPTOR_H__
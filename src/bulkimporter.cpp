@@ -0,0 +1,226 @@
+/*
+  bulkimporter.cpp - imports large keyrings in parallel chunks
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <bulkimporter.h>
+#include <context.h>
+#include <contextpool.h>
+#include <data.h>
+#include <importaccumulator.h>
+#include <importresult.h>
+#include <keypacketsplitter.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace GpgME;
+
+class BulkImporter::Private
+{
+public:
+    Private(ContextPool &p, unsigned int c, size_t s)
+        : pool(p),
+          concurrency(c ? c : 1),
+          chunkSize(s),
+          queueSize(2 * concurrency),
+          finished(false)
+    {
+    }
+
+    // returns false if the queue is empty and all chunks have been queued
+    bool fetch(std::string &chunk)
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        notEmpty.wait(lock, [this]() {
+            return !queue.empty() || finished;
+        });
+        if (queue.empty()) {
+            return false;
+        }
+        chunk = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+
+    void push(std::string &&chunk)
+    {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            notFull.wait(lock, [this]() {
+                return queue.size() < queueSize;
+            });
+            queue.push_back(std::move(chunk));
+        }
+        notEmpty.notify_one();
+    }
+
+    void work()
+    {
+        Error err;
+        ContextPool::Lease lease = pool.acquire(&err);
+        std::string chunk;
+        while (fetch(chunk)) {
+            ImportResult result;
+            if (!lease) {
+                result = ImportResult(err);
+            } else {
+                result = lease->importKeys(Data(chunk.data(), chunk.size(), false));
+            }
+            accumulator.add(result);
+
+            const std::lock_guard<std::mutex> lock(progressMutex);
+            progress.bytesImported += chunk.size();
+            ++progress.chunksImported;
+            if (result.error()) {
+                ++progress.failedChunks;
+            }
+            if (callback) {
+                callback(progress);
+            }
+        }
+    }
+
+    void addBytesRead(size_t bytes)
+    {
+        const std::lock_guard<std::mutex> lock(progressMutex);
+        progress.bytesRead += bytes;
+    }
+
+    ContextPool &pool;
+    const unsigned int concurrency;
+    const size_t chunkSize;
+    const size_t queueSize;
+
+    std::mutex queueMutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<std::string> queue;
+    bool finished;
+
+    ImportAccumulator accumulator;
+
+    mutable std::mutex progressMutex;
+    Progress progress;
+    ProgressCallback callback;
+};
+
+BulkImporter::BulkImporter(ContextPool &pool, unsigned int concurrency, size_t chunkSize)
+    : d(new Private(pool, concurrency, chunkSize))
+{
+}
+
+BulkImporter::~BulkImporter() = default;
+
+unsigned int BulkImporter::concurrency() const
+{
+    return d->concurrency;
+}
+
+size_t BulkImporter::chunkSize() const
+{
+    return d->chunkSize;
+}
+
+void BulkImporter::setProgressCallback(const ProgressCallback &callback)
+{
+    const std::lock_guard<std::mutex> lock(d->progressMutex);
+    d->callback = callback;
+}
+
+ImportResult BulkImporter::importKeys(Data &keyData)
+{
+    d->accumulator.clear();
+    {
+        const std::lock_guard<std::mutex> lock(d->progressMutex);
+        d->progress = Progress();
+    }
+    d->finished = false;
+
+    std::vector<std::thread> workers;
+    workers.reserve(d->concurrency);
+    for (unsigned int i = 0; i < d->concurrency; ++i) {
+        workers.emplace_back(&Private::work, d.get());
+    }
+
+    KeyPacketSplitter splitter(d->chunkSize);
+    std::vector<char> buffer(64 * 1024);
+    std::string chunk;
+    Error readError;
+    while (true) {
+        const auto n = keyData.read(buffer.data(), buffer.size());
+        if (n < 0) {
+            readError = Error::fromSystemError();
+            break;
+        }
+        if (n == 0) {
+            break;
+        }
+        d->addBytesRead(n);
+        splitter.feed(buffer.data(), n);
+        while (splitter.next(chunk)) {
+            d->push(std::move(chunk));
+            chunk.clear();
+        }
+        if (splitter.error()) {
+            // the rest of the stream cannot be split on key boundaries
+            break;
+        }
+    }
+    if (!readError && !splitter.error()) {
+        while (splitter.finish(chunk)) {
+            d->push(std::move(chunk));
+            chunk.clear();
+        }
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(d->queueMutex);
+        d->finished = true;
+    }
+    d->notEmpty.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+
+    if (readError) {
+        d->accumulator.add(ImportResult(readError));
+    }
+    if (const Error splitError = splitter.error()) {
+        d->accumulator.add(ImportResult(splitError));
+    }
+    return d->accumulator.result();
+}
+
+BulkImporter::Progress BulkImporter::progress() const
+{
+    const std::lock_guard<std::mutex> lock(d->progressMutex);
+    return d->progress;
+}
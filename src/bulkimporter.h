@@ -0,0 +1,95 @@
+/*
+  bulkimporter.h - imports large keyrings in parallel chunks
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_BULKIMPORTER_H__
+#define __GPGMEPP_BULKIMPORTER_H__
+
+#include "global.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace GpgME
+{
+
+class ContextPool;
+class Data;
+class ImportResult;
+
+/**
+ * Imports a large binary keyring, e.g. a keyserver dump, in chunks with
+ * the contexts of a ContextPool.
+ *
+ * The key data is split on key boundaries with a KeyPacketSplitter while
+ * it is read. The chunks are passed through a bounded queue to
+ * @p concurrency worker threads, which import them with importKeys() on
+ * leased contexts. The results are merged with an ImportAccumulator.
+ *
+ * gpg serializes the updates of a keyring with a lock, so more workers
+ * mainly help to parse the keys in parallel. With a concurrency of 1 the
+ * reading and splitting of the data is still pipelined with the import.
+ *
+ * Reading stops at data which cannot be split (e.g. ASCII armored data);
+ * the chunks before it are imported and the result has the error of the
+ * KeyPacketSplitter. The pool must outlive the importer.
+ */
+class GPGMEPP_EXPORT BulkImporter
+{
+public:
+    struct Progress {
+        /** The number of bytes read from the key data. */
+        uint64_t bytesRead = 0;
+        /** The number of bytes of all imported chunks. */
+        uint64_t bytesImported = 0;
+        unsigned long chunksImported = 0;
+        unsigned long failedChunks = 0;
+    };
+    /** Called (serialized) by the worker threads after every chunk. */
+    using ProgressCallback = std::function<void(const Progress &progress)>;
+
+    explicit BulkImporter(ContextPool &pool, unsigned int concurrency = 4, size_t chunkSize = 4 * 1024 * 1024);
+    ~BulkImporter();
+
+    unsigned int concurrency() const;
+    size_t chunkSize() const;
+
+    void setProgressCallback(const ProgressCallback &callback);
+
+    /** Imports all keys of @p keyData and returns the merged result. */
+    ImportResult importKeys(Data &keyData);
+
+    /** Returns the progress of the last import. */
+    Progress progress() const;
+
+private:
+    BulkImporter(const BulkImporter &) = delete;
+    BulkImporter &operator=(const BulkImporter &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_BULKIMPORTER_H__
@@ -0,0 +1,180 @@
+/*
+  bulkkeymanager.cpp - key management operations on many keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <bulkkeymanager.h>
+#include <contextpool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+
+using namespace GpgME;
+
+class BulkKeyManager::Private
+{
+public:
+    using Operation = std::function<Error(Context &ctx, size_t index)>;
+
+    Private(ContextPool &p, unsigned int c)
+        : pool(p),
+          concurrency(c ? c : 1)
+    {
+    }
+
+    // runs op for the indexes in tasks and returns the errors by index
+    std::vector<Error> run(size_t count, const std::vector<size_t> &tasks, const Operation &op)
+    {
+        std::vector<Error> errors(count);
+        std::atomic<size_t> next(0);
+        const auto work = [this, &tasks, &op, &errors, &next]() {
+            Error err;
+            ContextPool::Lease lease = pool.acquire(&err);
+            for (size_t i = next++; i < tasks.size(); i = next++) {
+                // every worker writes to a different element
+                errors[tasks[i]] = lease ? op(*lease, tasks[i]) : err;
+            }
+        };
+        const size_t numWorkers = std::min<size_t>(concurrency, tasks.size());
+        std::vector<std::thread> workers;
+        workers.reserve(numWorkers);
+        for (size_t i = 0; i < numWorkers; ++i) {
+            workers.emplace_back(work);
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        return errors;
+    }
+
+    // like run, but processes every key only once
+    std::vector<Error> runUnique(const std::vector<Key> &keys, const Operation &op)
+    {
+        std::vector<size_t> tasks;
+        tasks.reserve(keys.size());
+        // the first occurrence of every key
+        std::vector<size_t> first(keys.size());
+        std::unordered_map<std::string, size_t> seen;
+        seen.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            const char *const fpr = keys[i].primaryFingerprint();
+            first[i] = i;
+            if (fpr) {
+                const auto res = seen.emplace(fpr, i);
+                if (!res.second) {
+                    first[i] = res.first->second;
+                    continue;
+                }
+            }
+            tasks.push_back(i);
+        }
+        std::vector<Error> errors = run(keys.size(), tasks, op);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            errors[i] = errors[first[i]];
+        }
+        return errors;
+    }
+
+    ContextPool &pool;
+    const unsigned int concurrency;
+};
+
+BulkKeyManager::BulkKeyManager(ContextPool &pool, unsigned int concurrency)
+    : d(new Private(pool, concurrency))
+{
+}
+
+BulkKeyManager::~BulkKeyManager() = default;
+
+unsigned int BulkKeyManager::concurrency() const
+{
+    return d->concurrency;
+}
+
+std::vector<Error> BulkKeyManager::deleteKeys(const std::vector<Key> &keys, DeletionFlags flags)
+{
+    return d->runUnique(keys, [&keys, flags](Context &ctx, size_t i) {
+        return ctx.deleteKey(keys[i], flags);
+    });
+}
+
+std::vector<Error> BulkKeyManager::setExpire(const std::vector<Key> &keys, unsigned long expires,
+                                             Context::SetExpireFlags flags)
+{
+    return d->runUnique(keys, [&keys, expires, flags](Context &ctx, size_t i) {
+        return ctx.setExpire(keys[i], expires, std::vector<Subkey>(), flags);
+    });
+}
+
+std::vector<Error> BulkKeyManager::setOwnerTrust(const std::vector<std::pair<Key, Key::OwnerTrust>> &trusts)
+{
+    std::vector<Key> keys;
+    keys.reserve(trusts.size());
+    for (const auto &trust : trusts) {
+        keys.push_back(trust.first);
+    }
+    return d->runUnique(keys, [&trusts](Context &ctx, size_t i) {
+        return ctx.setOwnerTrust(trusts[i].first, trusts[i].second);
+    });
+}
+
+std::vector<Error> BulkKeyManager::setKeysEnabled(const std::vector<Key> &keys, bool enabled)
+{
+    return d->runUnique(keys, [&keys, enabled](Context &ctx, size_t i) {
+        return ctx.setKeyEnabled(keys[i], enabled);
+    });
+}
+
+std::vector<Error> BulkKeyManager::signKeys(const std::vector<Key> &keys, const Key &signingKey,
+                                            unsigned long expires, Context::KeySignFlags flags)
+{
+    return d->runUnique(keys, [&keys, &signingKey, expires, flags](Context &ctx, size_t i) {
+        const std::vector<Key> signers = ctx.signingKeys();
+        ctx.clearSigningKeys();
+        Error err = ctx.addSigningKey(signingKey);
+        if (!err) {
+            err = ctx.signKey(keys[i], std::vector<UserID>(), expires, flags);
+        }
+        // the context goes back to the pool
+        ctx.clearSigningKeys();
+        for (const Key &signer : signers) {
+            ctx.addSigningKey(signer);
+        }
+        return err;
+    });
+}
+
+std::vector<Error> BulkKeyManager::revokeUserIDs(const std::vector<std::pair<Key, std::string>> &userIDs)
+{
+    std::vector<size_t> tasks(userIDs.size());
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        tasks[i] = i;
+    }
+    return d->run(userIDs.size(), tasks, [&userIDs](Context &ctx, size_t i) {
+        return ctx.revUid(userIDs[i].first, userIDs[i].second.c_str());
+    });
+}
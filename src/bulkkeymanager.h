@@ -0,0 +1,94 @@
+/*
+  bulkkeymanager.h - key management operations on many keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_BULKKEYMANAGER_H__
+#define __GPGMEPP_BULKKEYMANAGER_H__
+
+#include "global.h"
+#include "context.h"
+#include "error.h"
+#include "key.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GpgME
+{
+
+class ContextPool;
+
+/**
+ * Runs key management operations (deletion, expiry, owner trust, ...) on
+ * many keys with the contexts of a ContextPool.
+ *
+ * gpgme runs one engine command per key for all of these operations. The
+ * operations are therefore distributed over @p concurrency worker threads
+ * with a leased context each, so that the start-up of the next command
+ * overlaps with the running ones; gpg serializes the actual keyring
+ * updates with its lock.
+ *
+ * All functions return one error per key in the order of the given keys.
+ * Duplicates of a key (by fingerprint) are processed only once; they get
+ * the error of the first occurrence. The pool must outlive the manager.
+ */
+class GPGMEPP_EXPORT BulkKeyManager
+{
+public:
+    explicit BulkKeyManager(ContextPool &pool, unsigned int concurrency = 4);
+    ~BulkKeyManager();
+
+    unsigned int concurrency() const;
+
+    std::vector<Error> deleteKeys(const std::vector<Key> &keys, DeletionFlags flags);
+
+    std::vector<Error> setExpire(const std::vector<Key> &keys, unsigned long expires,
+                                 Context::SetExpireFlags flags = Context::SetExpireDefault);
+
+    /** Requires gpg 2.4.6. */
+    std::vector<Error> setOwnerTrust(const std::vector<std::pair<Key, Key::OwnerTrust>> &trusts);
+
+    /** Requires gpg 2.4.6. */
+    std::vector<Error> setKeysEnabled(const std::vector<Key> &keys, bool enabled);
+
+    /** Certifies all user IDs of the keys with @p signingKey.
+     * @see Context::signKeys */
+    std::vector<Error> signKeys(const std::vector<Key> &keys, const Key &signingKey,
+                                unsigned long expires = 0, Context::KeySignFlags flags = Context::KeySignDefault);
+
+    /** Revokes the user ID of each pair. Pairs with the same key are not
+     * coalesced. */
+    std::vector<Error> revokeUserIDs(const std::vector<std::pair<Key, std::string>> &userIDs);
+
+private:
+    BulkKeyManager(const BulkKeyManager &) = delete;
+    BulkKeyManager &operator=(const BulkKeyManager &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_BULKKEYMANAGER_H__
@@ -0,0 +1,223 @@
+/*
+  cachingpassphraseprovider.cpp - caches the passphrases of another provider
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <cachingpassphraseprovider.h>
+#include <securearena.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace GpgME;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Entry {
+    // allocated from the secure arena
+    char *passphrase = nullptr;
+    Clock::time_point expires;
+    unsigned int uses = 0;
+};
+
+// a request to the target provider which other requests wait for
+struct Fetch {
+    bool done = false;
+    bool canceled = false;
+};
+}
+
+class CachingPassphraseProvider::Private
+{
+public:
+    Private(PassphraseProvider *t, std::chrono::seconds ttl, unsigned int m)
+        : target(t),
+          timeToLive(ttl),
+          maximumUses(m)
+    {
+    }
+
+    ~Private()
+    {
+        clear();
+    }
+
+    void erase(std::unordered_map<std::string, Entry>::iterator it)
+    {
+        SecureArena::instance().deallocate(it->second.passphrase);
+        entries.erase(it);
+    }
+
+    void clear()
+    {
+        for (auto &entry : entries) {
+            SecureArena::instance().deallocate(entry.second.passphrase);
+        }
+        entries.clear();
+    }
+
+    // returns a copy of the cached passphrase or nullptr; must be called
+    // with the mutex held
+    char *take(const std::string &id)
+    {
+        const auto it = entries.find(id);
+        if (it == entries.end()) {
+            return nullptr;
+        }
+        Entry &entry = it->second;
+        if (Clock::now() >= entry.expires) {
+            erase(it);
+            return nullptr;
+        }
+        char *const copy = SecureArena::instance().strdup(entry.passphrase);
+        if (copy && maximumUses && ++entry.uses >= maximumUses) {
+            erase(it);
+        }
+        return copy;
+    }
+
+    PassphraseProvider *const target;
+    const std::chrono::seconds timeToLive;
+    const unsigned int maximumUses;
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<std::string, std::shared_ptr<Fetch>> fetches;
+    Statistics stats;
+};
+
+CachingPassphraseProvider::CachingPassphraseProvider(PassphraseProvider *target, std::chrono::seconds timeToLive,
+                                                     unsigned int maximumUses)
+    : d(new Private(target, timeToLive, maximumUses))
+{
+}
+
+CachingPassphraseProvider::~CachingPassphraseProvider() = default;
+
+PassphraseProvider *CachingPassphraseProvider::target() const
+{
+    return d->target;
+}
+
+char *CachingPassphraseProvider::getPassphrase(const char *useridHint, const char *description,
+                                               bool previousWasBad, bool &canceled)
+{
+    canceled = false;
+    if (!d->target) {
+        canceled = true;
+        return nullptr;
+    }
+    std::string id = useridHint ? useridHint : "";
+    id += '\n';
+    id += description ? description : "";
+
+    std::shared_ptr<Fetch> fetch;
+    {
+        std::unique_lock<std::mutex> lock(d->mutex);
+        if (previousWasBad) {
+            const auto it = d->entries.find(id);
+            if (it != d->entries.end()) {
+                d->erase(it);
+            }
+        }
+        bool joined = false;
+        while (true) {
+            const auto running = d->fetches.find(id);
+            if (running == d->fetches.end()) {
+                break;
+            }
+            // wait for the fetch of another request for the same key
+            ++d->stats.joined;
+            const std::shared_ptr<Fetch> other = running->second;
+            d->cv.wait(lock, [&other]() {
+                return other->done;
+            });
+            if (other->canceled) {
+                canceled = true;
+                return nullptr;
+            }
+            joined = true;
+        }
+        // a passphrase fetched while waiting is not the bad one
+        if (!previousWasBad || joined) {
+            if (char *const passphrase = d->take(id)) {
+                ++d->stats.hits;
+                return passphrase;
+            }
+        }
+        ++d->stats.fetches;
+        fetch = std::make_shared<Fetch>();
+        d->fetches.emplace(id, fetch);
+    }
+
+    char *const passphrase = d->target->getPassphrase(useridHint, description, previousWasBad, canceled);
+    char *const cached = (!canceled && passphrase) ? SecureArena::instance().strdup(passphrase) : nullptr;
+
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    fetch->done = true;
+    // without a passphrase the waiters retry; only a cancellation by the
+    // user is passed on to them
+    fetch->canceled = canceled;
+    d->fetches.erase(id);
+    if (cached) {
+        const auto it = d->entries.find(id);
+        if (it != d->entries.end()) {
+            d->erase(it);
+        }
+        if (d->maximumUses == 1) {
+            // used up by this request
+            SecureArena::instance().deallocate(cached);
+        } else {
+            Entry &entry = d->entries[id];
+            entry.passphrase = cached;
+            entry.expires = Clock::now() + d->timeToLive;
+            entry.uses = 1;
+        }
+    }
+    d->cv.notify_all();
+    return passphrase;
+}
+
+void CachingPassphraseProvider::clear()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->clear();
+}
+
+unsigned int CachingPassphraseProvider::size() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->entries.size();
+}
+
+CachingPassphraseProvider::Statistics CachingPassphraseProvider::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
@@ -0,0 +1,92 @@
+/*
+  cachingpassphraseprovider.h - caches the passphrases of another provider
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_CACHINGPASSPHRASEPROVIDER_H__
+#define __GPGMEPP_CACHINGPASSPHRASEPROVIDER_H__
+
+#include "global.h"
+#include "interfaces/passphraseprovider.h"
+
+#include <chrono>
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * A passphrase provider which caches the passphrases returned by another
+ * provider, e.g. one fetching them from a remote vault, for use with the
+ * loopback pinentry mode.
+ *
+ * The passphrases are cached by user ID hint and description, i.e. by key,
+ * in memory of the SecureArena. A cached passphrase is dropped when its
+ * time to live has passed, when it has been used the maximum number of
+ * times, or when the engine reports that it was wrong. Concurrent requests
+ * for the same passphrase wait for a single request to the target
+ * provider; if that one is cancelled, then the waiting requests are
+ * cancelled as well.
+ *
+ * The provider may be shared by several contexts in different threads.
+ * The target provider is never called concurrently for the same key.
+ */
+class GPGMEPP_EXPORT CachingPassphraseProvider : public PassphraseProvider
+{
+public:
+    struct Statistics {
+        /** Requests served from the cache. */
+        unsigned long hits = 0;
+        /** Requests passed to the target provider. */
+        unsigned long fetches = 0;
+        /** Requests which waited for a fetch of another request. */
+        unsigned long joined = 0;
+    };
+
+    /** A @p maximumUses of 0 means no limit. The target must outlive the
+     * caching provider. */
+    explicit CachingPassphraseProvider(PassphraseProvider *target,
+                                       std::chrono::seconds timeToLive = std::chrono::seconds(300),
+                                       unsigned int maximumUses = 0);
+    ~CachingPassphraseProvider();
+
+    PassphraseProvider *target() const;
+
+    char *getPassphrase(const char *useridHint, const char *description,
+                        bool previousWasBad, bool &canceled) override;
+
+    /** Drops all cached passphrases. */
+    void clear();
+    unsigned int size() const;
+
+    Statistics statistics() const;
+
+private:
+    CachingPassphraseProvider(const CachingPassphraseProvider &) = delete;
+    CachingPassphraseProvider &operator=(const CachingPassphraseProvider &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_CACHINGPASSPHRASEPROVIDER_H__
@@ -27,12 +27,14 @@
 #endif
 
 #include "callbacks.h"
+#include "data_p.h"
 #include "util.h"
 
 #include <interfaces/progressprovider.h>
 #include <interfaces/passphraseprovider.h>
 #include <interfaces/dataprovider.h>
 #include <error.h>
+#include <securearena.h>
 
 #include <gpgme.h>
 #include <gpg-error.h>
@@ -51,6 +53,8 @@ static inline gpgme_error_t make_err_from_syserror()
 using GpgME::ProgressProvider;
 using GpgME::PassphraseProvider;
 using GpgME::DataProvider;
+using GpgME::Data;
+using GpgME::SecureArena;
 
 void progress_callback(void *opaque, const char *what,
                        int type, int current, int total)
@@ -61,15 +65,6 @@ void progress_callback(void *opaque, const char *what,
     }
 }
 
-/* To avoid that a compiler optimizes certain memset calls away, these
-   macros may be used instead. */
-#define wipememory2(_ptr,_set,_len) do { \
-        volatile char *_vptr=(volatile char *)(_ptr); \
-        size_t _vlen=(_len); \
-        while(_vlen) { *_vptr=(_set); _vptr++; _vlen--; } \
-    } while(0)
-#define wipememory(_ptr,_len) wipememory2(_ptr,0,_len)
-
 gpgme_error_t passphrase_callback(void *opaque, const char *uid_hint, const char *desc,
                                   int prev_was_bad, int fd)
 {
@@ -94,40 +89,71 @@ gpgme_error_t passphrase_callback(void *opaque, const char *uid_hint, const char
         }
     }
 
-    if (passphrase && *passphrase) {
-        wipememory(passphrase, std::strlen(passphrase));
+    if (passphrase && SecureArena::instance().owns(passphrase)) {
+        // wipes the passphrase
+        SecureArena::instance().deallocate(passphrase);
+    } else {
+        if (passphrase && *passphrase) {
+            SecureArena::wipe(passphrase, std::strlen(passphrase));
+        }
+        free(passphrase);
     }
-    free(passphrase);
     gpgme_io_write(fd, "\n", 1);
     return err;
 }
 
+// every call of the callbacks moves the position or changes the data
+static DataProvider *
+data_provider(void *opaque)
+{
+    const Data::Private *const p = static_cast<Data::Private *>(opaque);
+    if (!p) {
+        return nullptr;
+    }
+    p->invalidateType();
+    return p->provider;
+}
+
 static gpgme_ssize_t
 data_read_callback(void *opaque, void *buf, size_t buflen)
 {
-    DataProvider *provider = static_cast<DataProvider *>(opaque);
+    DataProvider *provider = data_provider(opaque);
     if (!provider) {
         gpgme_err_set_errno(gpgme_err_code_to_errno(GPG_ERR_EINVAL));
         return -1;
     }
-    return (gpgme_ssize_t)provider->read(buf, buflen);
+    Data::Private::IoStatsBlock *const stats = static_cast<Data::Private *>(opaque)->enabledIoStats();
+    if (!stats) {
+        return (gpgme_ssize_t)provider->read(buf, buflen);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const gpgme_ssize_t n = provider->read(buf, buflen);
+    stats->provider.countRead(n, std::chrono::steady_clock::now() - start);
+    return n;
 }
 
 static gpgme_ssize_t
 data_write_callback(void *opaque, const void *buf, size_t buflen)
 {
-    DataProvider *provider = static_cast<DataProvider *>(opaque);
+    DataProvider *provider = data_provider(opaque);
     if (!provider) {
         gpgme_err_set_errno(gpgme_err_code_to_errno(GPG_ERR_EINVAL));
         return -1;
     }
-    return (gpgme_ssize_t)provider->write(buf, buflen);
+    Data::Private::IoStatsBlock *const stats = static_cast<Data::Private *>(opaque)->enabledIoStats();
+    if (!stats) {
+        return (gpgme_ssize_t)provider->write(buf, buflen);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const gpgme_ssize_t n = provider->write(buf, buflen);
+    stats->provider.countWrite(n, std::chrono::steady_clock::now() - start);
+    return n;
 }
 
 static gpgme_off_t
 data_seek_callback(void *opaque, gpgme_off_t offset, int whence)
 {
-    DataProvider *provider = static_cast<DataProvider *>(opaque);
+    DataProvider *provider = data_provider(opaque);
     if (!provider) {
         gpgme_err_set_errno(gpgme_err_code_to_errno(GPG_ERR_EINVAL));
         return -1;
@@ -136,12 +162,19 @@ data_seek_callback(void *opaque, gpgme_off_t offset, int whence)
         gpgme_err_set_errno(gpgme_err_code_to_errno(GPG_ERR_EINVAL));
         return -1;
     }
-    return provider->seek(offset, whence);
+    Data::Private::IoStatsBlock *const stats = static_cast<Data::Private *>(opaque)->enabledIoStats();
+    if (!stats) {
+        return provider->seek(offset, whence);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const gpgme_off_t pos = provider->seek(offset, whence);
+    stats->provider.countSeek(std::chrono::steady_clock::now() - start);
+    return pos;
 }
 
 static void data_release_callback(void *opaque)
 {
-    DataProvider *provider = static_cast<DataProvider *>(opaque);
+    DataProvider *provider = data_provider(opaque);
     if (provider) {
         provider->release();
     }
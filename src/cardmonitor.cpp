@@ -0,0 +1,435 @@
+/*
+  cardmonitor.cpp - a cached smartcard status with change notifications
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <cardmonitor.h>
+#include <assuansession.h>
+#include <context.h>
+#include <data.h>
+#include <defaultassuantransaction.h>
+#include <interfaces/assuantransaction.h>
+#include <scdgetinfoassuantransaction.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+using namespace GpgME;
+
+namespace
+{
+
+// refreshes the monitor for every report of DEVINFO --watch
+class WatchTransaction : public AssuanTransaction
+{
+public:
+    explicit WatchTransaction(const std::function<void()> &changed)
+        : mChanged(changed)
+    {
+    }
+
+    Error data(const char *data, size_t datalen) override
+    {
+        (void)data;
+        (void)datalen;
+        return Error();
+    }
+
+    Data inquire(const char *name, const char *args, Error &err) override
+    {
+        (void)name;
+        (void)args;
+        err = Error::fromCode(GPG_ERR_ASS_UNKNOWN_INQUIRE);
+        return Data::null;
+    }
+
+    Error status(const char *status, const char *args) override
+    {
+        (void)args;
+        // a report is a DEVINFO_START line, a DEVICE line per card and a
+        // DEVINFO_END line; refresh once per report
+        if (status && std::strcmp(status, "DEVINFO_START") != 0 && std::strcmp(status, "DEVICE") != 0) {
+            mChanged();
+        }
+        return Error();
+    }
+
+private:
+    const std::function<void()> mChanged;
+};
+
+bool isNoCard(const Error &err)
+{
+    switch (err.code()) {
+    case GPG_ERR_CARD_NOT_PRESENT:
+    case GPG_ERR_CARD_REMOVED:
+    case GPG_ERR_ENODEV:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isUnsupported(const Error &err)
+{
+    switch (err.code()) {
+    case GPG_ERR_UNKNOWN_OPTION:
+    case GPG_ERR_UNKNOWN_COMMAND:
+    case GPG_ERR_ASS_UNKNOWN_CMD:
+    case GPG_ERR_NOT_SUPPORTED:
+    case GPG_ERR_NOT_IMPLEMENTED:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// parses "<keygrip> <keyref> [<usage> [...]]"
+CardMonitor::CardKey parseKeyPairInfo(const std::string &args)
+{
+    CardMonitor::CardKey key;
+    std::istringstream stream(args);
+    stream >> key.keygrip >> key.keyRef >> key.usage;
+    if (key.usage == "-") {
+        key.usage.clear();
+    }
+    return key;
+}
+
+bool sameCardKeys(const std::vector<CardMonitor::CardKey> &a, const std::vector<CardMonitor::CardKey> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].keygrip != b[i].keygrip || a[i].keyRef != b[i].keyRef || a[i].usage != b[i].usage) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameState(const CardMonitor::Status &a, const CardMonitor::Status &b)
+{
+    return a.readers == b.readers
+           && a.cardPresent == b.cardPresent
+           && a.serialNumber == b.serialNumber
+           && sameCardKeys(a.keys, b.keys)
+           && a.error.code() == b.error.code();
+}
+
+}
+
+class CardMonitor::Private
+{
+public:
+    Private(const char *s, const char *h, std::chrono::milliseconds i)
+        : socketName(s ? s : ""),
+          homeDirectory(h ? h : ""),
+          pollInterval(i.count() > 0 ? i : std::chrono::milliseconds(std::chrono::seconds(2))),
+          session(s, h),
+          nextId(1),
+          running(false),
+          stopping(false),
+          watching(false),
+          watchCtx(nullptr)
+    {
+    }
+
+    // queries scdaemon; the fields of a failed query keep their old values
+    Error query(Status &status)
+    {
+        ScdGetInfoAssuanTransaction readerList(ScdGetInfoAssuanTransaction::ReaderList);
+        Error err = session.transact("SCD GETINFO reader_list", &readerList);
+        if (err) {
+            return err;
+        }
+        status.readers = readerList.readerList();
+
+        DefaultAssuanTransaction serialNo;
+        err = session.transact("SCD SERIALNO", &serialNo);
+        if (isNoCard(err)) {
+            status.cardPresent = false;
+            status.serialNumber.clear();
+            status.keys.clear();
+            return Error();
+        } else if (err) {
+            return err;
+        }
+        const std::string serial = serialNo.firstStatusLine("SERIALNO");
+        status.cardPresent = true;
+        status.serialNumber = serial.substr(0, serial.find(' '));
+
+        DefaultAssuanTransaction learn;
+        err = session.transact("SCD LEARN --keypairinfo", &learn);
+        if (isNoCard(err)) {
+            // removed in the meantime; the watch reports this soon
+            status.cardPresent = false;
+            status.serialNumber.clear();
+            status.keys.clear();
+            return Error();
+        } else if (err) {
+            return err;
+        }
+        status.keys.clear();
+        for (const std::string &info : learn.statusLine("KEYPAIRINFO")) {
+            status.keys.push_back(parseKeyPairInfo(info));
+        }
+        return Error();
+    }
+
+    Error refresh()
+    {
+        const std::lock_guard<std::recursive_mutex> refreshLock(refreshMutex);
+        Status next = status();
+        next.error = query(next);
+        std::vector<std::pair<unsigned int, Handler>> toNotify;
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (sameState(current, next)) {
+                return next.error;
+            }
+            next.generation = current.generation + 1;
+            current = next;
+            toNotify = handlers;
+        }
+        for (const auto &handler : toNotify) {
+            if (isSubscribed(handler.first)) {
+                handler.second(next);
+            }
+        }
+        return next.error;
+    }
+
+    Status status() const
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return current;
+    }
+
+    bool isSubscribed(unsigned int id) const
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &handler : handlers) {
+            if (handler.first == id) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // waits for the poll interval; returns false if the monitor is stopped
+    bool pause()
+    {
+        std::unique_lock<std::mutex> lock(watchMutex);
+        return !stopCondition.wait_for(lock, pollInterval, [this]() { return stopping; });
+    }
+
+    // runs DEVINFO --watch until it fails or the monitor is stopped
+    Error watch()
+    {
+        Error err;
+        const std::unique_ptr<Context> ctx(Context::createForEngine(AssuanEngine, &err));
+        if (!ctx) {
+            return err ? err : Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+        }
+        if (!socketName.empty()) {
+            err = ctx->setEngineFileName(socketName.c_str());
+        }
+        if (!err && !homeDirectory.empty()) {
+            err = ctx->setEngineHomeDirectory(homeDirectory.c_str());
+        }
+        if (err) {
+            return err;
+        }
+        {
+            // started with the mutex locked, so that stop() cannot miss it
+            const std::lock_guard<std::mutex> lock(watchMutex);
+            if (stopping) {
+                return Error::fromCode(GPG_ERR_CANCELED);
+            }
+            err = ctx->startAssuanTransaction("SCD DEVINFO --watch",
+                                              std::unique_ptr<AssuanTransaction>(new WatchTransaction([this]() {
+                                                  refresh();
+                                              })));
+            if (err) {
+                return err;
+            }
+            watchCtx = ctx.get();
+            watching = true;
+        }
+        // the error of the server is the result of the operation
+        err = ctx->wait();
+        const std::lock_guard<std::mutex> lock(watchMutex);
+        watchCtx = nullptr;
+        return err;
+    }
+
+    void run()
+    {
+        bool supported = true;
+        while (supported) {
+            const Error err = watch();
+            watching = false;
+            if (isUnsupported(err)) {
+                supported = false;
+            } else if (!pause()) {
+                return;
+            } else {
+                // e.g. gpg-agent was restarted; catch up before watching again
+                refresh();
+            }
+        }
+        while (pause()) {
+            refresh();
+        }
+    }
+
+    const std::string socketName;
+    const std::string homeDirectory;
+    const std::chrono::milliseconds pollInterval;
+    AssuanSession session;
+
+    // serializes the refreshes and the notifications; recursive so that
+    // handlers may call refresh() and unsubscribe()
+    std::recursive_mutex refreshMutex;
+
+    mutable std::mutex mutex;
+    Status current;
+    std::vector<std::pair<unsigned int, Handler>> handlers;
+    unsigned int nextId;
+
+    std::mutex watchMutex;
+    std::condition_variable stopCondition;
+    std::thread thread;
+    bool running;
+    bool stopping;
+    std::atomic<bool> watching;
+    Context *watchCtx;
+};
+
+CardMonitor::CardMonitor(const char *socketName, const char *homeDirectory, std::chrono::milliseconds pollInterval)
+    : d(new Private(socketName, homeDirectory, pollInterval))
+{
+}
+
+CardMonitor::~CardMonitor()
+{
+    stop();
+}
+
+Error CardMonitor::start()
+{
+    {
+        const std::lock_guard<std::mutex> lock(d->watchMutex);
+        if (d->running) {
+            return Error();
+        }
+    }
+    const Error err = d->refresh();
+    const std::lock_guard<std::mutex> lock(d->watchMutex);
+    if (!d->running) {
+        d->running = true;
+        d->stopping = false;
+        d->thread = std::thread(&Private::run, d.get());
+    }
+    return err;
+}
+
+void CardMonitor::stop()
+{
+    {
+        const std::lock_guard<std::mutex> lock(d->watchMutex);
+        if (!d->running) {
+            return;
+        }
+        d->stopping = true;
+        if (d->watchCtx) {
+            d->watchCtx->cancelPendingOperation();
+        }
+    }
+    d->stopCondition.notify_all();
+    d->thread.join();
+    const std::lock_guard<std::mutex> lock(d->watchMutex);
+    d->running = false;
+    d->stopping = false;
+}
+
+bool CardMonitor::isRunning() const
+{
+    const std::lock_guard<std::mutex> lock(d->watchMutex);
+    return d->running;
+}
+
+bool CardMonitor::isWatching() const
+{
+    return d->watching;
+}
+
+Error CardMonitor::refresh()
+{
+    return d->refresh();
+}
+
+CardMonitor::Status CardMonitor::status() const
+{
+    return d->status();
+}
+
+bool CardMonitor::isCardPresent() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->current.cardPresent;
+}
+
+std::string CardMonitor::serialNumber() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->current.serialNumber;
+}
+
+unsigned int CardMonitor::subscribe(const Handler &handler)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    const unsigned int id = d->nextId++;
+    d->handlers.emplace_back(id, handler);
+    return id;
+}
+
+void CardMonitor::unsubscribe(unsigned int id)
+{
+    const std::lock_guard<std::recursive_mutex> refreshLock(d->refreshMutex);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    for (auto it = d->handlers.begin(); it != d->handlers.end(); ++it) {
+        if (it->first == id) {
+            d->handlers.erase(it);
+            return;
+        }
+    }
+}
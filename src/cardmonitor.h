@@ -0,0 +1,131 @@
+/*
+  cardmonitor.h - a cached smartcard status with change notifications
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_CARDMONITOR_H__
+#define __GPGMEPP_CARDMONITOR_H__
+
+#include "global.h"
+#include "error.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Keeps a snapshot of the smartcard readers, the inserted card and its keys
+ * and notifies subscribers when the snapshot changes.
+ *
+ * A monitor thread runs "SCD DEVINFO --watch" on its own connection to
+ * gpg-agent, so that scdaemon reports the insertion and removal of cards
+ * instead of being polled. After every report the snapshot is refreshed
+ * over a second, persistent connection (see AssuanSession). Scdaemons
+ * without DEVINFO --watch (GnuPG before 2.3) are polled instead.
+ *
+ * Reading the snapshot with status() or isCardPresent() does not talk to
+ * scdaemon. The monitor is thread-safe. The handlers are called one after
+ * the other from the monitor thread or the thread calling refresh();
+ * they must not call stop().
+ */
+class GPGMEPP_EXPORT CardMonitor
+{
+public:
+    /** A key on the card as reported by KEYPAIRINFO. */
+    struct CardKey {
+        std::string keygrip;
+        /** The reference of the key on the card, e.g. "OPENPGP.1". */
+        std::string keyRef;
+        /** The usage flags, e.g. "sc", if scdaemon reports them. */
+        std::string usage;
+    };
+
+    struct Status {
+        /** Counts the changes of the snapshot, starting with 0 before
+         * the first refresh. */
+        unsigned long generation = 0;
+        std::vector<std::string> readers;
+        bool cardPresent = false;
+        std::string serialNumber;
+        std::vector<CardKey> keys;
+        /** The error of the last refresh. The other fields keep the values
+         * of the last successful refresh. A missing card is no error. */
+        Error error;
+    };
+
+    using Handler = std::function<void(const Status &status)>;
+
+    /**
+     * Creates a monitor for the gpg-agent listening on @p socketName (the
+     * default socket if null) for @p homeDirectory. @p pollInterval is used
+     * if scdaemon cannot report card changes and as delay before watching
+     * again after the connection was lost.
+     */
+    explicit CardMonitor(const char *socketName = nullptr, const char *homeDirectory = nullptr,
+                         std::chrono::milliseconds pollInterval = std::chrono::seconds(2));
+    ~CardMonitor();
+
+    /**
+     * Refreshes the snapshot and starts the monitor thread. Returns the
+     * error of the first refresh; the monitor keeps trying anyway, e.g.
+     * until gpg-agent has been started.
+     */
+    Error start();
+    /** Stops the monitor thread. Called by the destructor. */
+    void stop();
+    bool isRunning() const;
+    /** Returns true if the monitor is told about card changes by scdaemon
+     * and false if it polls. */
+    bool isWatching() const;
+
+    /** Queries scdaemon now and notifies the subscribers if the snapshot
+     * changed. Returns the error of the queries. */
+    Error refresh();
+
+    Status status() const;
+    bool isCardPresent() const;
+    std::string serialNumber() const;
+
+    /**
+     * Calls @p handler with the new snapshot whenever it changes. Returns
+     * an id for unsubscribe(). The handler is not called for the current
+     * snapshot.
+     */
+    unsigned int subscribe(const Handler &handler);
+    /** Removes a handler. Waits for a running notification of another
+     * thread, so that the handler is not called after this returns. */
+    void unsubscribe(unsigned int id);
+
+private:
+    CardMonitor(const CardMonitor &) = delete;
+    CardMonitor &operator=(const CardMonitor &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_CARDMONITOR_H__
@@ -27,11 +27,14 @@
 #endif
 
 #include "configuration.h"
+#include "configuration_p.h"
 #include "error.h"
+#include "tracescope.h"
 #include "util.h"
 
 #include <gpgme.h>
 
+#include <atomic>
 #include <iterator>
 #include <algorithm>
 #include <ostream>
@@ -55,11 +58,19 @@ namespace
 struct nodelete {
     template <typename T> void operator()(T *) {}
 };
+
+std::atomic<unsigned int> savedConfigurations(0);
+}
+
+unsigned int GpgME::Configuration::saveGeneration()
+{
+    return savedConfigurations.load();
 }
 
 // static
 std::vector<Component> Component::load(Error &returnedError)
 {
+    TraceScope scope("gpgme.component_load");
 
     //
     // 1. get a context:
@@ -67,6 +78,7 @@ std::vector<Component> Component::load(Error &returnedError)
     gpgme_ctx_t ctx_native = nullptr;
     if (const gpgme_error_t err = gpgme_new(&ctx_native)) {
         returnedError = Error(err);
+        scope.setError(returnedError);
         return std::vector<Component>();
     }
     const shared_gpgme_ctx_t ctx(ctx_native, &gpgme_release);
@@ -77,6 +89,7 @@ std::vector<Component> Component::load(Error &returnedError)
     gpgme_conf_comp_t conf_list_native = nullptr;
     if (const gpgme_error_t err = gpgme_op_conf_load(ctx_native, &conf_list_native)) {
         returnedError = Error(err);
+        scope.setError(returnedError);
         return std::vector<Component>();
     }
     shared_gpgme_conf_comp_t head(conf_list_native, &gpgme_conf_release);
@@ -124,7 +137,9 @@ Error Component::save() const
     //
     // 2. save the config:
     //
-    return Error(gpgme_op_conf_save(ctx.get(), comp.get()));
+    const Error err(gpgme_op_conf_save(ctx.get(), comp.get()));
+    ++savedConfigurations;
+    return err;
 }
 
 const char *Component::name() const
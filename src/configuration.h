@@ -99,6 +99,7 @@ public:
         : comp(gpgme_comp) {}
 
     Component(const Component &other) = default;
+    Component(Component &&other) = default;
     const Component &operator=(const Component &other)
     {
         if (this != &other) {
@@ -152,6 +153,7 @@ public:
         : comp(gpgme_comp), opt(gpgme_opt) {}
 
     Option(const Option &other) = default;
+    Option(Option &&other) = default;
     const Option &operator=(const Option &other)
     {
         if (this != &other) {
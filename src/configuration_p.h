@@ -0,0 +1,38 @@
+/*
+  configuration_p.h - wraps gpgme configuration components (private part)
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_CONFIGURATION_P_H__
+#define __GPGMEPP_CONFIGURATION_P_H__
+
+namespace GpgME
+{
+namespace Configuration
+{
+
+// incremented by every Component::save()
+unsigned int saveGeneration();
+
+}
+}
+
+#endif // __GPGMEPP_CONFIGURATION_P_H__
@@ -0,0 +1,212 @@
+/*
+  configurationcache.cpp - a cache of the configuration of the components
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "configurationcache.h"
+#include "configuration_p.h"
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace GpgME;
+using namespace GpgME::Configuration;
+
+namespace
+{
+// the files which change the output of gpgconf
+const char *const homeConfigFiles[] = {
+    "common.conf", "gpg.conf", "gpgsm.conf", "gpg-agent.conf",
+    "dirmngr.conf", "scdaemon.conf", "keyboxd.conf",
+};
+
+struct FileStamp {
+    long long time = -1;
+    long long size = -1;
+
+    bool operator==(const FileStamp &other) const
+    {
+        return time == other.time && size == other.size;
+    }
+};
+
+FileStamp stampOf(const std::filesystem::path &file)
+{
+    FileStamp stamp;
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(file, ec);
+    if (!ec) {
+        stamp.time = mtime.time_since_epoch().count();
+    }
+    const auto size = std::filesystem::file_size(file, ec);
+    if (!ec) {
+        stamp.size = size;
+    }
+    return stamp;
+}
+
+std::vector<std::filesystem::path> configFiles()
+{
+    std::vector<std::filesystem::path> files;
+    if (const char *sysconfdir = dirInfo("sysconfdir")) {
+        files.push_back(std::filesystem::path(sysconfdir) / "gpgconf.conf");
+    }
+    if (const char *homedir = dirInfo("homedir")) {
+        for (const char *file : homeConfigFiles) {
+            files.push_back(std::filesystem::path(homedir) / file);
+        }
+    }
+    return files;
+}
+}
+
+class ConfigurationCache::Private
+{
+public:
+    Private()
+        : files(configFiles()),
+          loaded(false),
+          generation(0)
+    {
+    }
+
+    std::vector<FileStamp> stamps() const
+    {
+        std::vector<FileStamp> result;
+        result.reserve(files.size());
+        for (const auto &file : files) {
+            result.push_back(stampOf(file));
+        }
+        return result;
+    }
+
+    // called with the mutex locked
+    bool stale(const std::vector<FileStamp> &current) const
+    {
+        return !loaded || generation != saveGeneration() || current != fileStamps;
+    }
+
+    // called with the mutex locked; loads the components if necessary
+    Error ensureLoaded()
+    {
+        std::vector<FileStamp> current = stamps();
+        if (!stale(current)) {
+            return Error();
+        }
+        // read the generation first, so that a concurrent save is not missed
+        const unsigned int gen = saveGeneration();
+        Error err;
+        std::vector<Component> comps = Component::load(err);
+        if (err) {
+            return err;
+        }
+        comps.swap(components);
+        componentIndex.clear();
+        optionIndex.clear();
+        componentIndex.reserve(components.size());
+        for (const Component &component : components) {
+            if (!component.name()) {
+                continue;
+            }
+            componentIndex.emplace(component.name(), component);
+            for (const Option &option : component.options()) {
+                if (option.name()) {
+                    optionIndex.emplace(key(component.name(), option.name()), option);
+                }
+            }
+        }
+        fileStamps.swap(current);
+        generation = gen;
+        loaded = true;
+        return Error();
+    }
+
+    static std::string key(const char *component, const char *option)
+    {
+        std::string result(component);
+        result += '\0';
+        result += option;
+        return result;
+    }
+
+    const std::vector<std::filesystem::path> files;
+    mutable std::mutex mutex;
+    bool loaded;
+    unsigned int generation;
+    std::vector<FileStamp> fileStamps;
+    std::vector<Component> components;
+    std::unordered_map<std::string, Component> componentIndex;
+    std::unordered_map<std::string, Option> optionIndex;
+};
+
+ConfigurationCache::ConfigurationCache()
+    : d(new Private)
+{
+}
+
+ConfigurationCache::~ConfigurationCache() = default;
+
+std::vector<Component> ConfigurationCache::components(Error &err)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    err = d->ensureLoaded();
+    return err ? std::vector<Component>() : d->components;
+}
+
+Component ConfigurationCache::component(const char *name, Error &err)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    err = d->ensureLoaded();
+    if (err || !name) {
+        return Component();
+    }
+    const auto it = d->componentIndex.find(name);
+    return it != d->componentIndex.end() ? it->second : Component();
+}
+
+Option ConfigurationCache::option(const char *component, const char *name, Error &err)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    err = d->ensureLoaded();
+    if (err || !component || !name) {
+        return Option();
+    }
+    const auto it = d->optionIndex.find(Private::key(component, name));
+    return it != d->optionIndex.end() ? it->second : Option();
+}
+
+bool ConfigurationCache::isStale() const
+{
+    const std::vector<FileStamp> current = d->stamps();
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stale(current);
+}
+
+void ConfigurationCache::invalidate()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->loaded = false;
+}
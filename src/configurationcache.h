@@ -0,0 +1,81 @@
+/*
+  configurationcache.h - a cache of the configuration of the components
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_CONFIGURATIONCACHE_H__
+#define __GPGMEPP_CONFIGURATIONCACHE_H__
+
+#include "global.h"
+#include "configuration.h"
+#include "error.h"
+
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+namespace Configuration
+{
+
+/**
+ * Keeps the components loaded with Component::load() and serves them and
+ * their options by name from a hash index.
+ *
+ * The configuration is loaded again on the next access after a component
+ * was saved with Component::save() or after the modification time or the
+ * size of one of the configuration files (gpgconf.conf and the *.conf
+ * files of the components in the home directory) has changed.
+ *
+ * The lookups are thread-safe, but the returned components and options
+ * are shared by all users of the cache without synchronization, so they
+ * must only be read. Changing options (setNewValue(), resetToDefaultValue()
+ * and so on) and saving needs components from Component::load().
+ */
+class GPGMEPP_EXPORT ConfigurationCache
+{
+public:
+    ConfigurationCache();
+    ~ConfigurationCache();
+
+    std::vector<Component> components(Error &err);
+    /** Returns a null component if there is no component @p name. */
+    Component component(const char *name, Error &err);
+    /** Returns a null option if @p component has no option @p name. */
+    Option option(const char *component, const char *name, Error &err);
+
+    /** Returns true if the next access will load the configuration. */
+    bool isStale() const;
+    /** Forces a reload on the next access. */
+    void invalidate();
+
+private:
+    ConfigurationCache(const ConfigurationCache &) = delete;
+    ConfigurationCache &operator=(const ConfigurationCache &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+}
+}
+
+#endif // __GPGMEPP_CONFIGURATIONCACHE_H__
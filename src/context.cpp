@@ -36,8 +36,18 @@
 #include <encryptionresult.h>
 #include <engineinfo.h>
 #include <editinteractor.h>
+#include <enginecapabilities.h>
+#include <gpgadduserideditinteractor.h>
+#include <gpgsetexpirytimeeditinteractor.h>
+#include <gpgsignkeyeditinteractor.h>
 #include <vfsmountresult.h>
 #include <randomresults.h>
+#include <keylistinterner.h>
+#include <keylistrange.h>
+#include <keypacketsplitter.h>
+#include <ringbufferdataprovider.h>
+#include <tracescope.h>
+#include <interfaces/dataprovider.h>
 
 #include <interfaces/assuantransaction.h>
 #include <defaultassuantransaction.h>
@@ -50,9 +60,29 @@
 
 #include <gpgme.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
 #include <functional>
 #include <istream>
+#include <mutex>
 #include <numeric>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char **environ;
+#endif
+
 #ifndef NDEBUG
 #include <iostream>
 using std::cerr;
@@ -124,6 +154,7 @@ Context::KeyListModeSaver::~KeyListModeSaver()
 
 Context::Context(gpgme_ctx_t ctx) : d(new Private(ctx))
 {
+    d->q = this;
 }
 
 Context::~Context()
@@ -235,13 +266,26 @@ Context::Private::Private(gpgme_ctx_t c)
       lastAssuanTransaction(),
       lastEditInteractor(),
       lastCardEditInteractor(),
-      decryptFlags(DecryptNone)
+      decryptFlags(DecryptNone),
+      q(nullptr),
+      instrumentation(nullptr),
+      interner(nullptr),
+      tracer(nullptr),
+      traceParent(nullptr),
+      operationTimeout(0),
+      timeoutArmed(false),
+      timedOut(false),
+      changesKeyring(false),
+      quickEditing(false)
 {
 
 }
 
 Context::Private::~Private()
 {
+    if (timeoutArmed) {
+        disarmTimeout();
+    }
     if (ctx) {
         gpgme_release(ctx);
     }
@@ -249,6 +293,359 @@ Context::Private::~Private()
     delete iocbs;
 }
 
+namespace
+{
+// cancels the operations of the contexts whose deadline has expired; a
+// single thread serves all contexts
+class Watchdog
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static Watchdog &instance()
+    {
+        // never destroyed, so that contexts destroyed after the end of main()
+        // can still disarm it
+        static Watchdog *const watchdog = new Watchdog;
+        return *watchdog;
+    }
+
+    void arm(Context::Private *d, Clock::time_point deadline, bool replace)
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto res = deadlines.emplace(d, deadline);
+        if (!res.second && (replace || deadline < res.first->second)) {
+            res.first->second = deadline;
+        }
+        if (!thread.joinable()) {
+            thread = std::thread(&Watchdog::run, this);
+            thread.detach();
+        }
+        cv.notify_one();
+    }
+
+    void disarm(Context::Private *d)
+    {
+        // once this returns, the watchdog does not touch d anymore
+        const std::lock_guard<std::mutex> lock(mutex);
+        deadlines.erase(d);
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            if (deadlines.empty()) {
+                cv.wait(lock);
+                continue;
+            }
+            // few contexts have a pending deadline at the same time
+            const auto first = std::min_element(deadlines.begin(), deadlines.end(), [](const auto &lhs, const auto &rhs) {
+                return lhs.second < rhs.second;
+            });
+            const Clock::time_point deadline = first->second;
+            if (Clock::now() < deadline) {
+                cv.wait_until(lock, deadline);
+                continue;
+            }
+            Context::Private *const d = first->first;
+            deadlines.erase(first);
+            d->timedOut = true;
+            gpgme_cancel_async(d->ctx);
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_map<Context::Private *, Clock::time_point> deadlines;
+    std::thread thread;
+};
+}
+
+void Context::Private::armTimeout(std::chrono::steady_clock::time_point deadline, bool replace)
+{
+    Watchdog::instance().arm(this, deadline, replace);
+    timeoutArmed = true;
+}
+
+void Context::Private::disarmTimeout()
+{
+    Watchdog::instance().disarm(this);
+    timeoutArmed = false;
+}
+
+static std::atomic<unsigned int> s_keyringGeneration{0};
+
+void Context::Private::notifyKeyringChange()
+{
+    ++s_keyringGeneration;
+}
+
+unsigned int Context::Private::keyringGeneration()
+{
+    return s_keyringGeneration.load();
+}
+
+static std::atomic<Instrumentation *> s_globalInstrumentation{nullptr};
+
+static_assert(int(Instrumentation::DecryptAndVerify) == int(Context::Private::DecryptAndVerify)
+              && int(Instrumentation::KeyListWithImport) == int(Context::Private::KeyListWithImport)
+              && int(Instrumentation::Passwd) == int(Context::Private::Passwd)
+              && int(Instrumentation::MountVFS) == int(Context::Private::MountVFS),
+              "Instrumentation::Operation is out of sync with Context::Private::Operation");
+
+struct Context::Private::InstrumentedOperation {
+    Instrumentation *sink;
+    std::unique_ptr<TraceSpan> span;
+    Instrumentation::OperationStats stats;
+    Data in;
+    Data out;
+    // the callbacks replaced by the counting ones
+    gpgme_status_cb_t statusCb;
+    void *statusHook;
+    gpgme_progress_cb_t progressCb;
+    void *progressHook;
+    gpgme_passphrase_cb_t passphraseCb;
+    void *passphraseHook;
+};
+
+static gpgme_error_t instrumented_status_callback(void *opaque, const char *keyword, const char *args)
+{
+    auto *const op = static_cast<Context::Private::InstrumentedOperation *>(opaque);
+    ++op->stats.statusLines;
+    return op->statusCb ? op->statusCb(op->statusHook, keyword, args) : 0;
+}
+
+static void instrumented_progress_callback(void *opaque, const char *what, int type, int current, int total)
+{
+    auto *const op = static_cast<Context::Private::InstrumentedOperation *>(opaque);
+    ++op->stats.callbacks;
+    op->progressCb(op->progressHook, what, type, current, total);
+}
+
+static gpgme_error_t instrumented_passphrase_callback(void *opaque, const char *uid_hint, const char *desc,
+                                                      int prev_was_bad, int fd)
+{
+    auto *const op = static_cast<Context::Private::InstrumentedOperation *>(opaque);
+    ++op->stats.callbacks;
+    return op->passphraseCb(op->passphraseHook, uid_hint, desc, prev_was_bad, fd);
+}
+
+// puts the callbacks of the context back which were replaced for op
+static void restore_instrumented_callbacks(gpgme_ctx_t ctx, Context::Private::InstrumentedOperation *op)
+{
+    gpgme_status_cb_t scb = nullptr;
+    void *shp = nullptr;
+    gpgme_get_status_cb(ctx, &scb, &shp);
+    if (scb == &instrumented_status_callback && shp == op) {
+        gpgme_set_status_cb(ctx, op->statusCb, op->statusHook);
+    }
+    gpgme_progress_cb_t pcb = nullptr;
+    void *php = nullptr;
+    gpgme_get_progress_cb(ctx, &pcb, &php);
+    if (pcb == &instrumented_progress_callback && php == op) {
+        gpgme_set_progress_cb(ctx, op->progressCb, op->progressHook);
+    }
+    gpgme_passphrase_cb_t ppcb = nullptr;
+    void *pphp = nullptr;
+    gpgme_get_passphrase_cb(ctx, &ppcb, &pphp);
+    if (ppcb == &instrumented_passphrase_callback && pphp == op) {
+        gpgme_set_passphrase_cb(ctx, op->passphraseCb, op->passphraseHook);
+    }
+}
+
+static std::uint64_t data_position(Data &data)
+{
+    if (data.isNull()) {
+        return 0;
+    }
+    const auto pos = data.seek(0, SEEK_CUR);
+    return pos > 0 ? pos : 0;
+}
+
+// the cached types of data used by the engine are stale
+static void invalidate_data_types(std::initializer_list<const Data *> data)
+{
+    for (const Data *dp : data) {
+        if (dp && dp->impl()) {
+            dp->impl()->invalidateType();
+        }
+    }
+}
+
+void Context::Private::startOperation(Operation op, const Data *in, const Data *out, size_t keys)
+{
+    lastop = op;
+    invalidate_data_types({in, out});
+    timedOut = false;
+    if (operationTimeout.count() > 0) {
+        armTimeout(std::chrono::steady_clock::now() + operationTimeout, true);
+    } else if (timeoutArmed) {
+        disarmTimeout();
+    }
+    if (instrumented) {
+        // the previous operation was never finished, e.g. because the
+        // caller did not wait for it
+        restore_instrumented_callbacks(ctx, instrumented.get());
+        instrumented.reset();
+    }
+    Instrumentation *const sink = instrumentation ? instrumentation : s_globalInstrumentation.load(std::memory_order_relaxed);
+    Tracer *const t = tracer ? tracer : Context::globalTracer();
+    if (!sink && !t) {
+        return;
+    }
+
+    instrumented.reset(new InstrumentedOperation{sink, nullptr, {}, in ? *in : Data::null, out ? *out : Data::null,
+                                                 nullptr, nullptr, nullptr, nullptr, nullptr, nullptr});
+    Instrumentation::OperationStats &stats = instrumented->stats;
+    stats.operation = static_cast<Instrumentation::Operation>(op);
+    stats.protocol = q ? q->protocol() : UnknownProtocol;
+    stats.keys = keys;
+
+    if (t) {
+        const char *const name = Instrumentation::operationName(stats.operation);
+        instrumented->span = t->startSpan(("gpgme." + std::string(name)).c_str(),
+                                          traceParent ? traceParent : TraceScope::current());
+        if (TraceSpan *const span = instrumented->span.get()) {
+            span->setAttribute("gpgme.protocol", stats.protocol == CMS ? "cms" : stats.protocol == OpenPGP ? "openpgp" : "unknown");
+            span->setAttribute("gpgme.operation", name);
+            if (keys) {
+                span->setAttribute("gpgme.keys", std::int64_t(keys));
+            }
+        }
+    }
+
+    gpgme_get_status_cb(ctx, &instrumented->statusCb, &instrumented->statusHook);
+    gpgme_set_status_cb(ctx, &instrumented_status_callback, instrumented.get());
+    gpgme_get_progress_cb(ctx, &instrumented->progressCb, &instrumented->progressHook);
+    if (instrumented->progressCb) {
+        gpgme_set_progress_cb(ctx, &instrumented_progress_callback, instrumented.get());
+    }
+    gpgme_get_passphrase_cb(ctx, &instrumented->passphraseCb, &instrumented->passphraseHook);
+    if (instrumented->passphraseCb) {
+        gpgme_set_passphrase_cb(ctx, &instrumented_passphrase_callback, instrumented.get());
+    }
+
+    stats.start = Instrumentation::Clock::now();
+    if (sink) {
+        sink->operationStarted(q, stats.operation, stats.start);
+    }
+}
+
+void Context::Private::finishOperation()
+{
+    if (!instrumented) {
+        return;
+    }
+    const std::unique_ptr<InstrumentedOperation> op = std::move(instrumented);
+    Instrumentation::OperationStats &stats = op->stats;
+    stats.end = Instrumentation::Clock::now();
+    restore_instrumented_callbacks(ctx, op.get());
+    stats.error = Error(lasterr);
+    stats.bytesIn = data_position(op->in);
+    stats.bytesOut = data_position(op->out);
+    if (op->sink) {
+        op->sink->operationFinished(q, stats);
+    }
+    if (op->span) {
+        op->span->setAttribute("gpgme.bytes_in", std::int64_t(stats.bytesIn));
+        op->span->setAttribute("gpgme.bytes_out", std::int64_t(stats.bytesOut));
+        op->span->setAttribute("gpgme.error_code", std::int64_t(stats.error.code()));
+        op->span->end(stats.error);
+    }
+}
+
+void Context::Private::addEngineWaitTime(Instrumentation::Clock::duration duration)
+{
+    instrumented->stats.engineWait += duration;
+}
+
+void Context::Private::addResultCopyTime(Instrumentation::Clock::duration duration)
+{
+    instrumented->stats.resultCopy += duration;
+}
+
+const char *Instrumentation::operationName(Operation operation)
+{
+    switch (operation) {
+    case None: return "none";
+    case Encrypt: return "encrypt";
+    case Decrypt: return "decrypt";
+    case Sign: return "sign";
+    case Verify: return "verify";
+    case DecryptAndVerify: return "decrypt-verify";
+    case SignAndEncrypt: return "sign-encrypt";
+    case Import: return "import";
+    case Export: return "export";
+    case Delete: return "delete";
+    case KeyGen: return "keygen";
+    case KeyList: return "keylist";
+    case KeyListWithImport: return "keylist-import";
+    case Edit: return "edit";
+    case CardEdit: return "card-edit";
+    case GetAuditLog: return "auditlog";
+    case AssuanTransact: return "assuan";
+    case Passwd: return "passwd";
+    case CreateVFS: return "create-vfs";
+    case MountVFS: return "mount-vfs";
+    }
+    return "unknown";
+}
+
+void Context::Private::resetOperationState()
+{
+    lastop = None;
+    lasterr = GPG_ERR_NO_ERROR;
+    lastAssuanInquireData = Data::null;
+    lastAssuanTransaction.reset();
+    lastEditInteractor.reset();
+    lastCardEditInteractor.reset();
+    completion = nullptr;
+    listedKeys.reset();
+    quickEditing = false;
+    if (changesKeyring) {
+        // the operation was abandoned; it may still have changed the keyring
+        changesKeyring = false;
+        notifyKeyringChange();
+    }
+}
+
+void Context::Private::copySettingsTo(Context &helper) const
+{
+    // the flags gpgme_get_ctx_flag() knows
+    static const char *const flags[] = {
+        "redraw", "full-status", "raw-description", "export-session-key",
+        "override-session-key", "include-key-block", "auto-key-import",
+        "auto-key-retrieve", "request-origin", "no-symkey-cache",
+        "ignore-mdc-error", "auto-key-locate", "trust-model", "extended-edit",
+        "cert-expire", "key-origin", "import-filter", "import-options",
+        "no-auto-check-trustdb", "proc-all-sigs", "known-notations",
+    };
+
+    gpgme_ctx_t const to = helper.d->ctx;
+    const gpgme_protocol_t proto = gpgme_get_protocol(ctx);
+    for (gpgme_engine_info_t info = gpgme_ctx_get_engine_info(ctx); info; info = info->next) {
+        if (info->protocol == proto) {
+            gpgme_ctx_set_engine_info(to, proto, info->file_name, info->home_dir);
+            break;
+        }
+    }
+    gpgme_set_offline(to, gpgme_get_offline(ctx));
+    gpgme_set_pinentry_mode(to, gpgme_get_pinentry_mode(ctx));
+    gpgme_set_sender(to, gpgme_get_sender(ctx));
+    for (const char *name : flags) {
+        // unset flags are returned as empty strings
+        const char *const value = gpgme_get_ctx_flag(ctx, name);
+        if (value && *value) {
+            gpgme_set_ctx_flag(to, name, value);
+        }
+    }
+    helper.setInstrumentation(instrumentation);
+    helper.setTracer(tracer);
+    helper.setTraceParent(traceParent ? traceParent : TraceScope::current());
+}
+
 //
 //
 // Context attributes:
@@ -321,17 +718,49 @@ unsigned int Context::keyListMode() const
     return convert_from_gpgme_keylist_mode_t(gpgme_get_keylist_mode(d->ctx));
 }
 
+void Context::setGpgmeKeyListMode(unsigned int gpgmeMode)
+{
+    gpgme_set_keylist_mode(d->ctx, static_cast<gpgme_keylist_mode_t>(gpgmeMode));
+}
+
+void Context::setKeyListInterner(KeyListInterner *interner)
+{
+    d->interner = interner;
+}
+
+KeyListInterner *Context::keyListInterner() const
+{
+    return d->interner;
+}
+
 void Context::setProgressProvider(ProgressProvider *provider)
 {
     gpgme_set_progress_cb(d->ctx, provider ? &progress_callback : nullptr, provider);
+    d->progressThrottle.reset();
+}
+void Context::setProgressProvider(ProgressProvider *provider, std::chrono::milliseconds minInterval, int minPercentChange)
+{
+    std::unique_ptr<ThrottledProgressProvider> throttle(new ThrottledProgressProvider(provider, minInterval, minPercentChange));
+    gpgme_set_progress_cb(d->ctx, &progress_callback, static_cast<ProgressProvider *>(throttle.get()));
+    d->progressThrottle = std::move(throttle);
 }
 ProgressProvider *Context::progressProvider() const
 {
     void *pp = nullptr;
     gpgme_progress_cb_t pcb = &progress_callback;
     gpgme_get_progress_cb(d->ctx, &pcb, &pp);
+    if (pcb == &instrumented_progress_callback) {
+        pp = d->instrumented->progressHook;
+    }
+    if (d->progressThrottle && pp == static_cast<ProgressProvider *>(d->progressThrottle.get())) {
+        return d->progressThrottle->target();
+    }
     return static_cast<ProgressProvider *>(pp);
 }
+ThrottledProgressProvider::Snapshot Context::progressSnapshot() const
+{
+    return d->progressThrottle ? d->progressThrottle->snapshot() : ThrottledProgressProvider::Snapshot();
+}
 
 void Context::setPassphraseProvider(PassphraseProvider *provider)
 {
@@ -343,9 +772,52 @@ PassphraseProvider *Context::passphraseProvider() const
     void *pp = nullptr;
     gpgme_passphrase_cb_t pcb = &passphrase_callback;
     gpgme_get_passphrase_cb(d->ctx, &pcb, &pp);
+    if (pcb == &instrumented_passphrase_callback) {
+        pp = d->instrumented->passphraseHook;
+    }
     return static_cast<PassphraseProvider *>(pp);
 }
 
+void Context::setInstrumentation(Instrumentation *instrumentation)
+{
+    d->instrumentation = instrumentation;
+}
+
+Instrumentation *Context::instrumentation() const
+{
+    return d->instrumentation;
+}
+
+void Context::setGlobalInstrumentation(Instrumentation *instrumentation)
+{
+    s_globalInstrumentation.store(instrumentation);
+}
+
+Instrumentation *Context::globalInstrumentation()
+{
+    return s_globalInstrumentation.load();
+}
+
+void Context::setTracer(Tracer *tracer)
+{
+    d->tracer = tracer;
+}
+
+Tracer *Context::tracer() const
+{
+    return d->tracer;
+}
+
+void Context::setTraceParent(TraceSpan *parent)
+{
+    d->traceParent = parent;
+}
+
+TraceSpan *Context::traceParent() const
+{
+    return d->traceParent;
+}
+
 void Context::setManagedByEventLoopInteractor(bool manage)
 {
     if (!EventLoopInteractor::instance()) {
@@ -449,18 +921,18 @@ const char *Context::getSender ()
 
 Error Context::startKeyListing(const char *pattern, bool secretOnly)
 {
-    d->lastop = (((keyListMode() & GpgME::Locate) == GpgME::Locate)
-                 ? Private::KeyListWithImport
-                 : Private::KeyList);
-    return Error(d->lasterr = gpgme_op_keylist_start(d->ctx, pattern, int(secretOnly)));
+    d->startOperation(((keyListMode() & GpgME::Locate) == GpgME::Locate)
+                      ? Private::KeyListWithImport
+                      : Private::KeyList);
+    return d->started(gpgme_op_keylist_start(d->ctx, pattern, int(secretOnly)));
 }
 
 Error Context::startKeyListing(const char *patterns[], bool secretOnly)
 {
-    d->lastop = (((keyListMode() & GpgME::Locate) == GpgME::Locate)
-                 ? Private::KeyListWithImport
-                 : Private::KeyList);
-    return Error(d->lasterr = gpgme_op_keylist_ext_start(d->ctx, patterns, int(secretOnly), 0));
+    d->startOperation(((keyListMode() & GpgME::Locate) == GpgME::Locate)
+                      ? Private::KeyListWithImport
+                      : Private::KeyList);
+    return d->started(gpgme_op_keylist_ext_start(d->ctx, patterns, int(secretOnly), 0));
 }
 
 Key Context::nextKey(GpgME::Error &e)
@@ -469,14 +941,27 @@ Key Context::nextKey(GpgME::Error &e)
                  ? Private::KeyListWithImport
                  : Private::KeyList);
     gpgme_key_t key = nullptr;
-    e = Error(d->lasterr = gpgme_op_keylist_next(d->ctx, &key));
-    return Key(key, false);
+    const auto start = d->engineWaitStarted();
+    gpgme_error_t err = gpgme_op_keylist_next(d->ctx, &key);
+    d->engineWaitFinished(start);
+    if (err) {
+        // the listing ended; a cancellation by the watchdog is a timeout
+        err = d->operationDone(err);
+    }
+    e = Error(d->lasterr = err);
+    const Key result(key, false);
+    if (d->interner && key) {
+        d->interner->internKey(result);
+    }
+    return result;
 }
 
 KeyListResult Context::endKeyListing()
 {
     d->lasterr = gpgme_op_keylist_end(d->ctx);
-    return keyListResult();
+    return d->finishOperation([this]() {
+        return keyListResult();
+    });
 }
 
 KeyListResult Context::keyListResult() const
@@ -484,27 +969,168 @@ KeyListResult Context::keyListResult() const
     return KeyListResult(d->ctx, Error(d->lasterr));
 }
 
+KeyListRange Context::listKeys(const std::vector<std::string> &patterns, unsigned int mode, bool secretOnly)
+{
+    return KeyListRange(this, patterns, mode, secretOnly);
+}
+
+std::vector<Key> Context::listKeysParallel(const std::vector<std::string> &patterns, unsigned int mode,
+                                           unsigned int shards, bool secretOnly, GpgME::Error &err)
+{
+    err = Error();
+    const size_t count = patterns.empty() ? 1 : std::min<size_t>(std::max(shards, 1u), patterns.size());
+    const unsigned int listMode = mode ? mode : keyListMode();
+
+    struct Shard {
+        std::unique_ptr<Context> ctx;
+        std::vector<std::string> patterns;
+        std::vector<Key> keys;
+        Error err;
+    };
+    std::vector<Shard> slices(count);
+    for (size_t i = 0; i < count; ++i) {
+        Shard &shard = slices[i];
+        // spread the rest of the division over the first slices
+        const size_t begin = i * (patterns.size() / count) + std::min(i, patterns.size() % count);
+        const size_t end = begin + patterns.size() / count + (i < patterns.size() % count ? 1 : 0);
+        shard.patterns.assign(patterns.begin() + begin, patterns.begin() + end);
+        shard.ctx.reset(createForProtocol(protocol()));
+        if (!shard.ctx) {
+            err = Error::fromCode(GPG_ERR_INV_ENGINE);
+            return std::vector<Key>();
+        }
+        d->copySettingsTo(*shard.ctx);
+        shard.ctx->setKeyListMode(listMode);
+        shard.ctx->setKeyListInterner(d->interner);
+    }
+
+    const auto list = [secretOnly](Shard *shard) {
+        KeyListRange range = shard->ctx->listKeys(shard->patterns, 0, secretOnly);
+        for (const Key &key : range) {
+            shard->keys.push_back(key);
+        }
+        shard->err = range.error();
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i) {
+        threads.emplace_back(list, &slices[i]);
+    }
+    list(&slices[0]);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    std::vector<Key> keys;
+    std::unordered_set<std::string_view> seen;
+    for (const Shard &shard : slices) {
+        if (shard.err && !err) {
+            err = shard.err;
+        }
+        for (const Key &key : shard.keys) {
+            const char *const fpr = key.primaryFingerprint();
+            if (count == 1 || !fpr || seen.insert(fpr).second) {
+                keys.push_back(key);
+            }
+        }
+    }
+    return keys;
+}
+
 Key Context::key(const char *fingerprint, GpgME::Error &e , bool secret /*, bool forceUpdate*/)
 {
-    d->lastop = Private::KeyList;
+    d->startOperation(Private::KeyList);
     gpgme_key_t key = nullptr;
-    e = Error(d->lasterr = gpgme_get_key(d->ctx, fingerprint, &key, int(secret)/*, int( forceUpdate )*/));
+    e = d->finished(gpgme_get_key(d->ctx, fingerprint, &key, int(secret)/*, int( forceUpdate )*/));
     return Key(key, false);
 }
 
+static std::string normalized_key_pattern(const std::string &pattern)
+{
+    std::string result = pattern;
+    if (result.size() > 2 && result[0] == '0' && (result[1] == 'x' || result[1] == 'X')) {
+        result.erase(0, 2);
+    }
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::toupper(c);
+    });
+    return result;
+}
+
+std::vector<Key> Context::keys(const std::vector<std::string> &fingerprints, bool secret, GpgME::Error &e)
+{
+    std::vector<Key> result(fingerprints.size());
+    e = Error();
+    if (fingerprints.empty()) {
+        return result;
+    }
+
+    // maps the normalized patterns to the positions in the result
+    std::unordered_map<std::string, std::vector<size_t>> positions;
+    positions.reserve(fingerprints.size());
+    for (size_t i = 0; i < fingerprints.size(); ++i) {
+        positions[normalized_key_pattern(fingerprints[i])].push_back(i);
+    }
+
+    const StringsToCStrings patterns{fingerprints};
+    e = startKeyListing(patterns.c_strs(), secret);
+    if (e) {
+        return result;
+    }
+
+    const auto assign = [&positions, &result](const char *id, const Key &key) {
+        if (!id) {
+            return;
+        }
+        const auto it = positions.find(id);
+        if (it == positions.end()) {
+            return;
+        }
+        for (const size_t i : it->second) {
+            if (result[i].isNull()) {
+                result[i] = key;
+            }
+        }
+    };
+    while (true) {
+        Error err;
+        const Key key = nextKey(err);
+        if (err) {
+            if (err.code() != GPG_ERR_EOF) {
+                e = err;
+            }
+            break;
+        }
+        for (const Subkey &subkey : key.subkeys()) {
+            assign(subkey.fingerprint(), key);
+            assign(subkey.keyID(), key);
+        }
+        assign(key.shortKeyID(), key);
+    }
+    const KeyListResult res = endKeyListing();
+    if (!e && res.error() && res.error().code() != GPG_ERR_EOF) {
+        e = res.error();
+    }
+    return result;
+}
+
 KeyGenerationResult Context::generateKey(const char *parameters, Data &pubKey)
 {
-    d->lastop = Private::KeyGen;
+    d->startOperation(Private::KeyGen);
     Data::Private *const dp = pubKey.impl();
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_genkey(d->ctx, parameters, dp ? dp->data : nullptr, nullptr);
-    return KeyGenerationResult(d->ctx, Error(d->lasterr));
+    return d->finishOperation([this]() {
+        return KeyGenerationResult(d->ctx, Error(d->lasterr));
+    });
 }
 
 Error Context::startKeyGeneration(const char *parameters, Data &pubKey)
 {
-    d->lastop = Private::KeyGen;
+    d->startOperation(Private::KeyGen);
     Data::Private *const dp = pubKey.impl();
-    return Error(d->lasterr = gpgme_op_genkey_start(d->ctx, parameters, dp ? dp->data : nullptr, nullptr));
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_genkey_start(d->ctx, parameters, dp ? dp->data : nullptr, nullptr));
 }
 
 KeyGenerationResult Context::keyGenerationResult() const
@@ -518,30 +1144,194 @@ KeyGenerationResult Context::keyGenerationResult() const
 
 Error Context::exportKeys(const char *pattern, Data &keyData, unsigned int mode)
 {
-    d->lastop = Private::Export;
+    d->startOperation(Private::Export, nullptr, &keyData);
     Data::Private *const dp = keyData.impl();
-    return Error(d->lasterr = gpgme_op_export(d->ctx, pattern, mode, dp ? dp->data : nullptr));
+    return d->finished(gpgme_op_export(d->ctx, pattern, mode, dp ? dp->data : nullptr));
 }
 
 Error Context::exportKeys(const char *patterns[], Data &keyData, unsigned int mode)
 {
-    d->lastop = Private::Export;
+    d->startOperation(Private::Export, nullptr, &keyData);
     Data::Private *const dp = keyData.impl();
-    return Error(d->lasterr = gpgme_op_export_ext(d->ctx, patterns, mode, dp ? dp->data : nullptr));
+    return d->finished(gpgme_op_export_ext(d->ctx, patterns, mode, dp ? dp->data : nullptr));
 }
 
 Error Context::startKeyExport(const char *pattern, Data &keyData, unsigned int mode)
 {
-    d->lastop = Private::Export;
+    d->startOperation(Private::Export, nullptr, &keyData);
     Data::Private *const dp = keyData.impl();
-    return Error(d->lasterr = gpgme_op_export_start(d->ctx, pattern, mode, dp ? dp->data : nullptr));
+    return d->started(gpgme_op_export_start(d->ctx, pattern, mode, dp ? dp->data : nullptr));
 }
 
 Error Context::startKeyExport(const char *patterns[], Data &keyData, unsigned int mode)
 {
-    d->lastop = Private::Export;
+    d->startOperation(Private::Export, nullptr, &keyData);
     Data::Private *const dp = keyData.impl();
-    return Error(d->lasterr = gpgme_op_export_ext_start(d->ctx, patterns, mode, dp ? dp->data : nullptr));
+    return d->started(gpgme_op_export_ext_start(d->ctx, patterns, mode, dp ? dp->data : nullptr));
+}
+
+#ifdef _WIN32
+using ssize_type = gpgme_ssize_t;
+using off_type = gpgme_off_t;
+#else
+using ssize_type = ssize_t;
+using off_type = off_t;
+#endif
+
+namespace
+{
+// a data provider which splits the written export into the keys
+class KeyExportSplitter : public DataProvider
+{
+public:
+    KeyExportSplitter(const std::vector<Key> &keys, const Context::KeyExportCallback &callback)
+        : mKeys(keys),
+          mCallback(callback),
+          mSplitter(0),
+          mUsed(keys.size(), false),
+          mCanceled(false)
+    {
+        for (size_t i = 0; i < mKeys.size(); ++i) {
+            mByCreationTime.emplace(static_cast<long long>(mKeys[i].subkey(0).creationTime()), i);
+        }
+    }
+
+    bool isSupported(Operation op) const override
+    {
+        return op == Write || op == Release;
+    }
+    ssize_type read(void *, size_t) override
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    ssize_type write(const void *buffer, size_t bufSize) override
+    {
+        if (mCanceled) {
+            errno = ECANCELED;
+            return -1;
+        }
+        mSplitter.feed(static_cast<const char *>(buffer), bufSize);
+        std::string chunk;
+        while (mSplitter.next(chunk)) {
+            if (!emit(chunk)) {
+                errno = ECANCELED;
+                return -1;
+            }
+        }
+        return bufSize;
+    }
+    off_type seek(off_type, int) override
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    void release() override {}
+
+    // passes the remaining data to the callback
+    void finish()
+    {
+        std::string chunk;
+        while (!mCanceled && mSplitter.finish(chunk)) {
+            emit(chunk);
+        }
+    }
+
+    bool canceled() const
+    {
+        return mCanceled;
+    }
+
+private:
+    bool emit(const std::string &chunk)
+    {
+        const char *const fpr = fingerprint(KeyPacketSplitter::keyCreationTime(chunk.data(), chunk.size()));
+        if (!mCallback(fpr, chunk.data(), chunk.size())) {
+            mCanceled = true;
+        }
+        return !mCanceled;
+    }
+
+    // returns the fingerprint of the only listed key which has not been
+    // matched yet and has the creation time; keys with the same creation
+    // time cannot be told apart without hashing the key packet
+    const char *fingerprint(long long creationTime)
+    {
+        if (creationTime < 0) {
+            return nullptr;
+        }
+        size_t idx = mKeys.size();
+        const auto range = mByCreationTime.equal_range(creationTime);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (mUsed[it->second]) {
+                continue;
+            }
+            if (idx != mKeys.size()) {
+                // ambiguous
+                return nullptr;
+            }
+            idx = it->second;
+        }
+        if (idx == mKeys.size()) {
+            return nullptr;
+        }
+        mUsed[idx] = true;
+        return mKeys[idx].primaryFingerprint();
+    }
+
+    const std::vector<Key> &mKeys;
+    const Context::KeyExportCallback &mCallback;
+    KeyPacketSplitter mSplitter;
+    std::vector<bool> mUsed;
+    std::unordered_multimap<long long, size_t> mByCreationTime;
+    bool mCanceled;
+};
+}
+
+Error Context::exportKeysStreaming(const std::vector<std::string> &patterns, unsigned int mode,
+                                   const KeyExportCallback &callback)
+{
+    if (protocol() != OpenPGP || (mode & (ExportExtern | ExportSSH | ExportRaw | ExportPKCS12))) {
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    if (!callback) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+
+    std::vector<Key> keys;
+    Error err;
+    {
+        KeyListRange range = listKeys(patterns, 0, mode & (ExportSecret | ExportSecretSubkey));
+        for (const Key &key : range) {
+            keys.push_back(key);
+        }
+        err = range.error();
+    }
+    if (err) {
+        return err;
+    }
+    if (keys.empty()) {
+        return Error();
+    }
+
+    KeyExportSplitter splitter(keys, callback);
+    Data keyData(&splitter);
+    const bool wasArmored = armor();
+    setArmor(false);
+    const StringsToCStrings cpatterns{patterns};
+    err = patterns.empty() ? exportKeys(static_cast<const char *>(nullptr), keyData, mode)
+                           : exportKeys(cpatterns.c_strs(), keyData, mode);
+    setArmor(wasArmored);
+    if (splitter.canceled()) {
+        return Error::fromCode(GPG_ERR_CANCELED);
+    }
+    if (!err) {
+        splitter.finish();
+        if (splitter.canceled()) {
+            return Error::fromCode(GPG_ERR_CANCELED);
+        }
+    }
+    return err;
 }
 
 Error Context::exportPublicKeys(const char *pattern, Data &keyData, unsigned int mode)
@@ -651,15 +1441,42 @@ Error Context::startSecretSubkeyExport(const char *patterns[], Data &keyData, un
 
 ImportResult Context::importKeys(const Data &data)
 {
-    d->lastop = Private::Import;
+    d->startOperation(Private::Import, &data);
     const Data::Private *const dp = data.impl();
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_import(d->ctx, dp ? dp->data : nullptr);
-    return ImportResult(d->ctx, Error(d->lasterr));
+    return d->finishOperation([this]() {
+        return ImportResult(d->ctx, Error(d->lasterr));
+    });
+}
+
+// Exports the keys matching @p patterns (all keys if null) with @p source
+// in a helper thread while @p import reads the exported data. The data is
+// passed through a bounded buffer, so that neither all keys are held in
+// memory nor the import waits for the end of the export. Returns the error
+// of the export.
+static Error pipelineExport(Context &source, const char *patterns[], unsigned int mode,
+                            const std::function<void(Data &)> &import)
+{
+    RingBufferDataProvider buffer;
+    Data exported(&buffer);
+    Data imported(&buffer);
+    Error exportError;
+    std::thread exporter([&]() {
+        exportError = patterns ? source.exportKeys(patterns, exported, mode)
+                               : source.exportKeys(static_cast<const char *>(nullptr), exported, mode);
+        buffer.closeWrite();
+    });
+    import(imported);
+    // makes the export fail instead of blocking if the import stopped early
+    buffer.closeRead();
+    exporter.join();
+    return exportError;
 }
 
 ImportResult Context::importKeys(const std::vector<Key> &kk)
 {
-    d->lastop = Private::Import;
+    d->startOperation(Private::Import, nullptr, nullptr, kk.size());
     d->lasterr = make_error(GPG_ERR_NOT_IMPLEMENTED);
 
     bool shouldHaveResult = false;
@@ -671,12 +1488,14 @@ ImportResult Context::importKeys(const std::vector<Key> &kk)
         }
     }
     *keys_it++ = nullptr;
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_import_keys(d->ctx, keys);
     shouldHaveResult = true;
     if ((gpgme_err_code(d->lasterr) == GPG_ERR_NOT_IMPLEMENTED ||
             gpgme_err_code(d->lasterr) == GPG_ERR_NOT_SUPPORTED) &&
             protocol() == CMS) {
-        // ok, try the workaround (export+import):
+        // ok, try the workaround (export+import), with a second context
+        // exporting while this one imports:
         std::vector<const char *> fprs;
         for (std::vector<Key>::const_iterator it = kk.begin(), end = kk.end() ; it != end ; ++it) {
             if (const char *fpr = it->primaryFingerprint()) {
@@ -690,36 +1509,66 @@ ImportResult Context::importKeys(const std::vector<Key> &kk)
             }
         }
         fprs.push_back(nullptr);
-        Data data;
-        Data::Private *const dp = data.impl();
-        const gpgme_keylist_mode_t oldMode = gpgme_get_keylist_mode(d->ctx);
-        gpgme_set_keylist_mode(d->ctx, GPGME_KEYLIST_MODE_EXTERN);
-        d->lasterr = gpgme_op_export_ext(d->ctx, &fprs[0], 0, dp ? dp->data : nullptr);
-        gpgme_set_keylist_mode(d->ctx, oldMode);
-        if (!d->lasterr) {
-            data.seek(0, SEEK_SET);
-            d->lasterr = gpgme_op_import(d->ctx, dp ? dp->data : nullptr);
-            shouldHaveResult = true;
+        const EngineInfo engine = engineInfo();
+        const std::unique_ptr<Context> exporter(createForProtocol(CMS));
+        if (!exporter) {
+            d->lasterr = make_error(GPG_ERR_INV_ENGINE);
+            shouldHaveResult = false;
+        } else {
+            exporter->setEngineFileName(engine.fileName());
+            exporter->setEngineHomeDirectory(engine.homeDirectory());
+            exporter->setKeyListMode(Extern);
+            exporter->setInstrumentation(d->instrumentation);
+            exporter->setTracer(d->tracer);
+            exporter->setTraceParent(d->traceParent ? d->traceParent : TraceScope::current());
+            d->keyringChangeStarted();
+            const Error exportError = pipelineExport(*exporter, &fprs[0], 0, [this](Data &data) {
+                Data::Private *const dp = data.impl();
+                d->lasterr = gpgme_op_import(d->ctx, dp ? dp->data : nullptr);
+            });
+            if (exportError && exportError.code() != GPG_ERR_EPIPE) {
+                d->lasterr = exportError.encodedError();
+            }
         }
     }
     delete[] keys;
-    if (shouldHaveResult) {
-        return ImportResult(d->ctx, Error(d->lasterr));
-    } else {
-        return ImportResult(Error(d->lasterr));
+    return d->finishOperation([this, shouldHaveResult]() {
+        return shouldHaveResult ? ImportResult(d->ctx, Error(d->lasterr)) : ImportResult(Error(d->lasterr));
+    });
+}
+
+ImportResult Context::importKeysFrom(Context &source, const std::vector<std::string> &patterns, unsigned int mode)
+{
+    if (&source == this || source.protocol() != protocol()) {
+        return ImportResult(Error::fromCode(GPG_ERR_INV_VALUE));
+    }
+    d->startOperation(Private::Import, nullptr, nullptr, patterns.size());
+    const StringsToCStrings cpatterns{patterns};
+    d->keyringChangeStarted();
+    const Error exportError = pipelineExport(source, patterns.empty() ? nullptr : cpatterns.c_strs(), mode,
+                                             [this](Data &data) {
+        Data::Private *const dp = data.impl();
+        d->lasterr = gpgme_op_import(d->ctx, dp ? dp->data : nullptr);
+    });
+    if (exportError && exportError.code() != GPG_ERR_EPIPE) {
+        d->lasterr = exportError.encodedError();
     }
+    return d->finishOperation([this]() {
+        return ImportResult(d->ctx, Error(d->lasterr));
+    });
 }
 
 Error Context::startKeyImport(const Data &data)
 {
-    d->lastop = Private::Import;
+    d->startOperation(Private::Import, &data);
     const Data::Private *const dp = data.impl();
-    return Error(d->lasterr = gpgme_op_import_start(d->ctx, dp ? dp->data : nullptr));
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_import_start(d->ctx, dp ? dp->data : nullptr));
 }
 
 Error Context::startKeyImport(const std::vector<Key> &kk)
 {
-    d->lastop = Private::Import;
+    d->startOperation(Private::Import, nullptr, nullptr, kk.size());
     gpgme_key_t * const keys = new gpgme_key_t[ kk.size() + 1 ];
     gpgme_key_t *keys_it = &keys[0];
     for (std::vector<Key>::const_iterator it = kk.begin(), end = kk.end() ; it != end ; ++it) {
@@ -728,25 +1577,48 @@ Error Context::startKeyImport(const std::vector<Key> &kk)
         }
     }
     *keys_it++ = nullptr;
-    Error err = Error(d->lasterr = gpgme_op_import_keys_start(d->ctx, keys));
+    d->keyringChangeStarted();
+    Error err = d->started(gpgme_op_import_keys_start(d->ctx, keys));
     delete[] keys;
     return err;
 }
 
 ImportResult Context::importKeys(const std::vector<std::string> &keyIds)
 {
-    d->lastop = Private::Import;
+    d->startOperation(Private::Import, nullptr, nullptr, keyIds.size());
     const StringsToCStrings keyids{keyIds};
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_receive_keys(d->ctx, keyids.c_strs());
-    return ImportResult(d->ctx, Error(d->lasterr));
+    return d->finishOperation([this]() {
+        return ImportResult(d->ctx, Error(d->lasterr));
+    });
+}
+
+ImportResult Context::importKeys(const std::string_view *keyIds, size_t count)
+{
+    d->startOperation(Private::Import, nullptr, nullptr, count);
+    const StringsToCStrings keyids{keyIds, count};
+    d->keyringChangeStarted();
+    d->lasterr = gpgme_op_receive_keys(d->ctx, keyids.c_strs());
+    return d->finishOperation([this]() {
+        return ImportResult(d->ctx, Error(d->lasterr));
+    });
 }
 
 Error Context::startKeyImport(const std::vector<std::string> &keyIds)
 {
-    d->lastop = Private::Import;
+    d->startOperation(Private::Import, nullptr, nullptr, keyIds.size());
     const StringsToCStrings keyids{keyIds};
-    d->lasterr = gpgme_op_receive_keys_start(d->ctx, keyids.c_strs());
-    return Error(d->lasterr);
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_receive_keys_start(d->ctx, keyids.c_strs()));
+}
+
+Error Context::startKeyImport(const std::string_view *keyIds, size_t count)
+{
+    d->startOperation(Private::Import, nullptr, nullptr, count);
+    const StringsToCStrings keyids{keyIds, count};
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_receive_keys_start(d->ctx, keyids.c_strs()));
 }
 
 ImportResult Context::importResult() const
@@ -765,8 +1637,9 @@ Error Context::deleteKey(const Key &key, bool allowSecretKeyDeletion)
 
 Error Context::deleteKey(const Key &key, DeletionFlags flags)
 {
-    d->lastop = Private::Delete;
-    return Error(d->lasterr = gpgme_op_delete_ext(d->ctx, key.impl(), flags.toUnderlyingType()));
+    d->startOperation(Private::Delete);
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_delete_ext(d->ctx, key.impl(), flags.toUnderlyingType()));
 }
 
 Error Context::startKeyDeletion(const Key &key, bool allowSecretKeyDeletion)
@@ -776,47 +1649,183 @@ Error Context::startKeyDeletion(const Key &key, bool allowSecretKeyDeletion)
 
 Error Context::startKeyDeletion(const Key &key, DeletionFlags flags)
 {
-    d->lastop = Private::Delete;
-    return Error(d->lasterr = gpgme_op_delete_start(d->ctx, key.impl(), flags.toUnderlyingType()));
+    d->startOperation(Private::Delete);
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_delete_start(d->ctx, key.impl(), flags.toUnderlyingType()));
 }
 
 Error Context::passwd(const Key &key)
 {
-    d->lastop = Private::Passwd;
-    return Error(d->lasterr = gpgme_op_passwd(d->ctx, key.impl(), 0U));
+    d->startOperation(Private::Passwd);
+    return d->finished(gpgme_op_passwd(d->ctx, key.impl(), 0U));
 }
 
 Error Context::startPasswd(const Key &key)
 {
-    d->lastop = Private::Passwd;
-    return Error(d->lasterr = gpgme_op_passwd_start(d->ctx, key.impl(), 0U));
+    d->startOperation(Private::Passwd);
+    return d->started(gpgme_op_passwd_start(d->ctx, key.impl(), 0U));
 }
 
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 
+// parses the expiration times of the form "0", "N", "Nd", "Nw", "Nm" and
+// "Ny" accepted by gpg into seconds; returns false for other forms
+static bool parse_expiry_time(const std::string &s, unsigned long &seconds)
+{
+    if (s.empty() || !std::isdigit(static_cast<unsigned char>(s[0]))) {
+        return false;
+    }
+    size_t pos = 0;
+    unsigned long value = 0;
+    while (pos < s.size() && std::isdigit(static_cast<unsigned char>(s[pos]))) {
+        if (value > 100000) {
+            return false;
+        }
+        value = 10 * value + (s[pos++] - '0');
+    }
+    unsigned long days = 1;
+    if (pos < s.size()) {
+        switch (std::tolower(static_cast<unsigned char>(s[pos++]))) {
+        case 'd': days = 1; break;
+        case 'w': days = 7; break;
+        case 'm': days = 30; break;
+        case 'y': days = 365; break;
+        default: return false;
+        }
+    }
+    if (pos != s.size()) {
+        return false;
+    }
+    seconds = value * days * 86400;
+    return true;
+}
+
+static std::string getLFSeparatedListOfUserIds(const std::vector<UserID> &userIds);
+static unsigned int keysignflags2keysignflags(Context::KeySignFlags flags, bool lfsep);
+
+// runs within the Edit operation started by the caller, so the gpgme
+// functions are called directly instead of the public functions, which
+// run operations of their own
+bool Context::Private::quickEdit(Context *q, const Key &key, EditInteractor *func, bool async, Error &err)
+{
+    if (!func || key.isNull() || q->protocol() != OpenPGP
+        || !EngineCapabilities::get(GpgEngine).hasFeature(EngineCapabilities::QuickCommands)) {
+        return false;
+    }
+    // subclasses may change the dialog, so only the interactors themselves
+    // are replaced by quick commands
+    if (typeid(*func) == typeid(GpgAddUserIDEditInteractor)) {
+        const auto adduid = static_cast<const GpgAddUserIDEditInteractor *>(func);
+        std::string uid = adduid->nameUtf8();
+        if (!adduid->commentUtf8().empty()) {
+            uid += " (" + adduid->commentUtf8() + ')';
+        }
+        if (!adduid->emailUtf8().empty()) {
+            uid += (uid.empty() ? "<" : " <") + adduid->emailUtf8() + '>';
+        }
+        keyringChangeStarted();
+        err = Error(async ? gpgme_op_adduid_start(ctx, key.impl(), uid.c_str(), 0)
+                          : gpgme_op_adduid(ctx, key.impl(), uid.c_str(), 0));
+        quickEditStarted(func, async, err);
+        return true;
+    }
+    if (typeid(*func) == typeid(GpgSetExpiryTimeEditInteractor)) {
+        const auto expiry = static_cast<const GpgSetExpiryTimeEditInteractor *>(func);
+        unsigned long expires;
+        if (!parse_expiry_time(expiry->timeString(), expires)) {
+            return false;
+        }
+        keyringChangeStarted();
+        err = Error(async ? gpgme_op_setexpire_start(ctx, key.impl(), expires, "", 0)
+                          : gpgme_op_setexpire(ctx, key.impl(), expires, "", 0));
+        quickEditStarted(func, async, err);
+        return true;
+    }
+    if (typeid(*func) == typeid(GpgSignKeyEditInteractor)) {
+        const auto sign = static_cast<const GpgSignKeyEditInteractor *>(func);
+        // --quick-sign-key knows neither check levels, nor non-revocable
+        // nor trust signatures
+        const int options = sign->signingOptions();
+        if (sign->checkLevel() != 0 || (options & (GpgSignKeyEditInteractor::NonRevocable | GpgSignKeyEditInteractor::Trust))) {
+            return false;
+        }
+        std::vector<UserID> uids;
+        const std::vector<UserID> keyUids = key.userIDs();
+        for (unsigned int index : sign->userIDsToSign()) {
+            if (index >= keyUids.size()) {
+                return false;
+            }
+            uids.push_back(keyUids[index]);
+        }
+        unsigned int flags = Context::KeySignDefault;
+        if (!(options & GpgSignKeyEditInteractor::Exportable)) {
+            flags |= Context::KeySignLocal;
+        }
+        if (sign->dupeOk()) {
+            flags |= Context::KeySignForce;
+        }
+        const std::string uidList = getLFSeparatedListOfUserIds(uids);
+        const unsigned int signFlags = keysignflags2keysignflags(static_cast<Context::KeySignFlags>(flags), uids.size() > 1);
+        keyringChangeStarted();
+        err = Error(async ? gpgme_op_keysign_start(ctx, key.impl(), uidList.empty() ? nullptr : uidList.c_str(), 0, signFlags)
+                          : gpgme_op_keysign(ctx, key.impl(), uidList.empty() ? nullptr : uidList.c_str(), 0, signFlags));
+        quickEditStarted(func, async, err);
+        return true;
+    }
+    return false;
+}
+
+void Context::Private::quickEditStarted(EditInteractor *func, bool async, const Error &err)
+{
+    if (async && !err) {
+        // the error is reported when the operation is finished
+        quickEditing = true;
+    } else {
+        func->setLastError(err);
+    }
+}
+
+void Context::Private::quickEditDone(gpgme_error_t err)
+{
+    quickEditing = false;
+    if (lastEditInteractor) {
+        lastEditInteractor->setLastError(Error(err));
+    }
+}
+
 Error Context::edit(const Key &key, std::unique_ptr<EditInteractor> func, Data &data)
 {
-    d->lastop = Private::Edit;
+    d->startOperation(Private::Edit);
     d->lastEditInteractor = std::move(func);
+    Error err;
+    if (d->quickEdit(this, key, d->lastEditInteractor.get(), false, err)) {
+        return d->finished(err.encodedError());
+    }
     Data::Private *const dp = data.impl();
-    return Error(d->lasterr = gpgme_op_edit(d->ctx, key.impl(),
-                                            d->lastEditInteractor.get() ? edit_interactor_callback : nullptr,
-                                            d->lastEditInteractor.get() ? d->lastEditInteractor->d : nullptr,
-                                            dp ? dp->data : nullptr));
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_edit(d->ctx, key.impl(),
+                                     d->lastEditInteractor.get() ? edit_interactor_callback : nullptr,
+                                     d->lastEditInteractor.get() ? d->lastEditInteractor->d : nullptr,
+                                     dp ? dp->data : nullptr));
 }
 
 
 Error Context::startEditing(const Key &key, std::unique_ptr<EditInteractor> func, Data &data)
 {
-    d->lastop = Private::Edit;
+    d->startOperation(Private::Edit);
     d->lastEditInteractor = std::move(func);
+    Error err;
+    if (d->quickEdit(this, key, d->lastEditInteractor.get(), true, err)) {
+        return d->started(err.encodedError());
+    }
     Data::Private *const dp = data.impl();
-    return Error(d->lasterr = gpgme_op_edit_start(d->ctx, key.impl(),
-                              d->lastEditInteractor.get() ? edit_interactor_callback : nullptr,
-                              d->lastEditInteractor.get() ? d->lastEditInteractor->d : nullptr,
-                              dp ? dp->data : nullptr));
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_edit_start(d->ctx, key.impl(),
+                      d->lastEditInteractor.get() ? edit_interactor_callback : nullptr,
+                      d->lastEditInteractor.get() ? d->lastEditInteractor->d : nullptr,
+                      dp ? dp->data : nullptr));
 }
 
 
@@ -833,24 +1842,26 @@ std::unique_ptr<EditInteractor> Context::takeLastEditInteractor()
 
 Error Context::cardEdit(const Key &key, std::unique_ptr<EditInteractor> func, Data &data)
 {
-    d->lastop = Private::CardEdit;
+    d->startOperation(Private::CardEdit);
     d->lastCardEditInteractor = std::move(func);
     Data::Private *const dp = data.impl();
-    return Error(d->lasterr = gpgme_op_card_edit(d->ctx, key.impl(),
-                              d->lastCardEditInteractor.get() ? edit_interactor_callback : nullptr,
-                              d->lastCardEditInteractor.get() ? d->lastCardEditInteractor->d : nullptr,
-                              dp ? dp->data : nullptr));
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_card_edit(d->ctx, key.impl(),
+                       d->lastCardEditInteractor.get() ? edit_interactor_callback : nullptr,
+                       d->lastCardEditInteractor.get() ? d->lastCardEditInteractor->d : nullptr,
+                       dp ? dp->data : nullptr));
 }
 
 Error Context::startCardEditing(const Key &key, std::unique_ptr<EditInteractor> func, Data &data)
 {
-    d->lastop = Private::CardEdit;
+    d->startOperation(Private::CardEdit);
     d->lastCardEditInteractor = std::move(func);
     Data::Private *const dp = data.impl();
-    return Error(d->lasterr = gpgme_op_card_edit_start(d->ctx, key.impl(),
-                              d->lastCardEditInteractor.get() ? edit_interactor_callback : nullptr,
-                              d->lastCardEditInteractor.get() ? d->lastCardEditInteractor->d : nullptr,
-                              dp ? dp->data : nullptr));
+    d->keyringChangeStarted();
+    return d->started(gpgme_op_card_edit_start(d->ctx, key.impl(),
+                      d->lastCardEditInteractor.get() ? edit_interactor_callback : nullptr,
+                      d->lastCardEditInteractor.get() ? d->lastCardEditInteractor->d : nullptr,
+                      dp ? dp->data : nullptr));
 }
 
 #pragma GCC diagnostic pop
@@ -908,10 +1919,10 @@ Error Context::assuanTransact(const char *command, std::unique_ptr<AssuanTransac
 {
     gpgme_error_t err, operr;
 
-    d->lastop = Private::AssuanTransact;
+    d->startOperation(Private::AssuanTransact);
     d->lastAssuanTransaction = std::move(transaction);
     if (!d->lastAssuanTransaction.get()) {
-        return Error(d->lasterr = make_error(GPG_ERR_INV_ARG));
+        return d->finished(make_error(GPG_ERR_INV_ARG));
     }
     err = gpgme_op_assuan_transact_ext
       (d->ctx,
@@ -926,9 +1937,8 @@ Error Context::assuanTransact(const char *command, std::unique_ptr<AssuanTransac
 
     if (!err)
       err = operr;
-    d->lasterr = err;
 
-    return Error(d->lasterr);
+    return d->finished(err);
 }
 
 Error Context::startAssuanTransaction(const char *command)
@@ -940,10 +1950,10 @@ Error Context::startAssuanTransaction(const char *command, std::unique_ptr<Assua
 {
     gpgme_error_t err;
 
-    d->lastop = Private::AssuanTransact;
+    d->startOperation(Private::AssuanTransact);
     d->lastAssuanTransaction = std::move(transaction);
     if (!d->lastAssuanTransaction.get()) {
-        return Error(d->lasterr = make_error(GPG_ERR_INV_ARG));
+        return d->finished(make_error(GPG_ERR_INV_ARG));
     }
     err = gpgme_op_assuan_transact_start
       (d->ctx,
@@ -955,9 +1965,7 @@ Error Context::startAssuanTransaction(const char *command, std::unique_ptr<Assua
        assuan_transaction_status_callback,
        d->lastAssuanTransaction.get());
 
-    d->lasterr = err;
-
-    return Error(d->lasterr);
+    return d->started(err);
 }
 
 AssuanTransaction *Context::lastAssuanTransaction() const
@@ -972,11 +1980,13 @@ std::unique_ptr<AssuanTransaction> Context::takeLastAssuanTransaction()
 
 DecryptionResult Context::decrypt(const Data &cipherText, Data &plainText, const DecryptionFlags flags)
 {
-    d->lastop = Private::Decrypt;
+    d->startOperation(Private::Decrypt, &cipherText, &plainText);
     const Data::Private *const cdp = cipherText.impl();
     Data::Private *const pdp = plainText.impl();
     d->lasterr = gpgme_op_decrypt_ext(d->ctx, static_cast<gpgme_decrypt_flags_t> (d->decryptFlags | flags), cdp ? cdp->data : nullptr, pdp ? pdp->data : nullptr);
-    return decryptionResult();
+    return d->finishOperation([this]() {
+        return decryptionResult();
+    });
 }
 
 DecryptionResult Context::decrypt(const Data &cipherText, Data &plainText)
@@ -986,11 +1996,11 @@ DecryptionResult Context::decrypt(const Data &cipherText, Data &plainText)
 
 Error Context::startDecryption(const Data &cipherText, Data &plainText, const DecryptionFlags flags)
 {
-    d->lastop = Private::Decrypt;
+    d->startOperation(Private::Decrypt, &cipherText, &plainText);
     const Data::Private *const cdp = cipherText.impl();
     Data::Private *const pdp = plainText.impl();
-    return Error(d->lasterr = gpgme_op_decrypt_ext_start(d->ctx, static_cast<gpgme_decrypt_flags_t> (d->decryptFlags | flags),
-                 cdp ? cdp->data : nullptr, pdp ? pdp->data : nullptr));
+    return d->started(gpgme_op_decrypt_ext_start(d->ctx, static_cast<gpgme_decrypt_flags_t> (d->decryptFlags | flags),
+         cdp ? cdp->data : nullptr, pdp ? pdp->data : nullptr));
 }
 
 Error Context::startDecryption(const Data &cipherText, Data &plainText)
@@ -1009,36 +2019,40 @@ DecryptionResult Context::decryptionResult() const
 
 VerificationResult Context::verifyDetachedSignature(const Data &signature, const Data &signedText)
 {
-    d->lastop = Private::Verify;
+    d->startOperation(Private::Verify, &signedText);
     const Data::Private *const sdp = signature.impl();
     const Data::Private *const tdp = signedText.impl();
     d->lasterr = gpgme_op_verify(d->ctx, sdp ? sdp->data : nullptr, tdp ? tdp->data : nullptr, nullptr);
-    return verificationResult();
+    return d->finishOperation([this]() {
+        return verificationResult();
+    });
 }
 
 VerificationResult Context::verifyOpaqueSignature(const Data &signedData, Data &plainText)
 {
-    d->lastop = Private::Verify;
+    d->startOperation(Private::Verify, &signedData, &plainText);
     const Data::Private *const sdp = signedData.impl();
     Data::Private *const pdp = plainText.impl();
     d->lasterr = gpgme_op_verify(d->ctx, sdp ? sdp->data : nullptr, nullptr, pdp ? pdp->data : nullptr);
-    return verificationResult();
+    return d->finishOperation([this]() {
+        return verificationResult();
+    });
 }
 
 Error Context::startDetachedSignatureVerification(const Data &signature, const Data &signedText)
 {
-    d->lastop = Private::Verify;
+    d->startOperation(Private::Verify, &signedText);
     const Data::Private *const sdp = signature.impl();
     const Data::Private *const tdp = signedText.impl();
-    return Error(d->lasterr = gpgme_op_verify_start(d->ctx, sdp ? sdp->data : nullptr, tdp ? tdp->data : nullptr, nullptr));
+    return d->started(gpgme_op_verify_start(d->ctx, sdp ? sdp->data : nullptr, tdp ? tdp->data : nullptr, nullptr));
 }
 
 Error Context::startOpaqueSignatureVerification(const Data &signedData, Data &plainText)
 {
-    d->lastop = Private::Verify;
+    d->startOperation(Private::Verify, &signedData, &plainText);
     const Data::Private *const sdp = signedData.impl();
     Data::Private *const pdp = plainText.impl();
-    return Error(d->lasterr = gpgme_op_verify_start(d->ctx, sdp ? sdp->data : nullptr, nullptr, pdp ? pdp->data : nullptr));
+    return d->started(gpgme_op_verify_start(d->ctx, sdp ? sdp->data : nullptr, nullptr, pdp ? pdp->data : nullptr));
 }
 
 VerificationResult Context::verificationResult() const
@@ -1061,12 +2075,14 @@ VerificationResult Context::verificationResult() const
 
 std::pair<DecryptionResult, VerificationResult> Context::decryptAndVerify(const Data &cipherText, Data &plainText, DecryptionFlags flags)
 {
-    d->lastop = Private::DecryptAndVerify;
+    d->startOperation(Private::DecryptAndVerify, &cipherText, &plainText);
     const Data::Private *const cdp = cipherText.impl();
     Data::Private *const pdp = plainText.impl();
     d->lasterr = gpgme_op_decrypt_ext(d->ctx, static_cast<gpgme_decrypt_flags_t> (d->decryptFlags | flags | DecryptVerify),
                                       cdp ? cdp->data : nullptr, pdp ? pdp->data : nullptr);
-    return std::make_pair(decryptionResult(), verificationResult());
+    return d->finishOperation([this]() {
+        return std::make_pair(decryptionResult(), verificationResult());
+    });
 }
 
 std::pair<DecryptionResult, VerificationResult> Context::decryptAndVerify(const Data &cipherText, Data &plainText)
@@ -1074,12 +2090,89 @@ std::pair<DecryptionResult, VerificationResult> Context::decryptAndVerify(const
     return decryptAndVerify(cipherText, plainText, DecryptNone);
 }
 
+namespace
+{
+// a data provider which passes the written data to a callback in chunks
+// of at most chunkSize bytes (unlimited if 0)
+class CallbackForwarder : public DataProvider
+{
+public:
+    explicit CallbackForwarder(const std::function<bool(const char *, size_t)> &callback, size_t chunkSize = 0)
+        : mCallback(callback),
+          mChunkSize(chunkSize),
+          mCanceled(false)
+    {
+    }
+
+    bool isSupported(Operation op) const override
+    {
+        return op == Write || op == Release;
+    }
+    ssize_type read(void *, size_t) override
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    ssize_type write(const void *buffer, size_t bufSize) override
+    {
+        const char *p = static_cast<const char *>(buffer);
+        for (size_t left = bufSize; left && !mCanceled;) {
+            const size_t n = mChunkSize ? std::min(left, mChunkSize) : left;
+            mCanceled = !mCallback(p, n);
+            p += n;
+            left -= n;
+        }
+        if (mCanceled) {
+            errno = ECANCELED;
+            return -1;
+        }
+        return bufSize;
+    }
+    off_type seek(off_type, int) override
+    {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    void release() override
+    {
+    }
+
+    bool canceled() const
+    {
+        return mCanceled;
+    }
+
+private:
+    const std::function<bool(const char *, size_t)> &mCallback;
+    const size_t mChunkSize;
+    bool mCanceled;
+};
+}
+
+std::pair<DecryptionResult, VerificationResult> Context::decryptAndVerifyStreaming(const Data &cipherText,
+                                                                                   const PlainTextCallback &callback,
+                                                                                   DecryptionFlags flags)
+{
+    if (!callback) {
+        const Error err = Error::fromCode(GPG_ERR_INV_VALUE);
+        return std::make_pair(DecryptionResult(err), VerificationResult(err));
+    }
+    CallbackForwarder forwarder(callback);
+    Data plainText(&forwarder);
+    auto results = decryptAndVerify(cipherText, plainText, flags);
+    if (forwarder.canceled()) {
+        const Error err = Error::fromCode(GPG_ERR_CANCELED);
+        return std::make_pair(DecryptionResult(err), VerificationResult(err));
+    }
+    return results;
+}
+
 Error Context::startCombinedDecryptionAndVerification(const Data &cipherText, Data &plainText, DecryptionFlags flags)
 {
-    d->lastop = Private::DecryptAndVerify;
+    d->startOperation(Private::DecryptAndVerify, &cipherText, &plainText);
     const Data::Private *const cdp = cipherText.impl();
     Data::Private *const pdp = plainText.impl();
-    return Error(d->lasterr = gpgme_op_decrypt_ext_start(d->ctx, static_cast<gpgme_decrypt_flags_t> (d->decryptFlags | flags | DecryptVerify), cdp ? cdp->data : nullptr, pdp ? pdp->data : nullptr));
+    return d->started(gpgme_op_decrypt_ext_start(d->ctx, static_cast<gpgme_decrypt_flags_t> (d->decryptFlags | flags | DecryptVerify), cdp ? cdp->data : nullptr, pdp ? pdp->data : nullptr));
 }
 
 Error Context::startCombinedDecryptionAndVerification(const Data &cipherText, Data &plainText)
@@ -1106,16 +2199,27 @@ unsigned int to_auditlog_flags(unsigned int flags)
 
 Error Context::startGetAuditLog(Data &output, unsigned int flags)
 {
-    d->lastop = Private::GetAuditLog;
+    d->startOperation(Private::GetAuditLog, nullptr, &output);
     Data::Private *const odp = output.impl();
-    return Error(d->lasterr = gpgme_op_getauditlog_start(d->ctx, odp ? odp->data : nullptr, to_auditlog_flags(flags)));
+    return d->started(gpgme_op_getauditlog_start(d->ctx, odp ? odp->data : nullptr, to_auditlog_flags(flags)));
 }
 
 Error Context::getAuditLog(Data &output, unsigned int flags)
 {
-    d->lastop = Private::GetAuditLog;
+    d->startOperation(Private::GetAuditLog, nullptr, &output);
     Data::Private *const odp = output.impl();
-    return Error(d->lasterr = gpgme_op_getauditlog(d->ctx, odp ? odp->data : nullptr, to_auditlog_flags(flags)));
+    return d->finished(gpgme_op_getauditlog(d->ctx, odp ? odp->data : nullptr, to_auditlog_flags(flags)));
+}
+
+Error Context::getAuditLog(const AuditLogCallback &callback, unsigned int flags, size_t chunkSize)
+{
+    if (!callback) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    CallbackForwarder forwarder(callback, chunkSize);
+    Data output(&forwarder);
+    const Error err = getAuditLog(output, flags);
+    return forwarder.canceled() ? Error::fromCode(GPG_ERR_CANCELED) : err;
 }
 
 void Context::clearSigningKeys()
@@ -1215,19 +2319,31 @@ static gpgme_sig_mode_t sigflags2sigflags(SignatureMode flags)
 
 SigningResult Context::sign(const Data &plainText, Data &signature, SignatureMode mode)
 {
-    d->lastop = Private::Sign;
+    d->startOperation(Private::Sign, &plainText, &signature);
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const sdp = signature.impl();
     d->lasterr = gpgme_op_sign(d->ctx, pdp ? pdp->data : nullptr, sdp ? sdp->data : nullptr, sigflags2sigflags(mode));
-    return SigningResult(d->ctx, Error(d->lasterr));
+    return d->finishOperation([this]() {
+        return SigningResult(d->ctx, Error(d->lasterr));
+    });
 }
 
 Error Context::startSigning(const Data &plainText, Data &signature, SignatureMode mode)
 {
-    d->lastop = Private::Sign;
+    d->startOperation(Private::Sign, &plainText, &signature);
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const sdp = signature.impl();
-    return Error(d->lasterr = gpgme_op_sign_start(d->ctx, pdp ? pdp->data : nullptr, sdp ? sdp->data : nullptr, sigflags2sigflags(mode)));
+    return d->started(gpgme_op_sign_start(d->ctx, pdp ? pdp->data : nullptr, sdp ? sdp->data : nullptr, sigflags2sigflags(mode)));
+}
+
+SigningResult Context::signFile(const std::string &fileName, Data &signature, SignatureMode mode)
+{
+    if (protocol() != OpenPGP) {
+        return SigningResult(Error::fromCode(GPG_ERR_NOT_SUPPORTED));
+    }
+    Data plainText;
+    plainText.setFileName(fileName);
+    return sign(plainText, signature, static_cast<SignatureMode>(mode | SignFile));
 }
 
 SigningResult Context::signingResult() const
@@ -1284,63 +2400,103 @@ static gpgme_encrypt_flags_t encryptflags2encryptflags(Context::EncryptionFlags
     return static_cast<gpgme_encrypt_flags_t>(result);
 }
 
-gpgme_key_t *Context::getKeysFromRecipients(const std::vector<Key> &recipients)
+std::vector<gpgme_key_t> Context::Private::recipientKeys(const std::vector<Key> &recipients)
+{
+    std::vector<gpgme_key_t> keys;
+    keys.reserve(recipients.size() + 1);
+    for (const Key &key : recipients) {
+        if (key.impl()) {
+            keys.push_back(key.impl());
+        }
+    }
+    keys.push_back(nullptr);
+    return keys;
+}
+
+Context::Private::RecipientArray::RecipientArray(const std::vector<Key> &recipients)
+    : mKeys(nullptr)
 {
     if (recipients.empty()) {
-        return nullptr;
+        return;
     }
-    gpgme_key_t *ret = new gpgme_key_t[ recipients.size() + 1 ];
-    gpgme_key_t *keys_it = ret;
-    for (std::vector<Key>::const_iterator it = recipients.begin() ; it != recipients.end() ; ++it) {
-        if (it->impl()) {
-            *keys_it++ = it->impl();
+    if (recipients.size() <= InlineSize) {
+        mKeys = mInline;
+    } else {
+        mHeap.resize(recipients.size() + 1);
+        mKeys = mHeap.data();
+    }
+    gpgme_key_t *keys_it = mKeys;
+    for (const Key &key : recipients) {
+        if (key.impl()) {
+            *keys_it++ = key.impl();
         }
     }
-    *keys_it++ = nullptr;
-    return ret;
+    *keys_it = nullptr;
 }
 
 EncryptionResult Context::encrypt(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
 {
-    d->lastop = Private::Encrypt;
+    d->startOperation(Private::Encrypt, &plainText, &cipherText, recipients.size());
     if (flags & NoEncryptTo) {
-        return EncryptionResult(Error(d->lasterr = make_error(GPG_ERR_NOT_IMPLEMENTED)));
+        return EncryptionResult(d->finished(make_error(GPG_ERR_NOT_IMPLEMENTED)));
     }
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const cdp = cipherText.impl();
-    gpgme_key_t *const keys = getKeysFromRecipients(recipients);
-    d->lasterr = gpgme_op_encrypt(d->ctx, keys, encryptflags2encryptflags(flags),
+    Private::RecipientArray keys{recipients};
+    d->lasterr = gpgme_op_encrypt(d->ctx, keys.keys(), encryptflags2encryptflags(flags),
                                   pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr);
-    if (keys) {
-        delete[] keys;
-    }
-    return EncryptionResult(d->ctx, Error(d->lasterr));
+    return d->finishOperation([this]() {
+        return EncryptionResult(d->ctx, Error(d->lasterr));
+    });
 }
 
 Error Context::encryptSymmetrically(const Data &plainText, Data &cipherText)
 {
-    d->lastop = Private::Encrypt;
+    d->startOperation(Private::Encrypt, &plainText, &cipherText);
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const cdp = cipherText.impl();
-    return Error(d->lasterr = gpgme_op_encrypt(d->ctx, nullptr, (gpgme_encrypt_flags_t)0,
-                              pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr));
+    return d->finished(gpgme_op_encrypt(d->ctx, nullptr, (gpgme_encrypt_flags_t)0,
+                       pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr));
 }
 
 Error Context::startEncryption(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
 {
-    d->lastop = Private::Encrypt;
+    d->startOperation(Private::Encrypt, &plainText, &cipherText, recipients.size());
     if (flags & NoEncryptTo) {
-        return Error(d->lasterr = make_error(GPG_ERR_NOT_IMPLEMENTED));
+        return d->finished(make_error(GPG_ERR_NOT_IMPLEMENTED));
     }
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const cdp = cipherText.impl();
-    gpgme_key_t *const keys = getKeysFromRecipients(recipients);
-    d->lasterr = gpgme_op_encrypt_start(d->ctx, keys, encryptflags2encryptflags(flags),
-                                        pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr);
-    if (keys) {
-        delete[] keys;
+    Private::RecipientArray keys{recipients};
+    return d->started(gpgme_op_encrypt_start(d->ctx, keys.keys(), encryptflags2encryptflags(flags),
+                                             pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr));
+}
+
+EncryptionResult Context::encrypt(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
+{
+    d->startOperation(Private::Encrypt, &plainText, &cipherText, recipients.size());
+    if (flags & NoEncryptTo) {
+        return EncryptionResult(d->finished(make_error(GPG_ERR_NOT_IMPLEMENTED)));
     }
-    return Error(d->lasterr);
+    const Data::Private *const pdp = plainText.impl();
+    Data::Private *const cdp = cipherText.impl();
+    d->lasterr = gpgme_op_encrypt(d->ctx, recipients.gpgmeKeys(), encryptflags2encryptflags(flags),
+                                  pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr);
+    return d->finishOperation([this]() {
+        return EncryptionResult(d->ctx, Error(d->lasterr));
+    });
+}
+
+Error Context::startEncryption(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
+{
+    d->startOperation(Private::Encrypt, &plainText, &cipherText, recipients.size());
+    if (flags & NoEncryptTo) {
+        return d->finished(make_error(GPG_ERR_NOT_IMPLEMENTED));
+    }
+    const Data::Private *const pdp = plainText.impl();
+    Data::Private *const cdp = cipherText.impl();
+    return d->started(gpgme_op_encrypt_start(d->ctx, recipients.gpgmeKeys(), encryptflags2encryptflags(flags),
+                                             pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr));
 }
 
 EncryptionResult Context::encryptionResult() const
@@ -1354,61 +2510,129 @@ EncryptionResult Context::encryptionResult() const
 
 std::pair<SigningResult, EncryptionResult> Context::signAndEncrypt(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
 {
-    d->lastop = Private::SignAndEncrypt;
+    d->startOperation(Private::SignAndEncrypt, &plainText, &cipherText, recipients.size());
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const cdp = cipherText.impl();
-    gpgme_key_t *const keys = getKeysFromRecipients(recipients);
-    d->lasterr = gpgme_op_encrypt_sign(d->ctx, keys, encryptflags2encryptflags(flags),
+    Private::RecipientArray keys{recipients};
+    d->lasterr = gpgme_op_encrypt_sign(d->ctx, keys.keys(), encryptflags2encryptflags(flags),
                                        pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr);
-    if (keys) {
-        delete[] keys;
-    }
-    return std::make_pair(SigningResult(d->ctx, Error(d->lasterr)),
-                          EncryptionResult(d->ctx, Error(d->lasterr)));
+    return d->finishOperation([this]() {
+        return std::make_pair(SigningResult(d->ctx, Error(d->lasterr)),
+                              EncryptionResult(d->ctx, Error(d->lasterr)));
+    });
 }
 
 Error Context::startCombinedSigningAndEncryption(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
 {
-    d->lastop = Private::SignAndEncrypt;
+    d->startOperation(Private::SignAndEncrypt, &plainText, &cipherText, recipients.size());
     const Data::Private *const pdp = plainText.impl();
     Data::Private *const cdp = cipherText.impl();
-    gpgme_key_t *const keys = getKeysFromRecipients(recipients);
-    d->lasterr = gpgme_op_encrypt_sign_start(d->ctx, keys, encryptflags2encryptflags(flags),
-                 pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr);
-    if (keys) {
-        delete[] keys;
-    }
-    return Error(d->lasterr);
+    Private::RecipientArray keys{recipients};
+    return d->started(gpgme_op_encrypt_sign_start(d->ctx, keys.keys(), encryptflags2encryptflags(flags),
+                                                  pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr));
+}
+
+std::pair<SigningResult, EncryptionResult> Context::signAndEncrypt(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
+{
+    d->startOperation(Private::SignAndEncrypt, &plainText, &cipherText, recipients.size());
+    const Data::Private *const pdp = plainText.impl();
+    Data::Private *const cdp = cipherText.impl();
+    d->lasterr = gpgme_op_encrypt_sign(d->ctx, recipients.gpgmeKeys(), encryptflags2encryptflags(flags),
+                                       pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr);
+    return d->finishOperation([this]() {
+        return std::make_pair(SigningResult(d->ctx, Error(d->lasterr)),
+                              EncryptionResult(d->ctx, Error(d->lasterr)));
+    });
+}
+
+Error Context::startCombinedSigningAndEncryption(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
+{
+    d->startOperation(Private::SignAndEncrypt, &plainText, &cipherText, recipients.size());
+    const Data::Private *const pdp = plainText.impl();
+    Data::Private *const cdp = cipherText.impl();
+    return d->started(gpgme_op_encrypt_sign_start(d->ctx, recipients.gpgmeKeys(), encryptflags2encryptflags(flags),
+                                                  pdp ? pdp->data : nullptr, cdp ? cdp->data : nullptr));
 }
 
 Error Context::createVFS(const char *containerFile, const std::vector< Key > &recipients)
 {
-    d->lastop = Private::CreateVFS;
-    gpgme_key_t *const keys = new gpgme_key_t[ recipients.size() + 1 ];
-    gpgme_key_t *keys_it = keys;
-    for (std::vector<Key>::const_iterator it = recipients.begin() ; it != recipients.end() ; ++it) {
-        if (it->impl()) {
-            *keys_it++ = it->impl();
-        }
-    }
-    *keys_it++ = nullptr;
+    d->startOperation(Private::CreateVFS, nullptr, nullptr, recipients.size());
+    Private::RecipientArray keys{recipients};
 
     gpgme_error_t op_err;
-    d->lasterr = gpgme_op_vfs_create(d->ctx, keys, containerFile, 0, &op_err);
-    delete[] keys;
-    Error error(d->lasterr);
-    if (error) {
-        return error;
+    gpgme_key_t noKeys[] = {nullptr};
+    d->lasterr = gpgme_op_vfs_create(d->ctx, keys.keys() ? keys.keys() : noKeys, containerFile, 0, &op_err);
+    if (d->lasterr) {
+        return d->finished(d->lasterr);
     }
-    return Error(d->lasterr = op_err);
+    return d->finished(op_err);
 }
 
 VfsMountResult Context::mountVFS(const char *containerFile, const char *mountDir)
 {
-    d->lastop = Private::MountVFS;
+    d->startOperation(Private::MountVFS);
     gpgme_error_t op_err;
     d->lasterr = gpgme_op_vfs_mount(d->ctx, containerFile, mountDir, 0, &op_err);
-    return VfsMountResult(d->ctx, Error(d->lasterr), Error(op_err));
+    return d->finishOperation([this, op_err]() {
+        return VfsMountResult(d->ctx, Error(d->lasterr), Error(op_err));
+    });
+}
+
+std::future<Error> Context::createVFSAsync(const std::string &containerFile, const std::vector<Key> &recipients)
+{
+    return std::async(std::launch::async, [this, containerFile, recipients]() {
+        return createVFS(containerFile.c_str(), recipients);
+    });
+}
+
+std::future<VfsMountResult> Context::mountVFSAsync(const std::string &containerFile, const std::string &mountDir)
+{
+    return std::async(std::launch::async, [this, containerFile, mountDir]() {
+        return mountVFS(containerFile.c_str(), mountDir.c_str());
+    });
+}
+
+std::vector<Error> Context::createVFSs(const std::vector<VFSCreateRequest> &requests, unsigned int concurrency)
+{
+    std::vector<Error> results(requests.size());
+    const size_t count = std::min<size_t>(std::max(concurrency, 1u), requests.size());
+    if (count == 0) {
+        return results;
+    }
+    const EngineInfo engine = engineInfo();
+
+    std::vector<std::unique_ptr<Context>> contexts(count);
+    for (auto &ctx : contexts) {
+        Error err;
+        ctx = createForEngine(G13Engine, &err);
+        if (!ctx) {
+            std::fill(results.begin(), results.end(), err);
+            return results;
+        }
+        ctx->setEngineFileName(engine.fileName());
+        ctx->setEngineHomeDirectory(engine.homeDirectory());
+        ctx->setInstrumentation(d->instrumentation);
+        ctx->setTracer(d->tracer);
+        ctx->setTraceParent(d->traceParent ? d->traceParent : TraceScope::current());
+    }
+
+    std::atomic<size_t> next(0);
+    const auto work = [&requests, &results, &next](Context *ctx) {
+        for (size_t i = next++; i < requests.size(); i = next++) {
+            // every worker writes to a different element
+            results[i] = ctx->createVFS(requests[i].containerFile.c_str(), requests[i].recipients);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i) {
+        threads.emplace_back(work, contexts[i].get());
+    }
+    work(contexts[0].get());
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return results;
 }
 
 Error Context::cancelPendingOperation()
@@ -1424,9 +2648,11 @@ Error Context::cancelPendingOperationImmediately()
 bool Context::poll()
 {
     gpgme_error_t e = GPG_ERR_NO_ERROR;
+    const auto start = d->engineWaitStarted();
     const bool finished = gpgme_wait(d->ctx, &e, 0);
+    d->engineWaitFinished(start);
     if (finished) {
-        d->lasterr = e;
+        d->finished(e);
     }
     return finished;
 }
@@ -1434,8 +2660,28 @@ bool Context::poll()
 Error Context::wait()
 {
     gpgme_error_t e = GPG_ERR_NO_ERROR;
+    const auto start = d->engineWaitStarted();
     gpgme_wait(d->ctx, &e, 1);
-    return Error(d->lasterr = e);
+    d->engineWaitFinished(start);
+    return d->finished(e);
+}
+
+Error Context::wait(std::chrono::milliseconds timeout)
+{
+    if (timeout.count() > 0) {
+        d->armTimeout(std::chrono::steady_clock::now() + timeout, false);
+    }
+    return wait();
+}
+
+void Context::setOperationTimeout(std::chrono::milliseconds timeout)
+{
+    d->operationTimeout = timeout;
+}
+
+std::chrono::milliseconds Context::operationTimeout() const
+{
+    return d->operationTimeout;
 }
 
 Error Context::lastError() const
@@ -1504,12 +2750,14 @@ static gpgme_tofu_policy_t to_tofu_policy_t(unsigned int policy)
 
 Error Context::setTofuPolicy(const Key &k, unsigned int policy)
 {
-    return Error(d->lasterr = gpgme_op_tofu_policy(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_tofu_policy(d->ctx,
                  k.impl(), to_tofu_policy_t(policy)));
 }
 
 Error Context::setTofuPolicyStart(const Key &k, unsigned int policy)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_tofu_policy_start(d->ctx,
                  k.impl(), to_tofu_policy_t(policy)));
 }
@@ -1522,6 +2770,7 @@ Error Context::startCreateKey (const char *userid,
                                const Key &certkey,
                                unsigned int flags)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_createkey_start(d->ctx,
                  userid,
                  algo,
@@ -1531,6 +2780,50 @@ Error Context::startCreateKey (const char *userid,
                  flags));
 }
 
+std::vector<KeyGenerationResult> Context::createKeys(const std::vector<KeyGenRequest> &requests, unsigned int concurrency)
+{
+    std::vector<KeyGenerationResult> results(requests.size());
+    const size_t count = std::min<size_t>(std::max(concurrency, 1u), requests.size());
+    if (count == 0) {
+        return results;
+    }
+    const EngineInfo engine = engineInfo();
+
+    std::vector<std::unique_ptr<Context>> contexts(count);
+    for (auto &ctx : contexts) {
+        ctx.reset(createForProtocol(protocol()));
+        if (!ctx) {
+            std::fill(results.begin(), results.end(), KeyGenerationResult(Error::fromCode(GPG_ERR_INV_ENGINE)));
+            return results;
+        }
+        ctx->setEngineFileName(engine.fileName());
+        ctx->setEngineHomeDirectory(engine.homeDirectory());
+        ctx->setPinentryMode(pinentryMode());
+        ctx->setInstrumentation(d->instrumentation);
+        ctx->setTracer(d->tracer);
+        ctx->setTraceParent(d->traceParent ? d->traceParent : TraceScope::current());
+    }
+
+    std::atomic<size_t> next(0);
+    const auto work = [&requests, &results, &next](Context *ctx) {
+        for (size_t i = next++; i < requests.size(); i = next++) {
+            const KeyGenRequest &request = requests[i];
+            // every worker writes to a different element
+            results[i] = ctx->createKey(request.userid, request.algo, request.expires, request.flags);
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for (size_t i = 1; i < count; ++i) {
+        threads.emplace_back(work, contexts[i].get());
+    }
+    work(contexts[0].get());
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
 // deprecated
 Error Context::createKey (const char *userid,
                           const char *algo,
@@ -1539,7 +2832,8 @@ Error Context::createKey (const char *userid,
                           const Key &certkey,
                           unsigned int flags)
 {
-    return Error(d->lasterr = gpgme_op_createkey(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_createkey(d->ctx,
                  userid,
                  algo,
                  reserved,
@@ -1556,6 +2850,7 @@ KeyGenerationResult Context::createKeyEx (const char *userid,
                                           const Key &certkey,
                                           unsigned int flags)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_createkey(d->ctx,
                  userid,
                  algo,
@@ -1563,7 +2858,7 @@ KeyGenerationResult Context::createKeyEx (const char *userid,
                  expires,
                  certkey.impl(),
                  flags);
-    return KeyGenerationResult(d->ctx, Error(d->lasterr));
+    return KeyGenerationResult(d->ctx, d->finished(d->lasterr));
 }
 
 KeyGenerationResult Context::createKey(const std::string &userid,
@@ -1571,6 +2866,7 @@ KeyGenerationResult Context::createKey(const std::string &userid,
                                        unsigned long expires,
                                        CreationFlags flags)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_createkey(d->ctx,
                                     userid.c_str(),
                                     algo.c_str(),
@@ -1578,7 +2874,7 @@ KeyGenerationResult Context::createKey(const std::string &userid,
                                     expires,
                                     nullptr,
                                     flags);
-    return KeyGenerationResult{d->ctx, Error{d->lasterr}};
+    return KeyGenerationResult{d->ctx, d->finished(d->lasterr)};
 }
 
 Error Context::startCreateKey(const std::string &userid,
@@ -1586,6 +2882,7 @@ Error Context::startCreateKey(const std::string &userid,
                               unsigned long expires,
                               CreationFlags flags)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_createkey_start(d->ctx,
                                           userid.c_str(),
                                           algo.c_str(),
@@ -1598,35 +2895,41 @@ Error Context::startCreateKey(const std::string &userid,
 
 Error Context::addUid(const Key &k, const char *userid)
 {
-    return Error(d->lasterr = gpgme_op_adduid(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_adduid(d->ctx,
                  k.impl(), userid, 0));
 }
 
 Error Context::startAddUid(const Key &k, const char *userid)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_adduid_start(d->ctx,
                  k.impl(), userid, 0));
 }
 
 Error Context::revUid(const Key &k, const char *userid)
 {
-    return Error(d->lasterr = gpgme_op_revuid(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_revuid(d->ctx,
                  k.impl(), userid, 0));
 }
 
 Error Context::startRevUid(const Key &k, const char *userid)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_revuid_start(d->ctx,
                  k.impl(), userid, 0));
 }
 
 Error Context::setPrimaryUid(const Key &k, const char *userid)
 {
-    return Error(d->lasterr = gpgme_op_set_uid_flag(d->ctx, k.impl(), userid, "primary", nullptr));
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_set_uid_flag(d->ctx, k.impl(), userid, "primary", nullptr));
 }
 
 Error Context::startSetPrimaryUid(const Key &k, const char *userid)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_set_uid_flag_start(d->ctx, k.impl(), userid, "primary", nullptr));
 }
 
@@ -1636,7 +2939,8 @@ Error Context::createSubkey(const Key &k, const char *algo,
                             unsigned long expires,
                             unsigned int flags)
 {
-    return Error(d->lasterr = gpgme_op_createsubkey(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_createsubkey(d->ctx,
                  k.impl(), algo, reserved, expires, flags));
 }
 
@@ -1646,6 +2950,7 @@ Error Context::startCreateSubkey(const Key &k, const char *algo,
                                  unsigned long expires,
                                  unsigned int flags)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_createsubkey_start(d->ctx,
                  k.impl(), algo, reserved, expires, flags));
 }
@@ -1655,13 +2960,14 @@ KeyGenerationResult Context::createSubkey(const Key &k,
                                           unsigned long expires,
                                           CreationFlags flags)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_createsubkey(d->ctx,
                                        k.impl(),
                                        algo.c_str(),
                                        0,
                                        expires,
                                        flags);
-    return KeyGenerationResult{d->ctx, Error{d->lasterr}};
+    return KeyGenerationResult{d->ctx, d->finished(d->lasterr)};
 }
 
 Error Context::startCreateSubkey(const Key &k,
@@ -1669,6 +2975,7 @@ Error Context::startCreateSubkey(const Key &k,
                                  unsigned long expires,
                                  CreationFlags flags)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_createsubkey_start(d->ctx,
                                              k.impl(),
                                              algo.c_str(),
@@ -1721,7 +3028,8 @@ Error Context::setExpire(const Key &k, unsigned long expires,
     } else {
         subfprs = getLFSeparatedListOfFingerprintsFromSubkeys(subkeys);
     }
-    return Error(d->lasterr = gpgme_op_setexpire(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_setexpire(d->ctx,
                  k.impl(), expires, subfprs.c_str(), 0));
 }
 
@@ -1735,6 +3043,7 @@ Error Context::startSetExpire(const Key &k, unsigned long expires,
     } else {
         subfprs = getLFSeparatedListOfFingerprintsFromSubkeys(subkeys);
     }
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_setexpire_start(d->ctx,
                  k.impl(), expires, subfprs.c_str(), 0));
 }
@@ -1758,13 +3067,14 @@ static const char *owner_trust_to_string(Key::OwnerTrust trust)
 
 Error Context::setOwnerTrust(const Key &key, Key::OwnerTrust trust)
 {
-    d->lasterr = gpgme_op_setownertrust(d->ctx, key.impl(),
-                                        owner_trust_to_string(trust));
-    return Error(d->lasterr);
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_setownertrust(d->ctx, key.impl(),
+                                              owner_trust_to_string(trust)));
 }
 
 Error Context::startSetOwnerTrust(const Key &key, Key::OwnerTrust trust)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_setownertrust_start(d->ctx, key.impl(),
                                               owner_trust_to_string(trust));
     return Error(d->lasterr);
@@ -1772,18 +3082,80 @@ Error Context::startSetOwnerTrust(const Key &key, Key::OwnerTrust trust)
 
 Error Context::setKeyEnabled(const Key &key, bool enabled)
 {
-    d->lasterr = gpgme_op_setownertrust(d->ctx, key.impl(),
-                                        enabled ? "enable" : "disable");
-    return Error(d->lasterr);
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_setownertrust(d->ctx, key.impl(),
+                                              enabled ? "enable" : "disable"));
 }
 
 Error Context::startSetKeyEnabled(const Key &key, bool enabled)
 {
+    d->keyringChangeStarted();
     d->lasterr = gpgme_op_setownertrust_start(d->ctx, key.impl(),
                                               enabled ? "enable" : "disable");
     return Error(d->lasterr);
 }
 
+// runs gpg with the home directory of ctx and the given command
+static Error spawn_gpg(const Context *ctx, const char *command, Data &input, Data &output, Data &diagnostics)
+{
+    if (ctx->protocol() != OpenPGP) {
+        return Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    const EngineInfo info = ctx->engineInfo();
+    if (!info.fileName()) {
+        return Error::fromCode(GPG_ERR_INV_ENGINE);
+    }
+    Error err;
+    const std::unique_ptr<Context> spawnCtx = Context::createForEngine(SpawnEngine, &err);
+    if (!spawnCtx) {
+        return err;
+    }
+    // the status lines go to the diagnostics, too
+    std::vector<const char *> argv = {"gpg", "--batch", "--no-tty", "--quiet", "--status-fd", "2"};
+    if (info.homeDirectory()) {
+        argv.push_back("--homedir");
+        argv.push_back(info.homeDirectory());
+    }
+    argv.push_back(command);
+    argv.push_back(nullptr);
+    return spawnCtx->spawn(info.fileName(), argv.data(), input, output, diagnostics, Context::SpawnNone);
+}
+
+Error Context::exportOwnerTrust(Data &trustData)
+{
+    Data input(Data::null);
+    Data diagnostics;
+    return Error(d->lasterr = spawn_gpg(this, "--export-ownertrust", input, trustData, diagnostics).encodedError());
+}
+
+Error Context::importOwnerTrust(const Data &trustData)
+{
+    d->keyringChangeStarted();
+    Data input = trustData;
+    Data output(Data::null);
+    Data diagnostics;
+    Error err = spawn_gpg(this, "--import-ownertrust", input, output, diagnostics);
+    if (!err) {
+        // the spawn engine does not report the exit status, but gpg reports
+        // problems with the data (and failing with them) by status lines
+        for (const std::string &line : split(diagnostics.toString(), '\n')) {
+            static const char prefix[] = "[GNUPG:] ";
+            if (line.compare(0, sizeof(prefix) - 1, prefix) != 0) {
+                continue;
+            }
+            const std::vector<std::string> fields = split(line.substr(sizeof(prefix) - 1), ' ');
+            if (fields.size() < 3 || (fields[0] != "ERROR" && fields[0] != "FAILURE")) {
+                continue;
+            }
+            char *end = nullptr;
+            const unsigned long code = std::strtoul(fields[2].c_str(), &end, 10);
+            err = (*end || !code) ? Error::fromCode(GPG_ERR_GENERAL) : Error(static_cast<gpgme_error_t>(code));
+            break;
+        }
+    }
+    return d->finished(err.encodedError());
+}
+
 static std::string getLFSeparatedListOfUserIds(const std::vector<UserID> &userIds)
 {
     if (userIds.empty()) {
@@ -1806,7 +3178,8 @@ Error Context::revokeSignature(const Key &key, const Key &signingKey,
 {
     const unsigned int flags = userIds.size() > 1 ? GPGME_REVSIG_LFSEP : 0;
     const std::string uids = getLFSeparatedListOfUserIds(userIds);
-    return Error(d->lasterr = gpgme_op_revsig(d->ctx,
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_revsig(d->ctx,
                  key.impl(), signingKey.impl(), uids.c_str(), flags));
 }
 
@@ -1815,17 +3188,71 @@ Error Context::startRevokeSignature(const Key &key, const Key &signingKey,
 {
     const unsigned int flags = userIds.size() > 1 ? GPGME_REVSIG_LFSEP : 0;
     const std::string uids = getLFSeparatedListOfUserIds(userIds);
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_revsig_start(d->ctx,
                  key.impl(), signingKey.impl(), uids.c_str(), flags));
 }
 
+static unsigned int keysignflags2keysignflags(Context::KeySignFlags flags, bool lfsep)
+{
+    unsigned int result = lfsep ? GPGME_KEYSIGN_LFSEP : 0;
+    if (flags & Context::KeySignLocal) {
+        result |= GPGME_KEYSIGN_LOCAL;
+    }
+    if (flags & Context::KeySignNoExpire) {
+        result |= GPGME_KEYSIGN_NOEXPIRE;
+    }
+    if (flags & Context::KeySignForce) {
+        result |= GPGME_KEYSIGN_FORCE;
+    }
+    return result;
+}
+
+Error Context::signKey(const Key &key, const std::vector<UserID> &userIds,
+                       unsigned long expires, KeySignFlags flags)
+{
+    const std::string uids = getLFSeparatedListOfUserIds(userIds);
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_keysign(d->ctx, key.impl(), uids.empty() ? nullptr : uids.c_str(),
+                                        expires, keysignflags2keysignflags(flags, userIds.size() > 1)));
+}
+
+Error Context::startSignKey(const Key &key, const std::vector<UserID> &userIds,
+                            unsigned long expires, KeySignFlags flags)
+{
+    const std::string uids = getLFSeparatedListOfUserIds(userIds);
+    d->keyringChangeStarted();
+    return Error(d->lasterr = gpgme_op_keysign_start(d->ctx, key.impl(), uids.empty() ? nullptr : uids.c_str(),
+                                                     expires, keysignflags2keysignflags(flags, userIds.size() > 1)));
+}
+
+std::vector<Error> Context::signKeys(const std::vector<Key> &keys, const Key &signingKey,
+                                     unsigned long expires, KeySignFlags flags)
+{
+    std::vector<Error> errors;
+    errors.reserve(keys.size());
+    const std::vector<Key> signers = signingKeys();
+    clearSigningKeys();
+    const Error err = addSigningKey(signingKey);
+    for (const Key &key : keys) {
+        errors.push_back(err ? err : signKey(key, std::vector<UserID>(), expires, flags));
+    }
+    clearSigningKeys();
+    for (const Key &signer : signers) {
+        addSigningKey(signer);
+    }
+    return errors;
+}
+
 Error Context::addAdsk(const Key &k, const char *adsk)
 {
-    return Error(d->lasterr = gpgme_op_createsubkey(d->ctx, k.impl(), adsk, 0, 0, GPGME_CREATE_ADSK));
+    d->keyringChangeStarted();
+    return d->finished(gpgme_op_createsubkey(d->ctx, k.impl(), adsk, 0, 0, GPGME_CREATE_ADSK));
 }
 
 Error Context::startAddAdsk(const Key &k, const char *adsk)
 {
+    d->keyringChangeStarted();
     return Error(d->lasterr = gpgme_op_createsubkey_start(d->ctx, k.impl(), adsk, 0, 0, GPGME_CREATE_ADSK));
 }
 
@@ -1864,6 +3291,24 @@ RandomBytesResult Context::generateRandomBytes(size_t count)
     return RandomBytesResult{std::move(randomBytes)};
 }
 
+Error Context::generateRandomBytes(unsigned char *buffer, size_t count)
+{
+    // gpgme_op_random_bytes returns at most 1024 bytes at once
+    static const size_t maxChunkSize = 1024;
+    if (!buffer && count) {
+        return Error(d->lasterr = make_error(GPG_ERR_INV_VALUE));
+    }
+    d->lasterr = GPG_ERR_NO_ERROR;
+    while (count && !d->lasterr) {
+        const size_t chunkSize = std::min(count, maxChunkSize);
+        d->lasterr = gpgme_op_random_bytes(d->ctx, GPGME_RANDOM_MODE_NORMAL,
+                                           reinterpret_cast<char *>(buffer), chunkSize);
+        buffer += chunkSize;
+        count -= chunkSize;
+    }
+    return Error(d->lasterr);
+}
+
 RandomValueResult Context::generateRandomValue(unsigned int limit)
 {
     size_t randomValue;
@@ -1890,6 +3335,7 @@ Error Context::spawn(const char *file, const char *argv[],
                      Data &input, Data &output, Data &err,
                      SpawnFlags flags)
 {
+    invalidate_data_types({&input, &output, &err});
     return Error(d->lasterr = gpgme_op_spawn (d->ctx, file, argv,
         input.impl() ? input.impl()->data : nullptr,
         output.impl() ? output.impl()->data : nullptr,
@@ -1901,6 +3347,7 @@ Error Context::spawnAsync(const char *file, const char *argv[],
                           Data &input, Data &output, Data &err,
                           SpawnFlags flags)
 {
+    invalidate_data_types({&input, &output, &err});
     return Error(d->lasterr = gpgme_op_spawn_start (d->ctx, file, argv,
         input.impl() ? input.impl()->data : nullptr,
         output.impl() ? output.impl()->data : nullptr,
@@ -1908,6 +3355,65 @@ Error Context::spawnAsync(const char *file, const char *argv[],
         static_cast<int>(flags)));
 }
 
+Error Context::spawn(const char *file, const char *argv[],
+                     int input, int output, int err,
+                     SpawnFlags flags, int *exitStatus)
+{
+    if (exitStatus) {
+        *exitStatus = -1;
+    }
+#ifdef _WIN32
+    (void)file;
+    (void)argv;
+    (void)input;
+    (void)output;
+    (void)err;
+    (void)flags;
+    return Error(d->lasterr = make_error(GPG_ERR_NOT_SUPPORTED));
+#else
+    if (!file || !argv) {
+        return Error(d->lasterr = make_error(GPG_ERR_INV_VALUE));
+    }
+    posix_spawn_file_actions_t actions;
+    if (const int rc = posix_spawn_file_actions_init(&actions)) {
+        return Error(d->lasterr = gpg_error_from_errno(rc));
+    }
+    const int fds[] = {input, output, err};
+    int rc = 0;
+    for (int i = 0; i < 3 && !rc; ++i) {
+        rc = fds[i] >= 0 ? posix_spawn_file_actions_adddup2(&actions, fds[i], i)
+                         : posix_spawn_file_actions_addopen(&actions, i, "/dev/null", i ? O_WRONLY : O_RDONLY, 0);
+    }
+    pid_t pid;
+    if (!rc) {
+        rc = posix_spawn(&pid, file, &actions, nullptr, const_cast<char *const *>(argv), environ);
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc) {
+        return Error(d->lasterr = gpg_error_from_errno(rc));
+    }
+
+    if (flags & SpawnDetached) {
+        // reap the child in the background, so that it does not linger as zombie
+        std::thread([pid]() {
+            while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {
+            }
+        }).detach();
+        return Error(d->lasterr = GPG_ERR_NO_ERROR);
+    }
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return Error(d->lasterr = gpg_error_from_syserror());
+        }
+    }
+    if (exitStatus && WIFEXITED(status)) {
+        *exitStatus = WEXITSTATUS(status);
+    }
+    return Error(d->lasterr = GPG_ERR_NO_ERROR);
+#endif
+}
+
 std::ostream &operator<<(std::ostream &os, Protocol proto)
 {
     os << "GpgME::Protocol(";
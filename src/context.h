@@ -28,10 +28,18 @@
 
 #include "error.h"
 #include "key.h"
+#include "keylistoptions.h"
+#include "keylistrange.h"
+#include "recipientset.h"
+#include "throttledprogressprovider.h"
 #include "verificationresult.h" // for Signature::Notation
 
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 #include <utility>
@@ -43,6 +51,10 @@ namespace GpgME
 class Data;
 class ProgressProvider;
 class PassphraseProvider;
+class Instrumentation;
+class KeyListInterner;
+class Tracer;
+class TraceSpan;
 class EventLoopInteractor;
 class EditInteractor;
 class AssuanTransaction;
@@ -121,6 +133,25 @@ public:
     void addKeyListMode(unsigned int keyListMode);
     unsigned int keyListMode() const;
 
+    /** Sets a key listing mode fixed at compile time without translating it
+     * at runtime. See KeyListOptions. */
+    template <KeyListMode... Modes>
+    void setKeyListMode(KeyListOptions<Modes...>)
+    {
+        setGpgmeKeyListMode(KeyListOptions<Modes...>::gpgmeModes);
+    }
+
+    /** Set the key list interner
+     *
+     * If an interner is set, then the strings of every key returned by
+     * nextKey() are interned. The Context does not take ownership of the
+     * interner.
+     *
+     * @see KeyListInterner
+     */
+    void setKeyListInterner(KeyListInterner *interner);
+    KeyListInterner *keyListInterner() const;
+
     /** Set the passphrase provider
      *
      * To avoid problems where a class using a context registers
@@ -139,7 +170,60 @@ public:
      * is deleted if it is no longer needed.
      */
     void setProgressProvider(ProgressProvider *provider);
+    /**
+     * Same as above, but only forwards a report to @p provider if at least
+     * @p minInterval has passed or the progress changed by at least
+     * @p minPercentChange percent since the last forwarded report. The
+     * first and the final report of an operation are always forwarded.
+     * @p provider may be null if only progressSnapshot() is used.
+     *
+     * @see ThrottledProgressProvider
+     */
+    void setProgressProvider(ProgressProvider *provider, std::chrono::milliseconds minInterval,
+                             int minPercentChange = 0);
     ProgressProvider *progressProvider() const;
+    /**
+     * Returns the latest progress report. Can be called from another thread
+     * while an operation runs. Only available if the progress provider was
+     * set with the throttling overload; otherwise an empty snapshot is
+     * returned.
+     */
+    ThrottledProgressProvider::Snapshot progressSnapshot() const;
+
+    /** Set the instrumentation
+     *
+     * The instrumentation receives the timings and counters of the
+     * operations of this context. If no instrumentation is set, then the
+     * global instrumentation is used, if any. The Context does not take
+     * ownership of the instrumentation.
+     *
+     * @see Instrumentation
+     */
+    void setInstrumentation(Instrumentation *instrumentation);
+    Instrumentation *instrumentation() const;
+    /** Sets the instrumentation used by all contexts without an own one. */
+    static void setGlobalInstrumentation(Instrumentation *instrumentation);
+    static Instrumentation *globalInstrumentation();
+
+    /** Set the tracer
+     *
+     * The tracer opens a span around every operation of this context. If
+     * no tracer is set, then the global tracer is used, if any. The Context
+     * does not take ownership of the tracer.
+     *
+     * @see Tracer, TraceScope
+     */
+    void setTracer(Tracer *tracer);
+    Tracer *tracer() const;
+    /** Sets the tracer used by all contexts without an own one and by
+     * Component::load() and Key::update(). */
+    static void setGlobalTracer(Tracer *tracer);
+    static Tracer *globalTracer();
+    /** Sets the parent of the spans of the operations of this context. If
+     * @p parent is nullptr, then the current span of the thread which
+     * starts the operation is used. */
+    void setTraceParent(TraceSpan *parent);
+    TraceSpan *traceParent() const;
 
     void setManagedByEventLoopInteractor(bool managed);
     bool managedByEventLoopInteractor() const;
@@ -164,6 +248,7 @@ private:
     friend class ::GpgME::EventLoopInteractor;
     void installIOCallbacks(gpgme_io_cbs *iocbs);
     void uninstallIOCallbacks();
+    void setGpgmeKeyListMode(unsigned int gpgmeMode);
 
 public:
     //
@@ -184,8 +269,41 @@ public:
     KeyListResult endKeyListing();
     KeyListResult keyListResult() const;
 
+    /**
+     * Returns a lazy range over the keys matching @p patterns. If @p mode
+     * is not 0, then it is used as key list mode for the listing and the
+     * previous key list mode is restored afterwards. Destroying the range
+     * before the end is reached cancels the listing.
+     */
+    KeyListRange listKeys(const std::vector<std::string> &patterns, unsigned int mode = 0, bool secretOnly = false);
+
+    /**
+     * Lists the keys matching @p patterns with up to @p shards engine
+     * processes at the same time. The patterns are split into @p shards
+     * contiguous slices, each listed with an own context of the same
+     * protocol, engine, home directory, offline mode and context flags
+     * (see setFlag()) as this context. The keys are returned in the order
+     * of the slices; a key matched by patterns of several slices is only
+     * returned once.
+     *
+     * If @p patterns is empty, i.e. all keys are listed, then a single
+     * listing is run, because the engines cannot split a keyring.
+     *
+     * This context is not used for the listing and can be used otherwise
+     * in the meantime. @p err is set to the first error of a listing.
+     */
+    std::vector<Key> listKeysParallel(const std::vector<std::string> &patterns, unsigned int mode,
+                                      unsigned int shards, bool secretOnly, GpgME::Error &err);
+
     Key key(const char *fingerprint, GpgME::Error &e, bool secret = false);
 
+    /**
+     * Looks up the keys for the given fingerprints or key IDs with a single
+     * key listing. The returned list has the same size and order as
+     * @p fingerprints; keys which were not found are null.
+     */
+    std::vector<Key> keys(const std::vector<std::string> &fingerprints, bool secret, GpgME::Error &e);
+
     //
     // Key Generation
     //
@@ -234,6 +352,29 @@ public:
     GpgME::Error startKeyExport(const char *pattern, Data &keyData, unsigned int mode = ExportDefault);
     GpgME::Error startKeyExport(const char *pattern[], Data &keyData, unsigned int mode = ExportDefault);
 
+    /**
+     * Called for every exported key with its fingerprint and its binary
+     * key data. The fingerprint is null if the key could not be matched
+     * with the listed keys, e.g. because several of them have the same
+     * creation time. Returning false cancels the export.
+     */
+    using KeyExportCallback = std::function<bool(const char *fingerprint, const char *keyData, size_t size)>;
+    /**
+     * Exports the OpenPGP keys matching @p patterns (all keys if empty) and
+     * passes them to @p callback key by key while gpg writes the export, so
+     * that the whole export never has to be kept in memory.
+     *
+     * The output is split with a KeyPacketSplitter; the keys are matched
+     * with a key listing for the same patterns by the creation time of the
+     * primary key. The armor flag is ignored.
+     *
+     * Returns GPG_ERR_NOT_SUPPORTED for CMS and for the modes ExportExtern,
+     * ExportSSH, ExportRaw and ExportPKCS12, and GPG_ERR_CANCELED if the
+     * callback cancelled the export.
+     */
+    GpgME::Error exportKeysStreaming(const std::vector<std::string> &patterns, unsigned int mode,
+                                     const KeyExportCallback &callback);
+
     //
     // Key Import
     //
@@ -241,9 +382,28 @@ public:
     ImportResult importKeys(const Data &data);
     ImportResult importKeys(const std::vector<Key> &keys);
     ImportResult importKeys(const std::vector<std::string> &keyIds);
+    /**
+     * Imports the keys with the @p count key IDs at @p keyIds from a
+     * keyserver, like importKeys(const std::vector<std::string> &), without
+     * copying the key IDs into strings first. The key IDs are copied into a
+     * single buffer for the engine.
+     */
+    ImportResult importKeys(const std::string_view *keyIds, size_t count);
     GpgME::Error startKeyImport(const Data &data);
     GpgME::Error startKeyImport(const std::vector<Key> &keys);
     GpgME::Error startKeyImport(const std::vector<std::string> &keyIds);
+    GpgME::Error startKeyImport(const std::string_view *keyIds, size_t count);
+    /**
+     * Imports the keys matching @p patterns (all keys if empty) from the
+     * keyring of @p source, e.g. a context for another home directory.
+     * @p source exports the keys with @p exportMode in a helper thread
+     * while this context imports them, so that the keys are streamed
+     * through a small buffer. Both contexts must be idle and use the same
+     * protocol; @p source must not be used by other threads during the
+     * call. An error of the export is returned as error of the result.
+     */
+    ImportResult importKeysFrom(Context &source, const std::vector<std::string> &patterns,
+                                unsigned int exportMode = 0);
     ImportResult importResult() const;
 
     //
@@ -310,6 +470,32 @@ public:
                          unsigned long expires = 0,
                          CreationFlags flags = CreateUseDefaults);
 
+    struct KeyGenRequest {
+        std::string userid;
+        std::string algo;
+        unsigned long expires = 0;
+        CreationFlags flags = CreateUseDefaults;
+    };
+
+    /*!
+     * Creates a new OpenPGP key for every request with up to \a concurrency
+     * engine processes at the same time.
+     *
+     * Every worker uses an own context with the engine, home directory and
+     * pinentry mode of this context, so the keys are created in the same
+     * keyring. The engine only holds the keyring lock while storing a key,
+     * i.e. the creation of the keys itself runs in parallel. The results
+     * are returned in the order of \a requests.
+     *
+     * The passphrase provider of this context is not used, because it may
+     * not be thread-safe. Use CreateNoPassword or the loopback pinentry
+     * mode with a preset passphrase.
+     *
+     * \sa createKey
+     */
+    std::vector<GpgME::KeyGenerationResult> createKeys(const std::vector<KeyGenRequest> &requests,
+                                                       unsigned int concurrency = 4);
+
     Error addUid(const Key &key, const char *userid);
     Error startAddUid(const Key &key, const char *userid);
 
@@ -374,11 +560,53 @@ public:
      */
     Error startSetKeyEnabled(const Key &key, bool enabled);
 
+    /**
+     * Writes the owner trust values of all keys to \a trustData in the
+     * format of gpg --export-ownertrust. The engine is spawned once with
+     * the home directory of this context.
+     */
+    Error exportOwnerTrust(Data &trustData);
+    /**
+     * Sets the owner trust values of all keys listed in \a trustData (in
+     * the format of gpg --export-ownertrust) with one engine invocation.
+     * Returns the error of the ERROR or FAILURE status line if gpg reported
+     * problems with the data.
+     */
+    Error importOwnerTrust(const Data &trustData);
+
     Error revokeSignature(const Key &key, const Key &signingKey,
                           const std::vector<UserID> &userIds = std::vector<UserID>());
     Error startRevokeSignature(const Key &key, const Key &signingKey,
                                const std::vector<UserID> &userIds = std::vector<UserID>());
 
+    enum KeySignFlags {
+        KeySignDefault = 0,
+        KeySignLocal = 1,
+        KeySignNoExpire = 2,
+        KeySignForce = 4
+    };
+
+    /**
+     * Certifies the user IDs \a userIds (all user IDs if empty) of \a key
+     * with the signing keys of this context (see addSigningKey). If
+     * \a expires is 0, then the default expiration of gpg is used.
+     * Requires gpg 2.1.12.
+     */
+    Error signKey(const Key &key, const std::vector<UserID> &userIds = std::vector<UserID>(),
+                  unsigned long expires = 0, KeySignFlags flags = KeySignDefault);
+    Error startSignKey(const Key &key, const std::vector<UserID> &userIds = std::vector<UserID>(),
+                       unsigned long expires = 0, KeySignFlags flags = KeySignDefault);
+
+    /**
+     * Certifies all user IDs of all \a keys with \a signingKey. The signing
+     * keys of this context are restored afterwards. gpg certifies one key
+     * per invocation, so one command is run per key. Returns one error per
+     * key. Use BulkKeyManager::signKeys to run the commands concurrently.
+     * Requires gpg 2.1.12.
+     */
+    std::vector<Error> signKeys(const std::vector<Key> &keys, const Key &signingKey,
+                                unsigned long expires = 0, KeySignFlags flags = KeySignDefault);
+
     Error addAdsk(const Key &k, const char *adsk);
     Error startAddAdsk(const Key &k, const char *adsk);
 
@@ -457,6 +685,25 @@ public:
 
     std::pair<DecryptionResult, VerificationResult> decryptAndVerify(const Data &cipherText, Data &plainText);
     std::pair<DecryptionResult, VerificationResult> decryptAndVerify(const Data &cipherText, Data &plainText, const DecryptionFlags flags);
+
+    /**
+     * Called with every chunk of the plain text while gpg writes it.
+     * Returning false cancels the operation.
+     */
+    using PlainTextCallback = std::function<bool(const char *data, size_t size)>;
+    /**
+     * Decrypts and verifies @p cipherText and passes the plain text to
+     * @p callback chunk by chunk while gpg decrypts it, so that the caller
+     * can start processing it before the decryption has finished.
+     *
+     * The plain text is unverified until the results are returned; the
+     * caller has to discard everything passed to the callback if the
+     * decryption or the verification failed. Results with the error
+     * GPG_ERR_CANCELED are returned if the callback cancelled.
+     */
+    std::pair<DecryptionResult, VerificationResult> decryptAndVerifyStreaming(const Data &cipherText,
+                                                                              const PlainTextCallback &callback,
+                                                                              DecryptionFlags flags = DecryptNone);
     GpgME::Error startCombinedDecryptionAndVerification(const Data &cipherText, Data &plainText);
     GpgME::Error startCombinedDecryptionAndVerification(const Data &cipherText, Data &plainText, const DecryptionFlags flags);
     // use verificationResult() and decryptionResult() to retrieve the result objects...
@@ -482,6 +729,14 @@ public:
     GpgME::Error startSigning(const Data &plainText, Data &signature, SignatureMode mode);
     SigningResult signingResult() const;
 
+    /**
+     * Signs the file @p fileName. The engine reads the file itself, so the
+     * data is not passed through a pipe; use this for large files. SignFile
+     * is added to @p mode, which usually is Detached. Only supported for
+     * OpenPGP.
+     */
+    SigningResult signFile(const std::string &fileName, Data &signature, SignatureMode mode = Detached);
+
     // wrapper for gpgme_set_sender
     const char *getSender();
     GpgME::Error setSender(const char *sender);
@@ -507,8 +762,11 @@ public:
         ChangeRecipient = 4096,
     };
     EncryptionResult encrypt(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
+    /** Same as above but for a prepared set of recipients. */
+    EncryptionResult encrypt(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
     GpgME::Error encryptSymmetrically(const Data &plainText, Data &cipherText);
     GpgME::Error startEncryption(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
+    GpgME::Error startEncryption(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
     EncryptionResult encryptionResult() const;
 
     //
@@ -516,9 +774,55 @@ public:
     //
 
     std::pair<SigningResult, EncryptionResult> signAndEncrypt(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
+    std::pair<SigningResult, EncryptionResult> signAndEncrypt(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
     GpgME::Error startCombinedSigningAndEncryption(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
+    GpgME::Error startCombinedSigningAndEncryption(const RecipientSet &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
     // use encryptionResult() and signingResult() to retrieve the result objects...
 
+    //
+    //
+    // Asynchronous Operations
+    //
+    //
+
+    /*
+     * The following functions start an operation and report its result
+     * when it is done, either to a callback or through a future. They
+     * require that the context is managed by an EventLoopInteractor, e.g.
+     * an EpollEventLoop; otherwise GPG_ERR_INV_STATE is returned. The
+     * callbacks are called by the thread running the event loop before
+     * EventLoopInteractor::operationDoneEvent, so they may start the next
+     * operation on the context. Waiting for a future in the thread running
+     * the event loop blocks forever.
+     *
+     * The data objects are kept alive until the operation is done.
+     */
+
+    using EncryptionCallback = std::function<void(const EncryptionResult &)>;
+    GpgME::Error encryptAsync(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags,
+                              const EncryptionCallback &callback);
+    std::future<EncryptionResult> encryptAsync(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags);
+
+    using DecryptionCallback = std::function<void(const DecryptionResult &)>;
+    GpgME::Error decryptAsync(const Data &cipherText, Data &plainText, DecryptionFlags flags, const DecryptionCallback &callback);
+    std::future<DecryptionResult> decryptAsync(const Data &cipherText, Data &plainText, DecryptionFlags flags = DecryptNone);
+
+    using SigningCallback = std::function<void(const SigningResult &)>;
+    GpgME::Error signAsync(const Data &plainText, Data &signature, SignatureMode mode, const SigningCallback &callback);
+    std::future<SigningResult> signAsync(const Data &plainText, Data &signature, SignatureMode mode);
+
+    using VerificationCallback = std::function<void(const VerificationResult &)>;
+    /** Verifies a detached signature. */
+    GpgME::Error verifyAsync(const Data &signature, const Data &signedText, const VerificationCallback &callback);
+    std::future<VerificationResult> verifyAsync(const Data &signature, const Data &signedText);
+    GpgME::Error verifyOpaqueAsync(const Data &signedData, Data &plainText, const VerificationCallback &callback);
+    std::future<VerificationResult> verifyOpaqueAsync(const Data &signedData, Data &plainText);
+
+    /** The keys are collected from the next key events of the event loop. */
+    using KeyListCallback = std::function<void(const KeyListResult &, const std::vector<Key> &)>;
+    GpgME::Error listKeysAsync(const std::vector<std::string> &patterns, bool secretOnly, const KeyListCallback &callback);
+    std::future<std::pair<KeyListResult, std::vector<Key>>> listKeysAsync(const std::vector<std::string> &patterns, bool secretOnly = false);
+
     //
     //
     // Audit Log
@@ -533,6 +837,21 @@ public:
     GpgME::Error startGetAuditLog(Data &output, unsigned int flags = 0);
     GpgME::Error getAuditLog(Data &output, unsigned int flags = 0);
 
+    /** Called with the chunks of the audit log. Returning false cancels. */
+    using AuditLogCallback = std::function<bool(const char *data, size_t size)>;
+    /**
+     * Passes the audit log of the last operation to @p callback in chunks
+     * of at most @p chunkSize bytes (as written by the engine if 0) instead
+     * of collecting it in a Data. Returns GPG_ERR_CANCELED if the callback
+     * cancelled.
+     *
+     * The audit log is only fetched from the engine when it is requested
+     * with getAuditLog() and is available until the next operation is
+     * started with this context, so there is no need to fetch it if it is
+     * not used.
+     */
+    GpgME::Error getAuditLog(const AuditLogCallback &callback, unsigned int flags = 0, size_t chunkSize = 0);
+
     //
     //
     // Random values
@@ -563,6 +882,15 @@ public:
      */
     RandomBytesResult generateRandomBytes(size_t count);
 
+    /*!
+     * Fills the caller's \a buffer of \a count bytes with random bytes retrieved
+     * from gpg without any allocation. \a count may be larger than \c 1024;
+     * then the buffer is filled in chunks of 1024 bytes.
+     *
+     * \sa RandomPool
+     */
+    Error generateRandomBytes(unsigned char *buffer, size_t count);
+
     /*!
      * Generate an unbiased random value in the range [0, \a limit).
      */
@@ -581,6 +909,26 @@ public:
     GpgME::Error createVFS(const char *containerFile, const std::vector<Key> &recipients);
     VfsMountResult mountVFS(const char *containerFile, const char *mountDir);
 
+    /**
+     * Run createVFS() and mountVFS() in a new thread, because gpgme has no
+     * asynchronous interface for g13. The context must not be used until
+     * the future is ready.
+     */
+    std::future<GpgME::Error> createVFSAsync(const std::string &containerFile, const std::vector<Key> &recipients);
+    std::future<VfsMountResult> mountVFSAsync(const std::string &containerFile, const std::string &mountDir);
+
+    struct VFSCreateRequest {
+        std::string containerFile;
+        std::vector<Key> recipients;
+    };
+    /**
+     * Creates the containers of @p requests with up to @p concurrency g13
+     * processes at the same time. Every worker uses an own context with the
+     * engine and the home directory of this context. The errors are
+     * returned in the order of @p requests.
+     */
+    std::vector<GpgME::Error> createVFSs(const std::vector<VFSCreateRequest> &requests, unsigned int concurrency = 4);
+
     // Spawn Engine
     enum SpawnFlags {
         SpawnNone = 0,
@@ -610,6 +958,22 @@ public:
     GpgME::Error spawnAsync(const char *file, const char *argv[],
                             Data &input, Data &output,
                             Data &err, SpawnFlags flags);
+
+    /**
+     * Spawns the process \a file with arguments \a argv like spawn(), but
+     * connects stdin, stdout and stderr of the process directly to the file
+     * descriptors \a input, \a output and \a err, e.g. to files, pipes or
+     * sockets, instead of passing the data through gpgme. A descriptor of
+     * -1 means /dev/null. The descriptors stay owned by the caller.
+     *
+     * Unless SpawnDetached is set, waits for the process to exit and sets
+     * \a exitStatus to its exit status (-1 if it was killed by a signal).
+     * The process inherits all descriptors which are not close-on-exec.
+     * Not supported on Windows.
+     */
+    GpgME::Error spawn(const char *file, const char *argv[],
+                       int input, int output, int err,
+                       SpawnFlags flags, int *exitStatus = nullptr);
     //
     //
     // Run Control
@@ -618,6 +982,26 @@ public:
 
     bool poll();
     GpgME::Error wait();
+    /**
+     * Like wait(), but cancels the operation if it does not finish within
+     * @p timeout. An operation canceled because of a timeout fails with
+     * GPG_ERR_TIMEOUT instead of GPG_ERR_CANCELED.
+     */
+    GpgME::Error wait(std::chrono::milliseconds timeout);
+
+    /**
+     * Sets the maximum duration of the operations of this context. An
+     * operation which has not finished when the timeout expires is canceled
+     * with cancelPendingOperation() by a watchdog thread and fails with
+     * GPG_ERR_TIMEOUT. A timeout of 0, the default, disables this.
+     *
+     * The timeout applies to the operations which report to an
+     * Instrumentation, synchronous or not, and to every wait(). Whether a
+     * canceled operation returns immediately depends on the engine; e.g. a
+     * pinentry is only closed once the engine notices the cancellation.
+     */
+    void setOperationTimeout(std::chrono::milliseconds timeout);
+    std::chrono::milliseconds operationTimeout() const;
     GpgME::Error lastError() const;
     GpgME::Error cancelPendingOperation();
     GpgME::Error cancelPendingOperationImmediately();
@@ -663,11 +1047,6 @@ public:
     GPGMEPP_DEPRECATED GpgME::Error deleteKey(const Key &key, bool allowSecretKeyDeletion = false);
     GPGMEPP_DEPRECATED GpgME::Error startKeyDeletion(const Key &key, bool allowSecretKeyDeletion = false);
 
-private:
-    // Helper functions that need to be context because they rely
-    // on the "Friendlyness" of context to access the gpgme types.
-    gpgme_key_t *getKeysFromRecipients(const std::vector<Key> &recipients);
-
 private:
     Private *const d;
 
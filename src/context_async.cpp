@@ -0,0 +1,208 @@
+/*
+  context_async.cpp - asynchronous operations with completion callbacks and futures
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <context.h>
+#include <decryptionresult.h>
+#include <encryptionresult.h>
+#include <keylistresult.h>
+#include <signingresult.h>
+#include <verificationresult.h>
+
+#include "context_p.h"
+#include "util.h"
+
+#include <gpgme.h>
+
+using namespace GpgME;
+
+namespace
+{
+// returns a future which is fulfilled by the callback passed to start, or
+// with the error returned by start
+template <typename Result, typename Start>
+std::future<Result> makeFuture(Start start)
+{
+    const auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    const Error err = start([promise](const Result &result) {
+        promise->set_value(result);
+    });
+    if (err) {
+        promise->set_value(Result(err));
+    }
+    return future;
+}
+}
+
+Error Context::Private::startAsync(const std::function<Error()> &start, std::function<void()> &&done)
+{
+    if (!iocbs) {
+        return Error::fromCode(GPG_ERR_INV_STATE);
+    }
+    const Error err = start();
+    if (!err) {
+        completion = std::move(done);
+    }
+    return err;
+}
+
+Error Context::encryptAsync(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags,
+                            const EncryptionCallback &callback)
+{
+    return d->startAsync([&]() {
+            return startEncryption(recipients, plainText, cipherText, flags);
+        },
+        [this, plainText, cipherText, callback]() {
+            if (callback) {
+                callback(encryptionResult());
+            }
+        });
+}
+
+std::future<EncryptionResult> Context::encryptAsync(const std::vector<Key> &recipients, const Data &plainText, Data &cipherText, EncryptionFlags flags)
+{
+    return makeFuture<EncryptionResult>([&](const EncryptionCallback &callback) {
+        return encryptAsync(recipients, plainText, cipherText, flags, callback);
+    });
+}
+
+Error Context::decryptAsync(const Data &cipherText, Data &plainText, DecryptionFlags flags, const DecryptionCallback &callback)
+{
+    return d->startAsync([&]() {
+            return startDecryption(cipherText, plainText, flags);
+        },
+        [this, cipherText, plainText, callback]() {
+            if (callback) {
+                callback(decryptionResult());
+            }
+        });
+}
+
+std::future<DecryptionResult> Context::decryptAsync(const Data &cipherText, Data &plainText, DecryptionFlags flags)
+{
+    return makeFuture<DecryptionResult>([&](const DecryptionCallback &callback) {
+        return decryptAsync(cipherText, plainText, flags, callback);
+    });
+}
+
+Error Context::signAsync(const Data &plainText, Data &signature, SignatureMode mode, const SigningCallback &callback)
+{
+    return d->startAsync([&]() {
+            return startSigning(plainText, signature, mode);
+        },
+        [this, plainText, signature, callback]() {
+            if (callback) {
+                callback(signingResult());
+            }
+        });
+}
+
+std::future<SigningResult> Context::signAsync(const Data &plainText, Data &signature, SignatureMode mode)
+{
+    return makeFuture<SigningResult>([&](const SigningCallback &callback) {
+        return signAsync(plainText, signature, mode, callback);
+    });
+}
+
+Error Context::verifyAsync(const Data &signature, const Data &signedText, const VerificationCallback &callback)
+{
+    return d->startAsync([&]() {
+            return startDetachedSignatureVerification(signature, signedText);
+        },
+        [this, signature, signedText, callback]() {
+            if (callback) {
+                callback(verificationResult());
+            }
+        });
+}
+
+std::future<VerificationResult> Context::verifyAsync(const Data &signature, const Data &signedText)
+{
+    return makeFuture<VerificationResult>([&](const VerificationCallback &callback) {
+        return verifyAsync(signature, signedText, callback);
+    });
+}
+
+Error Context::verifyOpaqueAsync(const Data &signedData, Data &plainText, const VerificationCallback &callback)
+{
+    return d->startAsync([&]() {
+            return startOpaqueSignatureVerification(signedData, plainText);
+        },
+        [this, signedData, plainText, callback]() {
+            if (callback) {
+                callback(verificationResult());
+            }
+        });
+}
+
+std::future<VerificationResult> Context::verifyOpaqueAsync(const Data &signedData, Data &plainText)
+{
+    return makeFuture<VerificationResult>([&](const VerificationCallback &callback) {
+        return verifyOpaqueAsync(signedData, plainText, callback);
+    });
+}
+
+Error Context::listKeysAsync(const std::vector<std::string> &patterns, bool secretOnly, const KeyListCallback &callback)
+{
+    const Error err = d->startAsync([&]() {
+            d->listedKeys.reset(new std::vector<Key>);
+            const StringsToCStrings cpatterns{patterns};
+            return patterns.empty() ? startKeyListing(static_cast<const char *>(nullptr), secretOnly)
+                                    : startKeyListing(cpatterns.c_strs(), secretOnly);
+        },
+        [this, callback]() {
+            // the last error is the one of the done event; keylist_end
+            // only releases the queued keys
+            const KeyListResult result = keyListResult();
+            std::vector<Key> keys;
+            if (d->listedKeys) {
+                keys.swap(*d->listedKeys);
+                d->listedKeys.reset();
+            }
+            gpgme_op_keylist_end(d->ctx);
+            if (callback) {
+                callback(result, keys);
+            }
+        });
+    if (err) {
+        d->listedKeys.reset();
+    }
+    return err;
+}
+
+std::future<std::pair<KeyListResult, std::vector<Key>>> Context::listKeysAsync(const std::vector<std::string> &patterns, bool secretOnly)
+{
+    using Listing = std::pair<KeyListResult, std::vector<Key>>;
+    const auto promise = std::make_shared<std::promise<Listing>>();
+    std::future<Listing> future = promise->get_future();
+    const Error err = listKeysAsync(patterns, secretOnly, [promise](const KeyListResult &result, const std::vector<Key> &keys) {
+        promise->set_value(Listing(result, keys));
+    });
+    if (err) {
+        promise->set_value(Listing(KeyListResult(err), std::vector<Key>()));
+    }
+    return future;
+}
@@ -28,9 +28,13 @@
 
 #include <context.h>
 #include <data.h>
+#include <interfaces/instrumentation.h>
 
 #include <gpgme.h>
 
+#include <atomic>
+#include <chrono>
+
 namespace GpgME
 {
 
@@ -64,15 +68,153 @@ public:
         AssuanTransact = 0x2000,
         Passwd    = 0x4000, // no gpgme_passwd_result_t, but nevertheless...
 
-        CreateVFS = 0x4000,
-        MountVFS = 0x8000,
+        CreateVFS = 0x10000,
+        MountVFS = 0x20000,
 
         EndMarker
     };
 
+    // NULL-terminated array of the gpgme keys of recipients; uses inline
+    // storage for the common case of a few recipients
+    class RecipientArray
+    {
+    public:
+        explicit RecipientArray(const std::vector<Key> &recipients);
+        RecipientArray(const RecipientArray &) = delete;
+        RecipientArray &operator=(const RecipientArray &) = delete;
+
+        // returns nullptr if there are no recipients
+        gpgme_key_t *keys()
+        {
+            return mKeys;
+        }
+
+    private:
+        static constexpr size_t InlineSize = 8;
+        gpgme_key_t mInline[InlineSize + 1];
+        std::vector<gpgme_key_t> mHeap;
+        gpgme_key_t *mKeys;
+    };
+
     Private(gpgme_ctx_t c = nullptr);
     ~Private();
 
+    // resets the state of the last operation, but keeps the configuration
+    void resetOperationState();
+    // configures helper, a context of the same protocol, like this one:
+    // the engine, the offline and pinentry modes, the sender, the context
+    // flags and the instrumentation
+    void copySettingsTo(Context &helper) const;
+
+    // called before an operation which may modify the keyring is started;
+    // caches compare the generation to find out whether they are stale
+    static void notifyKeyringChange();
+    static unsigned int keyringGeneration();
+    // notifies the change now and again when the operation is done, so
+    // that keys cached while the operation runs become stale, too
+    void keyringChangeStarted()
+    {
+        notifyKeyringChange();
+        changesKeyring = true;
+    }
+
+    // returns the NULL-terminated array of the gpgme keys of the recipients
+    static std::vector<gpgme_key_t> recipientKeys(const std::vector<Key> &recipients);
+
+    // runs the quick command equivalent to the edit interactor func if the
+    // engine supports it; returns false if the interactor has to be used
+    bool quickEdit(Context *q, const Key &key, EditInteractor *func, bool async, Error &err);
+    // reports the error of the quick command through the interactor
+    void quickEditStarted(EditInteractor *func, bool async, const Error &err);
+    void quickEditDone(gpgme_error_t err);
+
+    // starts an asynchronous operation with start and, if that succeeds,
+    // installs done as completion of the operation
+    Error startAsync(const std::function<Error()> &start, std::function<void()> &&done);
+
+    // the state of an operation which is reported to an instrumentation
+    struct InstrumentedOperation;
+
+    // sets lastop and, if an instrumentation or a tracer is registered,
+    // starts measuring the operation; in and out are the data read and
+    // written by it, keys the number of recipients or keys
+    void startOperation(Operation op, const Data *in = nullptr, const Data *out = nullptr, size_t keys = 0);
+    // reports the measured operation to the instrumentation and ends its span
+    void finishOperation();
+    // same as above, but also measures the creation of the result
+    template <typename F>
+    auto finishOperation(F makeResult) -> decltype(makeResult())
+    {
+        lasterr = operationDone(lasterr);
+        if (!instrumented) {
+            return makeResult();
+        }
+        const auto start = Instrumentation::Clock::now();
+        auto result = makeResult();
+        addResultCopyTime(Instrumentation::Clock::now() - start);
+        finishOperation();
+        return result;
+    }
+    // arms the watchdog which cancels the operation at deadline; an
+    // already armed earlier deadline is kept unless replace is set
+    void armTimeout(std::chrono::steady_clock::time_point deadline, bool replace);
+    // disarms the watchdog; returns GPG_ERR_TIMEOUT instead of err if the
+    // watchdog canceled the operation
+    gpgme_error_t operationDone(gpgme_error_t err)
+    {
+        if (timeoutArmed) {
+            disarmTimeout();
+        }
+        if (changesKeyring) {
+            changesKeyring = false;
+            notifyKeyringChange();
+        }
+        if (timedOut.exchange(false) && gpgme_err_code(err) == GPG_ERR_CANCELED) {
+            return gpgme_err_make(gpgme_err_source(err), GPG_ERR_TIMEOUT);
+        }
+        return err;
+    }
+    void disarmTimeout();
+
+    // sets the error of a started operation; finishes it if it failed
+    Error started(gpgme_error_t err)
+    {
+        if (err) {
+            err = operationDone(err);
+        }
+        lasterr = err;
+        if (err && instrumented) {
+            finishOperation();
+        }
+        return Error(err);
+    }
+    // sets the error of a finished operation
+    Error finished(gpgme_error_t err)
+    {
+        err = operationDone(err);
+        lasterr = err;
+        if (quickEditing) {
+            quickEditDone(err);
+        }
+        if (instrumented) {
+            finishOperation();
+        }
+        return Error(err);
+    }
+    // measure the time spent waiting for the engine
+    Instrumentation::Clock::time_point engineWaitStarted() const
+    {
+        return instrumented ? Instrumentation::Clock::now() : Instrumentation::Clock::time_point();
+    }
+    void engineWaitFinished(Instrumentation::Clock::time_point start)
+    {
+        if (instrumented) {
+            addEngineWaitTime(Instrumentation::Clock::now() - start);
+        }
+    }
+    void addEngineWaitTime(Instrumentation::Clock::duration duration);
+    void addResultCopyTime(Instrumentation::Clock::duration duration);
+
     gpgme_ctx_t ctx;
     gpgme_io_cbs *iocbs;
     Operation lastop;
@@ -81,6 +223,29 @@ public:
     std::unique_ptr<AssuanTransaction> lastAssuanTransaction;
     std::unique_ptr<EditInteractor> lastEditInteractor, lastCardEditInteractor;
     DecryptionFlags decryptFlags;
+    // called by the event loop when the asynchronous operation is done
+    std::function<void()> completion;
+    // collects the keys of listKeysAsync()
+    std::unique_ptr<std::vector<Key>> listedKeys;
+    // the throttle installed by setProgressProvider(provider, interval)
+    std::unique_ptr<ThrottledProgressProvider> progressThrottle;
+    // the context owning this object
+    const Context *q;
+    Instrumentation *instrumentation;
+    KeyListInterner *interner;
+    Tracer *tracer;
+    TraceSpan *traceParent;
+    // the operation currently measured; null if no instrumentation is used
+    std::unique_ptr<InstrumentedOperation> instrumented;
+    std::chrono::milliseconds operationTimeout;
+    // only accessed by the thread running the operation
+    bool timeoutArmed;
+    // set by the watchdog when it cancels the operation
+    std::atomic<bool> timedOut;
+    // set while an operation which may modify the keyring runs
+    bool changesKeyring;
+    // set while an edit replaced by a quick command runs asynchronously
+    bool quickEditing;
 };
 
 } // namespace GpgME
@@ -0,0 +1,219 @@
+/*
+  contextpool.cpp - a pool of reusable contexts
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <contextpool.h>
+#include <context.h>
+
+#include "context_p.h"
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+using namespace GpgME;
+
+class ContextPool::Private
+{
+public:
+    Private(Protocol proto, const Configurator &configure)
+        : protocol(proto),
+          configure(configure),
+          maxIdle(0)
+    {
+    }
+
+    std::unique_ptr<Context> create(Error *err)
+    {
+        std::unique_ptr<Context> ctx = Context::create(protocol);
+        if (!ctx) {
+            if (err) {
+                *err = Error::fromCode(GPG_ERR_INV_ENGINE);
+            }
+            return ctx;
+        }
+        if (configure) {
+            configure(*ctx);
+        }
+        if (err) {
+            *err = Error();
+        }
+        return ctx;
+    }
+
+    void giveBack(std::unique_ptr<Context> &&ctx)
+    {
+        ctx->impl()->resetOperationState();
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (maxIdle == 0 || idle.size() < maxIdle) {
+            idle.push_back(std::move(ctx));
+        }
+        // otherwise the lease destroys the context outside of the lock
+    }
+
+    const Protocol protocol;
+    const Configurator configure;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Context>> idle;
+    unsigned int maxIdle;
+};
+
+//
+//
+// ContextPool::Lease
+//
+//
+
+ContextPool::Lease::Lease() = default;
+
+ContextPool::Lease::Lease(const std::shared_ptr<ContextPool::Private> &pool, std::unique_ptr<Context> &&ctx)
+    : mPool(pool),
+      mContext(std::move(ctx))
+{
+}
+
+ContextPool::Lease::Lease(Lease &&other) noexcept = default;
+
+ContextPool::Lease &ContextPool::Lease::operator=(Lease &&other) noexcept
+{
+    if (this != &other) {
+        release();
+        mPool = std::move(other.mPool);
+        mContext = std::move(other.mContext);
+    }
+    return *this;
+}
+
+ContextPool::Lease::~Lease()
+{
+    release();
+}
+
+void ContextPool::Lease::release()
+{
+    if (mContext && mPool) {
+        mPool->giveBack(std::move(mContext));
+    }
+    mContext.reset();
+    mPool.reset();
+}
+
+//
+//
+// ContextPool
+//
+//
+
+ContextPool::ContextPool(Protocol proto, const Configurator &configure)
+    : d(new Private(proto, configure))
+{
+}
+
+ContextPool::~ContextPool() = default;
+
+Protocol ContextPool::protocol() const
+{
+    return d->protocol;
+}
+
+ContextPool::Lease ContextPool::acquire(Error *err)
+{
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        if (!d->idle.empty()) {
+            std::unique_ptr<Context> ctx = std::move(d->idle.back());
+            d->idle.pop_back();
+            if (err) {
+                *err = Error();
+            }
+            return Lease(d, std::move(ctx));
+        }
+    }
+    // create the context outside of the lock; this is the expensive part
+    std::unique_ptr<Context> ctx = d->create(err);
+    if (!ctx) {
+        return Lease();
+    }
+    return Lease(d, std::move(ctx));
+}
+
+Error ContextPool::prewarm(unsigned int count)
+{
+    while (true) {
+        {
+            const std::lock_guard<std::mutex> lock(d->mutex);
+            const unsigned int target = d->maxIdle ? std::min(count, d->maxIdle) : count;
+            if (d->idle.size() >= target) {
+                return Error();
+            }
+        }
+        Error err;
+        std::unique_ptr<Context> ctx = d->create(&err);
+        if (!ctx) {
+            return err;
+        }
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        if (d->maxIdle != 0 && d->idle.size() >= d->maxIdle) {
+            // filled by returned leases in the meantime
+            return Error();
+        }
+        d->idle.push_back(std::move(ctx));
+    }
+}
+
+void ContextPool::setMaximumIdleCount(unsigned int count)
+{
+    std::vector<std::unique_ptr<Context>> surplus;
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        d->maxIdle = count;
+        if (count != 0 && d->idle.size() > count) {
+            std::move(d->idle.begin() + count, d->idle.end(), std::back_inserter(surplus));
+            d->idle.resize(count);
+        }
+    }
+    // surplus contexts are released outside of the lock
+}
+
+unsigned int ContextPool::maximumIdleCount() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->maxIdle;
+}
+
+unsigned int ContextPool::idleCount() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->idle.size();
+}
+
+void ContextPool::clear()
+{
+    std::vector<std::unique_ptr<Context>> contexts;
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        contexts.swap(d->idle);
+    }
+}
@@ -0,0 +1,139 @@
+/*
+  contextpool.h - a pool of reusable contexts
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_CONTEXTPOOL_H__
+#define __GPGMEPP_CONTEXTPOOL_H__
+
+#include "global.h"
+#include "error.h"
+
+#include <functional>
+#include <memory>
+
+namespace GpgME
+{
+
+class Context;
+
+/**
+ * A thread-safe pool of contexts for one protocol.
+ *
+ * Creating a Context involves gpgme_new, the protocol selection and
+ * the setup of all flags. For many short operations it is cheaper to
+ * keep the configured contexts around and to hand them out again.
+ *
+ * acquire() returns a Lease which gives exclusive access to one context.
+ * When the lease is destroyed the context is returned to the pool. All
+ * attributes of the context (armor, text mode, pinentry mode, key list
+ * mode, sender, signing keys, providers, ...) are kept. Only the state
+ * of the last operation (last operation, last error, last edit interactor
+ * and last assuan transaction) is reset.
+ *
+ * A lease must not be returned while an operation started on its context
+ * is still pending.
+ */
+class GPGMEPP_EXPORT ContextPool
+{
+    class Private;
+public:
+    /** Called once for every newly created context of the pool. */
+    using Configurator = std::function<void(Context &)>;
+
+    class GPGMEPP_EXPORT Lease
+    {
+    public:
+        Lease();
+        Lease(Lease &&other) noexcept;
+        Lease &operator=(Lease &&other) noexcept;
+        ~Lease();
+
+        /** Returns the context to the pool. Afterwards the lease is null. */
+        void release();
+
+        Context *context() const
+        {
+            return mContext.get();
+        }
+        Context *operator->() const
+        {
+            return mContext.get();
+        }
+        Context &operator*() const
+        {
+            return *mContext;
+        }
+
+        bool isNull() const
+        {
+            return !mContext;
+        }
+        explicit operator bool() const
+        {
+            return !isNull();
+        }
+
+    private:
+        friend class ::GpgME::ContextPool;
+        Lease(const std::shared_ptr<ContextPool::Private> &pool, std::unique_ptr<Context> &&ctx);
+
+        std::shared_ptr<ContextPool::Private> mPool;
+        std::unique_ptr<Context> mContext;
+    };
+
+    explicit ContextPool(Protocol proto, const Configurator &configure = Configurator());
+    ~ContextPool();
+
+    Protocol protocol() const;
+
+    /**
+     * Returns a lease for an idle context or for a newly created one if
+     * no context is idle. Returns a null lease and sets @p err if a new
+     * context could not be created.
+     */
+    Lease acquire(Error *err = nullptr);
+
+    /** Creates contexts until at least @p count contexts are idle, but
+     * not more than maximumIdleCount() if a maximum is set. */
+    Error prewarm(unsigned int count);
+
+    /**
+     * Sets the maximum number of idle contexts kept by the pool. Contexts
+     * returned to a full pool are destroyed. 0 (the default) means no limit.
+     */
+    void setMaximumIdleCount(unsigned int count);
+    unsigned int maximumIdleCount() const;
+
+    unsigned int idleCount() const;
+
+    /** Destroys all idle contexts. */
+    void clear();
+
+private:
+    ContextPool(const ContextPool &) = delete;
+    ContextPool &operator=(const ContextPool &) = delete;
+
+    std::shared_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_CONTEXTPOOL_H__
@@ -28,9 +28,21 @@
 #include "context_p.h"
 #include <error.h>
 #include <interfaces/dataprovider.h>
+#include <securearena.h>
 
 #include <gpgme.h>
 
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifndef NDEBUG
 #include <iostream>
 #endif
@@ -40,6 +52,55 @@ GpgME::Data::Private::~Private()
     if (data) {
         gpgme_data_release(data);
     }
+    delete ioStats.load();
+}
+
+void GpgME::Data::Private::IoCounters::countRead(gpgme_ssize_t n, std::chrono::steady_clock::duration time)
+{
+    reads.fetch_add(1, std::memory_order_relaxed);
+    if (n > 0) {
+        bytesRead.fetch_add(n, std::memory_order_relaxed);
+    }
+    readTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(), std::memory_order_relaxed);
+}
+
+void GpgME::Data::Private::IoCounters::countWrite(gpgme_ssize_t n, std::chrono::steady_clock::duration time)
+{
+    writes.fetch_add(1, std::memory_order_relaxed);
+    if (n > 0) {
+        bytesWritten.fetch_add(n, std::memory_order_relaxed);
+    }
+    writeTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(), std::memory_order_relaxed);
+}
+
+void GpgME::Data::Private::IoCounters::countSeek(std::chrono::steady_clock::duration time)
+{
+    seeks.fetch_add(1, std::memory_order_relaxed);
+    seekTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(), std::memory_order_relaxed);
+}
+
+void GpgME::Data::Private::IoCounters::reset()
+{
+    for (auto *counter : {&reads, &writes, &seeks, &bytesRead, &bytesWritten}) {
+        counter->store(0, std::memory_order_relaxed);
+    }
+    for (auto *time : {&readTime, &writeTime, &seekTime}) {
+        time->store(0, std::memory_order_relaxed);
+    }
+}
+
+GpgME::Data::IoStats::Counters GpgME::Data::Private::IoCounters::get() const
+{
+    IoStats::Counters c;
+    c.reads = reads.load(std::memory_order_relaxed);
+    c.writes = writes.load(std::memory_order_relaxed);
+    c.seeks = seeks.load(std::memory_order_relaxed);
+    c.bytesRead = bytesRead.load(std::memory_order_relaxed);
+    c.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    c.readTime = std::chrono::nanoseconds(readTime.load(std::memory_order_relaxed));
+    c.writeTime = std::chrono::nanoseconds(writeTime.load(std::memory_order_relaxed));
+    c.seekTime = std::chrono::nanoseconds(seekTime.load(std::memory_order_relaxed));
+    return c;
 }
 
 const GpgME::Data::Null GpgME::Data::null;
@@ -73,6 +134,382 @@ GpgME::Data::Data(const char *buffer, size_t size, bool copy)
     d.reset(new Private(e ? nullptr : data));
 }
 
+GpgME::Data GpgME::Data::fromView(const char *buffer, size_t size, const std::shared_ptr<void> &owner)
+{
+    Data result(buffer, size, false);
+    if (!result.isNull()) {
+        result.d->owner = owner;
+    }
+    return result;
+}
+
+#ifndef _WIN32
+namespace
+{
+// serves reads directly from a read-only memory mapping of a file region
+class MappedFileDataProvider : public GpgME::DataProvider
+{
+public:
+    MappedFileDataProvider(void *map, size_t mapLength, size_t skip)
+        : mMap(map),
+          mMapLength(mapLength),
+          mBegin(static_cast<const char *>(map) + skip),
+          mSize(mapLength - skip),
+          mPos(0)
+    {
+    }
+    ~MappedFileDataProvider() override
+    {
+        munmap(mMap, mMapLength);
+    }
+
+    bool isSupported(Operation op) const override
+    {
+        return op == Read || op == Seek;
+    }
+
+    ssize_t read(void *buffer, size_t bufSize) override
+    {
+        const size_t n = std::min(bufSize, mSize - mPos);
+        std::memcpy(buffer, mBegin + mPos, n);
+        mPos += n;
+        return n;
+    }
+
+    ssize_t write(const void *, size_t) override
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    off_t seek(off_t offset, int whence) override
+    {
+        off_t base;
+        switch (whence) {
+        case SEEK_SET: base = 0; break;
+        case SEEK_CUR: base = mPos; break;
+        case SEEK_END: base = mSize; break;
+        default:
+            errno = EINVAL;
+            return -1;
+        }
+        if (offset < -base || offset > off_t(mSize) - base) {
+            errno = EINVAL;
+            return -1;
+        }
+        mPos = base + offset;
+        return mPos;
+    }
+
+    void release() override
+    {
+    }
+
+private:
+    void *const mMap;
+    const size_t mMapLength;
+    const char *const mBegin;
+    const size_t mSize;
+    size_t mPos;
+};
+}
+#endif
+
+GpgME::Data GpgME::Data::mapFile(const char *path, gpgme_off_t offset, size_t length, Error *err)
+{
+#ifdef _WIN32
+    (void)path;
+    (void)offset;
+    (void)length;
+    if (err) {
+        *err = Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+    }
+    return Data(null);
+#else
+    if (!path || offset < 0) {
+        if (err) {
+            *err = Error::fromCode(GPG_ERR_INV_VALUE);
+        }
+        return Data(null);
+    }
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        if (err) {
+            *err = Error::fromSystemError();
+        }
+        return Data(null);
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        if (err) {
+            *err = Error::fromSystemError();
+        }
+        ::close(fd);
+        return Data(null);
+    }
+    if (offset > st.st_size) {
+        offset = st.st_size;
+    }
+    const size_t available = st.st_size - offset;
+    if (length == 0 || length > available) {
+        length = available;
+    }
+    if (length == 0) {
+        // an empty region cannot be mapped
+        ::close(fd);
+        if (err) {
+            *err = Error();
+        }
+        return Data();
+    }
+    // the offset of a mapping has to be a multiple of the page size
+    const off_t pageSize = sysconf(_SC_PAGESIZE);
+    const off_t mapOffset = offset - offset % pageSize;
+    const size_t skip = offset - mapOffset;
+    void *map = mmap(nullptr, length + skip, PROT_READ, MAP_PRIVATE, fd, mapOffset);
+    const int mapErrno = errno;
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        if (err) {
+            *err = Error::fromErrno(mapErrno);
+        }
+        return Data(null);
+    }
+    // Ignore errors as this is only a hint
+    madvise(map, length + skip, MADV_SEQUENTIAL);
+
+    auto provider = std::make_shared<MappedFileDataProvider>(map, length + skip, skip);
+    Data result(provider.get());
+    if (result.isNull()) {
+        if (err) {
+            *err = Error::fromCode(GPG_ERR_ENOMEM);
+        }
+        return Data(null);
+    }
+    result.d->owner = provider;
+    if (err) {
+        *err = Error();
+    }
+    return result;
+#endif
+}
+
+namespace
+{
+#ifdef _WIN32
+using ssize_type = gpgme_ssize_t;
+using off_type = gpgme_off_t;
+#else
+using ssize_type = ssize_t;
+using off_type = off_t;
+#endif
+
+// a growing memory buffer allocated from the secure arena
+class SecureBufferDataProvider : public GpgME::DataProvider
+{
+public:
+    explicit SecureBufferDataProvider(size_t reserve)
+        : mBuffer(nullptr),
+          mCapacity(0),
+          mSize(0),
+          mPos(0)
+    {
+        if (reserve) {
+            grow(reserve);
+        }
+    }
+    ~SecureBufferDataProvider() override
+    {
+        GpgME::SecureArena::instance().deallocate(mBuffer);
+    }
+
+    bool isSupported(Operation) const override
+    {
+        return true;
+    }
+
+    ssize_type read(void *buffer, size_t bufSize) override
+    {
+        const size_t n = std::min(bufSize, mSize - mPos);
+        std::memcpy(buffer, mBuffer + mPos, n);
+        mPos += n;
+        return n;
+    }
+
+    ssize_type write(const void *buffer, size_t bufSize) override
+    {
+        if (mPos + bufSize > mCapacity && !grow(mPos + bufSize)) {
+            errno = ENOMEM;
+            return -1;
+        }
+        std::memcpy(mBuffer + mPos, buffer, bufSize);
+        mPos += bufSize;
+        mSize = std::max(mSize, mPos);
+        return bufSize;
+    }
+
+    off_type seek(off_type offset, int whence) override
+    {
+        off_type base;
+        switch (whence) {
+        case SEEK_SET: base = 0; break;
+        case SEEK_CUR: base = mPos; break;
+        case SEEK_END: base = mSize; break;
+        default:
+            errno = EINVAL;
+            return -1;
+        }
+        if (offset < -base || offset > off_type(mSize) - base) {
+            errno = EINVAL;
+            return -1;
+        }
+        mPos = base + offset;
+        return mPos;
+    }
+
+    void release() override
+    {
+    }
+
+private:
+    bool grow(size_t needed)
+    {
+        GpgME::SecureArena &arena = GpgME::SecureArena::instance();
+        char *const buffer = static_cast<char *>(arena.allocate(std::max(needed, 2 * mCapacity)));
+        if (!buffer) {
+            return false;
+        }
+        if (mBuffer) {
+            std::memcpy(buffer, mBuffer, mSize);
+            // wipes the old copy
+            arena.deallocate(mBuffer);
+        }
+        mBuffer = buffer;
+        mCapacity = arena.blockSize(buffer);
+        return true;
+    }
+
+    char *mBuffer;
+    size_t mCapacity;
+    size_t mSize;
+    size_t mPos;
+};
+}
+
+namespace
+{
+// appends the written data to a caller-owned container; reads and seeks
+// are limited to the appended part
+template <typename Container>
+class ContainerSinkDataProvider : public GpgME::DataProvider
+{
+public:
+    explicit ContainerSinkDataProvider(Container &container)
+        : mContainer(container),
+          mBase(container.size()),
+          mPos(0)
+    {
+    }
+
+    bool isSupported(Operation) const override
+    {
+        return true;
+    }
+
+    ssize_type read(void *buffer, size_t bufSize) override
+    {
+        const size_t size = mContainer.size() - mBase;
+        const size_t n = mPos < size ? std::min(bufSize, size - mPos) : 0;
+        std::memcpy(buffer, mContainer.data() + mBase + mPos, n);
+        mPos += n;
+        return n;
+    }
+
+    ssize_type write(const void *buffer, size_t bufSize) override
+    {
+        const char *const p = static_cast<const char *>(buffer);
+        try {
+            const size_t size = mContainer.size() - mBase;
+            if (mPos == size) {
+                mContainer.insert(mContainer.end(), p, p + bufSize);
+            } else {
+                if (mPos + bufSize > size) {
+                    mContainer.resize(mBase + mPos + bufSize);
+                }
+                std::memcpy(&mContainer[mBase + mPos], p, bufSize);
+            }
+        } catch (const std::bad_alloc &) {
+            errno = ENOMEM;
+            return -1;
+        }
+        mPos += bufSize;
+        return bufSize;
+    }
+
+    off_type seek(off_type offset, int whence) override
+    {
+        const off_type size = mContainer.size() - mBase;
+        off_type base;
+        switch (whence) {
+        case SEEK_SET: base = 0; break;
+        case SEEK_CUR: base = mPos; break;
+        case SEEK_END: base = size; break;
+        default:
+            errno = EINVAL;
+            return -1;
+        }
+        if (offset < -base || offset > size - base) {
+            errno = EINVAL;
+            return -1;
+        }
+        mPos = base + offset;
+        return mPos;
+    }
+
+    void release() override
+    {
+    }
+
+private:
+    Container &mContainer;
+    const size_t mBase;
+    size_t mPos;
+};
+
+template <typename Container>
+GpgME::Data container_sink(Container &container)
+{
+    auto provider = std::make_shared<ContainerSinkDataProvider<Container>>(container);
+    GpgME::Data result(provider.get());
+    if (result.isNull()) {
+        return GpgME::Data(GpgME::Data::null);
+    }
+    result.impl()->owner = provider;
+    return result;
+}
+}
+
+GpgME::Data GpgME::Data::intoBuffer(std::vector<char> &buffer)
+{
+    return container_sink(buffer);
+}
+
+GpgME::Data GpgME::Data::intoString(std::string &string)
+{
+    return container_sink(string);
+}
+
+GpgME::Data GpgME::Data::secureBuffer(size_t reserve)
+{
+    auto provider = std::make_shared<SecureBufferDataProvider>(reserve);
+    Data result(provider.get());
+    if (result.isNull()) {
+        return Data(null);
+    }
+    result.d->owner = provider;
+    return result;
+}
+
 GpgME::Data::Data(const char *filename)
 {
     gpgme_data_t data;
@@ -129,7 +566,8 @@ GpgME::Data::Data(DataProvider *dp)
     if (!dp->isSupported(DataProvider::Release)) {
         d->cbs.release = nullptr;
     }
-    const gpgme_error_t e = gpgme_data_new_from_cbs(&d->data, &d->cbs, dp);
+    d->provider = dp;
+    const gpgme_error_t e = gpgme_data_new_from_cbs(&d->data, &d->cbs, d.get());
     if (e) {
         d->data = nullptr;
     }
@@ -185,26 +623,54 @@ GpgME::Error GpgME::Data::setEncoding(Encoding enc)
     return Error(gpgme_data_set_encoding(d->data, ge));
 }
 
+static GpgME::Data::Type to_data_type(gpgme_data_type_t type)
+{
+    using GpgME::Data;
+    switch (type) {
+    case GPGME_DATA_TYPE_INVALID:       return Data::Invalid;
+    case GPGME_DATA_TYPE_UNKNOWN:       return Data::Unknown;
+    case GPGME_DATA_TYPE_PGP_SIGNED:    return Data::PGPSigned;
+    case GPGME_DATA_TYPE_PGP_OTHER:     return Data::PGPOther;
+    case GPGME_DATA_TYPE_PGP_KEY:       return Data::PGPKey;
+    case GPGME_DATA_TYPE_CMS_SIGNED:    return Data::CMSSigned;
+    case GPGME_DATA_TYPE_CMS_ENCRYPTED: return Data::CMSEncrypted;
+    case GPGME_DATA_TYPE_CMS_OTHER:     return Data::CMSOther;
+    case GPGME_DATA_TYPE_X509_CERT:     return Data::X509Cert;
+    case GPGME_DATA_TYPE_PKCS12:        return Data::PKCS12;
+    case GPGME_DATA_TYPE_PGP_ENCRYPTED: return Data::PGPEncrypted;
+    case GPGME_DATA_TYPE_PGP_SIGNATURE: return Data::PGPSignature;
+    }
+    return Data::Invalid;
+}
+
 GpgME::Data::Type GpgME::Data::type() const
 {
     if (isNull()) {
         return Invalid;
     }
-    switch (gpgme_data_identify(d->data, 0)) {
-    case GPGME_DATA_TYPE_INVALID:       return Invalid;
-    case GPGME_DATA_TYPE_UNKNOWN:       return Unknown;
-    case GPGME_DATA_TYPE_PGP_SIGNED:    return PGPSigned;
-    case GPGME_DATA_TYPE_PGP_OTHER:     return PGPOther;
-    case GPGME_DATA_TYPE_PGP_KEY:       return PGPKey;
-    case GPGME_DATA_TYPE_CMS_SIGNED:    return CMSSigned;
-    case GPGME_DATA_TYPE_CMS_ENCRYPTED: return CMSEncrypted;
-    case GPGME_DATA_TYPE_CMS_OTHER:     return CMSOther;
-    case GPGME_DATA_TYPE_X509_CERT:     return X509Cert;
-    case GPGME_DATA_TYPE_PKCS12:        return PKCS12;
-    case GPGME_DATA_TYPE_PGP_ENCRYPTED: return PGPEncrypted;
-    case GPGME_DATA_TYPE_PGP_SIGNATURE: return PGPSignature;
+    const int cached = d->cachedType.load(std::memory_order_relaxed);
+    if (cached >= 0) {
+        return static_cast<Type>(cached);
     }
-    return Invalid;
+    const Type type = to_data_type(gpgme_data_identify(d->data, 0));
+    d->cachedType.store(type, std::memory_order_relaxed);
+    return type;
+}
+
+GpgME::Data::Type GpgME::Data::identifyBuffer(const char *buffer, size_t size)
+{
+    if (!buffer || !size) {
+        return Invalid;
+    }
+    // gpgme identifies only data objects; one which does not copy the buffer
+    // is cheap compared to the identification
+    gpgme_data_t data;
+    if (gpgme_data_new_from_mem(&data, buffer, size, 0)) {
+        return Invalid;
+    }
+    const Type type = to_data_type(gpgme_data_identify(data, 0));
+    gpgme_data_release(data);
+    return type;
 }
 
 char *GpgME::Data::fileName() const
@@ -224,61 +690,241 @@ GpgME::Error GpgME::Data::setFileName(const std::string &name)
 
 gpgme_ssize_t GpgME::Data::read(void *buffer, size_t length)
 {
-    return gpgme_data_read(d->data, buffer, length);
+    d->invalidateType();
+    Private::IoStatsBlock *const stats = d->enabledIoStats();
+    if (!stats) {
+        return gpgme_data_read(d->data, buffer, length);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const gpgme_ssize_t n = gpgme_data_read(d->data, buffer, length);
+    stats->calls.countRead(n, std::chrono::steady_clock::now() - start);
+    return n;
 }
 
 gpgme_ssize_t GpgME::Data::write(const void *buffer, size_t length)
 {
-    return gpgme_data_write(d->data, buffer, length);
+    d->invalidateType();
+    Private::IoStatsBlock *const stats = d->enabledIoStats();
+    if (!stats) {
+        return gpgme_data_write(d->data, buffer, length);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const gpgme_ssize_t n = gpgme_data_write(d->data, buffer, length);
+    stats->calls.countWrite(n, std::chrono::steady_clock::now() - start);
+    return n;
+}
+
+gpgme_ssize_t GpgME::Data::writev(const DataSegment *segments, size_t count)
+{
+    gpgme_ssize_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const char *p = static_cast<const char *>(segments[i].base);
+        size_t left = segments[i].length;
+        while (left > 0) {
+            const gpgme_ssize_t n = write(p, left);
+            if (n <= 0) {
+                return total > 0 ? total : -1;
+            }
+            p += n;
+            left -= n;
+            total += n;
+        }
+    }
+    return total;
+}
+
+gpgme_ssize_t GpgME::Data::readv(const DataSegment *segments, size_t count)
+{
+    gpgme_ssize_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        char *p = static_cast<char *>(segments[i].base);
+        size_t left = segments[i].length;
+        while (left > 0) {
+            const gpgme_ssize_t n = read(p, left);
+            if (n < 0) {
+                return total > 0 ? total : -1;
+            }
+            if (n == 0) {
+                return total;
+            }
+            p += n;
+            left -= n;
+            total += n;
+        }
+    }
+    return total;
 }
 
 gpgme_off_t GpgME::Data::seek(gpgme_off_t offset, int whence)
 {
-    return gpgme_data_seek(d->data, offset, whence);
+    d->invalidateType();
+    Private::IoStatsBlock *const stats = d->enabledIoStats();
+    if (!stats) {
+        return gpgme_data_seek(d->data, offset, whence);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    const gpgme_off_t pos = gpgme_data_seek(d->data, offset, whence);
+    stats->calls.countSeek(std::chrono::steady_clock::now() - start);
+    return pos;
 }
 
 GpgME::Error GpgME::Data::rewind()
 {
+    d->invalidateType();
     return Error(gpgme_data_rewind(d->data));
 }
 
 std::vector<GpgME::Key> GpgME::Data::toKeys(Protocol proto) const
 {
-    std::vector<GpgME::Key> ret;
     if (isNull()) {
-        return ret;
+        return std::vector<GpgME::Key>();
     }
-    auto ctx = GpgME::Context::createForProtocol(proto);
+    const std::unique_ptr<GpgME::Context> ctx(GpgME::Context::createForProtocol(proto));
     if (!ctx) {
-        return ret;
+        return std::vector<GpgME::Key>();
     }
+    Error err;
+    return toKeys(*ctx, err);
+}
 
-    if (gpgme_op_keylist_from_data_start (ctx->impl()->ctx, d->data, 0)) {
-        return ret;
+GpgME::Error GpgME::Data::toKeys(Context &ctx, const std::function<bool(const Key &key)> &callback) const
+{
+    if (isNull()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    Context::Private *const cd = ctx.impl();
+    gpgme_ctx_t const c = cd->ctx;
+    cd->startOperation(Context::Private::KeyList, this);
+    Error err(gpgme_op_keylist_from_data_start(c, d->data, 0));
+    if (err) {
+        return cd->finished(err.encodedError());
     }
 
     gpgme_key_t key;
-    while (!gpgme_op_keylist_next (ctx->impl()->ctx, &key)) {
-        ret.push_back(GpgME::Key(key, false));
+    while (true) {
+        const gpgme_error_t e = gpgme_op_keylist_next(c, &key);
+        if (e) {
+            if (gpgme_err_code(e) != GPG_ERR_EOF) {
+                err = Error(e);
+            }
+            break;
+        }
+        // takes over the reference, also if there is no callback
+        const GpgME::Key k(key, false);
+        if (callback && !callback(k)) {
+            // stop the listing early
+            gpgme_op_keylist_end(c);
+            break;
+        }
     }
-    gpgme_data_seek (d->data, 0, SEEK_SET);
+    gpgme_data_seek(d->data, 0, SEEK_SET);
+    d->invalidateType();
+    return cd->finished(err.encodedError());
+}
 
-    delete ctx;
+std::vector<GpgME::Key> GpgME::Data::toKeys(Context &ctx, Error &err) const
+{
+    std::vector<GpgME::Key> ret;
+    err = toKeys(ctx, [&ret](const Key &key) {
+        ret.push_back(key);
+        return true;
+    });
     return ret;
 }
 
+namespace
+{
+// chunk sizes used when reading the data in one go
+constexpr size_t minimumChunkSize = 4096;
+constexpr size_t maximumChunkSize = 1024 * 1024;
+
+// returns the number of bytes between the current position and the end
+// of the data or 0 if this cannot be determined because the data is not seekable
+size_t remainingSize(gpgme_data_t data)
+{
+    const gpgme_off_t cur = gpgme_data_seek(data, 0, SEEK_CUR);
+    if (cur < 0) {
+        return 0;
+    }
+    const gpgme_off_t end = gpgme_data_seek(data, 0, SEEK_END);
+    gpgme_data_seek(data, cur, SEEK_SET);
+    return end > cur ? static_cast<size_t>(end - cur) : 0;
+}
+
+// reads everything from the current position to the end directly into out;
+// the container is sized from the remaining size if it is known, otherwise
+// the chunk size doubles with every completely filled chunk
+template<typename Container>
+GpgME::Error readAll(gpgme_data_t data, Container &out)
+{
+    const size_t expected = remainingSize(data);
+    // one extra byte so that the EOF is detected without resizing
+    size_t chunk = expected ? expected + 1 : minimumChunkSize;
+    size_t used = 0;
+    for (;;) {
+        if (out.size() == used) {
+            out.resize(used + chunk);
+            chunk = std::min(2 * chunk, std::max(chunk, maximumChunkSize));
+        }
+        const gpgme_ssize_t nread = gpgme_data_read(data, &out[used], out.size() - used);
+        if (nread < 0) {
+            out.resize(used);
+            return GpgME::Error::fromSystemError();
+        }
+        if (nread == 0) {
+            break;
+        }
+        used += nread;
+    }
+    out.resize(used);
+    return GpgME::Error();
+}
+}
+
 std::string GpgME::Data::toString()
 {
-  std::string ret;
-  char buf[4096];
-  size_t nread;
-  seek (0, SEEK_SET);
-  while ((nread = read (buf, 4096)) > 0)
-    {
-      ret += std::string (buf, nread);
+    std::string ret;
+    if (isNull()) {
+        return ret;
+    }
+    seek(0, SEEK_SET);
+    readAll(d->data, ret);
+    seek(0, SEEK_SET);
+    return ret;
+}
+
+std::vector<unsigned char> GpgME::Data::toBytes()
+{
+    std::vector<unsigned char> ret;
+    if (isNull()) {
+        return ret;
+    }
+    seek(0, SEEK_SET);
+    readAll(d->data, ret);
+    seek(0, SEEK_SET);
+    return ret;
+}
+
+GpgME::Error GpgME::Data::drainTo(const std::function<void(const char *, size_t)> &sink)
+{
+    if (isNull()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    std::vector<char> buf(minimumChunkSize);
+    for (;;) {
+        const gpgme_ssize_t nread = read(buf.data(), buf.size());
+        if (nread < 0) {
+            return Error::fromSystemError();
+        }
+        if (nread == 0) {
+            return Error();
+        }
+        sink(buf.data(), nread);
+        // use bigger chunks for bigger data
+        if (static_cast<size_t>(nread) == buf.size() && buf.size() < maximumChunkSize) {
+            buf.resize(2 * buf.size());
+        }
     }
-  seek (0, SEEK_SET);
-  return ret;
 }
 
 GpgME::Error GpgME::Data::setFlag(const char *name, const char *value)
@@ -291,3 +937,43 @@ GpgME::Error GpgME::Data::setSizeHint(uint64_t size)
     const std::string val = std::to_string(size);
     return Error(gpgme_data_set_flag(d->data, "size-hint", val.c_str()));
 }
+
+void GpgME::Data::setIoStatsEnabled(bool enabled)
+{
+    Private::IoStatsBlock *block = d->ioStats.load(std::memory_order_acquire);
+    if (!block) {
+        if (!enabled) {
+            return;
+        }
+        Private::IoStatsBlock *const created = new Private::IoStatsBlock;
+        if (d->ioStats.compare_exchange_strong(block, created, std::memory_order_acq_rel)) {
+            return;
+        }
+        // enabled concurrently by a copy of this data
+        delete created;
+    }
+    block->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool GpgME::Data::ioStatsEnabled() const
+{
+    return d->enabledIoStats();
+}
+
+GpgME::Data::IoStats GpgME::Data::ioStats() const
+{
+    IoStats stats;
+    if (const Private::IoStatsBlock *const block = d->ioStats.load(std::memory_order_acquire)) {
+        stats.provider = block->provider.get();
+        stats.calls = block->calls.get();
+    }
+    return stats;
+}
+
+void GpgME::Data::resetIoStats()
+{
+    if (Private::IoStatsBlock *const block = d->ioStats.load(std::memory_order_acquire)) {
+        block->provider.reset();
+        block->calls.reset();
+    }
+}
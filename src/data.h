@@ -31,7 +31,11 @@
 #include <cstdint> // unit64_t
 #include <cstdio> // FILE
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace GpgME
 {
@@ -39,6 +43,12 @@ namespace GpgME
 class DataProvider;
 class Error;
 
+/** A buffer segment for vectored reads and writes, like struct iovec. */
+struct DataSegment {
+    void *base;
+    size_t length;
+};
+
 class GPGMEPP_EXPORT Data
 {
     struct Null {
@@ -65,9 +75,39 @@ public:
     // Callback-Based Data Buffers:
     explicit Data(DataProvider *provider);
 
+    /** Creates a data object which reads directly from @p buffer without
+     * copying it. The data keeps a reference to @p owner for as long as
+     * any copy of it exists, so that the memory can be tied to the
+     * lifetime of the data. The size hint is set to @p size. */
+    static Data fromView(const char *buffer, size_t size, const std::shared_ptr<void> &owner);
+
+    /** Creates a data object which reads the region of @p length bytes at
+     * @p offset of the file @p path directly from a read-only memory
+     * mapping of the file. If @p length is 0, then the region extends to
+     * the end of the file. Returns a null data object and sets @p err if
+     * the file cannot be mapped. Not supported on Windows. */
+    static Data mapFile(const char *path, gpgme_off_t offset = 0, size_t length = 0, Error *err = nullptr);
+
+    /** Creates a seekable, growing memory buffer for plain texts. The
+     * memory is allocated from the SecureArena, i.e. it is locked if
+     * possible and wiped when it is no longer used. @p reserve bytes are
+     * allocated up front. */
+    static Data secureBuffer(size_t reserve = 0);
+
+    /** Creates a data object which appends everything written to it to
+     * @p buffer, e.g. the output of an operation, so that the output does
+     * not have to be copied out of the data afterwards. Reserve capacity in
+     * @p buffer up front to avoid reallocations. The data can be read and
+     * seeked within the appended part. @p buffer is not owned and must
+     * outlive the data and all its copies. */
+    static Data intoBuffer(std::vector<char> &buffer);
+    /** Same as above for a string. */
+    static Data intoString(std::string &string);
+
     static const Null null;
 
     Data(const Data &other) = default;
+    Data(Data &&other) = default;
     const Data &operator=(Data other)
     {
         swap(other);
@@ -109,7 +149,13 @@ public:
         PGPEncrypted,
         PGPSignature,
     };
+    /** Identifies the data from the current position on. The result is
+     * cached until the data is read, written or sought with this data
+     * object or a copy of it, or used by an operation of a Context. */
     Type type() const;
+    /** Identifies @p size bytes at @p buffer like type() without copying
+     * them and without changing any data object. */
+    static Type identifyBuffer(const char *buffer, size_t size);
 
     char *fileName() const;
     Error setFileName(const char *name);
@@ -125,6 +171,15 @@ public:
     off_t seek(off_t offset, int whence);
 #endif
 
+    /** Writes the @p count segments in order, without copying them into a
+     * contiguous buffer first. Returns the number of bytes written, which
+     * is less than the total length only if a write failed, or -1 if
+     * nothing could be written. */
+    gpgme_ssize_t writev(const DataSegment *segments, size_t count);
+    /** Reads into the @p count segments in order until the end of the data.
+     * Returns the number of bytes read, or -1 if nothing could be read. */
+    gpgme_ssize_t readv(const DataSegment *segments, size_t count);
+
     /* Convenience function to do a seek (0, SEEK_SET).  */
     Error rewind();
 
@@ -132,15 +187,58 @@ public:
      * Protocol proto. Returns an empty list on error.*/
     std::vector<Key> toKeys(const Protocol proto = Protocol::OpenPGP) const;
 
+    /** Parses the data to key objects with @p ctx, e.g. a leased context
+     * of a ContextPool, instead of a newly created context. @p callback is
+     * called for every key; returning false stops the parsing. Sets the seek
+     * pos to 0. */
+    Error toKeys(Context &ctx, const std::function<bool(const Key &key)> &callback) const;
+    std::vector<Key> toKeys(Context &ctx, Error &err) const;
+
     /** Return a copy of the data as std::string. Sets seek pos to 0 */
     std::string toString();
 
+    /** Same as toString() but returns the data as bytes. Sets seek pos to 0 */
+    std::vector<unsigned char> toBytes();
+
+    /** Reads the data from the current position to the end and passes it
+     * chunk by chunk to @p sink. The seek position is not reset. */
+    Error drainTo(const std::function<void(const char *data, size_t size)> &sink);
+
     /** See gpgme_data_set_flag */
     Error setFlag(const char *name, const char *value);
 
     /** Set a size hint for this data e.g. for progress calculations. */
     Error setSizeHint(uint64_t size);
 
+    /** Counters of the reads, writes and seeks of a data object. */
+    struct IoStats {
+        struct Counters {
+            uint64_t reads = 0;
+            uint64_t writes = 0;
+            uint64_t seeks = 0;
+            uint64_t bytesRead = 0;
+            uint64_t bytesWritten = 0;
+            std::chrono::nanoseconds readTime{0};
+            std::chrono::nanoseconds writeTime{0};
+            std::chrono::nanoseconds seekTime{0};
+        };
+        /** The calls of the DataProvider, i.e. mostly by the engine. Only
+         * counted for data created from a DataProvider. */
+        Counters provider;
+        /** The calls of read(), write(), seek(), readv() and writev(). */
+        Counters calls;
+    };
+
+    /** Enables or disables counting the I/O of this data object and of all
+     * its copies. Disabled by default; while disabled the I/O only costs a
+     * check of a pointer. Enabling again keeps the counters. */
+    void setIoStatsEnabled(bool enabled);
+    bool ioStatsEnabled() const;
+    /** Returns the counters collected while the statistics were enabled. Can
+     * be called while an operation uses the data. */
+    IoStats ioStats() const;
+    void resetIoStats();
+
     class Private;
     Private *impl()
     {
@@ -28,15 +28,62 @@
 #include <data.h>
 #include "callbacks.h"
 
+#include <atomic>
+#include <chrono>
+
 class GpgME::Data::Private
 {
 public:
+    struct IoCounters {
+        std::atomic<uint64_t> reads{0};
+        std::atomic<uint64_t> writes{0};
+        std::atomic<uint64_t> seeks{0};
+        std::atomic<uint64_t> bytesRead{0};
+        std::atomic<uint64_t> bytesWritten{0};
+        std::atomic<int64_t> readTime{0};
+        std::atomic<int64_t> writeTime{0};
+        std::atomic<int64_t> seekTime{0};
+
+        void countRead(gpgme_ssize_t n, std::chrono::steady_clock::duration time);
+        void countWrite(gpgme_ssize_t n, std::chrono::steady_clock::duration time);
+        void countSeek(std::chrono::steady_clock::duration time);
+        void reset();
+        IoStats::Counters get() const;
+    };
+    struct IoStatsBlock {
+        std::atomic<bool> enabled{true};
+        IoCounters provider;
+        IoCounters calls;
+    };
+
     explicit Private(gpgme_data_t d = nullptr)
-        : data(d), cbs(data_provider_callbacks) {}
+        : data(d), cbs(data_provider_callbacks), provider(nullptr), ioStats(nullptr), cachedType(-1) {}
     ~Private();
 
+    // to be called whenever the position or the content of the data changes
+    void invalidateType() const
+    {
+        cachedType.store(-1, std::memory_order_relaxed);
+    }
+
+    // returns the counters if the statistics are enabled, otherwise nullptr
+    IoStatsBlock *enabledIoStats() const
+    {
+        IoStatsBlock *const block = ioStats.load(std::memory_order_acquire);
+        return block && block->enabled.load(std::memory_order_relaxed) ? block : nullptr;
+    }
+
     gpgme_data_t data;
     gpgme_data_cbs cbs;
+    // keeps the memory of data created by Data::fromView alive
+    std::shared_ptr<void> owner;
+    // the opaque of the callbacks is the Private, so that they can count
+    DataProvider *provider;
+    // allocated on first enabling and kept until the data is released, so
+    // that the callbacks never see it disappear
+    std::atomic<IoStatsBlock *> ioStats;
+    // the result of Data::type() or -1
+    mutable std::atomic<int> cachedType;
 };
 
 #endif // __GPGMEPP_DATA_P_H__
@@ -45,39 +45,28 @@ class GpgME::DecryptionResult::Private
 public:
     explicit Private(const _gpgme_op_decrypt_result &r) : res(r)
     {
-        if (res.unsupported_algorithm) {
-            res.unsupported_algorithm = strdup(res.unsupported_algorithm);
-        }
-        if (res.file_name) {
-            res.file_name = strdup(res.file_name);
-        }
-        if (res.symkey_algo) {
-            res.symkey_algo = strdup(res.symkey_algo);
-        }
+        arena.reserveString(res.unsupported_algorithm);
+        arena.reserveString(res.file_name);
+        arena.reserveString(res.symkey_algo);
+        res.unsupported_algorithm = arena.copyString(res.unsupported_algorithm);
+        res.file_name = arena.copyString(res.file_name);
+        res.symkey_algo = arena.copyString(res.symkey_algo);
         //FIXME: copying gpgme_recipient_t objects invalidates the keyid member,
         //thus we use _keyid for now (internal API)
+        unsigned int count = 0;
+        for (gpgme_recipient_t r = res.recipients ; r ; r = r->next) {
+            ++count;
+        }
+        recipients.reserve(count);
         for (gpgme_recipient_t r = res.recipients ; r ; r = r->next) {
             recipients.push_back(*r);
         }
         res.recipients = nullptr;
     }
-    ~Private()
-    {
-        if (res.unsupported_algorithm) {
-            std::free(res.unsupported_algorithm);
-        }
-        res.unsupported_algorithm = nullptr;
-        if (res.file_name) {
-            std::free(res.file_name);
-        }
-        res.file_name = nullptr;
-        if (res.symkey_algo) {
-            std::free(res.symkey_algo);
-        }
-        res.symkey_algo = nullptr;
-    }
 
     _gpgme_op_decrypt_result res;
+    // owns the copies of the strings of res
+    ResultArena arena;
     std::vector<_gpgme_recipient> recipients;
 };
 
@@ -107,6 +96,11 @@ void GpgME::DecryptionResult::init(gpgme_ctx_t ctx)
 
 make_standard_stuff(DecryptionResult)
 
+GpgME::MemoryUsage GpgME::DecryptionResult::approximateMemoryUsage() const
+{
+    return resultMemoryUsage<DecryptionResult>(d, d ? d->arena.allocatedBytes() + heapBytes(d->recipients) : 0);
+}
+
 const char *GpgME::DecryptionResult::unsupportedAlgorithm() const
 {
     return d ? d->res.unsupported_algorithm : nullptr ;
@@ -230,6 +224,16 @@ const char *GpgME::DecryptionResult::Recipient::shortKeyID() const
     return nullptr;
 }
 
+std::string_view GpgME::DecryptionResult::Recipient::keyIDView() const
+{
+    return to_string_view(keyID());
+}
+
+std::string_view GpgME::DecryptionResult::Recipient::shortKeyIDView() const
+{
+    return to_string_view(shortKeyID());
+}
+
 unsigned int GpgME::DecryptionResult::Recipient::publicKeyAlgorithm() const
 {
     if (d) {
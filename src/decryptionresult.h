@@ -33,6 +33,7 @@
 #include <algorithm>
 #include <iosfwd>
 #include <memory>
+#include <string_view>
 
 namespace GpgME
 {
@@ -48,6 +49,7 @@ public:
     explicit DecryptionResult(const Error &err);
 
     DecryptionResult(const DecryptionResult &other) = default;
+    DecryptionResult(DecryptionResult &&other) = default;
     const DecryptionResult &operator=(DecryptionResult other)
     {
         swap(other);
@@ -63,6 +65,9 @@ public:
 
     bool isNull() const;
 
+    /** Returns the approximate memory used by the result. */
+    MemoryUsage approximateMemoryUsage() const;
+
     const char *unsupportedAlgorithm() const;
 
     bool isWrongKeyUsage() const;
@@ -99,6 +104,7 @@ public:
     explicit Recipient(gpgme_recipient_t reci);
 
     Recipient(const Recipient &other) = default;
+    Recipient(Recipient &&other) = default;
     const Recipient &operator=(Recipient other)
     {
         swap(other);
@@ -115,6 +121,9 @@ public:
 
     const char *keyID() const;
     const char *shortKeyID() const;
+    /** Views of keyID() and shortKeyID(), which are empty if not available. */
+    std::string_view keyIDView() const;
+    std::string_view shortKeyIDView() const;
 
     unsigned int publicKeyAlgorithm() const;
     const char *publicKeyAlgorithmAsString() const;
@@ -29,6 +29,7 @@
 #include "editinteractor.h"
 #include "callbacks.h"
 #include "error.h"
+#include "statusline.h"
 #include "util.h"
 
 #include <gpgme.h>
@@ -68,6 +69,10 @@ private:
     Error error;
     std::FILE *debug = nullptr;
     bool debugNeedsClosing = false;
+    bool tracing = false;
+    std::vector<TraceEntry> trace;
+    // when the last response was written
+    std::chrono::steady_clock::time_point lastResponse;
 };
 
 class GpgME::CallbackHelper
@@ -75,12 +80,14 @@ class GpgME::CallbackHelper
 private:
     static int writeAll(int fd, const void *buf, size_t count)
     {
+        const char *data = static_cast<const char *>(buf);
         size_t toWrite = count;
         while (toWrite > 0) {
-            const int n = gpgme_io_write(fd, buf, toWrite);
+            const int n = gpgme_io_write(fd, data, toWrite);
             if (n < 0) {
                 return n;
             }
+            data += n;
             toWrite -= n;
         }
         return count;
@@ -91,6 +98,8 @@ public:
     {
         EditInteractor::Private *ei = (EditInteractor::Private *)opaque;
 
+        const auto arrived = ei->tracing ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        const unsigned int stateBefore = ei->state;
         Error err = status_to_error(status);
 
         if (!err) {
@@ -131,20 +140,19 @@ public:
                     if (ei->debug) {
                         std::fprintf(ei->debug, "EditInteractor: action result \"%s\"\n", result);
                     }
-                    // if there's a result, write it:
-                    if (*result) {
-                        gpgme_err_set_errno(0);
-                        const gpgme_ssize_t len = std::strlen(result);
-                        if (writeAll(fd, result, len) != len) {
-                            err = Error::fromSystemError();
-                            if (ei->debug) {
-                                std::fprintf(ei->debug, "EditInteractor: Could not write to fd %d (%s)\n", fd, err.asStdString().c_str());
-                            }
-                            goto error;
-                        }
-                    }
+                    // write the result and the newline with one write
                     gpgme_err_set_errno(0);
-                    if (writeAll(fd, "\n", 1) != 1) {
+                    const size_t len = std::strlen(result);
+                    char inlineBuffer[256];
+                    std::string heapBuffer;
+                    char *buffer = inlineBuffer;
+                    if (len + 1 > sizeof inlineBuffer) {
+                        heapBuffer.resize(len + 1);
+                        buffer = &heapBuffer[0];
+                    }
+                    std::memcpy(buffer, result, len);
+                    buffer[len] = '\n';
+                    if (writeAll(fd, buffer, len + 1) != static_cast<int>(len + 1)) {
                         err = Error::fromSystemError();
                         if (ei->debug) {
                             std::fprintf(ei->debug, "EditInteractor: Could not write to fd %d (%s)\n", fd, err.asStdString().c_str());
@@ -191,6 +199,19 @@ public:
                          ei->error.encodedError(), gpgme_strerror(ei->error.encodedError()));
         }
 
+        if (ei->tracing && !ei->q->needsNoResponse(status)) {
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+            const auto done = std::chrono::steady_clock::now();
+            if (ei->lastResponse == std::chrono::steady_clock::time_point()) {
+                ei->lastResponse = arrived;
+            }
+            ei->trace.push_back({stateBefore, ei->state, static_cast<unsigned int>(status), args ? args : "",
+                                 duration_cast<microseconds>(arrived - ei->lastResponse),
+                                 duration_cast<microseconds>(done - arrived)});
+            ei->lastResponse = done;
+        }
+
         return ei->error.encodedError();
     }
 };
@@ -247,6 +268,11 @@ Error EditInteractor::lastError() const
     return d->error;
 }
 
+void EditInteractor::setLastError(const Error &err)
+{
+    d->error = err;
+}
+
 bool EditInteractor::needsNoResponse(unsigned int status) const
 {
     switch (status) {
@@ -284,6 +310,27 @@ void EditInteractor::setDebugChannel(std::FILE *debug)
     d->debug = debug;
 }
 
+void EditInteractor::setTraceEnabled(bool enabled)
+{
+    d->tracing = enabled;
+}
+
+bool EditInteractor::isTraceEnabled() const
+{
+    return d->tracing;
+}
+
+const std::vector<EditInteractor::TraceEntry> &EditInteractor::trace() const
+{
+    return d->trace;
+}
+
+void EditInteractor::clearTrace()
+{
+    d->trace.clear();
+    d->lastResponse = std::chrono::steady_clock::time_point();
+}
+
 GpgME::Error EditInteractor::parseStatusError(const char *args)
 {
     Error err;
@@ -330,107 +377,8 @@ Error parse_sc_op_failure(const char *args)
     return err;
 }
 
-static const char *const status_strings[] = {
-    "EOF",
-    /* mkstatus processing starts here */
-    "ENTER",
-    "LEAVE",
-    "ABORT",
-
-    "GOODSIG",
-    "BADSIG",
-    "ERRSIG",
-
-    "BADARMOR",
-
-    "RSA_OR_IDEA",
-    "KEYEXPIRED",
-    "KEYREVOKED",
-
-    "TRUST_UNDEFINED",
-    "TRUST_NEVER",
-    "TRUST_MARGINAL",
-    "TRUST_FULLY",
-    "TRUST_ULTIMATE",
-
-    "SHM_INFO",
-    "SHM_GET",
-    "SHM_GET_BOOL",
-    "SHM_GET_HIDDEN",
-
-    "NEED_PASSPHRASE",
-    "VALIDSIG",
-    "SIG_ID",
-    "ENC_TO",
-    "NODATA",
-    "BAD_PASSPHRASE",
-    "NO_PUBKEY",
-    "NO_SECKEY",
-    "NEED_PASSPHRASE_SYM",
-    "DECRYPTION_FAILED",
-    "DECRYPTION_OKAY",
-    "MISSING_PASSPHRASE",
-    "GOOD_PASSPHRASE",
-    "GOODMDC",
-    "BADMDC",
-    "ERRMDC",
-    "IMPORTED",
-    "IMPORT_OK",
-    "IMPORT_PROBLEM",
-    "IMPORT_RES",
-    "FILE_START",
-    "FILE_DONE",
-    "FILE_ERROR",
-
-    "BEGIN_DECRYPTION",
-    "END_DECRYPTION",
-    "BEGIN_ENCRYPTION",
-    "END_ENCRYPTION",
-
-    "DELETE_PROBLEM",
-    "GET_BOOL",
-    "GET_LINE",
-    "GET_HIDDEN",
-    "GOT_IT",
-    "PROGRESS",
-    "SIG_CREATED",
-    "SESSION_KEY",
-    "NOTATION_NAME",
-    "NOTATION_DATA",
-    "POLICY_URL",
-    "BEGIN_STREAM",
-    "END_STREAM",
-    "KEY_CREATED",
-    "USERID_HINT",
-    "UNEXPECTED",
-    "INV_RECP",
-    "NO_RECP",
-    "ALREADY_SIGNED",
-    "SIGEXPIRED",
-    "EXPSIG",
-    "EXPKEYSIG",
-    "TRUNCATED",
-    "ERROR",
-    "NEWSIG",
-    "REVKEYSIG",
-    "SIG_SUBPACKET",
-    "NEED_PASSPHRASE_PIN",
-    "SC_OP_FAILURE",
-    "SC_OP_SUCCESS",
-    "CARDCTRL",
-    "BACKUP_KEY_CREATED",
-    "PKA_TRUST_BAD",
-    "PKA_TRUST_GOOD",
-
-    "PLAINTEXT",
-};
-static const unsigned int num_status_strings = sizeof status_strings / sizeof * status_strings ;
-
 const char *status_to_string(unsigned int idx)
 {
-    if (idx < num_status_strings) {
-        return status_strings[idx];
-    } else {
-        return "(unknown)";
-    }
+    const char *const keyword = StatusLine::keywordForCode(idx);
+    return keyword ? keyword : "(unknown)";
 }
@@ -27,7 +27,10 @@
 
 #include "gpgmepp_export.h"
 
+#include <chrono>
 #include <cstdio>
+#include <string>
+#include <vector>
 
 namespace GpgME
 {
@@ -60,10 +63,33 @@ public:
 
     void setDebugChannel(std::FILE *file);
 
+    /** A status line handled by the interactor, with the timings. */
+    struct TraceEntry {
+        unsigned int oldState;
+        unsigned int newState;
+        unsigned int statusCode;
+        std::string args;
+        /** The time between the previous response (or the first status
+         * line) and this status line, i.e. the time the engine needed. */
+        std::chrono::microseconds engineTime;
+        /** The time needed for computing and writing the response. */
+        std::chrono::microseconds responseTime;
+    };
+
+    /** Enables recording a TraceEntry for every status line which needs a
+     * response. Tracing is off by default. */
+    void setTraceEnabled(bool enabled);
+    bool isTraceEnabled() const;
+    const std::vector<TraceEntry> &trace() const;
+    void clearTrace();
+
 protected:
     Error parseStatusError(const char *args);
 
 private:
+    // used by Context when it runs the edit as a quick command
+    void setLastError(const Error &err);
+
     class Private;
     Private *const d;
 };
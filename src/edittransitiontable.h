@@ -0,0 +1,143 @@
+/*
+  edittransitiontable.h - compile-time transition tables for edit interactors
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_EDITTRANSITIONTABLE_H__
+#define __GPGMEPP_EDITTRANSITIONTABLE_H__
+
+#include "editinteractor.h"
+#include "error.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace GpgME
+{
+
+/**
+ * A transition of an EditInteractor state machine: in @c state, a status
+ * line with the code @c status and the prompt keyword @c prompt leads to
+ * the state @c next. If @c prompt is null, then any arguments match. If
+ * @c error is set, then the transition sets this error; this is used for
+ * transitions to the error state, e.g. if gpg asks again for a value.
+ */
+struct EditTransition {
+    unsigned int state;
+    unsigned int status;
+    const char *prompt;
+    unsigned int next;
+    gpg_err_code_t error;
+};
+
+/**
+ * A table of EditTransition built at compile time, which implements
+ * EditInteractor::nextState without comparing every prompt as string.
+ *
+ * The prompts are hashed at compile time; a status line is hashed once
+ * and then only the transitions of the current state with the same status
+ * code and hash are compared. The first matching transition wins.
+ *
+ * Example:
+ * @code
+ * static constexpr EditTransition transitions[] = {
+ *     {START, GPGME_STATUS_GET_LINE, "keyedit.prompt", COMMAND, GPG_ERR_NO_ERROR},
+ *     ...
+ * };
+ * static constexpr auto table = makeEditTransitionTable(transitions);
+ * @endcode
+ */
+template <size_t N>
+class EditTransitionTable
+{
+public:
+    constexpr explicit EditTransitionTable(const EditTransition (&transitions)[N])
+        : mEntries{}
+    {
+        for (size_t i = 0; i < N; ++i) {
+            mEntries[i].transition = transitions[i];
+            mEntries[i].hash = hash(transitions[i].prompt);
+        }
+    }
+
+    constexpr size_t size() const
+    {
+        return N;
+    }
+
+    /**
+     * Returns the state following @p state for the status line
+     * (@p status, @p args) and sets @p err to the error of the transition.
+     * If no transition matches, then @p err is set to @p noMatchError and
+     * EditInteractor::ErrorState is returned.
+     */
+    unsigned int next(unsigned int state, unsigned int status, const char *args,
+                      Error &err, const Error &noMatchError) const
+    {
+        const std::uint32_t h = hash(args);
+        for (const Entry &entry : mEntries) {
+            const EditTransition &t = entry.transition;
+            if (t.state != state || t.status != status) {
+                continue;
+            }
+            if (t.prompt && (entry.hash != h || !args || std::strcmp(t.prompt, args) != 0)) {
+                continue;
+            }
+            if (t.error != GPG_ERR_NO_ERROR) {
+                err = Error::fromCode(t.error);
+            }
+            return t.next;
+        }
+        err = noMatchError;
+        return EditInteractor::ErrorState;
+    }
+
+    /** The FNV-1a hash of @p s; 0 for null. */
+    static constexpr std::uint32_t hash(const char *s)
+    {
+        if (!s) {
+            return 0;
+        }
+        std::uint32_t h = 2166136261u;
+        while (*s) {
+            h = (h ^ static_cast<unsigned char>(*s++)) * 16777619u;
+        }
+        return h;
+    }
+
+private:
+    struct Entry {
+        EditTransition transition = {0, 0, nullptr, 0, GPG_ERR_NO_ERROR};
+        std::uint32_t hash = 0;
+    };
+    std::array<Entry, N> mEntries;
+};
+
+template <size_t N>
+constexpr EditTransitionTable<N> makeEditTransitionTable(const EditTransition (&transitions)[N])
+{
+    return EditTransitionTable<N>(transitions);
+}
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_EDITTRANSITIONTABLE_H__
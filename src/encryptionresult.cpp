@@ -45,25 +45,25 @@ class GpgME::EncryptionResult::Private
 public:
     explicit Private(const _gpgme_op_encrypt_result &r) : res(r)
     {
+        unsigned int count = 0;
         for (gpgme_invalid_key_t ik = res.invalid_recipients ; ik ; ik = ik->next) {
-            gpgme_invalid_key_t copy = new _gpgme_invalid_key(*ik);
-            if (ik->fpr) {
-                copy->fpr = strdup(ik->fpr);
-            }
+            ++count;
+            arena.reserve<_gpgme_invalid_key>();
+            arena.reserveString(ik->fpr);
+        }
+        invalid.reserve(count);
+        for (gpgme_invalid_key_t ik = res.invalid_recipients ; ik ; ik = ik->next) {
+            gpgme_invalid_key_t copy = arena.copy(*ik);
+            copy->fpr = arena.copyString(ik->fpr);
             copy->next = nullptr;
             invalid.push_back(copy);
         }
         res.invalid_recipients = nullptr;
     }
-    ~Private()
-    {
-        for (std::vector<gpgme_invalid_key_t>::iterator it = invalid.begin() ; it != invalid.end() ; ++it) {
-            std::free((*it)->fpr);
-            delete *it; *it = nullptr;
-        }
-    }
 
     _gpgme_op_encrypt_result res;
+    // owns the copies of the invalid keys
+    ResultArena arena;
     std::vector<gpgme_invalid_key_t> invalid;
 };
 
@@ -93,6 +93,11 @@ void GpgME::EncryptionResult::init(gpgme_ctx_t ctx)
 
 make_standard_stuff(EncryptionResult)
 
+GpgME::MemoryUsage GpgME::EncryptionResult::approximateMemoryUsage() const
+{
+    return resultMemoryUsage<EncryptionResult>(d, d ? d->arena.allocatedBytes() + heapBytes(d->invalid) : 0);
+}
+
 bool GpgME::EncryptionResult::isDeVs() const
 {
     return d && d->res.is_de_vs;
@@ -49,6 +49,7 @@ public:
     EncryptionResult(const Error &err);
 
     EncryptionResult(const EncryptionResult &other) = default;
+    EncryptionResult(EncryptionResult &&other) = default;
     const EncryptionResult &operator=(EncryptionResult other)
     {
         swap(other);
@@ -64,6 +65,9 @@ public:
 
     bool isNull() const;
 
+    /** Returns the approximate memory used by the result. */
+    MemoryUsage approximateMemoryUsage() const;
+
     bool isDeVs() const;
     bool isBetaCompliance() const;
 
@@ -88,6 +92,7 @@ public:
     InvalidRecipient();
 
     InvalidRecipient(const InvalidRecipient &other) = default;
+    InvalidRecipient(InvalidRecipient &&other) = default;
     const InvalidRecipient &operator=(InvalidRecipient other)
     {
         swap(other);
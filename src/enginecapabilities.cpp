@@ -0,0 +1,91 @@
+/*
+  enginecapabilities.cpp - cached versions and features of the engines
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "enginecapabilities.h"
+
+#include <array>
+
+using namespace GpgME;
+
+namespace
+{
+static_assert(GpgEngine == 0 && GpgSMEngine == 1 && GpgConfEngine == 2 && UnknownEngine == 3
+              && AssuanEngine == 4 && G13Engine == 5 && SpawnEngine == 6, "unexpected values of Engine");
+
+struct FeatureVersion {
+    EngineCapabilities::Feature feature;
+    EngineInfo::Version version;
+};
+
+constexpr FeatureVersion gpgFeatures[] = {
+    {EngineCapabilities::CombinedSecretKeyListing, "2.1.0"},
+    {EngineCapabilities::Tofu, "2.1.10"},
+    {EngineCapabilities::QuickCommands, "2.1.13"},
+    {EngineCapabilities::KeyListFromData, "2.1.14"},
+    {EngineCapabilities::SetExpireSubkeys, "2.1.22"},
+    {EngineCapabilities::QuickSetOwnerTrust, "2.4.6"},
+};
+}
+
+unsigned int EngineCapabilities::featuresOf(Engine engine, const EngineInfo::Version &version)
+{
+    unsigned int features = NoFeatures;
+    if (engine == GpgEngine) {
+        for (const FeatureVersion &fv : gpgFeatures) {
+            if (!(version < fv.version)) {
+                features |= fv.feature;
+            }
+        }
+    }
+    return features;
+}
+
+EngineCapabilities EngineCapabilities::create(Engine engine)
+{
+    EngineCapabilities caps;
+    caps.mEngine = engine;
+    if (engine == UnknownEngine) {
+        return caps;
+    }
+    const EngineInfo info = engineInfo(engine);
+    caps.mValid = !info.isNull() && info.fileName();
+    if (caps.mValid) {
+        caps.mVersion = info.engineVersion();
+        caps.mFeatures = featuresOf(engine, caps.mVersion);
+    }
+    return caps;
+}
+
+const EngineCapabilities &EngineCapabilities::get(Engine engine)
+{
+    // indexed by the value of the engine
+    static const std::array<EngineCapabilities, 7> table = {{
+        create(GpgEngine), create(GpgSMEngine), create(GpgConfEngine), create(UnknownEngine),
+        create(AssuanEngine), create(G13Engine), create(SpawnEngine),
+    }};
+    const size_t idx = static_cast<size_t>(engine);
+    return idx < table.size() ? table[idx] : table[UnknownEngine];
+}
@@ -0,0 +1,115 @@
+/*
+  enginecapabilities.h - cached versions and features of the engines
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_ENGINECAPABILITIES_H__
+#define __GPGMEPP_ENGINECAPABILITIES_H__
+
+#include "global.h"
+#include "engineinfo.h"
+
+namespace GpgME
+{
+
+/**
+ * The version and the features of an engine as installed when the
+ * capabilities were first requested.
+ *
+ * The capabilities of all engines are determined once per process from
+ * gpgme's global engine information. Unlike engineInfo(), get() does not
+ * allocate or parse anything, so that feature checks on hot paths cost a
+ * load and a compare. Engines configured per context with
+ * Context::setEngineFileName() are not taken into account.
+ *
+ * Comparisons with version literals, e.g. versionIsAtLeast("2.1.0"), can be
+ * evaluated at compile time.
+ */
+class GPGMEPP_EXPORT EngineCapabilities
+{
+public:
+    enum Feature : unsigned int {
+        NoFeatures = 0,
+        /** The secret key information is part of the public key listing (gpg 2.1.0). */
+        CombinedSecretKeyListing = 1 << 0,
+        /** TOFU trust model (gpg 2.1.10) */
+        Tofu = 1 << 1,
+        /** The quick key management commands (gpg 2.1.13) */
+        QuickCommands = 1 << 2,
+        /** Listing the keys of a data object (gpg 2.1.14) */
+        KeyListFromData = 1 << 3,
+        /** Setting the expiration time of subkeys (gpg 2.1.22) */
+        SetExpireSubkeys = 1 << 4,
+        /** Setting the owner trust and enabling or disabling keys with
+         * quick commands (gpg 2.4.6) */
+        QuickSetOwnerTrust = 1 << 5,
+    };
+
+    /** Returns the capabilities of @p engine. */
+    static const EngineCapabilities &get(Engine engine);
+
+    Engine engine() const
+    {
+        return mEngine;
+    }
+
+    /** Returns false if the engine is not available. */
+    bool isValid() const
+    {
+        return mValid;
+    }
+
+    const EngineInfo::Version &version() const
+    {
+        return mVersion;
+    }
+
+    constexpr bool versionIsAtLeast(const EngineInfo::Version &version) const
+    {
+        return !(mVersion < version);
+    }
+
+    bool hasFeature(Feature feature) const
+    {
+        return (mFeatures & feature) == feature;
+    }
+
+    unsigned int features() const
+    {
+        return mFeatures;
+    }
+
+    /** Returns the features of the version @p version of @p engine. */
+    static unsigned int featuresOf(Engine engine, const EngineInfo::Version &version);
+
+private:
+    EngineCapabilities() = default;
+    static EngineCapabilities create(Engine engine);
+
+    Engine mEngine = UnknownEngine;
+    bool mValid = false;
+    EngineInfo::Version mVersion;
+    unsigned int mFeatures = NoFeatures;
+};
+
+}
+
+#endif // __GPGMEPP_ENGINECAPABILITIES_H__
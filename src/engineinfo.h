@@ -42,34 +42,37 @@ public:
     struct Version
     {
         int major, minor, patch;
-        Version()
+        constexpr Version()
+            : major(0), minor(0), patch(0)
+        {
+        }
+
+        constexpr Version(int maj, int min, int pat)
+            : major(maj), minor(min), patch(pat)
         {
-          major = 0;
-          minor = 0;
-          patch = 0;
         }
 
         Version(const std::string& version)
+            : Version(version.c_str())
         {
-            if (version.empty() ||
-                std::sscanf(version.c_str(), "%d.%d.%d", &major, &minor, &patch) != 3) {
-                major = 0;
-                minor = 0;
-                patch = 0;
-            }
         }
 
-        Version(const char *version)
+        // parses like sscanf(version, "%d.%d.%d"), but can be evaluated at
+        // compile time for literals
+        constexpr Version(const char *version)
+            : major(0), minor(0), patch(0)
         {
-            if (!version ||
-                std::sscanf(version, "%d.%d.%d", &major, &minor, &patch) != 3) {
-                major = 0;
-                minor = 0;
-                patch = 0;
+            int v[3] = {0, 0, 0};
+            if (version && parseNumber(version, v[0]) && *version++ == '.'
+                    && parseNumber(version, v[1]) && *version++ == '.'
+                    && parseNumber(version, v[2])) {
+                major = v[0];
+                minor = v[1];
+                patch = v[2];
             }
         }
 
-        bool operator < (const Version& other) const
+        constexpr bool operator < (const Version& other) const
         {
             if (major > other.major ||
                 (major == other.major && minor > other.minor) ||
@@ -80,66 +83,66 @@ public:
             return true;
         }
 
-        bool operator < (const char* other) const
+        constexpr bool operator < (const char* other) const
         {
             return operator<(Version(other));
         }
 
-        bool operator <= (const Version &other) const
+        constexpr bool operator <= (const Version &other) const
         {
             return !operator>(other);
         }
 
-        bool operator <= (const char *other) const
+        constexpr bool operator <= (const char *other) const
         {
             return operator<=(Version(other));
         }
 
-        bool operator > (const char* other) const
+        constexpr bool operator > (const char* other) const
         {
             return operator>(Version(other));
         }
 
-        bool operator > (const Version & other) const
+        constexpr bool operator > (const Version & other) const
         {
             return !operator<(other) && !operator==(other);
         }
 
-        bool operator >= (const Version &other) const
+        constexpr bool operator >= (const Version &other) const
         {
             return !operator<(other);
         }
 
-        bool operator >= (const char *other) const
+        constexpr bool operator >= (const char *other) const
         {
             return operator>=(Version(other));
         }
 
-        bool operator == (const Version& other) const
+        constexpr bool operator == (const Version& other) const
         {
             return major == other.major
                 && minor == other.minor
                 && patch == other.patch;
         }
 
-        bool operator == (const char* other) const
+        constexpr bool operator == (const char* other) const
         {
             return operator==(Version(other));
         }
 
-        bool operator != (const Version &other) const
+        constexpr bool operator != (const Version &other) const
         {
             return !operator==(other);
         }
 
-        bool operator != (const char *other) const
+        constexpr bool operator != (const char *other) const
         {
             return operator!=(Version(other));
         }
 
         // the non-const overloads of the comparison operators are kept for
         // binary compatibility
-        bool operator < (const Version& other)
+        constexpr bool operator < (const Version& other)
         {
             if (major > other.major ||
                 (major == other.major && minor > other.minor) ||
@@ -150,59 +153,59 @@ public:
             return true;
         }
 
-        bool operator < (const char* other)
+        constexpr bool operator < (const char* other)
         {
             return operator<(Version(other));
         }
 
-        bool operator <= (const Version &other)
+        constexpr bool operator <= (const Version &other)
         {
             return !operator>(other);
         }
 
-        bool operator <= (const char *other)
+        constexpr bool operator <= (const char *other)
         {
             return operator<=(Version(other));
         }
 
-        bool operator > (const char* other)
+        constexpr bool operator > (const char* other)
         {
             return operator>(Version(other));
         }
 
-        bool operator > (const Version & other)
+        constexpr bool operator > (const Version & other)
         {
             return !operator<(other) && !operator==(other);
         }
 
-        bool operator >= (const Version &other)
+        constexpr bool operator >= (const Version &other)
         {
             return !operator<(other);
         }
 
-        bool operator >= (const char *other)
+        constexpr bool operator >= (const char *other)
         {
             return operator>=(Version(other));
         }
 
-        bool operator == (const Version& other)
+        constexpr bool operator == (const Version& other)
         {
             return major == other.major
                 && minor == other.minor
                 && patch == other.patch;
         }
 
-        bool operator == (const char* other)
+        constexpr bool operator == (const char* other)
         {
             return operator==(Version(other));
         }
 
-        bool operator != (const Version &other)
+        constexpr bool operator != (const Version &other)
         {
             return !operator==(other);
         }
 
-        bool operator != (const char *other)
+        constexpr bool operator != (const char *other)
         {
             return operator!=(Version(other));
         }
@@ -216,12 +219,36 @@ public:
             stream << ver.patch;
             return stream;
         }
+
+    private:
+        static constexpr bool parseNumber(const char *&p, int &value)
+        {
+            while (*p == ' ' || (*p >= '\t' && *p <= '\r')) {
+                ++p;
+            }
+            const bool negative = *p == '-';
+            if (*p == '-' || *p == '+') {
+                ++p;
+            }
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
+            value = 0;
+            while (*p >= '0' && *p <= '9') {
+                value = 10 * value + (*p++ - '0');
+            }
+            if (negative) {
+                value = -value;
+            }
+            return true;
+        }
     };
 
     EngineInfo();
     explicit EngineInfo(gpgme_engine_info_t engine);
 
     EngineInfo(const EngineInfo &other) = default;
+    EngineInfo(EngineInfo &&other) = default;
     const EngineInfo &operator=(EngineInfo other)
     {
         swap(other);
@@ -0,0 +1,522 @@
+/*
+  epolleventloop.cpp - a built-in event loop for managed contexts
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <epolleventloop.h>
+#include <key.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+# define GPGMEPP_HAVE_EPOLL 1
+# include <sys/epoll.h>
+# include <sys/eventfd.h>
+#endif
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__) || defined(__DragonFly__)
+# define GPGMEPP_HAVE_KQUEUE 1
+# include <sys/types.h>
+# include <sys/event.h>
+# include <sys/time.h>
+#endif
+#ifndef _WIN32
+# include <fcntl.h>
+# include <poll.h>
+# include <unistd.h>
+#endif
+
+using namespace GpgME;
+
+namespace
+{
+// the tag of a watcher encodes the file descriptor and the direction
+void *makeTag(int fd, EventLoopInteractor::Direction dir)
+{
+    return reinterpret_cast<void *>((static_cast<std::uintptr_t>(fd) << 1 | (dir == EventLoopInteractor::Write ? 1 : 0)) + 1);
+}
+
+void parseTag(void *tag, int &fd, EventLoopInteractor::Direction &dir)
+{
+    const std::uintptr_t value = reinterpret_cast<std::uintptr_t>(tag) - 1;
+    fd = static_cast<int>(value >> 1);
+    dir = (value & 1) ? EventLoopInteractor::Write : EventLoopInteractor::Read;
+}
+
+// number of events harvested with one call of epoll_wait/kevent
+constexpr int MaxEvents = 64;
+}
+
+class EpollEventLoop::Private
+{
+public:
+    struct Entry {
+        bool read;
+        bool write;
+        // distinguishes a reused file descriptor from the one an already
+        // harvested event refers to
+        std::uint32_t generation;
+    };
+
+    explicit Private(Backend b);
+    ~Private();
+
+    bool setUp();
+    bool apply(int fd, const Entry &entry, bool added, bool removed, Direction changed);
+
+    // returns the entry for fd, if it is still the one of generation
+    const Entry *find(int fd, std::uint32_t generation) const
+    {
+        const auto it = entries.find(fd);
+        return (it != entries.end() && it->second.generation == generation) ? &it->second : nullptr;
+    }
+
+    void drainWakeUp();
+    void runPosted();
+
+    Backend backend;
+    Error err;
+    int pollFd;
+    int wakeReadFd;
+    int wakeWriteFd;
+    std::unordered_map<int, Entry> entries;
+    std::uint32_t nextGeneration;
+
+    std::mutex mutex;
+    std::vector<std::function<void()>> posted;
+    std::atomic<bool> quitRequested;
+
+    OperationStartHandler startHandler;
+    NextKeyHandler nextKeyHandler;
+    OperationDoneHandler doneHandler;
+};
+
+EpollEventLoop::Private::Private(Backend b)
+    : backend(b),
+      pollFd(-1),
+      wakeReadFd(-1),
+      wakeWriteFd(-1),
+      nextGeneration(1),
+      quitRequested(false)
+{
+    if (backend == AutoBackend) {
+#if defined(GPGMEPP_HAVE_EPOLL)
+        backend = EpollBackend;
+#elif defined(GPGMEPP_HAVE_KQUEUE)
+        backend = KqueueBackend;
+#else
+        backend = PollBackend;
+#endif
+    }
+#ifndef GPGMEPP_HAVE_EPOLL
+    if (backend == EpollBackend) {
+        backend = PollBackend;
+    }
+#endif
+#ifndef GPGMEPP_HAVE_KQUEUE
+    if (backend == KqueueBackend) {
+        backend = PollBackend;
+    }
+#endif
+    if (!setUp()) {
+        err = Error::fromErrno(errno);
+    }
+}
+
+EpollEventLoop::Private::~Private()
+{
+#ifndef _WIN32
+    if (pollFd != -1) {
+        ::close(pollFd);
+    }
+    if (wakeWriteFd != -1 && wakeWriteFd != wakeReadFd) {
+        ::close(wakeWriteFd);
+    }
+    if (wakeReadFd != -1) {
+        ::close(wakeReadFd);
+    }
+#endif
+}
+
+bool EpollEventLoop::Private::setUp()
+{
+#ifdef _WIN32
+    errno = ENOSYS;
+    return false;
+#else
+#ifdef GPGMEPP_HAVE_EPOLL
+    if (backend == EpollBackend) {
+        pollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (pollFd == -1) {
+            return false;
+        }
+        wakeReadFd = wakeWriteFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wakeReadFd == -1) {
+            return false;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = static_cast<std::uint64_t>(static_cast<unsigned int>(wakeReadFd));
+        return epoll_ctl(pollFd, EPOLL_CTL_ADD, wakeReadFd, &ev) == 0;
+    }
+#endif
+    int fds[2];
+    if (::pipe(fds) == -1) {
+        return false;
+    }
+    wakeReadFd = fds[0];
+    wakeWriteFd = fds[1];
+    for (const int fd : fds) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+#ifdef GPGMEPP_HAVE_KQUEUE
+    if (backend == KqueueBackend) {
+        pollFd = kqueue();
+        if (pollFd == -1) {
+            return false;
+        }
+        struct kevent ev;
+        EV_SET(&ev, wakeReadFd, EVFILT_READ, EV_ADD, 0, 0, 0);
+        return kevent(pollFd, &ev, 1, nullptr, 0, nullptr) == 0;
+    }
+#endif
+    return true;
+#endif
+}
+
+bool EpollEventLoop::Private::apply(int fd, const Entry &entry, bool added, bool removed, Direction changed)
+{
+    (void)fd;
+    (void)entry;
+    (void)added;
+    (void)removed;
+    (void)changed;
+#ifdef GPGMEPP_HAVE_EPOLL
+    if (backend == EpollBackend) {
+        if (removed) {
+            // the file descriptor may already be closed; then the kernel
+            // has removed it already
+            epoll_ctl(pollFd, EPOLL_CTL_DEL, fd, nullptr);
+            return true;
+        }
+        epoll_event ev{};
+        ev.events = (entry.read ? static_cast<std::uint32_t>(EPOLLIN) : 0u) | (entry.write ? static_cast<std::uint32_t>(EPOLLOUT) : 0u);
+        ev.data.u64 = static_cast<std::uint64_t>(entry.generation) << 32 | static_cast<unsigned int>(fd);
+        return epoll_ctl(pollFd, added ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev) == 0;
+    }
+#endif
+#ifdef GPGMEPP_HAVE_KQUEUE
+    if (backend == KqueueBackend) {
+        const bool enable = changed == Read ? entry.read : entry.write;
+        struct kevent ev;
+        EV_SET(&ev, fd, changed == Read ? EVFILT_READ : EVFILT_WRITE, enable ? EV_ADD : EV_DELETE,
+               0, 0, reinterpret_cast<void *>(static_cast<std::uintptr_t>(entry.generation)));
+        return kevent(pollFd, &ev, 1, nullptr, 0, nullptr) == 0 || !enable;
+    }
+#endif
+    // the poll set is built from the entries in every iteration
+    return true;
+}
+
+void EpollEventLoop::Private::drainWakeUp()
+{
+#ifndef _WIN32
+    char buf[64];
+    while (::read(wakeReadFd, buf, sizeof(buf)) > 0) {
+    }
+#endif
+}
+
+void EpollEventLoop::Private::runPosted()
+{
+    std::vector<std::function<void()>> functions;
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        functions.swap(posted);
+    }
+    for (const auto &function : functions) {
+        function();
+    }
+}
+
+EpollEventLoop::EpollEventLoop(Backend backend)
+    : EventLoopInteractor(),
+      d(new Private(backend))
+{
+}
+
+EpollEventLoop::~EpollEventLoop() = default;
+
+EpollEventLoop::Backend EpollEventLoop::backend() const
+{
+    return d->backend;
+}
+
+Error EpollEventLoop::error() const
+{
+    return d->err;
+}
+
+unsigned int EpollEventLoop::watcherCount() const
+{
+    unsigned int count = 0;
+    for (const auto &entry : d->entries) {
+        count += (entry.second.read ? 1 : 0) + (entry.second.write ? 1 : 0);
+    }
+    return count;
+}
+
+void *EpollEventLoop::registerWatcher(int fd, Direction dir, bool &ok)
+{
+    ok = false;
+    if (d->err || fd < 0) {
+        return nullptr;
+    }
+    const auto it = d->entries.find(fd);
+    const bool added = it == d->entries.end();
+    Private::Entry entry = added ? Private::Entry{false, false, d->nextGeneration++} : it->second;
+    (dir == Read ? entry.read : entry.write) = true;
+    if (!d->apply(fd, entry, added, false, dir)) {
+        return nullptr;
+    }
+    d->entries[fd] = entry;
+    ok = true;
+    return makeTag(fd, dir);
+}
+
+void EpollEventLoop::unregisterWatcher(void *tag)
+{
+    int fd;
+    Direction dir;
+    parseTag(tag, fd, dir);
+    const auto it = d->entries.find(fd);
+    if (it == d->entries.end()) {
+        return;
+    }
+    Private::Entry &entry = it->second;
+    (dir == Read ? entry.read : entry.write) = false;
+    const bool removed = !entry.read && !entry.write;
+    d->apply(fd, entry, false, removed, dir);
+    if (removed) {
+        d->entries.erase(it);
+    }
+}
+
+int EpollEventLoop::processEvents(int timeout)
+{
+    if (d->err) {
+        return -1;
+    }
+    int dispatched = 0;
+#ifndef _WIN32
+#ifdef GPGMEPP_HAVE_EPOLL
+    if (d->backend == EpollBackend) {
+        epoll_event events[MaxEvents];
+        const int n = epoll_wait(d->pollFd, events, MaxEvents, timeout);
+        if (n == -1 && errno != EINTR) {
+            return -1;
+        }
+        for (int i = 0; i < n; ++i) {
+            const int fd = static_cast<int>(events[i].data.u64 & 0xffffffffu);
+            const auto generation = static_cast<std::uint32_t>(events[i].data.u64 >> 32);
+            if (generation == 0) {
+                d->drainWakeUp();
+                continue;
+            }
+            // the entry is looked up again before every dispatch because
+            // the callbacks may unregister watchers
+            const Private::Entry *entry = d->find(fd, generation);
+            if (entry && entry->read && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                actOn(fd, Read);
+                ++dispatched;
+                entry = d->find(fd, generation);
+            }
+            if (entry && entry->write && (events[i].events & (EPOLLOUT | EPOLLERR))) {
+                actOn(fd, Write);
+                ++dispatched;
+            }
+        }
+        d->runPosted();
+        return dispatched;
+    }
+#endif
+#ifdef GPGMEPP_HAVE_KQUEUE
+    if (d->backend == KqueueBackend) {
+        struct kevent events[MaxEvents];
+        struct timespec ts;
+        if (timeout >= 0) {
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = (timeout % 1000) * 1000000L;
+        }
+        const int n = kevent(d->pollFd, nullptr, 0, events, MaxEvents, timeout >= 0 ? &ts : nullptr);
+        if (n == -1 && errno != EINTR) {
+            return -1;
+        }
+        for (int i = 0; i < n; ++i) {
+            const int fd = static_cast<int>(events[i].ident);
+            if (fd == d->wakeReadFd) {
+                d->drainWakeUp();
+                continue;
+            }
+            const auto generation = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(events[i].udata));
+            const Private::Entry *const entry = d->find(fd, generation);
+            if (!entry) {
+                continue;
+            }
+            if (events[i].filter == EVFILT_READ && entry->read) {
+                actOn(fd, Read);
+                ++dispatched;
+            } else if (events[i].filter == EVFILT_WRITE && entry->write) {
+                actOn(fd, Write);
+                ++dispatched;
+            }
+        }
+        d->runPosted();
+        return dispatched;
+    }
+#endif
+    std::vector<pollfd> fds;
+    std::vector<std::uint32_t> generations;
+    fds.reserve(d->entries.size() + 1);
+    generations.reserve(d->entries.size() + 1);
+    fds.push_back({d->wakeReadFd, POLLIN, 0});
+    generations.push_back(0);
+    for (const auto &entry : d->entries) {
+        const short events = (entry.second.read ? POLLIN : 0) | (entry.second.write ? POLLOUT : 0);
+        fds.push_back({entry.first, events, 0});
+        generations.push_back(entry.second.generation);
+    }
+    const int n = ::poll(fds.data(), fds.size(), timeout);
+    if (n == -1 && errno != EINTR) {
+        return -1;
+    }
+    if (n > 0) {
+        if (fds[0].revents) {
+            d->drainWakeUp();
+        }
+        for (size_t i = 1; i < fds.size(); ++i) {
+            const short revents = fds[i].revents;
+            if (!revents) {
+                continue;
+            }
+            const int fd = fds[i].fd;
+            const Private::Entry *entry = d->find(fd, generations[i]);
+            if (entry && entry->read && (revents & (POLLIN | POLLHUP | POLLERR))) {
+                actOn(fd, Read);
+                ++dispatched;
+                entry = d->find(fd, generations[i]);
+            }
+            if (entry && entry->write && (revents & (POLLOUT | POLLERR))) {
+                actOn(fd, Write);
+                ++dispatched;
+            }
+        }
+    }
+    d->runPosted();
+#endif
+    return dispatched;
+}
+
+void EpollEventLoop::run()
+{
+    while (!d->quitRequested.exchange(false)) {
+        if (processEvents(-1) < 0) {
+            return;
+        }
+    }
+}
+
+void EpollEventLoop::quit()
+{
+    d->quitRequested = true;
+    wakeUp();
+}
+
+void EpollEventLoop::post(const std::function<void()> &function)
+{
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        d->posted.push_back(function);
+    }
+    wakeUp();
+}
+
+void EpollEventLoop::wakeUp()
+{
+#ifndef _WIN32
+    if (d->wakeWriteFd == -1) {
+        return;
+    }
+#ifdef GPGMEPP_HAVE_EPOLL
+    if (d->backend == EpollBackend) {
+        const std::uint64_t one = 1;
+        (void)::write(d->wakeWriteFd, &one, sizeof(one));
+        return;
+    }
+#endif
+    const char c = 0;
+    (void)::write(d->wakeWriteFd, &c, 1);
+#endif
+}
+
+void EpollEventLoop::setOperationStartHandler(const OperationStartHandler &handler)
+{
+    d->startHandler = handler;
+}
+
+void EpollEventLoop::setNextKeyHandler(const NextKeyHandler &handler)
+{
+    d->nextKeyHandler = handler;
+}
+
+void EpollEventLoop::setOperationDoneHandler(const OperationDoneHandler &handler)
+{
+    d->doneHandler = handler;
+}
+
+void EpollEventLoop::operationStartEvent(Context *context)
+{
+    if (d->startHandler) {
+        d->startHandler(context);
+    }
+}
+
+void EpollEventLoop::nextKeyEvent(Context *context, const Key &key)
+{
+    if (d->nextKeyHandler) {
+        d->nextKeyHandler(context, key);
+    }
+}
+
+void EpollEventLoop::operationDoneEvent(Context *context, const Error &e)
+{
+    if (d->doneHandler) {
+        d->doneHandler(context, e);
+    }
+}
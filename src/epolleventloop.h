@@ -0,0 +1,129 @@
+/*
+  epolleventloop.h - a built-in event loop for managed contexts
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_EPOLLEVENTLOOP_H__
+#define __GPGMEPP_EPOLLEVENTLOOP_H__
+
+#include "eventloopinteractor.h"
+#include "error.h"
+
+#include <functional>
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * A ready-to-use EventLoopInteractor which drives all managed contexts
+ * from the thread calling run() or processEvents().
+ *
+ * On Linux the loop uses epoll, on the BSDs and on macOS kqueue, and
+ * poll() everywhere else. The ready file descriptors are harvested in
+ * batches. A wakeup file descriptor allows other threads to post() work
+ * to the loop and to quit() it.
+ *
+ * Operations of the managed contexts must be started from the thread
+ * running the loop, e.g. by posting a function which starts them. To use
+ * several cores, create one loop per thread and distribute the contexts
+ * over the loops.
+ *
+ * The watched file descriptors are level-triggered: the gpgme IO callbacks
+ * read or write a single buffer per call, so an edge-triggered loop might
+ * never be woken up again for data which is left in a pipe.
+ */
+class GPGMEPP_EXPORT EpollEventLoop : public EventLoopInteractor
+{
+public:
+    enum Backend {
+        AutoBackend,
+        EpollBackend,
+        KqueueBackend,
+        PollBackend,
+    };
+
+    using OperationStartHandler = std::function<void(Context *context)>;
+    using NextKeyHandler = std::function<void(Context *context, const Key &key)>;
+    using OperationDoneHandler = std::function<void(Context *context, const Error &error)>;
+
+    /**
+     * Creates the loop. If @p backend is not available on this platform,
+     * then the loop falls back to poll(). Check error() to see whether the
+     * loop could be set up.
+     */
+    explicit EpollEventLoop(Backend backend = AutoBackend);
+    ~EpollEventLoop() override;
+
+    Backend backend() const;
+    Error error() const;
+
+    /** Returns the number of watched file descriptors. */
+    unsigned int watcherCount() const;
+
+    /**
+     * Waits up to @p timeout milliseconds (-1 waits forever) for activity
+     * and dispatches it, then runs the posted functions. Returns the number
+     * of dispatched file descriptor events, or -1 on error.
+     */
+    int processEvents(int timeout = -1);
+
+    /** Processes events until quit() is called. */
+    void run();
+
+    /**
+     * Makes run() return. Can be called from any thread. If the loop is
+     * not running then the next run() returns immediately.
+     */
+    void quit();
+
+    /**
+     * Queues @p function to be called by the thread running the loop and
+     * wakes up the loop. Can be called from any thread.
+     */
+    void post(const std::function<void()> &function);
+
+    /** Wakes up processEvents(). Can be called from any thread. */
+    void wakeUp();
+
+    void setOperationStartHandler(const OperationStartHandler &handler);
+    void setNextKeyHandler(const NextKeyHandler &handler);
+    void setOperationDoneHandler(const OperationDoneHandler &handler);
+
+protected:
+    void *registerWatcher(int fd, Direction dir, bool &ok) override;
+    void unregisterWatcher(void *tag) override;
+
+    void operationStartEvent(Context *context) override;
+    void nextKeyEvent(Context *context, const Key &key) override;
+    void operationDoneEvent(Context *context, const Error &e) override;
+
+private:
+    EpollEventLoop(const EpollEventLoop &) = delete;
+    EpollEventLoop &operator=(const EpollEventLoop &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_EPOLLEVENTLOOP_H__
@@ -25,10 +25,16 @@
 
 #include <gpgme.h>
 
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
+#include <type_traits>
+#include <unordered_map>
 
 using namespace GpgME;
 
+static_assert(std::is_trivially_copyable<Error>::value, "Error must be trivially copyable");
+
 static void format_error(gpgme_error_t err, std::string &str)
 {
     char buffer[ 1024 ];
@@ -37,6 +43,27 @@ static void format_error(gpgme_error_t err, std::string &str)
     str = buffer;
 }
 
+// returns the message of the code of err; the strings are never removed
+static const std::string &interned_message(gpgme_error_t err)
+{
+    static std::shared_mutex mutex;
+    static std::unordered_map<unsigned int, std::string> messages;
+
+    // the message does not depend on the source
+    const unsigned int code = gpgme_err_code(err);
+    {
+        const std::shared_lock<std::shared_mutex> lock(mutex);
+        const auto it = messages.find(code);
+        if (it != messages.end()) {
+            return it->second;
+        }
+    }
+    std::string message;
+    format_error(err, message);
+    const std::unique_lock<std::shared_mutex> lock(mutex);
+    return messages.emplace(code, std::move(message)).first->second;
+}
+
 const char *Error::source() const
 {
     return gpgme_strsource((gpgme_error_t)mErr);
@@ -44,17 +71,24 @@ const char *Error::source() const
 
 const char *Error::asString() const
 {
-    if (mMessage.empty()) {
-        format_error(static_cast<gpgme_error_t>(mErr), mMessage);
-    }
-    return mMessage.c_str();
+    return interned_message(static_cast<gpgme_error_t>(mErr)).c_str();
 }
 
 std::string Error::asStdString() const
 {
+#ifdef _WIN32
+    // the encoding of the message depends on the calling thread
     std::string message;
     format_error(static_cast<gpgme_error_t>(mErr), message);
     return message;
+#else
+    return interned_message(static_cast<gpgme_error_t>(mErr));
+#endif
+}
+
+std::string_view Error::message() const
+{
+    return interned_message(static_cast<gpgme_error_t>(mErr));
 }
 
 int Error::code() const
@@ -127,7 +161,7 @@ namespace GpgME {
 
 std::ostream &operator<<(std::ostream &os, const Error &err)
 {
-    return os << "GpgME::Error(" << err.encodedError() << " (" << err.asStdString() << "))";
+    return os << "GpgME::Error(" << err.encodedError() << " (" << err.message() << "))";
 }
 
 }
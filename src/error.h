@@ -29,6 +29,7 @@
 #include "global.h"
 
 #include <string>
+#include <string_view>
 #include <iosfwd>
 
 #include <gpg-error.h>
@@ -40,18 +41,34 @@
 namespace GpgME
 {
 
+/**
+ * An error code of gpgme.
+ *
+ * Error consists of the encoded error only, so that it is trivially
+ * copyable and as cheap to pass around as the error code itself. The
+ * messages are formatted once per error code and kept in a table shared
+ * by all threads.
+ */
 class GPGMEPP_EXPORT Error
 {
 public:
-    Error() : mErr(0), mMessage() {}
-    explicit Error(unsigned int e) : mErr(e), mMessage() {}
+    Error() : mErr(0) {}
+    explicit Error(unsigned int e) : mErr(e) {}
 
     const char *source() const;
     /* This function is deprecated. Use asStdString() instead. asString() may
      * return wrongly encoded (i.e. not UTF-8) results on Windows for the main
      * thread if the function was first called from a secondary thread. */
     GPGMEPP_DEPRECATED const char *asString() const;
+    /** Returns a copy of message(). Except on Windows, the message is the
+     * one formatted on the first use of the error code, i.e. in the locale
+     * in effect then. */
     std::string asStdString() const;
+    /** Returns the message of the error code. The message is formatted on
+     * the first call for an error code and stays valid until the program
+     * exits. Later changes of the locale do not change the message. On
+     * Windows, the same encoding caveat as for asString() applies. */
+    std::string_view message() const;
 
     int code() const;
     int sourceID() const;
@@ -82,7 +99,6 @@ public:
     }
 private:
     unsigned int mErr;
-    mutable std::string mMessage;
 };
 
 GPGMEPP_EXPORT std::ostream &operator<<(std::ostream &os, const Error &err);
@@ -34,6 +34,12 @@
 
 #include <gpgme.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 using std::vector;
 #ifndef NDEBUG
@@ -52,10 +58,7 @@ class EventLoopInteractor::Private
 {
 public:
     struct OneFD {
-        OneFD(int aFd, int aDir, gpgme_io_cb_t aFnc,
-              void *aFncData, void *aExternalTag)
-            : fd(aFd), dir(aDir), fnc(aFnc),
-              fncData(aFncData), externalTag(aExternalTag) {}
+        EventLoopInteractor *loop;
         int fd;
         int dir;
         gpgme_io_cb_t fnc;
@@ -63,7 +66,23 @@ public:
         void *externalTag;
     };
 
-    vector<OneFD *> mCallbacks;
+    // The registered callbacks live in mSlots; freed slots are reused, so
+    // registering a callback does not allocate once the deque has grown
+    // large enough. The tag handed to gpgme is the address of the slot,
+    // which stays valid when the deque grows.
+    std::deque<OneFD> mSlots;
+    vector<OneFD *> mFreeSlots;
+    // maps (fd, dir) to the slots; an fd may be registered more than once
+    // for one direction
+    std::unordered_multimap<std::uint64_t, OneFD *> mIndex;
+
+    static std::uint64_t indexKey(int fd, int dir)
+    {
+        return (static_cast<std::uint64_t>(static_cast<unsigned int>(fd)) << 1) | (dir ? 1 : 0);
+    }
+
+    OneFD *addSlot(const OneFD &fd);
+    void removeSlot(OneFD *slot);
 
     static void removeIOCb(void *tag);
     static gpgme_error_t registerIOCb(void *data, int fd, int dir,
@@ -82,65 +101,111 @@ const gpgme_io_cbs EventLoopInteractor::Private::iocbs = {
     nullptr
 };
 
+EventLoopInteractor::Private::OneFD *EventLoopInteractor::Private::addSlot(const OneFD &fd)
+{
+    OneFD *slot;
+    if (mFreeSlots.empty()) {
+        mSlots.push_back(fd);
+        slot = &mSlots.back();
+    } else {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        *slot = fd;
+    }
+    mIndex.emplace(indexKey(fd.fd, fd.dir), slot);
+    return slot;
+}
+
+void EventLoopInteractor::Private::removeSlot(OneFD *slot)
+{
+    // only this slot is removed, other registrations of the fd stay
+    const auto range = mIndex.equal_range(indexKey(slot->fd, slot->dir));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == slot) {
+            mIndex.erase(it);
+            break;
+        }
+    }
+    *slot = OneFD{nullptr, -1, 0, nullptr, nullptr, nullptr};
+    mFreeSlots.push_back(slot);
+}
+
 //
 // EventLoopInteractor::Private IO Callback Implementations
 //
 
-gpgme_error_t EventLoopInteractor::Private::registerIOCb(void *, int fd, int dir,
+// add_priv is the EventLoopInteractor managing the context
+gpgme_error_t EventLoopInteractor::Private::registerIOCb(void *data, int fd, int dir,
         gpgme_io_cb_t fnc, void *fnc_data,
         void **r_tag)
 {
-    assert(instance()); assert(instance()->d);
+    EventLoopInteractor *const loop = static_cast<EventLoopInteractor *>(data);
+    assert(loop); assert(loop->d);
     bool ok = false;
-    void *etag = instance()->registerWatcher(fd, dir ? Read : Write, ok);
+    void *etag = loop->registerWatcher(fd, dir ? Read : Write, ok);
     if (!ok) {
         return gpgme_error(GPG_ERR_GENERAL);
     }
-    instance()->d->mCallbacks.push_back(new OneFD(fd, dir, fnc, fnc_data, etag));
+    OneFD *const slot = loop->d->addSlot(OneFD{loop, fd, dir, fnc, fnc_data, etag});
     if (r_tag) {
-        *r_tag = instance()->d->mCallbacks.back();
+        *r_tag = slot;
     }
     return GPG_ERR_NO_ERROR;
 }
 
 void EventLoopInteractor::Private::removeIOCb(void *tag)
 {
-
-    if (!instance() || !instance()->d) {
+    OneFD *const slot = static_cast<OneFD *>(tag);
+    if (!slot || !slot->loop || !slot->fnc) {
         return;
     }
-    for (vector<OneFD *>::iterator it = instance()->d->mCallbacks.begin();
-            it != instance()->d->mCallbacks.end() ; ++it) {
-        if (*it == tag) {
-            instance()->unregisterWatcher((*it)->externalTag);
-            delete *it; *it = nullptr;
-            instance()->d->mCallbacks.erase(it);
-            return;
-        }
-    }
+    EventLoopInteractor *const loop = slot->loop;
+    void *const externalTag = slot->externalTag;
+    loop->d->removeSlot(slot);
+    loop->unregisterWatcher(externalTag);
 }
 
 void EventLoopInteractor::Private::eventIOCb(void *data, gpgme_event_io_t type, void *type_data)
 {
-    assert(instance());
     Context *ctx = static_cast<Context *>(data);
+    // the loop managing the context is the add_priv of its IO callbacks
+    EventLoopInteractor *loop = nullptr;
+    if (ctx && ctx->impl() && ctx->impl()->iocbs) {
+        loop = static_cast<EventLoopInteractor *>(ctx->impl()->iocbs->add_priv);
+    }
+    if (!loop) {
+        loop = instance();
+    }
+    assert(loop);
     switch (type) {
     case GPGME_EVENT_START: {
-        instance()->operationStartEvent(ctx);
+        loop->operationStartEvent(ctx);
         // TODO: what's in type_data?
     }
     break;
     case GPGME_EVENT_DONE: {
         gpgme_error_t e = *static_cast<gpgme_error_t *>(type_data);
         if (ctx && ctx->impl()) {
-            ctx->impl()->lasterr = e;
+            // maps a cancellation by the watchdog to GPG_ERR_TIMEOUT
+            e = ctx->impl()->finished(e).encodedError();
+            // moved out, so that the completion can start another
+            // asynchronous operation
+            std::function<void()> completion = std::move(ctx->impl()->completion);
+            ctx->impl()->completion = nullptr;
+            if (completion) {
+                completion();
+            }
         }
-        instance()->operationDoneEvent(ctx, Error(e));
+        loop->operationDoneEvent(ctx, Error(e));
     }
     break;
     case GPGME_EVENT_NEXT_KEY: {
         gpgme_key_t key = static_cast<gpgme_key_t>(type_data);
-        instance()->nextKeyEvent(ctx, Key(key, false));
+        const Key k(key, false);
+        if (ctx && ctx->impl() && ctx->impl()->listedKeys) {
+            ctx->impl()->listedKeys->push_back(k);
+        }
+        loop->nextKeyEvent(ctx, k);
     }
     break;
     default: // warn
@@ -154,16 +219,30 @@ void EventLoopInteractor::Private::eventIOCb(void *data, gpgme_event_io_t type,
 
 EventLoopInteractor *EventLoopInteractor::mSelf = nullptr;
 
+// guards mSelf and s_instances; loops may be created and destroyed in
+// different threads
+static std::mutex s_selfMutex;
+// the existing instances in the order of creation; mSelf is the first
+static std::vector<EventLoopInteractor *> s_instances;
+
 EventLoopInteractor::EventLoopInteractor() : d(new Private)
 {
-    assert(!mSelf);
-    mSelf = this;
+    const std::lock_guard<std::mutex> lock(s_selfMutex);
+    s_instances.push_back(this);
+    mSelf = s_instances.front();
 }
 
 EventLoopInteractor::~EventLoopInteractor()
 {
     // warn if there are still callbacks registered
-    mSelf = nullptr;
+    {
+        const std::lock_guard<std::mutex> lock(s_selfMutex);
+        const auto it = std::find(s_instances.begin(), s_instances.end(), this);
+        if (it != s_instances.end()) {
+            s_instances.erase(it);
+        }
+        mSelf = s_instances.empty() ? nullptr : s_instances.front();
+    }
     delete d;
 }
 
@@ -173,6 +252,7 @@ void EventLoopInteractor::manage(Context *context)
         return;
     }
     gpgme_io_cbs *iocbs = new gpgme_io_cbs(Private::iocbs);
+    iocbs->add_priv = this;
     iocbs->event_priv = context;
     context->installIOCallbacks(iocbs);
 }
@@ -186,13 +266,14 @@ void EventLoopInteractor::unmanage(Context *context)
 
 void EventLoopInteractor::actOn(int fd, Direction dir)
 {
-    for (vector<Private::OneFD *>::const_iterator it = d->mCallbacks.begin();
-            it != d->mCallbacks.end() ; ++it) {
-        if ((*it)->fd == fd && ((*it)->dir ? Read : Write) == dir) {
-            (*((*it)->fnc))((*it)->fncData, fd);
-            break;
-        }
+    const auto it = d->mIndex.find(Private::indexKey(fd, dir == Read ? 1 : 0));
+    if (it == d->mIndex.end()) {
+        return;
     }
+    // copy the callback; the slot may be reused by (un)registerWatcher()
+    // calls made from within the callback
+    const Private::OneFD cb = *it->second;
+    (*cb.fnc)(cb.fncData, fd);
 }
 
 } // namespace GpgME
@@ -50,13 +50,17 @@ class Key;
 
     \sect General Usage
 
-    \c EventLoopInteractor is designed to be used as a
-    singleton. However, in order to make any use of it, you have to
+    In order to make any use of \c EventLoopInteractor, you have to
     subclass it and reimplement it's pure virtual methods (see
-    below). We suggest you keep the constructor protected and
-    provide a static \c instance() method that returns the single
-    instance. Alternatively, you can create an instance on the
-    stack, e.g. in \c main().
+    below). You can create an instance on the stack, e.g. in \c
+    main().
+
+    Several instances can exist at the same time, e.g. one per
+    thread, each running its own event loop. Every \c Context is
+    managed by at most one instance, and all its IO callbacks and
+    events are delivered to that instance. The operations of a
+    managed \c Context must be driven from the thread running the
+    event loop of its instance.
 
     If you want \c EventLoopInteractor to manage a particular \c
     Context, just call \c manage() on the \c Context. OTOH, if you
@@ -115,6 +119,8 @@ protected:
 public:
     virtual ~EventLoopInteractor();
 
+    /** Returns the first created of the existing instances, or null if
+     * there is none. */
     static EventLoopInteractor *instance()
     {
         return mSelf;
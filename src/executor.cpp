@@ -0,0 +1,402 @@
+/*
+  executor.cpp - runs operations on a pool of worker threads
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <executor.h>
+#include <data.h>
+#include <decryptionresult.h>
+#include <encryptionresult.h>
+#include <importresult.h>
+#include <keylistresult.h>
+#include <signingresult.h>
+#include <verificationresult.h>
+
+#include "context_p.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+using namespace GpgME;
+
+namespace
+{
+// OpenPGP and CMS
+constexpr int ProtocolCount = 2;
+
+int protocolIndex(Protocol proto)
+{
+    switch (proto) {
+    case OpenPGP:
+        return 0;
+    case CMS:
+        return 1;
+    default:
+        return -1;
+    }
+}
+
+template <typename Result>
+Result errorResult(const Error &err)
+{
+    return Result(err);
+}
+
+template <>
+std::pair<KeyListResult, std::vector<Key>> errorResult(const Error &err)
+{
+    return {KeyListResult(err), std::vector<Key>()};
+}
+
+// submits run as operation and returns a future for its result
+template <typename Result, typename Run>
+std::future<Result> submitForResult(Executor &executor, Protocol proto, Run run)
+{
+    const auto promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    const Error err = executor.submit(proto, [promise, run](Context *ctx, const Error &e) mutable {
+        promise->set_value(ctx ? run(*ctx) : errorResult<Result>(e));
+    });
+    if (err) {
+        promise->set_value(errorResult<Result>(err));
+    }
+    return future;
+}
+}
+
+class Executor::Private
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        int protocol;
+        Operation operation;
+        Clock::time_point submitted;
+    };
+
+    struct Worker {
+        std::deque<Task> queue;
+        // only used by the worker's thread
+        std::unique_ptr<Context> contexts[ProtocolCount];
+        std::thread thread;
+    };
+
+    explicit Private(unsigned int threads)
+        : pending(0),
+          nextWorker(0),
+          stopping(false)
+    {
+        std::fill(std::begin(queued), std::end(queued), 0u);
+        std::fill(std::begin(running), std::end(running), 0u);
+        std::fill(std::begin(limits), std::end(limits), 0u);
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(threads);
+        for (unsigned int i = 0; i < threads; ++i) {
+            workers.emplace_back(new Worker);
+        }
+        for (unsigned int i = 0; i < threads; ++i) {
+            workers[i]->thread = std::thread(&Private::run, this, i);
+        }
+    }
+
+    ~Private()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (const auto &worker : workers) {
+            worker->thread.join();
+        }
+    }
+
+    bool isRunnable(int protocol) const
+    {
+        return limits[protocol] == 0 || running[protocol] < limits[protocol];
+    }
+
+    // takes a runnable task from the worker's own queue or steals one from
+    // the back of the queue of another worker; called with the mutex locked
+    bool take(unsigned int index, Task &task)
+    {
+        std::deque<Task> &own = workers[index]->queue;
+        for (auto it = own.begin(); it != own.end(); ++it) {
+            if (isRunnable(it->protocol)) {
+                task = std::move(*it);
+                own.erase(it);
+                return true;
+            }
+        }
+        for (size_t i = 1; i < workers.size(); ++i) {
+            std::deque<Task> &other = workers[(index + i) % workers.size()]->queue;
+            for (auto it = other.rbegin(); it != other.rend(); ++it) {
+                if (isRunnable(it->protocol)) {
+                    task = std::move(*it);
+                    other.erase(std::next(it).base());
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    unsigned int queuedTotal() const
+    {
+        unsigned int total = 0;
+        for (const unsigned int n : queued) {
+            total += n;
+        }
+        return total;
+    }
+
+    void execute(Worker &worker, Task &task)
+    {
+        const Protocol proto = task.protocol == 0 ? OpenPGP : CMS;
+        std::unique_ptr<Context> &ctx = worker.contexts[task.protocol];
+        Error err;
+        if (!ctx) {
+            ctx = Context::create(proto);
+            if (ctx) {
+                Configurator configure;
+                {
+                    const std::lock_guard<std::mutex> lock(mutex);
+                    configure = configurators[task.protocol];
+                }
+                if (configure) {
+                    configure(*ctx);
+                }
+            } else {
+                err = Error::fromCode(GPG_ERR_INV_ENGINE);
+            }
+        }
+        task.operation(ctx.get(), err);
+        if (ctx) {
+            ctx->impl()->resetOperationState();
+        }
+    }
+
+    void run(unsigned int index)
+    {
+        Worker &worker = *workers[index];
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            Task task;
+            if (take(index, task)) {
+                --queued[task.protocol];
+                ++running[task.protocol];
+                lock.unlock();
+
+                execute(worker, task);
+                const std::chrono::duration<double> latency = Clock::now() - task.submitted;
+                task.operation = nullptr;
+
+                lock.lock();
+                --running[task.protocol];
+                --pending;
+                ++stats.completed;
+                stats.totalLatency += latency.count();
+                stats.maximumLatency = std::max(stats.maximumLatency, latency.count());
+                if (limits[task.protocol] != 0) {
+                    // a task waiting for the limit may be runnable now
+                    wakeUp.notify_all();
+                }
+                done.notify_all();
+                continue;
+            }
+            if (stopping && queuedTotal() == 0) {
+                return;
+            }
+            wakeUp.wait(lock);
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    mutable std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::condition_variable done;
+    unsigned int queued[ProtocolCount];
+    unsigned int running[ProtocolCount];
+    unsigned int limits[ProtocolCount];
+    Configurator configurators[ProtocolCount];
+    size_t pending;
+    size_t nextWorker;
+    bool stopping;
+    Statistics stats;
+};
+
+Executor::Executor(unsigned int threads)
+    : d(new Private(threads))
+{
+}
+
+Executor::~Executor()
+{
+    waitForDone();
+}
+
+unsigned int Executor::threadCount() const
+{
+    return d->workers.size();
+}
+
+void Executor::setConfigurator(Protocol proto, const Configurator &configure)
+{
+    const int index = protocolIndex(proto);
+    if (index >= 0) {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        d->configurators[index] = configure;
+    }
+}
+
+void Executor::setConcurrencyLimit(Protocol proto, unsigned int limit)
+{
+    const int index = protocolIndex(proto);
+    if (index >= 0) {
+        {
+            const std::lock_guard<std::mutex> lock(d->mutex);
+            d->limits[index] = limit;
+        }
+        d->wakeUp.notify_all();
+    }
+}
+
+unsigned int Executor::concurrencyLimit(Protocol proto) const
+{
+    const int index = protocolIndex(proto);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return index >= 0 ? d->limits[index] : 0;
+}
+
+Error Executor::submit(Protocol proto, const Operation &operation)
+{
+    const int index = protocolIndex(proto);
+    if (index < 0) {
+        return Error::fromCode(GPG_ERR_UNSUPPORTED_PROTOCOL);
+    }
+    if (!operation) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        Private::Worker &worker = *d->workers[d->nextWorker++ % d->workers.size()];
+        worker.queue.push_back({index, operation, Private::Clock::now()});
+        ++d->queued[index];
+        ++d->pending;
+        ++d->stats.submitted;
+    }
+    d->wakeUp.notify_one();
+    return Error();
+}
+
+std::future<EncryptionResult> Executor::encrypt(Protocol proto, const std::vector<Key> &recipients, const Data &plainText,
+                                                Data &cipherText, Context::EncryptionFlags flags)
+{
+    return submitForResult<EncryptionResult>(*this, proto, [recipients, plainText, cipherText, flags](Context &ctx) mutable {
+        return ctx.encrypt(recipients, plainText, cipherText, flags);
+    });
+}
+
+std::future<DecryptionResult> Executor::decrypt(Protocol proto, const Data &cipherText, Data &plainText)
+{
+    return submitForResult<DecryptionResult>(*this, proto, [cipherText, plainText](Context &ctx) mutable {
+        return ctx.decrypt(cipherText, plainText);
+    });
+}
+
+std::future<SigningResult> Executor::sign(Protocol proto, const Data &plainText, Data &signature, SignatureMode mode)
+{
+    return submitForResult<SigningResult>(*this, proto, [plainText, signature, mode](Context &ctx) mutable {
+        return ctx.sign(plainText, signature, mode);
+    });
+}
+
+std::future<VerificationResult> Executor::verify(Protocol proto, const Data &signature, const Data &signedText)
+{
+    return submitForResult<VerificationResult>(*this, proto, [signature, signedText](Context &ctx) {
+        return ctx.verifyDetachedSignature(signature, signedText);
+    });
+}
+
+std::future<ImportResult> Executor::importKeys(Protocol proto, const Data &keyData)
+{
+    return submitForResult<ImportResult>(*this, proto, [keyData](Context &ctx) {
+        return ctx.importKeys(keyData);
+    });
+}
+
+std::future<std::pair<KeyListResult, std::vector<Key>>> Executor::listKeys(Protocol proto, const std::vector<std::string> &patterns,
+                                                                           bool secretOnly)
+{
+    using Listing = std::pair<KeyListResult, std::vector<Key>>;
+    return submitForResult<Listing>(*this, proto, [patterns, secretOnly](Context &ctx) {
+        Listing listing;
+        KeyListRange range = ctx.listKeys(patterns, 0, secretOnly);
+        for (const Key &key : range) {
+            listing.second.push_back(key);
+        }
+        listing.first = range.result();
+        return listing;
+    });
+}
+
+unsigned int Executor::queueDepth() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->queuedTotal();
+}
+
+unsigned int Executor::runningCount(Protocol proto) const
+{
+    const int index = protocolIndex(proto);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return index >= 0 ? d->running[index] : 0;
+}
+
+Executor::Statistics Executor::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
+
+void Executor::resetStatistics()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->stats = Statistics();
+}
+
+void Executor::waitForDone()
+{
+    std::unique_lock<std::mutex> lock(d->mutex);
+    d->done.wait(lock, [this]() {
+        return d->pending == 0;
+    });
+}
@@ -0,0 +1,144 @@
+/*
+  executor.h - runs operations on a pool of worker threads
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_EXECUTOR_H__
+#define __GPGMEPP_EXECUTOR_H__
+
+#include "global.h"
+#include "context.h"
+#include "error.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace GpgME
+{
+
+class Data;
+class DecryptionResult;
+class EncryptionResult;
+class ImportResult;
+class Key;
+class KeyListResult;
+class SigningResult;
+class VerificationResult;
+
+/**
+ * Runs operations on a fixed number of worker threads.
+ *
+ * Every worker owns one Context per protocol, which is created when the
+ * worker runs its first operation for that protocol and is reused for all
+ * following ones. Only the state of the last operation is reset between
+ * operations (see ContextPool).
+ *
+ * Submitted operations are queued on the workers in turn. An idle worker
+ * steals operations queued on other workers. The number of operations
+ * running at the same time can be limited per protocol.
+ *
+ * The destructor waits for all submitted operations.
+ */
+class GPGMEPP_EXPORT Executor
+{
+public:
+    /**
+     * An operation run by a worker. @p context is the worker's context for
+     * the protocol of the operation. If that context could not be created,
+     * then @p context is null and @p err is set.
+     */
+    using Operation = std::function<void(Context *context, const Error &err)>;
+    /** Called once for every context created by a worker. */
+    using Configurator = std::function<void(Context &)>;
+
+    struct Statistics {
+        unsigned long submitted = 0;
+        unsigned long completed = 0;
+        /** The time from submission to completion, in seconds. */
+        double totalLatency = 0;
+        double maximumLatency = 0;
+
+        double averageLatency() const
+        {
+            return completed ? totalLatency / completed : 0;
+        }
+    };
+
+    /** If @p threads is 0, then one worker per hardware thread is started. */
+    explicit Executor(unsigned int threads = 0);
+    ~Executor();
+
+    unsigned int threadCount() const;
+
+    /** Must be called before the first operation for @p proto is submitted. */
+    void setConfigurator(Protocol proto, const Configurator &configure);
+
+    /**
+     * Limits the number of operations for @p proto running at the same
+     * time to @p limit. 0 (the default) means no limit besides the number
+     * of workers.
+     */
+    void setConcurrencyLimit(Protocol proto, unsigned int limit);
+    unsigned int concurrencyLimit(Protocol proto) const;
+
+    /**
+     * Queues @p operation for @p proto. Returns an error if the protocol
+     * is not supported.
+     */
+    Error submit(Protocol proto, const Operation &operation);
+
+    std::future<EncryptionResult> encrypt(Protocol proto, const std::vector<Key> &recipients, const Data &plainText,
+                                          Data &cipherText, Context::EncryptionFlags flags = Context::None);
+    std::future<DecryptionResult> decrypt(Protocol proto, const Data &cipherText, Data &plainText);
+    /** The signing keys can be set with a configurator. */
+    std::future<SigningResult> sign(Protocol proto, const Data &plainText, Data &signature, SignatureMode mode);
+    /** Verifies a detached signature. */
+    std::future<VerificationResult> verify(Protocol proto, const Data &signature, const Data &signedText);
+    std::future<ImportResult> importKeys(Protocol proto, const Data &keyData);
+    std::future<std::pair<KeyListResult, std::vector<Key>>> listKeys(Protocol proto, const std::vector<std::string> &patterns,
+                                                                     bool secretOnly = false);
+
+    /** Returns the number of queued operations which are not running yet. */
+    unsigned int queueDepth() const;
+    /** Returns the number of running operations for @p proto. */
+    unsigned int runningCount(Protocol proto) const;
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+    /** Waits until all submitted operations have been completed. */
+    void waitForDone();
+
+private:
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_EXECUTOR_H__
@@ -0,0 +1,155 @@
+/*
+  fingerprint.cpp - a compact binary fingerprint
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <fingerprint.h>
+#include <key.h>
+
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+using namespace GpgME;
+
+namespace
+{
+
+constexpr unsigned char invalidNibble = 0xff;
+
+struct NibbleTable {
+    constexpr NibbleTable()
+        : values()
+    {
+        for (int c = 0; c < 256; ++c) {
+            values[c] = invalidNibble;
+        }
+        for (int c = '0'; c <= '9'; ++c) {
+            values[c] = static_cast<unsigned char>(c - '0');
+        }
+        for (int c = 'a'; c <= 'f'; ++c) {
+            values[c] = static_cast<unsigned char>(c - 'a' + 10);
+            values[c - 'a' + 'A'] = static_cast<unsigned char>(c - 'a' + 10);
+        }
+    }
+    unsigned char values[256];
+};
+
+constexpr NibbleTable nibbles;
+
+#ifdef __SSE2__
+// Decodes 16 hex digits into 8 bytes. Returns false if one of the characters
+// is not a hex digit.
+bool decode16(const char *hex, unsigned char *out)
+{
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hex));
+    const __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    const __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                          _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    const __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                           _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xffff) {
+        return false;
+    }
+    const __m128i values = _mm_or_si128(_mm_and_si128(isDigit, _mm_sub_epi8(v, _mm_set1_epi8('0'))),
+                                        _mm_andnot_si128(isDigit, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    // every 16 bit lane holds the high nibble in the low byte
+    const __m128i high = _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00ff)), 4);
+    const __m128i low = _mm_srli_epi16(values, 8);
+    const __m128i bytes = _mm_packus_epi16(_mm_or_si128(high, low), _mm_setzero_si128());
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), bytes);
+    return true;
+}
+#endif
+
+bool decode(const char *hex, size_t length, unsigned char *out)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= length; i += 16) {
+        if (!decode16(hex + i, out + i / 2)) {
+            return false;
+        }
+    }
+#endif
+    for (; i < length; i += 2) {
+        const unsigned char high = nibbles.values[static_cast<unsigned char>(hex[i])];
+        const unsigned char low = nibbles.values[static_cast<unsigned char>(hex[i + 1])];
+        if (high == invalidNibble || low == invalidNibble) {
+            return false;
+        }
+        out[i / 2] = static_cast<unsigned char>(high << 4 | low);
+    }
+    return true;
+}
+
+}
+
+Fingerprint::Fingerprint(std::string_view hex)
+{
+    if (hex.size() != 40 && hex.size() != 64) {
+        return;
+    }
+    if (decode(hex.data(), hex.size(), mBytes.data())) {
+        mSize = static_cast<unsigned char>(hex.size() / 2);
+    } else {
+        mBytes = {};
+    }
+}
+
+Fingerprint::Fingerprint(const char *hex)
+    : Fingerprint(hex ? std::string_view(hex) : std::string_view())
+{
+}
+
+Fingerprint::Fingerprint(const Key &key)
+    : Fingerprint(key.primaryFingerprint())
+{
+}
+
+Fingerprint::Fingerprint(const Subkey &subkey)
+    : Fingerprint(subkey.fingerprint())
+{
+}
+
+Fingerprint Fingerprint::fromBytes(const unsigned char *bytes, size_t size)
+{
+    Fingerprint fpr;
+    if (bytes && (size == 20 || size == 32)) {
+        std::memcpy(fpr.mBytes.data(), bytes, size);
+        fpr.mSize = static_cast<unsigned char>(size);
+    }
+    return fpr;
+}
+
+std::string Fingerprint::toString() const
+{
+    static const char digits[] = "0123456789ABCDEF";
+    std::string s(2 * mSize, '\0');
+    for (size_t i = 0; i < mSize; ++i) {
+        s[2 * i] = digits[mBytes[i] >> 4];
+        s[2 * i + 1] = digits[mBytes[i] & 0x0f];
+    }
+    return s;
+}
@@ -0,0 +1,138 @@
+/*
+  fingerprint.h - a compact binary fingerprint
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_FINGERPRINT_H__
+#define __GPGMEPP_FINGERPRINT_H__
+
+#include "global.h"
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace GpgME
+{
+
+class Key;
+class Subkey;
+
+/**
+ * A fingerprint in binary form.
+ *
+ * Holds the 20 bytes of a version 4 (or X.509 SHA-1) fingerprint or the
+ * 32 bytes of a version 5 or 6 fingerprint. Comparing two fingerprints
+ * compares a fixed block of 32 bytes, which the compiler does with two 128
+ * bit or one 256 bit comparison, instead of comparing hex strings. The
+ * type can be used as key of ordered and unordered containers.
+ */
+class GPGMEPP_EXPORT Fingerprint
+{
+public:
+    static constexpr size_t MaximumSize = 32;
+
+    constexpr Fingerprint() = default;
+    /** Parses a fingerprint in hex digit form. Results in a null fingerprint
+     * if @p hex is not a fingerprint of 40 or 64 hex digits. */
+    explicit Fingerprint(std::string_view hex);
+    explicit Fingerprint(const char *hex);
+    /** The primary fingerprint of @p key. */
+    explicit Fingerprint(const Key &key);
+    explicit Fingerprint(const Subkey &subkey);
+
+    /** Creates a fingerprint from @p size (20 or 32) raw bytes. */
+    static Fingerprint fromBytes(const unsigned char *bytes, size_t size);
+
+    constexpr bool isNull() const
+    {
+        return mSize == 0;
+    }
+
+    /** Returns the number of bytes, i.e. 0, 20 or 32. */
+    constexpr size_t size() const
+    {
+        return mSize;
+    }
+    const unsigned char *data() const
+    {
+        return mBytes.data();
+    }
+
+    /** Returns 4 for 20 byte fingerprints, 5 for 32 byte fingerprints (which
+     * are also used by version 6 keys), and 0 for null fingerprints. */
+    constexpr int version() const
+    {
+        return mSize == 20 ? 4 : mSize == 32 ? 5 : 0;
+    }
+
+    /** Returns the fingerprint in upper case hex digit form. */
+    std::string toString() const;
+
+    /** Fingerprints are cryptographic hashes, so that a part of the bytes is
+     * a good hash value. */
+    constexpr size_t hash() const
+    {
+        size_t h = mSize;
+        for (size_t i = 0; i < sizeof(size_t); ++i) {
+            h = (h << 8) ^ (h >> (8 * sizeof(size_t) - 8)) ^ mBytes[i];
+        }
+        return h;
+    }
+
+    bool operator==(const Fingerprint &other) const
+    {
+        // the unused bytes are always zero
+        return mSize == other.mSize && std::memcmp(mBytes.data(), other.mBytes.data(), MaximumSize) == 0;
+    }
+    bool operator!=(const Fingerprint &other) const
+    {
+        return !operator==(other);
+    }
+    bool operator<(const Fingerprint &other) const
+    {
+        if (mSize != other.mSize) {
+            return mSize < other.mSize;
+        }
+        return std::memcmp(mBytes.data(), other.mBytes.data(), MaximumSize) < 0;
+    }
+
+private:
+    alignas(16) std::array<unsigned char, MaximumSize> mBytes = {};
+    unsigned char mSize = 0;
+};
+
+} // namespace GpgME
+
+namespace std
+{
+template <>
+struct hash<GpgME::Fingerprint> {
+    size_t operator()(const GpgME::Fingerprint &fpr) const noexcept
+    {
+        return fpr.hash();
+    }
+};
+}
+
+#endif // __GPGMEPP_FINGERPRINT_H__
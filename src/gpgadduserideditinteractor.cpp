@@ -28,14 +28,11 @@
 
 #include "gpgadduserideditinteractor.h"
 
+#include "edittransitiontable.h"
 #include "error.h"
 
 #include <gpgme.h>
 
-#include <cstring>
-
-using std::strcmp;
-
 // avoid conflict (msvc)
 #ifdef ERROR
 # undef ERROR
@@ -115,77 +112,23 @@ const char *GpgAddUserIDEditInteractor::action(Error &err) const
 unsigned int GpgAddUserIDEditInteractor::nextState(unsigned int status, const char *args, Error &err) const
 {
 
-    static const Error GENERAL_ERROR     = Error::fromCode(GPG_ERR_GENERAL);
-    static const Error INV_NAME_ERROR    = Error::fromCode(GPG_ERR_INV_NAME);
-    static const Error INV_EMAIL_ERROR   = Error::fromCode(GPG_ERR_INV_USER_ID);
-    static const Error INV_COMMENT_ERROR = Error::fromCode(GPG_ERR_INV_USER_ID);
+    static const Error GENERAL_ERROR = Error::fromCode(GPG_ERR_GENERAL);
 
     using namespace GpgAddUserIDEditInteractor_Private;
 
-    switch (state()) {
-    case START:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return COMMAND;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case COMMAND:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.name") == 0) {
-            return NAME;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case NAME:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.email") == 0) {
-            return EMAIL;
-        }
-        err = GENERAL_ERROR;
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.name") == 0) {
-            err = INV_NAME_ERROR;
-        }
-        return ERROR;
-    case EMAIL:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.comment") == 0) {
-            return COMMENT;
-        }
-        err = GENERAL_ERROR;
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.email") == 0) {
-            err = INV_EMAIL_ERROR;
-        }
-        return ERROR;
-    case COMMENT:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        }
-        err = GENERAL_ERROR;
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.comment") == 0) {
-            err = INV_COMMENT_ERROR;
-        }
-        return ERROR;
-    case QUIT:
-        if (status == GPGME_STATUS_GET_BOOL &&
-                strcmp(args, "keyedit.save.okay") == 0) {
-            return SAVE;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case ERROR:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        }
-        err = lastError();
-        return ERROR;
-    default:
-        err = GENERAL_ERROR;
-        return ERROR;
-    }
+    static constexpr EditTransition transitions[] = {
+        {START, GPGME_STATUS_GET_LINE, "keyedit.prompt", COMMAND, GPG_ERR_NO_ERROR},
+        {COMMAND, GPGME_STATUS_GET_LINE, "keygen.name", NAME, GPG_ERR_NO_ERROR},
+        {NAME, GPGME_STATUS_GET_LINE, "keygen.email", EMAIL, GPG_ERR_NO_ERROR},
+        {NAME, GPGME_STATUS_GET_LINE, "keygen.name", ERROR, GPG_ERR_INV_NAME},
+        {EMAIL, GPGME_STATUS_GET_LINE, "keygen.comment", COMMENT, GPG_ERR_NO_ERROR},
+        {EMAIL, GPGME_STATUS_GET_LINE, "keygen.email", ERROR, GPG_ERR_INV_USER_ID},
+        {COMMENT, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
+        {COMMENT, GPGME_STATUS_GET_LINE, "keygen.comment", ERROR, GPG_ERR_INV_USER_ID},
+        {QUIT, GPGME_STATUS_GET_BOOL, "keyedit.save.okay", SAVE, GPG_ERR_NO_ERROR},
+        {ERROR, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
+    };
+    static constexpr auto table = makeEditTransitionTable(transitions);
+
+    return table.next(state(), status, args, err, state() == ERROR ? lastError() : GENERAL_ERROR);
 }
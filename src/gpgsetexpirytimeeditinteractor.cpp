@@ -27,14 +27,11 @@
 #endif
 
 #include "gpgsetexpirytimeeditinteractor.h"
+#include "edittransitiontable.h"
 #include "error.h"
 
 #include <gpgme.h>
 
-#include <cstring>
-
-using std::strcmp;
-
 // avoid conflict (msvc)
 #ifdef ERROR
 # undef ERROR
@@ -91,53 +88,20 @@ const char *GpgSetExpiryTimeEditInteractor::action(Error &err) const
 unsigned int GpgSetExpiryTimeEditInteractor::nextState(unsigned int status, const char *args, Error &err) const
 {
 
-    static const Error GENERAL_ERROR  = Error::fromCode(GPG_ERR_GENERAL);
-    static const Error INV_TIME_ERROR = Error::fromCode(GPG_ERR_INV_TIME);
+    static const Error GENERAL_ERROR = Error::fromCode(GPG_ERR_GENERAL);
 
     using namespace GpgSetExpiryTimeEditInteractor_Private;
 
-    switch (state()) {
-    case START:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return COMMAND;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case COMMAND:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keygen.valid") == 0) {
-            return DATE;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case DATE:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        } else if (status == GPGME_STATUS_GET_LINE &&
-                   strcmp(args, "keygen.valid")) {
-            err = INV_TIME_ERROR;
-            return ERROR;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case QUIT:
-        if (status == GPGME_STATUS_GET_BOOL &&
-                strcmp(args, "keyedit.save.okay") == 0) {
-            return SAVE;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case ERROR:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        }
-        err = lastError();
-        return ERROR;
-    default:
-        err = GENERAL_ERROR;
-        return ERROR;
-    }
+    static constexpr EditTransition transitions[] = {
+        {START, GPGME_STATUS_GET_LINE, "keyedit.prompt", COMMAND, GPG_ERR_NO_ERROR},
+        {COMMAND, GPGME_STATUS_GET_LINE, "keygen.valid", DATE, GPG_ERR_NO_ERROR},
+        {DATE, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
+        // gpg asks again for the date if it was not valid
+        {DATE, GPGME_STATUS_GET_LINE, "keygen.valid", ERROR, GPG_ERR_INV_TIME},
+        {QUIT, GPGME_STATUS_GET_BOOL, "keyedit.save.okay", SAVE, GPG_ERR_NO_ERROR},
+        {ERROR, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
+    };
+    static constexpr auto table = makeEditTransitionTable(transitions);
+
+    return table.next(state(), status, args, err, state() == ERROR ? lastError() : GENERAL_ERROR);
 }
@@ -38,6 +38,11 @@ public:
     explicit GpgSetExpiryTimeEditInteractor(const std::string &timeString = "0");
     ~GpgSetExpiryTimeEditInteractor();
 
+    const std::string &timeString() const
+    {
+        return m_strtime;
+    }
+
 private:
     const char *action(Error &err) const override;
     unsigned int nextState(unsigned int statusCode, const char *args, Error &err) const override;
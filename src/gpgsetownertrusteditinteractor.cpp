@@ -27,14 +27,11 @@
 #endif
 
 #include "gpgsetownertrusteditinteractor.h"
+#include "edittransitiontable.h"
 #include "error.h"
 
 #include <gpgme.h>
 
-#include <cstring>
-
-using std::strcmp;
-
 // avoid conflict (msvc)
 #ifdef ERROR
 # undef ERROR
@@ -96,58 +93,19 @@ unsigned int GpgSetOwnerTrustEditInteractor::nextState(unsigned int status, cons
 {
 
     static const Error GENERAL_ERROR = Error::fromCode(GPG_ERR_GENERAL);
-    //static const Error INV_TIME_ERROR = Error::fromCode( GPG_ERR_INV_TIME );
 
     using namespace GpgSetOwnerTrustEditInteractor_Private;
 
-    switch (state()) {
-    case START:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return COMMAND;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case COMMAND:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "edit_ownertrust.value") == 0) {
-            return VALUE;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case VALUE:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        } else if (status == GPGME_STATUS_GET_BOOL &&
-                   strcmp(args, "edit_ownertrust.set_ultimate.okay") == 0) {
-            return REALLY_ULTIMATE;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case REALLY_ULTIMATE:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case QUIT:
-        if (status == GPGME_STATUS_GET_BOOL &&
-                strcmp(args, "keyedit.save.okay") == 0) {
-            return SAVE;
-        }
-        err = GENERAL_ERROR;
-        return ERROR;
-    case ERROR:
-        if (status == GPGME_STATUS_GET_LINE &&
-                strcmp(args, "keyedit.prompt") == 0) {
-            return QUIT;
-        }
-        err = lastError();
-        return ERROR;
-    default:
-        err = GENERAL_ERROR;
-        return ERROR;
+    static constexpr EditTransition transitions[] = {
+        {START, GPGME_STATUS_GET_LINE, "keyedit.prompt", COMMAND, GPG_ERR_NO_ERROR},
+        {COMMAND, GPGME_STATUS_GET_LINE, "edit_ownertrust.value", VALUE, GPG_ERR_NO_ERROR},
+        {VALUE, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
+        {VALUE, GPGME_STATUS_GET_BOOL, "edit_ownertrust.set_ultimate.okay", REALLY_ULTIMATE, GPG_ERR_NO_ERROR},
+        {REALLY_ULTIMATE, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
+        {QUIT, GPGME_STATUS_GET_BOOL, "keyedit.save.okay", SAVE, GPG_ERR_NO_ERROR},
+        {ERROR, GPGME_STATUS_GET_LINE, "keyedit.prompt", QUIT, GPG_ERR_NO_ERROR},
     };
+    static constexpr auto table = makeEditTransitionTable(transitions);
+
+    return table.next(state(), status, args, err, state() == ERROR ? lastError() : GENERAL_ERROR);
 }
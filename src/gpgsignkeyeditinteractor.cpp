@@ -382,6 +382,26 @@ void GpgSignKeyEditInteractor::setDupeOk(bool value)
     d->dupeOk = value;
 }
 
+unsigned int GpgSignKeyEditInteractor::checkLevel() const
+{
+    return d->checkLevel;
+}
+
+const std::vector<unsigned int> &GpgSignKeyEditInteractor::userIDsToSign() const
+{
+    return d->userIDs;
+}
+
+int GpgSignKeyEditInteractor::signingOptions() const
+{
+    return d->options;
+}
+
+bool GpgSignKeyEditInteractor::dupeOk() const
+{
+    return d->dupeOk;
+}
+
 void GpgSignKeyEditInteractor::setTrustSignatureTrust(GpgME::TrustSignatureTrust trust)
 {
     assert(!d->started);
@@ -59,6 +59,11 @@ public:
      * Context::setFlag before calling edit.*/
     void setDupeOk(bool value);
 
+    unsigned int checkLevel() const;
+    const std::vector<unsigned int> &userIDsToSign() const;
+    int signingOptions() const;
+    bool dupeOk() const;
+
     void setTrustSignatureTrust(TrustSignatureTrust trust);
     void setTrustSignatureDepth(unsigned short depth);
     void setTrustSignatureScope(const std::string &scope);
@@ -0,0 +1,91 @@
+/*
+  importaccumulator.cpp - merges the results of many imports
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <importaccumulator.h>
+
+#include <mutex>
+
+using namespace GpgME;
+
+class ImportAccumulator::Private
+{
+public:
+    Private() : numResults(0) {}
+
+    mutable std::mutex mutex;
+    ImportResult merged;
+    unsigned int numResults;
+};
+
+ImportAccumulator::ImportAccumulator()
+    : d(new Private)
+{
+}
+
+ImportAccumulator::~ImportAccumulator() = default;
+
+void ImportAccumulator::add(const ImportResult &result)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    ++d->numResults;
+    if (!result.d) {
+        // a failed import without any statuses
+        if (result.error() && !d->merged.error()) {
+            d->merged.setError(result.error());
+        }
+        return;
+    }
+    if (!d->merged.d) {
+        // the merged result must not share its data with the added one,
+        // because mergeWith() changes all copies of a result
+        const Error err = d->merged.error();
+        d->merged = result.deepCopy();
+        if (err) {
+            d->merged.setError(err);
+        }
+        return;
+    }
+    d->merged.mergeWith(result);
+}
+
+unsigned int ImportAccumulator::numResults() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->numResults;
+}
+
+ImportResult ImportAccumulator::result() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->merged.deepCopy();
+}
+
+void ImportAccumulator::clear()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->merged = ImportResult();
+    d->numResults = 0;
+}
@@ -0,0 +1,73 @@
+/*
+  importaccumulator.h - merges the results of many imports
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_IMPORTACCUMULATOR_H__
+#define __GPGMEPP_IMPORTACCUMULATOR_H__
+
+#include "global.h"
+#include "importresult.h"
+
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * Merges the results of many imports, e.g. of the chunks of a large keyring
+ * imported by parallel workers, into one ImportResult.
+ *
+ * add() may be called concurrently from several threads. The results are
+ * merged with ImportResult::mergeWith() in the order in which they are
+ * added; the first error of the added results is kept.
+ *
+ * Unlike mergeWith(), the accumulator never modifies the added results or
+ * their copies.
+ */
+class GPGMEPP_EXPORT ImportAccumulator
+{
+public:
+    ImportAccumulator();
+    ~ImportAccumulator();
+
+    void add(const ImportResult &result);
+
+    /** Returns the number of results added since the last clear(). */
+    unsigned int numResults() const;
+
+    /** Returns the merged result. The returned result is not changed by
+     * later calls of add(). */
+    ImportResult result() const;
+
+    void clear();
+
+private:
+    ImportAccumulator(const ImportAccumulator &) = delete;
+    ImportAccumulator &operator=(const ImportAccumulator &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_IMPORTACCUMULATOR_H__
@@ -29,6 +29,7 @@
 
 #include <importresult.h>
 #include "result_p.h"
+#include "util.h"
 
 #include <gpgme.h>
 #include <cstdlib>
@@ -38,34 +39,138 @@
 #include <strings.h>
 #include <istream>
 #include <iterator>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
 
 class GpgME::ImportResult::Private
 {
 public:
-    Private(const _gpgme_op_import_result &r) : res(r)
+    // a deep copy of other which is indexed only when it is merged
+    Private(Private &other)
+        : res(other.res), result(nullptr), numImports(other.numImports), indexed(false)
     {
-        // copy recursively, using compiler-generated copy ctor.
-        // We just need to handle the pointers in the structs:
-        for (gpgme_import_status_t is = r.imports ; is ; is = is->next) {
-            gpgme_import_status_t copy = new _gpgme_import_status(*is);
-            if (is->fpr) {
-                copy->fpr = strdup(is->fpr);
-            }
-            copy->next = nullptr;
-            imports.push_back(copy);
+        const std::vector<gpgme_import_status_t> &src = other.importStatuses();
+        for (const gpgme_import_status_t import : src) {
+            arena.reserve<_gpgme_import_status>();
+            arena.reserveString(import->fpr);
+        }
+        imports.reserve(src.size());
+        for (const gpgme_import_status_t import : src) {
+            imports.push_back(copyImport(import));
+        }
+        std::call_once(materialized, []() {});
+    }
+
+    explicit Private(const gpgme_import_result_t r)
+        : res(*r), result(nullptr), numImports(0), indexed(false)
+    {
+        for (gpgme_import_status_t is = r->imports ; is ; is = is->next) {
+            ++numImports;
         }
         res.imports = nullptr;
+        // the import statuses are only copied when they are accessed;
+        // until then a reference to the result keeps it alive when the
+        // context is reused
+        if (numImports) {
+            gpgme_result_ref(r);
+            result = r;
+        }
     }
     ~Private()
     {
-        for (std::vector<gpgme_import_status_t>::iterator it = imports.begin() ; it != imports.end() ; ++it) {
-            std::free((*it)->fpr);
-            delete *it; *it = nullptr;
+        if (result) {
+            gpgme_result_unref(result);
+        }
+    }
+
+    std::vector<gpgme_import_status_t> &importStatuses()
+    {
+        std::call_once(materialized, [this]() {
+            if (!result) {
+                return;
+            }
+            for (gpgme_import_status_t is = result->imports ; is ; is = is->next) {
+                arena.reserve<_gpgme_import_status>();
+                arena.reserveString(is->fpr);
+            }
+            imports.reserve(numImports);
+            // copy recursively, using compiler-generated copy ctor.
+            // We just need to handle the pointers in the structs:
+            for (gpgme_import_status_t is = result->imports ; is ; is = is->next) {
+                imports.push_back(copyImport(is));
+            }
+            gpgme_result_unref(result);
+            result = nullptr;
+        });
+        return imports;
+    }
+
+    enum IndexFlags {
+        Considered = 1,
+        SecretConsidered = 2,
+        Changed = 4,
+        SecretChanged = 8,
+    };
+
+    static unsigned int indexFlags(const gpgme_import_status_t import)
+    {
+        unsigned int flags = Considered;
+        if (import->status != 0) {
+            flags |= Changed;
+        }
+        if (import->status & GPGME_IMPORT_SECRET) {
+            flags |= SecretConsidered;
+            if (import->status != GPGME_IMPORT_SECRET) {
+                flags |= SecretChanged;
+            }
         }
+        return flags;
     }
 
+    // adds the import statuses to the fingerprint index; the keys point to
+    // the fingerprints in the arena, which never move
+    static void addToIndex(std::unordered_map<std::string_view, unsigned int> &index,
+                           std::vector<gpgme_import_status_t>::const_iterator it,
+                           std::vector<gpgme_import_status_t>::const_iterator end)
+    {
+        for (; it != end; ++it) {
+            if ((*it)->fpr && *(*it)->fpr) {
+                index[(*it)->fpr] |= indexFlags(*it);
+            }
+        }
+    }
+
+    std::unordered_map<std::string_view, unsigned int> &fingerprintIndex()
+    {
+        if (!indexed) {
+            fprIndex.reserve(numImports);
+            const std::vector<gpgme_import_status_t> &statuses = importStatuses();
+            addToIndex(fprIndex, statuses.begin(), statuses.end());
+            indexed = true;
+        }
+        return fprIndex;
+    }
+
+    gpgme_import_status_t copyImport(const gpgme_import_status_t import)
+    {
+        gpgme_import_status_t copy = arena.copy(*import);
+        copy->fpr = arena.copyString(import->fpr);
+        copy->next = nullptr;
+        return copy;
+    }
+
+    // owns the copies of the import statuses and their fingerprints
+    ResultArena arena;
     _gpgme_op_import_result res;
+    // the result of gpgme until the import statuses have been copied
+    gpgme_import_result_t result;
+    unsigned int numImports;
+    std::once_flag materialized;
     std::vector<gpgme_import_status_t> imports;
+    // the flags of all imports of a fingerprint; built by the first merge
+    bool indexed;
+    std::unordered_map<std::string_view, unsigned int> fprIndex;
 };
 
 GpgME::ImportResult::ImportResult(gpgme_ctx_t ctx, int error)
@@ -89,11 +194,32 @@ void GpgME::ImportResult::init(gpgme_ctx_t ctx)
     if (!res) {
         return;
     }
-    d.reset(new Private(*res));
+    d.reset(new Private(res));
 }
 
 make_standard_stuff(ImportResult)
 
+GpgME::MemoryUsage GpgME::ImportResult::approximateMemoryUsage() const
+{
+    if (!d) {
+        return resultMemoryUsage<ImportResult>(d, 0);
+    }
+    const std::vector<gpgme_import_status_t> &imports = d->importStatuses();
+    // a node of the index holds the entry, the next pointer and the hash
+    const size_t indexBytes = d->fprIndex.bucket_count() * sizeof(void *)
+                              + d->fprIndex.size() * (sizeof(std::pair<const std::string_view, unsigned int>) + 2 * sizeof(void *));
+    return resultMemoryUsage<ImportResult>(d, d->arena.allocatedBytes() + heapBytes(imports) + indexBytes);
+}
+
+GpgME::ImportResult GpgME::ImportResult::deepCopy() const
+{
+    ImportResult copy(error());
+    if (d) {
+        copy.d.reset(new Private(*d));
+    }
+    return copy;
+}
+
 void GpgME::ImportResult::mergeWith(const ImportResult &other)
 {
     if (other.isNull()) {
@@ -141,34 +267,37 @@ void GpgME::ImportResult::mergeWith(const ImportResult &other)
     // Add the numbers of v3 keys that were skipped; may count duplicates
     d->res.skipped_v3_keys += other.d->res.skipped_v3_keys;
 
+    std::vector<gpgme_import_status_t> &imports = d->importStatuses();
+    const std::vector<gpgme_import_status_t> &otherImports = other.d->importStatuses();
+    std::unordered_map<std::string_view, unsigned int> &index = d->fingerprintIndex();
+
     // Look at the list of keys for which an import was attempted during the
-    // other import to correct some of the consolidated numbers
-    for (auto it = std::begin(other.d->imports), end = std::end(other.d->imports); it != end; ++it) {
-        const char *fpr = (*it)->fpr;
+    // other import to correct some of the consolidated numbers; the hash
+    // indexes keep this linear in the size of the other import
+    std::unordered_map<std::string_view, unsigned int> otherIndex;
+    otherIndex.reserve(otherImports.size());
+    Private::addToIndex(otherIndex, otherImports.begin(), otherImports.end());
+    std::unordered_map<std::string_view, unsigned int> seen;
+    seen.reserve(otherImports.size());
+    for (const gpgme_import_status_t import : otherImports) {
+        const char *fpr = import->fpr;
         if (!fpr || !*fpr) {
             // we cannot derive any useful information about an import if the
             // fingerprint is null or empty
             continue;
         }
+        const auto it = index.find(fpr);
         // was this key also considered during the first import
-        const auto consideredInFirstImports =
-            std::any_of(std::begin(d->imports), std::end(d->imports), [fpr](const gpgme_import_status_t i) {
-                return i->fpr && !strcmp(i->fpr, fpr);
-            });
+        const unsigned int inFirstImports = it != index.end() ? it->second : 0;
         // did we see this key already in the list of keys of the other import
-        const auto consideredInPreviousOtherImports =
-            std::any_of(std::begin(other.d->imports), it, [fpr](const gpgme_import_status_t i) {
-                return i->fpr && !strcmp(i->fpr, fpr);
-            });
+        unsigned int &inPreviousOtherImports = seen[fpr];
         // was anything added to this key during the other import
-        const auto changedInOtherImports =
-            std::any_of(std::begin(other.d->imports), std::end(other.d->imports), [fpr](const gpgme_import_status_t i) {
-                return i->fpr && !strcmp(i->fpr, fpr) && (i->status != 0);
-            });
-        if (consideredInFirstImports && !consideredInPreviousOtherImports) {
+        const unsigned int inOtherImports = otherIndex[fpr];
+
+        if ((inFirstImports & Private::Considered) && !(inPreviousOtherImports & Private::Considered)) {
             // key was also considered during first import, but not before in the list of other imports
             d->res.considered -= 1;
-            if (!changedInOtherImports) {
+            if (!(inOtherImports & Private::Changed)) {
                 // key was (most likely) counted as unchanged in the second import;
                 // this needs to be corrected (regardless of whether it was changed in the first import)
                 d->res.unchanged -= 1;
@@ -176,42 +305,31 @@ void GpgME::ImportResult::mergeWith(const ImportResult &other)
         }
 
         // now do the same for the secret key counts
-        const auto secretKeyConsideredInFirstImports =
-            std::any_of(std::begin(d->imports), std::end(d->imports), [fpr](const gpgme_import_status_t i) {
-                return i->fpr && !strcmp(i->fpr, fpr) && (i->status & GPGME_IMPORT_SECRET);
-            });
-        const auto secretKeyConsideredInPreviousOtherImports =
-            std::any_of(std::begin(other.d->imports), it, [fpr](const gpgme_import_status_t i) {
-                return i->fpr && !strcmp(i->fpr, fpr) && (i->status & GPGME_IMPORT_SECRET);
-            });
-        const auto secretKeyChangedInOtherImports =
-            std::any_of(std::begin(other.d->imports), std::end(other.d->imports), [fpr](const gpgme_import_status_t i) {
-                return i->fpr && !strcmp(i->fpr, fpr) && (i->status & GPGME_IMPORT_SECRET) && (i->status != GPGME_IMPORT_SECRET);
-            });
-        if (secretKeyConsideredInFirstImports && !secretKeyConsideredInPreviousOtherImports) {
+        if ((inFirstImports & Private::SecretConsidered) && !(inPreviousOtherImports & Private::SecretConsidered)) {
             // key was also considered during first import, but not before in the list of other imports
             d->res.secret_read -= 1;
-            if (!secretKeyChangedInOtherImports) {
+            if (!(inOtherImports & Private::SecretChanged)) {
                 // key was (most likely) counted as unchanged in the second import;
                 // this needs to be corrected (regardless of whether it was changed in the first import)
                 d->res.secret_unchanged -= 1;
             }
         }
+        inPreviousOtherImports |= Private::indexFlags(import);
     }
 
     // Now append the list of keys for which an import was attempted during the
     // other import
-    d->imports.reserve(d->imports.size() + other.d->imports.size());
-    std::transform(std::begin(other.d->imports), std::end(other.d->imports),
-                   std::back_inserter(d->imports),
-                   [](const gpgme_import_status_t import) {
-                       gpgme_import_status_t copy = new _gpgme_import_status{*import};
-                       if (import->fpr) {
-                           copy->fpr = strdup(import->fpr);
-                       }
-                       copy->next = nullptr; // should already be null, but better safe than sorry
-                       return copy;
-                   });
+    imports.reserve(imports.size() + otherImports.size());
+    d->numImports += other.d->numImports;
+    for (const gpgme_import_status_t import : otherImports) {
+        d->arena.reserve<_gpgme_import_status>();
+        d->arena.reserveString(import->fpr);
+    }
+    const size_t first = imports.size();
+    for (const gpgme_import_status_t import : otherImports) {
+        imports.push_back(d->copyImport(import));
+    }
+    Private::addToIndex(index, imports.cbegin() + first, imports.cend());
 
     // Finally, merge the error if there was none yet
     if (!bool(error())) {
@@ -294,14 +412,19 @@ GpgME::Import GpgME::ImportResult::import(unsigned int idx) const
     return Import(d, idx);
 }
 
+unsigned int GpgME::ImportResult::numImports() const
+{
+    return d ? d->numImports : 0 ;
+}
+
 std::vector<GpgME::Import> GpgME::ImportResult::imports() const
 {
     if (!d) {
         return std::vector<Import>();
     }
     std::vector<Import> result;
-    result.reserve(d->imports.size());
-    for (unsigned int i = 0 ; i < d->imports.size() ; ++i) {
+    result.reserve(d->numImports);
+    for (unsigned int i = 0 ; i < d->numImports ; ++i) {
         result.push_back(Import(d, i));
     }
     return result;
@@ -317,17 +440,22 @@ GpgME::Import::Import() : d(), idx(0) {}
 
 bool GpgME::Import::isNull() const
 {
-    return !d || idx >= d->imports.size() ;
+    return !d || idx >= d->numImports ;
 }
 
 const char *GpgME::Import::fingerprint() const
 {
-    return isNull() ? nullptr : d->imports[idx]->fpr ;
+    return isNull() ? nullptr : d->importStatuses()[idx]->fpr ;
+}
+
+std::string_view GpgME::Import::fingerprintView() const
+{
+    return to_string_view(fingerprint());
 }
 
 GpgME::Error GpgME::Import::error() const
 {
-    return Error(isNull() ? 0 : d->imports[idx]->result);
+    return Error(isNull() ? 0 : d->importStatuses()[idx]->result);
 }
 
 GpgME::Import::Status GpgME::Import::status() const
@@ -335,7 +463,7 @@ GpgME::Import::Status GpgME::Import::status() const
     if (isNull()) {
         return Unknown;
     }
-    const unsigned int s = d->imports[idx]->status;
+    const unsigned int s = d->importStatuses()[idx]->status;
     unsigned int result = Unknown;
     if (s & GPGME_IMPORT_NEW) {
         result |= NewKey;
@@ -30,6 +30,7 @@
 #include "gpgmepp_export.h"
 
 #include <memory>
+#include <string_view>
 
 #include <vector>
 
@@ -38,6 +39,7 @@ namespace GpgME
 
 class Error;
 class Import;
+class ImportAccumulator;
 
 class GPGMEPP_EXPORT ImportResult : public Result
 {
@@ -48,6 +50,7 @@ public:
     explicit ImportResult(const Error &error);
 
     ImportResult(const ImportResult &other) = default;
+    ImportResult(ImportResult &&other) = default;
     const ImportResult &operator=(ImportResult other)
     {
         swap(other);
@@ -73,6 +76,10 @@ public:
 
     bool isNull() const;
 
+    /** Returns the approximate memory used by the result. Copies the
+     * import statuses first if they have not been accessed yet. */
+    MemoryUsage approximateMemoryUsage() const;
+
     int numConsidered() const;
     int numKeysWithoutUserID() const;
     int numImported() const;
@@ -91,12 +98,18 @@ public:
     int notImported() const;
     int numV3KeysSkipped() const;
 
+    /** Returns the number of keys for which an import was attempted,
+     * i.e. the number of elements of imports(). */
+    unsigned int numImports() const;
     Import import(unsigned int idx) const;
     std::vector<Import> imports() const;
 
     class Private;
 private:
+    friend class ::GpgME::ImportAccumulator;
     void init(gpgme_ctx_t ctx);
+    // returns a copy which does not share its data with this result
+    ImportResult deepCopy() const;
     std::shared_ptr<Private> d;
 };
 
@@ -108,6 +121,7 @@ public:
     Import();
 
     Import(const Import &other) = default;
+    Import(Import &&other) = default;
     const Import &operator=(Import other)
     {
         swap(other);
@@ -124,6 +138,8 @@ public:
     bool isNull() const;
 
     const char *fingerprint() const;
+    /** Same as fingerprint() as a view, which is empty if not available. */
+    std::string_view fingerprintView() const;
     Error error() const;
 
     enum Status {
@@ -0,0 +1,123 @@
+/*
+  instrumentation.h - Interface for timing and counting context operations
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_INTERFACES_INSTRUMENTATION_H__
+#define __GPGMEPP_INTERFACES_INSTRUMENTATION_H__
+
+#include <gpgme++/gpgmepp_export.h>
+#include <gpgme++/error.h>
+#include <gpgme++/global.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace GpgME
+{
+
+class Context;
+
+/**
+ * Receives the timings and counters of the operations of a Context.
+ *
+ * An instrumentation is registered for a single context with
+ * Context::setInstrumentation() or for all contexts without an own
+ * instrumentation with Context::setGlobalInstrumentation(). If none is
+ * registered, then the operations only pay for a null pointer check.
+ *
+ * The functions are called from the thread which runs the operation, i.e.
+ * the thread calling the synchronous operation, wait() or poll(), or the
+ * thread of the event loop managing the context. An instrumentation shared
+ * by several contexts has to be thread-safe.
+ */
+class GPGMEPP_EXPORT Instrumentation
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Keep in line with Context::Private::Operation
+    enum Operation {
+        None = 0,
+        Encrypt = 0x001,
+        Decrypt = 0x002,
+        Sign = 0x004,
+        Verify = 0x008,
+        DecryptAndVerify = Decrypt | Verify,
+        SignAndEncrypt = Sign | Encrypt,
+        Import = 0x010,
+        Export = 0x020,
+        Delete = 0x040,
+        KeyGen = 0x080,
+        KeyList = 0x100,
+        KeyListWithImport = KeyList | Import,
+        Edit = 0x400,
+        CardEdit = 0x800,
+        GetAuditLog = 0x1000,
+        AssuanTransact = 0x2000,
+        Passwd = 0x4000,
+        CreateVFS = 0x10000,
+        MountVFS = 0x20000,
+    };
+
+    struct OperationStats {
+        Operation operation = None;
+        Protocol protocol = UnknownProtocol;
+        Clock::time_point start;
+        Clock::time_point end;
+        /** Time spent in Context::wait() and Context::poll(). */
+        Clock::duration engineWait = Clock::duration::zero();
+        /** Time spent creating the result object of a synchronous operation. */
+        Clock::duration resultCopy = Clock::duration::zero();
+        /** Bytes read from the input and written to the output data, as far
+         * as the position of the data tells. */
+        std::uint64_t bytesIn = 0;
+        std::uint64_t bytesOut = 0;
+        /** The number of recipients or keys passed to the operation, if any. */
+        unsigned int keys = 0;
+        /** Status lines forwarded by gpgme. */
+        unsigned int statusLines = 0;
+        /** Calls of the progress and passphrase providers. */
+        unsigned int callbacks = 0;
+        Error error;
+
+        Clock::duration duration() const
+        {
+            return end - start;
+        }
+    };
+
+    virtual ~Instrumentation() {}
+
+    /** Returns a lower-case name for @p operation, e.g. "decrypt-verify". */
+    static const char *operationName(Operation operation);
+
+    virtual void operationStarted(const Context *ctx, Operation operation, Clock::time_point start)
+    {
+        (void)ctx;
+        (void)operation;
+        (void)start;
+    }
+    virtual void operationFinished(const Context *ctx, const OperationStats &stats) = 0;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_INTERFACES_INSTRUMENTATION_H__
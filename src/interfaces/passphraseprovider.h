@@ -33,6 +33,8 @@ class PassphraseProvider
 public:
     virtual ~PassphraseProvider() {}
 
+    /* The returned passphrase is wiped and freed by the caller. It must
+       be allocated with malloc() or with SecureArena::strdup(). */
     virtual char *getPassphrase(const char *useridHint, const char *description,
                                 bool previousWasBad, bool &canceled) = 0;
 };
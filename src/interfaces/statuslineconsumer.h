@@ -0,0 +1,72 @@
+/*
+  statuslineconsumer.h - Interface for pre-parsed status callbacks
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_INTERFACES_STATUSLINECONSUMER_H__
+#define __GPGMEPP_INTERFACES_STATUSLINECONSUMER_H__
+
+#include <gpgme++/gpgmepp_export.h>
+#include <gpgme++/statusline.h>
+
+namespace GpgME
+{
+
+/**
+ * Like StatusConsumer, but gets the status lines with the keyword already
+ * mapped to the status code.
+ *
+ * The consumer subscribes to a set of status codes. Lines with other codes
+ * are dropped by the caller before status() is called.
+ */
+class GPGMEPP_EXPORT StatusLineConsumer
+{
+public:
+    explicit StatusLineConsumer(const StatusCodeSet &codes = StatusCodeSet::all())
+        : mCodes(codes)
+    {
+    }
+    virtual ~StatusLineConsumer() {}
+
+    const StatusCodeSet &statusCodes() const
+    {
+        return mCodes;
+    }
+    bool wantsStatus(unsigned int code) const
+    {
+        return mCodes.contains(code);
+    }
+
+    virtual void status(const StatusLine &line) = 0;
+
+protected:
+    void setStatusCodes(const StatusCodeSet &codes)
+    {
+        mCodes = codes;
+    }
+
+private:
+    StatusCodeSet mCodes;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_INTERFACES_STATUSLINECONSUMER_H__
@@ -0,0 +1,81 @@
+/*
+  tracer.h - Interface for tracing spans around engine operations
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_INTERFACES_TRACER_H__
+#define __GPGMEPP_INTERFACES_TRACER_H__
+
+#include <gpgme++/gpgmepp_export.h>
+#include <gpgme++/error.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * A span opened by a Tracer, e.g. an adapter for an OpenTelemetry span.
+ *
+ * Spans of context operations get the attributes "gpgme.protocol",
+ * "gpgme.operation" and, if known, "gpgme.keys" when they are started, and
+ * "gpgme.bytes_in", "gpgme.bytes_out" and "gpgme.error_code" before they
+ * are ended.
+ */
+class TraceSpan
+{
+public:
+    virtual ~TraceSpan() {}
+
+    virtual void setAttribute(const char *key, const char *value) = 0;
+    virtual void setAttribute(const char *key, std::int64_t value) = 0;
+
+    /** Called once when the traced operation has finished. The span is
+     * destroyed afterwards. */
+    virtual void end(const Error &error) = 0;
+};
+
+/**
+ * Opens the spans around context operations, Component::load() and
+ * Key::update().
+ *
+ * A tracer is registered for a single context with Context::setTracer() or
+ * for everything else with Context::setGlobalTracer(). The tracer is
+ * called from the thread which starts the operation and has to be
+ * thread-safe if it is shared.
+ */
+class Tracer
+{
+public:
+    virtual ~Tracer() {}
+
+    /**
+     * Starts a span called @p name, e.g. "gpgme.decrypt". @p parent is
+     * the span set with Context::setTraceParent() or else the current span
+     * of the thread (see TraceScope); it is nullptr if there is neither.
+     * May return nullptr to skip the span.
+     */
+    virtual std::unique_ptr<TraceSpan> startSpan(const char *name, TraceSpan *parent) = 0;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_INTERFACES_TRACER_H__
@@ -29,21 +29,117 @@
 #include "util.h"
 #include "tofuinfo.h"
 #include "context.h"
+#include "keylistresult.h"
 #include "engineinfo.h"
+#include "enginecapabilities.h"
+#include "fingerprint.h"
+#include "remarklookup.h"
+#include "tracescope.h"
 
 #include <gpgme.h>
 
 #include <string.h>
 #include <strings.h>
+#include <atomic>
 #include <cassert>
 #include <istream>
 #include <iterator>
+#include <unordered_map>
 
 const GpgME::Key::Null GpgME::Key::null;
 
 namespace GpgME
 {
 
+namespace
+{
+
+// Random access to the subkeys, user IDs and user ID signatures of a key.
+// gpgme only provides singly linked lists, so that looking up a child by
+// index is O(n), which makes index based loops quadratic.
+struct KeyIndex {
+    explicit KeyIndex(gpgme_key_t key)
+    {
+        for (gpgme_sub_key_t s = key->subkeys ; s ; s = s->next) {
+            subkeys.push_back(s);
+        }
+        for (gpgme_user_id_t u = key->uids ; u ; u = u->next) {
+            uidPositions.emplace(u, static_cast<unsigned int>(uids.size()));
+            uids.push_back(u);
+            signatureOffsets.push_back(signatures.size());
+            unsigned int i = 0;
+            for (gpgme_key_sig_t sig = u->signatures ; sig ; sig = sig->next, ++i) {
+                signaturePositions.emplace(sig, i);
+                signatures.push_back(sig);
+            }
+        }
+        signatureOffsets.push_back(signatures.size());
+    }
+
+    // returns -1 if uid does not belong to the key
+    int uidPosition(gpgme_user_id_t uid) const
+    {
+        const auto it = uidPositions.find(uid);
+        return it == uidPositions.end() ? -1 : static_cast<int>(it->second);
+    }
+
+    unsigned int numSignatures(unsigned int uidPos) const
+    {
+        return signatureOffsets[uidPos + 1] - signatureOffsets[uidPos];
+    }
+
+    std::vector<gpgme_sub_key_t> subkeys;
+    std::vector<gpgme_user_id_t> uids;
+    // the signatures of all user IDs; those of uids[i] start at signatureOffsets[i]
+    std::vector<gpgme_key_sig_t> signatures;
+    std::vector<size_t> signatureOffsets;
+    std::unordered_map<gpgme_user_id_t, unsigned int> uidPositions;
+    std::unordered_map<gpgme_key_sig_t, unsigned int> signaturePositions;
+};
+
+// The deleter of the shared_gpgme_key_t created by Key. It lives in the
+// control block of the shared pointer, so that the index built lazily on the
+// first indexed access is shared by all copies of the key and of its children.
+struct KeyDeleter {
+    KeyDeleter() = default;
+    KeyDeleter(const KeyDeleter &) : index(nullptr) {}
+    KeyDeleter &operator=(const KeyDeleter &) = delete;
+
+    void operator()(gpgme_key_t key) const
+    {
+        delete index.load(std::memory_order_acquire);
+        gpgme_key_unref(key);
+    }
+
+    mutable std::atomic<KeyIndex *> index{nullptr};
+};
+
+// Returns nullptr for null keys and for keys not created by Key's constructor.
+// If build is false, then returns nullptr if the index has not been built yet.
+const KeyIndex *key_index(const shared_gpgme_key_t &key, bool build = true)
+{
+    if (!key) {
+        return nullptr;
+    }
+    const KeyDeleter *const deleter = std::get_deleter<KeyDeleter>(key);
+    if (!deleter) {
+        return nullptr;
+    }
+    KeyIndex *index = deleter->index.load(std::memory_order_acquire);
+    if (!index && build) {
+        KeyIndex *const fresh = new KeyIndex(key.get());
+        if (deleter->index.compare_exchange_strong(index, fresh, std::memory_order_acq_rel)) {
+            index = fresh;
+        } else {
+            // another thread was faster
+            delete fresh;
+        }
+    }
+    return index;
+}
+
+}
+
 Key::Key() : key() {}
 
 Key::Key(const Null &) : key() {}
@@ -52,7 +148,7 @@ Key::Key(const shared_gpgme_key_t &k) : key(k) {}
 
 Key::Key(gpgme_key_t k, bool ref)
     : key(k
-          ? shared_gpgme_key_t(k, &gpgme_key_unref)
+          ? shared_gpgme_key_t(k, KeyDeleter())
           : shared_gpgme_key_t())
 {
     if (ref && impl()) {
@@ -75,6 +171,9 @@ unsigned int Key::numUserIDs() const
     if (!key) {
         return 0;
     }
+    if (const KeyIndex *const index = key_index(key)) {
+        return index->uids.size();
+    }
     unsigned int count = 0;
     for (gpgme_user_id_t uid = key->uids ; uid ; uid = uid->next) {
         ++count;
@@ -87,6 +186,9 @@ unsigned int Key::numSubkeys() const
     if (!key) {
         return 0;
     }
+    if (const KeyIndex *const index = key_index(key)) {
+        return index->subkeys.size();
+    }
     unsigned int count = 0;
     for (gpgme_sub_key_t subkey = key->subkeys ; subkey ; subkey = subkey->next) {
         ++count;
@@ -153,6 +255,21 @@ std::vector<RevocationKey> Key::revocationKeys() const
     return v;
 }
 
+ChildRange<UserID> Key::userIDRange() const
+{
+    return ChildRange<UserID>(key && key->uids ? UserID(key, key->uids) : UserID());
+}
+
+ChildRange<Subkey> Key::subkeyRange() const
+{
+    return ChildRange<Subkey>(key && key->subkeys ? Subkey(key, key->subkeys) : Subkey());
+}
+
+ChildRange<RevocationKey> Key::revocationKeyRange() const
+{
+    return ChildRange<RevocationKey>(key && key->revocation_keys ? RevocationKey(key, key->revocation_keys) : RevocationKey());
+}
+
 Key::OwnerTrust Key::ownerTrust() const
 {
     if (!key) {
@@ -350,11 +467,82 @@ const char *Key::primaryFingerprint() const
     return nullptr;
 }
 
+std::string_view Key::issuerSerialView() const
+{
+    return to_string_view(issuerSerial());
+}
+
+std::string_view Key::issuerNameView() const
+{
+    return to_string_view(issuerName());
+}
+
+std::string_view Key::chainIDView() const
+{
+    return to_string_view(chainID());
+}
+
+std::string_view Key::keyIDView() const
+{
+    return to_string_view(keyID());
+}
+
+std::string_view Key::shortKeyIDView() const
+{
+    return to_string_view(shortKeyID());
+}
+
+std::string_view Key::primaryFingerprintView() const
+{
+    return to_string_view(primaryFingerprint());
+}
+
 unsigned int Key::keyListMode() const
 {
     return key ? convert_from_gpgme_keylist_mode_t(key->keylist_mode) : 0;
 }
 
+// Merges the flags of him into me. The subkeys are matched by fingerprint
+// with a hash lookup.
+static void merge_key_flags(gpgme_key_t me, gpgme_key_t him)
+{
+    me->revoked          |= him->revoked;
+    me->expired          |= him->expired;
+    me->disabled         |= him->disabled;
+    me->invalid          |= him->invalid;
+    me->can_encrypt      |= him->can_encrypt;
+    me->can_sign         |= him->can_sign;
+    me->can_certify      |= him->can_certify;
+    me->secret           |= him->secret;
+    me->can_authenticate |= him->can_authenticate;
+    me->is_qualified     |= him->is_qualified;
+    me->keylist_mode     |= him->keylist_mode;
+
+    std::unordered_map<std::string_view, gpgme_sub_key_t> hisSubkeys;
+    for (gpgme_sub_key_t hissk = him->subkeys ; hissk ; hissk = hissk->next) {
+        if (hissk->fpr) {
+            hisSubkeys.emplace(hissk->fpr, hissk);
+        }
+    }
+
+    // make sure the gpgme_sub_key_t::is_cardkey flag isn't lost:
+    for (gpgme_sub_key_t mysk = me->subkeys ; mysk ; mysk = mysk->next) {
+        if (!mysk->fpr) {
+            continue;
+        }
+        const auto it = hisSubkeys.find(mysk->fpr);
+        if (it == hisSubkeys.end()) {
+            continue;
+        }
+        const gpgme_sub_key_t hissk = it->second;
+        mysk->is_cardkey |= hissk->is_cardkey;
+        mysk->secret |= hissk->secret;
+        if (hissk->keygrip && !mysk->keygrip) {
+            mysk->keygrip = strdup(hissk->keygrip);
+        }
+    }
+}
+
 const Key &Key::mergeWith(const Key &other)
 {
     // ### incomplete. Just merges has* and can*, nothing else atm
@@ -373,33 +561,58 @@ const Key &Key::mergeWith(const Key &other)
         return *this;
     }
 
-    me->revoked          |= him->revoked;
-    me->expired          |= him->expired;
-    me->disabled         |= him->disabled;
-    me->invalid          |= him->invalid;
-    me->can_encrypt      |= him->can_encrypt;
-    me->can_sign         |= him->can_sign;
-    me->can_certify      |= him->can_certify;
-    me->secret           |= him->secret;
-    me->can_authenticate |= him->can_authenticate;
-    me->is_qualified     |= him->is_qualified;
-    me->keylist_mode     |= him->keylist_mode;
+    merge_key_flags(me, him);
 
-    // make sure the gpgme_sub_key_t::is_cardkey flag isn't lost:
-    for (gpgme_sub_key_t mysk = me->subkeys ; mysk ; mysk = mysk->next) {
-        for (gpgme_sub_key_t hissk = him->subkeys ; hissk ; hissk = hissk->next) {
-            if (strcmp(mysk->fpr, hissk->fpr) == 0) {
-                mysk->is_cardkey |= hissk->is_cardkey;
-                mysk->secret |= hissk->secret;
-                if (hissk->keygrip && !mysk->keygrip) {
-                    mysk->keygrip = strdup(hissk->keygrip);
-                }
-                break;
-            }
+    return *this;
+}
+
+// The amount of user ID and signature data of a key; used to pick the key
+// with more details when merging two listings of the same key.
+static std::pair<size_t, size_t> key_details(gpgme_key_t key)
+{
+    size_t uids = 0;
+    size_t sigs = 0;
+    for (gpgme_user_id_t uid = key->uids ; uid ; uid = uid->next) {
+        ++uids;
+        for (gpgme_key_sig_t sig = uid->signatures ; sig ; sig = sig->next) {
+            ++sigs;
         }
     }
+    return {uids, sigs};
+}
 
-    return *this;
+void mergeKeyLists(std::vector<Key> &local, const std::vector<Key> &remote)
+{
+    std::unordered_map<Fingerprint, size_t> localIndex;
+    localIndex.reserve(local.size());
+    for (size_t i = 0; i < local.size(); ++i) {
+        const Fingerprint fpr(local[i]);
+        if (!fpr.isNull()) {
+            localIndex.emplace(fpr, i);
+        }
+    }
+
+    for (const Key &key : remote) {
+        const Fingerprint fpr(key);
+        if (fpr.isNull()) {
+            continue;
+        }
+        const auto it = localIndex.find(fpr);
+        if (it == localIndex.end()) {
+            localIndex.emplace(fpr, local.size());
+            local.push_back(key);
+            continue;
+        }
+        Key &mine = local[it->second];
+        if (key_details(key.impl()) > key_details(mine.impl())) {
+            // keep the user IDs and signatures of the more detailed listing
+            Key richer = key;
+            merge_key_flags(richer.impl(), mine.impl());
+            mine = richer;
+        } else {
+            merge_key_flags(mine.impl(), key.impl());
+        }
+    }
 }
 
 void Key::update()
@@ -407,20 +620,17 @@ void Key::update()
     if (isNull() || !primaryFingerprint()) {
         return;
     }
+    // the key listings below are children of this span
+    TraceScope scope("gpgme.key_update");
     auto ctx = Context::createForProtocol(protocol());
     if (!ctx) {
         return;
     }
-    ctx->setKeyListMode(KeyListMode::Local |
-                        KeyListMode::Signatures |
-                        KeyListMode::SignatureNotations |
-                        KeyListMode::Validate |
-                        KeyListMode::WithTofu |
-                        KeyListMode::WithKeygrip |
-                        KeyListMode::WithSecret);
+    ctx->setKeyListMode(KeyListOptions<Local, Signatures, SignatureNotations, Validate,
+                                       WithTofu, WithKeygrip, WithSecret>());
     Error err;
     Key newKey;
-    if (GpgME::engineInfo(GpgME::GpgEngine).engineVersion() < "2.1.0") {
+    if (!EngineCapabilities::get(GpgEngine).hasFeature(EngineCapabilities::CombinedSecretKeyListing)) {
         newKey = ctx->key(primaryFingerprint(), err, true);
         // Not secret so we get the information from the pubring.
         if (newKey.isNull()) {
@@ -431,11 +641,116 @@ void Key::update()
     }
     delete ctx;
     if (err) {
+        scope.setError(err);
         return;
     }
     swap(newKey);
 }
 
+// The number of fingerprints listed by one key listing. Bounds the length
+// of the command line of the engine.
+static const size_t updateAllBatchSize = 500;
+
+// Lists the keys with the given indexes and replaces them with the listed
+// keys. Appends the indexes of the keys which were not listed to notFound.
+static Error update_keys(Context *ctx, std::vector<Key> &keys, const std::vector<size_t> &indexes,
+                         bool secretOnly, std::vector<size_t> &notFound)
+{
+    Error firstError;
+    for (size_t start = 0; start < indexes.size(); start += updateAllBatchSize) {
+        const size_t end = std::min(indexes.size(), start + updateAllBatchSize);
+
+        std::unordered_map<Fingerprint, std::vector<size_t>> byFingerprint;
+        std::vector<const char *> patterns;
+        patterns.reserve(end - start + 1);
+        for (size_t i = start; i < end; ++i) {
+            const char *const fpr = keys[indexes[i]].primaryFingerprint();
+            auto &matches = byFingerprint[Fingerprint(fpr)];
+            if (matches.empty()) {
+                patterns.push_back(fpr);
+            }
+            matches.push_back(indexes[i]);
+        }
+        patterns.push_back(nullptr);
+
+        Error err = ctx->startKeyListing(patterns.data(), secretOnly);
+        while (!err) {
+            const Key newKey = ctx->nextKey(err);
+            if (err) {
+                continue;
+            }
+            const auto it = byFingerprint.find(Fingerprint(newKey));
+            if (it == byFingerprint.end()) {
+                continue;
+            }
+            for (const size_t idx : it->second) {
+                keys[idx] = newKey;
+            }
+            byFingerprint.erase(it);
+        }
+        ctx->endKeyListing();
+        if (err.code() != GPG_ERR_EOF && !firstError) {
+            firstError = err;
+        }
+
+        for (const auto &unlisted : byFingerprint) {
+            notFound.insert(notFound.end(), unlisted.second.begin(), unlisted.second.end());
+        }
+    }
+    return firstError;
+}
+
+// static
+Error Key::updateAll(std::vector<Key> &keys)
+{
+    std::vector<size_t> openpgp;
+    std::vector<size_t> cms;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const Key &key = keys[i];
+        if (Fingerprint(key).isNull()) {
+            continue;
+        }
+        (key.protocol() == CMS ? cms : openpgp).push_back(i);
+    }
+
+    Error firstError;
+    for (const Protocol proto : {OpenPGP, CMS}) {
+        const std::vector<size_t> &indexes = proto == CMS ? cms : openpgp;
+        if (indexes.empty()) {
+            continue;
+        }
+        const std::unique_ptr<Context> ctx(Context::createForProtocol(proto));
+        if (!ctx) {
+            continue;
+        }
+        ctx->setKeyListMode(KeyListMode::Local |
+                            KeyListMode::Signatures |
+                            KeyListMode::SignatureNotations |
+                            KeyListMode::Validate |
+                            KeyListMode::WithTofu |
+                            KeyListMode::WithKeygrip |
+                            KeyListMode::WithSecret);
+        std::vector<size_t> notFound;
+        Error err;
+        if (!EngineCapabilities::get(GpgEngine).hasFeature(EngineCapabilities::CombinedSecretKeyListing)) {
+            // as in update(), prefer the information from the secret keyring
+            err = update_keys(ctx.get(), keys, indexes, true, notFound);
+            const std::vector<size_t> pub = std::move(notFound);
+            notFound.clear();
+            const Error e = update_keys(ctx.get(), keys, pub, false, notFound);
+            if (!err) {
+                err = e;
+            }
+        } else {
+            err = update_keys(ctx.get(), keys, indexes, false, notFound);
+        }
+        if (err && !firstError) {
+            firstError = err;
+        }
+    }
+    return firstError;
+}
+
 // static
 Key Key::locate(const char *mbox)
 {
@@ -465,6 +780,9 @@ Key Key::locate(const char *mbox)
 
 static gpgme_sub_key_t find_subkey(const shared_gpgme_key_t &key, unsigned int idx)
 {
+    if (const KeyIndex *const index = key_index(key)) {
+        return idx < index->subkeys.size() ? index->subkeys[idx] : nullptr;
+    }
     if (key) {
         for (gpgme_sub_key_t s = key->subkeys ; s ; s = s->next, --idx) {
             if (idx == 0) {
@@ -619,6 +937,26 @@ std::vector<std::string_view> Subkey::keyGrips() const
     return _gpgmepp::split_into_string_views(subkey->keygrip, ',');
 }
 
+std::string_view Subkey::keyIDView() const
+{
+    return to_string_view(keyID());
+}
+
+std::string_view Subkey::fingerprintView() const
+{
+    return to_string_view(fingerprint());
+}
+
+std::string_view Subkey::cardSerialNumberView() const
+{
+    return to_string_view(cardSerialNumber());
+}
+
+std::string_view Subkey::keyGripView() const
+{
+    return to_string_view(keyGrip());
+}
+
 bool Subkey::isSecret() const
 {
     return subkey && subkey->secret;
@@ -672,6 +1010,9 @@ bool Subkey::isDisabled() const
 
 static gpgme_user_id_t find_uid(const shared_gpgme_key_t &key, unsigned int idx)
 {
+    if (const KeyIndex *const index = key_index(key)) {
+        return idx < index->uids.size() ? index->uids[idx] : nullptr;
+    }
     if (key) {
         for (gpgme_user_id_t u = key->uids ; u ; u = u->next, --idx) {
             if (idx == 0) {
@@ -684,6 +1025,9 @@ static gpgme_user_id_t find_uid(const shared_gpgme_key_t &key, unsigned int idx)
 
 static gpgme_user_id_t verify_uid(const shared_gpgme_key_t &key, gpgme_user_id_t uid)
 {
+    if (const KeyIndex *const index = key_index(key, false)) {
+        return index->uidPosition(uid) >= 0 ? uid : nullptr;
+    }
     if (key) {
         for (gpgme_user_id_t u = key->uids ; u ; u = u->next) {
             if (u == uid) {
@@ -723,6 +1067,9 @@ unsigned int UserID::numSignatures() const
     if (!uid) {
         return 0;
     }
+    if (const KeyIndex *const index = key_index(key)) {
+        return index->numSignatures(index->uidPosition(uid));
+    }
     unsigned int count = 0;
     for (gpgme_key_sig_t sig = uid->signatures ; sig ; sig = sig->next) {
         ++count;
@@ -744,6 +1091,11 @@ std::vector<UserID::Signature> UserID::signatures() const
     return v;
 }
 
+ChildRange<UserID::Signature> UserID::signatureRange() const
+{
+    return ChildRange<Signature>(uid && uid->signatures ? Signature(key, uid, uid->signatures) : Signature());
+}
+
 const char *UserID::id() const
 {
     return uid ? uid->uid : nullptr ;
@@ -769,6 +1121,31 @@ const char *UserID::uidhash() const
     return uid ? uid->uidhash : nullptr ;
 }
 
+std::string_view UserID::idView() const
+{
+    return to_string_view(id());
+}
+
+std::string_view UserID::nameView() const
+{
+    return to_string_view(name());
+}
+
+std::string_view UserID::emailView() const
+{
+    return to_string_view(email());
+}
+
+std::string_view UserID::commentView() const
+{
+    return to_string_view(comment());
+}
+
+std::string_view UserID::uidhashView() const
+{
+    return to_string_view(uidhash());
+}
+
 UserID::Validity UserID::validity() const
 {
     if (!uid) {
@@ -875,18 +1252,12 @@ const char *UserID::remark(const Key &remarker, Error &err) const
 
 std::vector<std::string> UserID::remarks(std::vector<Key> keys, Error &err) const
 {
-    std::vector<std::string> ret;
+    return RemarkLookup(keys).remarks(*this, err);
+}
 
-    for (const auto &key: keys) {
-        const char *rem = remark(key, err);
-        if (err) {
-            return ret;
-        }
-        if (rem) {
-            ret.push_back(rem);
-        }
-    }
-    return ret;
+std::vector<std::string_view> UserID::remarkViews(const std::vector<Key> &keys, Error &err) const
+{
+    return RemarkLookup(keys).remarkViews(*this, err);
 }
 
 //
@@ -895,52 +1266,74 @@ std::vector<std::string> UserID::remarks(std::vector<Key> keys, Error &err) cons
 //
 //
 
-static gpgme_key_sig_t find_signature(gpgme_user_id_t uid, unsigned int idx)
+static gpgme_key_sig_t find_signature(const shared_gpgme_key_t &key, gpgme_user_id_t uid, unsigned int idx)
 {
-    if (uid) {
-        for (gpgme_key_sig_t s = uid->signatures ; s ; s = s->next, --idx) {
-            if (idx == 0) {
-                return s;
-            }
+    if (!uid) {
+        return nullptr;
+    }
+    if (const KeyIndex *const index = key_index(key)) {
+        const unsigned int pos = index->uidPosition(uid);
+        return idx < index->numSignatures(pos) ? index->signatures[index->signatureOffsets[pos] + idx] : nullptr;
+    }
+    for (gpgme_key_sig_t s = uid->signatures ; s ; s = s->next, --idx) {
+        if (idx == 0) {
+            return s;
         }
     }
     return nullptr;
 }
 
-static gpgme_key_sig_t verify_signature(gpgme_user_id_t uid, gpgme_key_sig_t sig)
+static int signature_index(const shared_gpgme_key_t &key, gpgme_user_id_t uid, gpgme_key_sig_t sig)
 {
-    if (uid) {
-        for (gpgme_key_sig_t s = uid->signatures ; s ; s = s->next) {
-            if (s == sig) {
-                return sig;
-            }
+    if (!uid) {
+        return -1;
+    }
+    if (const KeyIndex *const index = key_index(key)) {
+        const auto it = index->signaturePositions.find(sig);
+        if (it == index->signaturePositions.end()) {
+            return -1;
+        }
+        // check that the signature belongs to the user ID
+        const unsigned int pos = index->uidPosition(uid);
+        if (it->second >= index->numSignatures(pos)
+                || index->signatures[index->signatureOffsets[pos] + it->second] != sig) {
+            return -1;
         }
+        return it->second;
     }
-    return nullptr;
+    int i = 0;
+    for (gpgme_key_sig_t s = uid->signatures ; s ; s = s->next, ++i) {
+        if (s == sig) {
+            return i;
+        }
+    }
+    return -1;
 }
 
-static int signature_index(gpgme_user_id_t uid, gpgme_key_sig_t sig)
+static gpgme_key_sig_t verify_signature(const shared_gpgme_key_t &key, gpgme_user_id_t uid, gpgme_key_sig_t sig)
 {
+    if (key_index(key, false)) {
+        return signature_index(key, uid, sig) >= 0 ? sig : nullptr;
+    }
     if (uid) {
-        int i = 0;
-        for (gpgme_key_sig_t s = uid->signatures ; s ; s = s->next, ++i) {
+        for (gpgme_key_sig_t s = uid->signatures ; s ; s = s->next) {
             if (s == sig) {
-                return i;
+                return sig;
             }
         }
     }
-    return -1;
+    return nullptr;
 }
 
 UserID::Signature::Signature() : key(), uid(nullptr), sig(nullptr) {}
 
 UserID::Signature::Signature(const shared_gpgme_key_t &k, gpgme_user_id_t u, unsigned int idx)
-    : key(k), uid(verify_uid(k, u)), sig(find_signature(uid, idx))
+    : key(k), uid(verify_uid(k, u)), sig(find_signature(k, uid, idx))
 {
 }
 
 UserID::Signature::Signature(const shared_gpgme_key_t &k, gpgme_user_id_t u, gpgme_key_sig_t s)
-    : key(k), uid(verify_uid(k, u)), sig(verify_signature(uid, s))
+    : key(k), uid(verify_uid(k, u)), sig(verify_signature(k, uid, s))
 {
 }
 
@@ -988,7 +1381,7 @@ bool UserID::Signature::operator<(const Signature &other) const
     }
 
     // to make the sort stable we compare the indexes of the signatures as last resort
-    return signature_index(uid, sig) < signature_index(uid, other.sig);
+    return signature_index(key, uid, sig) < signature_index(key, uid, other.sig);
 }
 
 UserID UserID::Signature::parent() const
@@ -1179,6 +1572,41 @@ const char *UserID::Signature::trustScope() const
     return sig ? sig->trust_scope : nullptr;
 }
 
+std::string_view UserID::Signature::signerKeyIDView() const
+{
+    return to_string_view(signerKeyID());
+}
+
+std::string_view UserID::Signature::signerUserIDView() const
+{
+    return to_string_view(signerUserID());
+}
+
+std::string_view UserID::Signature::signerNameView() const
+{
+    return to_string_view(signerName());
+}
+
+std::string_view UserID::Signature::signerEmailView() const
+{
+    return to_string_view(signerEmail());
+}
+
+std::string_view UserID::Signature::signerCommentView() const
+{
+    return to_string_view(signerComment());
+}
+
+std::string_view UserID::Signature::policyURLView() const
+{
+    return to_string_view(policyURL());
+}
+
+std::string_view UserID::Signature::trustScopeView() const
+{
+    return to_string_view(trustScope());
+}
+
 std::string UserID::addrSpecFromString(const char *userid)
 {
     if (!userid) {
@@ -1202,6 +1630,11 @@ std::string UserID::addrSpec() const
     return uid->address;
 }
 
+std::string_view UserID::addrSpecView() const
+{
+    return uid ? to_string_view(uid->address) : std::string_view();
+}
+
 Error UserID::revoke()
 {
     if (isNull()) {
@@ -1279,6 +1712,106 @@ time_t Key::lastUpdate() const
     return static_cast<time_t>(key ? key->last_update : 0);
 }
 
+static size_t stringSize(const char *str)
+{
+    return str ? strlen(str) + 1 : 0;
+}
+
+// the bytes of the key structure of gpgme and of everything it points to;
+// keyid points to _keyid and is not counted
+static size_t gpgmeKeySize(gpgme_key_t key)
+{
+    size_t size = sizeof(*key)
+                  + stringSize(key->issuer_serial)
+                  + stringSize(key->issuer_name)
+                  + stringSize(key->chain_id)
+                  + stringSize(key->fpr);
+    for (gpgme_sub_key_t subkey = key->subkeys; subkey; subkey = subkey->next) {
+        size += sizeof(*subkey)
+                + stringSize(subkey->fpr)
+                + stringSize(subkey->card_number)
+                + stringSize(subkey->curve)
+                + stringSize(subkey->keygrip);
+    }
+    for (gpgme_user_id_t uid = key->uids; uid; uid = uid->next) {
+        size += sizeof(*uid)
+                + stringSize(uid->uid)
+                + stringSize(uid->name)
+                + stringSize(uid->email)
+                + stringSize(uid->comment)
+                + stringSize(uid->address)
+                + stringSize(uid->uidhash);
+        for (gpgme_tofu_info_t tofu = uid->tofu; tofu; tofu = tofu->next) {
+            size += sizeof(*tofu) + stringSize(tofu->description);
+        }
+        for (gpgme_key_sig_t sig = uid->signatures; sig; sig = sig->next) {
+            size += sizeof(*sig)
+                    + stringSize(sig->uid)
+                    + stringSize(sig->name)
+                    + stringSize(sig->email)
+                    + stringSize(sig->comment)
+                    + stringSize(sig->trust_scope);
+            for (gpgme_sig_notation_t nota = sig->notations; nota; nota = nota->next) {
+                size += sizeof(*nota) + stringSize(nota->name) + stringSize(nota->value);
+            }
+        }
+    }
+    for (gpgme_revocation_key_t revkey = key->revocation_keys; revkey; revkey = revkey->next) {
+        size += sizeof(*revkey) + stringSize(revkey->fpr);
+    }
+    return size;
+}
+
+// roughly the control block of a shared_gpgme_key_t with its deleter
+static const size_t sharedKeyControlBlockSize = 4 * sizeof(void *);
+
+MemoryUsage Key::approximateMemoryUsage() const
+{
+    MemoryUsage usage;
+    usage.exclusive = usage.proportional = sizeof(Key);
+    if (key) {
+        usage += MemoryUsage::owned(gpgmeKeySize(key.get()) + sharedKeyControlBlockSize, key.use_count());
+    }
+    return usage;
+}
+
+// static
+MemoryUsage Key::approximateMemoryUsage(const std::vector<Key> &keys)
+{
+    MemoryUsage usage;
+    usage.exclusive = usage.proportional = keys.capacity() * sizeof(Key);
+    // the number of references to every key from within keys
+    std::unordered_map<gpgme_key_t, long> references;
+    references.reserve(keys.size());
+    for (const Key &k : keys) {
+        if (k.key) {
+            ++references[k.key.get()];
+        }
+    }
+    for (const Key &k : keys) {
+        if (!k.key) {
+            continue;
+        }
+        const auto it = references.find(k.key.get());
+        if (it == references.end()) {
+            continue;
+        }
+        const long outside = k.key.use_count() - it->second;
+        const size_t bytes = gpgmeKeySize(k.key.get()) + sharedKeyControlBlockSize;
+        if (outside > 0) {
+            MemoryUsage shared;
+            shared.shared = bytes;
+            shared.proportional = bytes * it->second / (it->second + outside);
+            usage += shared;
+        } else {
+            usage += MemoryUsage::owned(bytes, 1);
+        }
+        // counted once
+        references.erase(it);
+    }
+    return usage;
+}
+
 bool Key::isBad() const
 {
     return isNull() || isRevoked() || isExpired() || isDisabled() || isInvalid();
@@ -1449,4 +1982,63 @@ std::ostream &operator<<(std::ostream &os, const RevocationKey &revkey)
     return os << ')';
 }
 
+//
+//
+// class ChildRangeTraits
+//
+//
+
+void ChildRangeTraits<Subkey>::advance(Subkey &subkey)
+{
+    subkey.subkey = subkey.subkey->next;
+    if (!subkey.subkey) {
+        subkey.key.reset();
+    }
+}
+
+const void *ChildRangeTraits<Subkey>::node(const Subkey &subkey)
+{
+    return subkey.subkey;
+}
+
+void ChildRangeTraits<UserID>::advance(UserID &uid)
+{
+    uid.uid = uid.uid->next;
+    if (!uid.uid) {
+        uid.key.reset();
+    }
+}
+
+const void *ChildRangeTraits<UserID>::node(const UserID &uid)
+{
+    return uid.uid;
+}
+
+void ChildRangeTraits<UserID::Signature>::advance(UserID::Signature &sig)
+{
+    sig.sig = sig.sig->next;
+    if (!sig.sig) {
+        sig.uid = nullptr;
+        sig.key.reset();
+    }
+}
+
+const void *ChildRangeTraits<UserID::Signature>::node(const UserID::Signature &sig)
+{
+    return sig.sig;
+}
+
+void ChildRangeTraits<RevocationKey>::advance(RevocationKey &revkey)
+{
+    revkey.revkey = revkey.revkey->next;
+    if (!revkey.revkey) {
+        revkey.key.reset();
+    }
+}
+
+const void *ChildRangeTraits<RevocationKey>::node(const RevocationKey &revkey)
+{
+    return revkey.revkey;
+}
+
 } // namespace GpgME
@@ -25,11 +25,13 @@
 #define __GPGMEPP_KEY_H__
 
 #include "global.h"
+#include "memoryusage.h"
 #include "notation.h"
 
 #include "gpgmefw.h"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -47,6 +49,13 @@ class UserID;
 class TofuInfo;
 class RevocationKey;
 
+template <typename T> class ChildRange;
+template <typename T> struct ChildRangeTraits;
+namespace InlineAccessors
+{
+struct Access;
+}
+
 typedef std::shared_ptr< std::remove_pointer<gpgme_key_t>::type > shared_gpgme_key_t;
 
 enum class TrustSignatureTrust : char {
@@ -62,6 +71,11 @@ enum class TrustSignatureTrust : char {
 class GPGMEPP_EXPORT Key
 {
     friend class ::GpgME::Context;
+    friend class KeyView;
+    friend class UserIDView;
+    friend class SubkeyView;
+    friend struct InlineAccessors::Access;
+    friend void mergeKeyLists(std::vector<Key> &local, const std::vector<Key> &remote);
     struct Null {
 		Null() {}
 	};
@@ -74,6 +88,7 @@ public:
     static const Null null;
 
     Key(const Key &other) = default;
+    Key(Key &&other) = default;
     const Key &operator=(Key other)
     {
         swap(other);
@@ -93,6 +108,14 @@ public:
         return !key;
     }
 
+    /**
+     * Returns the user ID, respectively subkey, with the given index.
+     *
+     * On the first indexed access (including numUserIDs(), numSubkeys() and
+     * UserID::signature()) an index of the children of the key is built,
+     * which is shared by all copies of the key. Afterwards these lookups
+     * take constant time.
+     */
     UserID userID(unsigned int index) const;
     Subkey subkey(unsigned int index) const;
 
@@ -102,9 +125,20 @@ public:
     std::vector<UserID> userIDs() const;
     std::vector<Subkey> subkeys() const;
 
+    /**
+     * Returns ranges over the user IDs, respectively subkeys, of the key.
+     *
+     * In contrast to userIDs() and subkeys() the ranges do not allocate
+     * and iterating over them does not copy the key for every element.
+     * See ChildRange.
+     */
+    ChildRange<UserID> userIDRange() const;
+    ChildRange<Subkey> subkeyRange() const;
+
     RevocationKey revocationKey(unsigned int index) const;
     unsigned int numRevocationKeys() const;
     std::vector<RevocationKey> revocationKeys() const;
+    ChildRange<RevocationKey> revocationKeyRange() const;
 
     bool isRevoked() const;
     bool isExpired() const;
@@ -167,6 +201,15 @@ public:
     const char *shortKeyID() const;
     const char *primaryFingerprint() const;
 
+    /** The same values as views, which know their length. A view is empty
+     * if the value is not available, and valid as long as the key is. */
+    std::string_view issuerSerialView() const;
+    std::string_view issuerNameView() const;
+    std::string_view chainIDView() const;
+    std::string_view keyIDView() const;
+    std::string_view shortKeyIDView() const;
+    std::string_view primaryFingerprintView() const;
+
     unsigned int keyListMode() const;
 
     /*! Update information about this key.
@@ -175,6 +218,16 @@ public:
      * how long the keylisting takes.*/
     void update();
 
+    /*! Update information about all @p keys like update().
+     *
+     * Instead of one key listing per key, the keys are listed with
+     * a few key listings for many fingerprints at once. The results
+     * are matched to the keys by fingerprint. Keys which could not be
+     * listed are left unchanged.
+     *
+     * @returns the first error of the key listings. */
+    static Error updateAll(std::vector<Key> &keys);
+
     /**
      * @brief Add a user id to this key.
      *
@@ -221,6 +274,20 @@ public:
      *
      * @returns the last update time. */
     time_t lastUpdate() const;
+
+    /**
+     * Returns the approximate memory used by this key, i.e. the key
+     * structure of gpgme with its subkeys, user IDs, signatures and
+     * strings plus the handle. The gpgme data is counted as shared if
+     * other copies of this key exist.
+     */
+    MemoryUsage approximateMemoryUsage() const;
+    /**
+     * Returns the approximate memory used by @p keys. The data of copies of
+     * the same key in @p keys is counted once, as exclusive if it is not
+     * referenced by keys outside of @p keys.
+     */
+    static MemoryUsage approximateMemoryUsage(const std::vector<Key> &keys);
 private:
     gpgme_key_t impl() const
     {
@@ -241,6 +308,7 @@ public:
     Subkey(const shared_gpgme_key_t &key, unsigned int idx);
 
     Subkey(const Subkey &other) = default;
+    Subkey(Subkey &&other) = default;
     const Subkey &operator=(Subkey other)
     {
         swap(other);
@@ -354,7 +422,17 @@ public:
      */
     std::vector<std::string_view> keyGrips() const;
 
+    /** Views of keyID(), fingerprint(), cardSerialNumber() and keyGrip().
+     * Empty if the value is not available. See Key::primaryFingerprintView(). */
+    std::string_view keyIDView() const;
+    std::string_view fingerprintView() const;
+    std::string_view cardSerialNumberView() const;
+    std::string_view keyGripView() const;
+
 private:
+    friend struct ChildRangeTraits<Subkey>;
+    friend class SubkeyView;
+    friend struct InlineAccessors::Access;
     shared_gpgme_key_t key;
     gpgme_sub_key_t subkey;
 };
@@ -373,6 +451,7 @@ public:
     UserID(const shared_gpgme_key_t &key, unsigned int idx);
 
     UserID(const UserID &other) = default;
+    UserID(UserID &&other) = default;
     const UserID &operator=(UserID other)
     {
         swap(other);
@@ -396,6 +475,8 @@ public:
     unsigned int numSignatures() const;
     Signature signature(unsigned int index) const;
     std::vector<Signature> signatures() const;
+    /** Returns a range over the signatures. See Key::userIDRange(). */
+    ChildRange<Signature> signatureRange() const;
 
     const char *id() const;
     const char *name() const;
@@ -436,6 +517,16 @@ public:
      * or an empty string. */
     std::string addrSpec() const;
 
+    /** Views of id(), name(), email(), comment() and uidhash(). Empty if the
+     * value is not available. See Key::primaryFingerprintView(). */
+    std::string_view idView() const;
+    std::string_view nameView() const;
+    std::string_view emailView() const;
+    std::string_view commentView() const;
+    std::string_view uidhashView() const;
+    /** Same as addrSpec() without copying the address. */
+    std::string_view addrSpecView() const;
+
     /*! Revoke the user id.
      *
      * Key needs update afterwards.
@@ -469,11 +560,21 @@ public:
     const char *remark(const Key &key,
                        Error &error) const;
 
-    /*! Get multiple remarks made by potentially multiple keys. */
+    /*! Get multiple remarks made by potentially multiple keys.
+     *
+     * Walks the signatures only once. Use a RemarkLookup to look up the
+     * remarks of the same keys on many user IDs. */
     std::vector <std::string> remarks(std::vector<GpgME::Key> remarkers,
                                       Error &error) const;
+    /** Same as remarks() without copying the remarks. The views are valid
+     * as long as the key of this user ID is. */
+    std::vector<std::string_view> remarkViews(const std::vector<GpgME::Key> &remarkers,
+                                              Error &error) const;
 
 private:
+    friend struct ChildRangeTraits<UserID>;
+    friend class UserIDView;
+    friend struct InlineAccessors::Access;
     shared_gpgme_key_t key;
     gpgme_user_id_t uid;
 };
@@ -490,6 +591,7 @@ public:
     Signature(const shared_gpgme_key_t &key, gpgme_user_id_t uid, unsigned int idx);
 
     Signature(const Signature &other) = default;
+    Signature(Signature &&other) = default;
     const Signature &operator=(Signature other)
     {
         swap(other);
@@ -554,7 +656,18 @@ public:
     unsigned int trustDepth() const;
     const char *trustScope() const;
 
+    /** Views of the signer's key ID and user ID, the policy URL and the
+     * trust scope. Empty if not available. See Key::primaryFingerprintView(). */
+    std::string_view signerKeyIDView() const;
+    std::string_view signerUserIDView() const;
+    std::string_view signerNameView() const;
+    std::string_view signerEmailView() const;
+    std::string_view signerCommentView() const;
+    std::string_view policyURLView() const;
+    std::string_view trustScopeView() const;
+
 private:
+    friend struct ChildRangeTraits<Signature>;
     shared_gpgme_key_t key;
     gpgme_user_id_t uid;
     gpgme_key_sig_t sig;
@@ -594,6 +707,7 @@ public:
     int algorithm() const;
 
 private:
+    friend struct ChildRangeTraits<RevocationKey>;
     shared_gpgme_key_t key;
     gpgme_revocation_key_t revkey;
 };
@@ -603,6 +717,136 @@ inline void swap(RevocationKey& v1, RevocationKey& v2)
     v1.swap(v2);
 }
 
+//
+// class ChildRange
+//
+
+template <> struct GPGMEPP_EXPORT ChildRangeTraits<Subkey> {
+    static void advance(Subkey &subkey);
+    static const void *node(const Subkey &subkey);
+};
+
+template <> struct GPGMEPP_EXPORT ChildRangeTraits<UserID> {
+    static void advance(UserID &uid);
+    static const void *node(const UserID &uid);
+};
+
+template <> struct GPGMEPP_EXPORT ChildRangeTraits<UserID::Signature> {
+    static void advance(UserID::Signature &sig);
+    static const void *node(const UserID::Signature &sig);
+};
+
+template <> struct GPGMEPP_EXPORT ChildRangeTraits<RevocationKey> {
+    static void advance(RevocationKey &revkey);
+    static const void *node(const RevocationKey &revkey);
+};
+
+/**
+ * A range over the subkeys, user IDs, signatures or revocation keys of a
+ * key, which walks the lists of gpgme directly.
+ *
+ * Every iterator holds a single element, which is moved to the next child
+ * when the iterator is incremented. Therefore iterating neither allocates
+ * nor changes the reference count of the key. The reference returned by
+ * dereferencing an iterator is only valid until the iterator is incremented;
+ * copy the element to keep it. Because of this the iterators are only input
+ * iterators, although the range can be iterated more than once.
+ */
+template <typename T>
+class ChildRange
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T *;
+        using reference = const T &;
+
+        iterator() = default;
+
+        const T &operator*() const
+        {
+            return mCurrent;
+        }
+        const T *operator->() const
+        {
+            return &mCurrent;
+        }
+
+        iterator &operator++()
+        {
+            ChildRangeTraits<T>::advance(mCurrent);
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator &other) const
+        {
+            return ChildRangeTraits<T>::node(mCurrent) == ChildRangeTraits<T>::node(other.mCurrent);
+        }
+        bool operator!=(const iterator &other) const
+        {
+            return !operator==(other);
+        }
+
+    private:
+        friend class ChildRange;
+        explicit iterator(const T &first)
+            : mCurrent(first)
+        {
+        }
+
+        T mCurrent;
+    };
+    using const_iterator = iterator;
+
+    ChildRange() = default;
+
+    iterator begin() const
+    {
+        return iterator(mFirst);
+    }
+    iterator end() const
+    {
+        return iterator();
+    }
+    bool empty() const
+    {
+        return !ChildRangeTraits<T>::node(mFirst);
+    }
+
+private:
+    friend class Key;
+    friend class UserID;
+    explicit ChildRange(T &&first)
+        : mFirst(std::move(first))
+    {
+    }
+
+    T mFirst;
+};
+
+/*!
+ * Merges the keys of @p remote, e.g. the result of an external key listing,
+ * into @p local. Keys are matched by their primary fingerprint with a hash
+ * lookup; keys of @p remote not in @p local are appended.
+ *
+ * For keys in both lists the flags are merged like Key::mergeWith() does.
+ * The user IDs and signatures are taken from the key with more of them,
+ * i.e. a key of @p local may be replaced by the key of @p remote with the
+ * merged flags. Like Key::mergeWith() this changes the key data shared by
+ * all copies of the merged keys.
+ */
+GPGMEPP_EXPORT void mergeKeyLists(std::vector<Key> &local, const std::vector<Key> &remote);
+
 GPGMEPP_EXPORT std::ostream &operator<<(std::ostream &os, const UserID &uid);
 GPGMEPP_EXPORT std::ostream &operator<<(std::ostream &os, const Subkey &subkey);
 GPGMEPP_EXPORT std::ostream &operator<<(std::ostream &os, const Key &key);
@@ -0,0 +1,509 @@
+/*
+  keyaccessors.h - inline accessors of Key, Subkey and UserID
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYACCESSORS_H__
+#define __GPGMEPP_KEYACCESSORS_H__
+
+#include "key.h"
+#include "gpgmepp_buildconfig.h"
+
+#include <gpgme.h>
+
+#include <ctime>
+
+// The functions in GpgME::InlineAccessors are inline versions of the trivial
+// accessors of Key, Subkey and UserID with the same names, e.g.
+// InlineAccessors::canEncrypt(key) for key.canEncrypt(), so that loops over
+// many keys do not call into the library for every flag. They read the
+// gpgme structs directly only if gpgme.h has the same major and minor
+// version as the one GpgME++ was built with; otherwise they call the
+// exported member functions.
+#if defined(GPGME_VERSION_NUMBER) && (GPGME_VERSION_NUMBER >> 8) == (GPGMEPP_GPGME_VERSION_NUMBER >> 8)
+# define GPGMEPP_INLINE_ACCESSORS_DIRECT 1
+#else
+# define GPGMEPP_INLINE_ACCESSORS_DIRECT 0
+#endif
+
+namespace GpgME
+{
+namespace InlineAccessors
+{
+
+struct Access {
+    static gpgme_key_t key(const Key &key)
+    {
+        return key.impl();
+    }
+    static gpgme_sub_key_t subkey(const Subkey &subkey)
+    {
+        return subkey.subkey;
+    }
+    static gpgme_user_id_t uid(const UserID &uid)
+    {
+        return uid.uid;
+    }
+};
+
+#if GPGMEPP_INLINE_ACCESSORS_DIRECT
+
+//
+// Key
+//
+
+inline Protocol protocol(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    if (!k) {
+        return UnknownProtocol;
+    }
+    switch (k->protocol) {
+    case GPGME_PROTOCOL_CMS:     return CMS;
+    case GPGME_PROTOCOL_OpenPGP: return OpenPGP;
+    default:                     return UnknownProtocol;
+    }
+}
+
+inline bool isRevoked(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->revoked;
+}
+
+inline bool isExpired(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->expired;
+}
+
+inline bool isDisabled(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->disabled;
+}
+
+inline bool isInvalid(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->invalid;
+}
+
+inline bool hasSecret(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->secret;
+}
+
+inline bool canEncrypt(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->can_encrypt;
+}
+
+inline bool canSign(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->can_sign;
+}
+
+inline bool canCertify(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->can_certify;
+}
+
+inline bool canAuthenticate(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->can_authenticate;
+}
+
+inline bool isQualified(const Key &key)
+{
+    const gpgme_key_t k = Access::key(key);
+    return k && k->is_qualified;
+}
+
+inline bool isBad(const Key &key)
+{
+    return key.isNull() || isRevoked(key) || isExpired(key) || isDisabled(key) || isInvalid(key);
+}
+
+//
+// Subkey
+//
+
+inline bool canEncrypt(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->can_encrypt;
+}
+
+inline bool canSign(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->can_sign;
+}
+
+inline bool canCertify(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->can_certify;
+}
+
+inline bool canAuthenticate(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->can_authenticate;
+}
+
+inline bool canRenc(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->can_renc;
+}
+
+inline bool canTimestamp(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->can_timestamp;
+}
+
+inline bool isGroupOwned(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->is_group_owned;
+}
+
+inline bool isQualified(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->is_qualified;
+}
+
+inline bool isDeVs(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->is_de_vs;
+}
+
+inline bool isBetaCompliance(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->beta_compliance;
+}
+
+inline bool isCardKey(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->is_cardkey;
+}
+
+inline bool isSecret(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->secret;
+}
+
+inline unsigned int length(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s ? s->length : 0;
+}
+
+inline time_t creationTime(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return static_cast<time_t>(s ? s->timestamp : 0);
+}
+
+inline time_t expirationTime(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return static_cast<time_t>(s ? s->expires : 0);
+}
+
+inline bool neverExpires(const Subkey &subkey)
+{
+    return expirationTime(subkey) == time_t(0);
+}
+
+inline bool isRevoked(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->revoked;
+}
+
+inline bool isInvalid(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->invalid;
+}
+
+inline bool isExpired(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->expired;
+}
+
+inline bool isDisabled(const Subkey &subkey)
+{
+    const gpgme_sub_key_t s = Access::subkey(subkey);
+    return s && s->disabled;
+}
+
+inline bool isBad(const Subkey &subkey)
+{
+    return subkey.isNull() || isRevoked(subkey) || isExpired(subkey) || isDisabled(subkey) || isInvalid(subkey);
+}
+
+//
+// UserID
+//
+
+inline UserID::Validity validity(const UserID &uid)
+{
+    const gpgme_user_id_t u = Access::uid(uid);
+    if (!u) {
+        return UserID::Unknown;
+    }
+    switch (u->validity) {
+    default:
+    case GPGME_VALIDITY_UNKNOWN:   return UserID::Unknown;
+    case GPGME_VALIDITY_UNDEFINED: return UserID::Undefined;
+    case GPGME_VALIDITY_NEVER:     return UserID::Never;
+    case GPGME_VALIDITY_MARGINAL:  return UserID::Marginal;
+    case GPGME_VALIDITY_FULL:      return UserID::Full;
+    case GPGME_VALIDITY_ULTIMATE:  return UserID::Ultimate;
+    }
+}
+
+inline bool isRevoked(const UserID &uid)
+{
+    const gpgme_user_id_t u = Access::uid(uid);
+    return u && u->revoked;
+}
+
+inline bool isInvalid(const UserID &uid)
+{
+    const gpgme_user_id_t u = Access::uid(uid);
+    return u && u->invalid;
+}
+
+inline bool isBad(const UserID &uid)
+{
+    return uid.isNull() || isRevoked(uid) || isInvalid(uid);
+}
+
+#else // GPGMEPP_INLINE_ACCESSORS_DIRECT
+
+inline Protocol protocol(const Key &key)
+{
+    return key.protocol();
+}
+
+inline bool isRevoked(const Key &key)
+{
+    return key.isRevoked();
+}
+
+inline bool isExpired(const Key &key)
+{
+    return key.isExpired();
+}
+
+inline bool isDisabled(const Key &key)
+{
+    return key.isDisabled();
+}
+
+inline bool isInvalid(const Key &key)
+{
+    return key.isInvalid();
+}
+
+inline bool hasSecret(const Key &key)
+{
+    return key.hasSecret();
+}
+
+inline bool canEncrypt(const Key &key)
+{
+    return key.canEncrypt();
+}
+
+inline bool canSign(const Key &key)
+{
+    return key.canSign();
+}
+
+inline bool canCertify(const Key &key)
+{
+    return key.canCertify();
+}
+
+inline bool canAuthenticate(const Key &key)
+{
+    return key.canAuthenticate();
+}
+
+inline bool isQualified(const Key &key)
+{
+    return key.isQualified();
+}
+
+inline bool isBad(const Key &key)
+{
+    return key.isBad();
+}
+
+inline bool canEncrypt(const Subkey &subkey)
+{
+    return subkey.canEncrypt();
+}
+
+inline bool canSign(const Subkey &subkey)
+{
+    return subkey.canSign();
+}
+
+inline bool canCertify(const Subkey &subkey)
+{
+    return subkey.canCertify();
+}
+
+inline bool canAuthenticate(const Subkey &subkey)
+{
+    return subkey.canAuthenticate();
+}
+
+inline bool canRenc(const Subkey &subkey)
+{
+    return subkey.canRenc();
+}
+
+inline bool canTimestamp(const Subkey &subkey)
+{
+    return subkey.canTimestamp();
+}
+
+inline bool isGroupOwned(const Subkey &subkey)
+{
+    return subkey.isGroupOwned();
+}
+
+inline bool isQualified(const Subkey &subkey)
+{
+    return subkey.isQualified();
+}
+
+inline bool isDeVs(const Subkey &subkey)
+{
+    return subkey.isDeVs();
+}
+
+inline bool isBetaCompliance(const Subkey &subkey)
+{
+    return subkey.isBetaCompliance();
+}
+
+inline bool isCardKey(const Subkey &subkey)
+{
+    return subkey.isCardKey();
+}
+
+inline bool isSecret(const Subkey &subkey)
+{
+    return subkey.isSecret();
+}
+
+inline unsigned int length(const Subkey &subkey)
+{
+    return subkey.length();
+}
+
+inline time_t creationTime(const Subkey &subkey)
+{
+    return subkey.creationTime();
+}
+
+inline time_t expirationTime(const Subkey &subkey)
+{
+    return subkey.expirationTime();
+}
+
+inline bool neverExpires(const Subkey &subkey)
+{
+    return subkey.neverExpires();
+}
+
+inline bool isRevoked(const Subkey &subkey)
+{
+    return subkey.isRevoked();
+}
+
+inline bool isInvalid(const Subkey &subkey)
+{
+    return subkey.isInvalid();
+}
+
+inline bool isExpired(const Subkey &subkey)
+{
+    return subkey.isExpired();
+}
+
+inline bool isDisabled(const Subkey &subkey)
+{
+    return subkey.isDisabled();
+}
+
+inline bool isBad(const Subkey &subkey)
+{
+    return subkey.isBad();
+}
+
+inline UserID::Validity validity(const UserID &uid)
+{
+    return uid.validity();
+}
+
+inline bool isRevoked(const UserID &uid)
+{
+    return uid.isRevoked();
+}
+
+inline bool isInvalid(const UserID &uid)
+{
+    return uid.isInvalid();
+}
+
+inline bool isBad(const UserID &uid)
+{
+    return uid.isBad();
+}
+
+#endif // GPGMEPP_INLINE_ACCESSORS_DIRECT
+
+} // namespace InlineAccessors
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYACCESSORS_H__
@@ -0,0 +1,413 @@
+/*
+  keycache.cpp - an in-process cache of keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keycache.h>
+#include <context.h>
+#include <error.h>
+#include <fingerprint.h>
+#include <keylistresult.h>
+
+#include "context_p.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace GpgME;
+
+namespace
+{
+std::string toUpper(const char *s)
+{
+    std::string result = s ? s : "";
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::toupper(c);
+    });
+    return result;
+}
+
+std::string toLower(const std::string &s)
+{
+    std::string result = s;
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+    return result;
+}
+
+struct Entry {
+    Key key;
+    std::vector<std::string> fingerprints;
+    std::vector<std::string> keyIDs;
+    std::vector<std::string> keygrips;
+    std::vector<std::string> emails;
+};
+}
+
+class KeyCache::Private
+{
+public:
+    using Entries = std::list<Entry>;
+    using Index = std::unordered_map<std::string, Entries::iterator>;
+
+    Private()
+        : maxSize(0),
+          generation(Context::Private::keyringGeneration()),
+          hits(0),
+          misses(0)
+    {
+    }
+
+    // drops everything if the keyring may have changed since the last lookup
+    void checkValidity()
+    {
+        bool stale = false;
+        const unsigned int currentGeneration = Context::Private::keyringGeneration();
+        if (currentGeneration != generation) {
+            generation = currentGeneration;
+            stale = true;
+        }
+        if (!keyringFile.empty()) {
+            std::error_code ec;
+            const auto mtime = std::filesystem::last_write_time(keyringFile, ec);
+            if (!ec && mtime != keyringFileTime) {
+                keyringFileTime = mtime;
+                stale = true;
+            }
+        }
+        if (stale) {
+            clear();
+        }
+    }
+
+    void clear()
+    {
+        entries.clear();
+        byFingerprint.clear();
+        byKeyID.clear();
+        byKeygrip.clear();
+        byEmail.clear();
+        listedEmails.clear();
+    }
+
+    // moves the entry to the front of the LRU list
+    Key touch(Entries::iterator it)
+    {
+        entries.splice(entries.begin(), entries, it);
+        return it->key;
+    }
+
+    Key find(Index &index, const std::string &id, bool secret)
+    {
+        const auto it = index.find(id);
+        if (it == index.end() || (secret && !it->second->key.hasSecret())) {
+            ++misses;
+            return Key();
+        }
+        ++hits;
+        return touch(it->second);
+    }
+
+    void erase(Entries::iterator it)
+    {
+        for (const auto &fpr : it->fingerprints) {
+            byFingerprint.erase(fpr);
+        }
+        for (const auto &keyID : it->keyIDs) {
+            byKeyID.erase(keyID);
+        }
+        for (const auto &keygrip : it->keygrips) {
+            byKeygrip.erase(keygrip);
+        }
+        for (const auto &email : it->emails) {
+            auto range = byEmail.equal_range(email);
+            for (auto e = range.first; e != range.second;) {
+                e = (e->second == it) ? byEmail.erase(e) : std::next(e);
+            }
+            // the list of keys for this email is no longer complete
+            listedEmails.erase(email);
+        }
+        entries.erase(it);
+    }
+
+    void insert(const Key &key)
+    {
+        if (key.isNull() || !key.primaryFingerprint()) {
+            return;
+        }
+        const auto existing = byFingerprint.find(toUpper(key.primaryFingerprint()));
+        if (existing != byFingerprint.end()) {
+            erase(existing->second);
+        }
+
+        Entry entry;
+        entry.key = key;
+        for (const Subkey &subkey : key.subkeys()) {
+            if (subkey.fingerprint()) {
+                entry.fingerprints.push_back(toUpper(subkey.fingerprint()));
+            }
+            if (subkey.keyID()) {
+                entry.keyIDs.push_back(toUpper(subkey.keyID()));
+            }
+            if (subkey.keyGrip()) {
+                entry.keygrips.push_back(toUpper(subkey.keyGrip()));
+            }
+        }
+        for (const UserID &uid : key.userIDs()) {
+            const std::string email = toLower(uid.addrSpec());
+            if (!email.empty() && std::find(entry.emails.begin(), entry.emails.end(), email) == entry.emails.end()) {
+                entry.emails.push_back(email);
+            }
+        }
+        entries.push_front(std::move(entry));
+        const auto it = entries.begin();
+        for (const auto &fpr : it->fingerprints) {
+            byFingerprint[fpr] = it;
+        }
+        for (const auto &keyID : it->keyIDs) {
+            byKeyID[keyID] = it;
+        }
+        for (const auto &keygrip : it->keygrips) {
+            byKeygrip[keygrip] = it;
+        }
+        for (const auto &email : it->emails) {
+            byEmail.emplace(email, it);
+        }
+        enforceMaximumSize();
+    }
+
+    void enforceMaximumSize()
+    {
+        while (maxSize != 0 && entries.size() > maxSize) {
+            erase(std::prev(entries.end()));
+        }
+    }
+
+    Entries entries;
+    Index byFingerprint;
+    Index byKeyID;
+    Index byKeygrip;
+    std::unordered_multimap<std::string, Entries::iterator> byEmail;
+    // emails for which all keys have been listed
+    std::unordered_set<std::string> listedEmails;
+    unsigned int maxSize;
+    std::string keyringFile;
+    std::filesystem::file_time_type keyringFileTime;
+    unsigned int generation;
+    unsigned long hits;
+    unsigned long misses;
+};
+
+KeyCache::KeyCache()
+    : d(new Private)
+{
+}
+
+KeyCache::~KeyCache() = default;
+
+void KeyCache::setMaximumSize(unsigned int size)
+{
+    d->maxSize = size;
+    d->enforceMaximumSize();
+}
+
+unsigned int KeyCache::maximumSize() const
+{
+    return d->maxSize;
+}
+
+void KeyCache::setKeyringFile(const std::string &fileName)
+{
+    d->keyringFile = fileName;
+    d->keyringFileTime = {};
+    if (!fileName.empty()) {
+        std::error_code ec;
+        d->keyringFileTime = std::filesystem::last_write_time(fileName, ec);
+    }
+}
+
+std::string KeyCache::keyringFile() const
+{
+    return d->keyringFile;
+}
+
+Key KeyCache::findByFingerprint(const char *fpr, Context *ctx, Error &err, bool secret)
+{
+    err = Error();
+    if (!fpr || !*fpr) {
+        return Key();
+    }
+    d->checkValidity();
+    Key key = d->find(d->byFingerprint, toUpper(fpr), secret);
+    if (key.isNull() && ctx) {
+        key = ctx->key(fpr, err, secret);
+        d->insert(key);
+    }
+    return key;
+}
+
+Key KeyCache::findByFingerprint(const Fingerprint &fpr, Context *ctx, Error &err, bool secret)
+{
+    if (fpr.isNull()) {
+        err = Error();
+        return Key();
+    }
+    return findByFingerprint(fpr.toString().c_str(), ctx, err, secret);
+}
+
+Key KeyCache::findByKeyID(const char *keyID, Context *ctx, Error &err, bool secret)
+{
+    err = Error();
+    if (!keyID || !*keyID) {
+        return Key();
+    }
+    d->checkValidity();
+    Key key = d->find(d->byKeyID, toUpper(keyID), secret);
+    if (key.isNull() && ctx) {
+        key = ctx->key(keyID, err, secret);
+        d->insert(key);
+    }
+    return key;
+}
+
+Key KeyCache::findByKeygrip(const char *keygrip)
+{
+    if (!keygrip || !*keygrip) {
+        return Key();
+    }
+    d->checkValidity();
+    return d->find(d->byKeygrip, toUpper(keygrip), false);
+}
+
+std::vector<Key> KeyCache::findByEmail(const char *email, Context *ctx, Error &err)
+{
+    err = Error();
+    std::vector<Key> result;
+    if (!email || !*email) {
+        return result;
+    }
+    d->checkValidity();
+    const std::string addr = toLower(email);
+    if (d->listedEmails.count(addr) || !ctx) {
+        auto range = d->byEmail.equal_range(addr);
+        if (range.first == range.second) {
+            ++d->misses;
+            return result;
+        }
+        ++d->hits;
+        std::vector<Private::Entries::iterator> found;
+        for (auto it = range.first; it != range.second; ++it) {
+            found.push_back(it->second);
+        }
+        for (auto it : found) {
+            result.push_back(d->touch(it));
+        }
+        return result;
+    }
+
+    ++d->misses;
+    const std::string pattern = '<' + addr + '>';
+    err = ctx->startKeyListing(pattern.c_str());
+    if (err) {
+        return result;
+    }
+    while (true) {
+        Error e;
+        const Key key = ctx->nextKey(e);
+        if (e) {
+            if (e.code() != GPG_ERR_EOF) {
+                err = e;
+            }
+            break;
+        }
+        result.push_back(key);
+    }
+    ctx->endKeyListing();
+    if (err) {
+        return result;
+    }
+    for (const Key &key : result) {
+        d->insert(key);
+    }
+    // keys may have been evicted again if the cache is small
+    if (d->byEmail.count(addr) == result.size()) {
+        d->listedEmails.insert(addr);
+    }
+    return result;
+}
+
+void KeyCache::insert(const Key &key)
+{
+    d->checkValidity();
+    d->insert(key);
+}
+
+void KeyCache::insert(const std::vector<Key> &keys)
+{
+    d->checkValidity();
+    for (const Key &key : keys) {
+        d->insert(key);
+    }
+}
+
+void KeyCache::remove(const Key &key)
+{
+    if (key.isNull() || !key.primaryFingerprint()) {
+        return;
+    }
+    const auto it = d->byFingerprint.find(toUpper(key.primaryFingerprint()));
+    if (it != d->byFingerprint.end()) {
+        d->erase(it->second);
+    }
+}
+
+void KeyCache::clear()
+{
+    d->clear();
+}
+
+unsigned int KeyCache::size() const
+{
+    return d->entries.size();
+}
+
+unsigned long KeyCache::hits() const
+{
+    return d->hits;
+}
+
+unsigned long KeyCache::misses() const
+{
+    return d->misses;
+}
+
+void KeyCache::resetStatistics()
+{
+    d->hits = 0;
+    d->misses = 0;
+}
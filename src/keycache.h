@@ -0,0 +1,110 @@
+/*
+  keycache.h - an in-process cache of keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYCACHE_H__
+#define __GPGMEPP_KEYCACHE_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class Error;
+class Fingerprint;
+
+/**
+ * A cache of keys indexed by fingerprint, key ID, keygrip and email address.
+ *
+ * Lookups which miss the cache are resolved with the given context and
+ * the result is added to the cache. The least recently used keys are
+ * evicted if the maximum size is exceeded.
+ *
+ * The complete cache is invalidated whenever an operation which may change
+ * the keyring (import, deletion, edit, key creation, expiration or owner
+ * trust changes, ...) is started with any context of this library.
+ * Optionally, the modification time of a keyring file is checked on every
+ * lookup, so that changes done by other processes are noticed.
+ *
+ * This class is not thread-safe.
+ */
+class GPGMEPP_EXPORT KeyCache
+{
+public:
+    KeyCache();
+    ~KeyCache();
+
+    /** Sets the maximum number of cached keys. 0 (the default) means no limit. */
+    void setMaximumSize(unsigned int size);
+    unsigned int maximumSize() const;
+
+    /** Invalidate the cache if the modification time of @p fileName changes,
+     * e.g. of the pubring.kbx of the used GnuPG home directory. Pass an
+     * empty file name to disable this check. */
+    void setKeyringFile(const std::string &fileName);
+    std::string keyringFile() const;
+
+    /** Returns the key with the fingerprint @p fpr. On a cache miss the
+     * key is looked up with @p ctx (unless it is null). */
+    Key findByFingerprint(const char *fpr, Context *ctx, Error &err, bool secret = false);
+    Key findByFingerprint(const Fingerprint &fpr, Context *ctx, Error &err, bool secret = false);
+
+    /** Returns the key with the (long) key ID @p keyID. */
+    Key findByKeyID(const char *keyID, Context *ctx, Error &err, bool secret = false);
+
+    /** Returns the key having a subkey with the keygrip @p keygrip. Keygrips
+     * are only known for keys listed with the WithKeygrip key list mode,
+     * therefore, this never looks up the key with a context. */
+    Key findByKeygrip(const char *keygrip);
+
+    /** Returns the keys with a user ID with the email address @p email. On
+     * a cache miss the keys are listed with @p ctx (unless it is null). */
+    std::vector<Key> findByEmail(const char *email, Context *ctx, Error &err);
+
+    /** Adds @p key to the cache, replacing an older copy of the key. */
+    void insert(const Key &key);
+    void insert(const std::vector<Key> &keys);
+
+    void remove(const Key &key);
+    void clear();
+
+    unsigned int size() const;
+    unsigned long hits() const;
+    unsigned long misses() const;
+    void resetStatistics();
+
+private:
+    KeyCache(const KeyCache &) = delete;
+    KeyCache &operator=(const KeyCache &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYCACHE_H__
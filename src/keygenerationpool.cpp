@@ -0,0 +1,304 @@
+/*
+  keygenerationpool.cpp - a stock of pre-generated keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keygenerationpool.h>
+#include <keygenerationresult.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace GpgME;
+
+namespace
+{
+struct StockKey {
+    Key key;
+    size_t home;
+};
+
+struct SpecState {
+    KeyGenerationPool::Spec spec;
+    std::deque<StockKey> stock;
+    // keys currently being generated by the workers
+    unsigned int pending = 0;
+};
+
+std::unique_ptr<Context> createContext(const std::string &homeDirectory, Error &err)
+{
+    std::unique_ptr<Context> ctx(Context::createForProtocol(OpenPGP));
+    if (!ctx) {
+        err = Error::fromCode(GPG_ERR_INV_ENGINE);
+        return ctx;
+    }
+    if (!homeDirectory.empty()) {
+        err = ctx->setEngineHomeDirectory(homeDirectory.c_str());
+        if (err) {
+            ctx.reset();
+        }
+    }
+    return ctx;
+}
+
+Key generate(Context *ctx, const KeyGenerationPool::Spec &spec, const char *userid, Error &err)
+{
+    const KeyGenerationResult res = ctx->createKey(userid, spec.algo, spec.expires,
+                                                   spec.flags | Context::CreateForce);
+    err = res.error();
+    if (err) {
+        return Key();
+    }
+    if (!res.fingerprint()) {
+        err = Error::fromCode(GPG_ERR_GENERAL);
+        return Key();
+    }
+    return ctx->key(res.fingerprint(), err, true);
+}
+}
+
+class KeyGenerationPool::Private
+{
+public:
+    Private(const std::vector<std::string> &h, unsigned int t)
+        : homeDirectories(h.empty() ? std::vector<std::string>(1) : h),
+          threads(t ? t : 1),
+          nextHome(0),
+          running(false)
+    {
+    }
+
+    size_t takeHome()
+    {
+        return nextHome++ % homeDirectories.size();
+    }
+
+    // returns the spec a worker should generate the next key for
+    SpecState *nextShortage()
+    {
+        for (auto &entry : specs) {
+            SpecState &state = entry.second;
+            if (state.stock.size() + state.pending < state.spec.stock) {
+                return &state;
+            }
+        }
+        return nullptr;
+    }
+
+    void work()
+    {
+        std::vector<std::unique_ptr<Context>> contexts(homeDirectories.size());
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            SpecState *state = nullptr;
+            cv.wait(lock, [this, &state]() {
+                return !running || (state = nextShortage());
+            });
+            if (!running) {
+                return;
+            }
+            ++state->pending;
+            const Spec spec = state->spec;
+            const size_t home = takeHome();
+            lock.unlock();
+
+            Error err;
+            if (!contexts[home]) {
+                contexts[home] = createContext(homeDirectories[home], err);
+            }
+            const Key key = contexts[home] ? generate(contexts[home].get(), spec, placeholderUserID(), err) : Key();
+
+            lock.lock();
+            // addSpec() only replaces the spec, so state is still valid
+            --state->pending;
+            if (err || key.isNull()) {
+                ++stats.failures;
+                // don't spin on a broken setup
+                cv.wait_for(lock, std::chrono::seconds(1), [this]() { return !running; });
+                continue;
+            }
+            ++stats.generated;
+            state->stock.push_back({key, home});
+            cv.notify_all();
+        }
+    }
+
+    const std::vector<std::string> homeDirectories;
+    const unsigned int threads;
+
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::map<std::string, SpecState> specs;
+    size_t nextHome;
+    bool running;
+    Statistics stats;
+    std::vector<std::thread> workers;
+};
+
+KeyGenerationPool::KeyGenerationPool(const std::vector<std::string> &homeDirectories, unsigned int threads)
+    : d(new Private(homeDirectories, threads))
+{
+}
+
+KeyGenerationPool::~KeyGenerationPool()
+{
+    stop();
+}
+
+const char *KeyGenerationPool::placeholderUserID()
+{
+    return "GpgME++ key pool <key-pool@invalid>";
+}
+
+void KeyGenerationPool::addSpec(const std::string &name, const Spec &spec)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->specs[name].spec = spec;
+    d->cv.notify_all();
+}
+
+void KeyGenerationPool::start()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    if (d->running) {
+        return;
+    }
+    d->running = true;
+    for (unsigned int i = 0; i < d->threads; ++i) {
+        d->workers.emplace_back(&Private::work, d.get());
+    }
+}
+
+void KeyGenerationPool::stop()
+{
+    std::vector<std::thread> workers;
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        d->running = false;
+        workers.swap(d->workers);
+        d->cv.notify_all();
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+KeyGenerationPool::Assignment KeyGenerationPool::acquire(const std::string &name, const std::string &userid)
+{
+    Assignment result;
+    Spec spec;
+    StockKey stockKey;
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        const auto it = d->specs.find(name);
+        if (it == d->specs.end()) {
+            result.error = Error::fromCode(GPG_ERR_NOT_FOUND);
+            return result;
+        }
+        spec = it->second.spec;
+        if (!it->second.stock.empty()) {
+            stockKey = it->second.stock.front();
+            it->second.stock.pop_front();
+            d->cv.notify_all();
+        } else {
+            stockKey.home = d->takeHome();
+            result.generatedOnDemand = true;
+        }
+    }
+    result.homeDirectory = d->homeDirectories[stockKey.home];
+
+    const std::unique_ptr<Context> ctx = createContext(result.homeDirectory, result.error);
+    if (ctx) {
+        if (result.generatedOnDemand) {
+            result.key = generate(ctx.get(), spec, userid.c_str(), result.error);
+        } else {
+            result.error = ctx->addUid(stockKey.key, userid.c_str());
+            if (!result.error) {
+                result.error = ctx->revUid(stockKey.key, placeholderUserID());
+            }
+            Error err;
+            result.key = ctx->key(stockKey.key.primaryFingerprint(), err, true);
+            if (!result.error) {
+                result.error = err;
+            }
+        }
+    }
+
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    if (result.error) {
+        ++d->stats.failures;
+    } else {
+        ++d->stats.assigned;
+        if (result.generatedOnDemand) {
+            ++d->stats.generatedOnDemand;
+        }
+    }
+    return result;
+}
+
+unsigned int KeyGenerationPool::available(const std::string &name) const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    const auto it = d->specs.find(name);
+    return it == d->specs.end() ? 0 : it->second.stock.size();
+}
+
+Error KeyGenerationPool::discardStock()
+{
+    std::vector<StockKey> keys;
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        for (auto &entry : d->specs) {
+            keys.insert(keys.end(), entry.second.stock.begin(), entry.second.stock.end());
+            entry.second.stock.clear();
+        }
+        // the workers refill the stock unless they are stopped
+        d->cv.notify_all();
+    }
+    Error result;
+    std::vector<std::unique_ptr<Context>> contexts(d->homeDirectories.size());
+    for (const StockKey &stockKey : keys) {
+        Error err;
+        if (!contexts[stockKey.home]) {
+            contexts[stockKey.home] = createContext(d->homeDirectories[stockKey.home], err);
+        }
+        if (contexts[stockKey.home]) {
+            err = contexts[stockKey.home]->deleteKey(stockKey.key, DeletionFlag::AllowSecret | DeletionFlag::Force);
+        }
+        if (err && !result) {
+            result = err;
+        }
+    }
+    return result;
+}
+
+KeyGenerationPool::Statistics KeyGenerationPool::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
@@ -0,0 +1,128 @@
+/*
+  keygenerationpool.h - a stock of pre-generated keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYGENERATIONPOOL_H__
+#define __GPGMEPP_KEYGENERATIONPOOL_H__
+
+#include "global.h"
+#include "context.h"
+#include "error.h"
+#include "key.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Keeps a stock of pre-generated OpenPGP keys, so that handing out a new
+ * key only costs adding a user ID instead of generating the key.
+ *
+ * For every spec added with addSpec() the worker threads generate keys
+ * with a placeholder user ID until the stock of the spec is full. They
+ * spread the keys over the given home directories, each worker using an
+ * own context per home directory. acquire() takes a key from the stock,
+ * adds the real user ID and revokes the placeholder user ID. The revoked
+ * placeholder stays part of the key.
+ *
+ * The keys must be generated without interaction, i.e. the specs should
+ * contain CreateNoPassword or the contexts must be configured for loopback
+ * pinentry with a set passphrase provider.
+ *
+ * Keys still in stock when the pool is destroyed stay in the keyrings; use
+ * discardStock() to delete them. The pool is thread-safe.
+ */
+class GPGMEPP_EXPORT KeyGenerationPool
+{
+public:
+    struct Spec {
+        /** See Context::createKey(). */
+        std::string algo;
+        unsigned long expires = 0;
+        Context::CreationFlags flags = Context::CreateUseDefaults;
+        /** The number of keys to keep in stock. */
+        unsigned int stock = 1;
+    };
+
+    struct Assignment {
+        Key key;
+        /** The home directory whose keyring contains the key; empty for
+         * the default home directory. */
+        std::string homeDirectory;
+        Error error;
+        /** True if the stock was empty and the key was generated on demand. */
+        bool generatedOnDemand = false;
+    };
+
+    struct Statistics {
+        unsigned long generated = 0;
+        unsigned long assigned = 0;
+        unsigned long generatedOnDemand = 0;
+        unsigned long failures = 0;
+    };
+
+    /** If @p homeDirectories is empty, then the default home directory is
+     * used. The workers are started by start(). */
+    explicit KeyGenerationPool(const std::vector<std::string> &homeDirectories = {}, unsigned int threads = 2);
+    /** Stops the workers; see stop(). */
+    ~KeyGenerationPool();
+
+    /** Adds or replaces the spec @p name. */
+    void addSpec(const std::string &name, const Spec &spec);
+
+    /** Starts the workers which fill the stock. */
+    void start();
+    /** Stops the workers after the keys currently being generated. */
+    void stop();
+
+    /**
+     * Returns a key of the spec @p name with the user ID @p userid. If the
+     * stock is empty, then the key is generated first. Returns
+     * GPG_ERR_NOT_FOUND if there is no spec @p name.
+     */
+    Assignment acquire(const std::string &name, const std::string &userid);
+
+    /** Returns the number of keys in stock for the spec @p name. */
+    unsigned int available(const std::string &name) const;
+
+    /** Deletes all keys in stock from their keyrings. */
+    Error discardStock();
+
+    Statistics statistics() const;
+
+    /** The user ID of the keys in stock. */
+    static const char *placeholderUserID();
+
+private:
+    KeyGenerationPool(const KeyGenerationPool &) = delete;
+    KeyGenerationPool &operator=(const KeyGenerationPool &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYGENERATIONPOOL_H__
@@ -45,6 +45,7 @@ public:
     explicit KeyGenerationResult(const Error &err);
 
     KeyGenerationResult(const KeyGenerationResult &other) = default;
+    KeyGenerationResult(KeyGenerationResult &&other) = default;
     const KeyGenerationResult &operator=(KeyGenerationResult other)
     {
         swap(other);
@@ -0,0 +1,187 @@
+/*
+  keylistinterner.cpp - shares the strings of the keys of a listing
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keylistinterner.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+using namespace GpgME;
+
+namespace
+{
+// most strings of keys are short; longer ones get their own allocation
+constexpr size_t BlockSize = 16 * 1024;
+constexpr size_t MaxBlockString = BlockSize / 4;
+}
+
+class KeyListInterner::Private
+{
+public:
+    Private()
+        : used(BlockSize),
+          storedBytes(0),
+          requested(0)
+    {
+    }
+
+    // copies s into the blocks; called with the lock held exclusively
+    std::string_view store(std::string_view s)
+    {
+        char *p;
+        if (s.size() > MaxBlockString) {
+            large.emplace_back(new char[s.size()]);
+            p = large.back().get();
+        } else {
+            if (used + s.size() > BlockSize) {
+                blocks.emplace_back(new char[BlockSize]);
+                used = 0;
+            }
+            p = blocks.back().get() + used;
+            used += s.size();
+        }
+        std::memcpy(p, s.data(), s.size());
+        storedBytes += s.size();
+        return std::string_view(p, s.size());
+    }
+
+    mutable std::shared_mutex mutex;
+    std::unordered_set<std::string_view> strings;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::vector<std::unique_ptr<char[]>> large;
+    size_t used;
+    size_t storedBytes;
+    std::atomic<uint64_t> requested;
+};
+
+KeyListInterner::KeyListInterner()
+    : d(new Private)
+{
+}
+
+KeyListInterner::~KeyListInterner() = default;
+
+std::string_view KeyListInterner::intern(std::string_view s)
+{
+    if (s.empty()) {
+        return std::string_view();
+    }
+    d->requested.fetch_add(s.size(), std::memory_order_relaxed);
+    {
+        const std::shared_lock<std::shared_mutex> lock(d->mutex);
+        const auto it = d->strings.find(s);
+        if (it != d->strings.end()) {
+            return *it;
+        }
+    }
+    const std::unique_lock<std::shared_mutex> lock(d->mutex);
+    const auto it = d->strings.find(s);
+    if (it != d->strings.end()) {
+        return *it;
+    }
+    return *d->strings.insert(d->store(s)).first;
+}
+
+std::string_view KeyListInterner::intern(const char *s)
+{
+    return s ? intern(std::string_view(s)) : std::string_view();
+}
+
+void KeyListInterner::internKey(const Key &key)
+{
+    for (const UserID &uid : key.userIDRange()) {
+        intern(uid.name());
+        intern(uid.email());
+        intern(uid.comment());
+        for (const UserID::Signature &sig : uid.signatureRange()) {
+            intern(sig.signerKeyID());
+            intern(sig.signerName());
+            intern(sig.signerEmail());
+        }
+    }
+}
+
+std::string_view KeyListInterner::name(const UserID &uid)
+{
+    return intern(uid.name());
+}
+
+std::string_view KeyListInterner::email(const UserID &uid)
+{
+    return intern(uid.email());
+}
+
+std::string_view KeyListInterner::comment(const UserID &uid)
+{
+    return intern(uid.comment());
+}
+
+std::string_view KeyListInterner::addrSpec(const UserID &uid)
+{
+    return intern(uid.addrSpecView());
+}
+
+std::string_view KeyListInterner::signerKeyID(const UserID::Signature &sig)
+{
+    return intern(sig.signerKeyID());
+}
+
+std::string_view KeyListInterner::signerEmail(const UserID::Signature &sig)
+{
+    return intern(sig.signerEmail());
+}
+
+size_t KeyListInterner::size() const
+{
+    const std::shared_lock<std::shared_mutex> lock(d->mutex);
+    return d->strings.size();
+}
+
+size_t KeyListInterner::bytes() const
+{
+    const std::shared_lock<std::shared_mutex> lock(d->mutex);
+    return d->storedBytes;
+}
+
+uint64_t KeyListInterner::requestedBytes() const
+{
+    return d->requested.load(std::memory_order_relaxed);
+}
+
+void KeyListInterner::clear()
+{
+    const std::unique_lock<std::shared_mutex> lock(d->mutex);
+    d->strings.clear();
+    d->blocks.clear();
+    d->large.clear();
+    d->used = BlockSize;
+    d->storedBytes = 0;
+    d->requested.store(0, std::memory_order_relaxed);
+}
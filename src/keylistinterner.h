@@ -0,0 +1,97 @@
+/*
+  keylistinterner.h - shares the strings of the keys of a listing
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYLISTINTERNER_H__
+#define __GPGMEPP_KEYLISTINTERNER_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace GpgME
+{
+
+/**
+ * Stores a single copy of every distinct string of the keys of a listing.
+ *
+ * The keys of large listings repeat many strings, e.g. the signer key IDs
+ * of the user ID signatures and the names and addresses of the user IDs
+ * of the same people. Applications keeping copies of these strings, e.g.
+ * in indexes or models, can keep the views returned by the interner
+ * instead. Two views returned by the same interner are equal if and only
+ * if they point to the same memory, so comparing them is a pointer compare.
+ *
+ * If an interner is set with Context::setKeyListInterner(), then the
+ * context interns the strings of every key returned by nextKey(), so that
+ * looking them up later does not allocate.
+ *
+ * The views stay valid until the interner is cleared or destroyed. The
+ * interner is thread-safe.
+ */
+class GPGMEPP_EXPORT KeyListInterner
+{
+public:
+    KeyListInterner();
+    ~KeyListInterner();
+
+    /** Returns the shared copy of @p s. */
+    std::string_view intern(std::string_view s);
+    /** Returns the shared copy of @p s, or an empty view if @p s is nullptr. */
+    std::string_view intern(const char *s);
+
+    /** Interns the names, addresses and comments of the user IDs of @p key
+     * and the signer key IDs, names and addresses of their signatures. */
+    void internKey(const Key &key);
+
+    std::string_view name(const UserID &uid);
+    std::string_view email(const UserID &uid);
+    std::string_view comment(const UserID &uid);
+    std::string_view addrSpec(const UserID &uid);
+    std::string_view signerKeyID(const UserID::Signature &sig);
+    std::string_view signerEmail(const UserID::Signature &sig);
+
+    /** The number of distinct strings. */
+    size_t size() const;
+    /** The bytes used for the distinct strings. */
+    size_t bytes() const;
+    /** The bytes of all strings passed to intern(), i.e. the bytes needed
+     * if every string were copied. */
+    uint64_t requestedBytes() const;
+
+    /** Releases all strings. Invalidates all views returned so far. */
+    void clear();
+
+private:
+    KeyListInterner(const KeyListInterner &) = delete;
+    KeyListInterner &operator=(const KeyListInterner &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYLISTINTERNER_H__
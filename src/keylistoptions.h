@@ -0,0 +1,115 @@
+/*
+  keylistoptions.h - compile-time key listing modes
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYLISTOPTIONS_H__
+#define __GPGMEPP_KEYLISTOPTIONS_H__
+
+#include "global.h"
+
+#include <gpgme.h>
+
+namespace GpgME
+{
+
+struct KeyListModeMapping {
+    unsigned int mode;
+    unsigned int gpgmeMode;
+};
+
+/** The gpgme keylist mode for every KeyListMode flag. */
+inline constexpr KeyListModeMapping keyListModeMappings[] = {
+    {Local, GPGME_KEYLIST_MODE_LOCAL},
+    {Extern, GPGME_KEYLIST_MODE_EXTERN},
+    {Signatures, GPGME_KEYLIST_MODE_SIGS},
+    {SignatureNotations, GPGME_KEYLIST_MODE_SIG_NOTATIONS},
+    {Validate, GPGME_KEYLIST_MODE_VALIDATE},
+    {Ephemeral, GPGME_KEYLIST_MODE_EPHEMERAL},
+    {WithTofu, GPGME_KEYLIST_MODE_WITH_TOFU},
+    {WithKeygrip, GPGME_KEYLIST_MODE_WITH_KEYGRIP},
+    {WithSecret, GPGME_KEYLIST_MODE_WITH_SECRET},
+    {ForceExtern, GPGME_KEYLIST_MODE_FORCE_EXTERN},
+};
+
+/** Translates a combination of KeyListMode flags to the gpgme keylist mode.
+ * Unknown flags are ignored. */
+constexpr unsigned int toGpgmeKeyListMode(unsigned int modes)
+{
+    unsigned int result = 0;
+    for (const KeyListModeMapping &mapping : keyListModeMappings) {
+        if (modes & mapping.mode) {
+            result |= mapping.gpgmeMode;
+        }
+    }
+    return result;
+}
+
+/** Translates a gpgme keylist mode to KeyListMode flags. Unknown modes are
+ * ignored. */
+constexpr unsigned int fromGpgmeKeyListMode(unsigned int gpgmeModes)
+{
+    unsigned int result = 0;
+    for (const KeyListModeMapping &mapping : keyListModeMappings) {
+        if (gpgmeModes & mapping.gpgmeMode) {
+            result |= mapping.mode;
+        }
+    }
+    return result;
+}
+
+/** Returns false for unknown flags and for ForceExtern without Locate, which
+ * has no effect. */
+constexpr bool isValidKeyListMode(unsigned int modes)
+{
+    return !(modes & ~KeyListModeMask)
+        && (!(modes & ForceExtern) || (modes & Locate) == Locate);
+}
+
+/**
+ * A key listing mode fixed at compile time.
+ *
+ * The gpgme keylist mode is computed by the compiler, so that
+ * Context::setKeyListMode(KeyListOptions<...>()) does not translate the
+ * mode at runtime, and invalid combinations are rejected when compiling.
+ *
+ * Example:
+ * \code
+ * using FullKeyListing = KeyListOptions<Local, Signatures, Validate, WithSecret>;
+ * ctx->setKeyListMode(FullKeyListing());
+ * \endcode
+ */
+template <KeyListMode... Modes>
+struct KeyListOptions {
+    static constexpr unsigned int modes = (0u | ... | static_cast<unsigned int>(Modes));
+    static constexpr unsigned int gpgmeModes = toGpgmeKeyListMode(modes);
+
+    static_assert(isValidKeyListMode(modes), "invalid combination of key listing modes");
+
+    constexpr operator unsigned int() const
+    {
+        return modes;
+    }
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYLISTOPTIONS_H__
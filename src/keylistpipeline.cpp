@@ -0,0 +1,252 @@
+/*
+  keylistpipeline.cpp - processes listed keys on several threads
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keylistpipeline.h>
+#include <context.h>
+#include <keylistrange.h>
+#include <keylistresult.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using namespace GpgME;
+
+class KeyListPipeline::Private
+{
+public:
+    Private(unsigned int t, size_t q)
+        : threads(t ? t : std::max(1u, std::thread::hardware_concurrency())),
+          capacity(std::max<size_t>(q, 1)),
+          ordered(true),
+          inFlight(0),
+          listingDone(false),
+          nextToDeliver(0)
+    {
+    }
+
+    void reset()
+    {
+        queue.clear();
+        inFlight = 0;
+        listingDone = false;
+        pending.clear();
+        nextToDeliver = 0;
+        stats = Statistics();
+    }
+
+    // called by the thread running the listing; blocks while the pipeline is full
+    void enqueue(const Key &key, size_t index)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        spaceAvailable.wait(lock, [this]() {
+            return inFlight < capacity;
+        });
+        queue.emplace_back(index, key);
+        ++inFlight;
+        ++stats.keys;
+        keysAvailable.notify_one();
+    }
+
+    void finishListing()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            listingDone = true;
+        }
+        keysAvailable.notify_all();
+    }
+
+    void work(const Callback &callback)
+    {
+        while (true) {
+            std::pair<size_t, Key> item;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                keysAvailable.wait(lock, [this]() {
+                    return !queue.empty() || listingDone;
+                });
+                if (queue.empty()) {
+                    return;
+                }
+                item = std::move(queue.front());
+                queue.pop_front();
+            }
+            const KeyView view(item.second);
+            const bool keep = std::all_of(transforms.begin(), transforms.end(), [&view, &item](const Transform &transform) {
+                return transform(view, item.first);
+            });
+            deliver(item.first, keep ? std::move(item.second) : Key(), keep, callback);
+        }
+    }
+
+    void deliver(size_t index, Key &&key, bool keep, const Callback &callback)
+    {
+        size_t delivered = 0;
+        {
+            const std::lock_guard<std::mutex> lock(deliveryMutex);
+            if (!ordered) {
+                if (keep && callback) {
+                    callback(key, index);
+                }
+                delivered = 1;
+            } else {
+                // a null key marks a dropped key
+                pending.emplace(index, std::move(key));
+                for (auto it = pending.begin(); it != pending.end() && it->first == nextToDeliver; it = pending.erase(it)) {
+                    if (!it->second.isNull() && callback) {
+                        callback(it->second, it->first);
+                    }
+                    ++nextToDeliver;
+                    ++delivered;
+                }
+            }
+        }
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (!keep) {
+                ++stats.dropped;
+            }
+            inFlight -= delivered;
+        }
+        if (delivered) {
+            spaceAvailable.notify_one();
+        }
+    }
+
+    const unsigned int threads;
+    const size_t capacity;
+    std::vector<Transform> transforms;
+    bool ordered;
+
+    std::mutex mutex;
+    std::condition_variable keysAvailable;
+    std::condition_variable spaceAvailable;
+    std::deque<std::pair<size_t, Key>> queue;
+    size_t inFlight;
+    bool listingDone;
+
+    std::mutex deliveryMutex;
+    std::map<size_t, Key> pending;
+    size_t nextToDeliver;
+
+    KeyListResult res;
+    Statistics stats;
+};
+
+KeyListPipeline::KeyListPipeline(unsigned int threads, size_t queueSize)
+    : d(new Private(threads, queueSize))
+{
+}
+
+KeyListPipeline::~KeyListPipeline() = default;
+
+unsigned int KeyListPipeline::threadCount() const
+{
+    return d->threads;
+}
+
+size_t KeyListPipeline::queueSize() const
+{
+    return d->capacity;
+}
+
+void KeyListPipeline::addTransform(const Transform &transform)
+{
+    if (transform) {
+        d->transforms.push_back(transform);
+    }
+}
+
+void KeyListPipeline::setOrdered(bool ordered)
+{
+    d->ordered = ordered;
+}
+
+bool KeyListPipeline::isOrdered() const
+{
+    return d->ordered;
+}
+
+Error KeyListPipeline::run(Context *ctx, const std::vector<std::string> &patterns, unsigned int mode,
+                           bool secretOnly, const Callback &callback)
+{
+    d->reset();
+    if (!ctx) {
+        d->res = KeyListResult(Error::fromCode(GPG_ERR_INV_VALUE));
+        return d->res.error();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    workers.reserve(d->threads);
+    for (unsigned int i = 0; i < d->threads; ++i) {
+        workers.emplace_back(&Private::work, d.get(), std::cref(callback));
+    }
+
+    Error err;
+    {
+        KeyListRange range = ctx->listKeys(patterns, mode, secretOnly);
+        size_t index = 0;
+        for (const Key &key : range) {
+            d->enqueue(key, index++);
+        }
+        err = range.error();
+        d->res = range.result();
+    }
+    d->finishListing();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    d->stats.seconds = elapsed.count();
+    return err;
+}
+
+std::vector<Key> KeyListPipeline::run(Context *ctx, const std::vector<std::string> &patterns, unsigned int mode,
+                                      bool secretOnly, Error &err)
+{
+    std::vector<Key> keys;
+    err = run(ctx, patterns, mode, secretOnly, [&keys](const Key &key, size_t) {
+        keys.push_back(key);
+    });
+    return keys;
+}
+
+KeyListResult KeyListPipeline::result() const
+{
+    return d->res;
+}
+
+KeyListPipeline::Statistics KeyListPipeline::statistics() const
+{
+    return d->stats;
+}
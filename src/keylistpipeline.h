@@ -0,0 +1,122 @@
+/*
+  keylistpipeline.h - processes listed keys on several threads
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYLISTPIPELINE_H__
+#define __GPGMEPP_KEYLISTPIPELINE_H__
+
+#include "global.h"
+#include "error.h"
+#include "key.h"
+#include "keyview.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class KeyListResult;
+
+/**
+ * Runs transforms on the keys of a key listing on several threads while
+ * the engine is still listing keys.
+ *
+ * The thread calling run() fetches the keys from the context and passes
+ * them to the worker threads through a bounded queue, so that the number
+ * of keys in memory does not depend on the size of the keyring. Every
+ * worker runs all transforms, in the order they were added, on the keys
+ * it takes from the queue, e.g. to check the validity of the signatures,
+ * to look up remarks, or to evaluate the TofuInfo of the user IDs.
+ *
+ * The transforms get a KeyView and the number of the key in the listing,
+ * which can be used to store the results of the transform without
+ * locking. The keys which pass all transforms are passed to the callback,
+ * which is called serialized and, if the pipeline is ordered, in the order
+ * of the listing.
+ */
+class GPGMEPP_EXPORT KeyListPipeline
+{
+public:
+    /** Called on a worker thread. Returns false to drop the key. */
+    using Transform = std::function<bool(const KeyView &key, size_t index)>;
+    /** Called serialized with the keys passing all transforms. */
+    using Callback = std::function<void(const Key &key, size_t index)>;
+
+    struct Statistics {
+        unsigned long keys = 0;
+        unsigned long dropped = 0;
+        double seconds = 0;
+
+        double keysPerSecond() const
+        {
+            return seconds > 0 ? keys / seconds : 0;
+        }
+    };
+
+    /** If @p threads is 0, then one worker per hardware thread is used.
+     * At most @p queueSize keys are waiting for or in the transforms. */
+    explicit KeyListPipeline(unsigned int threads = 0, size_t queueSize = 256);
+    ~KeyListPipeline();
+
+    unsigned int threadCount() const;
+    size_t queueSize() const;
+
+    void addTransform(const Transform &transform);
+
+    /** If @p ordered is true (the default), then the callback gets the
+     * keys in the order of the listing, at the cost of keeping the keys
+     * finished early until the ones before them are finished. */
+    void setOrdered(bool ordered);
+    bool isOrdered() const;
+
+    /**
+     * Lists the keys matching @p patterns with @p ctx (see
+     * Context::listKeys()) and passes them through the transforms to
+     * @p callback. Returns when all keys have been processed. Returns the
+     * error of the key listing.
+     */
+    Error run(Context *ctx, const std::vector<std::string> &patterns, unsigned int mode,
+              bool secretOnly, const Callback &callback);
+    /** Same as above, but returns the keys passing all transforms. */
+    std::vector<Key> run(Context *ctx, const std::vector<std::string> &patterns, unsigned int mode,
+                         bool secretOnly, Error &err);
+
+    /** Returns the result of the key listing of the last run. */
+    KeyListResult result() const;
+    /** Returns the statistics of the last run. */
+    Statistics statistics() const;
+
+private:
+    KeyListPipeline(const KeyListPipeline &) = delete;
+    KeyListPipeline &operator=(const KeyListPipeline &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYLISTPIPELINE_H__
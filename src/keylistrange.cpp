@@ -0,0 +1,172 @@
+/*
+  keylistrange.cpp - a lazy range of listed keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keylistrange.h>
+#include <context.h>
+#include <keylistresult.h>
+
+#include "util.h"
+
+using namespace GpgME;
+
+class KeyListRange::Private
+{
+public:
+    Private(Context *c, unsigned int mode)
+        : ctx(c),
+          savedMode(ctx->keyListMode()),
+          restoreMode(mode != 0),
+          running(false),
+          begun(false)
+    {
+        if (restoreMode) {
+            ctx->setKeyListMode(mode);
+        }
+    }
+
+    ~Private()
+    {
+        if (running) {
+            ctx->cancelPendingOperationImmediately();
+            finish();
+        }
+    }
+
+    // fetches the next key; returns false at the end of the listing
+    bool advance()
+    {
+        if (!running) {
+            current = Key();
+            return false;
+        }
+        Error e;
+        current = ctx->nextKey(e);
+        if (e) {
+            if (e.code() != GPG_ERR_EOF) {
+                err = e;
+            }
+            current = Key();
+            finish();
+            return false;
+        }
+        return true;
+    }
+
+    void finish()
+    {
+        running = false;
+        res = ctx->endKeyListing();
+        if (restoreMode) {
+            ctx->setKeyListMode(savedMode);
+            restoreMode = false;
+        }
+    }
+
+    Context *const ctx;
+    const unsigned int savedMode;
+    bool restoreMode;
+    bool running;
+    bool begun;
+    Key current;
+    Error err;
+    KeyListResult res;
+};
+
+KeyListRange::KeyListRange(Context *ctx, const std::vector<std::string> &patterns, unsigned int mode, bool secretOnly)
+    : d(new Private(ctx, mode))
+{
+    const StringsToCStrings cpatterns{patterns};
+    d->err = patterns.empty() ? ctx->startKeyListing(static_cast<const char *>(nullptr), secretOnly)
+                              : ctx->startKeyListing(cpatterns.c_strs(), secretOnly);
+    if (d->err) {
+        d->res = KeyListResult(d->err);
+        if (d->restoreMode) {
+            ctx->setKeyListMode(d->savedMode);
+            d->restoreMode = false;
+        }
+    } else {
+        d->running = true;
+    }
+}
+
+KeyListRange::KeyListRange(KeyListRange &&other) noexcept = default;
+
+KeyListRange &KeyListRange::operator=(KeyListRange &&other) noexcept = default;
+
+KeyListRange::~KeyListRange() = default;
+
+KeyListRange::iterator KeyListRange::begin()
+{
+    if (!d) {
+        return end();
+    }
+    if (!d->begun) {
+        d->begun = true;
+        d->advance();
+    }
+    return d->running ? iterator(this) : end();
+}
+
+KeyListRange::iterator KeyListRange::end()
+{
+    return iterator();
+}
+
+void KeyListRange::cancel()
+{
+    if (d && d->running) {
+        d->ctx->cancelPendingOperationImmediately();
+        d->finish();
+        d->current = Key();
+    }
+}
+
+Error KeyListRange::error() const
+{
+    return d ? d->err : Error();
+}
+
+KeyListResult KeyListRange::result() const
+{
+    return d ? d->res : KeyListResult();
+}
+
+const Key &KeyListRange::iterator::operator*() const
+{
+    return mRange->d->current;
+}
+
+KeyListRange::iterator &KeyListRange::iterator::operator++()
+{
+    if (mRange && !mRange->d->advance()) {
+        mRange = nullptr;
+    }
+    return *this;
+}
+
+bool KeyListRange::iterator::operator==(const iterator &other) const
+{
+    return mRange == other.mRange;
+}
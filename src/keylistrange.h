@@ -0,0 +1,125 @@
+/*
+  keylistrange.h - a lazy range of listed keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYLISTRANGE_H__
+#define __GPGMEPP_KEYLISTRANGE_H__
+
+#include "global.h"
+#include "error.h"
+#include "key.h"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class KeyListResult;
+
+/**
+ * An input range over the keys of a key listing, as returned by
+ * Context::listKeys().
+ *
+ * The keys are fetched from the engine one by one while the range is
+ * iterated. If the range is destroyed (or cancel() is called) before all
+ * keys have been listed, then the key listing is canceled, so that
+ * queries like "the first N matches" do not have to wait for the listing
+ * to finish.
+ *
+ * The range can be iterated only once. The context must outlive the range
+ * and must not be used for other operations while the range is active.
+ */
+class GPGMEPP_EXPORT KeyListRange
+{
+public:
+    class GPGMEPP_EXPORT iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key *;
+        using reference = const Key &;
+
+        iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const
+        {
+            return &operator*();
+        }
+        iterator &operator++();
+        void operator++(int)
+        {
+            ++*this;
+        }
+
+        bool operator==(const iterator &other) const;
+        bool operator!=(const iterator &other) const
+        {
+            return !operator==(other);
+        }
+
+    private:
+        friend class ::GpgME::KeyListRange;
+        explicit iterator(KeyListRange *range)
+            : mRange(range)
+        {
+        }
+        KeyListRange *mRange = nullptr;
+    };
+
+    KeyListRange(KeyListRange &&other) noexcept;
+    KeyListRange &operator=(KeyListRange &&other) noexcept;
+    ~KeyListRange();
+
+    iterator begin();
+    iterator end();
+
+    /** Stops the key listing. Afterwards the range is at its end. */
+    void cancel();
+
+    /** Returns the error of the key listing. End of listing (GPG_ERR_EOF)
+     * is not an error. */
+    Error error() const;
+
+    /** Returns the result of the key listing once the end has been reached. */
+    KeyListResult result() const;
+
+private:
+    friend class ::GpgME::Context;
+    KeyListRange(Context *ctx, const std::vector<std::string> &patterns, unsigned int mode, bool secretOnly);
+
+    KeyListRange(const KeyListRange &) = delete;
+    KeyListRange &operator=(const KeyListRange &) = delete;
+
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYLISTRANGE_H__
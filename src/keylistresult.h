@@ -46,6 +46,7 @@ public:
     KeyListResult(const Error &err, const _gpgme_op_keylist_result &res);
 
     KeyListResult(const KeyListResult &other) = default;
+    KeyListResult(KeyListResult &&other) = default;
     const KeyListResult &operator=(KeyListResult other)
     {
         swap(other);
@@ -0,0 +1,319 @@
+/*
+  keylocator.cpp - cached and concurrent key lookups by mail address
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keylocator.h>
+#include <assuansession.h>
+#include <context.h>
+#include <contextpool.h>
+#include <data.h>
+#include <defaultassuantransaction.h>
+#include <keylistrange.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+using namespace GpgME;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+std::string toLower(const std::string &s)
+{
+    std::string result = s;
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+    return result;
+}
+
+// errors which mean that there is no key for the address
+bool isNotFound(const Error &err)
+{
+    switch (err.code()) {
+    case GPG_ERR_NO_NAME:
+    case GPG_ERR_NO_DATA:
+    case GPG_ERR_NOT_FOUND:
+    case GPG_ERR_NO_PUBKEY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct Entry {
+    Key key;
+    Clock::time_point expires;
+};
+}
+
+class KeyLocator::Private
+{
+public:
+    Private(Method m, unsigned int c)
+        : method(m),
+          concurrency(c ? c : 1),
+          positiveTtl(std::chrono::hours(1)),
+          negativeTtl(std::chrono::minutes(5)),
+          pool(OpenPGP, [](Context &ctx) {
+              ctx.setKeyListMode(Extern | Local);
+          }),
+          running(0)
+    {
+    }
+
+    Result lookup(const std::string &mbox)
+    {
+        {
+            std::unique_lock<std::mutex> lock(slotMutex);
+            slotAvailable.wait(lock, [this]() {
+                return running < concurrency;
+            });
+            ++running;
+        }
+        const Result result = method == WKD ? lookupWKD(mbox) : lookupKeyList(mbox);
+        {
+            const std::lock_guard<std::mutex> lock(slotMutex);
+            --running;
+        }
+        slotAvailable.notify_one();
+        return result;
+    }
+
+    Result lookupKeyList(const std::string &mbox)
+    {
+        Result result;
+        ContextPool::Lease lease = pool.acquire(&result.error);
+        if (!lease) {
+            return result;
+        }
+        KeyListRange range = lease->listKeys({mbox});
+        for (const Key &key : range) {
+            result.key = key;
+            // like Key::locate(), only the first key counts
+            break;
+        }
+        if (result.key.isNull()) {
+            result.error = range.error();
+        }
+        return result;
+    }
+
+    Result lookupWKD(const std::string &mbox)
+    {
+        Result result;
+        std::unique_ptr<AssuanSession> session = takeSession();
+        DefaultAssuanTransaction transaction;
+        const std::string command = "WKD_GET " + mbox;
+        result.error = session->transact(command.c_str(), &transaction);
+        returnSession(std::move(session));
+        if (result.error) {
+            return result;
+        }
+        const std::string &raw = transaction.data();
+        if (!raw.empty()) {
+            const Data data(raw.c_str(), raw.size(), false);
+            const std::vector<Key> keys = data.toKeys(OpenPGP);
+            if (!keys.empty()) {
+                result.key = keys.front();
+            }
+        }
+        return result;
+    }
+
+    std::unique_ptr<AssuanSession> takeSession()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(sessionMutex);
+            if (!sessions.empty()) {
+                std::unique_ptr<AssuanSession> session = std::move(sessions.back());
+                sessions.pop_back();
+                return session;
+            }
+        }
+        return std::unique_ptr<AssuanSession>(new AssuanSession(dirInfo("dirmngr-socket")));
+    }
+
+    void returnSession(std::unique_ptr<AssuanSession> &&session)
+    {
+        const std::lock_guard<std::mutex> lock(sessionMutex);
+        sessions.push_back(std::move(session));
+    }
+
+    const Method method;
+    const unsigned int concurrency;
+
+    mutable std::mutex mutex;
+    std::chrono::seconds positiveTtl;
+    std::chrono::seconds negativeTtl;
+    std::unordered_map<std::string, Entry> cache;
+    std::unordered_map<std::string, std::shared_future<Result>> inFlight;
+    Statistics stats;
+
+    ContextPool pool;
+    std::mutex sessionMutex;
+    std::vector<std::unique_ptr<AssuanSession>> sessions;
+
+    std::mutex slotMutex;
+    std::condition_variable slotAvailable;
+    unsigned int running;
+};
+
+KeyLocator::KeyLocator(Method method, unsigned int concurrency)
+    : d(new Private(method, concurrency))
+{
+}
+
+KeyLocator::~KeyLocator() = default;
+
+KeyLocator::Method KeyLocator::method() const
+{
+    return d->method;
+}
+
+unsigned int KeyLocator::concurrency() const
+{
+    return d->concurrency;
+}
+
+void KeyLocator::setPositiveTtl(std::chrono::seconds ttl)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->positiveTtl = ttl;
+}
+
+std::chrono::seconds KeyLocator::positiveTtl() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->positiveTtl;
+}
+
+void KeyLocator::setNegativeTtl(std::chrono::seconds ttl)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->negativeTtl = ttl;
+}
+
+std::chrono::seconds KeyLocator::negativeTtl() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->negativeTtl;
+}
+
+KeyLocator::Result KeyLocator::locate(const std::string &mbox)
+{
+    const std::string address = toLower(mbox);
+    std::promise<Result> promise;
+    {
+        std::unique_lock<std::mutex> lock(d->mutex);
+        const auto it = d->cache.find(address);
+        if (it != d->cache.end()) {
+            if (Clock::now() < it->second.expires) {
+                Result result;
+                result.key = it->second.key;
+                result.cached = true;
+                if (result.key.isNull()) {
+                    ++d->stats.negativeHits;
+                } else {
+                    ++d->stats.hits;
+                }
+                return result;
+            }
+            d->cache.erase(it);
+        }
+        const auto flight = d->inFlight.find(address);
+        if (flight != d->inFlight.end()) {
+            const std::shared_future<Result> pending = flight->second;
+            ++d->stats.joined;
+            lock.unlock();
+            return pending.get();
+        }
+        d->inFlight.emplace(address, promise.get_future().share());
+        ++d->stats.lookups;
+    }
+
+    Result result = d->lookup(mbox);
+    if (result.error && isNotFound(result.error)) {
+        result.error = Error();
+    }
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        if (!result.error) {
+            const auto ttl = result.key.isNull() ? d->negativeTtl : d->positiveTtl;
+            if (ttl.count() > 0) {
+                d->cache[address] = Entry{result.key, Clock::now() + ttl};
+            }
+        }
+        d->inFlight.erase(address);
+    }
+    promise.set_value(result);
+    return result;
+}
+
+std::vector<KeyLocator::Result> KeyLocator::locate(const std::vector<std::string> &mboxes)
+{
+    std::vector<Result> results(mboxes.size());
+    std::atomic<size_t> next{0};
+    const auto work = [this, &mboxes, &results, &next]() {
+        for (size_t i = next++; i < mboxes.size(); i = next++) {
+            results[i] = locate(mboxes[i]);
+        }
+    };
+    const size_t threadCount = std::min<size_t>(d->concurrency, mboxes.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+void KeyLocator::invalidate(const std::string &mbox)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->cache.erase(toLower(mbox));
+}
+
+void KeyLocator::clear()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->cache.clear();
+}
+
+KeyLocator::Statistics KeyLocator::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
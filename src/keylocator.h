@@ -0,0 +1,116 @@
+/*
+  keylocator.h - cached and concurrent key lookups by mail address
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYLOCATOR_H__
+#define __GPGMEPP_KEYLOCATOR_H__
+
+#include "global.h"
+#include "error.h"
+#include "key.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Locates the OpenPGP keys of mail addresses and caches the results.
+ *
+ * Found keys are cached for the positive TTL and addresses without a key
+ * for the (usually shorter) negative TTL. Failed lookups, e.g. because
+ * the network is down, are not cached. Concurrent lookups of the same
+ * address are run only once; the other callers wait for its result.
+ *
+ * With the KeyList method the keys are located like Key::locate() does,
+ * i.e. with an Extern | Local key listing, which imports keys found
+ * externally. With the WKD method the keys are fetched from the Web Key
+ * Directory by dirmngr with WKD_GET and are not imported; dirmngr must be
+ * running (e.g. started with gpgconf --launch dirmngr). The contexts and
+ * the dirmngr connections are reused between lookups.
+ *
+ * The locator is thread-safe.
+ */
+class GPGMEPP_EXPORT KeyLocator
+{
+public:
+    enum Method {
+        KeyList,
+        WKD,
+    };
+
+    struct Result {
+        /** The first key found, or a null key. */
+        Key key;
+        /** Set only if the lookup failed, not if no key was found. */
+        Error error;
+        /** True if the result was taken from the cache. */
+        bool cached = false;
+    };
+
+    struct Statistics {
+        unsigned long hits = 0;
+        unsigned long negativeHits = 0;
+        unsigned long lookups = 0;
+        /** Lookups which waited for a concurrent lookup of the same address. */
+        unsigned long joined = 0;
+    };
+
+    /** At most @p concurrency lookups run at the same time. */
+    explicit KeyLocator(Method method = KeyList, unsigned int concurrency = 4);
+    ~KeyLocator();
+
+    Method method() const;
+    unsigned int concurrency() const;
+
+    void setPositiveTtl(std::chrono::seconds ttl);
+    std::chrono::seconds positiveTtl() const;
+    void setNegativeTtl(std::chrono::seconds ttl);
+    std::chrono::seconds negativeTtl() const;
+
+    /** Returns the key for the mail address @p mbox. Blocks while the key
+     * is looked up. */
+    Result locate(const std::string &mbox);
+    /** Looks up all @p mboxes concurrently and returns the results in the
+     * same order. */
+    std::vector<Result> locate(const std::vector<std::string> &mboxes);
+
+    /** Drops the cached result for @p mbox. */
+    void invalidate(const std::string &mbox);
+    void clear();
+
+    Statistics statistics() const;
+
+private:
+    KeyLocator(const KeyLocator &) = delete;
+    KeyLocator &operator=(const KeyLocator &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYLOCATOR_H__
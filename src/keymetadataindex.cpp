@@ -0,0 +1,645 @@
+/*
+  keymetadataindex.cpp - a persistent index of key metadata
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keymetadataindex.h>
+#include <context.h>
+#include <fingerprint.h>
+#include <keylistresult.h>
+#include <keyringsnapshot.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace GpgME;
+
+namespace
+{
+
+const char indexMagic[8] = {'G', 'P', 'G', 'M', 'E', 'K', 'M', 'I'};
+const uint32_t byteOrderMark = 0x01020304;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    int64_t keyringTime;
+    uint64_t keyringSize;
+    uint64_t numRecords;
+    uint64_t numEmails;
+    uint64_t numKeygrips;
+    uint64_t stringsSize;
+    uint64_t recordsOffset;
+    uint64_t emailsOffset;
+    uint64_t keygripsOffset;
+    uint64_t stringsOffset;
+};
+
+// records are sorted by fingerprint
+struct FileRecord {
+    unsigned char fingerprint[Fingerprint::MaximumSize];
+    uint8_t fingerprintSize;
+    uint8_t protocol;
+    uint8_t validity;
+    uint8_t ownerTrust;
+    uint32_t flags;
+    uint32_t algorithm;
+    uint32_t length;
+    int64_t creationTime;
+    int64_t expirationTime;
+    // offset of the primary user ID in the string table plus 1, or 0
+    uint32_t userID;
+    uint32_t reserved;
+};
+
+// sorted by email address
+struct EmailEntry {
+    uint32_t email;
+    uint32_t record;
+};
+
+// sorted by keygrip
+struct KeygripEntry {
+    unsigned char keygrip[20];
+    uint32_t record;
+};
+
+struct KeyringStamp {
+    int64_t time = 0;
+    uint64_t size = 0;
+
+    bool operator==(const KeyringStamp &other) const
+    {
+        return time == other.time && size == other.size;
+    }
+};
+
+KeyringStamp keyring_stamp(const std::string &keyringFile)
+{
+    KeyringStamp stamp;
+    if (keyringFile.empty()) {
+        return stamp;
+    }
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(keyringFile, ec);
+    if (!ec) {
+        stamp.time = mtime.time_since_epoch().count();
+    }
+    const auto size = std::filesystem::file_size(keyringFile, ec);
+    if (!ec) {
+        stamp.size = size;
+    }
+    return stamp;
+}
+
+std::string normalized_email(const char *email)
+{
+    std::string s(email ? email : "");
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return s;
+}
+
+// a 40 digit keygrip has the same form as a version 4 fingerprint
+Fingerprint parse_keygrip(const char *keygrip)
+{
+    const Fingerprint grip(keygrip);
+    return grip.size() == 20 ? grip : Fingerprint();
+}
+
+size_t align8(size_t n)
+{
+    return (n + 7) & ~size_t(7);
+}
+
+template <typename T>
+void append(std::string &buffer, const T &value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+}
+
+class KeyMetadataIndex::Private
+{
+public:
+    ~Private()
+    {
+        unmap();
+    }
+
+    void unmap()
+    {
+#ifndef _WIN32
+        if (map) {
+            munmap(map, mapLength);
+        }
+#endif
+        map = nullptr;
+        mapLength = 0;
+        buffer.clear();
+        header = nullptr;
+    }
+
+    // the contents of the file, either mapped or read into buffer
+    const char *data() const
+    {
+        return map ? static_cast<const char *>(map) : buffer.data();
+    }
+
+    const FileRecord &record(size_t i) const
+    {
+        return reinterpret_cast<const FileRecord *>(data() + header->recordsOffset)[i];
+    }
+    const EmailEntry *emails() const
+    {
+        return reinterpret_cast<const EmailEntry *>(data() + header->emailsOffset);
+    }
+    const KeygripEntry *keygrips() const
+    {
+        return reinterpret_cast<const KeygripEntry *>(data() + header->keygripsOffset);
+    }
+    const char *string(uint32_t offset) const
+    {
+        return data() + header->stringsOffset + offset;
+    }
+
+    Error validate(size_t fileSize) const
+    {
+        if (fileSize < sizeof(FileHeader) || memcmp(header->magic, indexMagic, sizeof(indexMagic)) != 0) {
+            return Error::fromCode(GPG_ERR_INV_DATA);
+        }
+        if (header->version != FormatVersion || header->byteOrder != byteOrderMark) {
+            return Error::fromCode(GPG_ERR_UNKNOWN_VERSION);
+        }
+        // the tables are accessed in place, so they must be aligned
+        if (header->recordsOffset % alignof(FileRecord) != 0
+                || header->emailsOffset % alignof(EmailEntry) != 0
+                || header->keygripsOffset % alignof(KeygripEntry) != 0) {
+            return Error::fromCode(GPG_ERR_INV_DATA);
+        }
+        const auto fits = [fileSize](uint64_t offset, uint64_t count, size_t size) {
+            return offset <= fileSize && count <= (fileSize - offset) / size;
+        };
+        if (!fits(header->recordsOffset, header->numRecords, sizeof(FileRecord))
+                || !fits(header->emailsOffset, header->numEmails, sizeof(EmailEntry))
+                || !fits(header->keygripsOffset, header->numKeygrips, sizeof(KeygripEntry))
+                || !fits(header->stringsOffset, header->stringsSize, 1)) {
+            return Error::fromCode(GPG_ERR_TRUNCATED);
+        }
+        // all strings are terminated if the table is
+        if (header->stringsSize == 0 || string(header->stringsSize - 1)[0] != '\0') {
+            return Error::fromCode(GPG_ERR_INV_DATA);
+        }
+        for (size_t i = 0; i < header->numRecords; ++i) {
+            if (record(i).userID > header->stringsSize || record(i).fingerprintSize > Fingerprint::MaximumSize) {
+                return Error::fromCode(GPG_ERR_INV_DATA);
+            }
+        }
+        for (size_t i = 0; i < header->numEmails; ++i) {
+            if (emails()[i].email >= header->stringsSize || emails()[i].record >= header->numRecords) {
+                return Error::fromCode(GPG_ERR_INV_DATA);
+            }
+        }
+        for (size_t i = 0; i < header->numKeygrips; ++i) {
+            if (keygrips()[i].record >= header->numRecords) {
+                return Error::fromCode(GPG_ERR_INV_DATA);
+            }
+        }
+        return Error();
+    }
+
+    Error load(const std::string &fileName)
+    {
+#ifndef _WIN32
+        const int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return Error::fromSystemError();
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0) {
+            const Error err = Error::fromSystemError();
+            ::close(fd);
+            return err;
+        }
+        if (st.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+            ::close(fd);
+            return Error::fromCode(GPG_ERR_INV_DATA);
+        }
+        void *const m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int mapErrno = errno;
+        ::close(fd);
+        if (m == MAP_FAILED) {
+            return Error::fromErrno(mapErrno);
+        }
+        map = m;
+        mapLength = st.st_size;
+#else
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file) {
+            return Error::fromCode(GPG_ERR_ENOENT);
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (buffer.size() < sizeof(FileHeader)) {
+            buffer.clear();
+            return Error::fromCode(GPG_ERR_INV_DATA);
+        }
+#endif
+        header = reinterpret_cast<const FileHeader *>(data());
+        const Error err = validate(map ? mapLength : buffer.size());
+        if (err) {
+            unmap();
+        }
+        return err;
+    }
+
+    void *map = nullptr;
+    size_t mapLength = 0;
+    std::string buffer;
+    const FileHeader *header = nullptr;
+    std::string keyringFile;
+};
+
+KeyMetadataIndex::KeyMetadataIndex()
+    : d(new Private)
+{
+}
+
+KeyMetadataIndex::KeyMetadataIndex(KeyMetadataIndex &&other) noexcept = default;
+
+KeyMetadataIndex &KeyMetadataIndex::operator=(KeyMetadataIndex &&other) noexcept = default;
+
+KeyMetadataIndex::~KeyMetadataIndex() = default;
+
+// static
+Error KeyMetadataIndex::write(const std::string &fileName, const std::vector<Key> &keys, const std::string &keyringFile)
+{
+    // sort the keys by fingerprint and drop duplicates
+    std::vector<std::pair<Fingerprint, const Key *>> sorted;
+    sorted.reserve(keys.size());
+    for (const Key &key : keys) {
+        const Fingerprint fpr(key);
+        if (!fpr.isNull()) {
+            sorted.emplace_back(fpr, &key);
+        }
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first < rhs.first;
+    });
+    sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.first == rhs.first;
+    }), sorted.end());
+
+    std::string strings(1, '\0');
+    std::vector<FileRecord> records;
+    std::vector<std::pair<std::string, uint32_t>> emails;
+    std::vector<KeygripEntry> keygrips;
+    records.reserve(sorted.size());
+    for (const auto &entry : sorted) {
+        const Key &key = *entry.second;
+        const uint32_t recordNumber = records.size();
+        const ChildRange<Subkey> subkeys = key.subkeyRange();
+        const ChildRange<UserID> uids = key.userIDRange();
+        const Subkey primary = subkeys.empty() ? Subkey() : *subkeys.begin();
+        const UserID uid = uids.empty() ? UserID() : *uids.begin();
+
+        FileRecord record = {};
+        std::memcpy(record.fingerprint, entry.first.data(), entry.first.size());
+        record.fingerprintSize = entry.first.size();
+        record.protocol = key.protocol();
+        record.validity = uid.isNull() ? UserID::Unknown : uid.validity();
+        record.ownerTrust = key.ownerTrust();
+        record.flags = KeyringSnapshot::flagsOf(key);
+        record.algorithm = primary.publicKeyAlgorithm();
+        record.length = primary.length();
+        record.creationTime = primary.creationTime();
+        record.expirationTime = primary.expirationTime();
+        if (uid.id()) {
+            record.userID = strings.size() + 1;
+            strings.append(uid.id());
+            strings.push_back('\0');
+        }
+        records.push_back(record);
+
+        for (const UserID &u : uids) {
+            std::string email = normalized_email(u.addrSpec().c_str());
+            if (!email.empty()) {
+                emails.emplace_back(std::move(email), recordNumber);
+            }
+        }
+        for (const Subkey &subkey : subkeys) {
+            const Fingerprint grip = parse_keygrip(subkey.keyGrip());
+            if (!grip.isNull()) {
+                KeygripEntry e = {};
+                std::memcpy(e.keygrip, grip.data(), sizeof(e.keygrip));
+                e.record = recordNumber;
+                keygrips.push_back(e);
+            }
+        }
+    }
+
+    std::sort(emails.begin(), emails.end());
+    emails.erase(std::unique(emails.begin(), emails.end()), emails.end());
+    std::vector<EmailEntry> emailEntries;
+    emailEntries.reserve(emails.size());
+    for (const auto &email : emails) {
+        emailEntries.push_back({static_cast<uint32_t>(strings.size()), email.second});
+        strings.append(email.first);
+        strings.push_back('\0');
+    }
+    std::sort(keygrips.begin(), keygrips.end(), [](const KeygripEntry &lhs, const KeygripEntry &rhs) {
+        return std::memcmp(lhs.keygrip, rhs.keygrip, sizeof(lhs.keygrip)) < 0;
+    });
+
+    const KeyringStamp stamp = keyring_stamp(keyringFile);
+    FileHeader header = {};
+    std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+    header.version = FormatVersion;
+    header.byteOrder = byteOrderMark;
+    header.keyringTime = stamp.time;
+    header.keyringSize = stamp.size;
+    header.numRecords = records.size();
+    header.numEmails = emailEntries.size();
+    header.numKeygrips = keygrips.size();
+    header.stringsSize = strings.size();
+    header.recordsOffset = align8(sizeof(FileHeader));
+    header.emailsOffset = align8(header.recordsOffset + records.size() * sizeof(FileRecord));
+    header.keygripsOffset = align8(header.emailsOffset + emailEntries.size() * sizeof(EmailEntry));
+    header.stringsOffset = align8(header.keygripsOffset + keygrips.size() * sizeof(KeygripEntry));
+
+    std::string buffer;
+    buffer.reserve(header.stringsOffset + strings.size());
+    append(buffer, header);
+    buffer.resize(header.recordsOffset);
+    for (const FileRecord &record : records) {
+        append(buffer, record);
+    }
+    buffer.resize(header.emailsOffset);
+    for (const EmailEntry &email : emailEntries) {
+        append(buffer, email);
+    }
+    buffer.resize(header.keygripsOffset);
+    for (const KeygripEntry &keygrip : keygrips) {
+        append(buffer, keygrip);
+    }
+    buffer.resize(header.stringsOffset);
+    buffer.append(strings);
+
+    // write a temporary file and rename it, so that readers never see a
+    // partially written index
+    const std::string tmpName = fileName + ".tmp";
+    {
+        std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+        if (!file.write(buffer.data(), buffer.size()) || !file.flush()) {
+            file.close();
+            std::remove(tmpName.c_str());
+            return Error::fromCode(GPG_ERR_EIO);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpName, fileName, ec);
+    if (ec) {
+        std::remove(tmpName.c_str());
+        return Error::fromErrno(ec.value());
+    }
+    return Error();
+}
+
+// static
+Error KeyMetadataIndex::build(const std::string &fileName, Context *ctx, const std::string &keyringFile)
+{
+    if (!ctx) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    // take the stamp before listing, so that changes during the listing
+    // make the index stale
+    const KeyringStamp before = keyring_stamp(keyringFile);
+    std::vector<Key> keys;
+    Error err = ctx->startKeyListing();
+    while (!err) {
+        Key key = ctx->nextKey(err);
+        if (!err) {
+            keys.push_back(std::move(key));
+        }
+    }
+    const KeyListResult result = ctx->endKeyListing();
+    if (err.code() != GPG_ERR_EOF) {
+        return err;
+    }
+    if (result.error()) {
+        return result.error();
+    }
+    if (!(keyring_stamp(keyringFile) == before)) {
+        return Error::fromCode(GPG_ERR_TOO_OLD);
+    }
+    return write(fileName, keys, keyringFile);
+}
+
+Error KeyMetadataIndex::open(const std::string &fileName, const std::string &keyringFile)
+{
+    close();
+    const Error err = d->load(fileName);
+    if (err) {
+        return err;
+    }
+    d->keyringFile = keyringFile;
+    if (isStale()) {
+        close();
+        return Error::fromCode(GPG_ERR_TOO_OLD);
+    }
+    return Error();
+}
+
+void KeyMetadataIndex::close()
+{
+    d->unmap();
+    d->keyringFile.clear();
+}
+
+bool KeyMetadataIndex::isOpen() const
+{
+    return d->header;
+}
+
+bool KeyMetadataIndex::isStale() const
+{
+    if (!d->header || d->keyringFile.empty()) {
+        return false;
+    }
+    const KeyringStamp stamp = keyring_stamp(d->keyringFile);
+    return stamp.time != d->header->keyringTime || stamp.size != d->header->keyringSize;
+}
+
+size_t KeyMetadataIndex::size() const
+{
+    return d->header ? d->header->numRecords : 0;
+}
+
+size_t KeyMetadataIndex::findByFingerprint(const Fingerprint &fpr) const
+{
+    if (!d->header || fpr.isNull()) {
+        return npos;
+    }
+    size_t lo = 0;
+    size_t hi = d->header->numRecords;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        const FileRecord &r = d->record(mid);
+        const Fingerprint candidate = Fingerprint::fromBytes(r.fingerprint, r.fingerprintSize);
+        if (candidate == fpr) {
+            return mid;
+        }
+        if (candidate < fpr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return npos;
+}
+
+size_t KeyMetadataIndex::findByFingerprint(const char *fpr) const
+{
+    return findByFingerprint(Fingerprint(fpr));
+}
+
+std::vector<size_t> KeyMetadataIndex::findByEmail(const char *email) const
+{
+    std::vector<size_t> result;
+    if (!d->header || !email) {
+        return result;
+    }
+    const std::string needle = normalized_email(email);
+    const EmailEntry *const begin = d->emails();
+    const EmailEntry *const end = begin + d->header->numEmails;
+    struct Less {
+        const Private *d;
+        bool operator()(const EmailEntry &entry, const std::string &email) const
+        {
+            return strcmp(d->string(entry.email), email.c_str()) < 0;
+        }
+        bool operator()(const std::string &email, const EmailEntry &entry) const
+        {
+            return strcmp(email.c_str(), d->string(entry.email)) < 0;
+        }
+    };
+    const auto range = std::equal_range(begin, end, needle, Less{d.get()});
+    for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(it->record);
+    }
+    return result;
+}
+
+size_t KeyMetadataIndex::findByKeygrip(const char *keygrip) const
+{
+    const Fingerprint grip = parse_keygrip(keygrip);
+    if (!d->header || grip.isNull()) {
+        return npos;
+    }
+    const KeygripEntry *const begin = d->keygrips();
+    const KeygripEntry *const end = begin + d->header->numKeygrips;
+    const auto it = std::lower_bound(begin, end, grip, [](const KeygripEntry &entry, const Fingerprint &g) {
+        return std::memcmp(entry.keygrip, g.data(), sizeof(entry.keygrip)) < 0;
+    });
+    if (it == end || std::memcmp(it->keygrip, grip.data(), sizeof(it->keygrip)) != 0) {
+        return npos;
+    }
+    return it->record;
+}
+
+Key KeyMetadataIndex::key(size_t record, Context *ctx, Error &err) const
+{
+    if (record >= size() || !ctx) {
+        err = Error::fromCode(GPG_ERR_INV_VALUE);
+        return Key();
+    }
+    return ctx->key(fingerprint(record).toString().c_str(), err, false);
+}
+
+Fingerprint KeyMetadataIndex::fingerprint(size_t record) const
+{
+    const FileRecord &r = d->record(record);
+    return Fingerprint::fromBytes(r.fingerprint, r.fingerprintSize);
+}
+
+Protocol KeyMetadataIndex::protocol(size_t record) const
+{
+    return static_cast<Protocol>(d->record(record).protocol);
+}
+
+unsigned int KeyMetadataIndex::flags(size_t record) const
+{
+    return d->record(record).flags;
+}
+
+Subkey::PubkeyAlgo KeyMetadataIndex::algorithm(size_t record) const
+{
+    return static_cast<Subkey::PubkeyAlgo>(d->record(record).algorithm);
+}
+
+unsigned int KeyMetadataIndex::length(size_t record) const
+{
+    return d->record(record).length;
+}
+
+time_t KeyMetadataIndex::creationTime(size_t record) const
+{
+    return static_cast<time_t>(d->record(record).creationTime);
+}
+
+time_t KeyMetadataIndex::expirationTime(size_t record) const
+{
+    return static_cast<time_t>(d->record(record).expirationTime);
+}
+
+UserID::Validity KeyMetadataIndex::validity(size_t record) const
+{
+    return static_cast<UserID::Validity>(d->record(record).validity);
+}
+
+Key::OwnerTrust KeyMetadataIndex::ownerTrust(size_t record) const
+{
+    return static_cast<Key::OwnerTrust>(d->record(record).ownerTrust);
+}
+
+const char *KeyMetadataIndex::userID(size_t record) const
+{
+    const uint32_t offset = d->record(record).userID;
+    return offset ? d->string(offset - 1) : nullptr;
+}
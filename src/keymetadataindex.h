@@ -0,0 +1,132 @@
+/*
+  keymetadataindex.h - a persistent index of key metadata
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYMETADATAINDEX_H__
+#define __GPGMEPP_KEYMETADATAINDEX_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class Error;
+class Fingerprint;
+
+/**
+ * A file with the metadata of many keys which can be loaded instantly.
+ *
+ * Listing all keys of a large keyring takes a long time. An index file
+ * stores the scalar data of the keys (see KeyringSnapshot) and lookup tables
+ * by fingerprint, email address and keygrip. Opening an index maps the file
+ * into memory, so that a service can answer lookups right after its start
+ * and fetch the full keys lazily with key().
+ *
+ * The index records the modification time and size of a keyring file, e.g.
+ * the pubring.kbx of the used GnuPG home directory. It is rejected if the
+ * keyring has changed since the index was written.
+ *
+ * The file format is versioned and specific to the byte order of the host.
+ */
+class GPGMEPP_EXPORT KeyMetadataIndex
+{
+public:
+    /** The version of the file format written by this library. */
+    static const unsigned int FormatVersion = 1;
+    /** Returned by the lookup functions if nothing was found. */
+    static const size_t npos = static_cast<size_t>(-1);
+
+    KeyMetadataIndex();
+    KeyMetadataIndex(KeyMetadataIndex &&other) noexcept;
+    KeyMetadataIndex &operator=(KeyMetadataIndex &&other) noexcept;
+    ~KeyMetadataIndex();
+
+    /**
+     * Writes an index of @p keys to @p fileName. The file is replaced
+     * atomically. Keygrips are only indexed for keys listed with the
+     * WithKeygrip key list mode.
+     */
+    static Error write(const std::string &fileName, const std::vector<Key> &keys,
+                       const std::string &keyringFile = std::string());
+
+    /** Lists all keys with @p ctx and writes an index of them. */
+    static Error build(const std::string &fileName, Context *ctx,
+                       const std::string &keyringFile = std::string());
+
+    /**
+     * Opens the index @p fileName. Returns GPG_ERR_INV_DATA if the file is
+     * not an index, GPG_ERR_UNKNOWN_VERSION if it has an unknown format, and
+     * GPG_ERR_TOO_OLD if @p keyringFile is not empty and the keyring has
+     * changed since the index was written.
+     */
+    Error open(const std::string &fileName, const std::string &keyringFile = std::string());
+    void close();
+    bool isOpen() const;
+
+    /** Returns true if the keyring file given to open() has changed since
+     * the index was written. */
+    bool isStale() const;
+
+    /** Returns the number of keys, i.e. records, in the index. */
+    size_t size() const;
+
+    size_t findByFingerprint(const Fingerprint &fpr) const;
+    size_t findByFingerprint(const char *fpr) const;
+    /** Returns the records of all keys with a user ID with the address
+     * @p email. The address is compared case-insensitively. */
+    std::vector<size_t> findByEmail(const char *email) const;
+    size_t findByKeygrip(const char *keygrip) const;
+
+    /** Lists the full key of @p record with @p ctx. */
+    Key key(size_t record, Context *ctx, Error &err) const;
+
+    Fingerprint fingerprint(size_t record) const;
+    Protocol protocol(size_t record) const;
+    /** The flags as defined by KeyringSnapshot::Flag. */
+    unsigned int flags(size_t record) const;
+    Subkey::PubkeyAlgo algorithm(size_t record) const;
+    unsigned int length(size_t record) const;
+    time_t creationTime(size_t record) const;
+    time_t expirationTime(size_t record) const;
+    UserID::Validity validity(size_t record) const;
+    Key::OwnerTrust ownerTrust(size_t record) const;
+    /** The primary user ID, or nullptr if the key has no user ID. */
+    const char *userID(size_t record) const;
+
+private:
+    KeyMetadataIndex(const KeyMetadataIndex &) = delete;
+    KeyMetadataIndex &operator=(const KeyMetadataIndex &) = delete;
+
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYMETADATAINDEX_H__
@@ -0,0 +1,227 @@
+/*
+  keypacketsplitter.cpp - splits OpenPGP packet streams on key boundaries
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keypacketsplitter.h>
+
+using namespace GpgME;
+
+namespace
+{
+
+enum ParseResult {
+    Complete,
+    Incomplete,
+    Malformed,
+};
+
+// Determines the tag and the total size (header and body) of the packet
+// at p, see RFC 4880, section 4.2. A packet with an indeterminate length
+// extends to the end of the stream.
+ParseResult parsePacket(const unsigned char *p, size_t avail, int &tag, size_t &size, bool &indeterminate)
+{
+    indeterminate = false;
+    if (!avail) {
+        return Incomplete;
+    }
+    const unsigned char ctb = p[0];
+    if (!(ctb & 0x80)) {
+        return Malformed;
+    }
+    if (!(ctb & 0x40)) {
+        // old format
+        tag = (ctb >> 2) & 0x0f;
+        const unsigned int lengthType = ctb & 0x03;
+        if (lengthType == 3) {
+            indeterminate = true;
+            size = avail;
+            return tag ? Complete : Malformed;
+        }
+        const size_t lengthBytes = size_t(1) << lengthType;
+        if (avail < 1 + lengthBytes) {
+            return Incomplete;
+        }
+        size_t length = 0;
+        for (size_t i = 0; i < lengthBytes; ++i) {
+            length = (length << 8) | p[1 + i];
+        }
+        size = 1 + lengthBytes + length;
+    } else {
+        // new format; the body may consist of several partial bodies
+        tag = ctb & 0x3f;
+        size_t pos = 1;
+        while (true) {
+            if (avail < pos + 1) {
+                return Incomplete;
+            }
+            const unsigned char c = p[pos];
+            if (c < 192) {
+                size = pos + 1 + c;
+                break;
+            } else if (c < 224) {
+                if (avail < pos + 2) {
+                    return Incomplete;
+                }
+                size = pos + 2 + ((size_t(c) - 192) << 8) + p[pos + 1] + 192;
+                break;
+            } else if (c == 255) {
+                if (avail < pos + 5) {
+                    return Incomplete;
+                }
+                const size_t length = (size_t(p[pos + 1]) << 24) | (size_t(p[pos + 2]) << 16)
+                                      | (size_t(p[pos + 3]) << 8) | p[pos + 4];
+                size = pos + 5 + length;
+                break;
+            }
+            // partial body length
+            pos += 1 + (size_t(1) << (c & 0x1f));
+        }
+    }
+    if (!tag) {
+        return Malformed;
+    }
+    return size <= avail ? Complete : Incomplete;
+}
+
+bool isKeyPacket(int tag)
+{
+    // public key and secret key packets start a transferable key
+    return tag == 6 || tag == 5;
+}
+
+}
+
+class KeyPacketSplitter::Private
+{
+public:
+    explicit Private(size_t size)
+        : chunkSize(size),
+          pos(0),
+          failed(false)
+    {
+    }
+
+    // parses the complete packets after pos; returns the offset of the first
+    // key packet that closes the current chunk or 0 if there is none yet
+    size_t parse()
+    {
+        while (!failed) {
+            int tag = 0;
+            size_t size = 0;
+            bool indeterminate = false;
+            const ParseResult res = parsePacket(reinterpret_cast<const unsigned char *>(buffer.data()) + pos,
+                                                buffer.size() - pos, tag, size, indeterminate);
+            if (res == Malformed) {
+                failed = true;
+                err = Error::fromCode(GPG_ERR_INV_PACKET);
+                break;
+            }
+            if (res == Incomplete || indeterminate) {
+                break;
+            }
+            if (pos && pos >= chunkSize && isKeyPacket(tag)) {
+                return pos;
+            }
+            pos += size;
+        }
+        return 0;
+    }
+
+    const size_t chunkSize;
+    std::string buffer;
+    // the offset of the first packet in the buffer which is not yet parsed
+    size_t pos;
+    bool failed;
+    Error err;
+};
+
+KeyPacketSplitter::KeyPacketSplitter(size_t chunkSize)
+    : d(new Private(chunkSize))
+{
+}
+
+KeyPacketSplitter::~KeyPacketSplitter() = default;
+
+void KeyPacketSplitter::feed(const char *data, size_t size)
+{
+    d->buffer.append(data, size);
+}
+
+bool KeyPacketSplitter::next(std::string &chunk)
+{
+    const size_t end = d->parse();
+    if (!end) {
+        return false;
+    }
+    chunk.assign(d->buffer, 0, end);
+    d->buffer.erase(0, end);
+    d->pos = 0;
+    return true;
+}
+
+bool KeyPacketSplitter::finish(std::string &chunk)
+{
+    if (next(chunk)) {
+        return true;
+    }
+    if (d->buffer.empty()) {
+        return false;
+    }
+    chunk.swap(d->buffer);
+    d->buffer.clear();
+    d->pos = 0;
+    return true;
+}
+
+Error KeyPacketSplitter::error() const
+{
+    return d->err;
+}
+
+long long KeyPacketSplitter::keyCreationTime(const char *data, size_t size)
+{
+    const unsigned char *const p = reinterpret_cast<const unsigned char *>(data);
+    if (!size || !(p[0] & 0x80)) {
+        return -1;
+    }
+    int tag;
+    size_t header;
+    if (p[0] & 0x40) {
+        tag = p[0] & 0x3f;
+        if (size < 2) {
+            return -1;
+        }
+        header = p[1] < 192 ? 2 : p[1] < 224 ? 3 : p[1] == 255 ? 6 : 2;
+    } else {
+        tag = (p[0] >> 2) & 0x0f;
+        const unsigned int lengthType = p[0] & 0x03;
+        header = lengthType == 3 ? 1 : 1 + (size_t(1) << lengthType);
+    }
+    // the version is followed by the creation time in all versions
+    if (!isKeyPacket(tag) || size < header + 5) {
+        return -1;
+    }
+    return (static_cast<long long>(p[header + 1]) << 24) | (p[header + 2] << 16) | (p[header + 3] << 8) | p[header + 4];
+}
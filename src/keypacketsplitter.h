@@ -0,0 +1,83 @@
+/*
+  keypacketsplitter.h - splits OpenPGP packet streams on key boundaries
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYPACKETSPLITTER_H__
+#define __GPGMEPP_KEYPACKETSPLITTER_H__
+
+#include "global.h"
+#include "error.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace GpgME
+{
+
+/**
+ * Splits a binary OpenPGP packet stream, e.g. a keyring or a keyserver
+ * dump, into chunks of whole transferable keys.
+ *
+ * Only the packet headers are parsed. A chunk is closed before the first
+ * public key or secret key packet (tag 6 or 5) that starts at least
+ * @p chunkSize bytes after the start of the chunk, so that every chunk
+ * can be imported on its own.
+ *
+ * If the stream cannot be parsed (e.g. it is ASCII armored), then
+ * error() is set to GPG_ERR_INV_PACKET and the rest of the stream is
+ * returned as one chunk by finish().
+ */
+class GPGMEPP_EXPORT KeyPacketSplitter
+{
+public:
+    explicit KeyPacketSplitter(size_t chunkSize);
+    ~KeyPacketSplitter();
+
+    /** Appends the next @p size bytes of the stream. */
+    void feed(const char *data, size_t size);
+
+    /** Moves the next complete chunk to @p chunk. Returns false if more
+     * data is needed to complete a chunk. */
+    bool next(std::string &chunk);
+
+    /** To be called at the end of the stream. Moves the remaining data to
+     * @p chunk. Returns false if there is no data left. */
+    bool finish(std::string &chunk);
+
+    Error error() const;
+
+    /** Returns the creation time of the public or secret key packet at the
+     * start of @p data or -1 if @p data does not start with such a packet. */
+    static long long keyCreationTime(const char *data, size_t size);
+
+private:
+    KeyPacketSplitter(const KeyPacketSplitter &) = delete;
+    KeyPacketSplitter &operator=(const KeyPacketSplitter &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYPACKETSPLITTER_H__
@@ -0,0 +1,490 @@
+/*
+  keyringsnapshot.cpp - a columnar snapshot of a keyring
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keyringsnapshot.h>
+#include <context.h>
+#include <keylistresult.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+using namespace GpgME;
+
+namespace
+{
+
+// Stores strings in large blocks, so that the strings never move, and
+// stores every distinct string only once.
+class StringTable
+{
+public:
+    const char *intern(const char *str)
+    {
+        if (!str) {
+            return nullptr;
+        }
+        const std::string_view s(str);
+        const auto it = strings.find(s);
+        if (it != strings.end()) {
+            return it->second;
+        }
+        const size_t needed = s.size() + 1;
+        if (needed > left) {
+            const size_t blockSize = std::max(needed, defaultBlockSize);
+            blocks.emplace_back(new char[blockSize]);
+            reserved += blockSize;
+            next = blocks.back().get();
+            left = blockSize;
+        }
+        char *const copy = next;
+        std::memcpy(copy, s.data(), s.size());
+        copy[s.size()] = '\0';
+        next += needed;
+        left -= needed;
+        bytes += needed;
+        strings.emplace(std::string_view(copy, s.size()), copy);
+        return copy;
+    }
+
+    size_t size() const
+    {
+        return bytes;
+    }
+
+    // the bytes of the blocks and of the index
+    size_t allocatedBytes() const
+    {
+        // a node of the index holds the entry, the next pointer and the hash
+        return reserved
+               + blocks.capacity() * sizeof(blocks[0])
+               + strings.bucket_count() * sizeof(void *)
+               + strings.size() * (sizeof(std::pair<const std::string_view, const char *>) + 2 * sizeof(void *));
+    }
+
+private:
+    static constexpr size_t defaultBlockSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char *next = nullptr;
+    size_t left = 0;
+    size_t bytes = 0;
+    size_t reserved = 0;
+    std::unordered_map<std::string_view, const char *> strings;
+};
+
+}
+
+// static
+unsigned int KeyringSnapshot::flagsOf(const Key &key)
+{
+    unsigned int flags = 0;
+    if (key.isRevoked()) {
+        flags |= Revoked;
+    }
+    if (key.isExpired()) {
+        flags |= Expired;
+    }
+    if (key.isDisabled()) {
+        flags |= Disabled;
+    }
+    if (key.isInvalid()) {
+        flags |= Invalid;
+    }
+    if (key.canEncrypt()) {
+        flags |= CanEncrypt;
+    }
+    if (key.canSign()) {
+        flags |= CanSign;
+    }
+    if (key.canCertify()) {
+        flags |= CanCertify;
+    }
+    if (key.canAuthenticate()) {
+        flags |= CanAuthenticate;
+    }
+    if (key.hasSecret()) {
+        flags |= Secret;
+    }
+    if (key.isQualified()) {
+        flags |= Qualified;
+    }
+    if (key.isDeVs()) {
+        flags |= DeVs;
+    }
+    return flags;
+}
+
+// static
+unsigned int KeyringSnapshot::flagsOf(const Subkey &subkey)
+{
+    unsigned int flags = 0;
+    if (subkey.isRevoked()) {
+        flags |= Revoked;
+    }
+    if (subkey.isExpired()) {
+        flags |= Expired;
+    }
+    if (subkey.isDisabled()) {
+        flags |= Disabled;
+    }
+    if (subkey.isInvalid()) {
+        flags |= Invalid;
+    }
+    if (subkey.canEncrypt()) {
+        flags |= CanEncrypt;
+    }
+    if (subkey.canSign()) {
+        flags |= CanSign;
+    }
+    if (subkey.canCertify()) {
+        flags |= CanCertify;
+    }
+    if (subkey.canAuthenticate()) {
+        flags |= CanAuthenticate;
+    }
+    if (subkey.isSecret()) {
+        flags |= Secret;
+    }
+    if (subkey.isQualified()) {
+        flags |= Qualified;
+    }
+    if (subkey.isDeVs()) {
+        flags |= DeVs;
+    }
+    if (subkey.isCardKey()) {
+        flags |= CardKey;
+    }
+    return flags;
+}
+
+class KeyringSnapshot::Private
+{
+public:
+    bool matches(size_t row, const Filter &filter) const
+    {
+        const unsigned int f = flags[row];
+        if ((f & filter.requiredFlags) != filter.requiredFlags || (f & filter.excludedFlags)) {
+            return false;
+        }
+        if (filter.algorithm != Subkey::AlgoUnknown && algorithms[row] != filter.algorithm) {
+            return false;
+        }
+        if (lengths[row] < filter.minimumLength) {
+            return false;
+        }
+        if (filter.expiresBefore && (!expirationTimes[row] || expirationTimes[row] >= filter.expiresBefore)) {
+            return false;
+        }
+        if (filter.createdAfter && creationTimes[row] <= filter.createdAfter) {
+            return false;
+        }
+        if (validities[row] < filter.minimumValidity) {
+            return false;
+        }
+        if (filter.protocol != UnknownProtocol && protocols[row] != filter.protocol) {
+            return false;
+        }
+        return true;
+    }
+
+    // the key columns
+    std::vector<uint32_t> flags;
+    std::vector<uint8_t> protocols;
+    std::vector<uint16_t> algorithms;
+    std::vector<uint32_t> lengths;
+    std::vector<time_t> creationTimes;
+    std::vector<time_t> expirationTimes;
+    std::vector<uint8_t> validities;
+    std::vector<uint8_t> ownerTrusts;
+    std::vector<const char *> fingerprints;
+    std::vector<const char *> userIDs;
+    // the first subkey of every key plus the end of the last one
+    std::vector<uint32_t> subkeyOffsets{0};
+
+    // the subkey columns
+    std::vector<uint32_t> subkeyFlags;
+    std::vector<uint16_t> subkeyAlgorithms;
+    std::vector<uint32_t> subkeyLengths;
+    std::vector<time_t> subkeyCreationTimes;
+    std::vector<time_t> subkeyExpirationTimes;
+    std::vector<const char *> subkeyFingerprints;
+
+    StringTable strings;
+};
+
+KeyringSnapshot::KeyringSnapshot()
+    : d(new Private)
+{
+}
+
+KeyringSnapshot::KeyringSnapshot(KeyringSnapshot &&other) noexcept = default;
+
+KeyringSnapshot &KeyringSnapshot::operator=(KeyringSnapshot &&other) noexcept = default;
+
+KeyringSnapshot::~KeyringSnapshot() = default;
+
+// static
+KeyringSnapshot KeyringSnapshot::fromKeyListing(Context *ctx, Error &err, const char *pattern, bool secretOnly)
+{
+    KeyringSnapshot snapshot;
+    err = Error();
+    if (!ctx) {
+        err = Error::fromCode(GPG_ERR_INV_VALUE);
+        return snapshot;
+    }
+    err = ctx->startKeyListing(pattern, secretOnly);
+    while (!err) {
+        const Key key = ctx->nextKey(err);
+        if (!err) {
+            snapshot.add(key);
+        }
+    }
+    if (err.code() == GPG_ERR_EOF) {
+        err = Error();
+    }
+    const KeyListResult result = ctx->endKeyListing();
+    if (!err) {
+        err = result.error();
+    }
+    return snapshot;
+}
+
+void KeyringSnapshot::reserve(size_t keys)
+{
+    d->flags.reserve(keys);
+    d->protocols.reserve(keys);
+    d->algorithms.reserve(keys);
+    d->lengths.reserve(keys);
+    d->creationTimes.reserve(keys);
+    d->expirationTimes.reserve(keys);
+    d->validities.reserve(keys);
+    d->ownerTrusts.reserve(keys);
+    d->fingerprints.reserve(keys);
+    d->userIDs.reserve(keys);
+    d->subkeyOffsets.reserve(keys + 1);
+}
+
+void KeyringSnapshot::add(const Key &key)
+{
+    if (key.isNull()) {
+        return;
+    }
+    // use the ranges to not build the child index of the key
+    const ChildRange<Subkey> subkeys = key.subkeyRange();
+    const ChildRange<UserID> uids = key.userIDRange();
+    const Subkey primary = subkeys.empty() ? Subkey() : *subkeys.begin();
+    const UserID uid = uids.empty() ? UserID() : *uids.begin();
+
+    d->flags.push_back(flagsOf(key));
+    d->protocols.push_back(key.protocol());
+    d->algorithms.push_back(primary.publicKeyAlgorithm());
+    d->lengths.push_back(primary.length());
+    d->creationTimes.push_back(primary.creationTime());
+    d->expirationTimes.push_back(primary.expirationTime());
+    d->validities.push_back(uid.isNull() ? UserID::Unknown : uid.validity());
+    d->ownerTrusts.push_back(key.ownerTrust());
+    d->fingerprints.push_back(d->strings.intern(key.primaryFingerprint()));
+    d->userIDs.push_back(d->strings.intern(uid.id()));
+
+    for (const Subkey &subkey : subkeys) {
+        d->subkeyFlags.push_back(flagsOf(subkey));
+        d->subkeyAlgorithms.push_back(subkey.publicKeyAlgorithm());
+        d->subkeyLengths.push_back(subkey.length());
+        d->subkeyCreationTimes.push_back(subkey.creationTime());
+        d->subkeyExpirationTimes.push_back(subkey.expirationTime());
+        d->subkeyFingerprints.push_back(d->strings.intern(subkey.fingerprint()));
+    }
+    d->subkeyOffsets.push_back(d->subkeyFlags.size());
+}
+
+size_t KeyringSnapshot::size() const
+{
+    return d->flags.size();
+}
+
+bool KeyringSnapshot::empty() const
+{
+    return d->flags.empty();
+}
+
+std::vector<size_t> KeyringSnapshot::select(const Filter &filter) const
+{
+    std::vector<size_t> rows;
+    for (size_t row = 0, end = size(); row < end; ++row) {
+        if (d->matches(row, filter)) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+size_t KeyringSnapshot::count(const Filter &filter) const
+{
+    size_t n = 0;
+    for (size_t row = 0, end = size(); row < end; ++row) {
+        n += d->matches(row, filter);
+    }
+    return n;
+}
+
+Key KeyringSnapshot::key(size_t row, Context *ctx, Error &err) const
+{
+    if (row >= size() || !ctx || !d->fingerprints[row]) {
+        err = Error::fromCode(GPG_ERR_INV_VALUE);
+        return Key();
+    }
+    return ctx->key(d->fingerprints[row], err, false);
+}
+
+unsigned int KeyringSnapshot::flags(size_t row) const
+{
+    return d->flags[row];
+}
+
+Protocol KeyringSnapshot::protocol(size_t row) const
+{
+    return static_cast<Protocol>(d->protocols[row]);
+}
+
+Subkey::PubkeyAlgo KeyringSnapshot::algorithm(size_t row) const
+{
+    return static_cast<Subkey::PubkeyAlgo>(d->algorithms[row]);
+}
+
+unsigned int KeyringSnapshot::length(size_t row) const
+{
+    return d->lengths[row];
+}
+
+time_t KeyringSnapshot::creationTime(size_t row) const
+{
+    return d->creationTimes[row];
+}
+
+time_t KeyringSnapshot::expirationTime(size_t row) const
+{
+    return d->expirationTimes[row];
+}
+
+UserID::Validity KeyringSnapshot::validity(size_t row) const
+{
+    return static_cast<UserID::Validity>(d->validities[row]);
+}
+
+Key::OwnerTrust KeyringSnapshot::ownerTrust(size_t row) const
+{
+    return static_cast<Key::OwnerTrust>(d->ownerTrusts[row]);
+}
+
+const char *KeyringSnapshot::primaryFingerprint(size_t row) const
+{
+    return d->fingerprints[row];
+}
+
+const char *KeyringSnapshot::userID(size_t row) const
+{
+    return d->userIDs[row];
+}
+
+size_t KeyringSnapshot::firstSubkey(size_t row) const
+{
+    return d->subkeyOffsets[row];
+}
+
+unsigned int KeyringSnapshot::numSubkeys(size_t row) const
+{
+    return d->subkeyOffsets[row + 1] - d->subkeyOffsets[row];
+}
+
+unsigned int KeyringSnapshot::subkeyFlags(size_t subkey) const
+{
+    return d->subkeyFlags[subkey];
+}
+
+Subkey::PubkeyAlgo KeyringSnapshot::subkeyAlgorithm(size_t subkey) const
+{
+    return static_cast<Subkey::PubkeyAlgo>(d->subkeyAlgorithms[subkey]);
+}
+
+unsigned int KeyringSnapshot::subkeyLength(size_t subkey) const
+{
+    return d->subkeyLengths[subkey];
+}
+
+time_t KeyringSnapshot::subkeyCreationTime(size_t subkey) const
+{
+    return d->subkeyCreationTimes[subkey];
+}
+
+time_t KeyringSnapshot::subkeyExpirationTime(size_t subkey) const
+{
+    return d->subkeyExpirationTimes[subkey];
+}
+
+const char *KeyringSnapshot::subkeyFingerprint(size_t subkey) const
+{
+    return d->subkeyFingerprints[subkey];
+}
+
+size_t KeyringSnapshot::stringTableSize() const
+{
+    return d->strings.size();
+}
+
+template <typename T>
+static size_t columnBytes(const std::vector<T> &column)
+{
+    return column.capacity() * sizeof(T);
+}
+
+KeyringSnapshot::MemoryStats KeyringSnapshot::memoryStats() const
+{
+    MemoryStats stats;
+    stats.keys = size();
+    stats.subkeys = d->subkeyFlags.size();
+    stats.columnBytes = sizeof(Private)
+                        + columnBytes(d->flags)
+                        + columnBytes(d->protocols)
+                        + columnBytes(d->algorithms)
+                        + columnBytes(d->lengths)
+                        + columnBytes(d->creationTimes)
+                        + columnBytes(d->expirationTimes)
+                        + columnBytes(d->validities)
+                        + columnBytes(d->ownerTrusts)
+                        + columnBytes(d->fingerprints)
+                        + columnBytes(d->userIDs)
+                        + columnBytes(d->subkeyOffsets)
+                        + columnBytes(d->subkeyFlags)
+                        + columnBytes(d->subkeyAlgorithms)
+                        + columnBytes(d->subkeyLengths)
+                        + columnBytes(d->subkeyCreationTimes)
+                        + columnBytes(d->subkeyExpirationTimes)
+                        + columnBytes(d->subkeyFingerprints);
+    stats.stringBytes = d->strings.allocatedBytes();
+    return stats;
+}
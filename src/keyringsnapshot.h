@@ -0,0 +1,181 @@
+/*
+  keyringsnapshot.h - a columnar snapshot of a keyring
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYRINGSNAPSHOT_H__
+#define __GPGMEPP_KEYRINGSNAPSHOT_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class Error;
+
+/**
+ * A compact snapshot of the scalar data of many keys, e.g. of a complete
+ * keyring, for reports and other scans over large key sets.
+ *
+ * Every key is a row. The flags, times, algorithms, lengths and validities
+ * of the keys and of their subkeys are stored in contiguous columns, and all
+ * strings in one interned string table. Select the interesting rows with a
+ * Filter or with the column accessors and materialize the full Key of a row
+ * with key() only if needed.
+ *
+ * The key level values (algorithm, length, times) are those of the primary
+ * subkey; the validity is the one of the primary user ID.
+ */
+class GPGMEPP_EXPORT KeyringSnapshot
+{
+public:
+    enum Flag : unsigned int {
+        Revoked = 0x0001,
+        Expired = 0x0002,
+        Disabled = 0x0004,
+        Invalid = 0x0008,
+        CanEncrypt = 0x0010,
+        CanSign = 0x0020,
+        CanCertify = 0x0040,
+        CanAuthenticate = 0x0080,
+        Secret = 0x0100,
+        Qualified = 0x0200,
+        DeVs = 0x0400,
+        CardKey = 0x0800, // only for subkeys
+    };
+
+    /** Rows match a filter if they match all of its conditions. */
+    struct Filter {
+        /** All of these flags must be set. */
+        unsigned int requiredFlags = 0;
+        /** None of these flags must be set. */
+        unsigned int excludedFlags = 0;
+        /** The public key algorithm; AlgoUnknown matches all algorithms. */
+        Subkey::PubkeyAlgo algorithm = Subkey::AlgoUnknown;
+        unsigned int minimumLength = 0;
+        /** If not 0, then only keys with an expiration time before this time
+         * match. Keys which never expire do not match. */
+        time_t expiresBefore = 0;
+        /** If not 0, then only keys created after this time match. */
+        time_t createdAfter = 0;
+        UserID::Validity minimumValidity = UserID::Unknown;
+        Protocol protocol = UnknownProtocol;
+    };
+
+    KeyringSnapshot();
+    KeyringSnapshot(KeyringSnapshot &&other) noexcept;
+    KeyringSnapshot &operator=(KeyringSnapshot &&other) noexcept;
+    ~KeyringSnapshot();
+
+    /**
+     * Lists the keys matching @p pattern (all keys if null) with @p ctx and
+     * adds them to a new snapshot. The keys are not kept. On error @p err is
+     * set and the snapshot contains the keys listed until then.
+     */
+    static KeyringSnapshot fromKeyListing(Context *ctx, Error &err, const char *pattern = nullptr, bool secretOnly = false);
+
+    void reserve(size_t keys);
+    /** Adds the data of @p key as new row. */
+    void add(const Key &key);
+
+    size_t size() const;
+    bool empty() const;
+
+    /** Returns the flags of @p key, respectively @p subkey, as stored in the
+     * snapshot. */
+    static unsigned int flagsOf(const Key &key);
+    static unsigned int flagsOf(const Subkey &subkey);
+
+    /** Returns the rows matching @p filter. */
+    std::vector<size_t> select(const Filter &filter) const;
+    size_t count(const Filter &filter) const;
+
+    /**
+     * Returns the full key of @p row listed with @p ctx. Returns a null key
+     * and sets @p err if the key cannot be listed (anymore).
+     */
+    Key key(size_t row, Context *ctx, Error &err) const;
+
+    // the columns of the keys
+    unsigned int flags(size_t row) const;
+    Protocol protocol(size_t row) const;
+    Subkey::PubkeyAlgo algorithm(size_t row) const;
+    unsigned int length(size_t row) const;
+    time_t creationTime(size_t row) const;
+    time_t expirationTime(size_t row) const;
+    UserID::Validity validity(size_t row) const;
+    Key::OwnerTrust ownerTrust(size_t row) const;
+    const char *primaryFingerprint(size_t row) const;
+    /** The primary user ID, or nullptr if the key has no user ID. */
+    const char *userID(size_t row) const;
+
+    // the columns of the subkeys, indexed from firstSubkey(row) to
+    // firstSubkey(row) + numSubkeys(row) - 1
+    size_t firstSubkey(size_t row) const;
+    unsigned int numSubkeys(size_t row) const;
+    unsigned int subkeyFlags(size_t subkey) const;
+    Subkey::PubkeyAlgo subkeyAlgorithm(size_t subkey) const;
+    unsigned int subkeyLength(size_t subkey) const;
+    time_t subkeyCreationTime(size_t subkey) const;
+    time_t subkeyExpirationTime(size_t subkey) const;
+    const char *subkeyFingerprint(size_t subkey) const;
+
+    /** Returns the size of the string table in bytes. */
+    size_t stringTableSize() const;
+
+    struct MemoryStats {
+        size_t keys = 0;
+        size_t subkeys = 0;
+        /** The bytes allocated for the columns. */
+        size_t columnBytes = 0;
+        /** The bytes allocated for the string table and its index. */
+        size_t stringBytes = 0;
+
+        size_t total() const
+        {
+            return columnBytes + stringBytes;
+        }
+    };
+
+    /**
+     * Returns the memory used by the snapshot. Compare it with
+     * Key::approximateMemoryUsage() of the listed keys to decide whether
+     * keeping a snapshot is cheaper than keeping the keys.
+     */
+    MemoryStats memoryStats() const;
+
+private:
+    KeyringSnapshot(const KeyringSnapshot &) = delete;
+    KeyringSnapshot &operator=(const KeyringSnapshot &) = delete;
+
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYRINGSNAPSHOT_H__
@@ -0,0 +1,299 @@
+/*
+  keysorter.cpp - sorts large key lists
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keysorter.h>
+#include <mailboxindex.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+
+using namespace GpgME;
+
+namespace
+{
+// lists shorter than this are sorted by one thread
+const size_t minimumChunkSize = 2048;
+
+struct Entry {
+    const unsigned char *data;
+    uint32_t size;
+    uint32_t index;
+};
+
+bool operator<(const Entry &lhs, const Entry &rhs)
+{
+    const int c = std::memcmp(lhs.data, rhs.data, std::min(lhs.size, rhs.size));
+    if (c) {
+        return c < 0;
+    }
+    if (lhs.size != rhs.size) {
+        return lhs.size < rhs.size;
+    }
+    // keeps equal keys in their order
+    return lhs.index < rhs.index;
+}
+
+void appendInteger(std::vector<unsigned char> &buffer, int64_t value)
+{
+    // flipping the sign bit makes the big-endian bytes sort like the values
+    const uint64_t u = static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        buffer.push_back(static_cast<unsigned char>(u >> shift));
+    }
+}
+
+void appendString(std::vector<unsigned char> &buffer, const char *s)
+{
+    if (s) {
+        for (; *s; ++s) {
+            buffer.push_back(static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(*s))));
+        }
+    }
+    // terminated by 0, so that prefixes sort first
+    buffer.push_back(0);
+}
+
+// Calls @p function(chunk, begin, end) for @p chunks consecutive ranges of
+// [0, size), using one thread per chunk.
+template<typename Function>
+void forEachChunk(size_t size, unsigned int chunks, const Function &function)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    for (unsigned int chunk = 1; chunk < chunks; ++chunk) {
+        threads.emplace_back([&function, size, chunks, chunk]() {
+            function(chunk, size * chunk / chunks, size * (chunk + 1) / chunks);
+        });
+    }
+    function(0, 0, size / chunks);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+}
+
+class KeySorter::Private
+{
+public:
+    Private(const std::vector<Criterion> &c, unsigned int n)
+        : criteria(c),
+          concurrency(n ? n : std::max(1u, std::thread::hardware_concurrency()))
+    {
+    }
+
+    unsigned int chunks(size_t size) const
+    {
+        return static_cast<unsigned int>(std::max<size_t>(1, std::min<size_t>(concurrency, size / minimumChunkSize)));
+    }
+
+    void encode(const Key &key, std::vector<unsigned char> &buffer) const
+    {
+        const UserID uid = key.userID(0);
+        const Subkey subkey = key.subkey(0);
+        for (const Criterion &criterion : criteria) {
+            const size_t start = buffer.size();
+            switch (criterion.field) {
+            case Field::Validity:
+                buffer.push_back(static_cast<unsigned char>(uid.validity()));
+                break;
+            case Field::Email:
+                appendString(buffer, MailboxIndex::normalizedMailbox(uid.email()).c_str());
+                break;
+            case Field::Name:
+                appendString(buffer, uid.name());
+                break;
+            case Field::CreationTime:
+                appendInteger(buffer, subkey.creationTime());
+                break;
+            case Field::ExpirationTime:
+                // keys which never expire sort last
+                appendInteger(buffer, subkey.neverExpires() ? std::numeric_limits<int64_t>::max()
+                                                            : int64_t(subkey.expirationTime()));
+                break;
+            case Field::Fingerprint:
+                appendString(buffer, key.primaryFingerprint());
+                break;
+            }
+            if (criterion.descending) {
+                for (size_t i = start; i < buffer.size(); ++i) {
+                    buffer[i] = ~buffer[i];
+                }
+            }
+        }
+    }
+
+    // Extracts the sort keys of all keys into @p buffers, one per chunk.
+    std::vector<Entry> extract(const std::vector<Key> &keys, std::vector<std::vector<unsigned char>> &buffers) const
+    {
+        std::vector<Entry> entries(keys.size());
+        const unsigned int n = chunks(keys.size());
+        buffers.resize(n);
+        forEachChunk(keys.size(), n, [&](unsigned int chunk, size_t begin, size_t end) {
+            std::vector<unsigned char> &buffer = buffers[chunk];
+            std::vector<size_t> offsets;
+            offsets.reserve(end - begin + 1);
+            for (size_t i = begin; i < end; ++i) {
+                offsets.push_back(buffer.size());
+                encode(keys[i], buffer);
+            }
+            offsets.push_back(buffer.size());
+            // the buffer does not move anymore
+            for (size_t i = begin; i < end; ++i) {
+                const size_t offset = offsets[i - begin];
+                entries[i] = {buffer.data() + offset, static_cast<uint32_t>(offsets[i - begin + 1] - offset),
+                              static_cast<uint32_t>(i)};
+            }
+        });
+        return entries;
+    }
+
+    void sort(std::vector<Entry> &entries) const
+    {
+        const unsigned int n = chunks(entries.size());
+        std::vector<size_t> bounds;
+        for (unsigned int chunk = 0; chunk <= n; ++chunk) {
+            bounds.push_back(entries.size() * chunk / n);
+        }
+        forEachChunk(entries.size(), n, [&entries](unsigned int, size_t begin, size_t end) {
+            std::sort(entries.begin() + begin, entries.begin() + end);
+        });
+        // merge neighbouring runs until one is left
+        for (size_t width = 1; width < n; width *= 2) {
+            std::vector<std::thread> threads;
+            for (size_t first = 0; first + width < n; first += 2 * width) {
+                const size_t begin = bounds[first];
+                const size_t middle = bounds[first + width];
+                const size_t end = bounds[std::min<size_t>(first + 2 * width, n)];
+                threads.emplace_back([&entries, begin, middle, end]() {
+                    std::inplace_merge(entries.begin() + begin, entries.begin() + middle, entries.begin() + end);
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        }
+    }
+
+    // Returns the indexes of the first @p count entries in sorted order
+    std::vector<size_t> top(std::vector<Entry> &entries, size_t count) const
+    {
+        count = std::min(count, entries.size());
+        std::vector<Entry> candidates;
+        const unsigned int n = chunks(entries.size());
+        if (n == 1) {
+            std::partial_sort(entries.begin(), entries.begin() + count, entries.end());
+            candidates.assign(entries.begin(), entries.begin() + count);
+        } else {
+            // the first keys of every chunk are the candidates
+            forEachChunk(entries.size(), n, [&entries, count](unsigned int, size_t begin, size_t end) {
+                const size_t k = std::min(count, end - begin);
+                std::partial_sort(entries.begin() + begin, entries.begin() + begin + k, entries.begin() + end);
+            });
+            for (unsigned int chunk = 0; chunk < n; ++chunk) {
+                const size_t begin = entries.size() * chunk / n;
+                const size_t end = entries.size() * (chunk + 1) / n;
+                candidates.insert(candidates.end(), entries.begin() + begin,
+                                  entries.begin() + begin + std::min(count, end - begin));
+            }
+            std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+            candidates.resize(count);
+        }
+        std::vector<size_t> result;
+        result.reserve(count);
+        for (const Entry &entry : candidates) {
+            result.push_back(entry.index);
+        }
+        return result;
+    }
+
+    const std::vector<Criterion> criteria;
+    const unsigned int concurrency;
+};
+
+KeySorter::KeySorter(const std::vector<Criterion> &criteria, unsigned int concurrency)
+    : d(new Private(criteria, concurrency))
+{
+}
+
+KeySorter::~KeySorter() = default;
+
+const std::vector<KeySorter::Criterion> &KeySorter::criteria() const
+{
+    return d->criteria;
+}
+
+std::vector<size_t> KeySorter::order(const std::vector<Key> &keys) const
+{
+    std::vector<std::vector<unsigned char>> buffers;
+    std::vector<Entry> entries = d->extract(keys, buffers);
+    d->sort(entries);
+    std::vector<size_t> result;
+    result.reserve(entries.size());
+    for (const Entry &entry : entries) {
+        result.push_back(entry.index);
+    }
+    return result;
+}
+
+void KeySorter::sort(std::vector<Key> &keys) const
+{
+    const std::vector<size_t> indexes = order(keys);
+    std::vector<Key> sorted;
+    sorted.reserve(keys.size());
+    for (const size_t index : indexes) {
+        sorted.push_back(std::move(keys[index]));
+    }
+    keys.swap(sorted);
+}
+
+void KeySorter::partialSort(std::vector<Key> &keys, size_t count) const
+{
+    if (count >= keys.size()) {
+        sort(keys);
+        return;
+    }
+    std::vector<std::vector<unsigned char>> buffers;
+    std::vector<Entry> entries = d->extract(keys, buffers);
+    const std::vector<size_t> indexes = d->top(entries, count);
+    std::vector<bool> taken(keys.size());
+    std::vector<Key> sorted;
+    sorted.reserve(keys.size());
+    for (const size_t index : indexes) {
+        taken[index] = true;
+        sorted.push_back(std::move(keys[index]));
+    }
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (!taken[i]) {
+            sorted.push_back(std::move(keys[i]));
+        }
+    }
+    keys.swap(sorted);
+}
@@ -0,0 +1,97 @@
+/*
+  keysorter.h - sorts large key lists
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYSORTER_H__
+#define __GPGMEPP_KEYSORTER_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Sorts large lists of keys by several criteria.
+ *
+ * Comparing keys directly with their accessors walks the lists of user IDs
+ * and subkeys on every comparison. The sorter extracts a composite sort key
+ * for every key once, stores them contiguously and sorts them byte-wise,
+ * with several threads for large lists.
+ *
+ * The criteria refer to the primary user ID and the primary subkey of the
+ * keys. Email addresses and names are compared case-insensitively (ASCII
+ * only); email addresses are normalized with
+ * MailboxIndex::normalizedMailbox(). Keys which compare equal keep their
+ * relative order.
+ *
+ * A sorter can be used by several threads at the same time.
+ */
+class GPGMEPP_EXPORT KeySorter
+{
+public:
+    enum class Field {
+        Validity,
+        Email,
+        Name,
+        CreationTime,
+        ExpirationTime,
+        Fingerprint,
+    };
+
+    struct Criterion {
+        Field field;
+        bool descending = false;
+    };
+
+    /** A @p concurrency of 0 uses one thread per core. Lists shorter than
+     * a few thousand keys are always sorted by the calling thread. */
+    explicit KeySorter(const std::vector<Criterion> &criteria, unsigned int concurrency = 0);
+    ~KeySorter();
+
+    const std::vector<Criterion> &criteria() const;
+
+    /** Sorts @p keys. */
+    void sort(std::vector<Key> &keys) const;
+
+    /** Moves the first @p count keys in sorted order to the front of
+     * @p keys. The order of the other keys is unspecified. */
+    void partialSort(std::vector<Key> &keys, size_t count) const;
+
+    /** Returns the indexes of @p keys in sorted order without changing
+     * @p keys. */
+    std::vector<size_t> order(const std::vector<Key> &keys) const;
+
+private:
+    KeySorter(const KeySorter &) = delete;
+    KeySorter &operator=(const KeySorter &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYSORTER_H__
@@ -0,0 +1,80 @@
+/*
+  keyview.cpp - non-owning views of keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <keyview.h>
+
+using namespace GpgME;
+
+// Returns a shared key pointing to the same key without sharing ownership.
+// Copying it does not touch any reference count.
+static shared_gpgme_key_t borrow(const shared_gpgme_key_t &key)
+{
+    return shared_gpgme_key_t(shared_gpgme_key_t(), key.get());
+}
+
+KeyView::KeyView(const Key &key)
+    : mKey(borrow(key.key))
+{
+}
+
+Key KeyView::toKey() const
+{
+    return Key(mKey.impl(), true);
+}
+
+UserIDView::UserIDView(const UserID &uid)
+{
+    mUserID.key = borrow(uid.key);
+    mUserID.uid = uid.uid;
+}
+
+KeyView UserIDView::parent() const
+{
+    return KeyView(mUserID.parent());
+}
+
+UserID UserIDView::toUserID() const
+{
+    const Key owner = KeyView(mUserID.parent()).toKey();
+    return UserID(owner.key, mUserID.uid);
+}
+
+SubkeyView::SubkeyView(const Subkey &subkey)
+{
+    mSubkey.key = borrow(subkey.key);
+    mSubkey.subkey = subkey.subkey;
+}
+
+KeyView SubkeyView::parent() const
+{
+    return KeyView(mSubkey.parent());
+}
+
+Subkey SubkeyView::toSubkey() const
+{
+    const Key owner = KeyView(mSubkey.parent()).toKey();
+    return Subkey(owner.key, mSubkey.subkey);
+}
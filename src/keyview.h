@@ -0,0 +1,139 @@
+/*
+  keyview.h - non-owning views of keys
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_KEYVIEW_H__
+#define __GPGMEPP_KEYVIEW_H__
+
+#include "global.h"
+#include "key.h"
+
+namespace GpgME
+{
+
+/**
+ * A view of a key which does not own the key.
+ *
+ * Copying a Key, UserID or Subkey changes the reference count of the shared
+ * key. If many threads copy children of the same keys, e.g. while filtering
+ * or sorting large key lists, then they contend for the reference count.
+ * The views borrow the key from a Key that the caller keeps alive, so that
+ * copying them is as cheap as copying a pointer.
+ *
+ * The accessors of the viewed object are available through operator->. All
+ * objects returned by the accessors, e.g. the user IDs of a KeyView, borrow
+ * the key, too. Use toKey() (respectively toUserID() and toSubkey()) to get
+ * an object owning the key, e.g. to keep the result of a filter.
+ *
+ * \note The view, all copies of it and all objects obtained from it must not
+ * be used after the last Key owning the key has been destroyed.
+ */
+class GPGMEPP_EXPORT KeyView
+{
+public:
+    KeyView() = default;
+    /* implicit */ KeyView(const Key &key);
+
+    const Key &operator*() const
+    {
+        return mKey;
+    }
+    const Key *operator->() const
+    {
+        return &mKey;
+    }
+
+    bool isNull() const
+    {
+        return mKey.isNull();
+    }
+
+    /** Returns a Key owning the viewed key. */
+    Key toKey() const;
+
+private:
+    Key mKey;
+};
+
+/** A view of a user ID which does not own the key. See KeyView. */
+class GPGMEPP_EXPORT UserIDView
+{
+public:
+    UserIDView() = default;
+    /* implicit */ UserIDView(const UserID &uid);
+
+    const UserID &operator*() const
+    {
+        return mUserID;
+    }
+    const UserID *operator->() const
+    {
+        return &mUserID;
+    }
+
+    bool isNull() const
+    {
+        return mUserID.isNull();
+    }
+
+    KeyView parent() const;
+
+    /** Returns a UserID owning the viewed key. */
+    UserID toUserID() const;
+
+private:
+    UserID mUserID;
+};
+
+/** A view of a subkey which does not own the key. See KeyView. */
+class GPGMEPP_EXPORT SubkeyView
+{
+public:
+    SubkeyView() = default;
+    /* implicit */ SubkeyView(const Subkey &subkey);
+
+    const Subkey &operator*() const
+    {
+        return mSubkey;
+    }
+    const Subkey *operator->() const
+    {
+        return &mSubkey;
+    }
+
+    bool isNull() const
+    {
+        return mSubkey.isNull();
+    }
+
+    KeyView parent() const;
+
+    /** Returns a Subkey owning the viewed key. */
+    Subkey toSubkey() const;
+
+private:
+    Subkey mSubkey;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_KEYVIEW_H__
@@ -0,0 +1,251 @@
+/*
+  mailboxindex.cpp - resolves mailboxes to keys in-process
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <mailboxindex.h>
+#include <context.h>
+#include <fingerprint.h>
+#include <importresult.h>
+#include <keylistresult.h>
+
+#include "util.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <unordered_map>
+
+using namespace GpgME;
+
+class MailboxIndex::Private
+{
+public:
+    struct Candidate {
+        Key key;
+        Fingerprint fpr;
+        UserID::Validity validity;
+        time_t creationTime;
+
+        // best first
+        bool operator<(const Candidate &other) const
+        {
+            if (validity != other.validity) {
+                return validity_rank(validity) > validity_rank(other.validity);
+            }
+            return creationTime > other.creationTime;
+        }
+    };
+
+    void insert(const Key &key)
+    {
+        const Fingerprint fpr(key);
+        if (fpr.isNull()) {
+            return;
+        }
+        remove(fpr);
+
+        // the best validity of the user IDs of every mailbox of the key
+        std::unordered_map<std::string, UserID::Validity> validities;
+        for (const UserID &uid : key.userIDRange()) {
+            const std::string mailbox = normalizedMailbox(uid.addrSpec().c_str());
+            if (mailbox.empty()) {
+                continue;
+            }
+            const auto it = validities.emplace(mailbox, uid.validity()).first;
+            if (validity_rank(uid.validity()) > validity_rank(it->second)) {
+                it->second = uid.validity();
+            }
+        }
+
+        std::vector<std::string> &keyMailboxes = mailboxesOfKey[fpr];
+        const time_t creationTime = key.subkeyRange().empty() ? 0 : key.subkeyRange().begin()->creationTime();
+        for (const auto &entry : validities) {
+            std::vector<Candidate> &candidates = byMailbox[entry.first];
+            const Candidate candidate{key, fpr, entry.second, creationTime};
+            candidates.insert(std::upper_bound(candidates.begin(), candidates.end(), candidate), candidate);
+            keyMailboxes.push_back(entry.first);
+        }
+    }
+
+    void remove(const Fingerprint &fpr)
+    {
+        const auto it = mailboxesOfKey.find(fpr);
+        if (it == mailboxesOfKey.end()) {
+            return;
+        }
+        for (const std::string &mailbox : it->second) {
+            const auto candidates = byMailbox.find(mailbox);
+            if (candidates == byMailbox.end()) {
+                continue;
+            }
+            auto &v = candidates->second;
+            v.erase(std::remove_if(v.begin(), v.end(), [&fpr](const Candidate &c) {
+                return c.fpr == fpr;
+            }), v.end());
+            if (v.empty()) {
+                byMailbox.erase(candidates);
+            }
+        }
+        mailboxesOfKey.erase(it);
+    }
+
+    std::unordered_map<std::string, std::vector<Candidate>> byMailbox;
+    std::unordered_map<Fingerprint, std::vector<std::string>> mailboxesOfKey;
+};
+
+MailboxIndex::MailboxIndex()
+    : d(new Private)
+{
+}
+
+MailboxIndex::~MailboxIndex() = default;
+
+// static
+std::string MailboxIndex::normalizedMailbox(const char *address)
+{
+    if (!address || !*address) {
+        return std::string();
+    }
+    std::string mailbox = std::strchr(address, '<') ? UserID::addrSpecFromString(address) : std::string(address);
+    std::transform(mailbox.begin(), mailbox.end(), mailbox.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return mailbox;
+}
+
+void MailboxIndex::insert(const Key &key)
+{
+    d->insert(key);
+}
+
+void MailboxIndex::insert(const std::vector<Key> &keys)
+{
+    for (const Key &key : keys) {
+        d->insert(key);
+    }
+}
+
+void MailboxIndex::remove(const Key &key)
+{
+    d->remove(Fingerprint(key));
+}
+
+void MailboxIndex::remove(const Fingerprint &fpr)
+{
+    d->remove(fpr);
+}
+
+Error MailboxIndex::update(const ImportResult &result, Context *ctx)
+{
+    if (!ctx) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    std::vector<const char *> fingerprints;
+    for (const Import &import : result.imports()) {
+        if (!import.error() && import.fingerprint()) {
+            fingerprints.push_back(import.fingerprint());
+        }
+    }
+
+    // list in batches to bound the command line of the engine
+    static const size_t batchSize = 500;
+    for (size_t start = 0; start < fingerprints.size(); start += batchSize) {
+        const size_t end = std::min(fingerprints.size(), start + batchSize);
+        std::vector<const char *> patterns(fingerprints.begin() + start, fingerprints.begin() + end);
+        patterns.push_back(nullptr);
+
+        Error err = ctx->startKeyListing(patterns.data());
+        while (!err) {
+            const Key key = ctx->nextKey(err);
+            if (!err) {
+                d->insert(key);
+            }
+        }
+        ctx->endKeyListing();
+        if (err.code() != GPG_ERR_EOF) {
+            return err;
+        }
+    }
+    return Error();
+}
+
+void MailboxIndex::clear()
+{
+    d->byMailbox.clear();
+    d->mailboxesOfKey.clear();
+}
+
+size_t MailboxIndex::size() const
+{
+    return d->mailboxesOfKey.size();
+}
+
+std::vector<Key> MailboxIndex::candidates(const char *mailbox) const
+{
+    std::vector<Key> keys;
+    const auto it = d->byMailbox.find(normalizedMailbox(mailbox));
+    if (it == d->byMailbox.end()) {
+        return keys;
+    }
+    keys.reserve(it->second.size());
+    for (const auto &candidate : it->second) {
+        keys.push_back(candidate.key);
+    }
+    return keys;
+}
+
+Key MailboxIndex::bestEncryptionKey(const char *mailbox, UserID::Validity minimumValidity, Protocol protocol) const
+{
+    const auto it = d->byMailbox.find(normalizedMailbox(mailbox));
+    if (it == d->byMailbox.end()) {
+        return Key();
+    }
+    for (const auto &candidate : it->second) {
+        if (validity_rank(candidate.validity) < validity_rank(minimumValidity)) {
+            // the candidates are sorted by validity
+            break;
+        }
+        const Key &key = candidate.key;
+        if (key.isBad() || !key.canEncrypt()) {
+            continue;
+        }
+        if (protocol != UnknownProtocol && key.protocol() != protocol) {
+            continue;
+        }
+        return key;
+    }
+    return Key();
+}
+
+std::vector<Key> MailboxIndex::bestEncryptionKeys(const std::vector<std::string> &mailboxes,
+                                                  UserID::Validity minimumValidity, Protocol protocol) const
+{
+    std::vector<Key> keys;
+    keys.reserve(mailboxes.size());
+    for (const std::string &mailbox : mailboxes) {
+        keys.push_back(bestEncryptionKey(mailbox.c_str(), minimumValidity, protocol));
+    }
+    return keys;
+}
@@ -0,0 +1,113 @@
+/*
+  mailboxindex.h - resolves mailboxes to keys in-process
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_MAILBOXINDEX_H__
+#define __GPGMEPP_MAILBOXINDEX_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class Error;
+class Fingerprint;
+class ImportResult;
+
+/**
+ * An index of the mail addresses of the user IDs of keys.
+ *
+ * Resolving recipients with Key::locate() or a key listing needs an engine
+ * call per address. A MailboxIndex is filled with the keys of a listing and
+ * then resolves any number of addresses in-process. It is kept up to date
+ * with insert(), remove() and update() after imports or deletions.
+ *
+ * The candidates of a mailbox are ordered by the validity of the user ID
+ * with the address (best first, where Never ranks below Unknown) and then
+ * by the creation time of the key (newest first).
+ *
+ * This class is not thread-safe.
+ */
+class GPGMEPP_EXPORT MailboxIndex
+{
+public:
+    MailboxIndex();
+    ~MailboxIndex();
+
+    /** Returns the normalized form of the mail address of @p address, which
+     * may be a plain address or a user ID like "Name <address>". */
+    static std::string normalizedMailbox(const char *address);
+
+    /** Adds @p key, replacing an older copy of the same key. */
+    void insert(const Key &key);
+    void insert(const std::vector<Key> &keys);
+
+    void remove(const Key &key);
+    void remove(const Fingerprint &fpr);
+
+    /**
+     * Lists the keys which were imported according to @p result with @p ctx
+     * and inserts them. Use it after an import, and remove() after deleting
+     * keys.
+     */
+    Error update(const ImportResult &result, Context *ctx);
+
+    void clear();
+
+    /** Returns the number of keys in the index. */
+    size_t size() const;
+
+    /** Returns all keys with a user ID with the address @p mailbox. */
+    std::vector<Key> candidates(const char *mailbox) const;
+
+    /**
+     * Returns the best key for encrypting to @p mailbox, i.e. the first
+     * candidate which can encrypt, is not bad, and whose user ID with the
+     * address has at least the validity @p minimumValidity. If @p protocol
+     * is not UnknownProtocol, then only keys of this protocol are returned.
+     * Returns a null key if there is none.
+     */
+    Key bestEncryptionKey(const char *mailbox, UserID::Validity minimumValidity = UserID::Unknown,
+                          Protocol protocol = UnknownProtocol) const;
+
+    /** Returns the best encryption keys of all @p mailboxes in the same order. */
+    std::vector<Key> bestEncryptionKeys(const std::vector<std::string> &mailboxes,
+                                        UserID::Validity minimumValidity = UserID::Unknown,
+                                        Protocol protocol = UnknownProtocol) const;
+
+private:
+    MailboxIndex(const MailboxIndex &) = delete;
+    MailboxIndex &operator=(const MailboxIndex &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_MAILBOXINDEX_H__
@@ -0,0 +1,82 @@
+/*
+  memoryusage.h - approximate memory usage of keys and results
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_MEMORYUSAGE_H__
+#define __GPGMEPP_MEMORYUSAGE_H__
+
+#include <cstddef>
+
+namespace GpgME
+{
+
+/**
+ * The approximate number of bytes used by an object and the data it
+ * references, as returned by Key::approximateMemoryUsage() and by the
+ * approximateMemoryUsage() functions of the results.
+ *
+ * The data of keys and results is reference counted and shared by all
+ * copies of an object. Data which is referenced by other objects, too, is
+ * counted as shared, the rest as exclusive. The numbers include the
+ * structs and strings allocated by gpgme and by GpgME++, but not the
+ * overhead of the heap.
+ */
+struct MemoryUsage {
+    /** Bytes only used by this object. */
+    size_t exclusive = 0;
+    /** Bytes shared with other objects. */
+    size_t shared = 0;
+    /** The exclusive bytes plus the share of this object of the shared
+     * bytes, i.e. the shared bytes divided by the number of owners. Adds up
+     * to the memory used by all owners. */
+    size_t proportional = 0;
+
+    size_t total() const
+    {
+        return exclusive + shared;
+    }
+
+    /** Returns the usage of @p bytes referenced by @p owners objects. */
+    static MemoryUsage owned(size_t bytes, long owners)
+    {
+        MemoryUsage usage;
+        if (owners > 1) {
+            usage.shared = bytes;
+            usage.proportional = bytes / owners;
+        } else {
+            usage.exclusive = bytes;
+            usage.proportional = bytes;
+        }
+        return usage;
+    }
+
+    MemoryUsage &operator+=(const MemoryUsage &other)
+    {
+        exclusive += other.exclusive;
+        shared += other.shared;
+        proportional += other.proportional;
+        return *this;
+    }
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_MEMORYUSAGE_H__
@@ -30,6 +30,7 @@
 #include "gpgmepp_export.h"
 
 #include <memory>
+#include <string_view>
 
 #include <iosfwd>
 
@@ -45,6 +46,7 @@ public:
     explicit Notation(gpgme_sig_notation_t nota);
 
     Notation(const Notation &other) = default;
+    Notation(Notation &&other) = default;
     const Notation &operator=(Notation other)
     {
         swap(other);
@@ -62,6 +64,10 @@ public:
     const char *name() const;
     const char *value() const;
 
+    /** Views of name() and value(), which are empty if not set. */
+    std::string_view nameView() const;
+    std::string_view valueView() const;
+
     enum Flags {
         NoFlags = 0,
         HumanReadable = 1,
@@ -0,0 +1,243 @@
+/*
+  pipeline.cpp - streams data through several operations
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <pipeline.h>
+#include <data.h>
+#include <ringbufferdataprovider.h>
+
+#include "data_p.h"
+
+#include <cerrno>
+#include <thread>
+
+using namespace GpgME;
+
+#ifdef _WIN32
+using ssize_type = gpgme_ssize_t;
+using off_type = gpgme_off_t;
+#else
+using ssize_type = ssize_t;
+using off_type = off_t;
+#endif
+
+namespace
+{
+// one end of a pipe; releasing the data object closes the end
+class PipeEnd : public DataProvider
+{
+public:
+    PipeEnd(const std::shared_ptr<RingBufferDataProvider> &pipe, Operation op)
+        : mPipe(pipe),
+          mOp(op)
+    {
+    }
+
+    bool isSupported(Operation op) const override
+    {
+        return op == mOp || op == Release;
+    }
+
+    ssize_type read(void *buffer, size_t bufSize) override
+    {
+        return mPipe->read(buffer, bufSize);
+    }
+
+    ssize_type write(const void *buffer, size_t bufSize) override
+    {
+        return mPipe->write(buffer, bufSize);
+    }
+
+    off_type seek(off_type, int) override
+    {
+        errno = ESPIPE;
+        return -1;
+    }
+
+    void release() override
+    {
+        if (mOp == Read) {
+            mPipe->closeRead();
+        } else {
+            mPipe->closeWrite();
+        }
+    }
+
+private:
+    const std::shared_ptr<RingBufferDataProvider> mPipe;
+    const Operation mOp;
+};
+
+Data pipeEnd(const std::shared_ptr<RingBufferDataProvider> &pipe, DataProvider::Operation op)
+{
+    const auto provider = std::make_shared<PipeEnd>(pipe, op);
+    Data data(provider.get());
+    if (!data.isNull()) {
+        data.impl()->owner = provider;
+    }
+    return data;
+}
+}
+
+class Pipeline::Private
+{
+public:
+    explicit Private(size_t size)
+        : bufferSize(size)
+    {
+    }
+
+    const size_t bufferSize;
+    std::vector<Stage> stages;
+    std::vector<Error> errors;
+};
+
+Pipeline::Pipeline(size_t bufferSize)
+    : d(new Private(bufferSize))
+{
+}
+
+Pipeline::~Pipeline() = default;
+
+size_t Pipeline::bufferSize() const
+{
+    return d->bufferSize;
+}
+
+void Pipeline::addStage(const Stage &stage)
+{
+    d->stages.push_back(stage);
+}
+
+unsigned int Pipeline::stageCount() const
+{
+    return d->stages.size();
+}
+
+Error Pipeline::run(const Data &input, Data &output)
+{
+    const size_t count = d->stages.size();
+    d->errors.assign(count, Error());
+    if (count == 0) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+
+    // pipes[i] connects stage i to stage i + 1
+    std::vector<std::shared_ptr<RingBufferDataProvider>> pipes;
+    std::vector<Data> readEnds;
+    std::vector<Data> writeEnds;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        pipes.push_back(std::make_shared<RingBufferDataProvider>(d->bufferSize));
+        writeEnds.push_back(pipeEnd(pipes.back(), DataProvider::Write));
+        readEnds.push_back(pipeEnd(pipes.back(), DataProvider::Read));
+        if (writeEnds.back().isNull() || readEnds.back().isNull()) {
+            return Error::fromCode(GPG_ERR_ENOMEM);
+        }
+    }
+
+    const auto runStage = [&](size_t i) {
+        const Data &in = i == 0 ? input : readEnds[i - 1];
+        Data &out = i + 1 == count ? output : writeEnds[i];
+        d->errors[i] = d->stages[i](in, out);
+        // let the next stage see the end of its input and make writes of
+        // the previous stage fail instead of blocking forever
+        if (i + 1 < count) {
+            pipes[i]->closeWrite();
+        }
+        if (i > 0) {
+            pipes[i - 1]->closeRead();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for (size_t i = 0; i + 1 < count; ++i) {
+        threads.emplace_back(runStage, i);
+    }
+    runStage(count - 1);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (const Error &err : d->errors) {
+        if (err) {
+            return err;
+        }
+    }
+    return Error();
+}
+
+std::vector<Error> Pipeline::errors() const
+{
+    return d->errors;
+}
+
+Pipeline::Stage Pipeline::signAndEncryptStage(Context *ctx, const std::vector<Key> &recipients, Context::EncryptionFlags flags)
+{
+    return [ctx, recipients, flags](const Data &input, Data &output) {
+        const Error err = ctx->startCombinedSigningAndEncryption(recipients, input, output, flags);
+        return err ? err : ctx->wait();
+    };
+}
+
+Pipeline::Stage Pipeline::encryptStage(Context *ctx, const std::vector<Key> &recipients, Context::EncryptionFlags flags)
+{
+    return [ctx, recipients, flags](const Data &input, Data &output) {
+        const Error err = ctx->startEncryption(recipients, input, output, flags);
+        return err ? err : ctx->wait();
+    };
+}
+
+Pipeline::Stage Pipeline::signStage(Context *ctx, SignatureMode mode)
+{
+    return [ctx, mode](const Data &input, Data &output) {
+        const Error err = ctx->startSigning(input, output, mode);
+        return err ? err : ctx->wait();
+    };
+}
+
+Pipeline::Stage Pipeline::decryptAndVerifyStage(Context *ctx)
+{
+    return [ctx](const Data &input, Data &output) {
+        const Error err = ctx->startCombinedDecryptionAndVerification(input, output);
+        return err ? err : ctx->wait();
+    };
+}
+
+Pipeline::Stage Pipeline::decryptStage(Context *ctx)
+{
+    return [ctx](const Data &input, Data &output) {
+        const Error err = ctx->startDecryption(input, output);
+        return err ? err : ctx->wait();
+    };
+}
+
+Pipeline::Stage Pipeline::verifyOpaqueStage(Context *ctx)
+{
+    return [ctx](const Data &input, Data &output) {
+        const Error err = ctx->startOpaqueSignatureVerification(input, output);
+        return err ? err : ctx->wait();
+    };
+}
@@ -0,0 +1,100 @@
+/*
+  pipeline.h - streams data through several operations
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_PIPELINE_H__
+#define __GPGMEPP_PIPELINE_H__
+
+#include "global.h"
+#include "context.h"
+#include "error.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+class Data;
+
+/**
+ * Streams data through a chain of stages, e.g. sign+encrypt followed by
+ * an upload, or decrypt+verify followed by a parser.
+ *
+ * All stages run at the same time, each in its own thread. The output of
+ * a stage is connected to the input of the next stage by a bounded
+ * in-memory buffer. A stage writing to a full buffer blocks until the
+ * next stage has read from it, so the memory used for the intermediate
+ * data does not depend on the size of the payload.
+ *
+ * If a stage fails, then the next stage sees the end of its input and
+ * writes of the previous stage fail with EPIPE.
+ *
+ * The intermediate data objects are not seekable.
+ */
+class GPGMEPP_EXPORT Pipeline
+{
+public:
+    /** A stage reads @p input and writes the result to @p output. */
+    using Stage = std::function<Error(const Data &input, Data &output)>;
+
+    explicit Pipeline(size_t bufferSize = 64 * 1024);
+    ~Pipeline();
+
+    size_t bufferSize() const;
+
+    void addStage(const Stage &stage);
+    unsigned int stageCount() const;
+
+    /**
+     * Runs all stages. The first stage reads @p input and the last stage
+     * writes to @p output. Returns the error of the first failed stage.
+     */
+    Error run(const Data &input, Data &output);
+
+    /** Returns the errors of the stages of the last run. */
+    std::vector<Error> errors() const;
+
+    /**
+     * Stages running an operation on @p ctx, which must not be used
+     * otherwise while the pipeline runs. The results of the operation can
+     * be retrieved from the context after the run.
+     */
+    static Stage signAndEncryptStage(Context *ctx, const std::vector<Key> &recipients, Context::EncryptionFlags flags);
+    static Stage encryptStage(Context *ctx, const std::vector<Key> &recipients, Context::EncryptionFlags flags);
+    static Stage signStage(Context *ctx, SignatureMode mode);
+    static Stage decryptAndVerifyStage(Context *ctx);
+    static Stage decryptStage(Context *ctx);
+    static Stage verifyOpaqueStage(Context *ctx);
+
+private:
+    Pipeline(const Pipeline &) = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_PIPELINE_H__
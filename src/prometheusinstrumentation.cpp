@@ -0,0 +1,206 @@
+/*
+  prometheusinstrumentation.cpp - exports operation metrics in the Prometheus format
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <prometheusinstrumentation.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <locale>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+using namespace GpgME;
+
+namespace
+{
+struct Histogram {
+    // the number of observations per bucket, not cumulated; the last one
+    // is the +Inf bucket
+    std::vector<std::uint64_t> counts;
+    double sum = 0;
+
+    void observe(const std::vector<double> &bounds, double value)
+    {
+        if (counts.empty()) {
+            counts.resize(bounds.size() + 1);
+        }
+        const auto it = std::lower_bound(bounds.begin(), bounds.end(), value);
+        ++counts[it - bounds.begin()];
+        sum += value;
+    }
+};
+
+struct Metrics {
+    Histogram duration;
+    Histogram engineWait;
+    Histogram resultCopy;
+    std::uint64_t errors = 0;
+    std::uint64_t bytesIn = 0;
+    std::uint64_t bytesOut = 0;
+    std::uint64_t statusLines = 0;
+    std::uint64_t callbacks = 0;
+};
+
+const char *protocolName(Protocol protocol)
+{
+    switch (protocol) {
+    case OpenPGP:
+        return "openpgp";
+    case CMS:
+        return "cms";
+    default:
+        return "unknown";
+    }
+}
+
+double seconds(Instrumentation::Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+}
+
+class PrometheusInstrumentation::Private
+{
+public:
+    using Labels = std::pair<std::string, std::string>;
+    using Series = std::map<Labels, Metrics>;
+
+    explicit Private(const std::vector<double> &b)
+        : buckets(b.empty() ? defaultBuckets() : b)
+    {
+        std::sort(buckets.begin(), buckets.end());
+    }
+
+    static std::string labels(const Labels &l)
+    {
+        return "operation=\"" + l.second + "\",protocol=\"" + l.first + "\"";
+    }
+
+    void writeHistogram(std::ostream &out, const char *name, const char *help,
+                        Histogram Metrics::*histogram) const
+    {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " histogram\n";
+        for (const auto &s : series) {
+            const Histogram &h = s.second.*histogram;
+            const std::string l = labels(s.first);
+            std::uint64_t cumulated = 0;
+            for (size_t i = 0; i <= buckets.size(); ++i) {
+                cumulated += h.counts.empty() ? 0 : h.counts[i];
+                out << name << "_bucket{" << l << ",le=\"";
+                if (i < buckets.size()) {
+                    out << buckets[i];
+                } else {
+                    out << "+Inf";
+                }
+                out << "\"} " << cumulated << '\n';
+            }
+            out << name << "_sum{" << l << "} " << h.sum << '\n'
+                << name << "_count{" << l << "} " << cumulated << '\n';
+        }
+    }
+
+    void writeCounter(std::ostream &out, const char *name, const char *help,
+                      std::uint64_t Metrics::*counter) const
+    {
+        out << "# HELP " << name << ' ' << help << '\n'
+            << "# TYPE " << name << " counter\n";
+        for (const auto &s : series) {
+            out << name << '{' << labels(s.first) << "} " << s.second.*counter << '\n';
+        }
+    }
+
+    std::vector<double> buckets;
+    mutable std::mutex mutex;
+    Series series;
+};
+
+PrometheusInstrumentation::PrometheusInstrumentation(const std::vector<double> &buckets)
+    : d(new Private(buckets))
+{
+}
+
+PrometheusInstrumentation::~PrometheusInstrumentation() = default;
+
+std::vector<double> PrometheusInstrumentation::defaultBuckets()
+{
+    return {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+}
+
+const std::vector<double> &PrometheusInstrumentation::buckets() const
+{
+    return d->buckets;
+}
+
+void PrometheusInstrumentation::operationFinished(const Context *, const OperationStats &stats)
+{
+    const Private::Labels labels{protocolName(stats.protocol), operationName(stats.operation)};
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    Metrics &m = d->series[labels];
+    m.duration.observe(d->buckets, seconds(stats.duration()));
+    m.engineWait.observe(d->buckets, seconds(stats.engineWait));
+    m.resultCopy.observe(d->buckets, seconds(stats.resultCopy));
+    if (stats.error) {
+        ++m.errors;
+    }
+    m.bytesIn += stats.bytesIn;
+    m.bytesOut += stats.bytesOut;
+    m.statusLines += stats.statusLines;
+    m.callbacks += stats.callbacks;
+}
+
+std::string PrometheusInstrumentation::metrics() const
+{
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    out.precision(12);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->writeHistogram(out, "gpgmepp_operation_duration_seconds", "Duration of the operations.",
+                      &Metrics::duration);
+    d->writeHistogram(out, "gpgmepp_engine_wait_seconds", "Time spent waiting for the engine.",
+                      &Metrics::engineWait);
+    d->writeHistogram(out, "gpgmepp_result_copy_seconds", "Time spent creating the result objects.",
+                      &Metrics::resultCopy);
+    d->writeCounter(out, "gpgmepp_operation_errors_total", "Number of failed operations.",
+                    &Metrics::errors);
+    d->writeCounter(out, "gpgmepp_data_read_bytes_total", "Bytes read from the input data.",
+                    &Metrics::bytesIn);
+    d->writeCounter(out, "gpgmepp_data_written_bytes_total", "Bytes written to the output data.",
+                    &Metrics::bytesOut);
+    d->writeCounter(out, "gpgmepp_status_lines_total", "Number of status lines.",
+                    &Metrics::statusLines);
+    d->writeCounter(out, "gpgmepp_callbacks_total", "Number of progress and passphrase callbacks.",
+                    &Metrics::callbacks);
+    return out.str();
+}
+
+void PrometheusInstrumentation::reset()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->series.clear();
+}
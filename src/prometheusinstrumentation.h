@@ -0,0 +1,85 @@
+/*
+  prometheusinstrumentation.h - exports operation metrics in the Prometheus format
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_PROMETHEUSINSTRUMENTATION_H__
+#define __GPGMEPP_PROMETHEUSINSTRUMENTATION_H__
+
+#include "global.h"
+#include "interfaces/instrumentation.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * An Instrumentation which aggregates the reported operations into
+ * histograms and counters and returns them in the text exposition format
+ * of Prometheus.
+ *
+ * The metrics are labeled with the protocol and the name of the operation:
+ *  - gpgmepp_operation_duration_seconds (histogram)
+ *  - gpgmepp_engine_wait_seconds (histogram)
+ *  - gpgmepp_result_copy_seconds (histogram)
+ *  - gpgmepp_operation_errors_total
+ *  - gpgmepp_data_read_bytes_total and gpgmepp_data_written_bytes_total
+ *  - gpgmepp_status_lines_total and gpgmepp_callbacks_total
+ *
+ * The instrumentation is thread-safe and can be registered for many
+ * contexts or as global instrumentation.
+ */
+class GPGMEPP_EXPORT PrometheusInstrumentation : public Instrumentation
+{
+public:
+    /**
+     * @p buckets are the upper bounds of the histogram buckets in seconds
+     * in ascending order. If empty, then defaultBuckets() are used.
+     */
+    explicit PrometheusInstrumentation(const std::vector<double> &buckets = {});
+    ~PrometheusInstrumentation() override;
+
+    /** 1 ms to 10 s. */
+    static std::vector<double> defaultBuckets();
+    const std::vector<double> &buckets() const;
+
+    void operationFinished(const Context *ctx, const OperationStats &stats) override;
+
+    /** Returns the metrics in the Prometheus text exposition format. */
+    std::string metrics() const;
+
+    /** Removes all collected metrics. */
+    void reset();
+
+private:
+    PrometheusInstrumentation(const PrometheusInstrumentation &) = delete;
+    PrometheusInstrumentation &operator=(const PrometheusInstrumentation &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_PROMETHEUSINSTRUMENTATION_H__
@@ -0,0 +1,223 @@
+/*
+  randompool.cpp - a buffered pool of random bytes
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <randompool.h>
+#include <context.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace GpgME;
+
+static void wipe(unsigned char *p, size_t n)
+{
+    volatile unsigned char *v = p;
+    while (n--) {
+        *v++ = 0;
+    }
+}
+
+class RandomPool::Private
+{
+public:
+    Private(size_t c, size_t t)
+        : capacity(c ? c : 1024),
+          threshold(std::min(t ? t : capacity / 4, capacity)),
+          // a refill starts with less than threshold bytes left, so this
+          // never overflows and the buffer never has to be reallocated
+          buffer(2 * capacity),
+          head(0),
+          avail(0),
+          stopping(false),
+          refillRequested(true)
+    {
+        worker = std::thread(&Private::run, this);
+    }
+
+    ~Private()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wanted.notify_all();
+        worker.join();
+        wipe(buffer.data(), buffer.size());
+    }
+
+    // appends as much of [p, p + n) as fits behind the available bytes
+    void appendLocked(const unsigned char *p, size_t n)
+    {
+        n = std::min(n, buffer.size() - avail);
+        size_t tail = (head + avail) % buffer.size();
+        avail += n;
+        while (n) {
+            const size_t chunk = std::min(n, buffer.size() - tail);
+            std::memcpy(buffer.data() + tail, p, chunk);
+            tail = (tail + chunk) % buffer.size();
+            p += chunk;
+            n -= chunk;
+        }
+    }
+
+    void run()
+    {
+        std::unique_ptr<Context> ctx(Context::create(OpenPGP));
+        std::vector<unsigned char> fresh;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wanted.wait(lock, [this]() {
+                    return stopping || refillRequested;
+                });
+                if (stopping) {
+                    break;
+                }
+            }
+            fresh.resize(capacity);
+            const Error e = ctx ? ctx->generateRandomBytes(fresh.data(), fresh.size())
+                                : Error::fromCode(GPG_ERR_NOT_SUPPORTED);
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                refillRequested = false;
+                err = e;
+                if (!e) {
+                    appendLocked(fresh.data(), fresh.size());
+                }
+                ++generation;
+            }
+            wipe(fresh.data(), fresh.size());
+            refilled.notify_all();
+        }
+    }
+
+    const size_t capacity;
+    const size_t threshold;
+
+    mutable std::mutex mutex;
+    std::condition_variable wanted;
+    std::condition_variable refilled;
+    // ring buffer; the avail bytes starting at head have not been handed
+    // out, all other bytes are wiped
+    std::vector<unsigned char> buffer;
+    size_t head;
+    size_t avail;
+    bool stopping;
+    bool refillRequested;
+    unsigned long generation = 0;
+    Error err;
+    std::thread worker;
+};
+
+RandomPool::RandomPool(size_t capacity, size_t refillThreshold)
+    : d(new Private(capacity, refillThreshold))
+{
+}
+
+RandomPool::~RandomPool() = default;
+
+size_t RandomPool::capacity() const
+{
+    return d->capacity;
+}
+
+size_t RandomPool::available() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->avail;
+}
+
+Error RandomPool::fill(unsigned char *out, size_t count)
+{
+    if (!out && count) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    std::unique_lock<std::mutex> lock(d->mutex);
+    while (count) {
+        const size_t n = std::min({count, d->avail, d->buffer.size() - d->head});
+        if (n) {
+            unsigned char *const src = d->buffer.data() + d->head;
+            std::memcpy(out, src, n);
+            wipe(src, n);
+            d->head = (d->head + n) % d->buffer.size();
+            d->avail -= n;
+            out += n;
+            count -= n;
+        }
+        if ((count || d->avail < d->threshold) && !d->refillRequested) {
+            d->refillRequested = true;
+            d->wanted.notify_one();
+        }
+        if (!count) {
+            break;
+        }
+        if (d->avail) {
+            // the available bytes wrap around the end of the buffer
+            continue;
+        }
+        // wait for the refill; give up if it failed
+        const unsigned long generation = d->generation;
+        d->refilled.wait(lock, [this, generation]() {
+            return d->generation != generation;
+        });
+        if (d->err) {
+            return d->err;
+        }
+    }
+    return Error();
+}
+
+std::string RandomPool::zbase32String(Error *err)
+{
+    static const char alphabet[] = "ybndrfg8ejkmcpqxot1uwisza345h769";
+    // 30 characters of 5 bits each
+    unsigned char bytes[19];
+    const Error e = fill(bytes, sizeof bytes);
+    if (err) {
+        *err = e;
+    }
+    if (e) {
+        return std::string();
+    }
+    std::string result(30, '\0');
+    for (unsigned int i = 0; i < 30; ++i) {
+        const unsigned int bit = 5 * i;
+        const unsigned int word = (bytes[bit / 8] << 8) | (bit / 8 + 1 < sizeof bytes ? bytes[bit / 8 + 1] : 0);
+        result[i] = alphabet[(word >> (11 - bit % 8)) & 0x1f];
+    }
+    wipe(bytes, sizeof bytes);
+    return result;
+}
+
+Error RandomPool::lastError() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->err;
+}
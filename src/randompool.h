@@ -0,0 +1,89 @@
+/*
+  randompool.h - a buffered pool of random bytes
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_RANDOMPOOL_H__
+#define __GPGMEPP_RANDOMPOOL_H__
+
+#include "global.h"
+
+#include <memory>
+#include <string>
+
+namespace GpgME
+{
+
+/**
+ * A thread-safe pool of random bytes retrieved from gpg.
+ *
+ * The pool keeps a buffer of random bytes and hands out slices of it. A
+ * background thread with its own context refills the buffer whenever less
+ * than the refill threshold is left, so requests usually are served without
+ * any round-trip to the engine. Requests for more bytes than are left wait
+ * for the refill.
+ *
+ * Every byte is handed out only once, and the bytes are wiped from the
+ * buffer when they are handed out. The buffer of 2 * capacity() bytes is
+ * allocated once, so the random bytes are never copied around by a
+ * reallocation. Nevertheless the random bytes are kept
+ * in ordinary memory for a while; use the pool for nonces and tokens, but
+ * generate keys with the engine.
+ */
+class GPGMEPP_EXPORT RandomPool
+{
+public:
+    /**
+     * Creates a pool which fetches @p capacity bytes per refill. A refill is
+     * started when less than @p refillThreshold bytes are left, so the pool
+     * holds less than @p capacity + @p refillThreshold bytes. If
+     * @p refillThreshold is 0, then a quarter of @p capacity is used. The
+     * first fill is started immediately.
+     */
+    explicit RandomPool(size_t capacity = 64 * 1024, size_t refillThreshold = 0);
+    /** Stops the background thread. */
+    ~RandomPool();
+
+    size_t capacity() const;
+    /** Returns the number of bytes which can be handed out without waiting. */
+    size_t available() const;
+
+    /** Fills @p buffer with @p count random bytes. */
+    Error fill(unsigned char *buffer, size_t count);
+
+    /** Returns a string with 30 random z-base-32 characters, like
+     * Context::generateRandomZBase32String(). */
+    std::string zbase32String(Error *err = nullptr);
+
+    /** Returns the error of the last refill, if any. */
+    Error lastError() const;
+
+private:
+    RandomPool(const RandomPool &) = delete;
+    RandomPool &operator=(const RandomPool &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_RANDOMPOOL_H__
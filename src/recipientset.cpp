@@ -0,0 +1,74 @@
+/*
+  recipientset.cpp - a reusable set of recipients
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <recipientset.h>
+
+#include "context_p.h"
+
+using namespace GpgME;
+
+class RecipientSet::Private
+{
+public:
+    explicit Private(const std::vector<Key> &k)
+        : keys(k),
+          array(Context::Private::recipientKeys(keys))
+    {
+    }
+
+    // keeps the gpgme keys in array alive
+    const std::vector<Key> keys;
+    std::vector<gpgme_key_t> array;
+};
+
+RecipientSet::RecipientSet()
+    : d(new Private({}))
+{
+}
+
+RecipientSet::RecipientSet(const std::vector<Key> &recipients)
+    : d(new Private(recipients))
+{
+}
+
+bool RecipientSet::isEmpty() const
+{
+    return d->array.size() <= 1;
+}
+
+unsigned int RecipientSet::size() const
+{
+    return d->array.size() - 1;
+}
+
+const std::vector<Key> &RecipientSet::keys() const
+{
+    return d->keys;
+}
+
+gpgme_key_t *RecipientSet::gpgmeKeys() const
+{
+    return isEmpty() ? nullptr : d->array.data();
+}
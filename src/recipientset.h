@@ -0,0 +1,81 @@
+/*
+  recipientset.h - a reusable set of recipients
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_RECIPIENTSET_H__
+#define __GPGMEPP_RECIPIENTSET_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * An immutable set of recipients for encryption.
+ *
+ * The array of recipient keys needed by gpgme is built once when the set
+ * is created. Passing the set to Context::encrypt() and friends avoids
+ * rebuilding this array for every operation, e.g. if many messages are
+ * encrypted for the same recipients. Copies of a set share the array, and
+ * a set can be used by several contexts at the same time.
+ */
+class GPGMEPP_EXPORT RecipientSet
+{
+public:
+    RecipientSet();
+    explicit RecipientSet(const std::vector<Key> &recipients);
+
+    RecipientSet(const RecipientSet &other) = default;
+    RecipientSet(RecipientSet &&other) = default;
+    const RecipientSet &operator=(RecipientSet other)
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(RecipientSet &other)
+    {
+        using std::swap;
+        swap(this->d, other.d);
+    }
+
+    bool isEmpty() const;
+    unsigned int size() const;
+    const std::vector<Key> &keys() const;
+
+private:
+    friend class ::GpgME::Context;
+    // returns the NULL-terminated array or nullptr if the set is empty
+    gpgme_key_t *gpgmeKeys() const;
+
+    class Private;
+    std::shared_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+GPGMEPP_MAKE_STD_SWAP_SPECIALIZATION(RecipientSet)
+
+#endif // __GPGMEPP_RECIPIENTSET_H__
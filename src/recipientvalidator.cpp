@@ -0,0 +1,141 @@
+/*
+  recipientvalidator.cpp - checks recipients before encryption
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <recipientvalidator.h>
+
+#include "util.h"
+
+using namespace GpgME;
+
+namespace
+{
+bool isExpiredAt(time_t expirationTime, time_t now)
+{
+    return expirationTime > 0 && expirationTime <= now;
+}
+}
+
+class RecipientValidator::Private
+{
+public:
+    explicit Private(UserID::Validity v)
+        : minimumValidity(v)
+    {
+    }
+
+    const UserID::Validity minimumValidity;
+};
+
+RecipientValidator::RecipientValidator(UserID::Validity minimumValidity)
+    : d(new Private(minimumValidity))
+{
+}
+
+RecipientValidator::~RecipientValidator() = default;
+
+UserID::Validity RecipientValidator::minimumValidity() const
+{
+    return d->minimumValidity;
+}
+
+Error RecipientValidator::validate(const Key &key, time_t now) const
+{
+    if (key.isNull()) {
+        return Error::fromCode(GPG_ERR_NO_PUBKEY);
+    }
+    if (key.isRevoked()) {
+        return Error::fromCode(GPG_ERR_CERT_REVOKED);
+    }
+    if (!now) {
+        now = time(nullptr);
+    }
+    // the primary key expires with the key
+    if (key.isExpired() || isExpiredAt(key.subkey(0).expirationTime(), now)) {
+        return Error::fromCode(GPG_ERR_CERT_EXPIRED);
+    }
+    if (key.isDisabled()) {
+        return Error::fromCode(GPG_ERR_KEY_DISABLED);
+    }
+    if (key.isInvalid()) {
+        return Error::fromCode(GPG_ERR_UNUSABLE_PUBKEY);
+    }
+
+    bool hasEncryptionSubkey = false;
+    bool hasUsableSubkey = false;
+    for (const Subkey &subkey : key.subkeyRange()) {
+        if (!subkey.canEncrypt()) {
+            continue;
+        }
+        hasEncryptionSubkey = true;
+        if (!subkey.isBad() && !isExpiredAt(subkey.expirationTime(), now)) {
+            hasUsableSubkey = true;
+            break;
+        }
+    }
+    if (!hasEncryptionSubkey) {
+        return Error::fromCode(GPG_ERR_WRONG_KEY_USAGE);
+    }
+    if (!hasUsableSubkey) {
+        return Error::fromCode(GPG_ERR_UNUSABLE_PUBKEY);
+    }
+
+    if (validity_rank(d->minimumValidity) > validity_rank(UserID::Unknown)) {
+        bool valid = false;
+        for (const UserID &uid : key.userIDRange()) {
+            if (!uid.isBad() && validity_rank(uid.validity()) >= validity_rank(d->minimumValidity)) {
+                valid = true;
+                break;
+            }
+        }
+        if (!valid) {
+            return Error::fromCode(GPG_ERR_NOT_TRUSTED);
+        }
+    }
+    return Error();
+}
+
+std::vector<RecipientValidator::Rejection> RecipientValidator::check(const std::vector<Key> &keys) const
+{
+    std::vector<Rejection> rejected;
+    filter(keys, &rejected);
+    return rejected;
+}
+
+std::vector<Key> RecipientValidator::filter(const std::vector<Key> &keys, std::vector<Rejection> *rejected) const
+{
+    const time_t now = time(nullptr);
+    std::vector<Key> usable;
+    usable.reserve(keys.size());
+    for (const Key &key : keys) {
+        const Error reason = validate(key, now);
+        if (!reason) {
+            usable.push_back(key);
+        } else if (rejected) {
+            rejected->push_back({key, reason});
+        }
+    }
+    return usable;
+}
@@ -0,0 +1,103 @@
+/*
+  recipientvalidator.h - checks recipients before encryption
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_RECIPIENTVALIDATOR_H__
+#define __GPGMEPP_RECIPIENTVALIDATOR_H__
+
+#include "global.h"
+#include "error.h"
+#include "key.h"
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Checks recipient keys in-process before they are passed to an
+ * encryption, so that unusable recipients are found without running the
+ * engine.
+ *
+ * A key is rejected if it is null, revoked, expired, disabled or invalid,
+ * if none of its subkeys can be used for encryption, or if none of its
+ * user IDs has the minimum validity, where Never ranks below Unknown.
+ * The check is based on the state of the key as listed, except that
+ * expiration times are compared with the current time, so that keys kept
+ * in a cache expire in time.
+ *
+ * The reasons are the errors the engine would report for the recipient,
+ * see InvalidRecipient::reason():
+ * - GPG_ERR_NO_PUBKEY for a null key,
+ * - GPG_ERR_CERT_REVOKED, GPG_ERR_CERT_EXPIRED and GPG_ERR_KEY_DISABLED,
+ * - GPG_ERR_WRONG_KEY_USAGE if the key has no encryption subkey,
+ * - GPG_ERR_UNUSABLE_PUBKEY if the key is invalid or all encryption
+ *   subkeys are revoked, expired or invalid,
+ * - GPG_ERR_NOT_TRUSTED if the validity is too low.
+ *
+ * A validator can be used by several threads at the same time.
+ */
+class GPGMEPP_EXPORT RecipientValidator
+{
+public:
+    struct Rejection {
+        Key key;
+        Error reason;
+
+        const char *fingerprint() const
+        {
+            return key.primaryFingerprint();
+        }
+    };
+
+    /** With the default minimum validity of UserID::Unknown the validity
+     * is not checked, as for Context::AlwaysTrust. */
+    explicit RecipientValidator(UserID::Validity minimumValidity = UserID::Unknown);
+    ~RecipientValidator();
+
+    UserID::Validity minimumValidity() const;
+
+    /** Returns the reason why @p key cannot be used as recipient, or no
+     * error if it can. Expiration times are compared with @p now; 0 means
+     * the current time. */
+    Error validate(const Key &key, time_t now = 0) const;
+
+    /** Returns the rejected keys of @p keys in the order of @p keys. */
+    std::vector<Rejection> check(const std::vector<Key> &keys) const;
+
+    /** Returns the usable keys of @p keys in their order. If @p rejected is
+     * not null, then the rejected keys are appended to it. */
+    std::vector<Key> filter(const std::vector<Key> &keys, std::vector<Rejection> *rejected = nullptr) const;
+
+private:
+    RecipientValidator(const RecipientValidator &) = delete;
+    RecipientValidator &operator=(const RecipientValidator &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_RECIPIENTVALIDATOR_H__
@@ -0,0 +1,189 @@
+/*
+  remarklookup.cpp - looks up the remarks of many keys at once
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <remarklookup.h>
+#include <notation.h>
+
+#include <string.h>
+
+#include <string_view>
+#include <unordered_map>
+
+using namespace GpgME;
+
+class RemarkLookup::Private
+{
+public:
+    explicit Private(const std::vector<Key> &r)
+        : remarkers(r)
+    {
+        slots.reserve(remarkers.size());
+        for (const Key &remarker : remarkers) {
+            const char *const keyID = remarker.isNull() ? nullptr : remarker.keyID();
+            if (!keyID) {
+                hasNullRemarker = true;
+                slots.push_back(-1);
+                continue;
+            }
+            // several remarkers may be the same key
+            const auto it = slotForKeyID.emplace(keyID, slotForKeyID.size()).first;
+            slots.push_back(static_cast<int>(it->second));
+        }
+    }
+
+    static bool hasRemarks(const Key &key)
+    {
+        return key.protocol() == OpenPGP;
+    }
+
+    static bool isListedWithNotations(const Key &key)
+    {
+        return (key.keyListMode() & (Signatures | SignatureNotations)) == (Signatures | SignatureNotations);
+    }
+
+    // Finds the remark of every remarker key ID on uid. As in UserID::remark(),
+    // the last valid signature of a remarker wins.
+    std::vector<const char *> collect(const UserID &uid) const
+    {
+        std::vector<UserID::Signature> newest(slotForKeyID.size());
+        for (const UserID::Signature &sig : uid.signatureRange()) {
+            const char *const keyID = sig.signerKeyID();
+            if (!keyID || sig.isExpired() || sig.isRevokation() || sig.isInvalid() || sig.status() != UserID::Signature::NoError) {
+                continue;
+            }
+            const auto it = slotForKeyID.find(keyID);
+            if (it == slotForKeyID.end()) {
+                continue;
+            }
+            UserID::Signature &best = newest[it->second];
+            // equals because when the timestamps are the same we prefer the last in the list
+            if (best.isNull() || best.creationTime() <= sig.creationTime()) {
+                best = sig;
+            }
+        }
+
+        std::vector<const char *> result(newest.size(), nullptr);
+        for (size_t i = 0; i < newest.size(); ++i) {
+            if (newest[i].isNull()) {
+                continue;
+            }
+            for (const Notation &n : newest[i].notations()) {
+                if (n.name() && !strcmp(n.name(), "rem@gnupg.org")) {
+                    result[i] = n.value();
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    const std::vector<Key> remarkers;
+    // the slot in slotForKeyID of every remarker, or -1 for null remarkers
+    std::vector<int> slots;
+    std::unordered_map<std::string_view, size_t> slotForKeyID;
+    bool hasNullRemarker = false;
+};
+
+RemarkLookup::RemarkLookup(const std::vector<Key> &remarkers)
+    : d(new Private(remarkers))
+{
+}
+
+RemarkLookup::~RemarkLookup() = default;
+
+const std::vector<Key> &RemarkLookup::remarkers() const
+{
+    return d->remarkers;
+}
+
+std::vector<std::string> RemarkLookup::remarks(const UserID &uid, Error &error) const
+{
+    const std::vector<std::string_view> views = remarkViews(uid, error);
+    return std::vector<std::string>(views.begin(), views.end());
+}
+
+std::vector<std::string_view> RemarkLookup::remarkViews(const UserID &uid, Error &error) const
+{
+    std::vector<std::string_view> ret;
+    if (d->remarkers.empty()) {
+        return ret;
+    }
+
+    // report errors the same way as calling UserID::remark() for every remarker
+    const Key parent = uid.parent();
+    const bool hasRemarks = !uid.isNull() && Private::hasRemarks(parent);
+    const bool listedWithNotations = !uid.isNull() && Private::isListedWithNotations(parent);
+    std::vector<const char *> found;
+    if (hasRemarks && listedWithNotations) {
+        found = d->collect(uid);
+    }
+    for (const int slot : d->slots) {
+        if (uid.isNull() || slot < 0) {
+            error = Error::fromCode(GPG_ERR_GENERAL);
+            return ret;
+        }
+        if (!hasRemarks) {
+            continue;
+        }
+        if (!listedWithNotations) {
+            error = Error::fromCode(GPG_ERR_NO_DATA);
+            return ret;
+        }
+        if (const char *const remark = found[slot]) {
+            ret.push_back(remark);
+        }
+    }
+    return ret;
+}
+
+Error RemarkLookup::annotate(const std::vector<Key> &keys, const Callback &callback) const
+{
+    if (d->hasNullRemarker) {
+        return Error::fromCode(GPG_ERR_GENERAL);
+    }
+    if (d->remarkers.empty()) {
+        return Error();
+    }
+    for (const Key &key : keys) {
+        if (key.isNull() || !Private::hasRemarks(key)) {
+            continue;
+        }
+        if (!Private::isListedWithNotations(key)) {
+            return Error::fromCode(GPG_ERR_NO_DATA);
+        }
+        for (const UserID &uid : key.userIDRange()) {
+            const std::vector<const char *> found = d->collect(uid);
+            for (size_t i = 0; i < d->remarkers.size(); ++i) {
+                if (const char *const remark = found[d->slots[i]]) {
+                    if (callback) {
+                        callback(uid, d->remarkers[i], remark);
+                    }
+                }
+            }
+        }
+    }
+    return Error();
+}
@@ -0,0 +1,90 @@
+/*
+  remarklookup.h - looks up the remarks of many keys at once
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_REMARKLOOKUP_H__
+#define __GPGMEPP_REMARKLOOKUP_H__
+
+#include "global.h"
+#include "key.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Looks up the remarks made by a set of remarker keys.
+ *
+ * UserID::remark() walks all signatures of the user ID for every remarker.
+ * A RemarkLookup indexes the key IDs of the remarkers once and finds the
+ * remarks of all remarkers in a single pass over the signatures of a user
+ * ID.
+ *
+ * See UserID::remark() for the definition of a remark and for the keylist
+ * modes needed.
+ */
+class GPGMEPP_EXPORT RemarkLookup
+{
+public:
+    /** Called by annotate() for every remark found. */
+    using Callback = std::function<void(const UserID &uid, const Key &remarker, const char *remark)>;
+
+    explicit RemarkLookup(const std::vector<Key> &remarkers);
+    ~RemarkLookup();
+
+    const std::vector<Key> &remarkers() const;
+
+    /**
+     * Returns the remarks made on @p uid in the order of the remarkers.
+     * Remarkers without a remark are skipped. Same as UserID::remarks().
+     */
+    std::vector<std::string> remarks(const UserID &uid, Error &error) const;
+    /** Same as remarks() without copying the remarks. */
+    std::vector<std::string_view> remarkViews(const UserID &uid, Error &error) const;
+
+    /**
+     * Calls @p callback for every remark made by one of the remarkers on
+     * one of the user IDs of @p keys, e.g. the result of a key listing.
+     * Keys which are not OpenPGP keys are skipped.
+     *
+     * Returns GPG_ERR_GENERAL if one of the remarkers is null, and
+     * GPG_ERR_NO_DATA if an OpenPGP key was not listed with signatures and
+     * signature notations.
+     */
+    Error annotate(const std::vector<Key> &keys, const Callback &callback) const;
+
+private:
+    RemarkLookup(const RemarkLookup &) = delete;
+    RemarkLookup &operator=(const RemarkLookup &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_REMARKLOOKUP_H__
@@ -27,6 +27,7 @@
 
 #include "gpgmefw.h"
 #include "error.h"
+#include "memoryusage.h"
 
 #include <algorithm> // std::swap
 
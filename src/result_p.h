@@ -25,6 +25,15 @@
 #ifndef __GPGMEPP_RESULT_P_H__
 #define __GPGMEPP_RESULT_P_H__
 
+#include "memoryusage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 #define make_default_ctor(x) \
     GpgME::x::x() : GpgME::Result(), d() {}
 
@@ -42,4 +51,122 @@
     make_error_ctor(x) \
     make_isNull(x)
 
+namespace GpgME
+{
+
+// A bump allocator for the deep copies of the gpgme results held by the
+// Private classes of the results. All objects and strings are reserved in
+// a first pass over the gpgme lists, so that the copies are made in a single
+// allocation. Nothing is freed before the arena is destroyed.
+class ResultArena
+{
+public:
+    ResultArena() = default;
+    ResultArena(const ResultArena &) = delete;
+    ResultArena &operator=(const ResultArena &) = delete;
+
+    template <typename T>
+    void reserve(size_t n = 1)
+    {
+        mPending += n * sizeof(T) + alignof(T) - 1;
+    }
+
+    void reserveString(const char *str)
+    {
+        if (str) {
+            mPending += std::strlen(str) + 1;
+        }
+    }
+
+    // copies of the C structs of gpgme; the pointers of the copy still
+    // point to the strings and lists of the original
+    template <typename T>
+    T *copy(const T &value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only C structs can be copied");
+        void *const p = allocate(sizeof(T), alignof(T));
+        std::memcpy(p, &value, sizeof(T));
+        return static_cast<T *>(p);
+    }
+
+    template <typename T>
+    T *allocateArray(size_t n)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "only C structs can be allocated");
+        return n ? static_cast<T *>(allocate(n * sizeof(T), alignof(T))) : nullptr;
+    }
+
+    char *copyString(const char *str)
+    {
+        if (!str) {
+            return nullptr;
+        }
+        const size_t size = std::strlen(str) + 1;
+        char *const p = static_cast<char *>(allocate(size, 1));
+        std::memcpy(p, str, size);
+        return p;
+    }
+
+    // the bytes of all blocks of the arena
+    size_t allocatedBytes() const
+    {
+        return mAllocated + mMore.capacity() * sizeof(std::unique_ptr<char[]>);
+    }
+
+private:
+    void *allocate(size_t size, size_t align)
+    {
+        size_t padding = (align - reinterpret_cast<uintptr_t>(mNext) % align) % align;
+        if (!mNext || padding + size > mLeft) {
+            // the reserved size is allocated at once; later reservations
+            // (e.g. for merged results) get a new block
+            const size_t blockSize = std::max(mPending, size + align - 1);
+            std::unique_ptr<char[]> block(new char[blockSize]);
+            mAllocated += blockSize;
+            mNext = block.get();
+            mLeft = blockSize;
+            if (!mFirst) {
+                mFirst = std::move(block);
+            } else {
+                mMore.push_back(std::move(block));
+            }
+            mPending = 0;
+            padding = (align - reinterpret_cast<uintptr_t>(mNext) % align) % align;
+        }
+        void *const p = mNext + padding;
+        mNext += padding + size;
+        mLeft -= padding + size;
+        return p;
+    }
+
+    std::unique_ptr<char[]> mFirst;
+    std::vector<std::unique_ptr<char[]>> mMore;
+    char *mNext = nullptr;
+    size_t mLeft = 0;
+    size_t mPending = 0;
+    size_t mAllocated = 0;
+};
+
+// the heap memory of the elements of a vector
+template <typename T>
+size_t heapBytes(const std::vector<T> &v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+// the memory usage of a result of type R whose Private d refers to
+// additional bytes
+template <typename R, typename P>
+MemoryUsage resultMemoryUsage(const std::shared_ptr<P> &d, size_t bytes)
+{
+    MemoryUsage usage;
+    usage.exclusive = usage.proportional = sizeof(R);
+    if (d) {
+        usage += MemoryUsage::owned(sizeof(P) + bytes, d.use_count());
+    }
+    return usage;
+}
+
+}
+
 #endif // __GPGMEPP_RESULT_P_H__
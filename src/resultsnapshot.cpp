@@ -0,0 +1,1166 @@
+/*
+  resultsnapshot.cpp - serialized results and keys with zero-copy views
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <resultsnapshot.h>
+
+#include <cstring>
+
+using namespace GpgME;
+
+// The layout of a snapshot:
+//
+//   header:  "GPPS", version (u32), kind (u32), size (u32)
+//   records: a record is a sequence of 8 byte fields; a field is either
+//            an integer (u64), a string (offset and length, u32 each) or
+//            an array of records (offset and count, u32 each)
+//
+// The root record follows the header. Arrays and strings may be anywhere
+// in the buffer, but the arrays are laid out in the order of a depth-first
+// walk, which lets the validation check for overlaps in linear time.
+// Strings are followed by a NUL byte.
+
+namespace
+{
+constexpr char Magic[4] = {'G', 'P', 'P', 'S'};
+constexpr size_t HeaderSize = 16;
+constexpr size_t FieldSize = 8;
+
+enum Kind {
+    VerificationKind = 1,
+    DecryptionKind = 2,
+    ImportKind = 3,
+    KeyKind = 4,
+};
+
+enum FieldType {
+    Integer,
+    String,
+    Array,
+};
+
+struct Schema {
+    // the types of the fields; for arrays, the schema of the elements
+    std::initializer_list<std::pair<FieldType, const Schema *>> fields;
+
+    unsigned int size() const
+    {
+        return fields.size();
+    }
+};
+
+// the field numbers and the schemas of the records
+
+namespace NotationField
+{
+enum { Name, Value, Flags, Count };
+}
+const Schema NotationSchema{{{String, nullptr}, {String, nullptr}, {Integer, nullptr}}};
+
+namespace SignatureField
+{
+enum { Summary, Status, Fingerprint, CreationTime, ExpirationTime, Validity, NonValidityReason,
+       PublicKeyAlgorithm, HashAlgorithm, Flags, PolicyURL, Notations, Count };
+enum { NeverExpires = 1, WrongKeyUsage = 2, ChainModel = 4, DeVs = 8, BetaCompliance = 16 };
+}
+const Schema SignatureSchema{{{Integer, nullptr}, {Integer, nullptr}, {String, nullptr}, {Integer, nullptr},
+                              {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr},
+                              {Integer, nullptr}, {Integer, nullptr}, {String, nullptr}, {Array, &NotationSchema}}};
+
+namespace VerificationField
+{
+enum { Error, FileName, Signatures, Count };
+}
+const Schema VerificationSchema{{{Integer, nullptr}, {String, nullptr}, {Array, &SignatureSchema}}};
+
+namespace RecipientField
+{
+enum { KeyID, PublicKeyAlgorithm, Status, Count };
+}
+const Schema RecipientSchema{{{String, nullptr}, {Integer, nullptr}, {Integer, nullptr}}};
+
+namespace DecryptionField
+{
+enum { Error, FileName, UnsupportedAlgorithm, SymkeyAlgo, Flags, Recipients, Count };
+enum { WrongKeyUsage = 1, DeVs = 2, BetaCompliance = 4, Mime = 8, LegacyCipherNoMDC = 16 };
+}
+const Schema DecryptionSchema{{{Integer, nullptr}, {String, nullptr}, {String, nullptr}, {String, nullptr},
+                               {Integer, nullptr}, {Array, &RecipientSchema}}};
+
+namespace ImportStatusField
+{
+enum { Fingerprint, Error, Status, Count };
+}
+const Schema ImportStatusSchema{{{String, nullptr}, {Integer, nullptr}, {Integer, nullptr}}};
+
+namespace ImportField
+{
+enum { Error, Considered, KeysWithoutUserID, Imported, RSAImported, Unchanged, NewUserIDs, NewSubkeys,
+       NewSignatures, NewRevocations, SecretKeysConsidered, SecretKeysImported, SecretKeysUnchanged,
+       NotImported, V3KeysSkipped, Imports, Count };
+}
+const Schema ImportSchema{{{Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr},
+                           {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr},
+                           {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr},
+                           {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Array, &ImportStatusSchema}}};
+
+namespace SubkeyField
+{
+enum { KeyID, Fingerprint, KeyGrip, CardSerialNumber, CreationTime, ExpirationTime, PublicKeyAlgorithm,
+       Length, Flags, Count };
+enum { NeverExpires = 1, Revoked = 2, Expired = 4, Invalid = 8, Disabled = 16, CanEncrypt = 32, CanSign = 64,
+       CanCertify = 128, CanAuthenticate = 256, Qualified = 512, DeVs = 1024, CardKey = 2048, Secret = 4096 };
+}
+const Schema SubkeySchema{{{String, nullptr}, {String, nullptr}, {String, nullptr}, {String, nullptr},
+                           {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr},
+                           {Integer, nullptr}}};
+
+namespace UserIDField
+{
+enum { Id, Name, Email, Comment, AddrSpec, Validity, Flags, Origin, LastUpdate, Count };
+enum { Revoked = 1, Invalid = 2 };
+}
+const Schema UserIDSchema{{{String, nullptr}, {String, nullptr}, {String, nullptr}, {String, nullptr},
+                           {String, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr},
+                           {Integer, nullptr}}};
+
+namespace KeyField
+{
+enum { Protocol, OwnerTrust, Flags, IssuerSerial, IssuerName, ChainID, PrimaryFingerprint, KeyListMode,
+       Origin, LastUpdate, Subkeys, UserIDs, Count };
+enum { Revoked = 1, Expired = 2, Disabled = 4, Invalid = 8, CanEncrypt = 16, CanSign = 32, CanCertify = 64,
+       CanAuthenticate = 128, Qualified = 256, DeVs = 512, HasSecret = 1024, Root = 2048 };
+}
+const Schema KeySchema{{{Integer, nullptr}, {Integer, nullptr}, {Integer, nullptr}, {String, nullptr},
+                        {String, nullptr}, {String, nullptr}, {String, nullptr}, {Integer, nullptr},
+                        {Integer, nullptr}, {Integer, nullptr}, {Array, &SubkeySchema}, {Array, &UserIDSchema}}};
+
+std::uint32_t readU32(const char *p)
+{
+    const auto *const u = reinterpret_cast<const unsigned char *>(p);
+    return std::uint32_t(u[0]) | std::uint32_t(u[1]) << 8 | std::uint32_t(u[2]) << 16 | std::uint32_t(u[3]) << 24;
+}
+
+std::uint64_t readU64(const char *p)
+{
+    return std::uint64_t(readU32(p)) | std::uint64_t(readU32(p + 4)) << 32;
+}
+
+void writeU32(char *p, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = char((value >> (8 * i)) & 0xff);
+    }
+}
+
+void writeU64(char *p, std::uint64_t value)
+{
+    writeU32(p, std::uint32_t(value));
+    writeU32(p + 4, std::uint32_t(value >> 32));
+}
+
+unsigned int flag(bool set, unsigned int bit)
+{
+    return set ? bit : 0;
+}
+
+// builds a snapshot; records are addressed by their offset, because the
+// buffer grows while it is written
+class Writer
+{
+public:
+    Writer(Kind kind, const Schema &root)
+        : buffer(HeaderSize, '\0')
+    {
+        std::memcpy(&buffer[0], Magic, sizeof(Magic));
+        writeU32(&buffer[4], SnapshotRecord::FormatVersion);
+        writeU32(&buffer[8], kind);
+        mRoot = allocate(root.size(), 1);
+    }
+
+    size_t root() const
+    {
+        return mRoot;
+    }
+
+    // returns the offset of the first record
+    size_t allocate(unsigned int fields, size_t count)
+    {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + fields * FieldSize * count);
+        return offset;
+    }
+
+    void setInteger(size_t record, unsigned int field, std::uint64_t value)
+    {
+        writeU64(&buffer[record + field * FieldSize], value);
+    }
+
+    void setString(size_t record, unsigned int field, std::string_view value)
+    {
+        const size_t offset = buffer.size();
+        buffer.append(value.data(), value.size());
+        buffer += '\0';
+        writeU32(&buffer[record + field * FieldSize], std::uint32_t(offset));
+        writeU32(&buffer[record + field * FieldSize + 4], std::uint32_t(value.size()));
+    }
+
+    void setString(size_t record, unsigned int field, const char *value)
+    {
+        setString(record, field, value ? std::string_view(value) : std::string_view());
+    }
+
+    // returns the offset of the first element
+    size_t setArray(size_t record, unsigned int field, const Schema &element, size_t count)
+    {
+        const size_t offset = allocate(element.size(), count);
+        writeU32(&buffer[record + field * FieldSize], std::uint32_t(offset));
+        writeU32(&buffer[record + field * FieldSize + 4], std::uint32_t(count));
+        return offset;
+    }
+
+    std::string finish()
+    {
+        writeU32(&buffer[12], std::uint32_t(buffer.size()));
+        return std::move(buffer);
+    }
+
+private:
+    std::string buffer;
+    size_t mRoot;
+};
+
+class Validator
+{
+public:
+    Validator(const char *d, size_t s)
+        : data(d), size(s), cursor(HeaderSize)
+    {
+    }
+
+    bool record(const Schema &schema, size_t offset)
+    {
+        const char *const fields = data + offset;
+        unsigned int i = 0;
+        for (const auto &field : schema.fields) {
+            const char *const p = fields + FieldSize * i++;
+            if (field.first == Integer) {
+                continue;
+            }
+            const std::uint64_t start = readU32(p);
+            const std::uint64_t n = readU32(p + 4);
+            if (field.first == String) {
+                if (start + n >= size || data[start + n] != '\0') {
+                    return false;
+                }
+                continue;
+            }
+            const std::uint64_t stride = field.second->size() * FieldSize;
+            if (start < cursor || start + n * stride > size) {
+                return false;
+            }
+            cursor = start + n * stride;
+            for (std::uint64_t e = 0; e < n; ++e) {
+                if (!record(*field.second, start + e * stride)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // checks the header and the root record
+    bool validate(Kind kind, const Schema &root)
+    {
+        if (!data || size < HeaderSize + root.size() * FieldSize
+            || std::memcmp(data, Magic, sizeof(Magic)) != 0
+            || readU32(data + 8) != std::uint32_t(kind) || readU32(data + 12) != size) {
+            return false;
+        }
+        cursor = HeaderSize + root.size() * FieldSize;
+        return record(root, HeaderSize);
+    }
+
+private:
+    const char *const data;
+    const std::uint64_t size;
+    std::uint64_t cursor;
+};
+
+// returns the root record of a valid buffer or nullptr
+const char *checkedRoot(const char *data, size_t size, Kind kind, const Schema &schema, Error &err)
+{
+    if (size >= HeaderSize && std::memcmp(data, Magic, sizeof(Magic)) == 0
+        && readU32(data + 4) != SnapshotRecord::FormatVersion) {
+        err = Error::fromCode(GPG_ERR_UNSUPPORTED_PROTOCOL);
+        return nullptr;
+    }
+    if (!Validator(data, size).validate(kind, schema)) {
+        err = Error::fromCode(GPG_ERR_INV_DATA);
+        return nullptr;
+    }
+    err = Error();
+    return data + HeaderSize;
+}
+}
+
+std::uint64_t SnapshotRecord::integer(unsigned int field) const
+{
+    return mRecord ? readU64(mRecord + field * FieldSize) : 0;
+}
+
+std::string_view SnapshotRecord::string(unsigned int field) const
+{
+    if (!mRecord) {
+        return std::string_view();
+    }
+    const char *const p = mRecord + field * FieldSize;
+    return std::string_view(mBase + readU32(p), readU32(p + 4));
+}
+
+unsigned int SnapshotRecord::count(unsigned int field) const
+{
+    return mRecord ? readU32(mRecord + field * FieldSize + 4) : 0;
+}
+
+const char *SnapshotRecord::element(unsigned int field, unsigned int index, unsigned int elementFields) const
+{
+    if (index >= count(field)) {
+        return nullptr;
+    }
+    return mBase + readU32(mRecord + field * FieldSize) + size_t(index) * elementFields * FieldSize;
+}
+
+//
+// NotationSnapshot
+//
+
+std::string_view NotationSnapshot::name() const
+{
+    return string(NotationField::Name);
+}
+
+std::string_view NotationSnapshot::value() const
+{
+    return string(NotationField::Value);
+}
+
+Notation::Flags NotationSnapshot::flags() const
+{
+    return static_cast<Notation::Flags>(integer(NotationField::Flags));
+}
+
+//
+// SignatureSnapshot
+//
+
+Signature::Summary SignatureSnapshot::summary() const
+{
+    return static_cast<Signature::Summary>(integer(SignatureField::Summary));
+}
+
+Error SignatureSnapshot::status() const
+{
+    return Error(static_cast<unsigned int>(integer(SignatureField::Status)));
+}
+
+std::string_view SignatureSnapshot::fingerprint() const
+{
+    return string(SignatureField::Fingerprint);
+}
+
+time_t SignatureSnapshot::creationTime() const
+{
+    return static_cast<time_t>(std::int64_t(integer(SignatureField::CreationTime)));
+}
+
+time_t SignatureSnapshot::expirationTime() const
+{
+    return static_cast<time_t>(std::int64_t(integer(SignatureField::ExpirationTime)));
+}
+
+bool SignatureSnapshot::neverExpires() const
+{
+    return integer(SignatureField::Flags) & SignatureField::NeverExpires;
+}
+
+bool SignatureSnapshot::isWrongKeyUsage() const
+{
+    return integer(SignatureField::Flags) & SignatureField::WrongKeyUsage;
+}
+
+bool SignatureSnapshot::isVerifiedUsingChainModel() const
+{
+    return integer(SignatureField::Flags) & SignatureField::ChainModel;
+}
+
+bool SignatureSnapshot::isDeVs() const
+{
+    return integer(SignatureField::Flags) & SignatureField::DeVs;
+}
+
+bool SignatureSnapshot::isBetaCompliance() const
+{
+    return integer(SignatureField::Flags) & SignatureField::BetaCompliance;
+}
+
+Signature::Validity SignatureSnapshot::validity() const
+{
+    return static_cast<Signature::Validity>(integer(SignatureField::Validity));
+}
+
+Error SignatureSnapshot::nonValidityReason() const
+{
+    return Error(static_cast<unsigned int>(integer(SignatureField::NonValidityReason)));
+}
+
+unsigned int SignatureSnapshot::publicKeyAlgorithm() const
+{
+    return integer(SignatureField::PublicKeyAlgorithm);
+}
+
+unsigned int SignatureSnapshot::hashAlgorithm() const
+{
+    return integer(SignatureField::HashAlgorithm);
+}
+
+std::string_view SignatureSnapshot::policyURL() const
+{
+    return string(SignatureField::PolicyURL);
+}
+
+unsigned int SignatureSnapshot::numNotations() const
+{
+    return count(SignatureField::Notations);
+}
+
+NotationSnapshot SignatureSnapshot::notation(unsigned int index) const
+{
+    const char *const record = element(SignatureField::Notations, index, NotationField::Count);
+    return record ? NotationSnapshot(mBase, record) : NotationSnapshot();
+}
+
+//
+// VerificationSnapshot
+//
+
+std::string VerificationSnapshot::serialize(const VerificationResult &result)
+{
+    Writer w(VerificationKind, VerificationSchema);
+    const size_t root = w.root();
+    w.setInteger(root, VerificationField::Error, result.error().encodedError());
+    w.setString(root, VerificationField::FileName, result.fileName());
+    const std::vector<Signature> signatures = result.signatures();
+    const size_t first = w.setArray(root, VerificationField::Signatures, SignatureSchema, signatures.size());
+    for (size_t i = 0; i < signatures.size(); ++i) {
+        using namespace SignatureField;
+        const Signature &sig = signatures[i];
+        const size_t r = first + i * SignatureField::Count * FieldSize;
+        w.setInteger(r, Summary, sig.summary());
+        w.setInteger(r, Status, sig.status().encodedError());
+        w.setString(r, Fingerprint, sig.fingerprint());
+        w.setInteger(r, CreationTime, std::int64_t(sig.creationTime()));
+        w.setInteger(r, ExpirationTime, std::int64_t(sig.expirationTime()));
+        w.setInteger(r, Validity, sig.validity());
+        w.setInteger(r, NonValidityReason, sig.nonValidityReason().encodedError());
+        w.setInteger(r, PublicKeyAlgorithm, sig.publicKeyAlgorithm());
+        w.setInteger(r, HashAlgorithm, sig.hashAlgorithm());
+        w.setInteger(r, SignatureField::Flags, flag(sig.neverExpires(), NeverExpires)
+                     | flag(sig.isWrongKeyUsage(), WrongKeyUsage)
+                     | flag(sig.isVerifiedUsingChainModel(), ChainModel)
+                     | flag(sig.isDeVs(), DeVs)
+                     | flag(sig.isBetaCompliance(), BetaCompliance));
+        w.setString(r, PolicyURL, sig.policyURL());
+        const std::vector<Notation> notations = sig.notations();
+        const size_t n = w.setArray(r, Notations, NotationSchema, notations.size());
+        for (size_t j = 0; j < notations.size(); ++j) {
+            const size_t nr = n + j * NotationField::Count * FieldSize;
+            w.setString(nr, NotationField::Name, notations[j].name());
+            w.setString(nr, NotationField::Value, notations[j].value());
+            w.setInteger(nr, NotationField::Flags, notations[j].flags());
+        }
+    }
+    return w.finish();
+}
+
+VerificationSnapshot VerificationSnapshot::fromBuffer(const char *data, size_t size, Error &err)
+{
+    const char *const root = checkedRoot(data, size, VerificationKind, VerificationSchema, err);
+    return root ? VerificationSnapshot(data, root) : VerificationSnapshot();
+}
+
+Error VerificationSnapshot::error() const
+{
+    return Error(static_cast<unsigned int>(integer(VerificationField::Error)));
+}
+
+std::string_view VerificationSnapshot::fileName() const
+{
+    return string(VerificationField::FileName);
+}
+
+unsigned int VerificationSnapshot::numSignatures() const
+{
+    return count(VerificationField::Signatures);
+}
+
+SignatureSnapshot VerificationSnapshot::signature(unsigned int index) const
+{
+    const char *const record = element(VerificationField::Signatures, index, SignatureField::Count);
+    return record ? SignatureSnapshot(mBase, record) : SignatureSnapshot();
+}
+
+//
+// RecipientSnapshot
+//
+
+std::string_view RecipientSnapshot::keyID() const
+{
+    return string(RecipientField::KeyID);
+}
+
+unsigned int RecipientSnapshot::publicKeyAlgorithm() const
+{
+    return integer(RecipientField::PublicKeyAlgorithm);
+}
+
+Error RecipientSnapshot::status() const
+{
+    return Error(static_cast<unsigned int>(integer(RecipientField::Status)));
+}
+
+//
+// DecryptionSnapshot
+//
+
+std::string DecryptionSnapshot::serialize(const DecryptionResult &result)
+{
+    using namespace DecryptionField;
+    Writer w(DecryptionKind, DecryptionSchema);
+    const size_t root = w.root();
+    w.setInteger(root, DecryptionField::Error, result.error().encodedError());
+    w.setString(root, FileName, result.fileName());
+    w.setString(root, UnsupportedAlgorithm, result.unsupportedAlgorithm());
+    w.setString(root, SymkeyAlgo, result.symkeyAlgo());
+    w.setInteger(root, DecryptionField::Flags, flag(result.isWrongKeyUsage(), WrongKeyUsage)
+                 | flag(result.isDeVs(), DeVs)
+                 | flag(result.isBetaCompliance(), BetaCompliance)
+                 | flag(result.isMime(), Mime)
+                 | flag(result.isLegacyCipherNoMDC(), LegacyCipherNoMDC));
+    const std::vector<DecryptionResult::Recipient> recipients = result.recipients();
+    const size_t first = w.setArray(root, Recipients, RecipientSchema, recipients.size());
+    for (size_t i = 0; i < recipients.size(); ++i) {
+        const size_t r = first + i * RecipientField::Count * FieldSize;
+        w.setString(r, RecipientField::KeyID, recipients[i].keyID());
+        w.setInteger(r, RecipientField::PublicKeyAlgorithm, recipients[i].publicKeyAlgorithm());
+        w.setInteger(r, RecipientField::Status, recipients[i].status().encodedError());
+    }
+    return w.finish();
+}
+
+DecryptionSnapshot DecryptionSnapshot::fromBuffer(const char *data, size_t size, Error &err)
+{
+    const char *const root = checkedRoot(data, size, DecryptionKind, DecryptionSchema, err);
+    return root ? DecryptionSnapshot(data, root) : DecryptionSnapshot();
+}
+
+Error DecryptionSnapshot::error() const
+{
+    return Error(static_cast<unsigned int>(integer(DecryptionField::Error)));
+}
+
+std::string_view DecryptionSnapshot::fileName() const
+{
+    return string(DecryptionField::FileName);
+}
+
+std::string_view DecryptionSnapshot::unsupportedAlgorithm() const
+{
+    return string(DecryptionField::UnsupportedAlgorithm);
+}
+
+std::string_view DecryptionSnapshot::symkeyAlgo() const
+{
+    return string(DecryptionField::SymkeyAlgo);
+}
+
+bool DecryptionSnapshot::isWrongKeyUsage() const
+{
+    return integer(DecryptionField::Flags) & DecryptionField::WrongKeyUsage;
+}
+
+bool DecryptionSnapshot::isDeVs() const
+{
+    return integer(DecryptionField::Flags) & DecryptionField::DeVs;
+}
+
+bool DecryptionSnapshot::isBetaCompliance() const
+{
+    return integer(DecryptionField::Flags) & DecryptionField::BetaCompliance;
+}
+
+bool DecryptionSnapshot::isMime() const
+{
+    return integer(DecryptionField::Flags) & DecryptionField::Mime;
+}
+
+bool DecryptionSnapshot::isLegacyCipherNoMDC() const
+{
+    return integer(DecryptionField::Flags) & DecryptionField::LegacyCipherNoMDC;
+}
+
+unsigned int DecryptionSnapshot::numRecipients() const
+{
+    return count(DecryptionField::Recipients);
+}
+
+RecipientSnapshot DecryptionSnapshot::recipient(unsigned int index) const
+{
+    const char *const record = element(DecryptionField::Recipients, index, RecipientField::Count);
+    return record ? RecipientSnapshot(mBase, record) : RecipientSnapshot();
+}
+
+//
+// ImportStatusSnapshot
+//
+
+std::string_view ImportStatusSnapshot::fingerprint() const
+{
+    return string(ImportStatusField::Fingerprint);
+}
+
+Error ImportStatusSnapshot::error() const
+{
+    return Error(static_cast<unsigned int>(integer(ImportStatusField::Error)));
+}
+
+Import::Status ImportStatusSnapshot::status() const
+{
+    return static_cast<Import::Status>(integer(ImportStatusField::Status));
+}
+
+//
+// ImportSnapshot
+//
+
+std::string ImportSnapshot::serialize(const ImportResult &result)
+{
+    using namespace ImportField;
+    Writer w(ImportKind, ImportSchema);
+    const size_t root = w.root();
+    w.setInteger(root, ImportField::Error, result.error().encodedError());
+    w.setInteger(root, Considered, std::int64_t(result.numConsidered()));
+    w.setInteger(root, KeysWithoutUserID, std::int64_t(result.numKeysWithoutUserID()));
+    w.setInteger(root, Imported, std::int64_t(result.numImported()));
+    w.setInteger(root, RSAImported, std::int64_t(result.numRSAImported()));
+    w.setInteger(root, Unchanged, std::int64_t(result.numUnchanged()));
+    w.setInteger(root, NewUserIDs, std::int64_t(result.newUserIDs()));
+    w.setInteger(root, NewSubkeys, std::int64_t(result.newSubkeys()));
+    w.setInteger(root, NewSignatures, std::int64_t(result.newSignatures()));
+    w.setInteger(root, NewRevocations, std::int64_t(result.newRevocations()));
+    w.setInteger(root, SecretKeysConsidered, std::int64_t(result.numSecretKeysConsidered()));
+    w.setInteger(root, SecretKeysImported, std::int64_t(result.numSecretKeysImported()));
+    w.setInteger(root, SecretKeysUnchanged, std::int64_t(result.numSecretKeysUnchanged()));
+    w.setInteger(root, NotImported, std::int64_t(result.notImported()));
+    w.setInteger(root, V3KeysSkipped, std::int64_t(result.numV3KeysSkipped()));
+    const std::vector<Import> imports = result.imports();
+    const size_t first = w.setArray(root, Imports, ImportStatusSchema, imports.size());
+    for (size_t i = 0; i < imports.size(); ++i) {
+        const size_t r = first + i * ImportStatusField::Count * FieldSize;
+        w.setString(r, ImportStatusField::Fingerprint, imports[i].fingerprint());
+        w.setInteger(r, ImportStatusField::Error, imports[i].error().encodedError());
+        w.setInteger(r, ImportStatusField::Status, imports[i].status());
+    }
+    return w.finish();
+}
+
+ImportSnapshot ImportSnapshot::fromBuffer(const char *data, size_t size, Error &err)
+{
+    const char *const root = checkedRoot(data, size, ImportKind, ImportSchema, err);
+    return root ? ImportSnapshot(data, root) : ImportSnapshot();
+}
+
+Error ImportSnapshot::error() const
+{
+    return Error(static_cast<unsigned int>(integer(ImportField::Error)));
+}
+
+int ImportSnapshot::numConsidered() const
+{
+    return int(std::int64_t(integer(ImportField::Considered)));
+}
+
+int ImportSnapshot::numKeysWithoutUserID() const
+{
+    return int(std::int64_t(integer(ImportField::KeysWithoutUserID)));
+}
+
+int ImportSnapshot::numImported() const
+{
+    return int(std::int64_t(integer(ImportField::Imported)));
+}
+
+int ImportSnapshot::numRSAImported() const
+{
+    return int(std::int64_t(integer(ImportField::RSAImported)));
+}
+
+int ImportSnapshot::numUnchanged() const
+{
+    return int(std::int64_t(integer(ImportField::Unchanged)));
+}
+
+int ImportSnapshot::newUserIDs() const
+{
+    return int(std::int64_t(integer(ImportField::NewUserIDs)));
+}
+
+int ImportSnapshot::newSubkeys() const
+{
+    return int(std::int64_t(integer(ImportField::NewSubkeys)));
+}
+
+int ImportSnapshot::newSignatures() const
+{
+    return int(std::int64_t(integer(ImportField::NewSignatures)));
+}
+
+int ImportSnapshot::newRevocations() const
+{
+    return int(std::int64_t(integer(ImportField::NewRevocations)));
+}
+
+int ImportSnapshot::numSecretKeysConsidered() const
+{
+    return int(std::int64_t(integer(ImportField::SecretKeysConsidered)));
+}
+
+int ImportSnapshot::numSecretKeysImported() const
+{
+    return int(std::int64_t(integer(ImportField::SecretKeysImported)));
+}
+
+int ImportSnapshot::numSecretKeysUnchanged() const
+{
+    return int(std::int64_t(integer(ImportField::SecretKeysUnchanged)));
+}
+
+int ImportSnapshot::notImported() const
+{
+    return int(std::int64_t(integer(ImportField::NotImported)));
+}
+
+int ImportSnapshot::numV3KeysSkipped() const
+{
+    return int(std::int64_t(integer(ImportField::V3KeysSkipped)));
+}
+
+unsigned int ImportSnapshot::numImports() const
+{
+    return count(ImportField::Imports);
+}
+
+ImportStatusSnapshot ImportSnapshot::import(unsigned int index) const
+{
+    const char *const record = element(ImportField::Imports, index, ImportStatusField::Count);
+    return record ? ImportStatusSnapshot(mBase, record) : ImportStatusSnapshot();
+}
+
+//
+// SubkeySnapshot
+//
+
+std::string_view SubkeySnapshot::keyID() const
+{
+    return string(SubkeyField::KeyID);
+}
+
+std::string_view SubkeySnapshot::fingerprint() const
+{
+    return string(SubkeyField::Fingerprint);
+}
+
+std::string_view SubkeySnapshot::keyGrip() const
+{
+    return string(SubkeyField::KeyGrip);
+}
+
+std::string_view SubkeySnapshot::cardSerialNumber() const
+{
+    return string(SubkeyField::CardSerialNumber);
+}
+
+time_t SubkeySnapshot::creationTime() const
+{
+    return static_cast<time_t>(std::int64_t(integer(SubkeyField::CreationTime)));
+}
+
+time_t SubkeySnapshot::expirationTime() const
+{
+    return static_cast<time_t>(std::int64_t(integer(SubkeyField::ExpirationTime)));
+}
+
+bool SubkeySnapshot::neverExpires() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::NeverExpires;
+}
+
+bool SubkeySnapshot::isRevoked() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::Revoked;
+}
+
+bool SubkeySnapshot::isExpired() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::Expired;
+}
+
+bool SubkeySnapshot::isInvalid() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::Invalid;
+}
+
+bool SubkeySnapshot::isDisabled() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::Disabled;
+}
+
+bool SubkeySnapshot::canEncrypt() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::CanEncrypt;
+}
+
+bool SubkeySnapshot::canSign() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::CanSign;
+}
+
+bool SubkeySnapshot::canCertify() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::CanCertify;
+}
+
+bool SubkeySnapshot::canAuthenticate() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::CanAuthenticate;
+}
+
+bool SubkeySnapshot::isQualified() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::Qualified;
+}
+
+bool SubkeySnapshot::isDeVs() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::DeVs;
+}
+
+bool SubkeySnapshot::isCardKey() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::CardKey;
+}
+
+bool SubkeySnapshot::isSecret() const
+{
+    return integer(SubkeyField::Flags) & SubkeyField::Secret;
+}
+
+Subkey::PubkeyAlgo SubkeySnapshot::publicKeyAlgorithm() const
+{
+    return static_cast<Subkey::PubkeyAlgo>(integer(SubkeyField::PublicKeyAlgorithm));
+}
+
+unsigned int SubkeySnapshot::length() const
+{
+    return integer(SubkeyField::Length);
+}
+
+//
+// UserIDSnapshot
+//
+
+std::string_view UserIDSnapshot::id() const
+{
+    return string(UserIDField::Id);
+}
+
+std::string_view UserIDSnapshot::name() const
+{
+    return string(UserIDField::Name);
+}
+
+std::string_view UserIDSnapshot::email() const
+{
+    return string(UserIDField::Email);
+}
+
+std::string_view UserIDSnapshot::comment() const
+{
+    return string(UserIDField::Comment);
+}
+
+std::string_view UserIDSnapshot::addrSpec() const
+{
+    return string(UserIDField::AddrSpec);
+}
+
+UserID::Validity UserIDSnapshot::validity() const
+{
+    return static_cast<UserID::Validity>(integer(UserIDField::Validity));
+}
+
+bool UserIDSnapshot::isRevoked() const
+{
+    return integer(UserIDField::Flags) & UserIDField::Revoked;
+}
+
+bool UserIDSnapshot::isInvalid() const
+{
+    return integer(UserIDField::Flags) & UserIDField::Invalid;
+}
+
+Key::Origin UserIDSnapshot::origin() const
+{
+    return static_cast<Key::Origin>(integer(UserIDField::Origin));
+}
+
+time_t UserIDSnapshot::lastUpdate() const
+{
+    return static_cast<time_t>(std::int64_t(integer(UserIDField::LastUpdate)));
+}
+
+//
+// KeySnapshot
+//
+
+std::string KeySnapshot::serialize(const Key &key)
+{
+    Writer w(KeyKind, KeySchema);
+    const size_t root = w.root();
+    {
+        using namespace KeyField;
+        w.setInteger(root, KeyField::Protocol, key.protocol());
+        w.setInteger(root, KeyField::OwnerTrust, key.ownerTrust());
+        w.setInteger(root, KeyField::Flags, flag(key.isRevoked(), Revoked)
+                     | flag(key.isExpired(), Expired)
+                     | flag(key.isDisabled(), Disabled)
+                     | flag(key.isInvalid(), Invalid)
+                     | flag(key.canEncrypt(), CanEncrypt)
+                     | flag(key.canSign(), CanSign)
+                     | flag(key.canCertify(), CanCertify)
+                     | flag(key.canAuthenticate(), CanAuthenticate)
+                     | flag(key.isQualified(), Qualified)
+                     | flag(key.isDeVs(), DeVs)
+                     | flag(key.hasSecret(), HasSecret)
+                     | flag(key.isRoot(), Root));
+        w.setString(root, IssuerSerial, key.issuerSerial());
+        w.setString(root, IssuerName, key.issuerName());
+        w.setString(root, ChainID, key.chainID());
+        w.setString(root, PrimaryFingerprint, key.primaryFingerprint());
+        w.setInteger(root, KeyField::KeyListMode, key.keyListMode());
+        w.setInteger(root, KeyField::Origin, key.origin());
+        w.setInteger(root, LastUpdate, std::int64_t(key.lastUpdate()));
+    }
+
+    const std::vector<Subkey> subkeys = key.subkeys();
+    const size_t firstSubkey = w.setArray(root, KeyField::Subkeys, SubkeySchema, subkeys.size());
+    for (size_t i = 0; i < subkeys.size(); ++i) {
+        using namespace SubkeyField;
+        const Subkey &subkey = subkeys[i];
+        const size_t r = firstSubkey + i * SubkeyField::Count * FieldSize;
+        w.setString(r, KeyID, subkey.keyID());
+        w.setString(r, Fingerprint, subkey.fingerprint());
+        w.setString(r, KeyGrip, subkey.keyGrip());
+        w.setString(r, CardSerialNumber, subkey.cardSerialNumber());
+        w.setInteger(r, CreationTime, std::int64_t(subkey.creationTime()));
+        w.setInteger(r, ExpirationTime, std::int64_t(subkey.expirationTime()));
+        w.setInteger(r, PublicKeyAlgorithm, subkey.publicKeyAlgorithm());
+        w.setInteger(r, Length, subkey.length());
+        w.setInteger(r, SubkeyField::Flags, flag(subkey.neverExpires(), NeverExpires)
+                     | flag(subkey.isRevoked(), Revoked)
+                     | flag(subkey.isExpired(), Expired)
+                     | flag(subkey.isInvalid(), Invalid)
+                     | flag(subkey.isDisabled(), Disabled)
+                     | flag(subkey.canEncrypt(), CanEncrypt)
+                     | flag(subkey.canSign(), CanSign)
+                     | flag(subkey.canCertify(), CanCertify)
+                     | flag(subkey.canAuthenticate(), CanAuthenticate)
+                     | flag(subkey.isQualified(), Qualified)
+                     | flag(subkey.isDeVs(), DeVs)
+                     | flag(subkey.isCardKey(), CardKey)
+                     | flag(subkey.isSecret(), Secret));
+    }
+
+    const std::vector<UserID> uids = key.userIDs();
+    const size_t firstUid = w.setArray(root, KeyField::UserIDs, UserIDSchema, uids.size());
+    for (size_t i = 0; i < uids.size(); ++i) {
+        using namespace UserIDField;
+        const UserID &uid = uids[i];
+        const size_t r = firstUid + i * UserIDField::Count * FieldSize;
+        w.setString(r, Id, uid.id());
+        w.setString(r, Name, uid.name());
+        w.setString(r, Email, uid.email());
+        w.setString(r, Comment, uid.comment());
+        w.setString(r, AddrSpec, uid.addrSpecView());
+        w.setInteger(r, Validity, uid.validity());
+        w.setInteger(r, UserIDField::Flags, flag(uid.isRevoked(), Revoked) | flag(uid.isInvalid(), Invalid));
+        w.setInteger(r, Origin, uid.origin());
+        w.setInteger(r, LastUpdate, std::int64_t(uid.lastUpdate()));
+    }
+    return w.finish();
+}
+
+KeySnapshot KeySnapshot::fromBuffer(const char *data, size_t size, Error &err)
+{
+    const char *const root = checkedRoot(data, size, KeyKind, KeySchema, err);
+    return root ? KeySnapshot(data, root) : KeySnapshot();
+}
+
+Protocol KeySnapshot::protocol() const
+{
+    return static_cast<Protocol>(integer(KeyField::Protocol));
+}
+
+Key::OwnerTrust KeySnapshot::ownerTrust() const
+{
+    return static_cast<Key::OwnerTrust>(integer(KeyField::OwnerTrust));
+}
+
+bool KeySnapshot::isRevoked() const
+{
+    return integer(KeyField::Flags) & KeyField::Revoked;
+}
+
+bool KeySnapshot::isExpired() const
+{
+    return integer(KeyField::Flags) & KeyField::Expired;
+}
+
+bool KeySnapshot::isDisabled() const
+{
+    return integer(KeyField::Flags) & KeyField::Disabled;
+}
+
+bool KeySnapshot::isInvalid() const
+{
+    return integer(KeyField::Flags) & KeyField::Invalid;
+}
+
+bool KeySnapshot::canEncrypt() const
+{
+    return integer(KeyField::Flags) & KeyField::CanEncrypt;
+}
+
+bool KeySnapshot::canSign() const
+{
+    return integer(KeyField::Flags) & KeyField::CanSign;
+}
+
+bool KeySnapshot::canCertify() const
+{
+    return integer(KeyField::Flags) & KeyField::CanCertify;
+}
+
+bool KeySnapshot::canAuthenticate() const
+{
+    return integer(KeyField::Flags) & KeyField::CanAuthenticate;
+}
+
+bool KeySnapshot::isQualified() const
+{
+    return integer(KeyField::Flags) & KeyField::Qualified;
+}
+
+bool KeySnapshot::isDeVs() const
+{
+    return integer(KeyField::Flags) & KeyField::DeVs;
+}
+
+bool KeySnapshot::hasSecret() const
+{
+    return integer(KeyField::Flags) & KeyField::HasSecret;
+}
+
+bool KeySnapshot::isRoot() const
+{
+    return integer(KeyField::Flags) & KeyField::Root;
+}
+
+std::string_view KeySnapshot::issuerSerial() const
+{
+    return string(KeyField::IssuerSerial);
+}
+
+std::string_view KeySnapshot::issuerName() const
+{
+    return string(KeyField::IssuerName);
+}
+
+std::string_view KeySnapshot::chainID() const
+{
+    return string(KeyField::ChainID);
+}
+
+std::string_view KeySnapshot::primaryFingerprint() const
+{
+    return string(KeyField::PrimaryFingerprint);
+}
+
+unsigned int KeySnapshot::keyListMode() const
+{
+    return integer(KeyField::KeyListMode);
+}
+
+Key::Origin KeySnapshot::origin() const
+{
+    return static_cast<Key::Origin>(integer(KeyField::Origin));
+}
+
+time_t KeySnapshot::lastUpdate() const
+{
+    return static_cast<time_t>(std::int64_t(integer(KeyField::LastUpdate)));
+}
+
+unsigned int KeySnapshot::numSubkeys() const
+{
+    return count(KeyField::Subkeys);
+}
+
+SubkeySnapshot KeySnapshot::subkey(unsigned int index) const
+{
+    const char *const record = element(KeyField::Subkeys, index, SubkeyField::Count);
+    return record ? SubkeySnapshot(mBase, record) : SubkeySnapshot();
+}
+
+unsigned int KeySnapshot::numUserIDs() const
+{
+    return count(KeyField::UserIDs);
+}
+
+UserIDSnapshot KeySnapshot::userID(unsigned int index) const
+{
+    const char *const record = element(KeyField::UserIDs, index, UserIDField::Count);
+    return record ? UserIDSnapshot(mBase, record) : UserIDSnapshot();
+}
@@ -0,0 +1,357 @@
+/*
+  resultsnapshot.h - serialized results and keys with zero-copy views
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_RESULTSNAPSHOT_H__
+#define __GPGMEPP_RESULTSNAPSHOT_H__
+
+#include "global.h"
+#include "decryptionresult.h"
+#include "importresult.h"
+#include "key.h"
+#include "notation.h"
+#include "verificationresult.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace GpgME
+{
+
+/**
+ * Result snapshots are a compact binary serialization of verification,
+ * decryption and import results and of keys, e.g. for shared caches or
+ * for passing results to another process.
+ *
+ * serialize() writes a self-contained buffer with a versioned header.
+ * fromBuffer() checks the buffer once and returns a read-only view on it;
+ * the accessors of the views read directly from the buffer without
+ * copying, so the buffer must outlive the views. The strings returned by
+ * the views are NUL-terminated, i.e. data() can be used as C string.
+ *
+ * Only the plain data is serialized, e.g. a SignatureSnapshot cannot look
+ * up its key and a DecryptionSnapshot does not contain the session key.
+ * Integers are stored in little-endian byte order, so that snapshots can
+ * be exchanged between different hosts.
+ */
+class GPGMEPP_EXPORT SnapshotRecord
+{
+public:
+    /** The version of the format written by serialize(). */
+    static constexpr unsigned int FormatVersion = 1;
+
+    bool isNull() const
+    {
+        return !mRecord;
+    }
+
+protected:
+    SnapshotRecord() = default;
+    SnapshotRecord(const char *base, const char *record)
+        : mBase(base), mRecord(record)
+    {
+    }
+
+    std::uint64_t integer(unsigned int field) const;
+    std::string_view string(unsigned int field) const;
+    unsigned int count(unsigned int field) const;
+    // returns the record of element index of the array in field
+    const char *element(unsigned int field, unsigned int index, unsigned int elementFields) const;
+
+    const char *mBase = nullptr;
+    const char *mRecord = nullptr;
+};
+
+class GPGMEPP_EXPORT NotationSnapshot : public SnapshotRecord
+{
+public:
+    NotationSnapshot() = default;
+
+    std::string_view name() const;
+    std::string_view value() const;
+    Notation::Flags flags() const;
+
+private:
+    friend class SignatureSnapshot;
+    NotationSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT SignatureSnapshot : public SnapshotRecord
+{
+public:
+    SignatureSnapshot() = default;
+
+    Signature::Summary summary() const;
+    Error status() const;
+    std::string_view fingerprint() const;
+    time_t creationTime() const;
+    time_t expirationTime() const;
+    bool neverExpires() const;
+    bool isWrongKeyUsage() const;
+    bool isVerifiedUsingChainModel() const;
+    bool isDeVs() const;
+    bool isBetaCompliance() const;
+    Signature::Validity validity() const;
+    Error nonValidityReason() const;
+    unsigned int publicKeyAlgorithm() const;
+    unsigned int hashAlgorithm() const;
+    std::string_view policyURL() const;
+
+    unsigned int numNotations() const;
+    NotationSnapshot notation(unsigned int index) const;
+
+private:
+    friend class VerificationSnapshot;
+    SignatureSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT VerificationSnapshot : public SnapshotRecord
+{
+public:
+    VerificationSnapshot() = default;
+
+    static std::string serialize(const VerificationResult &result);
+    /** Returns a null snapshot and sets @p err if @p data is not a valid
+     * serialized verification result. */
+    static VerificationSnapshot fromBuffer(const char *data, size_t size, Error &err);
+
+    Error error() const;
+    std::string_view fileName() const;
+
+    unsigned int numSignatures() const;
+    SignatureSnapshot signature(unsigned int index) const;
+
+private:
+    VerificationSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT RecipientSnapshot : public SnapshotRecord
+{
+public:
+    RecipientSnapshot() = default;
+
+    std::string_view keyID() const;
+    unsigned int publicKeyAlgorithm() const;
+    Error status() const;
+
+private:
+    friend class DecryptionSnapshot;
+    RecipientSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT DecryptionSnapshot : public SnapshotRecord
+{
+public:
+    DecryptionSnapshot() = default;
+
+    static std::string serialize(const DecryptionResult &result);
+    static DecryptionSnapshot fromBuffer(const char *data, size_t size, Error &err);
+
+    Error error() const;
+    std::string_view fileName() const;
+    std::string_view unsupportedAlgorithm() const;
+    std::string_view symkeyAlgo() const;
+    bool isWrongKeyUsage() const;
+    bool isDeVs() const;
+    bool isBetaCompliance() const;
+    bool isMime() const;
+    bool isLegacyCipherNoMDC() const;
+
+    unsigned int numRecipients() const;
+    RecipientSnapshot recipient(unsigned int index) const;
+
+private:
+    DecryptionSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT ImportStatusSnapshot : public SnapshotRecord
+{
+public:
+    ImportStatusSnapshot() = default;
+
+    std::string_view fingerprint() const;
+    Error error() const;
+    Import::Status status() const;
+
+private:
+    friend class ImportSnapshot;
+    ImportStatusSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT ImportSnapshot : public SnapshotRecord
+{
+public:
+    ImportSnapshot() = default;
+
+    static std::string serialize(const ImportResult &result);
+    static ImportSnapshot fromBuffer(const char *data, size_t size, Error &err);
+
+    Error error() const;
+    int numConsidered() const;
+    int numKeysWithoutUserID() const;
+    int numImported() const;
+    int numRSAImported() const;
+    int numUnchanged() const;
+    int newUserIDs() const;
+    int newSubkeys() const;
+    int newSignatures() const;
+    int newRevocations() const;
+    int numSecretKeysConsidered() const;
+    int numSecretKeysImported() const;
+    int numSecretKeysUnchanged() const;
+    int notImported() const;
+    int numV3KeysSkipped() const;
+
+    unsigned int numImports() const;
+    ImportStatusSnapshot import(unsigned int index) const;
+
+private:
+    ImportSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT SubkeySnapshot : public SnapshotRecord
+{
+public:
+    SubkeySnapshot() = default;
+
+    std::string_view keyID() const;
+    std::string_view fingerprint() const;
+    std::string_view keyGrip() const;
+    std::string_view cardSerialNumber() const;
+    time_t creationTime() const;
+    time_t expirationTime() const;
+    bool neverExpires() const;
+    bool isRevoked() const;
+    bool isExpired() const;
+    bool isInvalid() const;
+    bool isDisabled() const;
+    bool canEncrypt() const;
+    bool canSign() const;
+    bool canCertify() const;
+    bool canAuthenticate() const;
+    bool isQualified() const;
+    bool isDeVs() const;
+    bool isCardKey() const;
+    bool isSecret() const;
+    Subkey::PubkeyAlgo publicKeyAlgorithm() const;
+    unsigned int length() const;
+
+private:
+    friend class KeySnapshot;
+    SubkeySnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+class GPGMEPP_EXPORT UserIDSnapshot : public SnapshotRecord
+{
+public:
+    UserIDSnapshot() = default;
+
+    std::string_view id() const;
+    std::string_view name() const;
+    std::string_view email() const;
+    std::string_view comment() const;
+    std::string_view addrSpec() const;
+    UserID::Validity validity() const;
+    bool isRevoked() const;
+    bool isInvalid() const;
+    Key::Origin origin() const;
+    time_t lastUpdate() const;
+
+private:
+    friend class KeySnapshot;
+    UserIDSnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+/** The metadata of a key; signatures of user IDs are not included. */
+class GPGMEPP_EXPORT KeySnapshot : public SnapshotRecord
+{
+public:
+    KeySnapshot() = default;
+
+    static std::string serialize(const Key &key);
+    static KeySnapshot fromBuffer(const char *data, size_t size, Error &err);
+
+    Protocol protocol() const;
+    Key::OwnerTrust ownerTrust() const;
+    bool isRevoked() const;
+    bool isExpired() const;
+    bool isDisabled() const;
+    bool isInvalid() const;
+    bool canEncrypt() const;
+    bool canSign() const;
+    bool canCertify() const;
+    bool canAuthenticate() const;
+    bool isQualified() const;
+    bool isDeVs() const;
+    bool hasSecret() const;
+    bool isRoot() const;
+    std::string_view issuerSerial() const;
+    std::string_view issuerName() const;
+    std::string_view chainID() const;
+    std::string_view primaryFingerprint() const;
+    unsigned int keyListMode() const;
+    Key::Origin origin() const;
+    time_t lastUpdate() const;
+
+    unsigned int numSubkeys() const;
+    SubkeySnapshot subkey(unsigned int index) const;
+    unsigned int numUserIDs() const;
+    UserIDSnapshot userID(unsigned int index) const;
+
+private:
+    KeySnapshot(const char *base, const char *record)
+        : SnapshotRecord(base, record)
+    {
+    }
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_RESULTSNAPSHOT_H__
@@ -0,0 +1,257 @@
+/*
+  ringbufferdataprovider.cpp - a bounded single-producer/single-consumer buffer
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <ringbufferdataprovider.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace GpgME;
+
+#ifdef _WIN32
+using ssize_type = gpgme_ssize_t;
+using off_type = gpgme_off_t;
+#else
+using ssize_type = ssize_t;
+using off_type = off_t;
+#endif
+
+class RingBufferDataProvider::Private
+{
+public:
+    Private(size_t c, Mode m)
+        : mode(m),
+          head(0),
+          tail(0),
+          writeClosed(false),
+          readClosed(false),
+          readerWaiting(false),
+          writerWaiting(false)
+    {
+        size_t capacity = 16;
+        while (capacity < c) {
+            capacity <<= 1;
+        }
+        buffer.resize(capacity);
+    }
+
+    size_t mask() const
+    {
+        return buffer.size() - 1;
+    }
+
+    // wakes up the other side if it is parked; the flag is checked after
+    // the index has been published, so that a side which is about to park
+    // either sees the new index or is woken up
+    void wake(std::atomic<bool> &waiting)
+    {
+        if (waiting) {
+            const std::lock_guard<std::mutex> lock(mutex);
+            condition.notify_all();
+        }
+    }
+
+    template <typename Predicate>
+    void park(std::atomic<bool> &waiting, Predicate ready)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        waiting = true;
+        condition.wait(lock, ready);
+        waiting = false;
+    }
+
+    const Mode mode;
+    std::vector<char> buffer;
+    // head and tail only grow; the readable bytes are [head, tail)
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<bool> writeClosed;
+    std::atomic<bool> readClosed;
+    std::atomic<bool> readerWaiting;
+    std::atomic<bool> writerWaiting;
+    std::mutex mutex;
+    std::condition_variable condition;
+};
+
+RingBufferDataProvider::RingBufferDataProvider(size_t capacity, Mode mode)
+    : d(new Private(capacity, mode))
+{
+}
+
+RingBufferDataProvider::~RingBufferDataProvider() = default;
+
+size_t RingBufferDataProvider::capacity() const
+{
+    return d->buffer.size();
+}
+
+RingBufferDataProvider::Mode RingBufferDataProvider::mode() const
+{
+    return d->mode;
+}
+
+size_t RingBufferDataProvider::size() const
+{
+    return d->tail - d->head;
+}
+
+void RingBufferDataProvider::closeWrite()
+{
+    d->writeClosed = true;
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->condition.notify_all();
+}
+
+bool RingBufferDataProvider::isWriteClosed() const
+{
+    return d->writeClosed;
+}
+
+void RingBufferDataProvider::closeRead()
+{
+    d->readClosed = true;
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->condition.notify_all();
+}
+
+bool RingBufferDataProvider::isReadClosed() const
+{
+    return d->readClosed;
+}
+
+bool RingBufferDataProvider::isSupported(Operation op) const
+{
+    return op != Seek;
+}
+
+ssize_type RingBufferDataProvider::read(void *buffer, size_t bufSize)
+{
+    const DataSegment segment = {buffer, bufSize};
+    return readv(&segment, 1);
+}
+
+ssize_type RingBufferDataProvider::write(const void *buffer, size_t bufSize)
+{
+    const DataSegment segment = {const_cast<void *>(buffer), bufSize};
+    return writev(&segment, 1);
+}
+
+ssize_type RingBufferDataProvider::readv(const DataSegment *segments, size_t count)
+{
+    size_t wanted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        wanted += segments[i].length;
+    }
+    if (wanted == 0) {
+        return 0;
+    }
+    while (true) {
+        const size_t head = d->head;
+        const size_t available = d->tail - head;
+        if (available > 0) {
+            size_t done = 0;
+            for (size_t i = 0; i < count && done < available; ++i) {
+                const size_t n = std::min(segments[i].length, available - done);
+                const size_t offset = (head + done) & d->mask();
+                const size_t first = std::min(n, d->buffer.size() - offset);
+                std::memcpy(segments[i].base, d->buffer.data() + offset, first);
+                std::memcpy(static_cast<char *>(segments[i].base) + first, d->buffer.data(), n - first);
+                done += n;
+            }
+            // publish all segments at once
+            d->head = head + done;
+            d->wake(d->writerWaiting);
+            return done;
+        }
+        // check the tail again; the writer may have written before closing
+        if (d->readClosed || (d->writeClosed && d->tail == head)) {
+            return 0;
+        }
+        if (d->mode == NonBlocking) {
+            errno = EAGAIN;
+            return -1;
+        }
+        d->park(d->readerWaiting, [this, head]() {
+            return d->tail != head || d->writeClosed || d->readClosed;
+        });
+    }
+}
+
+ssize_type RingBufferDataProvider::writev(const DataSegment *segments, size_t count)
+{
+    size_t wanted = 0;
+    for (size_t i = 0; i < count; ++i) {
+        wanted += segments[i].length;
+    }
+    if (wanted == 0) {
+        return 0;
+    }
+    while (true) {
+        if (d->readClosed || d->writeClosed) {
+            errno = EPIPE;
+            return -1;
+        }
+        const size_t tail = d->tail;
+        const size_t space = d->buffer.size() - (tail - d->head);
+        if (space > 0) {
+            size_t done = 0;
+            for (size_t i = 0; i < count && done < space; ++i) {
+                const size_t n = std::min(segments[i].length, space - done);
+                const size_t offset = (tail + done) & d->mask();
+                const size_t first = std::min(n, d->buffer.size() - offset);
+                std::memcpy(d->buffer.data() + offset, segments[i].base, first);
+                std::memcpy(d->buffer.data(), static_cast<const char *>(segments[i].base) + first, n - first);
+                done += n;
+            }
+            // publish all segments at once
+            d->tail = tail + done;
+            d->wake(d->readerWaiting);
+            return done;
+        }
+        if (d->mode == NonBlocking) {
+            errno = EAGAIN;
+            return -1;
+        }
+        d->park(d->writerWaiting, [this]() {
+            return d->tail - d->head < d->buffer.size() || d->readClosed || d->writeClosed;
+        });
+    }
+}
+
+off_type RingBufferDataProvider::seek(off_type, int)
+{
+    errno = ESPIPE;
+    return -1;
+}
+
+void RingBufferDataProvider::release()
+{
+}
@@ -0,0 +1,113 @@
+/*
+  ringbufferdataprovider.h - a bounded single-producer/single-consumer buffer
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_RINGBUFFERDATAPROVIDER_H__
+#define __GPGMEPP_RINGBUFFERDATAPROVIDER_H__
+
+#include "interfaces/dataprovider.h"
+#include "data.h"
+
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * A bounded buffer for streaming data from one thread to another, e.g.
+ * from a socket to a Context which encrypts it.
+ *
+ * Exactly one thread may write to the buffer and exactly one thread may
+ * read from it. Reading and writing do not take a lock; a lock is only
+ * taken to park a thread in Blocking mode when the buffer is empty (for
+ * the reader) or full (for the writer).
+ *
+ * In Blocking mode read() waits for data and write() waits for free
+ * space. In NonBlocking mode they fail with EAGAIN instead.
+ *
+ * The writer calls closeWrite() when it is done; afterwards read() returns
+ * 0 once the buffer is empty. If the reader calls closeRead(), then
+ * write() fails with EPIPE. The buffer is not seekable.
+ *
+ * The provider is not owned by the Data objects using it; release() does
+ * nothing.
+ */
+class GPGMEPP_EXPORT RingBufferDataProvider : public DataProvider
+{
+public:
+    enum Mode {
+        Blocking,
+        NonBlocking,
+    };
+
+    /** @p capacity is rounded up to the next power of two. */
+    explicit RingBufferDataProvider(size_t capacity = 64 * 1024, Mode mode = Blocking);
+    ~RingBufferDataProvider() override;
+
+    size_t capacity() const;
+    Mode mode() const;
+
+    /** Returns the number of bytes which can be read without waiting. */
+    size_t size() const;
+
+    void closeWrite();
+    bool isWriteClosed() const;
+    void closeRead();
+    bool isReadClosed() const;
+
+    bool isSupported(Operation op) const override;
+#ifdef _WIN32
+    gpgme_ssize_t read(void *buffer, size_t bufSize) override;
+    gpgme_ssize_t write(const void *buffer, size_t bufSize) override;
+    gpgme_off_t seek(gpgme_off_t offset, int whence) override;
+#else
+    ssize_t read(void *buffer, size_t bufSize) override;
+    ssize_t write(const void *buffer, size_t bufSize) override;
+    off_t seek(off_t offset, int whence) override;
+#endif
+    void release() override;
+
+    /**
+     * Vectored variants of read() and write(). All segments are copied
+     * with a single update of the buffer indices and at most one wakeup
+     * of the other side. Like read() and write() they may transfer less
+     * than the total length of the segments.
+     */
+#ifdef _WIN32
+    gpgme_ssize_t readv(const DataSegment *segments, size_t count);
+    gpgme_ssize_t writev(const DataSegment *segments, size_t count);
+#else
+    ssize_t readv(const DataSegment *segments, size_t count);
+    ssize_t writev(const DataSegment *segments, size_t count);
+#endif
+
+private:
+    RingBufferDataProvider(const RingBufferDataProvider &) = delete;
+    RingBufferDataProvider &operator=(const RingBufferDataProvider &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_RINGBUFFERDATAPROVIDER_H__
@@ -0,0 +1,273 @@
+/*
+  securearena.cpp - locked, recycled memory for secrets
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <securearena.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include <string.h>
+#ifndef _WIN32
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+using namespace GpgME;
+
+namespace
+{
+// size classes from 32 bytes to 16 KiB
+constexpr unsigned int MinClassShift = 5;
+constexpr unsigned int MaxClassShift = 14;
+constexpr unsigned int ClassCount = MaxClassShift - MinClassShift + 1;
+// small blocks are carved out of chunks of this size
+constexpr size_t ChunkSize = 64 * 1024;
+
+size_t pageSize()
+{
+#ifdef _WIN32
+    return 4096;
+#else
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#endif
+}
+
+unsigned int sizeClass(size_t size)
+{
+    unsigned int shift = MinClassShift;
+    while ((size_t(1) << shift) < size) {
+        ++shift;
+    }
+    return shift - MinClassShift;
+}
+
+size_t classSize(unsigned int sizeClass)
+{
+    return size_t(1) << (sizeClass + MinClassShift);
+}
+
+// maps length bytes; locked is set if the pages could be locked
+void *mapPages(size_t length, bool &locked)
+{
+    locked = false;
+#ifdef _WIN32
+    return std::calloc(1, length);
+#else
+    void *pages = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pages == MAP_FAILED) {
+        return nullptr;
+    }
+    locked = mlock(pages, length) == 0;
+#ifdef MADV_DONTDUMP
+    madvise(pages, length, MADV_DONTDUMP);
+#endif
+    return pages;
+#endif
+}
+
+void unmapPages(void *pages, size_t length, bool locked)
+{
+#ifdef _WIN32
+    (void)length;
+    (void)locked;
+    std::free(pages);
+#else
+    if (locked) {
+        munlock(pages, length);
+    }
+    munmap(pages, length);
+#endif
+}
+}
+
+class SecureArena::Private
+{
+public:
+    struct Region {
+        size_t length;
+        // the size class of the blocks of a chunk, or -1 for a large block
+        int sizeClass;
+        bool locked;
+    };
+
+    // returns the region containing p, or regions.end()
+    std::map<std::uintptr_t, Region>::const_iterator findRegion(const void *p) const
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(p);
+        auto it = regions.upper_bound(address);
+        if (it == regions.begin()) {
+            return regions.end();
+        }
+        --it;
+        return address < it->first + it->second.length ? it : regions.end();
+    }
+
+    bool addChunk(unsigned int c)
+    {
+        bool locked;
+        void *const chunk = mapPages(ChunkSize, locked);
+        if (!chunk) {
+            return false;
+        }
+        regions[reinterpret_cast<std::uintptr_t>(chunk)] = {ChunkSize, static_cast<int>(c), locked};
+        stats.bytesReserved += ChunkSize;
+        stats.bytesLocked += locked ? ChunkSize : 0;
+        const size_t size = classSize(c);
+        for (size_t offset = 0; offset + size <= ChunkSize; offset += size) {
+            freeLists[c].push_back(static_cast<char *>(chunk) + offset);
+        }
+        return true;
+    }
+
+    mutable std::mutex mutex;
+    std::map<std::uintptr_t, Region> regions;
+    std::vector<void *> freeLists[ClassCount];
+    Statistics stats;
+};
+
+SecureArena::SecureArena()
+    : d(new Private)
+{
+}
+
+SecureArena::~SecureArena() = default;
+
+SecureArena &SecureArena::instance()
+{
+    // never destroyed, so that blocks can still be deallocated during exit
+    static SecureArena *const arena = new SecureArena;
+    return *arena;
+}
+
+void *SecureArena::allocate(size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    if (size > classSize(ClassCount - 1)) {
+        const size_t length = (size + pageSize() - 1) / pageSize() * pageSize();
+        bool locked;
+        void *const block = mapPages(length, locked);
+        if (!block) {
+            return nullptr;
+        }
+        d->regions[reinterpret_cast<std::uintptr_t>(block)] = {length, -1, locked};
+        d->stats.bytesReserved += length;
+        d->stats.bytesLocked += locked ? length : 0;
+        d->stats.bytesInUse += length;
+        return block;
+    }
+    const unsigned int c = sizeClass(size);
+    if (d->freeLists[c].empty() && !d->addChunk(c)) {
+        return nullptr;
+    }
+    void *const block = d->freeLists[c].back();
+    d->freeLists[c].pop_back();
+    d->stats.bytesInUse += classSize(c);
+    return block;
+}
+
+void SecureArena::deallocate(void *block)
+{
+    if (!block) {
+        return;
+    }
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    const auto it = d->findRegion(block);
+    if (it == d->regions.end()) {
+        return;
+    }
+    const Private::Region region = it->second;
+    if (region.sizeClass < 0) {
+        wipe(block, region.length);
+        d->stats.bytesInUse -= region.length;
+        d->stats.bytesReserved -= region.length;
+        d->stats.bytesLocked -= region.locked ? region.length : 0;
+        d->regions.erase(it);
+        unmapPages(block, region.length, region.locked);
+        return;
+    }
+    const size_t size = classSize(region.sizeClass);
+    wipe(block, size);
+    d->stats.bytesInUse -= size;
+    d->freeLists[region.sizeClass].push_back(block);
+}
+
+char *SecureArena::strdup(const char *str)
+{
+    if (!str) {
+        return nullptr;
+    }
+    const size_t length = std::strlen(str);
+    char *const copy = static_cast<char *>(allocate(length + 1));
+    if (copy) {
+        std::memcpy(copy, str, length + 1);
+    }
+    return copy;
+}
+
+bool SecureArena::owns(const void *block) const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->findRegion(block) != d->regions.end();
+}
+
+size_t SecureArena::blockSize(const void *block) const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    const auto it = d->findRegion(block);
+    if (it == d->regions.end()) {
+        return 0;
+    }
+    return it->second.sizeClass < 0 ? it->second.length : classSize(it->second.sizeClass);
+}
+
+SecureArena::Statistics SecureArena::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
+
+void SecureArena::wipe(void *buffer, size_t size)
+{
+    if (!buffer || !size) {
+        return;
+    }
+#if (defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 25))) \
+    || defined(__OpenBSD__) || defined(__FreeBSD__)
+    explicit_bzero(buffer, size);
+#else
+    // the compiler cannot assume that the called function is memset
+    static void *(*const volatile wipeFunction)(void *, int, size_t) = std::memset;
+    wipeFunction(buffer, 0, size);
+#endif
+}
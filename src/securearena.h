@@ -0,0 +1,96 @@
+/*
+  securearena.h - locked, recycled memory for secrets
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_SECUREARENA_H__
+#define __GPGMEPP_SECUREARENA_H__
+
+#include "gpgmepp_export.h"
+
+#include <cstddef>
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * A process-wide allocator for secrets like passphrases and plain texts.
+ *
+ * The memory is taken from pages which are locked into RAM with mlock(),
+ * if the process is allowed to lock memory, so that it is never written
+ * to swap. Small blocks are recycled through free lists of power-of-two
+ * size classes; blocks larger than the largest class get pages of their
+ * own. Every block is wiped when it is deallocated.
+ *
+ * A PassphraseProvider may return a passphrase allocated with strdup() of
+ * the arena instead of with malloc(); the library then recycles the block
+ * after wiping it.
+ *
+ * All functions are thread-safe. On Windows the memory is not locked.
+ */
+class GPGMEPP_EXPORT SecureArena
+{
+public:
+    struct Statistics {
+        /** Bytes of the blocks handed out and not yet deallocated. */
+        size_t bytesInUse = 0;
+        /** Bytes of all pages mapped by the arena. */
+        size_t bytesReserved = 0;
+        /** Bytes of the pages which could be locked. */
+        size_t bytesLocked = 0;
+    };
+
+    static SecureArena &instance();
+
+    /** Returns a block of at least @p size bytes, or nullptr. */
+    void *allocate(size_t size);
+    /** Wipes and recycles a block returned by allocate(). */
+    void deallocate(void *block);
+
+    /** Returns a copy of @p str allocated from the arena. */
+    char *strdup(const char *str);
+
+    /** Returns true if @p block was allocated from the arena. */
+    bool owns(const void *block) const;
+
+    /** Returns the usable size of @p block. */
+    size_t blockSize(const void *block) const;
+
+    Statistics statistics() const;
+
+    /** Overwrites @p size bytes at @p buffer with zeros in a way which is
+     * not optimized away by the compiler. */
+    static void wipe(void *buffer, size_t size);
+
+private:
+    SecureArena();
+    ~SecureArena();
+    SecureArena(const SecureArena &) = delete;
+    SecureArena &operator=(const SecureArena &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_SECUREARENA_H__
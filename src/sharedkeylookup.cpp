@@ -0,0 +1,365 @@
+/*
+  sharedkeylookup.cpp - concurrent key lookups over a few contexts
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <sharedkeylookup.h>
+#include <context.h>
+#include <keylistresult.h>
+
+#include "util.h"
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+using namespace GpgME;
+
+namespace
+{
+
+enum Kind {
+    Fingerprint,
+    Mailbox,
+};
+
+struct Query {
+    Kind kind;
+    bool secret;
+    // the normalized fingerprint or the address
+    std::string pattern;
+    std::chrono::steady_clock::time_point queued;
+
+    bool done = false;
+    std::vector<Key> keys;
+    Error error;
+};
+
+std::string normalizedFingerprint(const std::string &pattern)
+{
+    std::string result = pattern;
+    if (result.size() > 2 && result[0] == '0' && (result[1] == 'x' || result[1] == 'X')) {
+        result.erase(0, 2);
+    }
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::toupper(c);
+    });
+    return result;
+}
+
+// the key of a query in the map of the pending queries
+std::string queryId(Kind kind, bool secret, const std::string &pattern)
+{
+    std::string id(1, kind == Fingerprint ? 'f' : 'm');
+    id += secret ? 's' : 'p';
+    id += pattern;
+    return id;
+}
+
+}
+
+class SharedKeyLookup::Private
+{
+public:
+    Private(Protocol proto, const Options &o)
+        : options(o),
+          pool(proto, o.configure),
+          stopping(false)
+    {
+        if (options.contexts == 0) {
+            options.contexts = 1;
+        }
+        if (options.maximumBatchSize == 0) {
+            options.maximumBatchSize = 1;
+        }
+        workers.reserve(options.contexts);
+        for (unsigned int i = 0; i < options.contexts; ++i) {
+            workers.emplace_back(&Private::work, this);
+        }
+    }
+
+    ~Private()
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        queuedCondition.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        // fail the lookups which were not run
+        const std::lock_guard<std::mutex> lock(mutex);
+        for (const std::shared_ptr<Query> &query : queue) {
+            query->error = Error::fromCode(GPG_ERR_CANCELED);
+            query->done = true;
+        }
+        doneCondition.notify_all();
+    }
+
+    // queues a query or joins a pending one; called with the mutex locked
+    std::shared_ptr<Query> submit(Kind kind, bool secret, const std::string &pattern)
+    {
+        ++stats.lookups;
+        const std::string id = queryId(kind, secret, pattern);
+        const auto it = pending.find(id);
+        if (it != pending.end()) {
+            ++stats.joined;
+            return it->second;
+        }
+        const std::shared_ptr<Query> query(new Query);
+        query->kind = kind;
+        query->secret = secret;
+        query->pattern = pattern;
+        query->queued = std::chrono::steady_clock::now();
+        if (stopping) {
+            query->error = Error::fromCode(GPG_ERR_CANCELED);
+            query->done = true;
+            return query;
+        }
+        pending.emplace(id, query);
+        queue.push_back(query);
+        queuedCondition.notify_one();
+        return query;
+    }
+
+    void wait(std::unique_lock<std::mutex> &lock, const std::shared_ptr<Query> &query)
+    {
+        doneCondition.wait(lock, [&query]() {
+            return query->done;
+        });
+    }
+
+    // takes the oldest query and the queued queries of the same kind;
+    // called with the mutex locked
+    std::vector<std::shared_ptr<Query>> takeBatch()
+    {
+        std::vector<std::shared_ptr<Query>> batch;
+        const Kind kind = queue.front()->kind;
+        const bool secret = queue.front()->secret;
+        for (auto it = queue.begin(); it != queue.end() && batch.size() < options.maximumBatchSize;) {
+            if ((*it)->kind == kind && (*it)->secret == secret) {
+                batch.push_back(*it);
+                it = queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return batch;
+    }
+
+    void work()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            queuedCondition.wait(lock, [this]() {
+                return stopping || !queue.empty();
+            });
+            if (stopping) {
+                return;
+            }
+            // give the lookups of other threads a chance to join the batch
+            const auto deadline = queue.front()->queued + options.batchWindow;
+            queuedCondition.wait_until(lock, deadline, [this]() {
+                return stopping || queue.empty() || queue.size() >= options.maximumBatchSize;
+            });
+            if (stopping) {
+                return;
+            }
+            if (queue.empty()) {
+                // taken by another worker
+                continue;
+            }
+            const std::vector<std::shared_ptr<Query>> batch = takeBatch();
+            ++stats.batches;
+            lock.unlock();
+            run(batch);
+            lock.lock();
+            for (const std::shared_ptr<Query> &query : batch) {
+                pending.erase(queryId(query->kind, query->secret, query->pattern));
+                query->done = true;
+            }
+            doneCondition.notify_all();
+        }
+    }
+
+    // runs the key listing for a batch without the mutex; the results are
+    // only read by the callers after done has been set
+    void run(const std::vector<std::shared_ptr<Query>> &batch)
+    {
+        Error err;
+        ContextPool::Lease lease = pool.acquire(&err);
+        if (!lease) {
+            for (const std::shared_ptr<Query> &query : batch) {
+                query->error = err ? err : Error::fromCode(GPG_ERR_GENERAL);
+            }
+            return;
+        }
+        if (batch.front()->kind == Fingerprint) {
+            runFingerprints(*lease, batch);
+        } else {
+            runMailboxes(*lease, batch);
+        }
+    }
+
+    void runFingerprints(Context &ctx, const std::vector<std::shared_ptr<Query>> &batch)
+    {
+        std::vector<std::string> fingerprints;
+        fingerprints.reserve(batch.size());
+        for (const std::shared_ptr<Query> &query : batch) {
+            fingerprints.push_back(query->pattern);
+        }
+        Error err;
+        const std::vector<Key> keys = ctx.keys(fingerprints, batch.front()->secret, err);
+        for (size_t i = 0; i < batch.size(); ++i) {
+            batch[i]->keys.assign(1, keys[i]);
+            batch[i]->error = err;
+        }
+    }
+
+    void runMailboxes(Context &ctx, const std::vector<std::shared_ptr<Query>> &batch)
+    {
+        std::unordered_map<std::string, Query *> queries;
+        std::vector<std::string> patterns;
+        patterns.reserve(batch.size());
+        for (const std::shared_ptr<Query> &query : batch) {
+            queries.emplace(query->pattern, query.get());
+            patterns.push_back("<" + query->pattern + ">");
+        }
+        const StringsToCStrings cpatterns{patterns};
+        Error err = ctx.startKeyListing(cpatterns.c_strs(), batch.front()->secret);
+        while (!err) {
+            Error e;
+            const Key key = ctx.nextKey(e);
+            if (e) {
+                if (e.code() != GPG_ERR_EOF) {
+                    err = e;
+                }
+                break;
+            }
+            for (const UserID &uid : key.userIDs()) {
+                const auto it = queries.find(uid.addrSpec());
+                if (it == queries.end()) {
+                    continue;
+                }
+                // a key with several user IDs with the address is added once
+                std::vector<Key> &keys = it->second->keys;
+                const char *const fpr = key.primaryFingerprint();
+                const char *const last = keys.empty() ? nullptr : keys.back().primaryFingerprint();
+                if (!fpr || !last || std::strcmp(fpr, last) != 0) {
+                    keys.push_back(key);
+                }
+            }
+        }
+        const KeyListResult res = ctx.endKeyListing();
+        if (!err && res.error() && res.error().code() != GPG_ERR_EOF) {
+            err = res.error();
+        }
+        for (const std::shared_ptr<Query> &query : batch) {
+            query->error = err;
+        }
+    }
+
+    Options options;
+    ContextPool pool;
+
+    mutable std::mutex mutex;
+    std::condition_variable queuedCondition;
+    std::condition_variable doneCondition;
+    // the lookups not yet taken by a worker, oldest first
+    std::deque<std::shared_ptr<Query>> queue;
+    // the queued and running lookups by queryId()
+    std::unordered_map<std::string, std::shared_ptr<Query>> pending;
+    bool stopping;
+    Statistics stats;
+    std::vector<std::thread> workers;
+};
+
+SharedKeyLookup::SharedKeyLookup(Protocol proto, const Options &options)
+    : d(new Private(proto, options))
+{
+}
+
+SharedKeyLookup::~SharedKeyLookup() = default;
+
+const SharedKeyLookup::Options &SharedKeyLookup::options() const
+{
+    return d->options;
+}
+
+Key SharedKeyLookup::key(const std::string &fingerprint, Error &err, bool secret)
+{
+    std::unique_lock<std::mutex> lock(d->mutex);
+    const std::shared_ptr<Query> query = d->submit(Fingerprint, secret, normalizedFingerprint(fingerprint));
+    d->wait(lock, query);
+    err = query->error;
+    return query->keys.empty() ? Key() : query->keys.front();
+}
+
+std::vector<Key> SharedKeyLookup::keys(const std::vector<std::string> &fingerprints, bool secret, Error &err)
+{
+    std::vector<std::shared_ptr<Query>> queries;
+    queries.reserve(fingerprints.size());
+    std::unique_lock<std::mutex> lock(d->mutex);
+    // submitted together, so that they end up in the same batch
+    for (const std::string &fingerprint : fingerprints) {
+        queries.push_back(d->submit(Fingerprint, secret, normalizedFingerprint(fingerprint)));
+    }
+    std::vector<Key> result;
+    result.reserve(queries.size());
+    err = Error();
+    for (const std::shared_ptr<Query> &query : queries) {
+        d->wait(lock, query);
+        result.push_back(query->keys.empty() ? Key() : query->keys.front());
+        if (!err) {
+            err = query->error;
+        }
+    }
+    return result;
+}
+
+std::vector<Key> SharedKeyLookup::keysForMailbox(const std::string &mbox, Error &err, bool secret)
+{
+    const std::string address = UserID::addrSpecFromString(mbox.c_str());
+    if (address.empty()) {
+        err = Error::fromCode(GPG_ERR_INV_USER_ID);
+        return std::vector<Key>();
+    }
+    std::unique_lock<std::mutex> lock(d->mutex);
+    const std::shared_ptr<Query> query = d->submit(Mailbox, secret, address);
+    d->wait(lock, query);
+    err = query->error;
+    return query->keys;
+}
+
+SharedKeyLookup::Statistics SharedKeyLookup::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
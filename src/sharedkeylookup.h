@@ -0,0 +1,109 @@
+/*
+  sharedkeylookup.h - concurrent key lookups over a few contexts
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_SHAREDKEYLOOKUP_H__
+#define __GPGMEPP_SHAREDKEYLOOKUP_H__
+
+#include "global.h"
+#include "contextpool.h"
+#include "error.h"
+#include "key.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Looks up keys for many threads with a few contexts.
+ *
+ * A Context runs one operation at a time and must not be shared by
+ * threads. Instead of giving every thread its own context (and engine
+ * process), the threads pass their lookups to a SharedKeyLookup, whose
+ * workers run them with the contexts of a ContextPool:
+ *
+ * - A lookup of a fingerprint (or mail address) which is already queued
+ *   or running is not run again; the caller waits for the running one.
+ * - The lookups arriving within the batch window are collected and run
+ *   with a single key listing for all their patterns (see
+ *   Context::keys()), up to the maximum batch size.
+ *
+ * The lookups only list the local keyring; nothing is imported. All
+ * functions are thread-safe and block until the result is available.
+ */
+class GPGMEPP_EXPORT SharedKeyLookup
+{
+public:
+    struct Options {
+        /** The number of workers, i.e. of concurrent key listings. */
+        unsigned int contexts = 2;
+        /** How long the first lookup of a batch waits for more lookups. */
+        std::chrono::microseconds batchWindow = std::chrono::milliseconds(2);
+        unsigned int maximumBatchSize = 100;
+        /** Called once for every new context, e.g. to set the home
+         * directory of the engine. */
+        ContextPool::Configurator configure;
+    };
+
+    struct Statistics {
+        unsigned long lookups = 0;
+        /** Lookups which waited for a pending lookup of the same pattern. */
+        unsigned long joined = 0;
+        /** The key listings run. */
+        unsigned long batches = 0;
+    };
+
+    SharedKeyLookup(Protocol proto, const Options &options);
+    ~SharedKeyLookup();
+
+    const Options &options() const;
+
+    /**
+     * Returns the key with the fingerprint or key ID @p fingerprint. Returns
+     * a null key if there is no such key; @p err is only set if the key
+     * listing failed.
+     */
+    Key key(const std::string &fingerprint, Error &err, bool secret = false);
+
+    /** Like Context::keys(): returns a key (or a null key) for each of
+     * @p fingerprints in the same order. */
+    std::vector<Key> keys(const std::vector<std::string> &fingerprints, bool secret, Error &err);
+
+    /** Returns the keys with a user ID with the mail address of @p mbox. */
+    std::vector<Key> keysForMailbox(const std::string &mbox, Error &err, bool secret = false);
+
+    Statistics statistics() const;
+
+private:
+    SharedKeyLookup(const SharedKeyLookup &) = delete;
+    SharedKeyLookup &operator=(const SharedKeyLookup &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_SHAREDKEYLOOKUP_H__
@@ -48,35 +48,35 @@ public:
         if (!r) {
             return;
         }
+        unsigned int numCreated = 0, numInvalid = 0;
         for (gpgme_new_signature_t is = r->signatures ; is ; is = is->next) {
-            gpgme_new_signature_t copy = new _gpgme_new_signature(*is);
-            if (is->fpr) {
-                copy->fpr = strdup(is->fpr);
-            }
+            ++numCreated;
+            arena.reserve<_gpgme_new_signature>();
+            arena.reserveString(is->fpr);
+        }
+        for (gpgme_invalid_key_t ik = r->invalid_signers ; ik ; ik = ik->next) {
+            ++numInvalid;
+            arena.reserve<_gpgme_invalid_key>();
+            arena.reserveString(ik->fpr);
+        }
+        created.reserve(numCreated);
+        invalid.reserve(numInvalid);
+        for (gpgme_new_signature_t is = r->signatures ; is ; is = is->next) {
+            gpgme_new_signature_t copy = arena.copy(*is);
+            copy->fpr = arena.copyString(is->fpr);
             copy->next = nullptr;
             created.push_back(copy);
         }
         for (gpgme_invalid_key_t ik = r->invalid_signers ; ik ; ik = ik->next) {
-            gpgme_invalid_key_t copy = new _gpgme_invalid_key(*ik);
-            if (ik->fpr) {
-                copy->fpr = strdup(ik->fpr);
-            }
+            gpgme_invalid_key_t copy = arena.copy(*ik);
+            copy->fpr = arena.copyString(ik->fpr);
             copy->next = nullptr;
             invalid.push_back(copy);
         }
     }
-    ~Private()
-    {
-        for (std::vector<gpgme_new_signature_t>::iterator it = created.begin() ; it != created.end() ; ++it) {
-            std::free((*it)->fpr);
-            delete *it; *it = nullptr;
-        }
-        for (std::vector<gpgme_invalid_key_t>::iterator it = invalid.begin() ; it != invalid.end() ; ++it) {
-            std::free((*it)->fpr);
-            delete *it; *it = nullptr;
-        }
-    }
 
+    // owns the copies of the signatures and invalid keys
+    ResultArena arena;
     std::vector<gpgme_new_signature_t> created;
     std::vector<gpgme_invalid_key_t> invalid;
 };
@@ -107,6 +107,16 @@ void GpgME::SigningResult::init(gpgme_ctx_t ctx)
 
 make_standard_stuff(SigningResult)
 
+GpgME::MemoryUsage GpgME::SigningResult::approximateMemoryUsage() const
+{
+    return resultMemoryUsage<SigningResult>(d, d ? d->arena.allocatedBytes() + heapBytes(d->created) + heapBytes(d->invalid) : 0);
+}
+
+unsigned int GpgME::SigningResult::numCreatedSignatures() const
+{
+    return d ? d->created.size() : 0 ;
+}
+
 GpgME::CreatedSignature GpgME::SigningResult::createdSignature(unsigned int idx) const
 {
     return CreatedSignature(d, idx);
@@ -125,6 +135,11 @@ std::vector<GpgME::CreatedSignature> GpgME::SigningResult::createdSignatures() c
     return result;
 }
 
+unsigned int GpgME::SigningResult::numInvalidSigningKeys() const
+{
+    return d ? d->invalid.size() : 0 ;
+}
+
 GpgME::InvalidSigningKey GpgME::SigningResult::invalidSigningKey(unsigned int idx) const
 {
     return InvalidSigningKey(d, idx);
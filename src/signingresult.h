@@ -51,6 +51,7 @@ public:
     explicit SigningResult(const Error &err);
 
     SigningResult(const SigningResult &other) = default;
+    SigningResult(SigningResult &&other) = default;
     const SigningResult &operator=(SigningResult other)
     {
         swap(other);
@@ -66,9 +67,14 @@ public:
 
     bool isNull() const;
 
+    /** Returns the approximate memory used by the result. */
+    MemoryUsage approximateMemoryUsage() const;
+
+    unsigned int numCreatedSignatures() const;
     CreatedSignature createdSignature(unsigned int index) const;
     std::vector<CreatedSignature> createdSignatures() const;
 
+    unsigned int numInvalidSigningKeys() const;
     InvalidSigningKey invalidSigningKey(unsigned int index) const;
     std::vector<InvalidSigningKey> invalidSigningKeys() const;
 
@@ -88,6 +94,7 @@ public:
     InvalidSigningKey();
 
     InvalidSigningKey(const InvalidSigningKey &other) = default;
+    InvalidSigningKey(InvalidSigningKey &&other) = default;
     const InvalidSigningKey &operator=(InvalidSigningKey other)
     {
         swap(other);
@@ -122,6 +129,7 @@ public:
     CreatedSignature();
 
     CreatedSignature(const CreatedSignature &other) = default;
+    CreatedSignature(CreatedSignature &&other) = default;
     const CreatedSignature &operator=(CreatedSignature other)
     {
         swap(other);
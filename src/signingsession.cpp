@@ -0,0 +1,180 @@
+/*
+  signingsession.cpp - signs many messages with the same configuration
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <signingsession.h>
+#include <context.h>
+#include <signingresult.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace GpgME;
+
+class SigningSession::Private
+{
+public:
+    Private(Protocol proto, const Options &o)
+        : options(o),
+          pool(proto, [this](Context &ctx) {
+              configure(ctx);
+          })
+    {
+    }
+
+    void configure(Context &ctx)
+    {
+        ctx.setArmor(options.armor);
+        ctx.setTextMode(options.textMode);
+        Error err;
+        for (const Key &key : options.signers) {
+            if (!err) {
+                err = ctx.addSigningKey(key);
+            }
+        }
+        for (const SignatureNotation &notation : options.notations) {
+            if (!err) {
+                err = ctx.addSignatureNotation(notation.name.c_str(), notation.value.c_str(), notation.flags);
+            }
+        }
+        if (!err && !options.sender.empty()) {
+            err = ctx.setSender(options.sender.c_str());
+        }
+        if (options.configure) {
+            options.configure(ctx);
+        }
+        if (err) {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (!configError) {
+                configError = err;
+            }
+        }
+    }
+
+    Error configurationError() const
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return configError;
+    }
+
+    SigningResult sign(const Data &plainText, Data &signature, SignatureMode mode)
+    {
+        Error err;
+        ContextPool::Lease lease = pool.acquire(&err);
+        if (!err) {
+            err = configurationError();
+        }
+        const SigningResult result = err ? SigningResult(err) : lease->sign(plainText, signature, mode);
+        const std::lock_guard<std::mutex> lock(mutex);
+        ++stats.signatures;
+        if (result.error()) {
+            ++stats.failures;
+        }
+        return result;
+    }
+
+    const Options options;
+    // declared after options, which are used by the configurator
+    ContextPool pool;
+
+    mutable std::mutex mutex;
+    Error configError;
+    Statistics stats;
+};
+
+SigningSession::SigningSession(Protocol proto, const Options &options)
+    : d(new Private(proto, options))
+{
+}
+
+SigningSession::~SigningSession() = default;
+
+const SigningSession::Options &SigningSession::options() const
+{
+    return d->options;
+}
+
+Error SigningSession::prepare(unsigned int contexts)
+{
+    std::vector<ContextPool::Lease> leases;
+    Error result;
+    for (unsigned int i = 0; i < std::max(contexts, 1u); ++i) {
+        Error err;
+        leases.push_back(d->pool.acquire(&err));
+        if (!err) {
+            err = d->configurationError();
+        }
+        if (!err) {
+            const Data plainText;
+            Data signature;
+            err = leases.back()->sign(plainText, signature, Detached).error();
+        }
+        if (err && !result) {
+            result = err;
+        }
+    }
+    // the leases return the contexts to the pool
+    return result;
+}
+
+SigningResult SigningSession::sign(const Data &plainText, Data &signature, SignatureMode mode)
+{
+    return d->sign(plainText, signature, mode);
+}
+
+std::vector<SigningResult> SigningSession::sign(const std::vector<Data> &plainTexts, std::vector<Data> &signatures,
+                                                SignatureMode mode, unsigned int concurrency)
+{
+    std::vector<SigningResult> results(plainTexts.size());
+    if (signatures.size() != plainTexts.size()) {
+        std::fill(results.begin(), results.end(), SigningResult(Error::fromCode(GPG_ERR_INV_VALUE)));
+        return results;
+    }
+    std::atomic<size_t> next(0);
+    const auto work = [this, &plainTexts, &signatures, &results, &next, mode]() {
+        for (size_t i = next++; i < plainTexts.size(); i = next++) {
+            // every worker writes to a different element
+            results[i] = d->sign(plainTexts[i], signatures[i], mode);
+        }
+    };
+    const size_t count = std::min<size_t>(std::max(concurrency, 1u), plainTexts.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < count; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+SigningSession::Statistics SigningSession::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
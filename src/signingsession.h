@@ -0,0 +1,120 @@
+/*
+  signingsession.h - signs many messages with the same configuration
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_SIGNINGSESSION_H__
+#define __GPGMEPP_SIGNINGSESSION_H__
+
+#include "global.h"
+#include "contextpool.h"
+#include "data.h"
+#include "key.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class SigningResult;
+
+/**
+ * Signs many messages with the same signing keys, notations and sender.
+ *
+ * The session keeps a ContextPool whose contexts are configured once with
+ * the options of the session, so that the signing keys are not looked up
+ * and added again for every message. sign() may be called by several
+ * threads at the same time; every call uses an own context of the pool.
+ *
+ * prepare() signs an empty message with every prepared context ahead of
+ * the real messages. This makes the agent unlock the signing keys (and
+ * thus ask for the passphrase, if needed) before the first message has
+ * to be signed, so that the latency of the first messages does not
+ * include the unlocking.
+ *
+ * gpgme starts a new engine process for every signature; neither a
+ * persistent gpg server nor signing precomputed digests is supported by
+ * the engines for OpenPGP signatures.
+ */
+class GPGMEPP_EXPORT SigningSession
+{
+public:
+    struct SignatureNotation {
+        std::string name;
+        std::string value;
+        unsigned int flags = 0;
+    };
+
+    struct Options {
+        std::vector<Key> signers;
+        std::vector<SignatureNotation> notations;
+        /** See Context::setSender(). */
+        std::string sender;
+        bool armor = false;
+        bool textMode = false;
+        /** Called once for every new context after the options have been
+         * applied, e.g. to set the pinentry mode. */
+        ContextPool::Configurator configure;
+    };
+
+    struct Statistics {
+        unsigned long signatures = 0;
+        unsigned long failures = 0;
+    };
+
+    SigningSession(Protocol proto, const Options &options);
+    ~SigningSession();
+
+    const Options &options() const;
+
+    /**
+     * Creates up to @p contexts configured contexts and signs an empty
+     * message with each of them. Returns the first error, e.g. if one of
+     * the signers cannot be used.
+     */
+    Error prepare(unsigned int contexts = 1);
+
+    /** Signs @p plainText into @p signature. Thread-safe. */
+    SigningResult sign(const Data &plainText, Data &signature, SignatureMode mode);
+
+    /**
+     * Signs every plain text into the signature with the same index with up
+     * to @p concurrency engine processes at the same time and returns the
+     * results in the same order.
+     */
+    std::vector<SigningResult> sign(const std::vector<Data> &plainTexts, std::vector<Data> &signatures,
+                                    SignatureMode mode, unsigned int concurrency = 4);
+
+    Statistics statistics() const;
+
+private:
+    SigningSession(const SigningSession &) = delete;
+    SigningSession &operator=(const SigningSession &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_SIGNINGSESSION_H__
@@ -0,0 +1,249 @@
+/*
+  statusline.cpp - a pre-parsed status line
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <statusline.h>
+
+#include <gpgme.h>
+
+#include <algorithm>
+#include <array>
+
+using namespace GpgME;
+
+namespace
+{
+
+struct StatusKeyword {
+    unsigned int code;
+    const char *keyword;
+};
+
+#define STATUS_KEYWORD(name) { GPGME_STATUS_ ## name, #name }
+
+static const StatusKeyword statusKeywords[] = {
+    STATUS_KEYWORD(EOF),
+    STATUS_KEYWORD(ENTER),
+    STATUS_KEYWORD(LEAVE),
+    STATUS_KEYWORD(ABORT),
+    STATUS_KEYWORD(GOODSIG),
+    STATUS_KEYWORD(BADSIG),
+    STATUS_KEYWORD(ERRSIG),
+    STATUS_KEYWORD(BADARMOR),
+    STATUS_KEYWORD(RSA_OR_IDEA),
+    STATUS_KEYWORD(KEYEXPIRED),
+    STATUS_KEYWORD(KEYREVOKED),
+    STATUS_KEYWORD(TRUST_UNDEFINED),
+    STATUS_KEYWORD(TRUST_NEVER),
+    STATUS_KEYWORD(TRUST_MARGINAL),
+    STATUS_KEYWORD(TRUST_FULLY),
+    STATUS_KEYWORD(TRUST_ULTIMATE),
+    STATUS_KEYWORD(SHM_INFO),
+    STATUS_KEYWORD(SHM_GET),
+    STATUS_KEYWORD(SHM_GET_BOOL),
+    STATUS_KEYWORD(SHM_GET_HIDDEN),
+    STATUS_KEYWORD(NEED_PASSPHRASE),
+    STATUS_KEYWORD(VALIDSIG),
+    STATUS_KEYWORD(SIG_ID),
+    STATUS_KEYWORD(ENC_TO),
+    STATUS_KEYWORD(NODATA),
+    STATUS_KEYWORD(BAD_PASSPHRASE),
+    STATUS_KEYWORD(NO_PUBKEY),
+    STATUS_KEYWORD(NO_SECKEY),
+    STATUS_KEYWORD(NEED_PASSPHRASE_SYM),
+    STATUS_KEYWORD(DECRYPTION_FAILED),
+    STATUS_KEYWORD(DECRYPTION_OKAY),
+    STATUS_KEYWORD(MISSING_PASSPHRASE),
+    STATUS_KEYWORD(GOOD_PASSPHRASE),
+    STATUS_KEYWORD(GOODMDC),
+    STATUS_KEYWORD(BADMDC),
+    STATUS_KEYWORD(ERRMDC),
+    STATUS_KEYWORD(IMPORTED),
+    STATUS_KEYWORD(IMPORT_OK),
+    STATUS_KEYWORD(IMPORT_PROBLEM),
+    STATUS_KEYWORD(IMPORT_RES),
+    STATUS_KEYWORD(FILE_START),
+    STATUS_KEYWORD(FILE_DONE),
+    STATUS_KEYWORD(FILE_ERROR),
+    STATUS_KEYWORD(BEGIN_DECRYPTION),
+    STATUS_KEYWORD(END_DECRYPTION),
+    STATUS_KEYWORD(BEGIN_ENCRYPTION),
+    STATUS_KEYWORD(END_ENCRYPTION),
+    STATUS_KEYWORD(DELETE_PROBLEM),
+    STATUS_KEYWORD(GET_BOOL),
+    STATUS_KEYWORD(GET_LINE),
+    STATUS_KEYWORD(GET_HIDDEN),
+    STATUS_KEYWORD(GOT_IT),
+    STATUS_KEYWORD(PROGRESS),
+    STATUS_KEYWORD(SIG_CREATED),
+    STATUS_KEYWORD(SESSION_KEY),
+    STATUS_KEYWORD(NOTATION_NAME),
+    STATUS_KEYWORD(NOTATION_DATA),
+    STATUS_KEYWORD(POLICY_URL),
+    STATUS_KEYWORD(BEGIN_STREAM),
+    STATUS_KEYWORD(END_STREAM),
+    STATUS_KEYWORD(KEY_CREATED),
+    STATUS_KEYWORD(USERID_HINT),
+    STATUS_KEYWORD(UNEXPECTED),
+    STATUS_KEYWORD(INV_RECP),
+    STATUS_KEYWORD(NO_RECP),
+    STATUS_KEYWORD(ALREADY_SIGNED),
+    STATUS_KEYWORD(SIGEXPIRED),
+    STATUS_KEYWORD(EXPSIG),
+    STATUS_KEYWORD(EXPKEYSIG),
+    STATUS_KEYWORD(TRUNCATED),
+    STATUS_KEYWORD(ERROR),
+    STATUS_KEYWORD(NEWSIG),
+    STATUS_KEYWORD(REVKEYSIG),
+    STATUS_KEYWORD(SIG_SUBPACKET),
+    STATUS_KEYWORD(NEED_PASSPHRASE_PIN),
+    STATUS_KEYWORD(SC_OP_FAILURE),
+    STATUS_KEYWORD(SC_OP_SUCCESS),
+    STATUS_KEYWORD(CARDCTRL),
+    STATUS_KEYWORD(BACKUP_KEY_CREATED),
+    STATUS_KEYWORD(PKA_TRUST_BAD),
+    STATUS_KEYWORD(PKA_TRUST_GOOD),
+    STATUS_KEYWORD(PLAINTEXT),
+    STATUS_KEYWORD(INV_SGNR),
+    STATUS_KEYWORD(NO_SGNR),
+    STATUS_KEYWORD(SUCCESS),
+    STATUS_KEYWORD(DECRYPTION_INFO),
+    STATUS_KEYWORD(PLAINTEXT_LENGTH),
+    STATUS_KEYWORD(MOUNTPOINT),
+    STATUS_KEYWORD(PINENTRY_LAUNCHED),
+    STATUS_KEYWORD(ATTRIBUTE),
+    STATUS_KEYWORD(BEGIN_SIGNING),
+    STATUS_KEYWORD(KEY_NOT_CREATED),
+    STATUS_KEYWORD(INQUIRE_MAXLEN),
+    STATUS_KEYWORD(FAILURE),
+    STATUS_KEYWORD(KEY_CONSIDERED),
+    STATUS_KEYWORD(TOFU_USER),
+    STATUS_KEYWORD(TOFU_STATS),
+    STATUS_KEYWORD(TOFU_STATS_LONG),
+    STATUS_KEYWORD(NOTATION_FLAGS),
+    STATUS_KEYWORD(DECRYPTION_COMPLIANCE_MODE),
+    STATUS_KEYWORD(VERIFICATION_COMPLIANCE_MODE),
+    STATUS_KEYWORD(CANCELED_BY_USER),};
+
+#undef STATUS_KEYWORD
+
+static constexpr unsigned int numStatusKeywords = sizeof statusKeywords / sizeof *statusKeywords;
+
+// the keywords indexed by code and the codes sorted by keyword
+struct StatusKeywordIndex {
+    StatusKeywordIndex()
+    {
+        byCode.fill(nullptr);
+        for (unsigned int i = 0; i < numStatusKeywords; ++i) {
+            if (statusKeywords[i].code <= StatusCodeSet::MaxCode) {
+                byCode[statusKeywords[i].code] = statusKeywords[i].keyword;
+            }
+            byKeyword[i] = statusKeywords[i];
+        }
+        std::sort(byKeyword.begin(), byKeyword.end(), [](const StatusKeyword &lhs, const StatusKeyword &rhs) {
+            return std::string_view(lhs.keyword) < std::string_view(rhs.keyword);
+        });
+    }
+
+    std::array<const char *, StatusCodeSet::MaxCode + 1> byCode;
+    std::array<StatusKeyword, numStatusKeywords> byKeyword;
+};
+
+static const StatusKeywordIndex &statusKeywordIndex()
+{
+    static const StatusKeywordIndex index;
+    return index;
+}
+
+}
+
+StatusLine::StatusLine(std::string_view keyword, std::string_view args)
+    : mCode(codeForKeyword(keyword)),
+      mKeyword(keyword),
+      mArgs(args)
+{
+}
+
+StatusLine::StatusLine(unsigned int code, std::string_view keyword, std::string_view args)
+    : mCode(code),
+      mKeyword(keyword),
+      mArgs(args)
+{
+}
+
+std::vector<std::string_view> StatusLine::fields() const
+{
+    std::vector<std::string_view> result;
+    std::string_view rest = mArgs;
+    while (true) {
+        const auto start = rest.find_first_not_of(' ');
+        if (start == std::string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(start);
+        const auto end = rest.find(' ');
+        result.push_back(rest.substr(0, end));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        rest.remove_prefix(end);
+    }
+    return result;
+}
+
+std::string_view StatusLine::field(unsigned int index) const
+{
+    std::string_view rest = mArgs;
+    while (true) {
+        const auto start = rest.find_first_not_of(' ');
+        if (start == std::string_view::npos) {
+            return std::string_view();
+        }
+        rest.remove_prefix(start);
+        const auto end = rest.find(' ');
+        if (index == 0) {
+            return rest.substr(0, end);
+        }
+        if (end == std::string_view::npos) {
+            return std::string_view();
+        }
+        rest.remove_prefix(end);
+        --index;
+    }
+}
+
+unsigned int StatusLine::codeForKeyword(std::string_view keyword)
+{
+    const auto &index = statusKeywordIndex().byKeyword;
+    const auto it = std::lower_bound(index.begin(), index.end(), keyword, [](const StatusKeyword &entry, std::string_view k) {
+        return std::string_view(entry.keyword) < k;
+    });
+    return it != index.end() && keyword == it->keyword ? it->code : UnknownCode;
+}
+
+const char *StatusLine::keywordForCode(unsigned int code)
+{
+    return code <= StatusCodeSet::MaxCode ? statusKeywordIndex().byCode[code] : nullptr;
+}
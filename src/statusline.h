@@ -0,0 +1,141 @@
+/*
+  statusline.h - a pre-parsed status line
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_STATUSLINE_H__
+#define __GPGMEPP_STATUSLINE_H__
+
+#include "global.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * A set of status codes (the values of gpgme_status_code_t), which can
+ * be built at compile time.
+ */
+class GPGMEPP_EXPORT StatusCodeSet
+{
+public:
+    /** The largest status code which can be stored in the set. */
+    static constexpr unsigned int MaxCode = 127;
+
+    constexpr StatusCodeSet() = default;
+    constexpr StatusCodeSet(std::initializer_list<unsigned int> codes)
+    {
+        for (unsigned int code : codes) {
+            add(code);
+        }
+    }
+
+    /** Returns a set with all codes, including the unknown ones. */
+    static constexpr StatusCodeSet all()
+    {
+        StatusCodeSet result;
+        result.mBits[0] = result.mBits[1] = ~std::uint64_t(0);
+        result.mUnknown = true;
+        return result;
+    }
+
+    /** Adds @p code. Codes greater than MaxCode are counted as unknown. */
+    constexpr StatusCodeSet &add(unsigned int code)
+    {
+        if (code > MaxCode) {
+            mUnknown = true;
+        } else {
+            mBits[code / 64] |= std::uint64_t(1) << (code % 64);
+        }
+        return *this;
+    }
+
+    constexpr bool contains(unsigned int code) const
+    {
+        return code > MaxCode ? mUnknown : (mBits[code / 64] >> (code % 64)) & 1;
+    }
+
+    constexpr bool isEmpty() const
+    {
+        return !mBits[0] && !mBits[1] && !mUnknown;
+    }
+
+private:
+    std::uint64_t mBits[2] = {0, 0};
+    bool mUnknown = false;
+};
+
+/**
+ * A status line of the engine with its keyword already mapped to the
+ * status code.
+ *
+ * The line does not own its strings; it is only valid while the status
+ * callback it was passed to runs. The arguments are split into fields
+ * only on request.
+ */
+class GPGMEPP_EXPORT StatusLine
+{
+public:
+    /** The code of keywords which are not known to this library. */
+    static constexpr unsigned int UnknownCode = ~0u;
+
+    constexpr StatusLine() = default;
+    StatusLine(std::string_view keyword, std::string_view args);
+    StatusLine(unsigned int code, std::string_view keyword, std::string_view args);
+
+    /** Returns the status code (a gpgme_status_code_t) or UnknownCode. */
+    unsigned int code() const
+    {
+        return mCode;
+    }
+    std::string_view keyword() const
+    {
+        return mKeyword;
+    }
+    std::string_view args() const
+    {
+        return mArgs;
+    }
+
+    /** Returns the space-separated fields of the arguments. */
+    std::vector<std::string_view> fields() const;
+    /** Returns the field number @p index (counting from 0) of the
+     * arguments, or an empty string if there are less fields. */
+    std::string_view field(unsigned int index) const;
+
+    /** Returns the status code of @p keyword or UnknownCode. */
+    static unsigned int codeForKeyword(std::string_view keyword);
+    /** Returns the keyword of the status code @p code or null. */
+    static const char *keywordForCode(unsigned int code);
+
+private:
+    unsigned int mCode = UnknownCode;
+    std::string_view mKeyword;
+    std::string_view mArgs;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_STATUSLINE_H__
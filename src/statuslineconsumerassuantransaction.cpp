@@ -0,0 +1,70 @@
+/*
+  statuslineconsumerassuantransaction.cpp - Assuan transaction that forwards pre-parsed status lines
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "statuslineconsumerassuantransaction.h"
+#include "data.h"
+#include "error.h"
+#include "statusline.h"
+#include "interfaces/statuslineconsumer.h"
+
+using namespace GpgME;
+
+StatusLineConsumerAssuanTransaction::StatusLineConsumerAssuanTransaction(StatusLineConsumer *statusConsumer)
+    : AssuanTransaction()
+    , m_consumer(statusConsumer)
+{
+}
+
+StatusLineConsumerAssuanTransaction::~StatusLineConsumerAssuanTransaction()
+{
+}
+
+Error StatusLineConsumerAssuanTransaction::data(const char *data, size_t datalen)
+{
+    (void) data;
+    (void) datalen;
+    return Error();
+}
+
+Data StatusLineConsumerAssuanTransaction::inquire(const char *name, const char *args, Error &err)
+{
+    (void)name;
+    (void)args;
+    (void)err;
+    return Data::null;
+}
+
+Error StatusLineConsumerAssuanTransaction::status(const char *status, const char *args)
+{
+    if (!m_consumer || !status) {
+        return Error();
+    }
+    const unsigned int code = StatusLine::codeForKeyword(status);
+    if (m_consumer->wantsStatus(code)) {
+        m_consumer->status(StatusLine(code, status, args ? args : ""));
+    }
+    return Error();
+}
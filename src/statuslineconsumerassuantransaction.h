@@ -0,0 +1,55 @@
+/*
+  statuslineconsumerassuantransaction.h - Assuan transaction that forwards pre-parsed status lines
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifndef __GPGMEPP_STATUSLINECONSUMERASSUANTRANSACTION_H__
+#define __GPGMEPP_STATUSLINECONSUMERASSUANTRANSACTION_H__
+
+#include "interfaces/assuantransaction.h"
+
+namespace GpgME
+{
+
+class StatusLineConsumer;
+
+/**
+ * Like StatusConsumerAssuanTransaction, but forwards the status lines as
+ * StatusLine to a StatusLineConsumer. Lines with codes the consumer is not
+ * subscribed to are dropped without calling the consumer.
+ */
+class GPGMEPP_EXPORT StatusLineConsumerAssuanTransaction: public AssuanTransaction
+{
+public:
+    explicit StatusLineConsumerAssuanTransaction(StatusLineConsumer *statusConsumer);
+    ~StatusLineConsumerAssuanTransaction();
+
+private:
+    Error data(const char *data, size_t datalen) override;
+    Data inquire(const char *name, const char *args, Error &err) override;
+    Error status(const char *status, const char *args) override;
+
+private:
+    StatusLineConsumer *m_consumer;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_STATUSLINECONSUMERASSUANTRANSACTION_H__
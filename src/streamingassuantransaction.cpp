@@ -0,0 +1,141 @@
+/*
+  streamingassuantransaction.cpp - an Assuan transaction writing into a sink
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <streamingassuantransaction.h>
+#include <data.h>
+#include <error.h>
+
+#include <map>
+
+using namespace GpgME;
+
+class StreamingAssuanTransaction::Private
+{
+public:
+    explicit Private(const Sink &s)
+        : sink(s),
+          bytes(0)
+    {
+    }
+
+    static Error writeAll(Data data, const char *buffer, size_t length)
+    {
+        while (length) {
+            const auto written = data.write(buffer, length);
+            if (written < 0) {
+                return Error::fromSystemError();
+            }
+            if (written == 0) {
+                return Error::fromCode(GPG_ERR_EIO);
+            }
+            buffer += written;
+            length -= written;
+        }
+        return Error();
+    }
+
+    const Sink sink;
+    unsigned long long bytes;
+    // std::less<> allows looking up a keyword without creating a string
+    std::map<std::string, std::vector<std::string>, std::less<>> status;
+};
+
+StreamingAssuanTransaction::StreamingAssuanTransaction(const Data &sink)
+    : AssuanTransaction(),
+      d(new Private([sink](const char *data, size_t length) {
+                        return Private::writeAll(sink, data, length);
+                    }))
+{
+}
+
+StreamingAssuanTransaction::StreamingAssuanTransaction(const Sink &sink)
+    : AssuanTransaction(),
+      d(new Private(sink))
+{
+}
+
+StreamingAssuanTransaction::~StreamingAssuanTransaction() = default;
+
+Error StreamingAssuanTransaction::data(const char *data, size_t len)
+{
+    d->bytes += len;
+    return d->sink ? d->sink(data, len) : Error();
+}
+
+Data StreamingAssuanTransaction::inquire(const char *name, const char *args, Error &err)
+{
+    (void)name; (void)args; (void)err;
+    return Data::null;
+}
+
+Error StreamingAssuanTransaction::status(const char *status, const char *args)
+{
+    if (!status) {
+        return Error();
+    }
+    auto it = d->status.find(status);
+    if (it == d->status.end()) {
+        it = d->status.emplace(status, std::vector<std::string>()).first;
+    }
+    it->second.emplace_back(args ? args : "");
+    return Error();
+}
+
+const std::vector<std::string> &StreamingAssuanTransaction::statusLine(const char *tag) const
+{
+    static const std::vector<std::string> none;
+    if (!tag) {
+        return none;
+    }
+    const auto it = d->status.find(tag);
+    return it == d->status.end() ? none : it->second;
+}
+
+std::string StreamingAssuanTransaction::firstStatusLine(const char *tag) const
+{
+    const std::vector<std::string> &lines = statusLine(tag);
+    return lines.empty() ? std::string() : lines.front();
+}
+
+bool StreamingAssuanTransaction::hasStatusLine(const char *tag) const
+{
+    return !statusLine(tag).empty();
+}
+
+std::vector<std::string> StreamingAssuanTransaction::statusKeywords() const
+{
+    std::vector<std::string> result;
+    result.reserve(d->status.size());
+    for (const auto &entry : d->status) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
+
+unsigned long long StreamingAssuanTransaction::bytesReceived() const
+{
+    return d->bytes;
+}
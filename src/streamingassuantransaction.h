@@ -0,0 +1,85 @@
+/*
+  streamingassuantransaction.h - an Assuan transaction writing into a sink
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_STREAMINGASSUANTRANSACTION_H__
+#define __GPGMEPP_STREAMINGASSUANTRANSACTION_H__
+
+#include "global.h"
+#include "interfaces/assuantransaction.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * An Assuan transaction for large responses.
+ *
+ * Unlike DefaultAssuanTransaction, the D-lines are not collected in a
+ * string but passed on to a Data object or a sink function as they
+ * arrive. Status lines are indexed by keyword as they arrive, so looking
+ * them up does not scan all status lines.
+ */
+class GPGMEPP_EXPORT StreamingAssuanTransaction : public AssuanTransaction
+{
+public:
+    /** Called with every chunk of the response. Returning an error aborts
+     * the transaction. */
+    using Sink = std::function<Error(const char *data, size_t length)>;
+
+    /** Writes the response into @p sink. */
+    explicit StreamingAssuanTransaction(const Data &sink);
+    /** Passes the response to @p sink. If @p sink is empty, then the
+     * response is discarded. */
+    explicit StreamingAssuanTransaction(const Sink &sink = Sink());
+    ~StreamingAssuanTransaction();
+
+    /** Returns the arguments of all status lines with keyword @p tag in
+     * the order they were received. */
+    const std::vector<std::string> &statusLine(const char *tag) const;
+    std::string firstStatusLine(const char *tag) const;
+    bool hasStatusLine(const char *tag) const;
+    /** Returns the keywords of all received status lines. */
+    std::vector<std::string> statusKeywords() const;
+
+    /** Returns the number of bytes of the response. */
+    unsigned long long bytesReceived() const;
+
+private:
+    Error data(const char *data, size_t datalen) override;
+    Data inquire(const char *name, const char *args, Error &err) override;
+    Error status(const char *status, const char *args) override;
+
+    StreamingAssuanTransaction(const StreamingAssuanTransaction &) = delete;
+    StreamingAssuanTransaction &operator=(const StreamingAssuanTransaction &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_STREAMINGASSUANTRANSACTION_H__
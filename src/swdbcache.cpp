@@ -0,0 +1,153 @@
+/*
+  swdbcache.cpp - caches the answers of the software version database
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <swdbcache.h>
+#include <error.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace GpgME;
+
+class SwdbCache::Private
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::vector<SwdbResult> results;
+        Clock::time_point expires;
+        bool valid = false;
+        // set while a query for the entry is running
+        bool refreshing = false;
+        // the error of the last query, for the waiting callers
+        Error err;
+        // incremented by every finished query
+        unsigned int generation = 0;
+    };
+
+    explicit Private(std::chrono::seconds t)
+        : ttl(t)
+    {
+    }
+
+    static std::string key(const char *name, const char *iversion)
+    {
+        // distinguish null from empty strings
+        std::string result(name ? "n" : "-");
+        if (name) {
+            result += name;
+        }
+        result += '\0';
+        result += iversion ? 'v' : '-';
+        if (iversion) {
+            result += iversion;
+        }
+        return result;
+    }
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::chrono::seconds ttl;
+    // shared, so that waiting callers keep the entry if it is cleared
+    std::unordered_map<std::string, std::shared_ptr<Entry>> entries;
+};
+
+SwdbCache::SwdbCache(std::chrono::seconds timeToLive)
+    : d(new Private(timeToLive))
+{
+}
+
+SwdbCache::~SwdbCache() = default;
+
+std::vector<SwdbResult> SwdbCache::query(const char *name, const char *iversion, Error *err)
+{
+    const std::string key = Private::key(name, iversion);
+    std::unique_lock<std::mutex> lock(d->mutex);
+    std::shared_ptr<Private::Entry> &slot = d->entries[key];
+    if (!slot) {
+        slot = std::make_shared<Private::Entry>();
+    }
+    const std::shared_ptr<Private::Entry> entry = slot;
+    if (entry->valid && Private::Clock::now() < entry->expires) {
+        if (err) {
+            *err = Error();
+        }
+        return entry->results;
+    }
+    if (entry->refreshing) {
+        // wait for the running query and take its answer
+        const unsigned int generation = entry->generation;
+        d->finished.wait(lock, [&entry, generation]() {
+            return entry->generation != generation;
+        });
+        if (err) {
+            *err = entry->err;
+        }
+        return entry->err ? std::vector<SwdbResult>() : entry->results;
+    }
+
+    entry->refreshing = true;
+    lock.unlock();
+    Error e;
+    std::vector<SwdbResult> results = SwdbResult::query(name, iversion, &e);
+    lock.lock();
+
+    entry->refreshing = false;
+    entry->err = e;
+    ++entry->generation;
+    entry->results = results;
+    if (!e) {
+        entry->expires = Private::Clock::now() + d->ttl;
+        entry->valid = true;
+    }
+    d->finished.notify_all();
+    if (err) {
+        *err = e;
+    }
+    return results;
+}
+
+std::chrono::seconds SwdbCache::timeToLive() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->ttl;
+}
+
+void SwdbCache::setTimeToLive(std::chrono::seconds timeToLive)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->ttl = timeToLive;
+}
+
+void SwdbCache::clear()
+{
+    // running queries store their answer in their own, detached entry
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->entries.clear();
+}
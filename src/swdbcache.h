@@ -0,0 +1,74 @@
+/*
+  swdbcache.h - caches the answers of the software version database
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_SWDBCACHE_H__
+#define __GPGMEPP_SWDBCACHE_H__
+
+#include "global.h"
+#include "swdbresult.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+/**
+ * Caches the results of SwdbResult::query() by name and installed version
+ * for a time to live.
+ *
+ * Concurrent queries for the same name and version while the answer is
+ * refreshed wait for the running query instead of starting another
+ * gpgconf. Failed queries are not cached, but the error is passed to all
+ * callers waiting for the query.
+ *
+ * The cache is thread-safe.
+ */
+class GPGMEPP_EXPORT SwdbCache
+{
+public:
+    explicit SwdbCache(std::chrono::seconds timeToLive = std::chrono::minutes(30));
+    ~SwdbCache();
+
+    /** Like SwdbResult::query(), but returns a cached answer if it is
+     * younger than the time to live. */
+    std::vector<SwdbResult> query(const char *name, const char *iversion = nullptr, Error *err = nullptr);
+
+    std::chrono::seconds timeToLive() const;
+    void setTimeToLive(std::chrono::seconds timeToLive);
+
+    /** Forgets all answers. The answers of running queries are not cached. */
+    void clear();
+
+private:
+    SwdbCache(const SwdbCache &) = delete;
+    SwdbCache &operator=(const SwdbCache &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_SWDBCACHE_H__
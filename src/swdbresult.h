@@ -63,6 +63,7 @@ public:
                                          Error *err = NULL);
 
     SwdbResult(const SwdbResult &other) = default;
+    SwdbResult(SwdbResult &&other) = default;
     const SwdbResult &operator=(SwdbResult other)
     {
         swap(other);
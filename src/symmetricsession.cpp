@@ -0,0 +1,199 @@
+/*
+  symmetricsession.cpp - encrypts many messages with the same passphrase
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <symmetricsession.h>
+#include <context.h>
+#include <encryptionresult.h>
+#include <securearena.h>
+#include <interfaces/passphraseprovider.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace GpgME;
+
+namespace
+{
+
+// hands out copies of the passphrase of the session
+class SessionPassphraseProvider : public PassphraseProvider
+{
+public:
+    explicit SessionPassphraseProvider(const char *passphrase)
+        : mPassphrase(SecureArena::instance().strdup(passphrase ? passphrase : ""))
+    {
+    }
+
+    ~SessionPassphraseProvider()
+    {
+        SecureArena::instance().deallocate(mPassphrase);
+    }
+
+    char *getPassphrase(const char *useridHint, const char *description,
+                        bool previousWasBad, bool &canceled) override
+    {
+        (void)useridHint;
+        (void)description;
+        // asking again with the same passphrase would not help
+        if (previousWasBad || !mPassphrase) {
+            canceled = true;
+            return nullptr;
+        }
+        return SecureArena::instance().strdup(mPassphrase);
+    }
+
+private:
+    char *const mPassphrase;
+};
+
+}
+
+class SymmetricSession::Private
+{
+public:
+    Private(const char *passphrase, const Options &o)
+        : provider(passphrase),
+          options(o),
+          pool(OpenPGP, [this](Context &ctx) {
+              configure(ctx);
+          })
+    {
+    }
+
+    void configure(Context &ctx)
+    {
+        ctx.setArmor(options.armor);
+        ctx.setTextMode(options.textMode);
+        ctx.setPassphraseProvider(&provider);
+        Error err = ctx.setPinentryMode(Context::PinentryLoopback);
+        if (!options.useAgentCache) {
+            // not known to old versions of gpgme, which then cache
+            ctx.setFlag("no-symkey-cache", "1");
+        }
+        if (options.configure) {
+            options.configure(ctx);
+        }
+        if (err) {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (!configError) {
+                configError = err;
+            }
+        }
+    }
+
+    Error configurationError() const
+    {
+        const std::lock_guard<std::mutex> lock(mutex);
+        return configError;
+    }
+
+    EncryptionResult encrypt(const Data &plainText, Data &cipherText)
+    {
+        Error err;
+        ContextPool::Lease lease = pool.acquire(&err);
+        if (!err) {
+            err = configurationError();
+        }
+        const unsigned int flags = Context::Symmetric | (options.noCompress ? Context::NoCompress : Context::None);
+        const EncryptionResult result = err ? EncryptionResult(err)
+                                            : lease->encrypt(std::vector<Key>(), plainText, cipherText,
+                                                             static_cast<Context::EncryptionFlags>(flags));
+        const std::lock_guard<std::mutex> lock(mutex);
+        ++stats.messages;
+        if (result.error()) {
+            ++stats.failures;
+        }
+        return result;
+    }
+
+    // declared before the pool, whose contexts use it
+    SessionPassphraseProvider provider;
+    const Options options;
+    // declared after options, which are used by the configurator
+    ContextPool pool;
+
+    mutable std::mutex mutex;
+    Error configError;
+    Statistics stats;
+};
+
+SymmetricSession::SymmetricSession(const char *passphrase, const Options &options)
+    : d(new Private(passphrase, options))
+{
+}
+
+SymmetricSession::~SymmetricSession() = default;
+
+const SymmetricSession::Options &SymmetricSession::options() const
+{
+    return d->options;
+}
+
+Error SymmetricSession::prepare(unsigned int contexts)
+{
+    const Error err = d->pool.prewarm(std::max(contexts, 1u));
+    return err ? err : d->configurationError();
+}
+
+EncryptionResult SymmetricSession::encrypt(const Data &plainText, Data &cipherText)
+{
+    return d->encrypt(plainText, cipherText);
+}
+
+std::vector<EncryptionResult> SymmetricSession::encrypt(const std::vector<Data> &plainTexts, std::vector<Data> &cipherTexts,
+                                                        unsigned int concurrency)
+{
+    std::vector<EncryptionResult> results(plainTexts.size());
+    if (cipherTexts.size() != plainTexts.size()) {
+        std::fill(results.begin(), results.end(), EncryptionResult(Error::fromCode(GPG_ERR_INV_VALUE)));
+        return results;
+    }
+    std::atomic<size_t> next(0);
+    const auto work = [this, &plainTexts, &cipherTexts, &results, &next]() {
+        for (size_t i = next++; i < plainTexts.size(); i = next++) {
+            // every worker writes to a different element
+            results[i] = d->encrypt(plainTexts[i], cipherTexts[i]);
+        }
+    };
+    const size_t count = std::min<size_t>(std::max(concurrency, 1u), plainTexts.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < count; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    return results;
+}
+
+SymmetricSession::Statistics SymmetricSession::statistics() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->stats;
+}
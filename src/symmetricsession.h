@@ -0,0 +1,109 @@
+/*
+  symmetricsession.h - encrypts many messages with the same passphrase
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_SYMMETRICSESSION_H__
+#define __GPGMEPP_SYMMETRICSESSION_H__
+
+#include "global.h"
+#include "contextpool.h"
+#include "data.h"
+
+#include <memory>
+#include <vector>
+
+namespace GpgME
+{
+
+class EncryptionResult;
+
+/**
+ * Encrypts many messages symmetrically with the same passphrase.
+ *
+ * The session keeps the passphrase in the SecureArena and passes it to the
+ * engine with the loopback pinentry mode, so that neither a pinentry nor a
+ * passphrase provider of the application is involved in the encryption of
+ * a message. The contexts of an OpenPGP ContextPool are configured once and
+ * used for encrypting several messages at the same time.
+ *
+ * Every message still gets its own S2K salt and session key, as OpenPGP
+ * requires; the engine derives the key encryption key for every message
+ * with the S2K options of its configuration (see e.g. --s2k-count in
+ * gpg.conf). Neither gpg nor gpgme offers a persistent engine or a way to
+ * reuse a derived key for symmetric encryption, so gpgme starts an engine
+ * process for every message. By default the passphrase is not put into
+ * the passphrase cache of gpg-agent ("no-symkey-cache"), which would only
+ * fill up with one entry per salt.
+ */
+class GPGMEPP_EXPORT SymmetricSession
+{
+public:
+    struct Options {
+        bool armor = false;
+        bool textMode = false;
+        bool noCompress = false;
+        /** Allow gpg-agent to cache the passphrase for the salt of every
+         * message, e.g. for decrypting the messages later in the same
+         * session of the agent. */
+        bool useAgentCache = false;
+        /** Called once for every new context after the options have been
+         * applied. */
+        ContextPool::Configurator configure;
+    };
+
+    struct Statistics {
+        unsigned long messages = 0;
+        unsigned long failures = 0;
+    };
+
+    /** Creates a session for @p passphrase, which is copied. */
+    SymmetricSession(const char *passphrase, const Options &options);
+    ~SymmetricSession();
+
+    const Options &options() const;
+
+    /** Creates contexts until at least @p contexts are idle. */
+    Error prepare(unsigned int contexts = 1);
+
+    /** Encrypts @p plainText into @p cipherText. Thread-safe. */
+    EncryptionResult encrypt(const Data &plainText, Data &cipherText);
+
+    /**
+     * Encrypts every plain text into the cipher text with the same index
+     * with up to @p concurrency engine processes at the same time and
+     * returns the results in the same order.
+     */
+    std::vector<EncryptionResult> encrypt(const std::vector<Data> &plainTexts, std::vector<Data> &cipherTexts,
+                                          unsigned int concurrency = 4);
+
+    Statistics statistics() const;
+
+private:
+    SymmetricSession(const SymmetricSession &) = delete;
+    SymmetricSession &operator=(const SymmetricSession &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_SYMMETRICSESSION_H__
@@ -0,0 +1,153 @@
+/*
+  throttledprogressprovider.cpp - coalesces progress reports
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <throttledprogressprovider.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+using namespace GpgME;
+
+class ThrottledProgressProvider::Private
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Private(ProgressProvider *t, std::chrono::milliseconds i, int p)
+        : target(t),
+          interval(i),
+          percent(p),
+          position(0),
+          type(0),
+          reports(0)
+    {
+    }
+
+    // current and total in one word, so that readers never see a
+    // current of one report with the total of another
+    static std::uint64_t pack(int current, int total)
+    {
+        return (std::uint64_t(std::uint32_t(current)) << 32) | std::uint32_t(total);
+    }
+
+    bool shouldForward(const char *what, int current, int total, Clock::time_point now) const
+    {
+        if (!forwarded || lastWhat != (what ? what : "")) {
+            return true;
+        }
+        if (total > 0 && current >= total) {
+            return true;
+        }
+        if (now - lastTime >= interval) {
+            return true;
+        }
+        if (percent > 0 && total > 0) {
+            const long long change = 100LL * (current - lastCurrent) / total;
+            return change >= percent || change <= -percent;
+        }
+        return false;
+    }
+
+    ProgressProvider *const target;
+    const std::chrono::milliseconds interval;
+    const int percent;
+
+    // only used by showProgress(), which gpgme calls from one thread
+    bool forwarded = false;
+    std::string lastWhat;
+    Clock::time_point lastTime;
+    int lastCurrent = 0;
+
+    std::atomic<std::uint64_t> position;
+    std::atomic<int> type;
+    std::atomic<unsigned long> reports;
+};
+
+ThrottledProgressProvider::ThrottledProgressProvider(ProgressProvider *target,
+                                                     std::chrono::milliseconds minInterval,
+                                                     int minPercentChange)
+    : d(new Private(target, minInterval, minPercentChange))
+{
+}
+
+ThrottledProgressProvider::~ThrottledProgressProvider() = default;
+
+ProgressProvider *ThrottledProgressProvider::target() const
+{
+    return d->target;
+}
+
+std::chrono::milliseconds ThrottledProgressProvider::minInterval() const
+{
+    return d->interval;
+}
+
+int ThrottledProgressProvider::minPercentChange() const
+{
+    return d->percent;
+}
+
+void ThrottledProgressProvider::showProgress(const char *what, int type, int current, int total)
+{
+    d->position.store(Private::pack(current, total), std::memory_order_relaxed);
+    d->type.store(type, std::memory_order_relaxed);
+    d->reports.fetch_add(1, std::memory_order_release);
+
+    if (!d->target) {
+        return;
+    }
+    const auto now = Private::Clock::now();
+    if (!d->shouldForward(what, current, total, now)) {
+        return;
+    }
+    d->forwarded = true;
+    d->lastWhat = what ? what : "";
+    d->lastTime = now;
+    d->lastCurrent = current;
+    d->target->showProgress(what, type, current, total);
+}
+
+ThrottledProgressProvider::Snapshot ThrottledProgressProvider::snapshot() const
+{
+    Snapshot result;
+    result.reports = d->reports.load(std::memory_order_acquire);
+    const std::uint64_t position = d->position.load(std::memory_order_relaxed);
+    result.current = int(std::uint32_t(position >> 32));
+    result.total = int(std::uint32_t(position));
+    result.type = d->type.load(std::memory_order_relaxed);
+    return result;
+}
+
+void ThrottledProgressProvider::reset()
+{
+    d->forwarded = false;
+    d->lastWhat.clear();
+    d->lastCurrent = 0;
+    d->position.store(0, std::memory_order_relaxed);
+    d->type.store(0, std::memory_order_relaxed);
+    d->reports.store(0, std::memory_order_release);
+}
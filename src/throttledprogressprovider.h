@@ -0,0 +1,98 @@
+/*
+  throttledprogressprovider.h - coalesces progress reports
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_THROTTLEDPROGRESSPROVIDER_H__
+#define __GPGMEPP_THROTTLEDPROGRESSPROVIDER_H__
+
+#include "global.h"
+#include "interfaces/progressprovider.h"
+
+#include <chrono>
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * A progress provider which forwards only some of the progress reports to
+ * another provider.
+ *
+ * A report is forwarded if at least the minimum interval has passed since
+ * the last forwarded report, or if the progress changed by at least the
+ * minimum number of percent. The first report of an operation (i.e. of a
+ * new @c what) and the final report (current == total) are always
+ * forwarded.
+ *
+ * Independent of the throttling, the latest report is kept in a snapshot,
+ * which can be read by other threads without locking.
+ */
+class GPGMEPP_EXPORT ThrottledProgressProvider : public ProgressProvider
+{
+public:
+    struct Snapshot {
+        int type = 0;
+        int current = 0;
+        int total = 0;
+        /** The number of reports received since the last reset(). */
+        unsigned long reports = 0;
+
+        /** Returns the progress between 0 and 1, or -1 if the total is
+         * not known. */
+        double fraction() const
+        {
+            return total > 0 ? double(current) / total : -1.0;
+        }
+    };
+
+    /**
+     * @p target may be null, in which case only the snapshot is updated.
+     * If @p minPercentChange is 0, then only the interval is checked.
+     */
+    explicit ThrottledProgressProvider(ProgressProvider *target,
+                                       std::chrono::milliseconds minInterval = std::chrono::milliseconds(100),
+                                       int minPercentChange = 0);
+    ~ThrottledProgressProvider();
+
+    ProgressProvider *target() const;
+    std::chrono::milliseconds minInterval() const;
+    int minPercentChange() const;
+
+    void showProgress(const char *what, int type, int current, int total) override;
+
+    /** Returns the latest report. Can be called from any thread. */
+    Snapshot snapshot() const;
+
+    /** Resets the snapshot and the throttling state. */
+    void reset();
+
+private:
+    ThrottledProgressProvider(const ThrottledProgressProvider &) = delete;
+    ThrottledProgressProvider &operator=(const ThrottledProgressProvider &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_THROTTLEDPROGRESSPROVIDER_H__
@@ -40,6 +40,7 @@ public:
     explicit TofuInfo(gpgme_tofu_info_t info);
 
     TofuInfo(const TofuInfo &other) = default;
+    TofuInfo(TofuInfo &&other) = default;
     const TofuInfo &operator=(TofuInfo other)
     {
         swap(other);
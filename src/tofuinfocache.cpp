@@ -0,0 +1,345 @@
+/*
+  tofuinfocache.cpp - batch queries and a cache of TOFU information
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <tofuinfocache.h>
+#include <context.h>
+#include <error.h>
+#include <key.h>
+#include <keylistrange.h>
+
+#include "context_p.h"
+
+#include <gpgme.h>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace GpgME;
+
+namespace
+{
+std::string toUpper(std::string_view s)
+{
+    std::string result(s);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::toupper(c);
+    });
+    return result;
+}
+
+std::string toLower(std::string_view s)
+{
+    std::string result(s);
+    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+        return std::tolower(c);
+    });
+    return result;
+}
+
+std::string bindingKey(std::string_view fingerprint, std::string_view address)
+{
+    return toUpper(fingerprint) + '\n' + toLower(address);
+}
+
+// calls f(address, info) for every user ID of key with TOFU information
+template <typename F>
+void forEachBinding(const Key &key, F &&f)
+{
+    for (const UserID &uid : key.userIDRange()) {
+        const TofuInfo info = uid.tofuInfo();
+        const std::string_view address = uid.addrSpecView();
+        if (!info.isNull() && !address.empty()) {
+            f(address, info);
+        }
+    }
+}
+
+unsigned int toGpgmePolicy(TofuInfo::Policy policy)
+{
+    switch (policy) {
+    case TofuInfo::PolicyNone:
+        return GPGME_TOFU_POLICY_NONE;
+    case TofuInfo::PolicyAuto:
+        return GPGME_TOFU_POLICY_AUTO;
+    case TofuInfo::PolicyGood:
+        return GPGME_TOFU_POLICY_GOOD;
+    case TofuInfo::PolicyBad:
+        return GPGME_TOFU_POLICY_BAD;
+    case TofuInfo::PolicyAsk:
+        return GPGME_TOFU_POLICY_ASK;
+    case TofuInfo::PolicyUnknown:
+    default:
+        return GPGME_TOFU_POLICY_UNKNOWN;
+    }
+}
+
+// returns a copy of info with another policy
+TofuInfo withPolicy(const TofuInfo &info, TofuInfo::Policy policy)
+{
+    _gpgme_tofu_info raw = {};
+    // the inverse of TofuInfo::validity()
+    raw.validity = info.validity() == TofuInfo::ValidityUnknown ? 7 : info.validity() - 1;
+    raw.policy = toGpgmePolicy(policy);
+    raw.signcount = info.signCount();
+    raw.encrcount = info.encrCount();
+    raw.signfirst = info.signFirst();
+    raw.signlast = info.signLast();
+    raw.encrfirst = info.encrFirst();
+    raw.encrlast = info.encrLast();
+    // copied by TofuInfo
+    raw.description = const_cast<char *>(info.description());
+    return TofuInfo(&raw);
+}
+
+struct Entry {
+    std::string fingerprint;
+    TofuInfo info;
+    std::chrono::steady_clock::time_point added;
+};
+}
+
+class TofuInfoCache::Private
+{
+public:
+    Private()
+        : maxAge(0),
+          generation(Context::Private::keyringGeneration()),
+          hits(0),
+          misses(0)
+    {
+    }
+
+    // drops everything if the keyring may have changed since the last lookup
+    void checkValidity()
+    {
+        const unsigned int currentGeneration = Context::Private::keyringGeneration();
+        if (currentGeneration != generation) {
+            generation = currentGeneration;
+            entries.clear();
+        }
+    }
+
+    // returns the cached info or a null info if the binding is not cached
+    TofuInfo lookup(const std::string &key)
+    {
+        const auto it = entries.find(key);
+        if (it == entries.end()) {
+            return TofuInfo();
+        }
+        if (maxAge && std::chrono::steady_clock::now() - it->second.added > std::chrono::seconds(maxAge)) {
+            entries.erase(it);
+            return TofuInfo();
+        }
+        return it->second.info;
+    }
+
+    void insert(const Key &key)
+    {
+        const char *const fpr = key.primaryFingerprint();
+        if (!fpr) {
+            return;
+        }
+        const std::string fingerprint = toUpper(fpr);
+        const auto now = std::chrono::steady_clock::now();
+        forEachBinding(key, [this, &fingerprint, now](std::string_view address, const TofuInfo &info) {
+            entries[bindingKey(fingerprint, address)] = Entry{fingerprint, info, now};
+        });
+    }
+
+    unsigned int maxAge;
+    unsigned int generation;
+    std::unordered_map<std::string, Entry> entries;
+    unsigned long hits;
+    unsigned long misses;
+};
+
+TofuInfoCache::TofuInfoCache()
+    : d(new Private)
+{
+}
+
+TofuInfoCache::~TofuInfoCache() = default;
+
+std::vector<TofuInfo> TofuInfoCache::query(Context *ctx, const std::vector<Binding> &bindings, Error &err)
+{
+    err = Error();
+    std::vector<TofuInfo> result(bindings.size());
+    if (bindings.empty()) {
+        return result;
+    }
+    if (!ctx) {
+        err = Error::fromCode(GPG_ERR_INV_VALUE);
+        return result;
+    }
+    if (ctx->protocol() != OpenPGP) {
+        err = Error::fromCode(GPG_ERR_UNSUPPORTED_PROTOCOL);
+        return result;
+    }
+
+    std::vector<std::string> patterns;
+    std::unordered_set<std::string> seen;
+    for (const Binding &binding : bindings) {
+        std::string fpr = toUpper(binding.fingerprint);
+        if (!fpr.empty() && seen.insert(fpr).second) {
+            patterns.push_back(std::move(fpr));
+        }
+    }
+    if (patterns.empty()) {
+        // an empty pattern list would list all keys
+        return result;
+    }
+
+    std::unordered_map<std::string, TofuInfo> infos;
+    {
+        KeyListRange range = ctx->listKeys(patterns, ctx->keyListMode() | WithTofu);
+        for (const Key &key : range) {
+            const char *const fpr = key.primaryFingerprint();
+            if (!fpr) {
+                continue;
+            }
+            forEachBinding(key, [&infos, fpr](std::string_view address, const TofuInfo &info) {
+                infos.emplace(bindingKey(fpr, address), info);
+            });
+        }
+        err = range.error();
+    }
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        const auto it = infos.find(bindingKey(bindings[i].fingerprint, bindings[i].address));
+        if (it != infos.end()) {
+            result[i] = it->second;
+        }
+    }
+    return result;
+}
+
+void TofuInfoCache::setMaximumAge(unsigned int seconds)
+{
+    d->maxAge = seconds;
+}
+
+unsigned int TofuInfoCache::maximumAge() const
+{
+    return d->maxAge;
+}
+
+TofuInfo TofuInfoCache::find(const Binding &binding, Context *ctx, Error &err)
+{
+    return find(std::vector<Binding>{binding}, ctx, err).front();
+}
+
+std::vector<TofuInfo> TofuInfoCache::find(const std::vector<Binding> &bindings, Context *ctx, Error &err)
+{
+    err = Error();
+    d->checkValidity();
+    std::vector<TofuInfo> result(bindings.size());
+    std::vector<Binding> missing;
+    std::vector<size_t> missingIndexes;
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        result[i] = d->lookup(bindingKey(bindings[i].fingerprint, bindings[i].address));
+        if (!result[i].isNull()) {
+            ++d->hits;
+        } else {
+            ++d->misses;
+            missing.push_back(bindings[i]);
+            missingIndexes.push_back(i);
+        }
+    }
+    if (missing.empty() || !ctx) {
+        return result;
+    }
+
+    const std::vector<TofuInfo> found = query(ctx, missing, err);
+    const auto now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < found.size(); ++i) {
+        if (found[i].isNull()) {
+            continue;
+        }
+        const std::string fingerprint = toUpper(missing[i].fingerprint);
+        d->entries[bindingKey(fingerprint, missing[i].address)] = Entry{fingerprint, found[i], now};
+        result[missingIndexes[i]] = found[i];
+    }
+    return result;
+}
+
+void TofuInfoCache::insert(const Key &key)
+{
+    d->checkValidity();
+    d->insert(key);
+}
+
+Error TofuInfoCache::setTofuPolicy(Context *ctx, const Key &key, TofuInfo::Policy policy)
+{
+    if (!ctx || key.isNull()) {
+        return Error::fromCode(GPG_ERR_INV_VALUE);
+    }
+    d->checkValidity();
+    const unsigned int before = Context::Private::keyringGeneration();
+    const Error err = ctx->setTofuPolicy(key, policy);
+    // the policy change bumps the generation when it starts and when it is
+    // done; anything more is a change of the keyring we do not know of
+    const unsigned int after = Context::Private::keyringGeneration();
+    d->generation = after;
+    if (err || after - before > 2) {
+        d->entries.clear();
+        return err;
+    }
+    const std::string fingerprint = toUpper(key.primaryFingerprint() ? key.primaryFingerprint() : "");
+    for (auto &entry : d->entries) {
+        if (entry.second.fingerprint == fingerprint) {
+            entry.second.info = withPolicy(entry.second.info, policy);
+        }
+    }
+    return err;
+}
+
+void TofuInfoCache::clear()
+{
+    d->entries.clear();
+}
+
+unsigned int TofuInfoCache::size() const
+{
+    return d->entries.size();
+}
+
+unsigned long TofuInfoCache::hits() const
+{
+    return d->hits;
+}
+
+unsigned long TofuInfoCache::misses() const
+{
+    return d->misses;
+}
+
+void TofuInfoCache::resetStatistics()
+{
+    d->hits = 0;
+    d->misses = 0;
+}
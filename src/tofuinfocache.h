@@ -0,0 +1,113 @@
+/*
+  tofuinfocache.h - batch queries and a cache of TOFU information
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_TOFUINFOCACHE_H__
+#define __GPGMEPP_TOFUINFOCACHE_H__
+
+#include "global.h"
+#include "tofuinfo.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace GpgME
+{
+
+class Context;
+class Error;
+class Key;
+
+/**
+ * Looks up the TofuInfo of many bindings of a key and an address at once
+ * and caches them.
+ *
+ * query() lists the keys of all bindings with a single WithTofu key
+ * listing. The cache resolves all misses of a find() with a single query.
+ * Setting a policy with setTofuPolicy() updates the cached bindings of the
+ * key, so that reading the policy afterwards does not need the engine.
+ *
+ * The cache is cleared whenever an operation which may change the keyring
+ * is started with any context of this library (see KeyCache). The sign and
+ * encryption counters of the bindings change with every verification and
+ * encryption, which does not clear the cache; set a maximum age if
+ * up-to-date counters are needed.
+ *
+ * Only OpenPGP contexts are supported. This class is not thread-safe.
+ */
+class GPGMEPP_EXPORT TofuInfoCache
+{
+public:
+    struct Binding {
+        /** The fingerprint of the primary key. */
+        std::string fingerprint;
+        /** The mail address of a user ID of the key. */
+        std::string address;
+    };
+
+    TofuInfoCache();
+    ~TofuInfoCache();
+
+    /**
+     * Returns the TofuInfo of every binding in the order of @p bindings.
+     * The info of a binding whose key or user ID was not found is null.
+     * The key list mode of @p ctx is not changed.
+     */
+    static std::vector<TofuInfo> query(Context *ctx, const std::vector<Binding> &bindings, Error &err);
+
+    /** Cached entries older than @p seconds are looked up again. 0 (the
+     * default) means no limit. */
+    void setMaximumAge(unsigned int seconds);
+    unsigned int maximumAge() const;
+
+    TofuInfo find(const Binding &binding, Context *ctx, Error &err);
+    /** Same as query(), but only the bindings which are not cached are
+     * looked up. */
+    std::vector<TofuInfo> find(const std::vector<Binding> &bindings, Context *ctx, Error &err);
+
+    /** Adds the bindings of all user IDs of @p key, which must have been
+     * listed with WithTofu. */
+    void insert(const Key &key);
+
+    /** Sets the policy of @p key with @p ctx and, on success, the policy of
+     * the cached bindings of the key. */
+    Error setTofuPolicy(Context *ctx, const Key &key, TofuInfo::Policy policy);
+
+    void clear();
+
+    unsigned int size() const;
+    unsigned long hits() const;
+    unsigned long misses() const;
+    void resetStatistics();
+
+private:
+    TofuInfoCache(const TofuInfoCache &) = delete;
+    TofuInfoCache &operator=(const TofuInfoCache &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_TOFUINFOCACHE_H__
@@ -0,0 +1,92 @@
+/*
+  tracescope.cpp - makes a tracing span the current span of a thread
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <tracescope.h>
+#include <context.h>
+
+#include <atomic>
+
+using namespace GpgME;
+
+namespace
+{
+thread_local TraceSpan *s_currentSpan = nullptr;
+std::atomic<Tracer *> s_globalTracer{nullptr};
+}
+
+void Context::setGlobalTracer(Tracer *tracer)
+{
+    s_globalTracer.store(tracer);
+}
+
+Tracer *Context::globalTracer()
+{
+    return s_globalTracer.load(std::memory_order_relaxed);
+}
+
+TraceScope::TraceScope(const char *name, Tracer *tracer)
+    : mPrevious(s_currentSpan)
+{
+    if (!tracer) {
+        tracer = Context::globalTracer();
+    }
+    if (tracer) {
+        mSpan = tracer->startSpan(name, mPrevious);
+    }
+    if (mSpan) {
+        s_currentSpan = mSpan.get();
+    }
+}
+
+TraceScope::TraceScope(TraceSpan *parent)
+    : mPrevious(s_currentSpan)
+{
+    s_currentSpan = parent;
+}
+
+TraceScope::~TraceScope()
+{
+    s_currentSpan = mPrevious;
+    if (mSpan) {
+        mSpan->setAttribute("gpgme.error_code", std::int64_t(mError.code()));
+        mSpan->end(mError);
+    }
+}
+
+TraceSpan *TraceScope::span() const
+{
+    return mSpan.get();
+}
+
+void TraceScope::setError(const Error &error)
+{
+    mError = error;
+}
+
+TraceSpan *TraceScope::current()
+{
+    return s_currentSpan;
+}
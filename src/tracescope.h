@@ -0,0 +1,81 @@
+/*
+  tracescope.h - makes a tracing span the current span of a thread
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_TRACESCOPE_H__
+#define __GPGMEPP_TRACESCOPE_H__
+
+#include "global.h"
+#include "error.h"
+#include "interfaces/tracer.h"
+
+#include <memory>
+
+namespace GpgME
+{
+
+/**
+ * Sets the current tracing span of the calling thread for its lifetime.
+ *
+ * The current span is used as parent of the spans of all operations
+ * started by the thread on contexts without an explicit parent set with
+ * Context::setTraceParent().
+ *
+ * \code
+ * TraceScope scope(requestSpan); // requestSpan created by the application
+ * ctx->decrypt(cipherText, plainText); // "gpgme.decrypt" is a child of requestSpan
+ * \endcode
+ */
+class GPGMEPP_EXPORT TraceScope
+{
+public:
+    /**
+     * Starts a span called @p name with @p tracer, or with the global
+     * tracer if @p tracer is nullptr, as child of the current span and makes
+     * it the current span. Does nothing if there is no tracer.
+     */
+    explicit TraceScope(const char *name, Tracer *tracer = nullptr);
+    /** Makes @p parent the current span without starting a span. */
+    explicit TraceScope(TraceSpan *parent);
+    /** Ends the span started by the scope with the error set with setError()
+     * and restores the previous current span. */
+    ~TraceScope();
+
+    /** Returns the span started by the scope or nullptr. */
+    TraceSpan *span() const;
+    void setError(const Error &error);
+
+    /** Returns the current span of the calling thread or nullptr. */
+    static TraceSpan *current();
+
+private:
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    std::unique_ptr<TraceSpan> mSpan;
+    TraceSpan *mPrevious;
+    Error mError;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_TRACESCOPE_H__
@@ -27,6 +27,7 @@
 
 #include "util.h"
 
+#include <algorithm>
 #include <functional>
 
 #include <cstring>
@@ -49,19 +50,40 @@ std::vector<std::string_view> _gpgmepp::split_into_string_views(const char *s, c
     return result;
 }
 
+void _gpgmepp::append_length_prefixed(std::string &out, std::string_view value)
+{
+    out += std::to_string(value.size());
+    out += ':';
+    out.append(value.data(), value.size());
+}
+
 StringsToCStrings::StringsToCStrings(const std::vector<std::string>& v)
-    : m_strings{v}
 {
+    m_cstrings.reserve(v.size() + 1);
+    std::transform(std::begin(v), std::end(v),
+                   std::back_inserter(m_cstrings),
+                   std::mem_fn(&std::string::c_str));
+    m_cstrings.push_back(nullptr);
 }
 
-const char **StringsToCStrings::c_strs() const
+StringsToCStrings::StringsToCStrings(const std::string_view *v, size_t count)
 {
-    if (m_cstrings.empty()) {
-        m_cstrings.reserve(m_strings.size() + 1);
-        std::transform(std::begin(m_strings), std::end(m_strings),
-                       std::back_inserter(m_cstrings),
-                       std::mem_fn(&std::string::c_str));
-        m_cstrings.push_back(nullptr);
+    size_t size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size += v[i].size() + 1;
+    }
+    m_buffer.resize(size);
+    m_cstrings.reserve(count + 1);
+    char *p = m_buffer.data();
+    for (size_t i = 0; i < count; ++i) {
+        m_cstrings.push_back(p);
+        p = std::copy(v[i].begin(), v[i].end(), p);
+        *p++ = '\0';
     }
+    m_cstrings.push_back(nullptr);
+}
+
+const char **StringsToCStrings::c_strs() const
+{
     return m_cstrings.data();
 }
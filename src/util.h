@@ -29,6 +29,8 @@
 #define __GPGMEPP_UTIL_H__
 
 #include "global.h"
+#include "key.h"
+#include "keylistoptions.h"
 #include "notation.h"
 
 #include <gpgme.h>
@@ -38,12 +40,33 @@
 #endif
 #include <sstream>
 #include <string>
+#include <string_view>
 
 static inline const char *protect(const char *s)
 {
     return s ? s : "<null>" ;
 }
 
+static inline std::string_view to_string_view(const char *s)
+{
+    return s ? std::string_view(s) : std::string_view();
+}
+
+// orders the validities from worst to best; unlike in the enum, Never
+// (an explicitly distrusted user ID) is worse than Unknown
+static inline int validity_rank(GpgME::UserID::Validity validity)
+{
+    switch (validity) {
+    case GpgME::UserID::Never:     return 0;
+    case GpgME::UserID::Unknown:   return 1;
+    case GpgME::UserID::Undefined: return 2;
+    case GpgME::UserID::Marginal:  return 3;
+    case GpgME::UserID::Full:      return 4;
+    case GpgME::UserID::Ultimate:  return 5;
+    }
+    return 1;
+}
+
 static inline gpgme_error_t make_error(gpgme_err_code_t code)
 {
     return gpgme_err_make((gpgme_err_source_t)22, code);
@@ -62,95 +85,12 @@ static inline unsigned long to_pid(const std::string &s)
 
 static inline gpgme_keylist_mode_t add_to_gpgme_keylist_mode_t(unsigned int oldmode, unsigned int newmodes)
 {
-    if (newmodes & GpgME::Local) {
-        oldmode |= GPGME_KEYLIST_MODE_LOCAL;
-    }
-    if (newmodes & GpgME::Extern) {
-        oldmode |= GPGME_KEYLIST_MODE_EXTERN;
-    }
-    if (newmodes & GpgME::Signatures) {
-        oldmode |= GPGME_KEYLIST_MODE_SIGS;
-    }
-    if (newmodes & GpgME::SignatureNotations) {
-        oldmode |= GPGME_KEYLIST_MODE_SIG_NOTATIONS;
-    }
-    if (newmodes & GpgME::Validate) {
-        oldmode |= GPGME_KEYLIST_MODE_VALIDATE;
-    }
-    if (newmodes & GpgME::Ephemeral) {
-        oldmode |= GPGME_KEYLIST_MODE_EPHEMERAL;
-    }
-    if (newmodes & GpgME::WithTofu) {
-        oldmode |= GPGME_KEYLIST_MODE_WITH_TOFU;
-    }
-    if (newmodes & GpgME::WithKeygrip) {
-        oldmode |= GPGME_KEYLIST_MODE_WITH_KEYGRIP;
-    }
-    if (newmodes & GpgME::WithSecret) {
-        oldmode |= GPGME_KEYLIST_MODE_WITH_SECRET;
-    }
-    if (newmodes & GpgME::ForceExtern) {
-        oldmode |= GPGME_KEYLIST_MODE_FORCE_EXTERN;
-    }
-#ifndef NDEBUG
-    if (newmodes & ~(GpgME::KeyListModeMask)) {
-        //std::cerr << "GpgME::Context: keylist mode must be one of Local, "
-        //"Extern, Signatures, SignatureNotations, Validate, Ephemeral, WithTofu, "
-        //"WithKeygrip, WithSecret, ForceExtern, or a combination thereof!"
-        //<< std::endl;
-    }
-#endif
-    return static_cast<gpgme_keylist_mode_t>(oldmode);
+    return static_cast<gpgme_keylist_mode_t>(oldmode | GpgME::toGpgmeKeyListMode(newmodes));
 }
 
 static inline unsigned int convert_from_gpgme_keylist_mode_t(unsigned int mode)
 {
-    unsigned int result = 0;
-    if (mode & GPGME_KEYLIST_MODE_LOCAL) {
-        result |= GpgME::Local;
-    }
-    if (mode & GPGME_KEYLIST_MODE_EXTERN) {
-        result |= GpgME::Extern;
-    }
-    if (mode & GPGME_KEYLIST_MODE_SIGS) {
-        result |= GpgME::Signatures;
-    }
-    if (mode & GPGME_KEYLIST_MODE_SIG_NOTATIONS) {
-        result |= GpgME::SignatureNotations;
-    }
-    if (mode & GPGME_KEYLIST_MODE_WITH_SECRET) {
-        result |= GpgME::WithSecret;
-    }
-    if (mode & GPGME_KEYLIST_MODE_WITH_TOFU) {
-        result |= GpgME::WithTofu;
-    }
-    if (mode & GPGME_KEYLIST_MODE_WITH_KEYGRIP) {
-        result |= GpgME::WithKeygrip;
-    }
-    if (mode & GPGME_KEYLIST_MODE_EPHEMERAL) {
-        result |= GpgME::Ephemeral;
-    }
-    if (mode & GPGME_KEYLIST_MODE_VALIDATE) {
-        result |= GpgME::Validate;
-    }
-    if (mode & GPGME_KEYLIST_MODE_FORCE_EXTERN) {
-        result |= GpgME::ForceExtern;
-    }
-#ifndef NDEBUG
-    if (mode & ~(GPGME_KEYLIST_MODE_LOCAL |
-                 GPGME_KEYLIST_MODE_EXTERN |
-                 GPGME_KEYLIST_MODE_SIGS |
-                 GPGME_KEYLIST_MODE_SIG_NOTATIONS |
-                 GPGME_KEYLIST_MODE_WITH_SECRET |
-                 GPGME_KEYLIST_MODE_WITH_TOFU |
-                 GPGME_KEYLIST_MODE_WITH_KEYGRIP |
-                 GPGME_KEYLIST_MODE_EPHEMERAL |
-                 GPGME_KEYLIST_MODE_VALIDATE |
-                 GPGME_KEYLIST_MODE_FORCE_EXTERN)) {
-        //std::cerr << "GpgME: WARNING: gpgme_get_keylist_mode() returned an unknown flag!" << std::endl;
-    }
-#endif // NDEBUG
-    return result;
+    return GpgME::fromGpgmeKeyListMode(mode);
 }
 
 static inline GpgME::Notation::Flags convert_from_gpgme_sig_notation_flags_t(unsigned int flags)
@@ -198,16 +138,28 @@ namespace _gpgmepp {
  */
 GPGMEPP_EXPORT std::vector<std::string_view> split_into_string_views(const char *s, char delimiter);
 
+/*!
+ * Appends \a value with its length as decimal prefix and a colon to
+ * \a out, so that concatenations of different values never collide.
+ * \a value may contain NUL bytes.
+ */
+GPGMEPP_EXPORT void append_length_prefixed(std::string &out, std::string_view value);
+
 } // namespace _gpgmepp
 
 /**
- * Adapter for passing a vector of strings as NULL-terminated array of
- * const char* to the C-interface of gpgme.
+ * Adapter for passing strings as NULL-terminated array of const char* to
+ * the C-interface of gpgme.
+ *
+ * Strings of a vector are already NUL-terminated and are not copied, so
+ * the vector must outlive the adapter. String views are copied into a
+ * single buffer.
  */
 class StringsToCStrings
 {
 public:
     explicit StringsToCStrings(const std::vector<std::string> &v);
+    StringsToCStrings(const std::string_view *v, size_t count);
     ~StringsToCStrings() = default;
 
     StringsToCStrings(const StringsToCStrings &) = delete;
@@ -217,7 +169,7 @@ public:
 
     const char **c_strs() const;
 private:
-    const std::vector<std::string> m_strings;
+    std::vector<char> m_buffer;
     mutable std::vector<const char *> m_cstrings;
 };
 
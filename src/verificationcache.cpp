@@ -0,0 +1,252 @@
+/*
+  verificationcache.cpp - caches the results of repeated verifications
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include <verificationcache.h>
+#include <context.h>
+#include <data.h>
+#include <engineinfo.h>
+
+#include "context_p.h"
+#include "util.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+using namespace GpgME;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Entry {
+    std::string id;
+    VerificationResult result;
+    Clock::time_point time;
+};
+
+std::string entryID(const Context &ctx, const std::string &signature, const std::string &digest)
+{
+    // length-prefixed, so that no two different combinations are equal
+    std::string id;
+    id.reserve(signature.size() + digest.size() + 64);
+    id += std::to_string(int(ctx.protocol()));
+    id += ':';
+    _gpgmepp::append_length_prefixed(id, to_string_view(ctx.engineInfo().homeDirectory()));
+    // the digest is usually binary and may contain NUL bytes
+    _gpgmepp::append_length_prefixed(id, digest);
+    id += signature;
+    return id;
+}
+}
+
+class VerificationCache::Private
+{
+public:
+    using Entries = std::list<Entry>;
+
+    explicit Private(size_t m)
+        : maxSize(m),
+          maxAge(0),
+          generation(Context::Private::keyringGeneration()),
+          hits(0),
+          misses(0)
+    {
+    }
+
+    // drops everything if the keyring may have changed
+    void checkValidity()
+    {
+        const unsigned int currentGeneration = Context::Private::keyringGeneration();
+        if (currentGeneration != generation) {
+            generation = currentGeneration;
+            clear();
+        }
+    }
+
+    void clear()
+    {
+        entries.clear();
+        index.clear();
+    }
+
+    void erase(Entries::iterator it)
+    {
+        index.erase(it->id);
+        entries.erase(it);
+    }
+
+    void shrink()
+    {
+        while (maxSize && entries.size() > maxSize) {
+            erase(std::prev(entries.end()));
+        }
+    }
+
+    VerificationResult find(const std::string &id)
+    {
+        checkValidity();
+        const auto it = index.find(id);
+        if (it == index.end()) {
+            ++misses;
+            return VerificationResult();
+        }
+        if (maxAge.count() && Clock::now() - it->second->time > maxAge) {
+            erase(it->second);
+            ++misses;
+            return VerificationResult();
+        }
+        ++hits;
+        // moves the entry to the front of the LRU list
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->result;
+    }
+
+    void insert(std::string &&id, const VerificationResult &result, unsigned int startGeneration)
+    {
+        checkValidity();
+        // the keyring changed while verifying
+        if (startGeneration != generation || result.isNull() || result.error()) {
+            return;
+        }
+        const auto existing = index.find(id);
+        if (existing != index.end()) {
+            erase(existing->second);
+        }
+        entries.push_front(Entry{std::move(id), result, Clock::now()});
+        index.emplace(entries.front().id, entries.begin());
+        shrink();
+    }
+
+    size_t maxSize;
+    std::chrono::seconds maxAge;
+    unsigned int generation;
+    unsigned long hits;
+    unsigned long misses;
+    Entries entries;
+    std::unordered_map<std::string, Entries::iterator> index;
+    mutable std::mutex mutex;
+};
+
+VerificationCache::VerificationCache(size_t maximumSize)
+    : d(new Private(maximumSize))
+{
+}
+
+VerificationCache::~VerificationCache() = default;
+
+void VerificationCache::setMaximumSize(size_t size)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->maxSize = size;
+    d->shrink();
+}
+
+size_t VerificationCache::maximumSize() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->maxSize;
+}
+
+void VerificationCache::setMaximumAge(std::chrono::seconds age)
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->maxAge = age;
+}
+
+std::chrono::seconds VerificationCache::maximumAge() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->maxAge;
+}
+
+VerificationResult VerificationCache::verifyDetachedSignature(Context &ctx, const std::string &signature,
+                                                              const Data &signedText, const std::string &signedTextDigest,
+                                                              bool *cached)
+{
+    std::string id = entryID(ctx, signature, signedTextDigest);
+    unsigned int generation;
+    {
+        const std::lock_guard<std::mutex> lock(d->mutex);
+        const VerificationResult result = d->find(id);
+        if (!result.isNull()) {
+            if (cached) {
+                *cached = true;
+            }
+            return result;
+        }
+        generation = d->generation;
+    }
+    if (cached) {
+        *cached = false;
+    }
+    const Data signatureData(signature.data(), signature.size(), false);
+    const VerificationResult result = ctx.verifyDetachedSignature(signatureData, signedText);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->insert(std::move(id), result, generation);
+    return result;
+}
+
+VerificationResult VerificationCache::find(const Context &ctx, const std::string &signature,
+                                           const std::string &signedTextDigest)
+{
+    const std::string id = entryID(ctx, signature, signedTextDigest);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->find(id);
+}
+
+void VerificationCache::insert(const Context &ctx, const std::string &signature,
+                               const std::string &signedTextDigest, const VerificationResult &result)
+{
+    std::string id = entryID(ctx, signature, signedTextDigest);
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->checkValidity();
+    d->insert(std::move(id), result, d->generation);
+}
+
+void VerificationCache::clear()
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    d->clear();
+}
+
+size_t VerificationCache::size() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->entries.size();
+}
+
+unsigned long VerificationCache::hits() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->hits;
+}
+
+unsigned long VerificationCache::misses() const
+{
+    const std::lock_guard<std::mutex> lock(d->mutex);
+    return d->misses;
+}
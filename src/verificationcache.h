@@ -0,0 +1,105 @@
+/*
+  verificationcache.h - caches the results of repeated verifications
+  Copyright (C) 2026 g10 Code GmbH
+
+  This file is part of GPGME++.
+
+  GPGME++ is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Library General Public
+  License as published by the Free Software Foundation; either
+  version 2 of the License, or (at your option) any later version.
+
+  GPGME++ is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU Library General Public License for more details.
+
+  You should have received a copy of the GNU Library General Public License
+  along with this program; if not, see <https://gnu.org/licenses/>.
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+
+// -*- c++ -*-
+#ifndef __GPGMEPP_VERIFICATIONCACHE_H__
+#define __GPGMEPP_VERIFICATIONCACHE_H__
+
+#include "global.h"
+#include "verificationresult.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace GpgME
+{
+
+class Context;
+class Data;
+
+/**
+ * Caches the results of the verifications of detached signatures, for
+ * applications which verify the same signatures of the same data again
+ * and again.
+ *
+ * An entry is identified by the bytes of the signature, a digest of the
+ * signed data provided by the caller, the protocol and the home directory
+ * of the context. The digest must be computed with a collision resistant
+ * hash function, because a cached result is returned for all data with
+ * the same digest.
+ *
+ * Like KeyCache, the cache is invalidated whenever an operation which may
+ * change the keyring (import, revocation, trust changes, ...) is started
+ * with any context of this library. Changes by other processes are not
+ * noticed; use setMaximumAge() to bound the age of the results. Results
+ * with an error are not cached.
+ *
+ * The cache is thread-safe.
+ */
+class GPGMEPP_EXPORT VerificationCache
+{
+public:
+    /** A @p maximumSize of 0 means no limit. */
+    explicit VerificationCache(size_t maximumSize = 1000);
+    ~VerificationCache();
+
+    void setMaximumSize(size_t size);
+    size_t maximumSize() const;
+
+    /** Results older than @p age are verified again. 0, the default,
+     * means no limit, i.e. cached results never expire (until the cache
+     * is invalidated or the entry is evicted). */
+    void setMaximumAge(std::chrono::seconds age);
+    std::chrono::seconds maximumAge() const;
+
+    /**
+     * Returns the cached result for @p signature and @p signedTextDigest or
+     * verifies @p signature of @p signedText with @p ctx and caches the
+     * result. @p cached is set to true if the engine was not invoked.
+     */
+    VerificationResult verifyDetachedSignature(Context &ctx, const std::string &signature,
+                                               const Data &signedText, const std::string &signedTextDigest,
+                                               bool *cached = nullptr);
+
+    /** Returns the cached result or a null result. */
+    VerificationResult find(const Context &ctx, const std::string &signature, const std::string &signedTextDigest);
+    void insert(const Context &ctx, const std::string &signature, const std::string &signedTextDigest,
+                const VerificationResult &result);
+
+    void clear();
+    size_t size() const;
+
+    unsigned long hits() const;
+    unsigned long misses() const;
+
+private:
+    VerificationCache(const VerificationCache &) = delete;
+    VerificationCache &operator=(const VerificationCache &) = delete;
+
+    class Private;
+    const std::unique_ptr<Private> d;
+};
+
+} // namespace GpgME
+
+#endif // __GPGMEPP_VERIFICATIONCACHE_H__
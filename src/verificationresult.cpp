@@ -38,6 +38,7 @@
 #include <istream>
 #include <algorithm>
 #include <iterator>
+#include <mutex>
 #include <string>
 #include <cstring>
 #include <cstdlib>
@@ -48,6 +49,7 @@ class GpgME::VerificationResult::Private
 {
 public:
     explicit Private(const gpgme_verify_result_t r)
+        : res(nullptr), numSigs(0)
     {
         if (!r) {
             return;
@@ -55,18 +57,82 @@ public:
         if (r->file_name) {
             file_name = r->file_name;
         }
+        for (gpgme_signature_t is = r->signatures ; is ; is = is->next) {
+            ++numSigs;
+        }
+        // the signatures are only copied when they are accessed; until then
+        // a reference to the result keeps it alive when the context is reused
+        if (numSigs) {
+            gpgme_result_ref(r);
+            res = r;
+        }
+    }
+    ~Private()
+    {
+        if (res) {
+            gpgme_result_unref(res);
+        }
+    }
+
+    std::vector<gpgme_signature_t> &signatures()
+    {
+        materialize();
+        return sigs;
+    }
+    std::vector<GpgME::Key> &signatureKeys()
+    {
+        materialize();
+        return keys;
+    }
+    const std::vector<char *> &policyURLs()
+    {
+        materialize();
+        return purls;
+    }
+
+    void materialize()
+    {
+        std::call_once(materialized, [this]() {
+            if (res) {
+                copySignatures(res);
+                gpgme_result_unref(res);
+                res = nullptr;
+            }
+        });
+    }
+
+    void copySignatures(const gpgme_verify_result_t r)
+    {
+        // size the arena, so that all copies are made in one allocation:
+        for (gpgme_signature_t is = r->signatures ; is ; is = is->next) {
+            arena.reserve<_gpgme_signature>();
+            arena.reserveString(is->fpr);
+#ifndef _WIN32
+            arena.reserveString(is->pka_address);
+#endif
+            unsigned int numNotations = 0;
+            for (gpgme_sig_notation_t in = is->notations ; in ; in = in->next) {
+                if (in->name) {
+                    ++numNotations;
+                    arena.reserveString(in->name);
+                }
+                arena.reserveString(in->value);
+            }
+            arena.reserve<Nota>(numNotations);
+        }
+        sigs.reserve(numSigs);
+        nota.reserve(numSigs);
+        keys.reserve(numSigs);
+        purls.reserve(numSigs);
+
         // copy recursively, using compiler-generated copy ctor.
         // We just need to handle the pointers in the structs:
         for (gpgme_signature_t is = r->signatures ; is ; is = is->next) {
-            gpgme_signature_t scopy = new _gpgme_signature(*is);
-            if (is->fpr) {
-                scopy->fpr = strdup(is->fpr);
-            }
+            gpgme_signature_t scopy = arena.copy(*is);
+            scopy->fpr = arena.copyString(is->fpr);
 // PENDING(marc) why does this crash on Windows in strdup()?
 # ifndef _WIN32
-            if (is->pka_address) {
-                scopy->pka_address = strdup(is->pka_address);
-            }
+            scopy->pka_address = arena.copyString(is->pka_address);
 # else
             scopy->pka_address = nullptr;
 # endif
@@ -79,39 +145,27 @@ public:
                 keys.push_back(Key());
             }
             // copy notations:
-            nota.push_back(std::vector<Nota>());
+            unsigned int numNotations = 0;
+            for (gpgme_sig_notation_t in = is->notations ; in ; in = in->next) {
+                if (in->name) {
+                    ++numNotations;
+                }
+            }
+            NotaList list = { arena.allocateArray<Nota>(numNotations), 0 };
             purls.push_back(nullptr);
             for (gpgme_sig_notation_t in = is->notations ; in ; in = in->next) {
                 if (!in->name) {
                     if (in->value) {
-                        purls.back() = strdup(in->value);   // policy url
+                        purls.back() = arena.copyString(in->value);   // policy url
                     }
                     continue;
                 }
-                Nota n = { nullptr, nullptr, in->flags };
-                n.name = strdup(in->name);
-                if (in->value) {
-                    n.value = strdup(in->value);
-                }
-                nota.back().push_back(n);
+                const Nota n = { arena.copyString(in->name), arena.copyString(in->value), in->flags };
+                list.items[list.count++] = n;
             }
+            nota.push_back(list);
         }
     }
-    ~Private()
-    {
-        for (std::vector<gpgme_signature_t>::iterator it = sigs.begin() ; it != sigs.end() ; ++it) {
-            std::free((*it)->fpr);
-            std::free((*it)->pka_address);
-            delete *it; *it = nullptr;
-        }
-        for (std::vector< std::vector<Nota> >::iterator it = nota.begin() ; it != nota.end() ; ++it) {
-            for (std::vector<Nota>::iterator jt = it->begin() ; jt != it->end() ; ++jt) {
-                std::free(jt->name);  jt->name = nullptr;
-                std::free(jt->value); jt->value = nullptr;
-            }
-        }
-        std::for_each(purls.begin(), purls.end(), &std::free);
-    }
 
     struct Nota {
         char *name;
@@ -119,8 +173,35 @@ public:
         gpgme_sig_notation_flags_t flags;
     };
 
+    // the notations of one signature, allocated from the arena
+    struct NotaList {
+        Nota *items;
+        unsigned int count;
+
+        unsigned int size() const
+        {
+            return count;
+        }
+        const Nota &operator[](unsigned int idx) const
+        {
+            return items[idx];
+        }
+    };
+
+    const std::vector<NotaList> &notations()
+    {
+        materialize();
+        return nota;
+    }
+
+    // the result of gpgme until the signatures have been copied
+    gpgme_verify_result_t res;
+    unsigned int numSigs;
+    std::once_flag materialized;
+    // owns the copies of the signatures, notations and strings
+    ResultArena arena;
     std::vector<gpgme_signature_t> sigs;
-    std::vector< std::vector<Nota> > nota;
+    std::vector<NotaList> nota;
     std::vector<GpgME::Key> keys;
     std::vector<char *> purls;
     std::string file_name;
@@ -157,6 +238,23 @@ void GpgME::VerificationResult::init(gpgme_ctx_t ctx)
 
 make_standard_stuff(VerificationResult)
 
+GpgME::MemoryUsage GpgME::VerificationResult::approximateMemoryUsage() const
+{
+    if (!d) {
+        return resultMemoryUsage<VerificationResult>(d, 0);
+    }
+    d->materialize();
+    const size_t bytes = d->arena.allocatedBytes()
+                         + heapBytes(d->sigs)
+                         + heapBytes(d->nota)
+                         + heapBytes(d->purls)
+                         + (d->file_name.capacity() >= sizeof(std::string) ? d->file_name.capacity() + 1 : 0);
+    MemoryUsage usage = resultMemoryUsage<VerificationResult>(d, bytes);
+    // the keys of the signatures, including the vector
+    usage += Key::approximateMemoryUsage(d->keys);
+    return usage;
+}
+
 const char *GpgME::VerificationResult::fileName() const
 {
     return d ? d->file_name.c_str() : nullptr ;
@@ -164,7 +262,7 @@ const char *GpgME::VerificationResult::fileName() const
 
 unsigned int GpgME::VerificationResult::numSignatures() const
 {
-    return d ? d->sigs.size() : 0 ;
+    return d ? d->numSigs : 0 ;
 }
 
 GpgME::Signature GpgME::VerificationResult::signature(unsigned int idx) const
@@ -178,8 +276,8 @@ std::vector<GpgME::Signature> GpgME::VerificationResult::signatures() const
         return std::vector<Signature>();
     }
     std::vector<Signature> result;
-    result.reserve(d->sigs.size());
-    for (unsigned int i = 0 ; i < d->sigs.size() ; ++i) {
+    result.reserve(d->numSigs);
+    for (unsigned int i = 0 ; i < d->numSigs ; ++i) {
         result.push_back(Signature(d, i));
     }
     return result;
@@ -194,7 +292,7 @@ GpgME::Signature::Signature() : d(), idx(0) {}
 
 bool GpgME::Signature::isNull() const
 {
-    return !d || idx >= d->sigs.size() ;
+    return !d || idx >= d->numSigs ;
 }
 
 GpgME::Signature::Summary GpgME::Signature::summary() const
@@ -202,7 +300,7 @@ GpgME::Signature::Summary GpgME::Signature::summary() const
     if (isNull()) {
         return None;
     }
-    gpgme_sigsum_t sigsum = d->sigs[idx]->summary;
+    gpgme_sigsum_t sigsum = d->signatures()[idx]->summary;
     unsigned int result = 0;
     if (sigsum & GPGME_SIGSUM_VALID) {
         result |= Valid;
@@ -245,22 +343,22 @@ GpgME::Signature::Summary GpgME::Signature::summary() const
 
 const char *GpgME::Signature::fingerprint() const
 {
-    return isNull() ? nullptr : d->sigs[idx]->fpr ;
+    return isNull() ? nullptr : d->signatures()[idx]->fpr ;
 }
 
 GpgME::Error GpgME::Signature::status() const
 {
-    return Error(isNull() ? 0 : d->sigs[idx]->status);
+    return Error(isNull() ? 0 : d->signatures()[idx]->status);
 }
 
 time_t GpgME::Signature::creationTime() const
 {
-    return static_cast<time_t>(isNull() ? 0 : d->sigs[idx]->timestamp);
+    return static_cast<time_t>(isNull() ? 0 : d->signatures()[idx]->timestamp);
 }
 
 time_t GpgME::Signature::expirationTime() const
 {
-    return static_cast<time_t>(isNull() ? 0 : d->sigs[idx]->exp_timestamp);
+    return static_cast<time_t>(isNull() ? 0 : d->signatures()[idx]->exp_timestamp);
 }
 
 bool GpgME::Signature::neverExpires() const
@@ -270,28 +368,28 @@ bool GpgME::Signature::neverExpires() const
 
 bool GpgME::Signature::isWrongKeyUsage() const
 {
-    return !isNull() && d->sigs[idx]->wrong_key_usage;
+    return !isNull() && d->signatures()[idx]->wrong_key_usage;
 }
 
 bool GpgME::Signature::isVerifiedUsingChainModel() const
 {
-    return !isNull() && d->sigs[idx]->chain_model;
+    return !isNull() && d->signatures()[idx]->chain_model;
 }
 
 bool GpgME::Signature::isDeVs() const
 {
-    return !isNull() && d->sigs[idx]->is_de_vs;
+    return !isNull() && d->signatures()[idx]->is_de_vs;
 }
 
 bool GpgME::Signature::isBetaCompliance() const
 {
-    return !isNull() && d->sigs[idx]->beta_compliance;
+    return !isNull() && d->signatures()[idx]->beta_compliance;
 }
 
 GpgME::Signature::PKAStatus GpgME::Signature::pkaStatus() const
 {
     if (!isNull()) {
-        return static_cast<PKAStatus>(d->sigs[idx]->pka_trust);
+        return static_cast<PKAStatus>(d->signatures()[idx]->pka_trust);
     }
     return UnknownPKAStatus;
 }
@@ -299,7 +397,7 @@ GpgME::Signature::PKAStatus GpgME::Signature::pkaStatus() const
 const char *GpgME::Signature::pkaAddress() const
 {
     if (!isNull()) {
-        return d->sigs[idx]->pka_address;
+        return d->signatures()[idx]->pka_address;
     }
     return nullptr;
 }
@@ -309,7 +407,7 @@ GpgME::Signature::Validity GpgME::Signature::validity() const
     if (isNull()) {
         return Unknown;
     }
-    switch (d->sigs[idx]->validity) {
+    switch (d->signatures()[idx]->validity) {
     default:
     case GPGME_VALIDITY_UNKNOWN:   return Unknown;
     case GPGME_VALIDITY_UNDEFINED: return Undefined;
@@ -325,7 +423,7 @@ char GpgME::Signature::validityAsString() const
     if (isNull()) {
         return '?';
     }
-    switch (d->sigs[idx]->validity) {
+    switch (d->signatures()[idx]->validity) {
     default:
     case GPGME_VALIDITY_UNKNOWN:   return '?';
     case GPGME_VALIDITY_UNDEFINED: return 'q';
@@ -338,13 +436,13 @@ char GpgME::Signature::validityAsString() const
 
 GpgME::Error GpgME::Signature::nonValidityReason() const
 {
-    return Error(isNull() ? 0 : d->sigs[idx]->validity_reason);
+    return Error(isNull() ? 0 : d->signatures()[idx]->validity_reason);
 }
 
 unsigned int GpgME::Signature::publicKeyAlgorithm() const
 {
     if (!isNull()) {
-        return d->sigs[idx]->pubkey_algo;
+        return d->signatures()[idx]->pubkey_algo;
     }
     return 0;
 }
@@ -352,7 +450,7 @@ unsigned int GpgME::Signature::publicKeyAlgorithm() const
 const char *GpgME::Signature::publicKeyAlgorithmAsString() const
 {
     if (!isNull()) {
-        return gpgme_pubkey_algo_name(d->sigs[idx]->pubkey_algo);
+        return gpgme_pubkey_algo_name(d->signatures()[idx]->pubkey_algo);
     }
     return nullptr;
 }
@@ -360,7 +458,7 @@ const char *GpgME::Signature::publicKeyAlgorithmAsString() const
 unsigned int GpgME::Signature::hashAlgorithm() const
 {
     if (!isNull()) {
-        return d->sigs[idx]->hash_algo;
+        return d->signatures()[idx]->hash_algo;
     }
     return 0;
 }
@@ -368,14 +466,34 @@ unsigned int GpgME::Signature::hashAlgorithm() const
 const char *GpgME::Signature::hashAlgorithmAsString() const
 {
     if (!isNull()) {
-        return gpgme_hash_algo_name(d->sigs[idx]->hash_algo);
+        return gpgme_hash_algo_name(d->signatures()[idx]->hash_algo);
     }
     return nullptr;
 }
 
 const char *GpgME::Signature::policyURL() const
 {
-    return isNull() ? nullptr : d->purls[idx] ;
+    return isNull() ? nullptr : d->policyURLs()[idx] ;
+}
+
+std::string_view GpgME::Signature::fingerprintView() const
+{
+    return to_string_view(fingerprint());
+}
+
+std::string_view GpgME::Signature::pkaAddressView() const
+{
+    return to_string_view(pkaAddress());
+}
+
+std::string_view GpgME::Signature::policyURLView() const
+{
+    return to_string_view(policyURL());
+}
+
+unsigned int GpgME::Signature::numNotations() const
+{
+    return isNull() ? 0 : d->notations()[idx].size() ;
 }
 
 GpgME::Notation GpgME::Signature::notation(unsigned int nidx) const
@@ -389,8 +507,8 @@ std::vector<GpgME::Notation> GpgME::Signature::notations() const
         return std::vector<GpgME::Notation>();
     }
     std::vector<GpgME::Notation> result;
-    result.reserve(d->nota[idx].size());
-    for (unsigned int i = 0 ; i < d->nota[idx].size() ; ++i) {
+    result.reserve(d->notations()[idx].size());
+    for (unsigned int i = 0 ; i < d->notations()[idx].size() ; ++i) {
         result.push_back(GpgME::Notation(d, idx, i));
     }
     return result;
@@ -401,7 +519,7 @@ GpgME::Key GpgME::Signature::key() const
     if (isNull()) {
         return Key();
     }
-    return d->keys[idx];
+    return d->signatureKeys()[idx];
 }
 
 GpgME::Key GpgME::Signature::key(bool search, bool update) const
@@ -421,13 +539,13 @@ GpgME::Key GpgME::Signature::key(bool search, bool update) const
                         KeyListMode::WithTofu |
                         KeyListMode::WithKeygrip);
             Error e;
-            ret = d->keys[idx] = ctx->key(fingerprint(), e, false);
+            ret = d->signatureKeys()[idx] = ctx->key(fingerprint(), e, false);
             delete ctx;
         }
     }
     if (update) {
-        d->keys[idx].update();
-        ret = d->keys[idx];
+        d->signatureKeys()[idx].update();
+        ret = d->signatureKeys()[idx];
     }
     return ret;
 }
@@ -493,7 +611,7 @@ bool GpgME::Notation::isNull() const
         return true;
     }
     if (d->d) {
-        return d->sidx >= d->d->nota.size() || d->nidx >= d->d->nota[d->sidx].size() ;
+        return d->sidx >= d->d->numSigs || d->nidx >= d->d->notations()[d->sidx].size() ;
     }
     return !d->nota;
 }
@@ -502,7 +620,7 @@ const char *GpgME::Notation::name() const
 {
     return
         isNull() ? nullptr :
-        d->d ? d->d->nota[d->sidx][d->nidx].name :
+        d->d ? d->d->notations()[d->sidx][d->nidx].name :
         d->nota ? d->nota->name : nullptr ;
 }
 
@@ -510,16 +628,26 @@ const char *GpgME::Notation::value() const
 {
     return
         isNull() ? nullptr :
-        d->d ? d->d->nota[d->sidx][d->nidx].value :
+        d->d ? d->d->notations()[d->sidx][d->nidx].value :
         d->nota ? d->nota->value : nullptr ;
 }
 
+std::string_view GpgME::Notation::nameView() const
+{
+    return to_string_view(name());
+}
+
+std::string_view GpgME::Notation::valueView() const
+{
+    return to_string_view(value());
+}
+
 GpgME::Notation::Flags GpgME::Notation::flags() const
 {
     return
         convert_from_gpgme_sig_notation_flags_t(
             isNull() ? 0:
-            d->d ? d->d->nota[d->sidx][d->nidx].flags :
+            d->d ? d->d->notations()[d->sidx][d->nidx].flags :
             d->nota ? d->nota->flags : 0);
 }
 
@@ -32,6 +32,7 @@
 #include <time.h>
 
 #include <memory>
+#include <string_view>
 
 #include <vector>
 #include <iosfwd>
@@ -53,6 +54,7 @@ public:
     explicit VerificationResult(const Error &err);
 
     VerificationResult(const VerificationResult &other) = default;
+    VerificationResult(VerificationResult &&other) = default;
     const VerificationResult &operator=(VerificationResult other)
     {
         swap(other);
@@ -68,6 +70,11 @@ public:
 
     bool isNull() const;
 
+    /** Returns the approximate memory used by the result, including the
+     * copied signatures and their keys. Copies the signatures first if they
+     * have not been accessed yet. */
+    MemoryUsage approximateMemoryUsage() const;
+
     const char *fileName() const;
 
     unsigned int numSignatures() const;
@@ -90,6 +97,7 @@ public:
     Signature();
 
     Signature(const Signature &other) = default;
+    Signature(Signature &&other) = default;
     const Signature &operator=(Signature other)
     {
         swap(other);
@@ -155,6 +163,14 @@ public:
     const char *hashAlgorithmAsString() const;
 
     const char *policyURL() const;
+
+    /** Views of fingerprint(), pkaAddress() and policyURL(), which are
+     * empty if not available. */
+    std::string_view fingerprintView() const;
+    std::string_view pkaAddressView() const;
+    std::string_view policyURLView() const;
+
+    unsigned int numNotations() const;
     GpgME::Notation notation(unsigned int index) const;
     std::vector<GpgME::Notation> notations() const;
 
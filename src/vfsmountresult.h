@@ -46,6 +46,7 @@ public:
     explicit VfsMountResult(const Error &err);
 
     VfsMountResult(const VfsMountResult &other) = default;
+    VfsMountResult(VfsMountResult &&other) = default;
     const VfsMountResult &operator=(VfsMountResult other)
     {
         swap(other);
@@ -0,0 +1,203 @@
+/*
+    t-cachingpassphraseprovider.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "cachingpassphraseprovider.h"
+#include "securearena.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+class CountingProvider : public PassphraseProvider
+{
+public:
+    char *getPassphrase(const char *useridHint, const char *description,
+                        bool previousWasBad, bool &canceled) override
+    {
+        (void)useridHint;
+        (void)description;
+        (void)previousWasBad;
+        ++calls;
+        if (delay) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        }
+        canceled = cancel;
+        if (cancel || (failFirst && calls == 1)) {
+            return nullptr;
+        }
+        return SecureArena::instance().strdup(("secret" + std::to_string(calls.load())).c_str());
+    }
+
+    std::atomic<int> calls{0};
+    int delay = 0;
+    bool cancel = false;
+    // the first request returns no passphrase without being canceled
+    bool failFirst = false;
+};
+
+static std::string
+ask(PassphraseProvider &provider, const char *hint, bool previousWasBad, bool &canceled)
+{
+    char *passphrase = provider.getPassphrase(hint, "desc", previousWasBad, canceled);
+    if (!passphrase) {
+        return std::string();
+    }
+    const std::string result(passphrase);
+    SecureArena::instance().deallocate(passphrase);
+    return result;
+}
+
+static void
+test_cache()
+{
+    CountingProvider target;
+    CachingPassphraseProvider cache(&target);
+    bool canceled;
+    if (ask(cache, "A", false, canceled) != "secret1" || ask(cache, "A", false, canceled) != "secret1") {
+        print_error_and_exit("passphrase not cached", __FILE__, __LINE__);
+    }
+    if (ask(cache, "B", false, canceled) != "secret2" || cache.size() != 2) {
+        print_error_and_exit("passphrases not cached by key", __FILE__, __LINE__);
+    }
+    if (ask(cache, "A", true, canceled) != "secret3" || ask(cache, "A", false, canceled) != "secret3") {
+        print_error_and_exit("bad passphrase not replaced", __FILE__, __LINE__);
+    }
+    const auto stats = cache.statistics();
+    if (stats.hits != 2 || stats.fetches != 3 || target.calls != 3) {
+        print_error_and_exit("wrong statistics", __FILE__, __LINE__);
+    }
+    cache.clear();
+    if (cache.size() != 0) {
+        print_error_and_exit("cache not cleared", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_limits()
+{
+    CountingProvider target;
+    CachingPassphraseProvider uses(&target, std::chrono::seconds(300), 2);
+    bool canceled;
+    ask(uses, "A", false, canceled);
+    ask(uses, "A", false, canceled);
+    if (ask(uses, "A", false, canceled) != "secret2") {
+        print_error_and_exit("maximum uses not honored", __FILE__, __LINE__);
+    }
+
+    CachingPassphraseProvider expired(&target, std::chrono::seconds(0));
+    ask(expired, "A", false, canceled);
+    ask(expired, "A", false, canceled);
+    if (target.calls != 4) {
+        print_error_and_exit("time to live not honored", __FILE__, __LINE__);
+    }
+
+    target.cancel = true;
+    CachingPassphraseProvider cancel(&target);
+    if (!ask(cancel, "A", false, canceled).empty() || !canceled || cancel.size() != 0) {
+        print_error_and_exit("cancellation cached", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_single_flight()
+{
+    CountingProvider target;
+    target.delay = 100;
+    CachingPassphraseProvider cache(&target);
+    std::vector<std::thread> threads;
+    std::atomic<int> wrong{0};
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&cache, &wrong]() {
+            bool canceled;
+            if (ask(cache, "A", false, canceled) != "secret1") {
+                ++wrong;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (wrong || target.calls != 1) {
+        print_error_and_exit("concurrent requests not joined", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_failed_fetch()
+{
+    CountingProvider target;
+    target.delay = 100;
+    target.failFirst = true;
+    CachingPassphraseProvider cache(&target);
+    std::vector<std::thread> threads;
+    std::atomic<int> empty{0};
+    std::atomic<int> canceledCount{0};
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            bool canceled;
+            if (ask(cache, "A", false, canceled).empty()) {
+                ++empty;
+            }
+            if (canceled) {
+                ++canceledCount;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (canceledCount || empty != 1 || target.calls != 2) {
+        print_error_and_exit("failed fetch not retried by the waiters", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_cache();
+    test_limits();
+    test_single_flight();
+    test_failed_fetch();
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+    t-fakekey.h
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifndef __GPGMEPP_TESTS_T_FAKEKEY_H__
+#define __GPGMEPP_TESTS_T_FAKEKEY_H__
+
+#include "key.h"
+
+#include <gpgme.h>
+
+#include <string>
+
+// a key with one user ID and a primary subkey, built without an engine;
+// the tests change the gpgme structs directly
+struct FakeKey {
+    explicit FakeKey(const std::string &e = "user@example.net",
+                     const std::string &f = "0123456789ABCDEF0123456789ABCDEF01234567")
+        : fpr(f),
+          email(e)
+    {
+        key._refs = 1;
+        key.subkeys = &primary;
+        key.uids = &uid;
+        primary.fpr = &fpr[0];
+        uid.email = &email[0];
+    }
+    // the structs point into each other
+    FakeKey(const FakeKey &) = delete;
+    FakeKey &operator=(const FakeKey &) = delete;
+
+    // appends the encryption subkey to the subkeys
+    void addEncryptionSubkey()
+    {
+        key.can_encrypt = 1;
+        primary.next = &encryption;
+        encryption.can_encrypt = 1;
+    }
+
+    // the key holds a reference of its own, so it is never released
+    GpgME::Key get()
+    {
+        return GpgME::Key(&key, true);
+    }
+
+    std::string fpr;
+    std::string email;
+    _gpgme_key key{};
+    _gpgme_subkey primary{};
+    _gpgme_subkey encryption{};
+    _gpgme_user_id uid{};
+};
+
+#endif // __GPGMEPP_TESTS_T_FAKEKEY_H__
@@ -0,0 +1,113 @@
+/*
+    t-fingerprint.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "fingerprint.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <unordered_set>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static void
+test_parse()
+{
+    const Fingerprint v4{"A0FF4590BB6122EDEF6E3C542D727CC768697734"};
+    if (v4.isNull() || v4.size() != 20 || v4.version() != 4) {
+        print_error_and_exit("v4 fingerprint not parsed", __FILE__, __LINE__);
+    }
+    if (v4.data()[0] != 0xa0 || v4.data()[1] != 0xff || v4.data()[19] != 0x34) {
+        print_error_and_exit("v4 fingerprint decoded wrongly", __FILE__, __LINE__);
+    }
+    if (v4.toString() != "A0FF4590BB6122EDEF6E3C542D727CC768697734") {
+        print_error_and_exit("v4 fingerprint not formatted", __FILE__, __LINE__);
+    }
+    const Fingerprint lower{"a0ff4590bb6122edef6e3c542d727cc768697734"};
+    if (lower != v4) {
+        print_error_and_exit("case of hex digits not ignored", __FILE__, __LINE__);
+    }
+
+    const char *const hex64 = "19347BC9872464025F99DF3EC2E0000ED9884892E1F7B3EA4C94009159569B54";
+    const Fingerprint v5{hex64};
+    if (v5.size() != 32 || v5.version() != 5 || v5.toString() != hex64) {
+        print_error_and_exit("v5 fingerprint not parsed", __FILE__, __LINE__);
+    }
+    if (v5 == v4) {
+        print_error_and_exit("different fingerprints compare equal", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_invalid()
+{
+    if (!Fingerprint{static_cast<const char *>(nullptr)}.isNull()
+            || !Fingerprint{"A0FF4590"}.isNull()
+            || !Fingerprint{"A0FF4590BB6122EDEF6E3C542D727CC76869773G"}.isNull()
+            || !Fingerprint{"A0FF4590BB6122ED:F6E3C542D727CC768697734"}.isNull()) {
+        print_error_and_exit("invalid fingerprint accepted", __FILE__, __LINE__);
+    }
+    if (Fingerprint{"A0FF4590BB6122EDEF6E3C542D727CC76869773G"}.data()[0] != 0) {
+        print_error_and_exit("invalid fingerprint not cleared", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_containers()
+{
+    const unsigned char bytes[20] = {0xa0, 0xff, 0x45, 0x90};
+    const Fingerprint raw = Fingerprint::fromBytes(bytes, sizeof(bytes));
+    std::unordered_set<Fingerprint> set;
+    set.insert(raw);
+    set.insert(Fingerprint{"A0FF4590BB6122EDEF6E3C542D727CC768697734"});
+    set.insert(Fingerprint::fromBytes(bytes, sizeof(bytes)));
+    if (set.size() != 2 || !set.count(raw)) {
+        print_error_and_exit("fingerprint not usable in unordered containers", __FILE__, __LINE__);
+    }
+    if (!(raw < Fingerprint{"A0FF4590BB6122EDEF6E3C542D727CC768697734"})) {
+        print_error_and_exit("unexpected order", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_parse();
+    test_invalid();
+    test_containers();
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+    t-keylistinterner.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "keylistinterner.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static void
+test_intern()
+{
+    KeyListInterner interner;
+    std::string a = "alice@example.org";
+    std::string b = a;
+    const std::string_view va = interner.intern(a);
+    const std::string_view vb = interner.intern(b);
+    if (va != a || va.data() != vb.data() || va.data() == a.data()) {
+        print_error_and_exit("equal strings not shared", __FILE__, __LINE__);
+    }
+    if (interner.intern("bob@example.org").data() == va.data()) {
+        print_error_and_exit("different strings shared", __FILE__, __LINE__);
+    }
+    if (!interner.intern(static_cast<const char *>(nullptr)).empty() || !interner.intern("").empty()) {
+        print_error_and_exit("empty string interned", __FILE__, __LINE__);
+    }
+    if (interner.size() != 2 || interner.bytes() != 2 * a.size() - 2
+        || interner.requestedBytes() != 3 * a.size() - 2) {
+        print_error_and_exit("wrong statistics", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_stable()
+{
+    KeyListInterner interner;
+    std::vector<std::string> strings;
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 10000; ++i) {
+        strings.push_back("user" + std::to_string(i) + "@example.org");
+        views.push_back(interner.intern(strings.back()));
+    }
+    // a string too long for the blocks
+    strings.push_back(std::string(100000, 'x'));
+    views.push_back(interner.intern(strings.back()));
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (views[i] != strings[i] || interner.intern(strings[i]).data() != views[i].data()) {
+            print_error_and_exit("interned string moved", __FILE__, __LINE__);
+        }
+    }
+    interner.clear();
+    if (interner.size() != 0 || interner.bytes() != 0) {
+        print_error_and_exit("not cleared", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_intern();
+    test_stable();
+
+    return 0;
+}
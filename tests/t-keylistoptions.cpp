@@ -0,0 +1,88 @@
+/*
+    t-keylistoptions.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "keylistoptions.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+using FullKeyListing = KeyListOptions<Local, Signatures, SignatureNotations, Validate,
+                                      WithTofu, WithKeygrip, WithSecret>;
+
+static_assert(FullKeyListing::modes == (Local | Signatures | SignatureNotations | Validate |
+                                        WithTofu | WithKeygrip | WithSecret));
+static_assert(FullKeyListing::gpgmeModes == (GPGME_KEYLIST_MODE_LOCAL | GPGME_KEYLIST_MODE_SIGS |
+                                             GPGME_KEYLIST_MODE_SIG_NOTATIONS | GPGME_KEYLIST_MODE_VALIDATE |
+                                             GPGME_KEYLIST_MODE_WITH_TOFU | GPGME_KEYLIST_MODE_WITH_KEYGRIP |
+                                             GPGME_KEYLIST_MODE_WITH_SECRET));
+static_assert(KeyListOptions<LocateExternal>::gpgmeModes == (GPGME_KEYLIST_MODE_LOCATE | GPGME_KEYLIST_MODE_FORCE_EXTERN));
+static_assert(KeyListOptions<>::gpgmeModes == 0);
+static_assert(!isValidKeyListMode(ForceExtern | Local));
+static_assert(!isValidKeyListMode(KeyListModeMask + 1));
+
+static void
+test_round_trip()
+{
+    for (unsigned int mode = 0; mode <= KeyListModeMask; ++mode) {
+        if (fromGpgmeKeyListMode(toGpgmeKeyListMode(mode)) != mode) {
+            print_error_and_exit("mode not translated back", __FILE__, __LINE__);
+        }
+    }
+    unsigned int all = 0;
+    for (const KeyListModeMapping &mapping : keyListModeMappings) {
+        if (all & mapping.mode) {
+            print_error_and_exit("mode mapped twice", __FILE__, __LINE__);
+        }
+        all |= mapping.mode;
+    }
+    if (all != KeyListModeMask) {
+        print_error_and_exit("mode not mapped", __FILE__, __LINE__);
+    }
+    if (fromGpgmeKeyListMode(0x80000000 | GPGME_KEYLIST_MODE_LOCAL) != Local) {
+        print_error_and_exit("unknown gpgme mode not ignored", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_round_trip();
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+/*
+    t-keypacketsplitter.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "keypacketsplitter.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+// a new format packet with a one or two octet length
+static std::string
+packet(int tag, size_t length)
+{
+    std::string p(1, char(0xc0 | tag));
+    if (length < 192) {
+        p += char(length);
+    } else {
+        p += char(((length - 192) >> 8) + 192);
+        p += char((length - 192) & 0xff);
+    }
+    p.append(length, char(tag));
+    return p;
+}
+
+// an old format packet with a two octet length
+static std::string
+oldPacket(int tag, size_t length)
+{
+    std::string p(1, char(0x80 | (tag << 2) | 1));
+    p += char(length >> 8);
+    p += char(length & 0xff);
+    p.append(length, char(tag));
+    return p;
+}
+
+// a public key with a user ID, a signature and a subkey
+static std::string
+transferableKey(size_t n)
+{
+    return packet(6, 100 + n) + oldPacket(13, 30) + packet(2, 300) + packet(14, 100);
+}
+
+static std::vector<std::string>
+split(const std::string &stream, size_t chunkSize, size_t feedSize, Error &err)
+{
+    KeyPacketSplitter splitter(chunkSize);
+    std::vector<std::string> chunks;
+    std::string chunk;
+    for (size_t i = 0; i < stream.size(); i += feedSize) {
+        splitter.feed(stream.data() + i, std::min(feedSize, stream.size() - i));
+        while (splitter.next(chunk)) {
+            chunks.push_back(chunk);
+        }
+    }
+    while (splitter.finish(chunk)) {
+        chunks.push_back(chunk);
+    }
+    err = splitter.error();
+    return chunks;
+}
+
+static void
+test_split()
+{
+    std::vector<std::string> keys;
+    std::string stream;
+    for (size_t i = 0; i < 50; ++i) {
+        keys.push_back(transferableKey(i));
+        stream += keys.back();
+    }
+    for (const size_t feedSize : {1, 7, 1000, 100000}) {
+        Error err;
+        const std::vector<std::string> chunks = split(stream, 2000, feedSize, err);
+        if (err) {
+            print_error_and_exit("valid stream not parsed", __FILE__, __LINE__);
+        }
+        std::string joined;
+        size_t key = 0;
+        for (const std::string &chunk : chunks) {
+            // every chunk consists of whole keys
+            size_t pos = 0;
+            while (pos < chunk.size()) {
+                if (chunk.compare(pos, keys[key].size(), keys[key]) != 0) {
+                    print_error_and_exit("chunk not split on key boundary", __FILE__, __LINE__);
+                }
+                pos += keys[key++].size();
+            }
+            if (&chunk != &chunks.back() && chunk.size() < 2000) {
+                print_error_and_exit("chunk too small", __FILE__, __LINE__);
+            }
+            joined += chunk;
+        }
+        if (joined != stream || chunks.size() < 2) {
+            print_error_and_exit("stream not split", __FILE__, __LINE__);
+        }
+    }
+}
+
+static void
+test_partial_lengths()
+{
+    // a public key packet with a partial body of 512 bytes and a rest of 10
+    std::string key(1, char(0xc6));
+    key += char(0xe9);
+    key.append(512, 'x');
+    key += char(10);
+    key.append(10, 'y');
+    const std::string stream = key + packet(13, 20) + key + packet(13, 20);
+    Error err;
+    const std::vector<std::string> chunks = split(stream, 1, 3, err);
+    if (err || chunks.size() != 2 || chunks[0] != key + packet(13, 20)) {
+        print_error_and_exit("partial body lengths not handled", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_creation_time()
+{
+    std::string key(1, char(0xc6));
+    key += char(9);
+    key += char(4);
+    key += std::string("\x5f\x10\x20\x30", 4);
+    key += std::string(4, char(1));
+    if (KeyPacketSplitter::keyCreationTime(key.data(), key.size()) != 0x5f102030) {
+        print_error_and_exit("creation time not parsed", __FILE__, __LINE__);
+    }
+    const std::string uid = packet(13, 20);
+    if (KeyPacketSplitter::keyCreationTime(uid.data(), uid.size()) != -1) {
+        print_error_and_exit("user ID packet taken for a key", __FILE__, __LINE__);
+    }
+    if (KeyPacketSplitter::keyCreationTime(key.data(), 4) != -1) {
+        print_error_and_exit("truncated packet not rejected", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_armored()
+{
+    const std::string stream = "-----BEGIN PGP PUBLIC KEY BLOCK-----\n\nmQENBF...\n";
+    Error err;
+    const std::vector<std::string> chunks = split(stream, 1, 5, err);
+    if (err.code() != GPG_ERR_INV_PACKET) {
+        print_error_and_exit("armored stream not rejected", __FILE__, __LINE__);
+    }
+    if (chunks.size() != 1 || chunks[0] != stream) {
+        print_error_and_exit("armored stream not passed as one chunk", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_split();
+    test_partial_lengths();
+    test_creation_time();
+    test_armored();
+
+    return 0;
+}
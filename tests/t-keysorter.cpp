@@ -0,0 +1,149 @@
+/*
+    t-keysorter.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "keysorter.h"
+#include "t-fakekey.h"
+
+#include <gpgme.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <deque>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+// a key with the given email, validity and creation time
+struct SortKey : FakeKey {
+    SortKey(const std::string &e, int v, long created)
+        : FakeKey(e)
+    {
+        uid.validity = static_cast<gpgme_validity_t>(v);
+        primary.timestamp = created;
+    }
+};
+
+static std::vector<Key>
+makeKeys(std::deque<SortKey> &storage, size_t count)
+{
+    std::vector<Key> keys;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string email = (i % 3 ? "User" : "user") + std::to_string(i % 97) + "@example.net";
+        storage.emplace_back(email, i % 6, long(i * 7919 % 100003));
+        keys.push_back(storage.back().get());
+    }
+    return keys;
+}
+
+// validity descending, then email, then creation time
+static bool
+expectedLess(const Key &lhs, const Key &rhs)
+{
+    if (lhs.userID(0).validity() != rhs.userID(0).validity()) {
+        return lhs.userID(0).validity() > rhs.userID(0).validity();
+    }
+    std::string l = lhs.userID(0).email();
+    std::string r = rhs.userID(0).email();
+    std::transform(l.begin(), l.end(), l.begin(), ::tolower);
+    std::transform(r.begin(), r.end(), r.begin(), ::tolower);
+    if (l != r) {
+        return l < r;
+    }
+    return lhs.subkey(0).creationTime() < rhs.subkey(0).creationTime();
+}
+
+static const std::vector<KeySorter::Criterion> criteria = {
+    {KeySorter::Field::Validity, true},
+    {KeySorter::Field::Email, false},
+    {KeySorter::Field::CreationTime, false},
+};
+
+static void
+test_sort(size_t count, unsigned int concurrency)
+{
+    std::deque<SortKey> storage;
+    std::vector<Key> keys = makeKeys(storage, count);
+    std::vector<Key> expected = keys;
+    std::stable_sort(expected.begin(), expected.end(), expectedLess);
+
+    const KeySorter sorter(criteria, concurrency);
+    sorter.sort(keys);
+    for (size_t i = 0; i < count; ++i) {
+        // the email addresses are distinct buffers, so this compares the keys
+        if (keys[i].userID(0).email() != expected[i].userID(0).email()) {
+            print_error_and_exit("keys not sorted", __FILE__, __LINE__);
+        }
+    }
+
+    std::vector<Key> partial = makeKeys(storage, count);
+    sorter.partialSort(partial, 100);
+    for (size_t i = 0; i < 100; ++i) {
+        if (expectedLess(partial[i], expected[i]) || expectedLess(expected[i], partial[i])) {
+            print_error_and_exit("keys not partially sorted", __FILE__, __LINE__);
+        }
+    }
+    if (partial.size() != count) {
+        print_error_and_exit("keys lost", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_descending_strings()
+{
+    std::deque<SortKey> storage;
+    storage.emplace_back("ab@example.net", 0, 0);
+    storage.emplace_back("abc@example.net", 0, 0);
+    storage.emplace_back("a@example.net", 0, 0);
+    std::vector<Key> keys{storage[0].get(), storage[1].get(), storage[2].get()};
+    const KeySorter sorter({{KeySorter::Field::Email, true}});
+    const std::vector<size_t> order = sorter.order(keys);
+    if (order != std::vector<size_t>{1, 0, 2}) {
+        print_error_and_exit("emails not sorted descending", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_sort(500, 1);
+    test_sort(20000, 4);
+    test_descending_strings();
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+    t-memoryusage.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "key.h"
+#include "keyringsnapshot.h"
+#include "t-fakekey.h"
+
+#include <gpgme.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static void
+test_owned()
+{
+    const MemoryUsage exclusive = MemoryUsage::owned(100, 1);
+    if (exclusive.exclusive != 100 || exclusive.shared != 0 || exclusive.proportional != 100) {
+        print_error_and_exit("exclusive bytes not counted", __FILE__, __LINE__);
+    }
+    MemoryUsage shared = MemoryUsage::owned(100, 4);
+    if (shared.exclusive != 0 || shared.shared != 100 || shared.proportional != 25) {
+        print_error_and_exit("shared bytes not counted", __FILE__, __LINE__);
+    }
+    shared += exclusive;
+    if (shared.total() != 200 || shared.proportional != 125) {
+        print_error_and_exit("usages not added", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_key()
+{
+    FakeKey fake;
+    const Key key = fake.get();
+    const MemoryUsage alone = key.approximateMemoryUsage();
+    const size_t minimum = sizeof(Key) + sizeof(_gpgme_key) + sizeof(_gpgme_subkey) + sizeof(_gpgme_user_id)
+                           + fake.fpr.size() + 1 + fake.email.size() + 1;
+    if (alone.shared != 0 || alone.exclusive < minimum || alone.proportional != alone.exclusive) {
+        print_error_and_exit("key not counted as exclusive", __FILE__, __LINE__);
+    }
+
+    const Key copy = key;
+    const MemoryUsage shared = key.approximateMemoryUsage();
+    if (shared.exclusive != sizeof(Key) || shared.total() != alone.total()
+        || shared.proportional != sizeof(Key) + shared.shared / 2) {
+        print_error_and_exit("copied key not counted as shared", __FILE__, __LINE__);
+    }
+
+    if (Key().approximateMemoryUsage().total() != sizeof(Key)) {
+        print_error_and_exit("null key not counted as handle", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_keys()
+{
+    FakeKey fake;
+    std::vector<Key> keys;
+    keys.reserve(2);
+    keys.push_back(fake.get());
+    keys.push_back(keys.front());
+    const size_t keyBytes = keys.front().approximateMemoryUsage().total() - sizeof(Key);
+
+    // both copies are in the vector; the key is counted once
+    const MemoryUsage inside = Key::approximateMemoryUsage(keys);
+    if (inside.shared != 0 || inside.exclusive != 2 * sizeof(Key) + keyBytes) {
+        print_error_and_exit("copies within the keys not counted once", __FILE__, __LINE__);
+    }
+
+    const Key outside = keys.front();
+    const MemoryUsage shared = Key::approximateMemoryUsage(keys);
+    if (shared.shared != keyBytes || shared.proportional != 2 * sizeof(Key) + keyBytes * 2 / 3) {
+        print_error_and_exit("copy outside of the keys not counted as shared", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_snapshot()
+{
+    KeyringSnapshot snapshot;
+    const size_t empty = snapshot.memoryStats().total();
+    FakeKey fake;
+    for (int i = 0; i < 100; ++i) {
+        snapshot.add(fake.get());
+    }
+    const KeyringSnapshot::MemoryStats stats = snapshot.memoryStats();
+    if (stats.keys != 100 || stats.subkeys != 100 || stats.total() <= empty
+        || stats.stringBytes < snapshot.stringTableSize()) {
+        print_error_and_exit("snapshot not counted", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_owned();
+    test_key();
+    test_keys();
+    test_snapshot();
+
+    return 0;
+}
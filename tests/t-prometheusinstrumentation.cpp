@@ -0,0 +1,130 @@
+/*
+    t-prometheusinstrumentation.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "prometheusinstrumentation.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static bool
+contains(const std::string &text, const std::string &line)
+{
+    return text.find(line + '\n') != std::string::npos;
+}
+
+static Instrumentation::OperationStats
+stats(Instrumentation::Operation operation, std::chrono::milliseconds duration, const Error &error = Error())
+{
+    Instrumentation::OperationStats s;
+    s.operation = operation;
+    s.protocol = OpenPGP;
+    s.start = Instrumentation::Clock::now();
+    s.end = s.start + duration;
+    s.engineWait = duration / 2;
+    s.bytesIn = 100;
+    s.bytesOut = 200;
+    s.statusLines = 3;
+    s.callbacks = 1;
+    s.error = error;
+    return s;
+}
+
+static void
+test_histograms()
+{
+    PrometheusInstrumentation instrumentation({0.01, 0.1, 1});
+    instrumentation.operationFinished(nullptr, stats(Instrumentation::Decrypt, std::chrono::milliseconds(5)));
+    instrumentation.operationFinished(nullptr, stats(Instrumentation::Decrypt, std::chrono::milliseconds(50)));
+    instrumentation.operationFinished(nullptr, stats(Instrumentation::Decrypt, std::chrono::milliseconds(5000)));
+    const std::string metrics = instrumentation.metrics();
+    const std::string labels = "operation=\"decrypt\",protocol=\"openpgp\"";
+    if (!contains(metrics, "# TYPE gpgmepp_operation_duration_seconds histogram")) {
+        print_error_and_exit("histogram type missing", __FILE__, __LINE__);
+    }
+    if (!contains(metrics, "gpgmepp_operation_duration_seconds_bucket{" + labels + ",le=\"0.01\"} 1")
+        || !contains(metrics, "gpgmepp_operation_duration_seconds_bucket{" + labels + ",le=\"0.1\"} 2")
+        || !contains(metrics, "gpgmepp_operation_duration_seconds_bucket{" + labels + ",le=\"1\"} 2")
+        || !contains(metrics, "gpgmepp_operation_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} 3")
+        || !contains(metrics, "gpgmepp_operation_duration_seconds_count{" + labels + "} 3")) {
+        print_error_and_exit("wrong histogram buckets", __FILE__, __LINE__);
+    }
+    if (!contains(metrics, "gpgmepp_operation_duration_seconds_sum{" + labels + "} 5.055")) {
+        print_error_and_exit("wrong histogram sum", __FILE__, __LINE__);
+    }
+    if (!contains(metrics, "gpgmepp_engine_wait_seconds_bucket{" + labels + ",le=\"0.01\"} 1")) {
+        print_error_and_exit("wrong engine wait histogram", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_counters()
+{
+    PrometheusInstrumentation instrumentation;
+    instrumentation.operationFinished(nullptr, stats(Instrumentation::Sign, std::chrono::milliseconds(1)));
+    instrumentation.operationFinished(nullptr, stats(Instrumentation::Sign, std::chrono::milliseconds(1),
+                                                     Error::fromCode(GPG_ERR_BAD_PASSPHRASE)));
+    const std::string metrics = instrumentation.metrics();
+    const std::string labels = "{operation=\"sign\",protocol=\"openpgp\"} ";
+    if (!contains(metrics, "gpgmepp_operation_errors_total" + labels + "1")
+        || !contains(metrics, "gpgmepp_data_read_bytes_total" + labels + "200")
+        || !contains(metrics, "gpgmepp_data_written_bytes_total" + labels + "400")
+        || !contains(metrics, "gpgmepp_status_lines_total" + labels + "6")
+        || !contains(metrics, "gpgmepp_callbacks_total" + labels + "2")) {
+        print_error_and_exit("wrong counters", __FILE__, __LINE__);
+    }
+    if (metrics.find("operation=\"decrypt\"") != std::string::npos) {
+        print_error_and_exit("unexpected series", __FILE__, __LINE__);
+    }
+    instrumentation.reset();
+    if (instrumentation.metrics().find("operation=\"sign\"") != std::string::npos) {
+        print_error_and_exit("metrics not reset", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_histograms();
+    test_counters();
+
+    return 0;
+}
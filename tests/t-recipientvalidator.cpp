@@ -0,0 +1,164 @@
+/*
+    t-recipientvalidator.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "recipientvalidator.h"
+#include "t-fakekey.h"
+
+#include <gpgme.h>
+
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+// a key with a certification and an encryption subkey and one user ID
+struct RecipientKey : FakeKey {
+    RecipientKey()
+    {
+        addEncryptionSubkey();
+        primary.can_certify = 1;
+        uid.validity = GPGME_VALIDITY_MARGINAL;
+    }
+};
+
+static void
+expect(const RecipientValidator &validator, RecipientKey &fake, gpg_err_code_t code, int line)
+{
+    const Error err = validator.validate(fake.get());
+    if (err.code() != code) {
+        std::cerr << "got " << err.code() << ", expected " << code << std::endl;
+        print_error_and_exit("wrong reason", __FILE__, line);
+    }
+}
+
+static void
+test_validate()
+{
+    const RecipientValidator validator;
+    if (validator.validate(Key()).code() != GPG_ERR_NO_PUBKEY) {
+        print_error_and_exit("null key not rejected", __FILE__, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        expect(validator, fake, GPG_ERR_NO_ERROR, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        fake.key.revoked = 1;
+        expect(validator, fake, GPG_ERR_CERT_REVOKED, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        fake.key.expired = 1;
+        expect(validator, fake, GPG_ERR_CERT_EXPIRED, __LINE__);
+    }
+    {
+        // expired since the key was listed
+        RecipientKey fake;
+        fake.primary.expires = time(nullptr) - 10;
+        expect(validator, fake, GPG_ERR_CERT_EXPIRED, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        fake.key.disabled = 1;
+        expect(validator, fake, GPG_ERR_KEY_DISABLED, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        fake.encryption.can_encrypt = 0;
+        expect(validator, fake, GPG_ERR_WRONG_KEY_USAGE, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        fake.encryption.revoked = 1;
+        expect(validator, fake, GPG_ERR_UNUSABLE_PUBKEY, __LINE__);
+    }
+    {
+        RecipientKey fake;
+        fake.encryption.expires = time(nullptr) - 10;
+        expect(validator, fake, GPG_ERR_UNUSABLE_PUBKEY, __LINE__);
+    }
+}
+
+static void
+test_validity()
+{
+    const RecipientValidator validator(UserID::Full);
+    RecipientKey fake;
+    expect(validator, fake, GPG_ERR_NOT_TRUSTED, __LINE__);
+    fake.uid.validity = GPGME_VALIDITY_ULTIMATE;
+    expect(validator, fake, GPG_ERR_NO_ERROR, __LINE__);
+    fake.uid.revoked = 1;
+    expect(validator, fake, GPG_ERR_NOT_TRUSTED, __LINE__);
+
+    // Never is worse than Unknown and Undefined despite its enum value
+    const RecipientValidator undefined(UserID::Undefined);
+    RecipientKey never;
+    never.uid.validity = GPGME_VALIDITY_NEVER;
+    expect(undefined, never, GPG_ERR_NOT_TRUSTED, __LINE__);
+}
+
+static void
+test_filter()
+{
+    const RecipientValidator validator;
+    RecipientKey good;
+    RecipientKey bad;
+    bad.key.revoked = 1;
+    std::vector<RecipientValidator::Rejection> rejected;
+    const std::vector<Key> usable = validator.filter({good.get(), bad.get(), Key(), good.get()}, &rejected);
+    if (usable.size() != 2 || rejected.size() != 2
+        || rejected[0].reason.code() != GPG_ERR_CERT_REVOKED || !rejected[1].key.isNull()) {
+        print_error_and_exit("keys not filtered", __FILE__, __LINE__);
+    }
+    if (validator.check({good.get()}).size() != 0) {
+        print_error_and_exit("usable key rejected", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_validate();
+    test_validity();
+    test_filter();
+
+    return 0;
+}
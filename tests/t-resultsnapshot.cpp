@@ -0,0 +1,104 @@
+/*
+    t-resultsnapshot.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "resultsnapshot.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static void
+test_round_trip()
+{
+    const std::string buffer = VerificationSnapshot::serialize(VerificationResult(Error::fromCode(GPG_ERR_BAD_SIGNATURE)));
+    Error err;
+    const VerificationSnapshot snapshot = VerificationSnapshot::fromBuffer(buffer.data(), buffer.size(), err);
+    if (err || snapshot.isNull()) {
+        print_error_and_exit("valid snapshot rejected", __FILE__, __LINE__);
+    }
+    if (snapshot.error().code() != GPG_ERR_BAD_SIGNATURE || snapshot.numSignatures() != 0
+        || !snapshot.fileName().empty() || !snapshot.signature(0).isNull()) {
+        print_error_and_exit("snapshot not restored", __FILE__, __LINE__);
+    }
+
+    const std::string keyBuffer = KeySnapshot::serialize(Key());
+    const KeySnapshot key = KeySnapshot::fromBuffer(keyBuffer.data(), keyBuffer.size(), err);
+    if (err || key.numSubkeys() != 0 || key.numUserIDs() != 0 || !key.primaryFingerprint().empty()) {
+        print_error_and_exit("key snapshot not restored", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_rejected()
+{
+    const std::string buffer = ImportSnapshot::serialize(ImportResult(Error::fromCode(GPG_ERR_NO_DATA)));
+    Error err;
+    if (!DecryptionSnapshot::fromBuffer(buffer.data(), buffer.size(), err).isNull() || !err) {
+        print_error_and_exit("snapshot of wrong kind accepted", __FILE__, __LINE__);
+    }
+    if (!ImportSnapshot::fromBuffer(buffer.data(), buffer.size() - 1, err).isNull() || !err) {
+        print_error_and_exit("truncated snapshot accepted", __FILE__, __LINE__);
+    }
+    // points the imports array behind the end of the buffer
+    std::string corrupted = buffer;
+    corrupted[16 + 15 * 8] = char(0xff);
+    if (!ImportSnapshot::fromBuffer(corrupted.data(), corrupted.size(), err).isNull() || !err) {
+        print_error_and_exit("corrupted snapshot accepted", __FILE__, __LINE__);
+    }
+    corrupted = buffer;
+    corrupted[4] = 2;
+    ImportSnapshot::fromBuffer(corrupted.data(), corrupted.size(), err);
+    if (err.code() != GPG_ERR_UNSUPPORTED_PROTOCOL) {
+        print_error_and_exit("unknown version accepted", __FILE__, __LINE__);
+    }
+    const ImportSnapshot snapshot = ImportSnapshot::fromBuffer(buffer.data(), buffer.size(), err);
+    if (err || snapshot.error().code() != GPG_ERR_NO_DATA || snapshot.numImports() != 0) {
+        print_error_and_exit("valid snapshot rejected", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_round_trip();
+    test_rejected();
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+    t-securearena.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "securearena.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static void
+test_allocate_and_recycle()
+{
+    SecureArena &arena = SecureArena::instance();
+    const size_t inUse = arena.statistics().bytesInUse;
+
+    char *const block = static_cast<char *>(arena.allocate(100));
+    if (!block) {
+        print_error_and_exit("allocation failed", __FILE__, __LINE__);
+    }
+    if (!arena.owns(block) || !arena.owns(block + 99)) {
+        print_error_and_exit("block not owned by arena", __FILE__, __LINE__);
+    }
+    if (arena.blockSize(block) != 128) {
+        print_error_and_exit("unexpected block size", __FILE__, __LINE__);
+    }
+    std::memset(block, 'x', 100);
+    arena.deallocate(block);
+    if (block[0] != 0 || block[99] != 0) {
+        print_error_and_exit("block not wiped", __FILE__, __LINE__);
+    }
+    if (arena.statistics().bytesInUse != inUse) {
+        print_error_and_exit("block not accounted as free", __FILE__, __LINE__);
+    }
+    // the block of the size class is reused
+    void *const again = arena.allocate(120);
+    if (again != block) {
+        print_error_and_exit("block not recycled", __FILE__, __LINE__);
+    }
+    arena.deallocate(again);
+}
+
+static void
+test_large_block()
+{
+    SecureArena &arena = SecureArena::instance();
+    const size_t reserved = arena.statistics().bytesReserved;
+    void *const block = arena.allocate(100000);
+    if (!block || arena.blockSize(block) < 100000) {
+        print_error_and_exit("allocation failed", __FILE__, __LINE__);
+    }
+    arena.deallocate(block);
+    if (arena.statistics().bytesReserved != reserved) {
+        print_error_and_exit("large block not unmapped", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_strdup_and_foreign_memory()
+{
+    SecureArena &arena = SecureArena::instance();
+    char *const copy = arena.strdup("secret");
+    if (!copy || std::strcmp(copy, "secret") != 0) {
+        print_error_and_exit("unexpected copy", __FILE__, __LINE__);
+    }
+    arena.deallocate(copy);
+
+    char *const foreign = static_cast<char *>(std::malloc(16));
+    if (arena.owns(foreign)) {
+        print_error_and_exit("foreign memory owned by arena", __FILE__, __LINE__);
+    }
+    std::free(foreign);
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_allocate_and_recycle();
+    test_large_block();
+    test_strdup_and_foreign_memory();
+
+    return 0;
+}
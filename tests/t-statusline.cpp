@@ -0,0 +1,109 @@
+/*
+    t-statusline.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "statusline.h"
+
+#include <gpgme.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+static void
+test_code_set()
+{
+    static constexpr StatusCodeSet codes{GPGME_STATUS_GOODSIG, GPGME_STATUS_KEY_CONSIDERED};
+    static_assert(codes.contains(GPGME_STATUS_GOODSIG), "code not added at compile time");
+    if (!codes.contains(GPGME_STATUS_KEY_CONSIDERED) || codes.contains(GPGME_STATUS_BADSIG)) {
+        print_error_and_exit("wrong codes in set", __FILE__, __LINE__);
+    }
+    if (codes.contains(StatusLine::UnknownCode) || !StatusCodeSet::all().contains(StatusLine::UnknownCode)) {
+        print_error_and_exit("unknown codes not handled", __FILE__, __LINE__);
+    }
+    if (!StatusCodeSet().isEmpty() || codes.isEmpty()) {
+        print_error_and_exit("empty set not detected", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_keywords()
+{
+    if (StatusLine::codeForKeyword("GOODSIG") != GPGME_STATUS_GOODSIG
+        || StatusLine::codeForKeyword("EOF") != GPGME_STATUS_EOF
+        || StatusLine::codeForKeyword("KEY_CONSIDERED") != GPGME_STATUS_KEY_CONSIDERED) {
+        print_error_and_exit("keyword not mapped to code", __FILE__, __LINE__);
+    }
+    if (StatusLine::codeForKeyword("NO_SUCH_STATUS") != StatusLine::UnknownCode
+        || StatusLine::codeForKeyword("GOODSI") != StatusLine::UnknownCode) {
+        print_error_and_exit("unknown keyword mapped to code", __FILE__, __LINE__);
+    }
+    if (std::strcmp(StatusLine::keywordForCode(GPGME_STATUS_NEWSIG), "NEWSIG") != 0
+        || StatusLine::keywordForCode(StatusLine::UnknownCode)) {
+        print_error_and_exit("code not mapped to keyword", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_fields()
+{
+    const StatusLine line("IMPORT_OK", " 1  ABCDEF 3");
+    if (line.code() != GPGME_STATUS_IMPORT_OK || line.keyword() != "IMPORT_OK") {
+        print_error_and_exit("wrong code", __FILE__, __LINE__);
+    }
+    const auto fields = line.fields();
+    if (fields.size() != 3 || fields[0] != "1" || fields[1] != "ABCDEF" || fields[2] != "3") {
+        print_error_and_exit("arguments not split", __FILE__, __LINE__);
+    }
+    if (line.field(1) != "ABCDEF" || line.field(2) != "3" || !line.field(3).empty()) {
+        print_error_and_exit("wrong field", __FILE__, __LINE__);
+    }
+    if (!StatusLine("GOT_IT", "").fields().empty()) {
+        print_error_and_exit("fields of empty arguments", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_code_set();
+    test_keywords();
+    test_fields();
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+    t-tracescope.cpp
+
+    This file is part of GPGME++'s test suite.
+    Copyright (c) 2026 g10 Code GmbH
+
+    GPGME++ is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Library General Public
+    License as published by the Free Software Foundation; either
+    version 2 of the License, or (at your option) any later version.
+
+    GPGME++ is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Library General Public License for more details.
+
+    You should have received a copy of the GNU Library General Public License
+    along with GPGME++; see the file COPYING.LIB.  If not, write to the
+    Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+    Boston, MA 02110-1301, USA.
+*/
+
+#ifdef HAVE_CONFIG_H
+ #include "config.h"
+#endif
+
+#include "context.h"
+#include "tracescope.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace GpgME;
+
+static void
+print_error_and_exit(std::string_view message, std::string_view file, int line)
+{
+    std::cerr << file << ':' << line << ": " << message << std::endl;
+    exit(1);
+}
+
+struct RecordedSpan {
+    std::string name;
+    std::string parent;
+    std::int64_t errorCode = -1;
+    bool ended = false;
+};
+
+class RecordingTracer : public Tracer
+{
+public:
+    class Span : public TraceSpan
+    {
+    public:
+        Span(RecordingTracer *t, size_t i)
+            : tracer(t), index(i)
+        {
+        }
+        void setAttribute(const char *key, const char *) override
+        {
+            (void)key;
+        }
+        void setAttribute(const char *key, std::int64_t value) override
+        {
+            if (std::string(key) == "gpgme.error_code") {
+                tracer->spans[index].errorCode = value;
+            }
+        }
+        void end(const Error &) override
+        {
+            tracer->spans[index].ended = true;
+        }
+
+        RecordingTracer *const tracer;
+        const size_t index;
+    };
+
+    std::unique_ptr<TraceSpan> startSpan(const char *name, TraceSpan *parent) override
+    {
+        RecordedSpan span;
+        span.name = name;
+        if (auto p = dynamic_cast<Span *>(parent)) {
+            span.parent = spans[p->index].name;
+        }
+        spans.push_back(span);
+        return std::unique_ptr<TraceSpan>(new Span(this, spans.size() - 1));
+    }
+
+    std::vector<RecordedSpan> spans;
+};
+
+static void
+test_nesting()
+{
+    RecordingTracer tracer;
+    {
+        TraceScope outer("outer", &tracer);
+        if (TraceScope::current() != outer.span()) {
+            print_error_and_exit("span not made current", __FILE__, __LINE__);
+        }
+        {
+            TraceScope inner("inner", &tracer);
+            inner.setError(Error::fromCode(GPG_ERR_NO_DATA));
+        }
+        if (TraceScope::current() != outer.span()) {
+            print_error_and_exit("previous span not restored", __FILE__, __LINE__);
+        }
+    }
+    if (TraceScope::current()) {
+        print_error_and_exit("current span not cleared", __FILE__, __LINE__);
+    }
+    if (tracer.spans.size() != 2 || tracer.spans[1].parent != "outer" || !tracer.spans[0].parent.empty()) {
+        print_error_and_exit("wrong parents", __FILE__, __LINE__);
+    }
+    if (!tracer.spans[0].ended || !tracer.spans[1].ended) {
+        print_error_and_exit("spans not ended", __FILE__, __LINE__);
+    }
+    if (tracer.spans[0].errorCode != 0 || tracer.spans[1].errorCode != GPG_ERR_NO_DATA) {
+        print_error_and_exit("wrong error codes", __FILE__, __LINE__);
+    }
+}
+
+static void
+test_global_tracer_and_parent()
+{
+    {
+        TraceScope none("unused");
+        if (none.span() || TraceScope::current()) {
+            print_error_and_exit("span started without a tracer", __FILE__, __LINE__);
+        }
+    }
+    RecordingTracer tracer;
+    Context::setGlobalTracer(&tracer);
+    {
+        TraceScope request("request", &tracer);
+        // e.g. a worker thread which adopts the span of a request
+        TraceScope adopted(request.span());
+        TraceScope child("child");
+    }
+    Context::setGlobalTracer(nullptr);
+    if (tracer.spans.size() != 2 || tracer.spans[1].name != "child" || tracer.spans[1].parent != "request") {
+        print_error_and_exit("global tracer or adopted parent not used", __FILE__, __LINE__);
+    }
+}
+
+int
+main (int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    test_nesting();
+    test_global_tracer_and_parent();
+
+    return 0;
+}
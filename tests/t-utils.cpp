@@ -92,6 +92,28 @@ test_split_into_string_views()
     }
 }
 
+static void
+test_append_length_prefixed()
+{
+    // binary digests which only differ after a NUL byte
+    const std::string first("\x12\x00\x34", 3);
+    const std::string second("\x12\x00\x56", 3);
+    std::string a, b;
+    append_length_prefixed(a, first);
+    append_length_prefixed(b, second);
+    if (a == b || a != std::string("3:\x12\x00\x34", 5)) {
+        print_error_and_exit("value cut off at NUL byte", __FILE__, __LINE__);
+    }
+    std::string c, d;
+    append_length_prefixed(c, "ab");
+    append_length_prefixed(c, "c");
+    append_length_prefixed(d, "a");
+    append_length_prefixed(d, "bc");
+    if (c == d) {
+        print_error_and_exit("different fields give the same result", __FILE__, __LINE__);
+    }
+}
+
 int
 main (int argc, char **argv)
 {
@@ -101,6 +123,7 @@ main (int argc, char **argv)
     GpgME::initializeLibrary();
 
     test_split_into_string_views();
+    test_append_length_prefixed();
 
     return 0;
 }